@@ -0,0 +1,165 @@
+/**
+ * @file activation_log.h
+ * @brief Per-event activation timing for bilateral skew feedback
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * Both gloves record when each macrocycle event actually started. The
+ * SECONDARY converts its start times to the PRIMARY timebase and returns
+ * them with the next MACROCYCLE_ACK; the PRIMARY subtracts its own start
+ * times for the same (sequence, event index) to get true bilateral skew.
+ *
+ * Design:
+ * - Motor task (producer) logs (scheduled, actual) local times into a
+ *   lock-free SPSC ring via recordActivation() - no mutex, no search
+ * - One consumer context (SECONDARY: BLE callback, PRIMARY: main loop)
+ *   tracks macrocycles, drains the ring and matches entries to events by
+ *   their scheduled local time (unique within the tracked window)
+ * - Lateness is stored against the PRIMARY schedule (baseTime + deltaTimeUs),
+ *   so PRIMARY skew = SECONDARY lateness - PRIMARY lateness
+ */
+
+#ifndef ACTIVATION_LOG_H
+#define ACTIVATION_LOG_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <atomic>
+#include "config.h"
+#include "types.h"
+
+/**
+ * @brief Activation timing log for one glove
+ *
+ * Usage (SECONDARY, BLE callback):
+ *   activationLog.track(mc, localBaseTime);       // when staging a macrocycle
+ *   activationLog.drain(clockOffset);             // before building the ACK
+ *   if (activationLog.takeFeedback(getMicros(), feedback)) { ...attach... }
+ *
+ * Usage (PRIMARY, main loop):
+ *   activationLog.track(mc, mc.baseTime);         // when sending a macrocycle
+ *   activationLog.drain(0);
+ *   uint8_t n = activationLog.computeSkew(secondaryFeedback, skewUs);
+ *
+ * Motor task (both roles):
+ *   activationLog.recordActivation(event.timeUs, afterOp);
+ */
+class ActivationLog {
+public:
+    // Macrocycles remembered: everything a pipelined PRIMARY keeps in flight
+    // plus the ones whose feedback is still on its way back
+    static constexpr uint8_t MAX_MACROCYCLES = MACROCYCLE_PIPELINE_MAX_DEPTH + 2;
+
+    // Activations logged between drains (power of 2). Drained at least once
+    // per macrocycle, which has MACROCYCLE_MAX_EVENTS activations.
+    static constexpr uint8_t RING_SIZE = 32;
+
+    // Events not started this long after their scheduled time count as missed
+    static constexpr uint32_t SETTLE_US = 100000;
+
+    ActivationLog();
+
+    /**
+     * @brief Forget all tracked macrocycles and logged activations
+     *
+     * Consumer only, while the motor task is not logging.
+     */
+    void reset();
+
+    /**
+     * @brief Start tracking a macrocycle (consumer only)
+     *
+     * Re-tracking a sequence ID already tracked (a pipelined resend) is a
+     * no-op. The oldest macrocycle is forgotten when the log is full.
+     *
+     * @param mc Macrocycle as scheduled (baseTime in the PRIMARY clock)
+     * @param localBaseTime baseTime in this glove's clock (PRIMARY: mc.baseTime)
+     */
+    void track(const Macrocycle& mc, uint64_t localBaseTime);
+
+    /**
+     * @brief Log a motor activation (motor task, producer only)
+     *
+     * ISR-safe: no mutex, no search.
+     *
+     * @param scheduledLocalUs ActivationQueue event time (local clock)
+     * @param actualLocalUs When the motor actually started (local clock)
+     * @return false if the ring is full (activation not logged)
+     */
+    bool recordActivation(uint64_t scheduledLocalUs, uint64_t actualLocalUs);
+
+    /**
+     * @brief Match logged activations to tracked events (consumer only)
+     *
+     * @param localMinusPrimaryUs Clock offset used to convert actual start times
+     *        to the PRIMARY timebase (0 on PRIMARY)
+     * @return Number of activations matched to a tracked event
+     */
+    uint8_t drain(int64_t localMinusPrimaryUs);
+
+    /**
+     * @brief Take the oldest finished macrocycle not yet reported (consumer only)
+     *
+     * A macrocycle is finished once its last event is SETTLE_US past due.
+     * Events that never started are MACROCYCLE_LATENESS_NONE.
+     *
+     * @param nowLocalUs Current local time
+     * @param feedback Output: per-event lateness against the PRIMARY schedule
+     * @return false if no tracked macrocycle is finished and unreported
+     */
+    bool takeFeedback(uint64_t nowLocalUs, MacrocycleFeedback& feedback);
+
+    /**
+     * @brief Per-event bilateral skew against feedback from the other glove
+     *
+     * Skew = SECONDARY start - PRIMARY start (both in the PRIMARY clock), i.e.
+     * feedback lateness minus own lateness, for each event both gloves started.
+     *
+     * @param feedback SECONDARY feedback (from MACROCYCLE_ACK)
+     * @param skewUs Output: up to MACROCYCLE_MAX_EVENTS values, in event order
+     * @return Number of values written (0 if the sequence isn't tracked)
+     */
+    uint8_t computeSkew(const MacrocycleFeedback& feedback, int32_t* skewUs) const;
+
+    /**
+     * @brief Activations dropped because the ring was full
+     */
+    uint32_t getDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "RING_SIZE must be a power of 2");
+    static_assert(std::atomic<uint8_t>::is_always_lock_free, "head/tail must be lock-free (motor task producer)");
+
+    struct Activation {
+        uint64_t scheduledLocalUs;
+        uint64_t actualLocalUs;
+    };
+
+    struct TrackedMacrocycle {
+        MacrocycleFeedback feedback;                  // sequenceId, eventCount, lateness so far
+        uint64_t localBaseTime;
+        uint64_t primaryBaseTime;
+        uint32_t deltaTimeUs[MACROCYCLE_MAX_EVENTS];
+        bool used;
+        bool reported;
+    };
+
+    Activation _ring[RING_SIZE];
+    std::atomic<uint8_t> _head;  // Written by the motor task only
+    std::atomic<uint8_t> _tail;  // Written by the consumer only
+    std::atomic<uint32_t> _dropped;
+
+    TrackedMacrocycle _tracked[MAX_MACROCYCLES];
+    uint8_t _nextSlot;           // Round-robin: overwrites the oldest
+
+    TrackedMacrocycle* findTracked(uint32_t sequenceId);
+    const TrackedMacrocycle* findTracked(uint32_t sequenceId) const;
+};
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+extern ActivationLog activationLog;
+
+#endif // ACTIVATION_LOG_H
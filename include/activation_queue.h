@@ -1,7 +1,7 @@
 /**
  * @file activation_queue.h
  * @brief Unified motor event queue for FreeRTOS-based motor control
- * @version 3.0.0
+ * @version 3.2.0
  * @platform Adafruit Feather nRF52840 Express
  *
  * Pure FreeRTOS architecture - no hardware timer dependency.
@@ -11,6 +11,8 @@
  * - enqueue() adds both activation AND deactivation events
  * - Motor task sleeps until next event time, then executes
  * - FreeRTOS timing + busy-wait for sub-ms precision
+ * - Events held in a MotorEventHeap: O(1) peek, O(log n) enqueue/dequeue,
+ *   equal timestamps dequeue in enqueue order
  */
 
 #ifndef ACTIVATION_QUEUE_H
@@ -18,55 +20,16 @@
 
 #include <Arduino.h>
 #include "rtos.h"
+#include "motor_event_heap.h"
 
 // Forward declarations
 class HapticController;
 
-/**
- * @brief Type of motor event
- */
-enum class MotorEventType : uint8_t {
-    ACTIVATE,    // Turn motor ON
-    DEACTIVATE   // Turn motor OFF
-};
-
-/**
- * @brief Single scheduled motor event (activation or deactivation)
- *
- * NOTE: This struct is accessed from multiple contexts (main loop, BLE callbacks,
- * motor task). The `active` flag is marked volatile to prevent cache issues.
- */
-struct MotorEvent {
-    uint64_t timeUs;        // Event time (local clock, microseconds)
-    uint8_t  finger;        // Motor index (0-3)
-    uint8_t  amplitude;     // Intensity (0-100), only used for ACTIVATE
-    uint16_t frequencyHz;   // Motor frequency, only used for ACTIVATE
-    MotorEventType type;    // ACTIVATE or DEACTIVATE
-    volatile bool active;   // Slot in use (volatile: accessed from multiple contexts)
-
-    MotorEvent()
-        : timeUs(0)
-        , finger(0)
-        , amplitude(0)
-        , frequencyHz(250)
-        , type(MotorEventType::ACTIVATE)
-        , active(false) {}
-
-    void clear() {
-        timeUs = 0;
-        finger = 0;
-        amplitude = 0;
-        frequencyHz = 250;
-        type = MotorEventType::ACTIVATE;
-        active = false;
-    }
-};
-
 /**
  * @class ActivationQueue
  * @brief Unified queue for motor events (activations AND deactivations)
  *
- * Manages a fixed-size array of motor events. The motor task processes
+ * Manages a fixed-capacity min-heap of motor events. The motor task processes
  * events in time order using FreeRTOS timing with busy-wait for precision.
  *
  * Usage:
@@ -77,7 +40,7 @@ struct MotorEvent {
  */
 class ActivationQueue {
 public:
-    static constexpr uint8_t MAX_EVENTS = 32;  // 12 activations + 12 deactivations + margin
+    static constexpr uint8_t MAX_EVENTS = MotorEventHeap::CAPACITY;
 
     ActivationQueue();
 
@@ -119,6 +82,18 @@ public:
      */
     bool dequeueNextEvent(MotorEvent& event);
 
+    /**
+     * @brief Dequeue the next event and any others due within a window of it
+     * @param events Output array (deadline order)
+     * @param maxCount Capacity of events
+     * @param windowUs Coalescing window relative to the first event
+     * @return Number of events dequeued (0 if queue empty or mutex unavailable)
+     *
+     * Used by the motor task to merge near-simultaneous boundaries (e.g.
+     * DEACTIVATE F0 / ACTIVATE F1) into one I2C batch.
+     */
+    uint8_t dequeueEventsWithin(MotorEvent* events, uint8_t maxCount, uint32_t windowUs);
+
     /**
      * @brief Get time of next event
      * @return Next event time, or UINT64_MAX if queue empty
@@ -189,29 +164,16 @@ public:
     uint64_t getNextActivationTime() const { return getNextEventTime(); }
 
 private:
-    MotorEvent _events[MAX_EVENTS];
+    MotorEventHeap _events;          // Earliest-deadline heap (guarded by _queueMutex)
     HapticController* _haptic;
     TaskHandle_t _motorTaskHandle;
     SemaphoreHandle_t _queueMutex;   // Mutex for thread-safe queue access
     bool _initialized;
 
     /**
-     * @brief Find an empty slot in the queue
-     * @return Slot index, or -1 if full
-     */
-    int8_t findEmptySlot() const;
-
-    /**
-     * @brief Find next event by time
-     * @return Slot index of earliest event, or -1 if none
-     */
-    int8_t findNextEvent() const;
-
-    /**
-     * @brief Add a single event to queue
-     * @return Slot index if added, -1 if full
+     * @brief Log a queue-full rejection (M5 fix)
      */
-    int8_t addEvent(const MotorEvent& event);
+    void logQueueFull(const MotorEvent& event) const;
 };
 
 // Global instance
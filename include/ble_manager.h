@@ -19,6 +19,7 @@
 
 #include "config.h"
 #include "types.h"
+#include "rx_frame_assembler.h"
 
 // =============================================================================
 // BLE CONSTANTS
@@ -68,9 +69,8 @@ struct BBConnection {
     volatile bool pendingIdentify;       // Waiting for IDENTIFY message
     uint32_t identifyStartTime; // When identification period started
 
-    // Message receive buffer
-    char rxBuffer[RX_BUFFER_SIZE];
-    uint16_t rxIndex;
+    // Message reassembly (frames stamped at first-byte arrival)
+    RxFrameAssembler rx;
 
     BBConnection() :
         connHandle(CONN_HANDLE_INVALID),
@@ -78,9 +78,7 @@ struct BBConnection {
         isConnected(false),
         connectedAt(0),
         pendingIdentify(false),
-        identifyStartTime(0),
-        rxIndex(0) {
-        memset(rxBuffer, 0, sizeof(rxBuffer));
+        identifyStartTime(0) {
     }
 
     void reset() {
@@ -90,8 +88,7 @@ struct BBConnection {
         connectedAt = 0;
         pendingIdentify = false;
         identifyStartTime = 0;
-        rxIndex = 0;
-        memset(rxBuffer, 0, sizeof(rxBuffer));
+        rx.reset();
     }
 };
 
@@ -102,7 +99,8 @@ struct BBConnection {
 // Callback function types
 typedef void (*BLEConnectCallback)(uint16_t connHandle, ConnectionType type);
 typedef void (*BLEDisconnectCallback)(uint16_t connHandle, ConnectionType type, uint8_t reason);
-typedef void (*BLEMessageCallback)(uint16_t connHandle, const char* message);
+// rxTimestampUs: getMicros() when the message's first byte arrived (PTP T2/T4)
+typedef void (*BLEMessageCallback)(uint16_t connHandle, const char* message, uint64_t rxTimestampUs);
 
 // =============================================================================
 // BLE MANAGER CLASS
@@ -248,6 +246,23 @@ public:
      */
     bool send(uint16_t connHandle, const char* message);
 
+    /**
+     * @brief Send a sync message timestamped when its first byte is written
+     *
+     * The message waits in the TX queue like any other; the timestamp is
+     * taken in update() right before the bytes go to the UART service, so
+     * queueing delay doesn't count as network delay in PTP.
+     *
+     * @param connHandle Connection handle
+     * @param message Message string (EOT will be appended automatically)
+     * @param stampOffset Offset of a SyncCommand::stampTxTime() placeholder
+     *                    to patch, or 0 for none
+     * @param sentAtUs Optional: receives the transmit timestamp
+     * @return true if queued
+     */
+    bool sendStamped(uint16_t connHandle, const char* message, uint16_t stampOffset,
+                     volatile uint64_t* sentAtUs = nullptr);
+
     /**
      * @brief Send message to SECONDARY device (PRIMARY mode)
      * @param message Message string
@@ -319,6 +334,11 @@ public:
      */
     uint16_t getPrimaryHandle() const;
 
+    /**
+     * @brief Get number of messages waiting in the TX queue
+     */
+    uint8_t getPendingTxCount() const { return _txCount; }
+
     // =========================================================================
     // STATIC CALLBACKS (for Bluefruit library)
     // =========================================================================
@@ -362,6 +382,8 @@ private:
         uint16_t length;
         uint16_t bytesSent;
         uint16_t connHandle;
+        uint16_t stampOffset;           // TX timestamp placeholder (0 = none)
+        volatile uint64_t* sentAtUs;    // Receives the TX timestamp (nullptr = none)
         bool pending;
     };
 
@@ -374,9 +396,12 @@ private:
      * @brief Enqueue message for non-blocking transmission
      * @param connHandle Target connection
      * @param message Message to send (EOT will be appended)
+     * @param stampOffset TX timestamp placeholder to patch (0 = none)
+     * @param sentAtUs Receives the TX timestamp (nullptr = none)
      * @return true if enqueued successfully
      */
-    bool enqueueTx(uint16_t connHandle, const char* message);
+    bool enqueueTx(uint16_t connHandle, const char* message,
+                   uint16_t stampOffset = 0, volatile uint64_t* sentAtUs = nullptr);
 
     /**
      * @brief Process pending TX queue entries
@@ -400,8 +425,8 @@ private:
     BBConnection* findConnectionByType(ConnectionType type);
     BBConnection* findFreeConnection();
 
-    void processIncomingData(uint16_t connHandle, const uint8_t* data, uint16_t len);
-    void processClientIncomingData(const uint8_t* data, uint16_t len);
+    void processIncomingData(uint16_t connHandle, const uint8_t* data, uint16_t len, uint64_t rxUs);
+    void processClientIncomingData(const uint8_t* data, uint16_t len, uint64_t rxUs);
     void deliverMessage(BBConnection* conn, uint16_t connHandle);
     ConnectionType identifyConnectionType(uint16_t connHandle);
 };
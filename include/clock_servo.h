@@ -0,0 +1,186 @@
+/**
+ * @file clock_servo.h
+ * @brief Two-state Kalman clock servo (offset + skew) for PTP samples
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * Jointly estimates the SECONDARY - PRIMARY clock offset and the crystal
+ * skew between the two boards from PING/PONG (t1, t2, t3, t4) exchanges.
+ * Replaces the 10-sample median + slow EMA + clamped EMA drift rate:
+ * - Skew is part of the state, so offset predictions between samples
+ *   (e.g. when a MACROCYCLE is sent) are extrapolated, not held
+ * - Each sample is weighted by its path-delay excess over the best recent
+ *   delay: a BLE retransmission that adds 7.5ms one way mostly shows up as
+ *   asymmetry, so high-delay samples are trusted less instead of equally
+ * - Innovation gating rejects outliers; a run of rejections re-seeds the
+ *   filter (step change, e.g. SECONDARY rebooted)
+ * - Exposes its own uncertainty as a 95% confidence interval
+ *
+ * State (relative to an integer anchor to keep float precision):
+ *   x[0] = offset residual (us),  x[1] = skew (us per ms = ppm / 1000)
+ *
+ * Thread Safety: NOT thread-safe. Owned by SimpleSyncProtocol, fed from the
+ * BLE callback (PONG) and read from the main loop. Kept free of Arduino
+ * timing calls so it can be driven by recorded traces natively.
+ */
+
+#ifndef CLOCK_SERVO_H
+#define CLOCK_SERVO_H
+
+#include <stdint.h>
+
+// =============================================================================
+// PTP SAMPLE
+// =============================================================================
+
+/**
+ * @brief One PING/PONG exchange
+ *
+ * t1/t4 on PRIMARY clock, t2/t3 on SECONDARY clock (microseconds).
+ */
+struct PtpSample {
+    uint64_t t1;    // PRIMARY send (PING)
+    uint64_t t2;    // SECONDARY receive (PING)
+    uint64_t t3;    // SECONDARY send (PONG)
+    uint64_t t4;    // PRIMARY receive (PONG)
+
+    /**
+     * @brief IEEE 1588 offset: ((t2 - t1) + (t3 - t4)) / 2
+     */
+    int64_t offset() const {
+        return (((int64_t)t2 - (int64_t)t1) + ((int64_t)t3 - (int64_t)t4)) / 2;
+    }
+
+    /**
+     * @brief Network round trip excluding SECONDARY processing: (t4 - t1) - (t3 - t2)
+     */
+    int64_t pathDelay() const {
+        return ((int64_t)t4 - (int64_t)t1) - ((int64_t)t3 - (int64_t)t2);
+    }
+
+    /**
+     * @brief PRIMARY-clock time the sample describes (midpoint of t1..t4)
+     */
+    uint64_t midpoint() const {
+        return t1 + (t4 - t1) / 2;
+    }
+};
+
+// =============================================================================
+// CLOCK SERVO
+// =============================================================================
+
+/**
+ * @class ClockServo
+ * @brief Kalman filter over (offset, skew) with delay-weighted measurements
+ *
+ * Usage:
+ *   ClockServo servo;
+ *   servo.addSample({t1, t2, t3, t4});            // on every PONG
+ *   if (servo.isValid()) {
+ *       int64_t offset = servo.getOffsetAt(getMicros());
+ *       uint32_t ci = servo.getConfidenceIntervalUs(getMicros());
+ *   }
+ */
+class ClockServo {
+public:
+    // Measurement noise floor (us): even a best-delay sample carries up to one
+    // connection interval of unknown asymmetry (~1.5ms sigma at 7.5ms)
+    static constexpr float MEAS_NOISE_US = 1500.0f;
+    // Offset random walk (us^2 per ms): timestamp/ISR jitter not explained by skew
+    static constexpr float OFFSET_PROCESS_NOISE = 0.01f;
+    // Skew random walk ((us/ms)^2 per ms): ~1 ppm wander per minute (temperature)
+    static constexpr float SKEW_PROCESS_NOISE = 2e-11f;
+    // Initial skew uncertainty (us/ms): 50 ppm, i.e. two +/-20 ppm crystals plus margin
+    static constexpr float INITIAL_SKEW_STDDEV = 0.05f;
+    // Innovation gate (sigma) and how many consecutive rejections force a re-seed
+    static constexpr float GATE_SIGMA = 4.0f;
+    static constexpr uint8_t MAX_CONSECUTIVE_REJECTS = 5;
+    // Samples above this path delay are discarded outright (us)
+    static constexpr int64_t MAX_PATH_DELAY_US = 120000;
+    // Best-delay tracker forgets this much per sample (us) so it follows
+    // connection-interval changes instead of sticking to one lucky sample
+    static constexpr int64_t MIN_DELAY_DECAY_US = 10;
+    // Skew extrapolation horizon; predictions further out hold the last offset
+    static constexpr uint32_t MAX_HOLDOVER_MS = 30000;
+
+    ClockServo();
+
+    /**
+     * @brief Forget all state (reconnect / resetClockSync)
+     */
+    void reset();
+
+    /**
+     * @brief Feed one PTP exchange
+     * @return true if the sample was used, false if rejected (delay or gate)
+     */
+    bool addSample(const PtpSample& sample);
+
+    /**
+     * @brief True once SYNC_MIN_VALID_SAMPLES samples have been accepted
+     *        since the last (re-)seed
+     */
+    bool isValid() const { return _acceptedCount >= _minValidSamples; }
+
+    /**
+     * @brief Predicted offset (SECONDARY - PRIMARY) at a PRIMARY-clock time
+     * @param primaryTimeUs PRIMARY clock time (us), e.g. getMicros() on PRIMARY
+     * @return Offset in microseconds (0 if no sample yet)
+     */
+    int64_t getOffsetAt(uint64_t primaryTimeUs) const;
+
+    /**
+     * @brief Estimated skew in microseconds per millisecond (ppm / 1000)
+     */
+    float getSkewUsPerMs() const { return _skew; }
+
+    /**
+     * @brief Estimated skew in parts per million
+     */
+    float getSkewPpm() const { return _skew * 1000.0f; }
+
+    /**
+     * @brief One-sigma offset uncertainty at a PRIMARY-clock time (us)
+     */
+    float getOffsetStdDevUs(uint64_t primaryTimeUs) const;
+
+    /**
+     * @brief 95% confidence half-width of getOffsetAt() (us)
+     */
+    uint32_t getConfidenceIntervalUs(uint64_t primaryTimeUs) const;
+
+    /**
+     * @brief Best (lowest) recent path delay in microseconds
+     */
+    int64_t getMinPathDelayUs() const { return _minDelayUs; }
+
+    uint32_t getAcceptedCount() const { return _acceptedCount; }   // Since the last (re-)seed
+    uint32_t getRejectedCount() const { return _rejectedCount; }
+    uint32_t getReseedCount() const { return _reseedCount; }
+
+    /**
+     * @brief Override accepted-sample threshold for validity (default SYNC_MIN_VALID_SAMPLES)
+     */
+    void setMinValidSamples(uint8_t count) { _minValidSamples = count; }
+
+private:
+    bool _seeded;
+    int64_t _anchorOffset;      // Integer part of the offset estimate (us)
+    uint64_t _lastTimeUs;       // PRIMARY time of the last accepted sample
+    float _offset;              // x[0]: offset residual relative to _anchorOffset (us)
+    float _skew;                // x[1]: skew (us per ms)
+    float _p00, _p01, _p11;     // Symmetric covariance
+    int64_t _minDelayUs;        // Decaying minimum path delay
+    uint32_t _acceptedCount;
+    uint32_t _rejectedCount;
+    uint32_t _reseedCount;
+    uint8_t _consecutiveRejects;
+    uint8_t _minValidSamples;
+
+    void seed(const PtpSample& sample, float measVariance);
+    float measurementVariance(int64_t pathDelayUs) const;
+    float elapsedMs(uint64_t primaryTimeUs) const;
+};
+
+#endif // CLOCK_SERVO_H
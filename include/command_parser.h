@@ -0,0 +1,190 @@
+/**
+ * @file command_parser.h
+ * @brief Zero-copy command tokenizer and sorted command tables
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * Front end for every message handed to onBLEMessage(): the message is
+ * tokenized once in place and its command word is looked up in constexpr
+ * tables sorted by name (binary search), instead of copying it into
+ * fixed-size token buffers and walking strcmp chains.
+ *
+ * Tokenizing rules (same as the former MenuController::parseCommand):
+ * - the message ends at the first '\n', '\r' or EOT (or after
+ *   COMMAND_MESSAGE_MAX characters)
+ * - leading spaces are skipped
+ * - fields are separated by ':'; empty fields are skipped (strtok semantics)
+ * - the first field is the command, up to MAX_COMMAND_PARAMS more are kept
+ */
+
+#ifndef COMMAND_PARSER_H
+#define COMMAND_PARSER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string_view>
+#include "config.h"
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+// Characters of a message that are tokenized
+#define COMMAND_MESSAGE_MAX 255
+
+// Parameter buffer size (for handlers that need a NUL-terminated copy)
+#define PARAM_BUFFER_SIZE 64
+
+// Maximum parameters per command
+#define MAX_COMMAND_PARAMS 16
+
+// =============================================================================
+// COMMAND TOKENS
+// =============================================================================
+
+/**
+ * @brief Non-owning, zero-copy view of a tokenized command
+ *
+ * Stores field offsets into the caller's message (~56 bytes) rather than
+ * copies of each field.
+ *
+ * LIFETIME: The message buffer must outlive the tokens.
+ *
+ * Usage:
+ *   CommandTokens tokens;
+ *   if (tokens.parse(message)) {
+ *       std::string_view command = tokens.command();
+ *       int32_t id = tokens.paramInt(0);
+ *   }
+ */
+class CommandTokens {
+public:
+    CommandTokens();
+
+    /**
+     * @brief Tokenize a message in place
+     * @param message NUL-terminated message (must outlive the tokens)
+     * @return true if the message holds a command
+     */
+    bool parse(const char* message);
+
+    /**
+     * @brief Command field as written (case preserved)
+     */
+    std::string_view command() const { return field(0); }
+
+    /**
+     * @brief Number of parameters after the command
+     */
+    uint8_t paramCount() const { return _fieldCount > 0 ? static_cast<uint8_t>(_fieldCount - 1) : 0; }
+
+    /**
+     * @brief Parameter as a view into the message (empty if out of range)
+     */
+    std::string_view param(uint8_t index) const { return field(static_cast<uint8_t>(index + 1)); }
+
+    /**
+     * @brief Parameter decoded like atoi() (defaultValue if out of range)
+     */
+    int32_t paramInt(uint8_t index, int32_t defaultValue = 0) const;
+
+    /**
+     * @brief Copy a parameter as a NUL-terminated string
+     * @param index Parameter index
+     * @param out Output buffer
+     * @param outSize Size of output buffer (longer parameters are truncated)
+     * @return false if index is out of range
+     */
+    bool copyParam(uint8_t index, char* out, size_t outSize) const;
+
+private:
+    static constexpr uint8_t MAX_FIELDS = 1 + MAX_COMMAND_PARAMS;
+
+    const char* _message;
+    uint8_t _fieldCount;
+    uint8_t _fieldStart[MAX_FIELDS];
+    uint8_t _fieldLen[MAX_FIELDS];
+
+    std::string_view field(uint8_t index) const;
+};
+
+// =============================================================================
+// SORTED COMMAND TABLES
+// =============================================================================
+
+/**
+ * @brief Entry of a command table
+ */
+template <typename T>
+struct CommandEntry {
+    const char* name;
+    T value;
+};
+
+/**
+ * @brief Compare a command word with a table name (strcmp ordering)
+ * @param ignoreCase Compare word characters uppercased (table names must be uppercase)
+ */
+constexpr int compareCommand(std::string_view word, const char* name, bool ignoreCase = false) {
+    size_t i = 0;
+    for (; i < word.size() && name[i] != '\0'; i++) {
+        char c = word[i];
+        if (ignoreCase && c >= 'a' && c <= 'z') {
+            c = static_cast<char>(c - ('a' - 'A'));
+        }
+        if (c != name[i]) {
+            return static_cast<unsigned char>(c) < static_cast<unsigned char>(name[i]) ? -1 : 1;
+        }
+    }
+    if (i == word.size()) {
+        return name[i] == '\0' ? 0 : -1;
+    }
+    return 1;
+}
+
+/**
+ * @brief Check at compile time that a table is sorted by name with no duplicates
+ */
+template <typename T, size_t N>
+constexpr bool commandTableSorted(const CommandEntry<T> (&table)[N]) {
+    for (size_t i = 1; i < N; i++) {
+        if (compareCommand(table[i - 1].name, table[i].name) >= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Binary search a sorted command table
+ * @return Matching entry, or nullptr
+ */
+template <typename T, size_t N>
+constexpr const CommandEntry<T>* findCommand(const CommandEntry<T> (&table)[N], std::string_view word,
+                                             bool ignoreCase = false) {
+    size_t lo = 0;
+    size_t hi = N;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = compareCommand(word, table[mid].name, ignoreCase);
+        if (cmp == 0) {
+            return &table[mid];
+        }
+        if (cmp < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Check if a command word belongs to PRIMARY <-> SECONDARY traffic
+ *
+ * Internal messages bypass the phone command menu. Matching is exact and
+ * case-sensitive, plus the SYNC_* and ACK_SYNC* families.
+ */
+bool isInternalCommand(std::string_view word);
+
+#endif // COMMAND_PARSER_H
@@ -98,6 +98,50 @@
 // Note: Therapy timing (TIME_ON, TIME_OFF, etc.) is defined in therapy profiles
 // See ProfileManager and ORIGINAL_PARAMETERS.md for v1 reference values
 
+// Motor event dispatch (build-time selectable, see [env:adafruit_feather_nrf52840_hwtimer])
+#define MOTOR_DISPATCH_BUSY_WAIT 0      // FreeRTOS sleep to ~1ms before event, then spin on getMicros()
+#define MOTOR_DISPATCH_HW_TIMER  1      // One-shot hardware TIMER compare wakes the motor task
+#ifndef MOTOR_DISPATCH_MODE
+#define MOTOR_DISPATCH_MODE MOTOR_DISPATCH_BUSY_WAIT
+#endif
+#define MOTOR_BUSY_WAIT_WINDOW_US 2000  // Busy-wait mode: spin when event is closer than this
+#define MOTOR_TIMER_WAKE_LEAD_US 40     // HW timer mode: fire this early to absorb ISR -> task switch,
+                                        // remainder is a short spin
+
+// Motor event coalescing: events due within this window of the earliest one are
+// executed as a single locked I2C batch (one mux sequence, writes in deadline order)
+#ifndef MOTOR_COALESCE_WINDOW_US
+#define MOTOR_COALESCE_WINDOW_US 500    // 0 = merge identical timestamps only
+#endif
+#define MOTOR_COALESCE_MAX_EVENTS 4     // Max events merged into one batch
+
+// Macrocycle pipelining: PRIMARY keeps N future macrocycles in flight on SECONDARY,
+// each with an absolute baseTime, so BLE latency is off the per-cycle critical path.
+// 1 = lockstep (next macrocycle generated only after the previous one completes)
+#ifndef MACROCYCLE_PIPELINE_DEPTH
+#define MACROCYCLE_PIPELINE_DEPTH 1
+#endif
+#define MACROCYCLE_PIPELINE_MAX_DEPTH 4   // Bounds in-flight storage and ActivationQueue capacity
+#define MACROCYCLE_ACK_TIMEOUT_MS 300     // Resend an in-flight macrocycle not ACKed within this
+#define MACROCYCLE_RESEND_CUTOFF_US 20000 // Don't resend if baseTime is closer than this (too late)
+
+// Lockstep mode: generate the next macrocycle during the previous one's 2x TIME_RELAX
+// so the IDLE step only stamps baseTime and sends (0 = generate inline, for comparison)
+#ifndef MACROCYCLE_PRECOMPUTE
+#define MACROCYCLE_PRECOMPUTE 1
+#endif
+
+// Seeded macrocycles: both gloves generate macrocycle N from (session seed, N), so
+// PRIMARY sends a "macrocycle N at baseTime T" beacon instead of every event.
+// Used only when the SECONDARY advertises support (CAPS ...SG<version>).
+#ifndef SEEDED_MACROCYCLES
+#define SEEDED_MACROCYCLES 0
+#endif
+#define SEEDED_MACROCYCLE_VERSION 2         // 2: integer-µs timeline and jitter
+#define SEEDED_MACROCYCLE_MAX_COAST 2       // Pipelined only: macrocycles SECONDARY generates
+                                            // on its own when a beacon is late (link outage)
+#define SEEDED_MACROCYCLE_COAST_LEAD_MS 30  // Coast this long before the next slot starts
+
 // Test session duration (quick hardware verification, separate from profile settings)
 constexpr uint32_t TEST_DURATION_SEC = 120;  // 2 minutes
 
@@ -0,0 +1,121 @@
+/**
+ * @file flash_write_scheduler.h
+ * @brief Defers settings writes to windows with no scheduled motor events
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * A LittleFS commit erases and programs internal flash. On the nRF52840 the
+ * CPU stalls while a page is erased (up to ~85ms), so a settings write that
+ * lands next to a buzz ruins its timing. Callers mark settings dirty instead
+ * of writing; loop() commits once:
+ * - changes have stopped arriving for FLASH_WRITE_COALESCE_MS (bursts such
+ *   as LED toggles become one write)
+ * - the next motor event is at least getRequiredWindowUs() away, counting
+ *   the events of the next macrocycle before they are queued. In lockstep
+ *   the queue is empty for every relax period, and the next macrocycle is
+ *   queued only one lead time (~50ms) before its first event.
+ *
+ * The required window starts at FLASH_WRITE_WINDOW_US and grows to the worst
+ * stall measured so far plus FLASH_WRITE_GUARD_US.
+ */
+
+#ifndef FLASH_WRITE_SCHEDULER_H
+#define FLASH_WRITE_SCHEDULER_H
+
+#include <stdint.h>
+#include <atomic>
+
+#ifndef FLASH_WRITE_COALESCE_MS
+#define FLASH_WRITE_COALESCE_MS 500     // Quiet time after the last change
+#endif
+
+#ifndef FLASH_WRITE_WINDOW_US
+#define FLASH_WRITE_WINDOW_US 100000    // Initial event-free window (one page erase + margin)
+#endif
+
+#ifndef FLASH_WRITE_GUARD_US
+#define FLASH_WRITE_GUARD_US 20000      // Margin over the worst measured stall
+#endif
+
+/**
+ * @brief Dirty tracking and commit-window decisions for one settings file
+ *
+ * markDirty() may run in a BLE callback; everything else runs in loop().
+ * A change marked while a commit is in progress keeps the settings dirty.
+ *
+ * Usage (loop):
+ *   if (scheduler.shouldCommit(millis(), nowUs, queue.getNextEventTime(),
+ *                              therapy.getNextMacrocycleDueUs())) {
+ *       uint32_t generation = scheduler.beginCommit();
+ *       ...write, measuring stallUs...
+ *       scheduler.endCommit(generation, millis(), stallUs, ok);
+ *   }
+ */
+class FlashWriteScheduler {
+public:
+    FlashWriteScheduler();
+
+    /**
+     * @brief Record a settings change to persist later
+     * @param nowMs Current time (millis)
+     */
+    void markDirty(uint32_t nowMs);
+
+    /**
+     * @brief True if changes are waiting to be committed
+     */
+    bool isDirty() const {
+        return _markedGeneration.load(std::memory_order_acquire) != _committedGeneration;
+    }
+
+    /**
+     * @brief Check whether a commit may start now
+     * @param nowMs Current time (millis)
+     * @param nowUs Current time (local micros, same clock as nextEventUs)
+     * @param nextEventUs Next scheduled motor event (UINT64_MAX if none)
+     * @param nextMacrocycleUs When the next macrocycle gets queued
+     *        (UINT64_MAX if no session is running)
+     * @return true if dirty, settled, and both are far enough away
+     */
+    bool shouldCommit(uint32_t nowMs, uint64_t nowUs, uint64_t nextEventUs,
+                      uint64_t nextMacrocycleUs = UINT64_MAX) const;
+
+    /**
+     * @brief Start a commit
+     * @return Generation to pass to endCommit()
+     */
+    uint32_t beginCommit() const { return _markedGeneration.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Finish a commit
+     * @param generation Value returned by beginCommit()
+     * @param nowMs Current time (millis)
+     * @param stallUs Measured duration of the write
+     * @param success false keeps the settings dirty and retries after the
+     *        coalesce delay
+     */
+    void endCommit(uint32_t generation, uint32_t nowMs, uint32_t stallUs, bool success);
+
+    /**
+     * @brief Event-free window a commit currently needs
+     */
+    uint32_t getRequiredWindowUs() const;
+
+    uint32_t getCommitCount() const { return _commitCount; }
+    uint32_t getFailureCount() const { return _failureCount; }
+    uint32_t getLastStallUs() const { return _lastStallUs; }
+    uint32_t getMaxStallUs() const { return _maxStallUs; }
+
+private:
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "generation must be lock-free (BLE callback writer)");
+
+    std::atomic<uint32_t> _markedGeneration;   // Bumped per change (any context)
+    std::atomic<uint32_t> _lastChangeMs;       // Start of the coalesce delay
+    uint32_t _committedGeneration;             // Last generation written (loop only)
+    uint32_t _commitCount;
+    uint32_t _failureCount;
+    uint32_t _lastStallUs;
+    uint32_t _maxStallUs;
+};
+
+#endif // FLASH_WRITE_SCHEDULER_H
@@ -1,7 +1,7 @@
 /**
  * @file hardware.h
  * @brief BlueBuzzah hardware abstraction layer - Class declarations
- * @version 2.0.0
+ * @version 2.1.0
  * @platform Adafruit Feather nRF52840 Express
  *
  * Hardware components:
@@ -28,6 +28,33 @@
 // HAPTIC CONTROLLER
 // =============================================================================
 
+/**
+ * @brief One motor write within a coalesced I2C batch (see executeBatch)
+ */
+struct HapticBatchOp {
+    uint64_t deadlineUs;    // Scheduled time for the RTP write (getMicros() timebase)
+    uint8_t finger;         // Finger index (0-3)
+    uint8_t amplitude;      // Amplitude percentage (0-100), 0 = deactivate
+    uint16_t frequencyHz;   // LRA frequency for activations, 0 = leave unchanged
+    Result result;          // Output: per-op result
+    uint64_t completedUs;   // Output: getMicros() right after the RTP write
+};
+
+/**
+ * @brief I2C bus transaction counters (shadow-register elision)
+ *
+ * "Skipped" counts writes the shadow state proved redundant - each one is a
+ * full I2C transaction (START, address, payload, STOP) that never hit the bus.
+ */
+struct I2CBusStats {
+    uint32_t muxWrites;         // TCA9548A control-byte writes issued
+    uint32_t muxWritesSkipped;  // TCA9548A writes elided (mask already set)
+    uint32_t drvWrites;         // DRV2605 register writes issued
+    uint32_t drvWritesSkipped;  // DRV2605 writes elided (register already holds value)
+
+    uint32_t totalSkipped() const { return muxWritesSkipped + drvWritesSkipped; }
+};
+
 /**
  * @brief Controls 4 DRV2605 haptic drivers via TCA9548A I2C multiplexer
  *
@@ -156,12 +183,36 @@ public:
      */
     void closeAllChannels();
 
+    /**
+     * @brief Execute several motor writes as one locked I2C transaction
+     * @param ops Operations ordered by deadline (outputs filled in place)
+     * @param count Number of operations
+     * @return Result::OK if the batch ran (see per-op results), ERROR_BUSY if
+     *         the I2C mutex could not be acquired
+     *
+     * Takes _i2cMutex once for the whole batch. Before each RTP write the mux is
+     * switched straight to the op's channel (single TCA register write, no close
+     * in between) and the frequency is updated if it changed, then the write
+     * waits for the op's deadline. Channels are closed once at the end.
+     */
+    Result executeBatch(HapticBatchOp* ops, uint8_t count);
+
     /**
      * @brief Check which finger has mux channel pre-selected
      * @return Finger index (0-3) or -1 if none pre-selected
      */
     int8_t getPreSelectedFinger() const { return _preSelectedFinger; }
 
+    /**
+     * @brief Get I2C transaction counters (issued vs elided by shadow registers)
+     */
+    const I2CBusStats& getBusStats() const { return _busStats; }
+
+    /**
+     * @brief Reset I2C transaction counters
+     */
+    void resetBusStats();
+
 private:
     TCA9548A _tca;
     Adafruit_DRV2605 _drv[MAX_ACTUATORS];
@@ -169,9 +220,46 @@ private:
     bool _fingerEnabled[MAX_ACTUATORS];
     bool _initialized;
     int8_t _preSelectedFinger;  // Tracks which finger has mux channel pre-selected (-1 = none)
-    uint16_t _lastFrequency[MAX_ACTUATORS] = {0};  // Cached frequency per finger (skip I2C if unchanged)
     SemaphoreHandle_t _i2cMutex;  // Protects I2C operations from concurrent access
 
+    // Shadow register state: every write that would not change the device is skipped.
+    // Only writes made through writeMux()/writeDrvRegister() are tracked; library
+    // calls that touch registers internally (begin, useLRA, setMode) invalidate.
+    static constexpr uint8_t DRV_SHADOW_REG_COUNT = 0x23;  // DRV2605 registers 0x00-0x22
+    uint8_t _muxShadow;                   // Last TCA9548A control byte written
+    bool _muxShadowValid;
+    uint8_t _drvShadow[MAX_ACTUATORS][DRV_SHADOW_REG_COUNT];
+    uint64_t _drvShadowValid[MAX_ACTUATORS];  // Bit n set = _drvShadow[f][n] matches chip
+    I2CBusStats _busStats;
+
+    /**
+     * @brief Write TCA9548A control byte unless it already holds mask
+     * @param mask Channel bitmask (1 << finger, or 0 to close all)
+     * @param force Write even if shadow matches (safety paths)
+     */
+    void writeMux(uint8_t mask, bool force = false);
+
+    /**
+     * @brief Write a DRV2605 register unless the shadow proves it already holds value
+     * @note Channel for finger must already be selected
+     */
+    void writeDrvRegister(uint8_t finger, uint8_t reg, uint8_t value, bool force = false);
+
+    /**
+     * @brief Check whether a DRV2605 register is known to hold value
+     */
+    bool drvRegisterMatches(uint8_t finger, uint8_t reg, uint8_t value) const;
+
+    /**
+     * @brief Forget shadow state for one driver (after library-level register access)
+     */
+    void invalidateDrvShadow(uint8_t finger);
+
+    /**
+     * @brief Count a whole select + write + close sequence elided by the shadow
+     */
+    void countSkippedSequence();
+
     /**
      * @brief Select multiplexer channel and prepare for DRV2605 communication
      * @param finger Finger index (0-3)
@@ -0,0 +1,105 @@
+/**
+ * @file latency_histogram.h
+ * @brief Fixed-memory log-linear latency histogram with percentile queries
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * HDR-style histogram for microsecond latencies:
+ * - Values below 2 * SUB_COUNT get one bucket each (exact)
+ * - Above that, every power of two is split into SUB_COUNT linear
+ *   sub-buckets, so a bucket is at most 1/SUB_COUNT of its value wide
+ *   (6.25% with the default 4 sub-bits)
+ * - record() is O(1) with no floating point: one CLZ, a shift and an add
+ * - Negative values (early execution) use a mirrored set of buckets
+ * - Magnitudes above MAX_MAGNITUDE land in the top bucket; exact min/max
+ *   are kept separately and clamp percentile results
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+
+#ifndef LATENCY_HIST_SUB_BITS
+#define LATENCY_HIST_SUB_BITS 4         // 16 sub-buckets per power of two
+#endif
+
+#ifndef LATENCY_HIST_MAX_BITS
+#define LATENCY_HIST_MAX_BITS 17        // Magnitudes up to 131,071 us
+#endif
+
+// =============================================================================
+// LATENCY HISTOGRAM
+// =============================================================================
+
+/**
+ * @brief Log-linear histogram of signed microsecond values
+ *
+ * Usage:
+ *   histogram.record(drift_us);                  // motor task, O(1)
+ *   int32_t p99 = histogram.getPercentile(990);  // per-mille: 500, 900, 990, 999
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint8_t SUB_BITS = LATENCY_HIST_SUB_BITS;
+    static constexpr uint32_t SUB_COUNT = 1u << SUB_BITS;
+    static constexpr uint32_t MAX_MAGNITUDE = (1u << LATENCY_HIST_MAX_BITS) - 1;
+    static constexpr uint16_t BUCKETS = (LATENCY_HIST_MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+    LatencyHistogram();
+
+    /**
+     * @brief Clear all counts
+     */
+    void reset();
+
+    /**
+     * @brief Record one value (O(1), no floating point)
+     * @param value_us Value in microseconds (negative allowed)
+     */
+    void record(int32_t value_us);
+
+    /**
+     * @brief Value at a percentile (nearest rank)
+     *
+     * Returns the highest value of the bucket holding the ranked sample,
+     * clamped to the observed min/max, so the result is never below the
+     * true percentile and at most one bucket width above it. A sample in
+     * the saturated top bucket reports the observed max.
+     *
+     * @param perMille Percentile in parts per thousand (500 = p50, 999 = p99.9)
+     * @return Value in microseconds, or 0 if no samples
+     */
+    int32_t getPercentile(uint16_t perMille) const;
+
+    uint32_t getCount() const { return _count; }
+    int32_t getMin() const { return _count ? _min : 0; }
+    int32_t getMax() const { return _count ? _max : 0; }
+
+    /**
+     * @brief Bucket holding a magnitude (saturates at MAX_MAGNITUDE)
+     */
+    static uint16_t bucketIndex(uint32_t magnitude);
+
+    /**
+     * @brief Smallest magnitude in a bucket
+     */
+    static uint32_t bucketLowest(uint16_t index);
+
+    /**
+     * @brief Largest magnitude in a bucket
+     */
+    static uint32_t bucketHighest(uint16_t index);
+
+private:
+    static_assert(LATENCY_HIST_MAX_BITS > LATENCY_HIST_SUB_BITS && LATENCY_HIST_MAX_BITS <= 31,
+                  "LATENCY_HIST_MAX_BITS must be in (SUB_BITS, 31]");
+
+    uint32_t _positive[BUCKETS];    // value >= 0, by magnitude
+    uint32_t _negative[BUCKETS];    // value < 0, by magnitude
+    uint32_t _count;
+    int32_t _min;
+    int32_t _max;
+};
+
+#endif // LATENCY_HISTOGRAM_H
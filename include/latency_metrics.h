@@ -5,6 +5,16 @@
  *
  * Provides runtime-toggleable latency metrics collection for measuring
  * execution drift and BLE timing across PRIMARY/SECONDARY gloves.
+ *
+ * Threading: each recording context owns a shard it alone writes.
+ * - Execution shard: motor task (recordExecution, recordSpinWait)
+ * - RTT shard: BLE callback (recordRtt)
+ * - Everything else: loop()
+ * The motor task and BLE shards are guarded by a SeqLock: the writer never
+ * waits, and loop() readers take consistent snapshots (no torn 64-bit sums,
+ * no min/max/count from different samples). reset() never touches those
+ * shards - it bumps an epoch and each writer clears its own shard on its
+ * next sample; until then readers see the shard as empty.
  */
 
 #ifndef LATENCY_METRICS_H
@@ -12,17 +22,97 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include <atomic>
+#include "config.h"
+#include "latency_histogram.h"
+#include "seqlock.h"
 
 // Forward declaration for config constants
 #ifndef LATENCY_LATE_THRESHOLD_US
 #define LATENCY_LATE_THRESHOLD_US 1000  // >1ms considered "late"
 #endif
 
+#define LATENCY_NO_FINGER 0xFF         // recordExecution(): no per-finger stats
+
+#ifndef LATENCY_SKEW_WINDOW
+#define LATENCY_SKEW_WINDOW 256         // Recent |skew| samples kept for p99
+#endif
+
+/**
+ * @brief Execution drift and motor dispatch statistics (motor task shard)
+ */
+struct LatencyExecutionStats {
+    // Execution drift (actual - scheduled, microseconds)
+    int32_t lastDrift_us;   ///< Most recent execution drift
+    int32_t minDrift_us;    ///< Minimum observed drift
+    int32_t maxDrift_us;    ///< Maximum observed drift
+    int64_t totalDrift_us;  ///< Sum of all drifts (for average calculation)
+    uint32_t sampleCount;   ///< Number of execution samples
+
+    // Late/early tracking
+    uint32_t lateCount;     ///< Count of executions with drift > threshold
+    uint32_t earlyCount;    ///< Count of executions with negative drift
+
+    // Motor dispatch (time spent spinning before each event)
+    uint32_t spinWaitCount;     ///< Number of events that ended in a spin-wait
+    uint32_t maxSpinWait_us;    ///< Longest single spin-wait
+    uint64_t totalSpinWait_us;  ///< Sum of spin-wait time (CPU burned at priority 4)
+
+    void clear();
+
+    /**
+     * @brief Average execution drift, or 0 if no samples
+     */
+    int32_t getAverageDrift() const;
+
+    /**
+     * @brief Execution jitter (max - min drift), or 0 if no samples
+     */
+    uint32_t getJitter() const;
+
+    /**
+     * @brief Average spin-wait per dispatched event, or 0 if no samples
+     */
+    uint32_t getAverageSpinWait() const;
+};
+
+/**
+ * @brief Ongoing BLE RTT statistics (BLE callback shard)
+ */
+struct LatencyRttStats {
+    uint32_t lastRtt_us;    ///< Most recent RTT measurement
+    uint32_t minRtt_us;     ///< Minimum observed RTT (best latency estimate)
+    uint32_t maxRtt_us;     ///< Maximum observed RTT
+    uint64_t totalRtt_us;   ///< Sum of all RTTs (for average calculation)
+    uint32_t rttSampleCount;///< Number of RTT samples
+
+    void clear();
+
+    /**
+     * @brief Average RTT, or 0 if no samples
+     */
+    uint32_t getAverageRtt() const;
+};
+
+/**
+ * @brief Percentiles of one histogram, all taken from the same snapshot
+ */
+struct LatencyPercentiles {
+    uint32_t count;     ///< Samples (0: every value below is 0)
+    int32_t min_us;
+    int32_t p50_us;
+    int32_t p90_us;
+    int32_t p99_us;
+    int32_t p999_us;
+    int32_t max_us;
+};
+
 /**
  * @brief Latency metrics collection and reporting
  *
  * Tracks execution drift (actual vs scheduled time), BLE RTT timing,
- * and sync quality metrics from initial RTT probing.
+ * and sync quality metrics from initial RTT probing. Drift and RTT also
+ * feed log-linear histograms for p50/p90/p99/p99.9.
  */
 struct LatencyMetrics {
     // ==========================================================================
@@ -33,28 +123,28 @@ struct LatencyMetrics {
     bool verboseLogging;    ///< Whether to log each individual buzz
 
     // ==========================================================================
-    // EXECUTION DRIFT (actual - scheduled, microseconds)
+    // MACROCYCLE START (lockstep IDLE step, PRIMARY only)
     // ==========================================================================
 
-    int32_t lastDrift_us;   ///< Most recent execution drift
-    int32_t minDrift_us;    ///< Minimum observed drift
-    int32_t maxDrift_us;    ///< Maximum observed drift
-    int64_t totalDrift_us;  ///< Sum of all drifts (for average calculation)
-    uint32_t sampleCount;   ///< Number of execution samples
-
-    // Late/early tracking
-    uint32_t lateCount;     ///< Count of executions with drift > threshold
-    uint32_t earlyCount;    ///< Count of executions with negative drift
+    uint32_t idlePrecomputedCount;      ///< IDLE steps that used a precomputed macrocycle
+    uint32_t maxIdlePrecomputed_us;     ///< Longest precomputed IDLE step
+    uint64_t totalIdlePrecomputed_us;   ///< Sum of precomputed IDLE step times
+    uint32_t idleInlineCount;           ///< IDLE steps that generated the macrocycle inline
+    uint32_t maxIdleInline_us;          ///< Longest inline-generation IDLE step
+    uint64_t totalIdleInline_us;        ///< Sum of inline-generation IDLE step times
 
     // ==========================================================================
-    // BLE RTT TIMING (ongoing, PRIMARY only)
+    // BILATERAL SKEW (SECONDARY start - PRIMARY start per event, PRIMARY only)
     // ==========================================================================
 
-    uint32_t lastRtt_us;    ///< Most recent RTT measurement
-    uint32_t minRtt_us;     ///< Minimum observed RTT (best latency estimate)
-    uint32_t maxRtt_us;     ///< Maximum observed RTT
-    uint64_t totalRtt_us;   ///< Sum of all RTTs (for average calculation)
-    uint32_t rttSampleCount;///< Number of RTT samples
+    // Written by loop() with interrupts disabled: SKEW_STATUS reads these
+    // from the BLE callback, which can preempt loop()
+    int32_t minSkew_us;         ///< Most negative skew (SECONDARY earliest)
+    int32_t maxSkew_us;         ///< Most positive skew (SECONDARY latest)
+    int64_t totalSkew_us;       ///< Sum of all skews (for average calculation)
+    uint32_t skewSampleCount;   ///< Number of per-event skew samples
+    uint16_t recentAbsSkew_us[LATENCY_SKEW_WINDOW]; ///< Ring of recent |skew| (saturated)
+    uint16_t recentSkewHead;    ///< Next write position in recentAbsSkew_us
 
     // ==========================================================================
     // SYNC QUALITY (from initial RTT probing)
@@ -70,8 +160,13 @@ struct LatencyMetrics {
     // METHODS
     // ==========================================================================
 
+    LatencyMetrics();
+
     /**
      * @brief Reset all metrics to initial state
+     *
+     * Call from loop(). Motor task and BLE shards read as empty from here
+     * on and are cleared by their writers on the next sample.
      */
     void reset();
 
@@ -88,12 +183,43 @@ struct LatencyMetrics {
 
     /**
      * @brief Record an execution drift measurement
+     *
+     * O(1), no floating point (called from the motor task).
+     *
      * @param drift_us Drift in microseconds (actual - scheduled)
+     * @param activate True for ACTIVATE, false for DEACTIVATE
+     * @param finger Finger index, or LATENCY_NO_FINGER to skip per-finger stats
+     */
+    void recordExecution(int32_t drift_us, bool activate = true,
+                         uint8_t finger = LATENCY_NO_FINGER);
+
+    /**
+     * @brief Record time the motor task spun before dispatching an event
+     *
+     * Motor task only (same shard as recordExecution).
+     *
+     * @param spin_us Spin duration in microseconds
+     */
+    void recordSpinWait(uint32_t spin_us);
+
+    /**
+     * @brief Record how long a lockstep IDLE step took
+     * @param step_us Step duration in microseconds
+     * @param precomputed True if the macrocycle was generated during the previous relax
+     */
+    void recordIdleStep(uint32_t step_us, bool precomputed);
+
+    /**
+     * @brief Record one event's bilateral skew (from MACROCYCLE_ACK feedback)
+     * @param skew_us SECONDARY start - PRIMARY start in microseconds
      */
-    void recordExecution(int32_t drift_us);
+    void recordBilateralSkew(int32_t skew_us);
 
     /**
      * @brief Record an RTT measurement (ongoing, during therapy)
+     *
+     * BLE callback only (the RTT shard's single writer).
+     *
      * @param rtt_us Round-trip time in microseconds
      */
     void recordRtt(uint32_t rtt_us);
@@ -110,6 +236,38 @@ struct LatencyMetrics {
      */
     void finalizeSyncProbing(int64_t offset_us);
 
+    /**
+     * @brief Consistent snapshot of execution drift and dispatch stats
+     *
+     * Lock-free; retries while the motor task is writing. Must not be
+     * called from a context that can preempt the motor task.
+     */
+    LatencyExecutionStats getExecutionStats() const;
+
+    /**
+     * @brief Consistent snapshot of ongoing RTT stats
+     *
+     * Lock-free; retries while the BLE callback is writing. Call from loop().
+     */
+    LatencyRttStats getRttStats() const;
+
+    /**
+     * @brief Drift percentiles for one event type, all fingers
+     * @param activate ACTIVATE (true) or DEACTIVATE (false)
+     */
+    LatencyPercentiles getDriftPercentiles(bool activate) const;
+
+    /**
+     * @brief ACTIVATE drift percentiles for one finger
+     * @param finger Finger index (< MAX_ACTUATORS, else all zero)
+     */
+    LatencyPercentiles getFingerDriftPercentiles(uint8_t finger) const;
+
+    /**
+     * @brief Ongoing RTT percentiles
+     */
+    LatencyPercentiles getRttPercentiles() const;
+
     /**
      * @brief Get average execution drift
      * @return Average drift in microseconds, or 0 if no samples
@@ -122,6 +280,31 @@ struct LatencyMetrics {
      */
     uint32_t getAverageRtt() const;
 
+    /**
+     * @brief Get average spin-wait per dispatched event
+     * @return Average spin in microseconds, or 0 if no samples
+     */
+    uint32_t getAverageSpinWait() const;
+
+    /**
+     * @brief Get average lockstep IDLE step time
+     * @param precomputed Average precomputed (true) or inline-generation (false) steps
+     * @return Average step in microseconds, or 0 if no samples
+     */
+    uint32_t getAverageIdleStep(bool precomputed) const;
+
+    /**
+     * @brief Get average bilateral skew
+     * @return Average skew in microseconds, or 0 if no samples
+     */
+    int32_t getAverageSkew() const;
+
+    /**
+     * @brief Get 99th percentile of |skew| over the last LATENCY_SKEW_WINDOW events
+     * @return p99 |skew| in microseconds, or 0 if no samples
+     */
+    uint32_t getSkewP99Abs() const;
+
     /**
      * @brief Get execution jitter (max - min drift)
      * @return Jitter in microseconds
@@ -138,6 +321,32 @@ struct LatencyMetrics {
      * @brief Print full metrics report to Serial
      */
     void printReport() const;
+
+private:
+    struct ExecutionShard {
+        SeqLock lock;
+        uint32_t epoch;                                 ///< _resetEpoch last cleared for
+        LatencyExecutionStats stats;
+        LatencyHistogram activateDrift;                 ///< ACTIVATE drift, all fingers
+        LatencyHistogram deactivateDrift;               ///< DEACTIVATE drift, all fingers
+        LatencyHistogram fingerDrift[MAX_ACTUATORS];    ///< ACTIVATE drift per finger
+    };
+
+    struct RttShard {
+        SeqLock lock;
+        uint32_t epoch;                                 ///< _resetEpoch last cleared for
+        LatencyRttStats stats;
+        LatencyHistogram histogram;
+    };
+
+    ExecutionShard _execution;          ///< Written by the motor task only
+    RttShard _rtt;                      ///< Written by the BLE callback only
+    std::atomic<uint32_t> _resetEpoch;  ///< Bumped by reset()
+
+    void beginExecutionWrite();
+    void beginRttWrite();
+    LatencyPercentiles readPercentiles(const SeqLock& lock, const uint32_t& shardEpoch,
+                                       const LatencyHistogram& histogram) const;
 };
 
 // Global instance declaration (defined in latency_metrics.cpp)
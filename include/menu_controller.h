@@ -10,6 +10,7 @@
  * - Session: SESSION_START, SESSION_PAUSE, SESSION_RESUME, SESSION_STOP, SESSION_STATUS
  * - Parameters: PARAM_SET
  * - Calibration: CALIBRATE_START, CALIBRATE_BUZZ, CALIBRATE_STOP
+ * - Status push: SUBSCRIBE
  * - System: HELP, RESTART
  */
 
@@ -19,6 +20,7 @@
 #include <Arduino.h>
 #include "types.h"
 #include "config.h"
+#include "command_parser.h"
 
 // Forward declarations
 class TherapyEngine;
@@ -27,6 +29,7 @@ class HapticController;
 class TherapyStateMachine;
 class ProfileManager;
 class BLEManager;
+class StatusPublisher;
 
 // =============================================================================
 // CONSTANTS
@@ -38,20 +41,6 @@ class BLEManager;
 // Response buffer size
 #define RESPONSE_BUFFER_SIZE 512
 
-// Parameter buffer size
-#define PARAM_BUFFER_SIZE 64
-
-// Maximum parameters per command
-#define MAX_COMMAND_PARAMS 16
-
-// =============================================================================
-// INTERNAL MESSAGE PREFIXES
-// =============================================================================
-
-// Messages that should be passed through without menu processing
-extern const char* INTERNAL_MESSAGES[];
-extern const uint8_t INTERNAL_MESSAGE_COUNT;
-
 // =============================================================================
 // CALLBACK TYPES
 // =============================================================================
@@ -75,7 +64,7 @@ typedef void (*RestartCallback)();
  *
  * Handles:
  * - Command parsing from BLE strings
- * - All 18 protocol command handlers
+ * - All 19 protocol command handlers
  * - Response formatting (KEY:VALUE with EOT)
  * - Error handling
  * - Internal message pass-through
@@ -131,6 +120,11 @@ public:
      */
     void setRestartCallback(RestartCallback callback);
 
+    /**
+     * @brief Set publisher driven by SUBSCRIBE (PRIMARY only)
+     */
+    void setStatusPublisher(StatusPublisher* publisher);
+
     // =========================================================================
     // COMMAND PROCESSING
     // =========================================================================
@@ -142,6 +136,13 @@ public:
      */
     bool handleCommand(const char* message);
 
+    /**
+     * @brief Handle an already-tokenized command (see command_parser.h)
+     * @param tokens Tokens of the message (message buffer still valid)
+     * @return true if command was processed
+     */
+    bool handleCommand(const CommandTokens& tokens);
+
     /**
      * @brief Check if message is an internal sync message
      * @param message Message to check
@@ -166,6 +167,7 @@ private:
     TherapyStateMachine* _stateMachine;
     ProfileManager* _profiles;
     BLEManager* _ble;
+    StatusPublisher* _publisher;
 
     // Device info
     DeviceRole _role;
@@ -183,19 +185,8 @@ private:
     // Response buffer
     char _responseBuffer[RESPONSE_BUFFER_SIZE];
 
-    // =========================================================================
-    // COMMAND PARSING
-    // =========================================================================
-
-    /**
-     * @brief Parse command and extract parameters
-     * @param message Input message
-     * @param command Output command name (uppercase)
-     * @param params Output parameter array
-     * @param paramCount Output parameter count
-     * @return true if parsing successful
-     */
-    bool parseCommand(const char* message, char* command, char params[][PARAM_BUFFER_SIZE], uint8_t& paramCount);
+    // Command handler (dispatched by name from a sorted table in handleCommand)
+    typedef void (MenuController::*CommandHandler)(const CommandTokens& tokens);
 
     // =========================================================================
     // RESPONSE FORMATTING
@@ -227,32 +218,34 @@ private:
     // COMMAND HANDLERS
     // =========================================================================
 
-    void handleInfo();
-    void handleBattery();
-    void handlePing();
+    void handleInfo(const CommandTokens& tokens);
+    void handleBattery(const CommandTokens& tokens);
+    void handlePing(const CommandTokens& tokens);
 
-    void handleProfileList();
-    void handleProfileLoad(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
-    void handleProfileGet();
-    void handleProfileCustom(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
+    void handleProfileList(const CommandTokens& tokens);
+    void handleProfileLoad(const CommandTokens& tokens);
+    void handleProfileGet(const CommandTokens& tokens);
+    void handleProfileCustom(const CommandTokens& tokens);
 
-    void handleSessionStart();
-    void handleSessionPause();
-    void handleSessionResume();
-    void handleSessionStop();
-    void handleSessionStatus();
+    void handleSessionStart(const CommandTokens& tokens);
+    void handleSessionPause(const CommandTokens& tokens);
+    void handleSessionResume(const CommandTokens& tokens);
+    void handleSessionStop(const CommandTokens& tokens);
+    void handleSessionStatus(const CommandTokens& tokens);
+    void handleSkewStatus(const CommandTokens& tokens);
+    void handleSubscribe(const CommandTokens& tokens);
 
-    void handleParamSet(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
+    void handleParamSet(const CommandTokens& tokens);
 
-    void handleCalibrateStart();
-    void handleCalibrateBuzz(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
-    void handleCalibrateStop();
+    void handleCalibrateStart(const CommandTokens& tokens);
+    void handleCalibrateBuzz(const CommandTokens& tokens);
+    void handleCalibrateStop(const CommandTokens& tokens);
 
-    void handleHelp();
-    void handleRestart();
+    void handleHelp(const CommandTokens& tokens);
+    void handleRestart(const CommandTokens& tokens);
 
-    void handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
-    void handleDebug(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount);
+    void handleTherapyLedOff(const CommandTokens& tokens);
+    void handleDebug(const CommandTokens& tokens);
 };
 
 #endif // MENU_CONTROLLER_H
@@ -1,18 +1,20 @@
 /**
  * @file motor_event_buffer.h
- * @brief Lock-free motor event staging buffer for BLE callback -> main loop
- * @version 1.0.0
+ * @brief Lock-free motor event staging buffer for BLE callback -> motor task
+ * @version 1.1.0
  * @platform Adafruit Feather nRF52840 Express
  *
  * TP-1: Provides ISR-safe staging of motor events from BLE callbacks.
  * Events are staged without mutex acquisition, then forwarded to
- * ActivationQueue in the main loop context.
+ * ActivationQueue by the motor task (no hop through loop()).
  *
  * Design:
  * - Lock-free SPSC (single-producer, single-consumer) ring buffer
  * - BLE callbacks (producer) write via stage()
- * - Main loop (consumer) reads via unstage()
- * - Memory barriers (DMB) ensure ARM memory ordering
+ * - Motor task (consumer) reads via unstage()
+ * - Acquire/release atomics on head/tail: payload writes are published by the
+ *   release store of _head and observed after the acquire load (GCC emits
+ *   DMB on Cortex-M4), slot reuse is gated the same way through _tail
  */
 
 #ifndef MOTOR_EVENT_BUFFER_H
@@ -20,6 +22,8 @@
 
 #include <Arduino.h>
 #include <stdint.h>
+#include <atomic>
+#include "config.h"
 
 // =============================================================================
 // STAGED MOTOR EVENT
@@ -37,8 +41,9 @@ struct StagedMotorEvent {
     uint8_t amplitude;         // Amplitude percentage (0-100)
     uint16_t durationMs;       // Duration in milliseconds
     uint16_t frequencyHz;      // Frequency in Hz
+    bool isMacrocycleFirst;    // True if this is the first event of a new macrocycle batch
     bool isMacrocycleLast;     // True if this is the last event in a macrocycle batch
-    volatile bool valid;       // Marks slot as ready for consumption
+    bool valid;                // Set on unstaged copies (ownership is tracked by head/tail)
 
     StagedMotorEvent() :
         activateTimeUs(0),
@@ -46,6 +51,7 @@ struct StagedMotorEvent {
         amplitude(0),
         durationMs(0),
         frequencyHz(0),
+        isMacrocycleFirst(false),
         isMacrocycleLast(false),
         valid(false) {}
 
@@ -55,6 +61,7 @@ struct StagedMotorEvent {
         amplitude = 0;
         durationMs = 0;
         frequencyHz = 0;
+        isMacrocycleFirst = false;
         isMacrocycleLast = false;
         valid = false;
     }
@@ -69,27 +76,31 @@ struct StagedMotorEvent {
  *
  * Uses SPSC (single-producer, single-consumer) model:
  * - Producer: BLE callbacks (ISR context)
- * - Consumer: Main loop
+ * - Consumer: Motor task
  *
  * Thread safety:
- * - stage() is ISR-safe (no mutex, uses memory barriers)
- * - unstage() is main-loop-only (no mutex needed)
+ * - stage()/beginMacrocycle() are producer-only and ISR-safe (no mutex)
+ * - unstage() is consumer-only (no mutex needed)
  * - hasPending() is safe from any context
  *
  * Usage:
  *   // In BLE callback:
  *   motorEventBuffer.stage(timeUs, finger, amp, dur, freq);
+ *   activationQueue.notifyMotorTask();
  *
- *   // In main loop():
+ *   // In motor task:
  *   StagedMotorEvent event;
  *   while (motorEventBuffer.unstage(event)) {
+ *       if (event.isMacrocycleFirst) activationQueue.clear();
  *       activationQueue.enqueue(event.activateTimeUs, event.finger,
  *                               event.amplitude, event.durationMs, event.frequencyHz);
  *   }
  */
 class MotorEventBuffer {
 public:
-    static constexpr uint8_t MAX_STAGED = 16;  // Power of 2 for efficient modulo
+    // Power of 2 for efficient modulo. One 12-event macrocycle fits in 16; pipelined
+    // mode can deliver several back-to-back before the motor task drains them.
+    static constexpr uint8_t MAX_STAGED = (MACROCYCLE_PIPELINE_DEPTH > 1) ? 32 : 16;
 
     MotorEventBuffer();
 
@@ -113,7 +124,9 @@ public:
      * @brief Begin a new macrocycle batch (ISR-safe)
      *
      * Sets flag indicating incoming events are part of a macrocycle.
-     * Main loop will clear the activation queue before processing these events.
+     * The next staged event is tagged isMacrocycleFirst so the consumer
+     * clears the activation queue exactly once, even if it drains the
+     * batch while the producer is still staging it.
      */
     void beginMacrocycle();
 
@@ -125,9 +138,9 @@ public:
     bool isMacrocyclePending() const;
 
     /**
-     * @brief Unstage the next pending event (main loop only)
+     * @brief Unstage the next pending event (consumer only)
      *
-     * Must only be called from main loop context.
+     * Must only be called from the single consumer context (motor task).
      *
      * @param event Output: The unstaged event data
      * @return true if an event was unstaged, false if buffer empty
@@ -155,15 +168,19 @@ public:
     /**
      * @brief Clear all pending events
      *
-     * Should only be called from main loop when no staging is occurring.
+     * Should only be called when neither producer nor consumer is running.
      */
     void clear();
 
 private:
+    static_assert((MAX_STAGED & (MAX_STAGED - 1)) == 0, "MAX_STAGED must be a power of 2");
+    static_assert(std::atomic<uint8_t>::is_always_lock_free, "head/tail must be lock-free (ISR producer)");
+
     StagedMotorEvent _buffer[MAX_STAGED];
-    volatile uint8_t _head;  // Next write position (producer)
-    volatile uint8_t _tail;  // Next read position (consumer)
-    volatile bool _macrocyclePending;  // True when macrocycle batch needs processing
+    std::atomic<uint8_t> _head;  // Next write position (written by producer only)
+    std::atomic<uint8_t> _tail;  // Next read position (written by consumer only)
+    std::atomic<bool> _macrocyclePending;  // True when macrocycle batch needs processing
+    bool _nextIsMacrocycleFirst;  // Producer-private: tag next staged event
 };
 
 // =============================================================================
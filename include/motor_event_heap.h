@@ -0,0 +1,175 @@
+/**
+ * @file motor_event_heap.h
+ * @brief Fixed-capacity earliest-deadline min-heap for motor events
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * Backing store for ActivationQueue. Replaces the 32-slot linear scans
+ * (findEmptySlot/findNextEvent) with a binary min-heap:
+ * - peek():  O(1)  - earliest event is always at the root
+ * - push():  O(log n)
+ * - pop():   O(log n)
+ *
+ * Ordering: events are ordered by timeUs, ties broken by insertion order
+ * (FIFO), so two events scheduled for the same microsecond execute in the
+ * order they were enqueued - e.g. DEACTIVATE(F0) before ACTIVATE(F1).
+ *
+ * Thread Safety: NOT thread-safe. ActivationQueue serializes access with
+ * its FreeRTOS mutex. Kept free of RTOS dependencies so it can be unit
+ * tested and benchmarked natively.
+ */
+
+#ifndef MOTOR_EVENT_HEAP_H
+#define MOTOR_EVENT_HEAP_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "config.h"
+#include "types.h"
+
+// =============================================================================
+// MOTOR EVENT
+// =============================================================================
+
+/**
+ * @brief Type of motor event
+ */
+enum class MotorEventType : uint8_t {
+    ACTIVATE,    // Turn motor ON
+    DEACTIVATE   // Turn motor OFF
+};
+
+/**
+ * @brief Single scheduled motor event (activation or deactivation)
+ *
+ * NOTE: This struct is accessed from multiple contexts (main loop, BLE callbacks,
+ * motor task). The `active` flag is marked volatile to prevent cache issues.
+ */
+struct MotorEvent {
+    uint64_t timeUs;        // Event time (local clock, microseconds)
+    uint8_t  finger;        // Motor index (0-3)
+    uint8_t  amplitude;     // Intensity (0-100), only used for ACTIVATE
+    uint16_t frequencyHz;   // Motor frequency, only used for ACTIVATE
+    MotorEventType type;    // ACTIVATE or DEACTIVATE
+    volatile bool active;   // Slot in use (volatile: accessed from multiple contexts)
+
+    MotorEvent()
+        : timeUs(0)
+        , finger(0)
+        , amplitude(0)
+        , frequencyHz(250)
+        , type(MotorEventType::ACTIVATE)
+        , active(false) {}
+
+    void clear() {
+        timeUs = 0;
+        finger = 0;
+        amplitude = 0;
+        frequencyHz = 250;
+        type = MotorEventType::ACTIVATE;
+        active = false;
+    }
+};
+
+// =============================================================================
+// MOTOR EVENT HEAP
+// =============================================================================
+
+/**
+ * @class MotorEventHeap
+ * @brief Binary min-heap of MotorEvents keyed on (timeUs, insertion order)
+ *
+ * Usage:
+ *   MotorEventHeap heap;
+ *   heap.push(event);
+ *   const MotorEvent* next = heap.peek();   // nullptr if empty
+ *   MotorEvent out;
+ *   heap.pop(out);
+ */
+class MotorEventHeap {
+public:
+    // Per in-flight macrocycle: 12 activations + 12 deactivations, plus margin
+    // (32 in lockstep mode, MACROCYCLE_PIPELINE_DEPTH > 1 scales it up)
+    static constexpr uint8_t CAPACITY = MACROCYCLE_PIPELINE_DEPTH * MACROCYCLE_MAX_EVENTS * 2 + 8;
+
+    MotorEventHeap();
+
+    /**
+     * @brief Remove all events and reset insertion ordering
+     */
+    void clear();
+
+    /**
+     * @brief Insert an event
+     * @param event Event to insert (stored with active = true)
+     * @return true if inserted, false if heap full
+     */
+    bool push(const MotorEvent& event);
+
+    /**
+     * @brief Earliest event without removing it
+     * @return Pointer to root event, or nullptr if empty (valid until next mutation)
+     */
+    const MotorEvent* peek() const {
+        return (_size > 0) ? &_events[0] : nullptr;
+    }
+
+    /**
+     * @brief Remove the earliest event
+     * @param event Output: the removed event
+     * @return true if an event was removed, false if empty
+     */
+    bool pop(MotorEvent& event);
+
+    /**
+     * @brief Remove the earliest event plus every event due within a window of it
+     * @param out Output array, filled in dequeue (deadline, then FIFO) order
+     * @param maxCount Capacity of out
+     * @param windowUs Events with timeUs <= first.timeUs + windowUs are included
+     * @return Number of events removed (0 if empty)
+     */
+    uint8_t popWithin(MotorEvent* out, uint8_t maxCount, uint32_t windowUs);
+
+    /**
+     * @brief Number of events in the heap
+     */
+    uint8_t size() const { return _size; }
+
+    /**
+     * @brief Remaining capacity
+     */
+    uint8_t available() const { return static_cast<uint8_t>(CAPACITY - _size); }
+
+    bool isEmpty() const { return _size == 0; }
+
+private:
+    static_assert(MACROCYCLE_PIPELINE_DEPTH >= 1 && MACROCYCLE_PIPELINE_DEPTH <= MACROCYCLE_PIPELINE_MAX_DEPTH,
+                  "MACROCYCLE_PIPELINE_DEPTH out of range");
+
+    // Parallel arrays: keeping the tie-break counter out of MotorEvent avoids
+    // padding each entry to 24 bytes (8-byte alignment of timeUs)
+    MotorEvent _events[CAPACITY];
+    uint32_t _order[CAPACITY];      // Insertion sequence for FIFO tie-break
+    uint8_t _size;
+    uint32_t _nextOrder;
+
+    /**
+     * @brief Heap ordering: earlier time first, then earlier insertion
+     * Order comparison is wrap-safe (signed difference).
+     */
+    static bool before(uint64_t timeA, uint32_t orderA, uint64_t timeB, uint32_t orderB) {
+        if (timeA != timeB) {
+            return timeA < timeB;
+        }
+        return static_cast<int32_t>(orderA - orderB) < 0;
+    }
+
+    bool before(uint8_t a, uint8_t b) const {
+        return before(_events[a].timeUs, _order[a], _events[b].timeUs, _order[b]);
+    }
+
+    void siftUp(uint8_t pos);
+    void siftDown(uint8_t pos);
+};
+
+#endif // MOTOR_EVENT_HEAP_H
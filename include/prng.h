@@ -0,0 +1,78 @@
+/**
+ * @file prng.h
+ * @brief Seedable xoshiro128++ generator for reproducible pattern generation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * Small, fast PRNG with explicit state (no hidden globals like Arduino
+ * random()), so two devices seeded identically draw identical sequences:
+ * - xoshiro128++: 128-bit state, 32-bit output, a handful of adds/xors/
+ *   rotates per draw - cheap on the Cortex-M4
+ * - seed(): expands a 64-bit seed with SplitMix64 (never all-zero state)
+ * - forStream(): random access by (seed, stream index). The state for
+ *   stream N is derived by hashing, so macrocycle N can be generated
+ *   without drawing (or jumping over) streams 0..N-1
+ * - below()/range(): unbiased bounded draws (Lemire's multiply-shift with
+ *   rejection); the divide only runs on the rare rejection path
+ */
+
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <stdint.h>
+
+// =============================================================================
+// PRNG
+// =============================================================================
+
+/**
+ * @brief xoshiro128++ pseudo-random generator
+ *
+ * Usage:
+ *   Prng rng = Prng::forStream(sessionSeed, macrocycleSequenceId);
+ *   long jitter = rng.range(-1000, 1001);
+ */
+class Prng {
+public:
+    Prng();
+    explicit Prng(uint64_t seedValue);
+
+    /**
+     * @brief Reset state from a 64-bit seed (any value, including 0)
+     */
+    void seed(uint64_t seedValue);
+
+    /**
+     * @brief Generator for an independent stream of a seed
+     * @param seedValue Session seed
+     * @param stream Stream index (e.g. macrocycle sequence ID)
+     */
+    static Prng forStream(uint64_t seedValue, uint32_t stream);
+
+    /**
+     * @brief Next raw 32-bit output
+     */
+    uint32_t next();
+
+    /**
+     * @brief Unbiased integer in [0, bound)
+     * @return 0 if bound is 0
+     */
+    uint32_t below(uint32_t bound);
+
+    /**
+     * @brief Unbiased integer in [min, max), drop-in for Arduino random(min, max)
+     * @return min if max <= min
+     */
+    long range(long min, long max);
+
+    /**
+     * @brief SplitMix64 finalizer (bijective 64-bit mix)
+     */
+    static uint64_t mix64(uint64_t x);
+
+private:
+    uint32_t _s[4];
+};
+
+#endif // PRNG_H
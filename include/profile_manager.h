@@ -17,6 +17,7 @@
 #include <Arduino.h>
 #include "types.h"
 #include "config.h"
+#include "flash_write_scheduler.h"
 
 // =============================================================================
 // CONSTANTS
@@ -34,7 +35,8 @@
 // Pattern type string max length
 #define PATTERN_TYPE_MAX 16
 
-// Settings file path and format
+// Settings file path and format (v1: whole-struct file, migrated to the
+// journal in settings_journal.h on first load)
 #define SETTINGS_FILE "/settings.bin"
 #define SETTINGS_MAGIC 0xBB
 #define SETTINGS_VERSION 1
@@ -81,110 +83,41 @@ struct __attribute__((packed)) SettingsData {
  * - Actuator settings (type, frequency)
  * - Timing parameters (on/off times, jitter)
  * - Session settings (duration, pattern)
+ *
+ * Strings point to literals (built-in profile table and pattern names), so
+ * the built-in profiles are constexpr and live in flash, and the working
+ * copy in ProfileManager holds only the tunable values.
  */
 struct TherapyProfile {
-    char name[PROFILE_NAME_MAX];
-    char description[PROFILE_DESC_MAX];
+    const char* name = "default";
+    const char* description = "Default profile";
 
     // Actuator settings
-    ActuatorType actuatorType;
-    uint16_t frequencyHz;
+    ActuatorType actuatorType = ActuatorType::LRA;
+    uint16_t frequencyHz = 250;
 
     // Timing parameters
-    float timeOnMs;
-    float timeOffMs;
-    float jitterPercent;
+    float timeOnMs = 100.0f;
+    float timeOffMs = 67.0f;
+    float jitterPercent = 23.5f;
 
     // Amplitude settings
-    uint8_t amplitudeMin;
-    uint8_t amplitudeMax;
+    uint8_t amplitudeMin = 100;
+    uint8_t amplitudeMax = 100;
 
     // Session settings
-    uint16_t sessionDurationMin;  // Duration in minutes
-    char patternType[PATTERN_TYPE_MAX];
-    bool mirrorPattern;
-    uint8_t numFingers;
+    uint16_t sessionDurationMin = 120;  // Duration in minutes (default 2 hours)
+    const char* patternType = "rndp";   // "rndp", "sequential", "mirrored"
+    bool mirrorPattern = true;
+    uint8_t numFingers = 4;
 
     // Metadata
-    bool isDefault;
+    bool isDefault = false;
 
     // Frequency randomization (Custom vCR feature)
-    bool frequencyRandomization;
-    uint16_t frequencyMin;  // Min frequency for randomization (Hz)
-    uint16_t frequencyMax;  // Max frequency for randomization (Hz)
-
-    /**
-     * @brief Default constructor with noisy vCR defaults
-     */
-    TherapyProfile() :
-        actuatorType(ActuatorType::LRA),
-        frequencyHz(250),
-        timeOnMs(100.0f),
-        timeOffMs(67.0f),
-        jitterPercent(23.5f),
-        amplitudeMin(100),
-        amplitudeMax(100),
-        sessionDurationMin(120),  // 2 hours
-        mirrorPattern(true),
-        numFingers(4),
-        isDefault(false),
-        frequencyRandomization(false),
-        frequencyMin(210),
-        frequencyMax(260)
-    {
-        strcpy(name, "default");
-        strcpy(description, "Default profile");
-        strcpy(patternType, "rndp");
-    }
-
-    /**
-     * @brief Copy constructor
-     */
-    TherapyProfile(const TherapyProfile& other) {
-        strcpy(name, other.name);
-        strcpy(description, other.description);
-        strcpy(patternType, other.patternType);
-        actuatorType = other.actuatorType;
-        frequencyHz = other.frequencyHz;
-        timeOnMs = other.timeOnMs;
-        timeOffMs = other.timeOffMs;
-        jitterPercent = other.jitterPercent;
-        amplitudeMin = other.amplitudeMin;
-        amplitudeMax = other.amplitudeMax;
-        sessionDurationMin = other.sessionDurationMin;
-        mirrorPattern = other.mirrorPattern;
-        numFingers = other.numFingers;
-        isDefault = other.isDefault;
-        frequencyRandomization = other.frequencyRandomization;
-        frequencyMin = other.frequencyMin;
-        frequencyMax = other.frequencyMax;
-    }
-
-    /**
-     * @brief Assignment operator
-     */
-    TherapyProfile& operator=(const TherapyProfile& other) {
-        if (this != &other) {
-            strcpy(name, other.name);
-            strcpy(description, other.description);
-            strcpy(patternType, other.patternType);
-            actuatorType = other.actuatorType;
-            frequencyHz = other.frequencyHz;
-            timeOnMs = other.timeOnMs;
-            timeOffMs = other.timeOffMs;
-            jitterPercent = other.jitterPercent;
-            amplitudeMin = other.amplitudeMin;
-            amplitudeMax = other.amplitudeMax;
-            sessionDurationMin = other.sessionDurationMin;
-            mirrorPattern = other.mirrorPattern;
-            numFingers = other.numFingers;
-            isDefault = other.isDefault;
-            frequencyRandomization = other.frequencyRandomization;
-            frequencyMin = other.frequencyMin;
-            frequencyMax = other.frequencyMax;
-        }
-        return *this;
-    }
+    bool frequencyRandomization = false;
+    uint16_t frequencyMin = 210;  // Min frequency for randomization (Hz)
+    uint16_t frequencyMax = 260;  // Max frequency for randomization (Hz)
 };
 
 // =============================================================================
@@ -306,16 +239,67 @@ public:
 
     /**
      * @brief Save current profile settings to LittleFS
+     *
+     * Appends a journal record for each field changed since the last save
+     * (nothing is written if none changed). Compacts the journal into a
+     * fresh snapshot when it is full, torn, or not yet created.
+     *
      * @return true if saved successfully
      */
     bool saveSettings();
 
+    /**
+     * @brief Persist settings later, outside any motor event window
+     *
+     * Use instead of saveSettings() whenever a session may be running: a
+     * flash erase stalls the CPU for tens of milliseconds. Safe to call from
+     * the BLE callback. Changes are coalesced and written by
+     * serviceSettingsWrite(). Settings that must reach flash before a reboot
+     * still call saveSettings() directly.
+     */
+    void requestSaveSettings();
+
+    /**
+     * @brief Commit requested settings if the motor schedule allows (call in loop)
+     * @param nowUs Current time (getMicros())
+     * @param nextMotorEventUs Next scheduled motor event (UINT64_MAX if none)
+     * @param nextMacrocycleUs When the next macrocycle gets queued
+     *        (UINT64_MAX if no session is running)
+     * @return true if settings were written
+     */
+    bool serviceSettingsWrite(uint64_t nowUs, uint64_t nextMotorEventUs,
+                              uint64_t nextMacrocycleUs = UINT64_MAX);
+
+    /**
+     * @brief Check if requested settings are still waiting for a write window
+     */
+    bool hasPendingSettings() const { return _settingsWriter.isDirty(); }
+
+    /**
+     * @brief Deferred write state (commit counts, measured stalls)
+     */
+    const FlashWriteScheduler& getSettingsWriteScheduler() const { return _settingsWriter; }
+
+    /**
+     * @brief Duration of the last saveSettings() flash write in microseconds
+     */
+    uint32_t getLastSaveStallUs() const { return _lastSaveStallUs; }
+
     /**
      * @brief Load profile settings from LittleFS
+     *
+     * Replays the settings journal. A v1 settings file found without a
+     * journal is loaded and migrated.
+     *
      * @return true if loaded successfully
      */
     bool loadSettings();
 
+    /**
+     * @brief Current size of the settings journal in bytes (0 if not yet written)
+     */
+    uint16_t getJournalBytes() const { return _journalBytes; }
+
     /**
      * @brief Check if LittleFS is available
      */
@@ -376,14 +360,14 @@ public:
     void setDebugMode(bool debug) { _debugMode = debug; }
 
 private:
-    // Built-in profiles
-    TherapyProfile _builtInProfiles[MAX_PROFILES];
+    // Built-in profiles (constexpr table in profile_manager.cpp)
     uint8_t _profileCount;
 
     // Profile name pointers for getProfileNames()
     const char* _profileNames[MAX_PROFILES];
 
-    // Current profile (working copy)
+    // Current profile: built-in profile _currentProfileId plus parameter
+    // overrides (strings still point into the flash table)
     TherapyProfile _currentProfile;
     uint8_t _currentProfileId;
     bool _profileLoaded;
@@ -401,11 +385,49 @@ private:
     // Debug mode
     bool _debugMode;
 
+    // Deferred settings writes
+    FlashWriteScheduler _settingsWriter;
+    uint32_t _lastSaveStallUs;
+
+    // Settings journal state
+    SettingsData _persisted;         // Settings as the journal replays them
+    uint16_t _journalBytes;          // Valid journal length (0 = must compact)
+
     /**
      * @brief Initialize built-in profiles
      */
     void initBuiltInProfiles();
 
+    /**
+     * @brief Snapshot current role, profile and flags for storage
+     */
+    void captureSettings(SettingsData& data) const;
+
+    /**
+     * @brief Apply stored settings (validates timing values)
+     */
+    void applySettings(const SettingsData& data);
+
+    /**
+     * @brief Read and replay the settings journal
+     */
+    bool loadJournal(SettingsData& data);
+
+    /**
+     * @brief Read a v1 settings file
+     */
+    bool loadLegacySettings(SettingsData& data);
+
+    /**
+     * @brief Append records to the journal
+     */
+    bool appendJournal(const uint8_t* records, size_t len);
+
+    /**
+     * @brief Rewrite the journal as a single snapshot
+     */
+    bool compactJournal(const SettingsData& data);
+
     /**
      * @brief Validate parameter value
      */
@@ -0,0 +1,94 @@
+/**
+ * @file rx_frame_assembler.h
+ * @brief EOT frame reassembly with first-byte receive timestamps
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * BLE UART data arrives in chunks (one per RX callback) that don't line up
+ * with messages: a frame can span chunks, and a chunk can hold the tail of
+ * one frame plus the next. Each frame is stamped with the arrival time of
+ * the chunk holding its FIRST byte, not the time it is handed to the
+ * message handler, so PTP T2/T4 don't absorb:
+ * - the connection intervals until the last chunk of a split frame arrives
+ * - the time spent handling earlier frames from the same chunk
+ */
+
+#ifndef RX_FRAME_ASSEMBLER_H
+#define RX_FRAME_ASSEMBLER_H
+
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * @brief Reassembles BLE_EOT_CHAR-terminated frames for one connection
+ *
+ * Usage (RX callback):
+ *   uint64_t rxUs = getMicros();   // callback entry
+ *   uint16_t offset = 0;
+ *   while (offset < len) {
+ *       offset += rx.feed(data + offset, len - offset, rxUs);
+ *       if (rx.hasFrame()) {
+ *           handle(rx.frame(), rx.frameRxUs());
+ *           rx.consumeFrame();
+ *       }
+ *   }
+ */
+class RxFrameAssembler {
+public:
+    RxFrameAssembler();
+
+    /**
+     * @brief Drop any partial frame (e.g. on disconnect)
+     */
+    void reset();
+
+    /**
+     * @brief Consume bytes up to and including the next frame terminator
+     *
+     * '\r' is skipped and empty frames are ignored. A frame longer than
+     * RX_BUFFER_SIZE - 1 is dropped up to its terminator (counted in
+     * getOverflowCount()).
+     *
+     * @param data Chunk bytes
+     * @param len Chunk length
+     * @param chunkRxUs When the chunk arrived (local clock)
+     * @return Bytes consumed; stops early when a frame completes. Returns 0
+     *         while a completed frame hasn't been consumed.
+     */
+    uint16_t feed(const uint8_t* data, uint16_t len, uint64_t chunkRxUs);
+
+    /**
+     * @brief True if a complete frame is waiting (feed() stops until consumed)
+     */
+    bool hasFrame() const { return _frameReady; }
+
+    /**
+     * @brief Completed frame, NUL-terminated, without terminator or '\r'
+     */
+    const char* frame() const { return _buffer; }
+
+    /**
+     * @brief Arrival time of the chunk holding the frame's first byte
+     */
+    uint64_t frameRxUs() const { return _frameRxUs; }
+
+    /**
+     * @brief Release the completed frame so feed() can continue
+     */
+    void consumeFrame();
+
+    /**
+     * @brief Frames dropped for exceeding the buffer
+     */
+    uint32_t getOverflowCount() const { return _overflowCount; }
+
+private:
+    char _buffer[RX_BUFFER_SIZE];
+    uint16_t _length;
+    uint64_t _frameRxUs;
+    bool _frameReady;
+    bool _discarding;       // Dropping an oversized frame up to its terminator
+    uint32_t _overflowCount;
+};
+
+#endif // RX_FRAME_ASSEMBLER_H
@@ -0,0 +1,83 @@
+/**
+ * @file seqlock.h
+ * @brief Single-writer sequence lock for tear-free snapshots without a mutex
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * The writer bumps a sequence counter to odd before changing the guarded
+ * data and back to even after. Readers copy the data and retry if the
+ * counter was odd or moved while they copied. The writer never waits, so
+ * it can run in the motor task (priority 4) at O(1) cost.
+ *
+ * Constraints (single core, FreeRTOS):
+ * - Exactly one writer context per SeqLock
+ * - A reader must not preempt its writer: a higher-priority reader spinning
+ *   on an odd counter would never let the writer finish. Readers of the
+ *   motor-task and BLE-callback shards run in loop() (lowest priority).
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Sequence lock guarding one writer's data
+ *
+ * Writer:
+ *   lock.writeBegin();  ...update fields...  lock.writeEnd();
+ *
+ * Reader:
+ *   uint32_t start;
+ *   do {
+ *       start = lock.readBegin();
+ *       copy = data;
+ *   } while (lock.readRetry(start));
+ */
+class SeqLock {
+public:
+    SeqLock() : _sequence(0) {}
+
+    /**
+     * @brief Mark the guarded data as being written (writer only)
+     */
+    void writeBegin() {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /**
+     * @brief Publish the write (writer only)
+     */
+    void writeEnd() {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Start a read attempt
+     * @return Sequence to pass to readRetry()
+     */
+    uint32_t readBegin() const {
+        return _sequence.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Check whether the data read since readBegin() may be torn
+     * @param start Value returned by readBegin()
+     * @return true if a write was in progress or happened: read again
+     */
+    bool readRetry(uint32_t start) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return (start & 1u) != 0 || _sequence.load(std::memory_order_relaxed) != start;
+    }
+
+private:
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "sequence must be lock-free (motor task writer)");
+
+    std::atomic<uint32_t> _sequence;
+};
+
+#endif // SEQLOCK_H
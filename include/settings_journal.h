@@ -0,0 +1,138 @@
+/**
+ * @file settings_journal.h
+ * @brief Append-only key/value journal for persistent settings
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * Replaces rewriting the whole SettingsData image on every save. A save
+ * appends one small CRC-protected record per changed field; loading replays
+ * the records over defaults, last write wins. When the journal would grow
+ * past SETTINGS_JOURNAL_MAX_BYTES it is compacted into a fresh snapshot
+ * (header + every field) written beside it and renamed over it.
+ *
+ * File layout:
+ *   Header  [SETTINGS_MAGIC][SETTINGS_JOURNAL_ID][version][0xFF]
+ *   Record  [key][len][value: len bytes, little-endian][crc16 LE]
+ *
+ * The CRC (CRC-16/CCITT-FALSE) covers key, len and value. Replay stops at
+ * the first record that is truncated or fails its CRC (a write torn by
+ * reset); everything before it is kept and the next save compacts.
+ * Records with unknown keys are skipped, so adding a field needs no format
+ * change. Keys are never reused.
+ *
+ * Version history:
+ *   1: SettingsData written whole to SETTINGS_FILE (migrated on first load)
+ *   2: This journal
+ */
+
+#ifndef SETTINGS_JOURNAL_H
+#define SETTINGS_JOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "profile_manager.h"
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+#define SETTINGS_JOURNAL_FILE "/settings.jnl"
+#define SETTINGS_JOURNAL_TMP_FILE "/settings.jnl.tmp"   // Compaction in progress
+#define SETTINGS_JOURNAL_ID 'J'
+#define SETTINGS_JOURNAL_VERSION 2
+
+#ifndef SETTINGS_JOURNAL_MAX_BYTES
+#define SETTINGS_JOURNAL_MAX_BYTES 512  // Compact before exceeding (load buffer size)
+#endif
+
+/**
+ * @brief Stable journal keys (one per persisted SettingsData field)
+ */
+enum class SettingsKey : uint8_t {
+    ROLE = 1,
+    PROFILE_ID = 2,
+    ACTUATOR_TYPE = 3,
+    FREQUENCY_HZ = 4,
+    TIME_ON_MS = 5,
+    TIME_OFF_MS = 6,
+    JITTER_PERCENT = 7,
+    AMPLITUDE_MIN = 8,
+    AMPLITUDE_MAX = 9,
+    SESSION_DURATION_MIN = 10,
+    PATTERN_TYPE = 11,
+    MIRROR_PATTERN = 12,
+    NUM_FINGERS = 13,
+    THERAPY_LED_OFF = 14,
+    DEBUG_MODE = 15
+};
+
+/**
+ * @brief Outcome of replaying a journal image
+ */
+struct SettingsJournalReplay {
+    bool valid;             // Header matched; data holds the replayed settings
+    size_t validBytes;      // Bytes up to the end of the last good record
+    uint16_t records;       // Records applied
+    uint16_t skipped;       // Good records with unknown keys or sizes
+    bool torn;              // Stopped early at a truncated or corrupt record
+};
+
+// =============================================================================
+// SETTINGS JOURNAL
+// =============================================================================
+
+/**
+ * @brief Encodes and replays settings journal images (no file I/O)
+ *
+ * Usage (ProfileManager):
+ *   size_t len;
+ *   if (SettingsJournal::encodeChanges(persisted, current, buf, sizeof(buf), len) && len > 0)
+ *       append(buf, len);
+ */
+class SettingsJournal {
+public:
+    static constexpr uint8_t HEADER_SIZE = 4;
+    static constexpr uint8_t RECORD_OVERHEAD = 4;   // key + len + crc16
+    static constexpr uint8_t FIELD_COUNT = 15;
+
+    // Buffer size that holds any snapshot or set of changes
+    static constexpr size_t ENCODE_BUFFER_SIZE = HEADER_SIZE + FIELD_COUNT * RECORD_OVERHEAD + sizeof(SettingsData);
+
+    /**
+     * @brief Encode a record for every field that differs
+     * @param from Settings already in the journal
+     * @param to Settings to persist
+     * @param out Output buffer
+     * @param outSize Size of output buffer
+     * @param written Bytes encoded (0 if nothing changed)
+     * @return false if the records don't fit
+     */
+    static bool encodeChanges(const SettingsData& from, const SettingsData& to,
+                              uint8_t* out, size_t outSize, size_t& written);
+
+    /**
+     * @brief Encode a complete journal: header plus every field
+     * @return Bytes encoded, or 0 if the buffer is too small
+     */
+    static size_t encodeSnapshot(const SettingsData& data, uint8_t* out, size_t outSize);
+
+    /**
+     * @brief Size of encodeSnapshot()'s output
+     */
+    static size_t snapshotSize();
+
+    /**
+     * @brief Apply a journal image to settings
+     * @param image Journal bytes (header first)
+     * @param len Image length
+     * @param data In: defaults for fields without records. Out: replayed settings
+     */
+    static SettingsJournalReplay replay(const uint8_t* image, size_t len, SettingsData& data);
+
+    /**
+     * @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+     */
+    static uint16_t crc16(const uint8_t* data, size_t len, uint16_t crc = 0xFFFF);
+};
+
+#endif // SETTINGS_JOURNAL_H
@@ -0,0 +1,157 @@
+/**
+ * @file status_publisher.h
+ * @brief Pushes session status deltas to a subscribed phone
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ *
+ * Replaces polling SESSION_STATUS / BATTERY / INFO. After SUBSCRIBE:<ms>
+ * the PRIMARY pushes only the fields that changed since the last push:
+ *
+ *   PUSH:<seq>\n
+ *   SESSION_STATUS:RUNNING\n     (state change: pushed without waiting for the interval)
+ *   ELAPSED:301\n
+ *   REMAINING:6899\n
+ *   BATP:3.71\n                  (moves in STATUS_PUSH_BATTERY_STEP_CV steps)
+ *   SYNC_US:120\n                (PTP offset confidence, -1 = not synced)
+ *
+ * The first push after SUBSCRIBE carries every field; seq lets the phone
+ * spot a push dropped by a full TX queue (the delta is kept and resent).
+ *
+ * Pushes share the BLE TX queue with MACROCYCLE traffic to the SECONDARY,
+ * so they wait for idle link time: an empty TX queue and at least
+ * STATUS_PUSH_MACROCYCLE_HOLDOFF_MS since the last macrocycle went out
+ * (its ACK is back and the next one is a macrocycle period away).
+ */
+
+#ifndef STATUS_PUBLISHER_H
+#define STATUS_PUBLISHER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "types.h"
+
+// =============================================================================
+// CONSTANTS
+// =============================================================================
+
+#ifndef STATUS_PUSH_MIN_INTERVAL_MS
+#define STATUS_PUSH_MIN_INTERVAL_MS 250         // Fastest rate (also the gap between any two pushes)
+#endif
+
+#ifndef STATUS_PUSH_MAX_INTERVAL_MS
+#define STATUS_PUSH_MAX_INTERVAL_MS 60000
+#endif
+
+#ifndef STATUS_PUSH_MACROCYCLE_HOLDOFF_MS
+#define STATUS_PUSH_MACROCYCLE_HOLDOFF_MS 50    // After a macrocycle send (MC + MC_ACK round trip)
+#endif
+
+#ifndef STATUS_PUSH_BATTERY_STEP_CV
+#define STATUS_PUSH_BATTERY_STEP_CV 5           // Battery change worth a push (0.05V, above ADC noise)
+#endif
+
+#ifndef STATUS_PUSH_SYNC_STEP_US
+#define STATUS_PUSH_SYNC_STEP_US 100            // Sync confidence change worth a push
+#endif
+
+// Buffer that holds a push with every field
+#define STATUS_PUSH_BUFFER_SIZE 128
+
+/**
+ * @brief Values a push reports
+ */
+struct StatusSnapshot {
+    TherapyState state;
+    uint32_t elapsedSec;
+    uint32_t remainingSec;
+    uint16_t batteryCentivolts;     // PRIMARY battery, 0.01V
+    int32_t syncUs;                 // Offset confidence half-width, -1 = not synced
+};
+
+// =============================================================================
+// STATUS PUBLISHER
+// =============================================================================
+
+/**
+ * @brief Subscription state, rate limiting and delta encoding (loop only)
+ *
+ * Usage (loop):
+ *   char buf[STATUS_PUSH_BUFFER_SIZE];
+ *   size_t len = publisher.prepare(nowMs, snapshot, ble.getPendingTxCount(), buf, sizeof(buf));
+ *   if (len > 0 && ble.sendToPhone(buf)) {
+ *       publisher.markSent(nowMs, snapshot);
+ *   }
+ */
+class StatusPublisher {
+public:
+    StatusPublisher();
+
+    /**
+     * @brief Start (or retune) a subscription; the next push is a full snapshot
+     * @param intervalMs Requested push interval (0 = unsubscribe)
+     * @return Interval applied, clamped to the supported range (0 if unsubscribed)
+     */
+    uint32_t subscribe(uint32_t intervalMs);
+
+    /**
+     * @brief Stop pushing (SUBSCRIBE:0 or phone disconnect)
+     */
+    void unsubscribe();
+
+    bool isSubscribed() const { return _intervalMs != 0; }
+    uint32_t getIntervalMs() const { return _intervalMs; }
+
+    /**
+     * @brief Record that a macrocycle was sent to the SECONDARY
+     */
+    void onMacrocycleSent(uint32_t nowMs);
+
+    /**
+     * @brief Check if the link has room for a push
+     * @param nowMs Current time (millis)
+     * @param pendingTx Messages waiting in the BLE TX queue
+     */
+    bool isLinkIdle(uint32_t nowMs, uint8_t pendingTx) const;
+
+    /**
+     * @brief Check if a push is due: state changed, or interval elapsed
+     */
+    bool isDue(uint32_t nowMs, const StatusSnapshot& snapshot) const;
+
+    /**
+     * @brief Encode the fields that changed since the last push
+     * @return Message length (without EOT), 0 if nothing changed or buffer too small
+     */
+    size_t encode(const StatusSnapshot& snapshot, char* out, size_t outSize) const;
+
+    /**
+     * @brief Build the push to send now, if any
+     *
+     * An interval that elapses with nothing changed restarts silently.
+     *
+     * @return Message length (without EOT), 0 if nothing to send now
+     */
+    size_t prepare(uint32_t nowMs, const StatusSnapshot& snapshot, uint8_t pendingTx,
+                   char* out, size_t outSize);
+
+    /**
+     * @brief Commit a push the BLE layer accepted
+     */
+    void markSent(uint32_t nowMs, const StatusSnapshot& snapshot);
+
+    uint32_t getPushCount() const { return _pushCount; }
+    uint32_t getDeferredCount() const { return _deferredCount; }
+
+private:
+    uint32_t _intervalMs;           // 0 = not subscribed
+    uint32_t _lastPushMs;           // Last push (or silent interval restart)
+    uint32_t _lastMacrocycleMs;
+    bool _macrocycleSent;           // _lastMacrocycleMs is valid
+    bool _hasSent;                  // _sent is valid (false = next push is a full snapshot)
+    StatusSnapshot _sent;           // Values the phone has
+    uint32_t _pushCount;            // Also the PUSH sequence number
+    uint32_t _deferredCount;        // Due pushes held back for link traffic
+    bool _deferring;                // Current due push already counted
+};
+
+#endif // STATUS_PUBLISHER_H
@@ -17,8 +17,10 @@
 #define SYNC_PROTOCOL_H
 
 #include <Arduino.h>
+#include <string_view>
 #include "config.h"
 #include "types.h"
+#include "clock_servo.h"
 
 // =============================================================================
 // PROTOCOL CONSTANTS
@@ -29,6 +31,53 @@
 #define SYNC_MAX_DATA_PAIRS 8
 #define SYNC_MAX_KEY_LEN 16
 #define SYNC_MAX_VALUE_LEN 32
+#define SYNC_TX_STAMP_LEN 21                // "HHHHHHHHHH|LLLLLLLLLL": fixed-width high|low halves
+
+// Binary MACROCYCLE wire format (negotiated via CAPS at connect time)
+// Packed little-endian payload, 7-bit packed with the high bit set on every
+// byte so the frame never contains NUL, EOT, CR or protocol delimiters.
+#define MACROCYCLE_BINARY_PREFIX "MB:"
+#define MACROCYCLE_BINARY_PREFIX_LEN 3
+#define MACROCYCLE_BINARY_VERSION 2         // 2: integer-µs baseTime and event times
+#define MACROCYCLE_BINARY_HEADER_BITS 176   // ver(8) seq(32) baseUs(48) offset(64) dur(16) count(8)
+#define MACROCYCLE_BINARY_EVENT_BITS 39     // gapUs(21) finger(3) amp(7) freqOffset(8)
+#define MACROCYCLE_BINARY_MAX_GAP_US 0x1FFFFF  // 2.1s between consecutive events
+#define MACROCYCLE_BINARY_MAX_FINGER 7
+#define MACROCYCLE_BINARY_MAX_AMPLITUDE 127
+#define SYNC_CAPS_PREFIX "CAPS:"           // SECONDARY -> PRIMARY capability advertisement
+
+// Text MACROCYCLE wire formats. MC: keeps the V4 layout (ms times) that every
+// firmware decodes; MU: is V5 (µs times), sent only after CAPS ...MT<version>
+#define MACROCYCLE_TEXT_V4_PREFIX "MC:"
+#define MACROCYCLE_TEXT_V5_PREFIX "MU:"
+#define MACROCYCLE_TEXT_PREFIX_LEN 3
+#define MACROCYCLE_TEXT_VERSION 5
+
+// Seeded macrocycles (negotiated via CAPS ...SG<version>, see SEEDED_MACROCYCLES)
+#define SEEDED_SESSION_PREFIX "SS:"        // Session seed + generation parameters, once per session
+#define MACROCYCLE_BEACON_PREFIX "MN:"     // "macrocycle N at baseTime T", replaces MC:/MB:
+#define SEEDED_PREFIX_LEN 3
+
+// MC_ACK with per-event execution feedback (SECONDARY -> PRIMARY)
+// MC_ACK:seq|ts|fbSeq|l0,l1,...  - 12 events worst case is ~135 bytes
+#define MACROCYCLE_ACK_BUFFER_SIZE 160
+
+// =============================================================================
+// MACROCYCLE WIRE FORMAT
+// =============================================================================
+
+/**
+ * @brief MACROCYCLE encoding selected for the PRIMARY -> SECONDARY link
+ *
+ * TEXT_V4 is always understood and is the fallback until the SECONDARY
+ * advertises CAPS:MB<version>[,SG<version>][,MT<version>].
+ */
+enum class MacrocycleWireFormat : uint8_t {
+    TEXT_V4 = 0,    // MC:seq|baseMs|offHigh|offLow|dur|count|dMs,f,a[,fo]|...
+    BINARY_V1 = 1,  // MB:<7-bit packed binary payload>
+    SEEDED_V1 = 2,  // SS: once per session, then MN:seq|baseHigh|baseLow|offHigh|offLow|tag
+    TEXT_V5 = 3     // MU:seq|baseHigh|baseLow|offHigh|offLow|dur|count|dUs,f,a[,fo]|...
+};
 
 // =============================================================================
 // SYNC COMMAND DATA
@@ -51,6 +100,8 @@ struct SyncDataPair {
 // SYNC COMMAND CLASS
 // =============================================================================
 
+class SyncCommandView;
+
 /**
  * @brief Represents a synchronization command between PRIMARY and SECONDARY
  *
@@ -92,6 +143,13 @@ public:
      */
     bool deserialize(const char* message);
 
+    /**
+     * @brief Build an owning copy from an already-parsed view
+     * @param view Parsed SyncCommandView (its message buffer must still be valid)
+     * @return true if view was valid
+     */
+    bool deserialize(const SyncCommandView& view);
+
     // =========================================================================
     // COMMAND PROPERTIES
     // =========================================================================
@@ -263,6 +321,31 @@ public:
      */
     static SyncCommand createPongWithTimestamps(uint32_t sequenceId, uint64_t t2, uint64_t t3);
 
+    /**
+     * @brief Serialize a PONG whose T3 is filled in when it is transmitted
+     *
+     * Always uses the 64-bit form PONG:seq|T2High|T2Low|T3High|T3Low, with
+     * T3 as a fixed-width zero placeholder (SYNC_TX_STAMP_LEN characters)
+     * that stampTxTime() overwrites in place once the bytes reach the radio.
+     *
+     * @param buffer Output buffer
+     * @param bufferSize Size of output buffer
+     * @param sequenceId Sequence ID (echoes the PING's sequence ID)
+     * @param t2 SECONDARY's receive timestamp in microseconds
+     * @param stampOffset Set to the placeholder offset for stampTxTime()
+     * @return true if the message fit
+     */
+    static bool serializePongForTxStamp(char* buffer, size_t bufferSize, uint32_t sequenceId,
+                                        uint64_t t2, uint16_t& stampOffset);
+
+    /**
+     * @brief Overwrite a serializePongForTxStamp() placeholder with a timestamp
+     * @param buffer Serialized message
+     * @param stampOffset Placeholder offset
+     * @param txUs Transmit timestamp in microseconds
+     */
+    static void stampTxTime(char* buffer, uint16_t stampOffset, uint64_t txUs);
+
     /**
      * @brief Create DEBUG_FLASH command for synchronized LED flash
      * @param sequenceId Sequence ID for the command
@@ -289,15 +372,22 @@ public:
     /**
      * @brief Serialize a macrocycle to buffer with hybrid format
      *
-     * Format: MC:seq|baseTime|count|<binary_payload>
-     * Binary payload is MacrocycleEvent array (6 bytes per event).
+     * Format V5: MU:seq|baseHigh|baseLow|offHigh|offLow|dur|count|d,f,a[,fo]|...
+     * baseTime and event offsets d are in µs.
+     * Format V4: MC:seq|baseMs|offHigh|offLow|dur|count|d,f,a[,fo]|...
+     * baseTime and event times are truncated to ms (d is uint16). Every
+     * SECONDARY decodes it, so it is the fallback until CAPS ...MT5 arrives.
+     *
+     * Fails rather than truncating when the events don't fit.
      *
-     * @param buffer Output buffer (must be at least 120 bytes for 12 events)
+     * @param buffer Output buffer (must be at least 200 bytes)
      * @param bufferSize Size of output buffer
      * @param macrocycle Macrocycle to serialize
+     * @param format TEXT_V5 or TEXT_V4
      * @return true if serialization successful
      */
-    static bool serializeMacrocycle(char* buffer, size_t bufferSize, const Macrocycle& macrocycle);
+    static bool serializeMacrocycle(char* buffer, size_t bufferSize, const Macrocycle& macrocycle,
+                                    MacrocycleWireFormat format = MacrocycleWireFormat::TEXT_V5);
 
     /**
      * @brief Calculate serialized size of a macrocycle
@@ -309,6 +399,8 @@ public:
     /**
      * @brief Deserialize a macrocycle from hybrid format message
      *
+     * Accepts both text formats, told apart by prefix (MU: = V5, MC: = V4).
+     *
      * @param message Input message (text header + binary payload)
      * @param messageLen Total message length (including binary)
      * @param macrocycle Output macrocycle struct
@@ -316,6 +408,128 @@ public:
      */
     static bool deserializeMacrocycle(const char* message, size_t messageLen, Macrocycle& macrocycle);
 
+    // =========================================================================
+    // MACROCYCLE SERIALIZATION (binary format, negotiated)
+    // =========================================================================
+
+    /**
+     * @brief Serialize a macrocycle with the packed binary format
+     *
+     * Format: MB:<payload> where payload is the 7-bit packing of
+     *   ver u8 | seq u32 | baseTime u48 (µs) | clockOffset i64 | dur u16 | count u8 |
+     *   count x (gapUs u21 | finger u3 | amp u7 | freqOffset u8)
+     * Byte-sized fields are little-endian; sub-byte fields are MSB-first.
+     * gapUs is the event's offset from the previous event (the first event's
+     * from baseTime), so event times keep full µs resolution. A full 12-event
+     * macrocycle is 95 bytes (96 with EOT), so it fits in a single
+     * BLE_CHUNK_SIZE notification. Fails if events are out of order or a
+     * field exceeds its width.
+     *
+     * @param buffer Output buffer (NUL-terminated on success)
+     * @param bufferSize Size of output buffer (getMacrocycleBinarySize() + 1)
+     * @param macrocycle Macrocycle to serialize
+     * @return true if serialization successful
+     */
+    static bool serializeMacrocycleBinary(char* buffer, size_t bufferSize, const Macrocycle& macrocycle);
+
+    /**
+     * @brief Calculate binary serialized size of a macrocycle (excluding NUL)
+     * @param macrocycle Macrocycle to measure
+     * @return Exact size in bytes, including the "MB:" prefix
+     */
+    static size_t getMacrocycleBinarySize(const Macrocycle& macrocycle);
+
+    /**
+     * @brief Deserialize a binary macrocycle directly from the receive buffer
+     *
+     * Decodes in place: fields are unpacked straight from the message bytes
+     * without copying or tokenizing. Rejects unknown versions, non-packed
+     * bytes and length mismatches.
+     *
+     * @param message Input message starting with "MB:"
+     * @param messageLen Message length in bytes (excluding NUL)
+     * @param macrocycle Output macrocycle struct
+     * @return true if deserialization successful
+     */
+    static bool deserializeMacrocycleBinary(const char* message, size_t messageLen, Macrocycle& macrocycle);
+
+    // =========================================================================
+    // SEEDED MACROCYCLES (negotiated)
+    // =========================================================================
+
+    /**
+     * @brief Serialize the seeded session parameters
+     *
+     * Format: SS:seedHigh|seedLow|type|onBits|offBits|jitterBits|fingers|mirror|
+     *            ampMin|ampMax|freqRand|freqMin|freqMax|coast
+     * Floats are sent as their IEEE-754 bit patterns so SECONDARY generates
+     * from bit-identical values.
+     *
+     * @param buffer Output buffer (at least 128 bytes)
+     * @param bufferSize Size of output buffer
+     * @param session Session to serialize
+     * @return true if serialization successful
+     */
+    static bool serializeSeededSession(char* buffer, size_t bufferSize, const SeededSession& session);
+
+    /**
+     * @brief Deserialize the seeded session parameters
+     * @param message Input message starting with "SS:"
+     * @param session Output session
+     * @return true if every field parsed and the seed is non-zero
+     */
+    static bool deserializeSeededSession(const char* message, SeededSession& session);
+
+    /**
+     * @brief Serialize a macrocycle beacon (sequence ID, baseTime, clock offset)
+     *
+     * Format: MN:seq|baseHigh|baseLow|offHigh|offLow|tag
+     * baseTime is sent in full microseconds; events are not sent at all.
+     *
+     * @param buffer Output buffer (at least 64 bytes)
+     * @param bufferSize Size of output buffer
+     * @param macrocycle Macrocycle whose sequenceId/baseTime/clockOffset to send
+     * @param sessionTag SeededSession::tag() of the session it belongs to
+     * @return true if serialization successful
+     */
+    static bool serializeMacrocycleBeacon(char* buffer, size_t bufferSize,
+                                          const Macrocycle& macrocycle, uint16_t sessionTag);
+
+    /**
+     * @brief Deserialize a macrocycle beacon
+     * @param message Input message starting with "MN:"
+     * @param macrocycle Output: sequenceId, baseTime and clockOffset (no events)
+     * @param sessionTag Output session tag
+     * @return true if every field parsed
+     */
+    static bool deserializeMacrocycleBeacon(const char* message, Macrocycle& macrocycle, uint16_t& sessionTag);
+
+    /**
+     * @brief Serialize a MACROCYCLE_ACK, optionally carrying execution feedback
+     *
+     * Format: MC_ACK:seq|ts[|fbSeq|l0,l1,...]
+     * fbSeq is the macrocycle the feedback describes (an earlier one: feedback
+     * is only complete once its events have run). li is event i's lateness in
+     * µs against the PRIMARY schedule; empty if the event never started.
+     * Receivers that only read seq are unaffected by the suffix.
+     *
+     * @param buffer Output buffer (MACROCYCLE_ACK_BUFFER_SIZE bytes)
+     * @param bufferSize Size of output buffer
+     * @param sequenceId Sequence ID being acknowledged
+     * @param feedback Feedback to attach, or nullptr for a plain ACK
+     * @return true if serialization successful
+     */
+    static bool serializeMacrocycleAck(char* buffer, size_t bufferSize, uint32_t sequenceId,
+                                       const MacrocycleFeedback* feedback);
+
+    /**
+     * @brief Extract execution feedback from a MACROCYCLE_ACK
+     * @param message Input message starting with "MC_ACK:"
+     * @param feedback Output feedback
+     * @return true if the ACK carries well-formed feedback
+     */
+    static bool deserializeMacrocycleAckFeedback(const char* message, MacrocycleFeedback& feedback);
+
 private:
     SyncCommandType _type;
     uint32_t _sequenceId;
@@ -330,6 +544,108 @@ private:
     bool parseData(const char* dataStr);
 };
 
+// =============================================================================
+// SYNC COMMAND VIEW (zero-copy parse)
+// =============================================================================
+
+/**
+ * @brief Non-owning, zero-copy view of a received sync command
+ *
+ * Indexes field offsets into the caller's receive buffer instead of copying
+ * tokens into SyncDataPair arrays (~40 bytes vs ~420 for SyncCommand).
+ * Integers are decoded lazily on access. Intended for the BLE callback hot
+ * path (PING/PONG) where the object lives on the callback stack.
+ *
+ * Parsing rules match SyncCommand::deserialize(): TYPE:seq|timestamp[|data...],
+ * empty tokens are skipped, at most SYNC_MAX_DATA_PAIRS data fields are kept.
+ *
+ * LIFETIME: The message buffer must outlive the view. Use
+ * SyncCommand::deserialize(view) when an owning copy is needed.
+ *
+ * Usage:
+ *   SyncCommandView cmd;
+ *   if (cmd.parse(message) && cmd.getType() == SyncCommandType::PONG) {
+ *       uint32_t t2 = cmd.getDataUnsigned(0);
+ *   }
+ */
+class SyncCommandView {
+public:
+    SyncCommandView();
+
+    /**
+     * @brief Index a received message in place (no copies)
+     * @param message NUL-terminated message (must outlive the view)
+     * @return true if message is a well-formed sync command
+     */
+    bool parse(const char* message);
+
+    /**
+     * @brief Check if last parse() succeeded
+     */
+    bool isValid() const { return _message != nullptr; }
+
+    /**
+     * @brief Get command type
+     */
+    SyncCommandType getType() const { return _type; }
+
+    /**
+     * @brief Get sequence ID (decoded on access, saturates at UINT32_MAX)
+     */
+    uint32_t getSequenceId() const;
+
+    /**
+     * @brief Get timestamp in microseconds (decoded on access)
+     */
+    uint64_t getTimestamp() const;
+
+    /**
+     * @brief Get number of positional data fields
+     */
+    uint8_t getDataCount() const { return _fieldCount > 2 ? static_cast<uint8_t>(_fieldCount - 2) : 0; }
+
+    /**
+     * @brief Get raw data field as a view into the message buffer
+     * @param index Positional data index (0-based, after seq and timestamp)
+     * @return View of the field, empty if index out of range
+     */
+    std::string_view getData(uint8_t index) const;
+
+    /**
+     * @brief Check if positional data field exists
+     */
+    bool hasData(uint8_t index) const { return index < getDataCount(); }
+
+    /**
+     * @brief Get signed integer data field (saturates at INT32_MIN / INT32_MAX)
+     * @param index Positional data index
+     * @param defaultValue Value to return if field not present
+     */
+    int32_t getDataInt(uint8_t index, int32_t defaultValue = 0) const;
+
+    /**
+     * @brief Get unsigned integer data field
+     * @param index Positional data index
+     * @param defaultValue Value to return if field not present
+     *
+     * NOTE: Same semantics as a 32-bit strtoul(): saturates at UINT32_MAX, a
+     * leading '-' negates modulo 2^32. Use for timestamp high/low parts.
+     */
+    uint32_t getDataUnsigned(uint8_t index, uint32_t defaultValue = 0) const;
+
+
+private:
+    static constexpr uint8_t MAX_FIELDS = 2 + SYNC_MAX_DATA_PAIRS;  // seq + timestamp + data
+
+    const char* _message;
+    SyncCommandType _type;
+    uint8_t _fieldCount;
+    uint16_t _fieldStart[MAX_FIELDS];
+    uint8_t _fieldLen[MAX_FIELDS];
+
+    std::string_view field(uint8_t index) const;
+};
+
 // =============================================================================
 // TIMING UTILITIES
 // =============================================================================
@@ -396,6 +712,82 @@ private:
 // Global sequence generator
 extern SequenceGenerator g_sequenceGenerator;
 
+// =============================================================================
+// MACROCYCLE RECEIVE WINDOW
+// =============================================================================
+
+/**
+ * @brief SECONDARY-side duplicate/continuity check for received MACROCYCLEs
+ *
+ * A pipelined PRIMARY resends macrocycles whose MC_ACK it did not see, and
+ * keeps several in flight, so they can arrive duplicated or out of order.
+ * Tracks the newest staged sequence ID plus a bitmask of the ones just
+ * before it (within MACROCYCLE_PIPELINE_MAX_DEPTH).
+ *
+ * Usage (BLE callback, single context):
+ *   switch (window.classify(mc.sequenceId)) {
+ *       case MacrocycleReceiveWindow::DUPLICATE:    ACK again, don't stage
+ *       case MacrocycleReceiveWindow::NEW_TIMELINE: clear queue, then stage
+ *       case MacrocycleReceiveWindow::IN_WINDOW:    stage alongside queued events
+ *   }
+ *   window.markStaged(mc.sequenceId);
+ */
+class MacrocycleReceiveWindow {
+public:
+    enum Result : uint8_t {
+        NEW_TIMELINE,   // First macrocycle, or unrelated to recent ones (new session / PRIMARY rebooted)
+        IN_WINDOW,      // Next in sequence, or a late one filling a gap
+        DUPLICATE       // Already staged (resend)
+    };
+
+    MacrocycleReceiveWindow() { reset(); }
+
+    /**
+     * @brief Forget all history (call on every PRIMARY connect)
+     */
+    void reset() {
+        _haveAny = false;
+        _newest = 0;
+        _stagedMask = 0;
+    }
+
+    Result classify(uint32_t sequenceId) const {
+        if (!_haveAny) {
+            return NEW_TIMELINE;
+        }
+        int32_t ahead = static_cast<int32_t>(sequenceId - _newest);
+        if (ahead > 0) {
+            return (ahead <= WINDOW) ? IN_WINDOW : NEW_TIMELINE;
+        }
+        if (ahead <= -WINDOW) {
+            return NEW_TIMELINE;
+        }
+        return (_stagedMask & (1u << -ahead)) ? DUPLICATE : IN_WINDOW;
+    }
+
+    void markStaged(uint32_t sequenceId) {
+        int32_t ahead = static_cast<int32_t>(sequenceId - _newest);
+        if (!_haveAny || ahead > WINDOW || ahead <= -WINDOW) {
+            _haveAny = true;
+            _newest = sequenceId;
+            _stagedMask = 1;
+        } else if (ahead > 0) {
+            _newest = sequenceId;
+            _stagedMask = ((_stagedMask << ahead) | 1u) & WINDOW_MASK;
+        } else {
+            _stagedMask |= (1u << -ahead);
+        }
+    }
+
+private:
+    static constexpr int32_t WINDOW = MACROCYCLE_PIPELINE_MAX_DEPTH;
+    static constexpr uint32_t WINDOW_MASK = (1u << WINDOW) - 1;
+
+    bool _haveAny;
+    uint32_t _newest;       // Newest staged sequence ID
+    uint32_t _stagedMask;   // Bit i set = (_newest - i) was staged
+};
+
 // =============================================================================
 // SIMPLE SYNC PROTOCOL
 // =============================================================================
@@ -561,6 +953,32 @@ public:
      */
     int64_t calculatePTPOffset(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4);
 
+    /**
+     * @brief Feed a complete PING/PONG exchange to the clock servo
+     *
+     * Jointly updates the offset and skew estimate (see ClockServo). Once the
+     * servo is valid, getCorrectedOffset() and getDriftRate() come from it
+     * instead of the median/EMA path below.
+     *
+     * @param t1 PRIMARY send timestamp (PRIMARY clock)
+     * @param t2 SECONDARY receive timestamp (SECONDARY clock)
+     * @param t3 SECONDARY send timestamp (SECONDARY clock)
+     * @param t4 PRIMARY receive timestamp (PRIMARY clock)
+     * @return true if the sample was accepted
+     */
+    bool addPTPSample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4);
+
+    /**
+     * @brief Clock servo state (skew, confidence, accept/reject counters)
+     */
+    const ClockServo& getClockServo() const { return _servo; }
+
+    /**
+     * @brief 95% confidence half-width of getCorrectedOffset() right now
+     * @return Microseconds (0 if the servo is not valid)
+     */
+    uint32_t getOffsetConfidenceUs() const;
+
     /**
      * @brief Add a clock offset sample for median filtering
      * @param offset Clock offset sample in microseconds
@@ -589,7 +1007,7 @@ public:
      * @brief Check if clock synchronization is valid (enough stable samples)
      * @return true if sync is valid and can be used for scheduling
      */
-    bool isClockSyncValid() const { return _clockSyncValid; }
+    bool isClockSyncValid() const { return _clockSyncValid || _servo.isValid(); }
 
     /**
      * @brief Get number of clock offset samples collected
@@ -610,9 +1028,10 @@ public:
     /**
      * @brief Get drift-corrected clock offset
      *
-     * Returns the median offset plus compensation for estimated crystal drift
-     * since the last measurement. This provides more accurate offset between
-     * sync events.
+     * With a valid clock servo: the servo's offset + skew prediction at
+     * getMicros(). Otherwise (legacy median/EMA samples only): the median
+     * offset plus compensation for the EMA drift rate since the last
+     * measurement.
      *
      * @return Corrected offset in microseconds
      */
@@ -620,9 +1039,11 @@ public:
 
     /**
      * @brief Get estimated drift rate
-     * @return Drift rate in microseconds per millisecond
+     * @return Drift rate in microseconds per millisecond (servo skew when valid)
      */
-    float getDriftRate() const { return _driftRateUsPerMs; }
+    float getDriftRate() const {
+        return _servo.isValid() ? _servo.getSkewUsPerMs() : _driftRateUsPerMs;
+    }
 
     /**
      * @brief Get average RTT in microseconds
@@ -699,6 +1120,9 @@ private:
     int64_t _lastMeasuredOffset;  // Previous offset measurement for drift calculation
     uint32_t _lastOffsetTime;     // Time of last offset measurement (millis)
     float _driftRateUsPerMs;      // Estimated drift rate (microseconds per millisecond)
+
+    // Offset + skew Kalman servo fed by addPTPSample() (supersedes median/EMA when valid)
+    ClockServo _servo;
 };
 
 #endif // SYNC_PROTOCOL_H
@@ -10,6 +10,7 @@
  * - Mirrored bilateral patterns
  * - Timing with jitter support
  * - Callback-driven motor control
+ * - Optional macrocycle pipelining (N macrocycles in flight on SECONDARY)
  */
 
 #ifndef THERAPY_ENGINE_H
@@ -18,10 +19,12 @@
 #include <Arduino.h>
 #include "config.h"
 #include "types.h"
-#include <vector>
+#include "prng.h"
+#include <array>
 #include <ranges>
 #include <cassert>
 #include <cstdint>
+#include <atomic>
 
 // =============================================================================
 // FLOW CONTROL STATE
@@ -55,47 +58,86 @@ enum class PatternType{
 // PATTERN STRUCTURE
 // =============================================================================
 
+/**
+ * @brief Fixed-capacity per-finger sequence
+ *
+ * std::array storage sized for PATTERN_MAX_FINGERS with a runtime length,
+ * so patterns never touch the heap. Iterates (and converts to std::span)
+ * over the first size() elements only.
+ */
+template <typename T>
+struct FingerArray {
+    std::array<T, PATTERN_MAX_FINGERS> values;
+    uint8_t count;
+
+    constexpr size_t size() const { return count; }
+    constexpr T* data() { return values.data(); }
+    constexpr const T* data() const { return values.data(); }
+    constexpr T* begin() { return values.data(); }
+    constexpr T* end() { return values.data() + count; }
+    constexpr const T* begin() const { return values.data(); }
+    constexpr const T* end() const { return values.data() + count; }
+    constexpr T& operator[](size_t i) { return values[i]; }
+    constexpr const T& operator[](size_t i) const { return values[i]; }
+};
+
 /**
  * @brief Generated therapy pattern
  *
  * Contains finger sequences for both hands with timing information.
+ * Storage is fixed-size (PATTERN_MAX_FINGERS), so a Pattern can live on the
+ * stack and be regenerated in place without allocating.
  *
  * Timing model (matching v1 original):
- *   For each finger: MOTOR_ON(burstDurationMs) → MOTOR_OFF(timeOffMs[i] with jitter)
- *   After all fingers: Wait interBurstIntervalMs (TIME_RELAX = 668ms)
+ *   For each finger: MOTOR_ON(burstDurationUs) → MOTOR_OFF(timeOffUs[i] with jitter)
+ *   After all fingers: Wait interBurstIntervalUs (TIME_RELAX = 668ms)
+ *
+ * All times are integer microseconds: jitter is applied in whole µs, so
+ * summing a pattern's timing never drifts from the schedule it describes.
  */
 struct [[nodiscard]] Pattern {
-    std::vector<uint8_t> primarySequence;
-    std::vector<uint8_t> secondarySequence;
-    std::vector<float> timeOffMs;   // TIME_OFF + jitter for each finger (v1: 67ms ± jitter)
+    FingerArray<uint8_t> primarySequence;
+    FingerArray<uint8_t> secondarySequence;
+    FingerArray<uint32_t> timeOffUs;   // TIME_OFF + jitter for each finger (v1: 67ms ± jitter)
     uint8_t numFingers;
-    float burstDurationMs;                  // TIME_ON (v1: 100ms)
-    float interBurstIntervalMs;             // TIME_RELAX after pattern cycle (v1: 668ms fixed)
-
-    Pattern(uint8_t _numFingers = DEFAULT_NUM_FINGERS) :
-        primarySequence(std::vector<uint8_t>(_numFingers)),
-        secondarySequence(std::vector<uint8_t>(_numFingers)),
-        timeOffMs(std::vector<float>(_numFingers, 67.0f)),
-        numFingers(_numFingers),
-        burstDurationMs(100.0f),
-        interBurstIntervalMs(668.0f)
-    {
-        assert(primarySequence.size() == primarySequence.size() && primarySequence.size() == timeOffMs.size());
-        for (uint8_t i = 0; i < primarySequence.size(); i++) {
+    uint32_t burstDurationUs;               // TIME_ON (v1: 100ms)
+    uint32_t interBurstIntervalUs;          // TIME_RELAX after pattern cycle (v1: 668ms fixed)
+
+    Pattern(uint8_t _numFingers = DEFAULT_NUM_FINGERS) {
+        reset(_numFingers);
+    }
+
+    /**
+     * @brief Reinitialize in place: identity sequences, 67ms TIME_OFF
+     * @param _numFingers Fingers per hand (clamped to PATTERN_MAX_FINGERS)
+     */
+    void reset(uint8_t _numFingers) {
+        assert(_numFingers <= PATTERN_MAX_FINGERS);
+        if (_numFingers > PATTERN_MAX_FINGERS) {
+            _numFingers = PATTERN_MAX_FINGERS;
+        }
+        numFingers = _numFingers;
+        burstDurationUs = 100000;
+        interBurstIntervalUs = 668000;
+        primarySequence.count = _numFingers;
+        secondarySequence.count = _numFingers;
+        timeOffUs.count = _numFingers;
+        for (uint8_t i = 0; i < PATTERN_MAX_FINGERS; i++) {
             primarySequence[i] = i;
             secondarySequence[i] = i;
+            timeOffUs[i] = 67000;
         }
     }
 
     /**
-     * @brief Get total pattern duration in milliseconds
+     * @brief Get total pattern duration in microseconds
      */
-    float getTotalDurationMs() const {
-        float total = 0;
+    uint32_t getTotalDurationUs() const {
+        uint32_t total = 0;
         for (int i = 0; i < numFingers; i++) {
-            total += burstDurationMs + timeOffMs[i];
+            total += burstDurationUs + timeOffUs[i];
         }
-        return total + interBurstIntervalMs;  // Include TIME_RELAX at end
+        return total + interBurstIntervalUs;  // Include TIME_RELAX at end
     }
 
     /**
@@ -121,8 +163,27 @@ struct [[nodiscard]] Pattern {
 /**
  * @brief Fisher-Yates shuffle for array
  * @param arr Array to shuffle
+ * @param rng Generator to draw from
  */
-constexpr void shuffleArray(std::span<uint8_t> arr);
+constexpr void shuffleArray(std::span<uint8_t> arr, Prng& rng);
+
+/**
+ * @brief In-place pattern generators
+ *
+ * Same sequences, timing and draw order as the by-value generate*()
+ * functions below, written into an existing Pattern so the hot path
+ * (TherapyEngine::generateMacrocycle) can reuse one buffer. Parameters
+ * match the corresponding generate*() function.
+ */
+void fillRandomPermutation(Pattern& pattern, uint8_t numFingers, uint32_t timeOnUs,
+                           uint32_t timeOffUs, float jitterPercent, bool mirrorPattern,
+                           Prng& rng);
+void fillSequentialPattern(Pattern& pattern, uint8_t numFingers, uint32_t timeOnUs,
+                           uint32_t timeOffUs, float jitterPercent, bool mirrorPattern, bool reverse,
+                           Prng& rng);
+void fillMirroredPattern(Pattern& pattern, uint8_t numFingers, uint32_t timeOnUs,
+                         uint32_t timeOffUs, float jitterPercent, bool randomize,
+                         Prng& rng);
 
 /**
  * @brief Generate random permutation (RNDP) pattern
@@ -130,17 +191,19 @@ constexpr void shuffleArray(std::span<uint8_t> arr);
  * Each finger activated exactly once per cycle in randomized order.
  * Used for noisy vCR therapy.
  *
+ * @param rng Generator for shuffles and jitter
  * @param numFingers Number of fingers per hand (1-4)
- * @param timeOnMs Vibration burst duration
- * @param timeOffMs Time between bursts
+ * @param timeOnUs Vibration burst duration (µs)
+ * @param timeOffUs Time between bursts (µs)
  * @param jitterPercent Timing jitter percentage (0-100)
  * @param mirrorPattern If true, same finger on both hands (noisy vCR)
  * @return Generated pattern
  */
 Pattern generateRandomPermutation(
+    Prng& rng,
     uint8_t numFingers = 4,
-    float timeOnMs = 100.0f,
-    float timeOffMs = 67.0f,
+    uint32_t timeOnUs = 100000,
+    uint32_t timeOffUs = 67000,
     float jitterPercent = 0.0f,
     bool mirrorPattern = false
 );
@@ -150,18 +213,20 @@ Pattern generateRandomPermutation(
  *
  * Fingers activated in order: 0->1->2->3 (or reverse)
  *
+ * @param rng Generator for shuffles and jitter
  * @param numFingers Number of fingers per hand (1-4)
- * @param timeOnMs Vibration burst duration
- * @param timeOffMs Time between bursts
+ * @param timeOnUs Vibration burst duration (µs)
+ * @param timeOffUs Time between bursts (µs)
  * @param jitterPercent Timing jitter percentage (0-100)
  * @param mirrorPattern If true, same sequence for both hands
  * @param reverse If true, reverse order (3->0)
  * @return Generated pattern
  */
 Pattern generateSequentialPattern(
+    Prng& rng,
     uint8_t numFingers = 4,
-    float timeOnMs = 100.0f,
-    float timeOffMs = 67.0f,
+    uint32_t timeOnUs = 100000,
+    uint32_t timeOffUs = 67000,
     float jitterPercent = 0.0f,
     bool mirrorPattern = false,
     bool reverse = false
@@ -172,17 +237,19 @@ Pattern generateSequentialPattern(
  *
  * Both hands use identical finger sequences.
  *
+ * @param rng Generator for shuffles and jitter
  * @param numFingers Number of fingers per hand (1-4)
- * @param timeOnMs Vibration burst duration
- * @param timeOffMs Time between bursts
+ * @param timeOnUs Vibration burst duration (µs)
+ * @param timeOffUs Time between bursts (µs)
  * @param jitterPercent Timing jitter percentage (0-100)
  * @param randomize If true, randomize sequence
  * @return Generated pattern
  */
 Pattern generateMirroredPattern(
+    Prng& rng,
     uint8_t numFingers = 4,
-    float timeOnMs = 100.0f,
-    float timeOffMs = 67.0f,
+    uint32_t timeOnUs = 100000,
+    uint32_t timeOffUs = 67000,
     float jitterPercent = 0.0f,
     bool randomize = true
 );
@@ -228,6 +295,39 @@ typedef bool (*IsSchedulingCompleteCallback)();
 // Returns RTT + 3σ margin, clamped to reasonable bounds
 typedef uint32_t (*GetLeadTimeCallback)();
 
+// Callback reporting how long the lockstep IDLE step took (microseconds)
+// precomputed = macrocycle was generated during the previous relax period
+typedef void (*IdleStepTimeCallback)(uint32_t elapsedUs, bool precomputed);
+
+// =============================================================================
+// MACROCYCLE PIPELINE
+// =============================================================================
+
+/**
+ * @brief Macrocycle sent to SECONDARY and not yet retired (pipelined mode)
+ */
+struct InFlightMacrocycle {
+    Macrocycle macrocycle;      // As sent (baseTime is absolute, PRIMARY clock)
+    uint32_t lastSentMs;        // millis() of the most recent (re)send
+    uint8_t sendCount;          // 1 = sent once, >1 = resent
+    bool acked;                 // MACROCYCLE_ACK received for this sequence ID
+
+    InFlightMacrocycle() : lastSentMs(0), sendCount(0), acked(false) {}
+};
+
+/**
+ * @brief Pipelined-mode ACK/resend counters (reset on startSession)
+ */
+struct MacrocyclePipelineStats {
+    uint32_t sent;              // Macrocycles generated and sent
+    uint32_t acked;             // ACKs matched to an in-flight macrocycle
+    uint32_t resent;            // Resends after MACROCYCLE_ACK_TIMEOUT_MS
+    uint32_t retiredUnacked;    // Retired without ever being ACKed (likely missed on SECONDARY)
+    uint32_t rebased;           // Pipeline fell behind real time and restarted from now + lead time
+
+    MacrocyclePipelineStats() : sent(0), acked(0), resent(0), retiredUnacked(0), rebased(0) {}
+};
+
 // =============================================================================
 // THERAPY ENGINE CLASS
 // =============================================================================
@@ -309,6 +409,55 @@ public:
      */
     void setGetLeadTimeCallback(GetLeadTimeCallback callback);
 
+    /**
+     * @brief Set callback reporting lockstep IDLE step execution time
+     *
+     * Measured from the start of the IDLE step to the last local activation
+     * being enqueued (macrocycle start callback, baseTime stamp, send, schedule).
+     *
+     * @param callback Function receiving elapsed microseconds
+     */
+    void setIdleStepTimeCallback(IdleStepTimeCallback callback);
+
+    /**
+     * @brief Generate lockstep macrocycles ahead of time (default on)
+     *
+     * When enabled, the next macrocycle is generated while the previous one
+     * waits out 2x TIME_RELAX, so the IDLE step only stamps baseTime, sends
+     * and schedules. Disable to measure the inline-generation cost.
+     *
+     * @param enabled Precompute the next macrocycle during relax
+     */
+    void setMacrocyclePrecompute(bool enabled);
+
+    /**
+     * @brief Set number of macrocycles kept in flight on SECONDARY
+     *
+     * 1 (default) = lockstep: the next macrocycle is generated after the
+     * previous one completes, so lead time is paid every cycle.
+     * N > 1 = pipelined: macrocycles are generated back-to-back on an absolute
+     * timeline (baseTime[k+1] = baseTime[k] + duration + 2x TIME_RELAX) and sent
+     * up to N ahead. Lead time only applies to the first one of a session, and
+     * unacknowledged macrocycles are resent while there is still time.
+     *
+     * Call before startSession(). Clamped to MACROCYCLE_PIPELINE_MAX_DEPTH;
+     * the ActivationQueue must be sized for it (MACROCYCLE_PIPELINE_DEPTH).
+     *
+     * @param depth Macrocycles in flight (1 = lockstep)
+     */
+    void setPipelineDepth(uint8_t depth);
+
+    /**
+     * @brief Record a MACROCYCLE_ACK from SECONDARY (pipelined mode)
+     *
+     * Safe to call from the BLE callback: the sequence ID is queued lock-free
+     * and matched against in-flight macrocycles on the next update().
+     *
+     * @param sequenceId Sequence ID from the MC_ACK message
+     * @return false if the ACK backlog is full (ACK dropped, may cause a resend)
+     */
+    bool onMacrocycleAck(uint32_t sequenceId);
+
     /**
      * @brief Enable/disable frequency randomization (Custom vCR feature)
      * @param enabled Enable frequency randomization
@@ -367,6 +516,90 @@ public:
      */
     void stop();
 
+    /**
+     * @brief Generate the next macrocycle in place
+     *
+     * Writes 3 patterns × numFingers events straight into mc.events using the
+     * current session parameters and advances the sequence ID. Does not
+     * allocate; baseTime is left for the caller to set.
+     *
+     * @param mc Macrocycle to overwrite
+     */
+    void generateMacrocycle(Macrocycle& mc);
+
+    /**
+     * @brief Reseed the engine's generator (replay a logged session)
+     *
+     * startSession() normally draws a fresh seed and logs it as
+     * "[THERAPY] Random seed"; calling this first makes the next session
+     * reuse the given seed, so its patterns repeat exactly.
+     *
+     * @param seed Seed to use from now on
+     */
+    void seedRandom(uint64_t seed);
+
+    /**
+     * @brief Seed of the current session's generator
+     */
+    uint64_t getRandomSeed() const { return _randomSeed; }
+
+    // =========================================================================
+    // SEEDED MACROCYCLES
+    // =========================================================================
+
+    /**
+     * @brief Generate macrocycles from a per-session seed (PRIMARY)
+     *
+     * When enabled, each startSession() draws a fresh seed and macrocycle N
+     * is generated from Prng::forStream(seed, N) instead of the engine's stream,
+     * so a SECONDARY holding the same SeededSession regenerates it exactly.
+     *
+     * @param enabled true once the SECONDARY has advertised seeded support
+     */
+    void setSeededGeneration(bool enabled) { _seededGeneration = enabled; }
+
+    /**
+     * @brief Check if the current session generates from a seed
+     */
+    bool isSeeded() const { return _sessionSeed != 0; }
+
+    /**
+     * @brief Parameters a SECONDARY needs to replicate this session
+     * @return Session with seed 0 when not seeded
+     */
+    SeededSession getSeededSession() const;
+
+    /**
+     * @brief Adopt a PRIMARY's seeded session without starting therapy (SECONDARY)
+     *
+     * Only configures generation; the engine stays stopped.
+     *
+     * @param session Parameters received in the SS: message
+     */
+    void loadSeededSession(const SeededSession& session);
+
+    /**
+     * @brief Generate macrocycle sequenceId of the seeded session in place
+     *
+     * Deterministic: the same (session, sequenceId) always yields the same
+     * events. Does not touch the PRIMARY's own sequence counter.
+     *
+     * @param mc Macrocycle to overwrite (baseTime/clockOffset left to the caller)
+     * @param sequenceId Macrocycle sequence ID from the beacon
+     */
+    void generateSeededMacrocycle(Macrocycle& mc, uint32_t sequenceId) const;
+
+    /**
+     * @brief Length of a macrocycle's slot: events + 2x TIME_RELAX
+     *
+     * The next macrocycle of a contiguous (pipelined) timeline starts this
+     * long after mc.baseTime. Exact in µs, so a timeline built by chaining
+     * slots never accumulates rounding error.
+     */
+    uint32_t getMacrocycleSlotUs(const Macrocycle& mc) const {
+        return mc.getTotalDurationUs() + getDoubleRelaxUs();
+    }
+
     // =========================================================================
     // STATUS
     // =========================================================================
@@ -381,6 +614,15 @@ public:
      */
     bool isPaused() const { return _isPaused; }
 
+    /**
+     * @brief Local time (getMicros()) at which update() next sends a macrocycle
+     *
+     * Its events are queued only then, typically one lead time before the
+     * first of them, so an empty ActivationQueue does not mean the motors are
+     * idle for long. UINT64_MAX when not running or paused.
+     */
+    uint64_t getNextMacrocycleDueUs() const;
+
     /**
      * @brief Check if this is a test session (started via TEST command)
      */
@@ -420,6 +662,21 @@ public:
         return (finger < MAX_ACTUATORS) ? _currentFrequency[finger] : 235;
     }
 
+    /**
+     * @brief Get configured pipeline depth (1 = lockstep)
+     */
+    uint8_t getPipelineDepth() const { return _pipelineDepth; }
+
+    /**
+     * @brief Get number of macrocycles currently in flight (pipelined mode)
+     */
+    uint8_t getInFlightCount() const { return _inFlightCount; }
+
+    /**
+     * @brief Get pipelined-mode ACK/resend counters
+     */
+    const MacrocyclePipelineStats& getPipelineStats() const { return _pipelineStats; }
+
 private:
     // State
     bool _isRunning;
@@ -433,6 +690,8 @@ private:
     PatternType _patternType;
     float _timeOnMs;
     float _timeOffMs;
+    uint32_t _timeOnUs;   // _timeOnMs rounded once to the integer µs timeline
+    uint32_t _timeOffUs;  // _timeOffMs rounded once to the integer µs timeline
     float _jitterPercent;
     uint8_t _numFingers;
     bool _mirrorPattern;
@@ -478,17 +737,49 @@ private:
     StartSchedulingCallback _startSchedulingCallback;
     IsSchedulingCompleteCallback _isSchedulingCompleteCallback;
     GetLeadTimeCallback _getLeadTimeCallback;
+    IdleStepTimeCallback _idleStepTimeCallback;
 
     uint32_t _macrocycleSequenceId;      // Sequence ID for MACROCYCLE messages
-    Macrocycle _currentMacrocycle;       // Current macrocycle being executed
+    bool _seededGeneration;              // Draw a session seed at startSession()
+    Prng _rng;                           // Every therapy draw (shuffle, jitter, amplitude, frequency)
+    uint64_t _randomSeed;                // Seed _rng got at startSession()
+    bool _randomSeedPinned;              // seedRandom() called since the last startSession()
+    uint64_t _sessionSeed;               // 0 = macrocycles draw from _rng
+    uint8_t _seedCoastBudget;            // SeededSession::coastBudget for this session
+    // Lockstep mode double buffer: the back buffer is filled during WAITING_RELAX
+    Macrocycle _macrocycleBuffers[2];
+    uint8_t _frontMacrocycle;            // Index of the macrocycle being executed
+    bool _nextMacrocycleReady;           // Back buffer holds the next macrocycle
+    bool _precomputeMacrocycles;
     uint8_t _macrocycleEventIndex;       // Current event index within macrocycle (0-11)
     uint64_t _macrocycleBaseTime;        // Base activation time for current macrocycle
 
+    // Pipelined mode: ring of in-flight macrocycles, oldest at _inFlightHead
+    uint8_t _pipelineDepth;
+    InFlightMacrocycle _inFlight[MACROCYCLE_PIPELINE_MAX_DEPTH];
+    uint8_t _inFlightHead;
+    uint8_t _inFlightCount;
+    uint64_t _nextMacrocycleBaseTime;    // baseTime for the next generated macrocycle (0 = none yet)
+    MacrocyclePipelineStats _pipelineStats;
+
+    // ACK handoff from BLE callback (producer) to update() (consumer), SPSC ring
+    static constexpr uint8_t ACK_RING_SIZE = 8;  // Power of 2
+    uint32_t _ackRing[ACK_RING_SIZE];
+    std::atomic<uint8_t> _ackHead;
+    std::atomic<uint8_t> _ackTail;
+
     // Internal methods
     void generateNextPattern();
     void applyFrequencyRandomization();  // Called at start of each pattern cycle
-    Macrocycle generateMacrocycle();     // Generate all 12 events for a macrocycle
+    void fillMacrocycle(Macrocycle& mc, Prng& rng, uint16_t* frequency) const;
+    void resetFrequencies();             // All fingers back to the 250 Hz default
     void executeMacrocycleStep();        // State machine for macrocycle batching mode
+    void executePipelinedMacrocycleStep();  // Pipelined mode: retire, ACK, resend, top up
+    void scheduleLocalEvents(const Macrocycle& mc);  // Enqueue PRIMARY activations for mc
+    uint32_t getDoubleRelaxUs() const;   // 2x TIME_RELAX gap between macrocycles
+    void precomputeNextMacrocycle();     // Fill the back buffer if precompute is on
+    void drainMacrocycleAcks();
+    void resetPipeline();
 };
 
 #endif // THERAPY_ENGINE_H
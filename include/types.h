@@ -431,27 +431,28 @@ constexpr uint16_t MACROCYCLE_FREQ_BASE = 200;
 constexpr uint8_t MACROCYCLE_FREQ_STEP = 5;
 
 /**
- * @brief Single buzz event within a macrocycle (packed for BLE transmission)
+ * @brief Single buzz event within a macrocycle
  *
- * Binary format: 6 bytes per event for compact BLE payload.
- * All times are relative to the macrocycle baseTime.
+ * All times are relative to the macrocycle baseTime, in integer microseconds
+ * so jittered TIME_OFF values survive generation, transmission and
+ * scheduling without rounding.
  *
  * Note: 'finger' is the SECONDARY finger (transmitted over BLE).
  * 'primaryFinger' is for local PRIMARY use only (NOT serialized).
  * In mirrored mode, primaryFinger == finger. In non-mirrored mode, they differ.
  */
 struct __attribute__((packed)) MacrocycleEvent {
-    uint16_t deltaTimeMs;   // Offset from baseTime in milliseconds (0-65535)
+    uint32_t deltaTimeUs;   // Offset from baseTime in microseconds (up to ~71 minutes)
     uint8_t  finger;        // SECONDARY motor index (0-3) - transmitted over BLE
     uint8_t  amplitude;     // Intensity percentage (0-100)
     uint16_t durationMs;    // ON duration in milliseconds (supports up to 65535ms)
     uint8_t  freqOffset;    // Encoded frequency: (freq - 200) / 5, supports 200-455 Hz
     uint8_t  primaryFinger; // PRIMARY motor index (0-3) - local use only, NOT serialized
 
-    MacrocycleEvent() : deltaTimeMs(0), finger(0), amplitude(0), durationMs(0), freqOffset(0), primaryFinger(0) {}
+    MacrocycleEvent() : deltaTimeUs(0), finger(0), amplitude(0), durationMs(0), freqOffset(0), primaryFinger(0) {}
 
-    MacrocycleEvent(uint16_t delta, uint8_t secFinger, uint8_t primFinger, uint8_t amp, uint16_t dur, uint16_t freqHz)
-        : deltaTimeMs(delta)
+    MacrocycleEvent(uint32_t deltaUs, uint8_t secFinger, uint8_t primFinger, uint8_t amp, uint16_t dur, uint16_t freqHz)
+        : deltaTimeUs(deltaUs)
         , finger(secFinger)
         , amplitude(amp)
         , durationMs(dur)
@@ -484,7 +485,7 @@ struct Macrocycle {
 
     /**
      * @brief Add an event to the macrocycle
-     * @param deltaMs Offset from baseTime in milliseconds
+     * @param deltaUs Offset from baseTime in microseconds
      * @param secFinger SECONDARY motor index (transmitted over BLE)
      * @param primFinger PRIMARY motor index (local use only)
      * @param amp Amplitude percentage (0-100)
@@ -492,20 +493,81 @@ struct Macrocycle {
      * @param freqHz Frequency in Hz
      * @return true if added, false if full
      */
-    bool addEvent(uint16_t deltaMs, uint8_t secFinger, uint8_t primFinger, uint8_t amp, uint16_t durMs, uint16_t freqHz) {
+    bool addEvent(uint32_t deltaUs, uint8_t secFinger, uint8_t primFinger, uint8_t amp, uint16_t durMs, uint16_t freqHz) {
         if (eventCount >= MACROCYCLE_MAX_EVENTS) return false;
-        events[eventCount++] = MacrocycleEvent(deltaMs, secFinger, primFinger, amp, durMs, freqHz);
+        events[eventCount++] = MacrocycleEvent(deltaUs, secFinger, primFinger, amp, durMs, freqHz);
         return true;
     }
 
     /**
-     * @brief Get total duration of macrocycle in milliseconds
+     * @brief Get total duration of macrocycle in microseconds
      */
-    uint16_t getTotalDurationMs() const {
+    uint32_t getTotalDurationUs() const {
         if (eventCount == 0) return 0;
         // Last event's delta + its duration
-        return events[eventCount - 1].deltaTimeMs + events[eventCount - 1].durationMs;
+        return events[eventCount - 1].deltaTimeUs + events[eventCount - 1].durationMs * 1000u;
     }
 };
 
+/**
+ * @brief Lateness value for an event that never started
+ */
+constexpr int16_t MACROCYCLE_LATENESS_NONE = INT16_MIN;
+
+/**
+ * @brief How late each event of one macrocycle started on one glove
+ *
+ * latenessUs[i] = actual start of event i converted to the PRIMARY clock,
+ * minus its PRIMARY schedule (baseTime + deltaTimeUs). Saturates at
+ * +/-32767 us; MACROCYCLE_LATENESS_NONE if the event never started.
+ * SECONDARY returns this with a MACROCYCLE_ACK; PRIMARY subtracts its own
+ * lateness for the same event to get bilateral skew.
+ */
+struct MacrocycleFeedback {
+    uint32_t sequenceId;
+    uint8_t  eventCount;
+    int16_t  latenessUs[MACROCYCLE_MAX_EVENTS];
+
+    MacrocycleFeedback() : sequenceId(0), eventCount(0) {
+        for (uint8_t i = 0; i < MACROCYCLE_MAX_EVENTS; i++) {
+            latenessUs[i] = MACROCYCLE_LATENESS_NONE;
+        }
+    }
+};
+
+/**
+ * @brief Everything a glove needs to generate macrocycles locally
+ *
+ * Seeded mode: PRIMARY sends this once per session (SS: message), then only
+ * "macrocycle N at baseTime T" beacons (MN: message). Both gloves generate
+ * macrocycle N's events from (seed, N) with the same code, so they agree
+ * event for event. Floats are carried as raw bits so both sides compute
+ * jitter from bit-identical inputs.
+ */
+struct SeededSession {
+    uint64_t seed;                  // Session seed (0 = seeded mode off)
+    uint8_t  patternType;           // PatternType as uint8_t
+    float    timeOnMs;
+    float    timeOffMs;
+    float    jitterPercent;
+    uint8_t  numFingers;
+    bool     mirrorPattern;
+    uint8_t  amplitudeMin;
+    uint8_t  amplitudeMax;
+    bool     frequencyRandomization;
+    uint16_t frequencyMin;
+    uint16_t frequencyMax;
+    uint8_t  coastBudget;           // Macrocycles SECONDARY may generate without a beacon (0 = never)
+
+    SeededSession()
+        : seed(0), patternType(0), timeOnMs(100.0f), timeOffMs(67.0f), jitterPercent(0.0f)
+        , numFingers(4), mirrorPattern(false), amplitudeMin(100), amplitudeMax(100)
+        , frequencyRandomization(false), frequencyMin(210), frequencyMax(255), coastBudget(0) {}
+
+    /**
+     * @brief Short tag carried in every beacon to detect stale session state
+     */
+    uint16_t tag() const { return static_cast<uint16_t>(seed ^ (seed >> 16) ^ (seed >> 32) ^ (seed >> 48)); }
+};
+
 #endif // TYPES_H
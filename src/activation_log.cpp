@@ -0,0 +1,200 @@
+/**
+ * @file activation_log.cpp
+ * @brief Per-event activation timing for bilateral skew feedback - Implementation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ */
+
+#include "activation_log.h"
+
+// =============================================================================
+// GLOBAL INSTANCE
+// =============================================================================
+
+ActivationLog activationLog;
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+/**
+ * @brief Clamp a lateness to the int16 wire range (keeps NONE reserved)
+ */
+static int16_t clampLateness(int64_t latenessUs) {
+    if (latenessUs > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (latenessUs <= MACROCYCLE_LATENESS_NONE) {
+        return static_cast<int16_t>(MACROCYCLE_LATENESS_NONE + 1);
+    }
+    return static_cast<int16_t>(latenessUs);
+}
+
+// =============================================================================
+// CONSTRUCTOR / RESET
+// =============================================================================
+
+ActivationLog::ActivationLog() :
+    _head(0),
+    _tail(0),
+    _dropped(0),
+    _nextSlot(0)
+{
+    reset();
+}
+
+void ActivationLog::reset() {
+    _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+    _dropped.store(0, std::memory_order_relaxed);
+    for (uint8_t i = 0; i < MAX_MACROCYCLES; i++) {
+        _tracked[i].used = false;
+        _tracked[i].reported = false;
+    }
+    _nextSlot = 0;
+}
+
+// =============================================================================
+// TRACKING (CONSUMER ONLY)
+// =============================================================================
+
+ActivationLog::TrackedMacrocycle* ActivationLog::findTracked(uint32_t sequenceId) {
+    for (uint8_t i = 0; i < MAX_MACROCYCLES; i++) {
+        if (_tracked[i].used && _tracked[i].feedback.sequenceId == sequenceId) {
+            return &_tracked[i];
+        }
+    }
+    return nullptr;
+}
+
+const ActivationLog::TrackedMacrocycle* ActivationLog::findTracked(uint32_t sequenceId) const {
+    for (uint8_t i = 0; i < MAX_MACROCYCLES; i++) {
+        if (_tracked[i].used && _tracked[i].feedback.sequenceId == sequenceId) {
+            return &_tracked[i];
+        }
+    }
+    return nullptr;
+}
+
+void ActivationLog::track(const Macrocycle& mc, uint64_t localBaseTime) {
+    if (findTracked(mc.sequenceId) != nullptr) {
+        return;  // Pipelined resend
+    }
+
+    TrackedMacrocycle& slot = _tracked[_nextSlot];
+    _nextSlot = static_cast<uint8_t>((_nextSlot + 1) % MAX_MACROCYCLES);
+
+    slot.feedback = MacrocycleFeedback();
+    slot.feedback.sequenceId = mc.sequenceId;
+    slot.feedback.eventCount = mc.eventCount;
+    slot.localBaseTime = localBaseTime;
+    slot.primaryBaseTime = mc.baseTime;
+    for (uint8_t i = 0; i < mc.eventCount; i++) {
+        slot.deltaTimeUs[i] = mc.events[i].deltaTimeUs;
+    }
+    slot.used = true;
+    slot.reported = false;
+}
+
+// =============================================================================
+// LOGGING (MOTOR TASK, PRODUCER ONLY)
+// =============================================================================
+
+bool ActivationLog::recordActivation(uint64_t scheduledLocalUs, uint64_t actualLocalUs) {
+    uint8_t head = _head.load(std::memory_order_relaxed);
+    uint8_t next = static_cast<uint8_t>((head + 1) & (RING_SIZE - 1));
+    if (next == _tail.load(std::memory_order_acquire)) {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    _ring[head].scheduledLocalUs = scheduledLocalUs;
+    _ring[head].actualLocalUs = actualLocalUs;
+    _head.store(next, std::memory_order_release);
+    return true;
+}
+
+// =============================================================================
+// MATCHING (CONSUMER ONLY)
+// =============================================================================
+
+uint8_t ActivationLog::drain(int64_t localMinusPrimaryUs) {
+    uint8_t matched = 0;
+    uint8_t tail = _tail.load(std::memory_order_relaxed);
+    while (tail != _head.load(std::memory_order_acquire)) {
+        Activation entry = _ring[tail];
+        tail = static_cast<uint8_t>((tail + 1) & (RING_SIZE - 1));
+        _tail.store(tail, std::memory_order_release);
+
+        // Scheduled local times are unique across the tracked window
+        // (events are strictly increasing and macrocycles don't overlap)
+        for (uint8_t m = 0; m < MAX_MACROCYCLES; m++) {
+            TrackedMacrocycle& tracked = _tracked[m];
+            if (!tracked.used || entry.scheduledLocalUs < tracked.localBaseTime) {
+                continue;
+            }
+            uint64_t delta = entry.scheduledLocalUs - tracked.localBaseTime;
+            bool found = false;
+            for (uint8_t i = 0; i < tracked.feedback.eventCount; i++) {
+                if (tracked.deltaTimeUs[i] != delta) {
+                    continue;
+                }
+                uint64_t actualPrimaryUs = static_cast<uint64_t>(
+                    static_cast<int64_t>(entry.actualLocalUs) - localMinusPrimaryUs);
+                uint64_t scheduledPrimaryUs = tracked.primaryBaseTime + tracked.deltaTimeUs[i];
+                tracked.feedback.latenessUs[i] = clampLateness(
+                    static_cast<int64_t>(actualPrimaryUs - scheduledPrimaryUs));
+                matched++;
+                found = true;
+                break;
+            }
+            if (found) {
+                break;
+            }
+        }
+    }
+    return matched;
+}
+
+bool ActivationLog::takeFeedback(uint64_t nowLocalUs, MacrocycleFeedback& feedback) {
+    TrackedMacrocycle* oldest = nullptr;
+    for (uint8_t m = 0; m < MAX_MACROCYCLES; m++) {
+        TrackedMacrocycle& tracked = _tracked[m];
+        if (!tracked.used || tracked.reported || tracked.feedback.eventCount == 0) {
+            continue;
+        }
+        uint8_t last = static_cast<uint8_t>(tracked.feedback.eventCount - 1);
+        uint64_t settledUs = tracked.localBaseTime + tracked.deltaTimeUs[last] + SETTLE_US;
+        if (nowLocalUs < settledUs) {
+            continue;
+        }
+        if (oldest == nullptr ||
+            static_cast<int32_t>(tracked.feedback.sequenceId - oldest->feedback.sequenceId) < 0) {
+            oldest = &tracked;
+        }
+    }
+
+    if (oldest == nullptr) {
+        return false;
+    }
+    oldest->reported = true;
+    feedback = oldest->feedback;
+    return true;
+}
+
+uint8_t ActivationLog::computeSkew(const MacrocycleFeedback& feedback, int32_t* skewUs) const {
+    const TrackedMacrocycle* tracked = findTracked(feedback.sequenceId);
+    if (tracked == nullptr) {
+        return 0;
+    }
+
+    uint8_t count = 0;
+    uint8_t events = (feedback.eventCount < tracked->feedback.eventCount)
+                         ? feedback.eventCount : tracked->feedback.eventCount;
+    for (uint8_t i = 0; i < events; i++) {
+        int16_t theirs = feedback.latenessUs[i];
+        int16_t ours = tracked->feedback.latenessUs[i];
+        if (theirs != MACROCYCLE_LATENESS_NONE && ours != MACROCYCLE_LATENESS_NONE) {
+            skewUs[count++] = static_cast<int32_t>(theirs) - static_cast<int32_t>(ours);
+        }
+    }
+    return count;
+}
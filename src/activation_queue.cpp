@@ -1,11 +1,14 @@
 /**
  * @file activation_queue.cpp
  * @brief Unified motor event queue for FreeRTOS-based motor control
- * @version 3.1.0
+ * @version 3.2.0
  *
  * Pure FreeRTOS architecture - motor task handles both activations
  * and deactivations with unified timing.
  *
+ * Events live in a MotorEventHeap, so the motor task's peek/recheck/dequeue
+ * sequence is O(1)/O(log n) under the mutex instead of a 32-slot scan each.
+ *
  * Thread Safety: All public methods are protected by FreeRTOS mutex.
  * Queue is accessed from main loop, BLE callbacks, and motor task.
  */
@@ -65,9 +68,6 @@ ActivationQueue::ActivationQueue()
     , _queueMutex(nullptr)
     , _initialized(false)
 {
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        _events[i].clear();
-    }
 }
 
 void ActivationQueue::begin(HapticController* haptic, TaskHandle_t motorTaskHandle) {
@@ -95,54 +95,16 @@ void ActivationQueue::clear() {
     QueueMutexLock lock(_queueMutex);
     // Proceed even if lock not acquired - safety operation
 
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        _events[i].clear();
-    }
-}
-
-int8_t ActivationQueue::findEmptySlot() const {
-    // NOTE: Caller must hold mutex
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        if (!_events[i].active) {
-            return static_cast<int8_t>(i);
-        }
-    }
-    return -1;
-}
-
-int8_t ActivationQueue::findNextEvent() const {
-    // NOTE: Caller must hold mutex
-    int8_t earliestIdx = -1;
-    uint64_t earliestTime = UINT64_MAX;
-
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        if (_events[i].active) {
-            if (_events[i].timeUs < earliestTime) {
-                earliestTime = _events[i].timeUs;
-                earliestIdx = static_cast<int8_t>(i);
-            }
-        }
-    }
-
-    return earliestIdx;
+    _events.clear();
 }
 
-int8_t ActivationQueue::addEvent(const MotorEvent& event) {
-    // NOTE: Caller must hold mutex
-    int8_t slot = findEmptySlot();
-    if (slot < 0) {
-        // Verbose logging for queue full (M5 fix)
-        Serial.printf("[QUEUE] FULL! Cannot add F%d %s event at T=%lu ms (count=%d/%d)\n",
-                      event.finger,
-                      (event.type == MotorEventType::ACTIVATE) ? "ACTIVATE" : "DEACTIVATE",
-                      static_cast<unsigned long>(event.timeUs / 1000),
-                      eventCount(), MAX_EVENTS);
-        return -1;
-    }
-
-    _events[slot] = event;
-    _events[slot].active = true;
-    return slot;
+void ActivationQueue::logQueueFull(const MotorEvent& event) const {
+    // Verbose logging for queue full (M5 fix)
+    Serial.printf("[QUEUE] FULL! Cannot add F%d %s event at T=%lu ms (count=%d/%d)\n",
+                  event.finger,
+                  (event.type == MotorEventType::ACTIVATE) ? "ACTIVATE" : "DEACTIVATE",
+                  static_cast<unsigned long>(event.timeUs / 1000),
+                  _events.size(), MAX_EVENTS);
 }
 
 bool ActivationQueue::enqueue(uint64_t activateTimeUs, uint8_t finger, uint8_t amplitude,
@@ -162,12 +124,6 @@ bool ActivationQueue::enqueue(uint64_t activateTimeUs, uint8_t finger, uint8_t a
     actEvent.type = MotorEventType::ACTIVATE;
     actEvent.active = true;
 
-    // H4 fix: Store slot index for proper rollback
-    int8_t actSlot = addEvent(actEvent);
-    if (actSlot < 0) {
-        return false;
-    }
-
     // Create corresponding deactivation event
     MotorEvent deactEvent;
     deactEvent.timeUs = activateTimeUs + (static_cast<uint64_t>(durationMs) * 1000ULL);
@@ -177,13 +133,16 @@ bool ActivationQueue::enqueue(uint64_t activateTimeUs, uint8_t finger, uint8_t a
     deactEvent.type = MotorEventType::DEACTIVATE;
     deactEvent.active = true;
 
-    int8_t deactSlot = addEvent(deactEvent);
-    if (deactSlot < 0) {
-        // H4 fix: Rollback by known index, not by searching
-        _events[actSlot].clear();
+    // H4 fix: Activation and deactivation are added as a pair - reserve room
+    // for both up front so there is never a half-enqueued pair to roll back
+    if (_events.available() < 2) {
+        logQueueFull(_events.available() == 0 ? actEvent : deactEvent);
         return false;
     }
 
+    _events.push(actEvent);
+    _events.push(deactEvent);
+
     if (profiles.getDebugMode()) {
         Serial.printf("[QUEUE] Enqueued F%d A%d @%dHz (ON at T+%lums, OFF at T+%lums)\n",
                       finger, amplitude, frequencyHz,
@@ -205,13 +164,13 @@ bool ActivationQueue::peekNextEvent(MotorEvent& event) const {
         return false;
     }
 
-    int8_t idx = findNextEvent();
-    if (idx < 0) {
+    const MotorEvent* next = _events.peek();
+    if (next == nullptr) {
         return false;
     }
 
     // Copy entire event while holding mutex (H5 fix - atomic 64-bit copy)
-    event = _events[idx];
+    event = *next;
     return true;
 }
 
@@ -221,15 +180,18 @@ bool ActivationQueue::dequeueNextEvent(MotorEvent& event) {
         return false;
     }
 
-    int8_t idx = findNextEvent();
-    if (idx < 0) {
-        return false;
+    // Copy and remove while holding mutex (C2 fix - atomic peek+dequeue)
+    return _events.pop(event);
+}
+
+uint8_t ActivationQueue::dequeueEventsWithin(MotorEvent* events, uint8_t maxCount,
+                                             uint32_t windowUs) {
+    QueueMutexLock lock(_queueMutex);
+    if (!lock.acquired()) {
+        return 0;
     }
 
-    // Copy and clear while holding mutex (C2 fix - atomic peek+dequeue)
-    event = _events[idx];
-    _events[idx].clear();
-    return true;
+    return _events.popWithin(events, maxCount, windowUs);
 }
 
 uint64_t ActivationQueue::getNextEventTime() const {
@@ -238,22 +200,13 @@ uint64_t ActivationQueue::getNextEventTime() const {
         return UINT64_MAX;
     }
 
-    int8_t idx = findNextEvent();
-    if (idx < 0) {
-        return UINT64_MAX;
-    }
-    return _events[idx].timeUs;
+    const MotorEvent* next = _events.peek();
+    return (next != nullptr) ? next->timeUs : UINT64_MAX;
 }
 
 uint8_t ActivationQueue::eventCount() const {
     // NOTE: Can be called without mutex for approximate count (used in logging)
-    uint8_t count = 0;
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        if (_events[i].active) {
-            count++;
-        }
-    }
-    return count;
+    return _events.size();
 }
 
 bool ActivationQueue::isEmpty() const {
@@ -262,12 +215,7 @@ bool ActivationQueue::isEmpty() const {
         return true;  // Assume empty on failure (safe default)
     }
 
-    for (uint8_t i = 0; i < MAX_EVENTS; i++) {
-        if (_events[i].active) {
-            return false;
-        }
-    }
-    return true;
+    return _events.isEmpty();
 }
 
 void ActivationQueue::notifyMotorTask() {
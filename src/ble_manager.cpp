@@ -6,6 +6,7 @@
  */
 
 #include "ble_manager.h"
+#include "sync_protocol.h"  // getMicros()
 
 // =============================================================================
 // GLOBAL INSTANCE (needed for static callbacks)
@@ -43,6 +44,8 @@ BLEManager::BLEManager() :
         _txQueue[i].pending = false;
         _txQueue[i].length = 0;
         _txQueue[i].bytesSent = 0;
+        _txQueue[i].stampOffset = 0;
+        _txQueue[i].sentAtUs = nullptr;
     }
 
     // Set global instance for static callbacks
@@ -443,7 +446,27 @@ bool BLEManager::send(uint16_t connHandleParam, const char* message) {
     return enqueueTx(connHandleParam, message);
 }
 
-bool BLEManager::enqueueTx(uint16_t connHandle, const char* message) {
+bool BLEManager::sendStamped(uint16_t connHandleParam, const char* message, uint16_t stampOffset,
+                             volatile uint64_t* sentAtUs) {
+    if (connHandleParam == CONN_HANDLE_INVALID) {
+        return false;
+    }
+
+    BBConnection* conn = findConnection(connHandleParam);
+    if (!conn || !conn->isConnected) {
+        return false;
+    }
+
+    if (stampOffset != 0 && (size_t)stampOffset + SYNC_TX_STAMP_LEN > strlen(message)) {
+        Serial.println(F("[BLE] ERROR: TX stamp outside message"));
+        return false;
+    }
+
+    return enqueueTx(connHandleParam, message, stampOffset, sentAtUs);
+}
+
+bool BLEManager::enqueueTx(uint16_t connHandle, const char* message,
+                           uint16_t stampOffset, volatile uint64_t* sentAtUs) {
     // Check if queue is full
     if (_txCount >= TX_QUEUE_SIZE) {
         Serial.println(F("[BLE] TX queue full, dropping message"));
@@ -471,6 +494,8 @@ bool BLEManager::enqueueTx(uint16_t connHandle, const char* message) {
     entry->length = static_cast<uint16_t>(msgLen + 1);
     entry->bytesSent = 0;
     entry->connHandle = connHandle;
+    entry->stampOffset = stampOffset;
+    entry->sentAtUs = sentAtUs;
     entry->pending = true;
 
     // Advance tail
@@ -490,6 +515,17 @@ void BLEManager::processTxQueue() {
             continue;
         }
 
+        // Sync messages: timestamp as the first byte goes out (retried writes re-stamp)
+        if (entry->bytesSent == 0 && (entry->stampOffset != 0 || entry->sentAtUs)) {
+            uint64_t txUs = getMicros();
+            if (entry->stampOffset != 0) {
+                SyncCommand::stampTxTime(entry->data, entry->stampOffset, txUs);
+            }
+            if (entry->sentAtUs) {
+                *entry->sentAtUs = txUs;
+            }
+        }
+
         // Try to write remaining bytes (non-blocking)
         size_t remaining = entry->length - entry->bytesSent;
         size_t written = tryWriteImmediate(entry->connHandle,
@@ -632,52 +668,34 @@ ConnectionType BLEManager::identifyConnectionType(uint16_t connHandle [[maybe_un
     }
 }
 
-void BLEManager::processIncomingData(uint16_t connHandleParam, const uint8_t* data, uint16_t len) {
+void BLEManager::processIncomingData(uint16_t connHandleParam, const uint8_t* data, uint16_t len, uint64_t rxUs) {
     BBConnection* conn = findConnection(connHandleParam);
     if (!conn) return;
 
-    // Append data to buffer
-    for (uint16_t i = 0; i < len && conn->rxIndex < RX_BUFFER_SIZE - 1; i++) {
-        uint8_t c = data[i];
-
-        // Skip carriage return
-        if (c == '\r') {
-            continue;
-        }
-
-        // Check for message terminator (EOT only - phone apps must send EOT)
-        if (c == EOT_CHAR) {
-            // End of message - null terminate
-            conn->rxBuffer[conn->rxIndex] = '\0';
-
-            if (conn->rxIndex > 0) {
-                deliverMessage(conn, connHandleParam);
-            }
-
-            // Reset buffer for next message
-            conn->rxIndex = 0;
-        } else {
-            // Add to buffer
-            conn->rxBuffer[conn->rxIndex++] = c;
-        }
-    }
-
     // NOTE: Do NOT deliver partial messages here!
     // Messages can be fragmented across BLE packets.
     // Only deliver when EOT terminator is received.
     // Phone apps MUST send EOT (0x04) for proper message framing.
+    uint32_t overflows = conn->rx.getOverflowCount();
+    uint16_t offset = 0;
+    while (offset < len) {
+        offset = static_cast<uint16_t>(offset + conn->rx.feed(data + offset, static_cast<uint16_t>(len - offset), rxUs));
+        if (conn->rx.hasFrame()) {
+            deliverMessage(conn, connHandleParam);
+            conn->rx.consumeFrame();
+        }
+    }
 
-    // Handle buffer overflow
-    if (conn->rxIndex >= RX_BUFFER_SIZE - 1) {
-        Serial.println(F("[BLE] WARNING: RX buffer overflow, clearing"));
-        conn->rxIndex = 0;
+    if (conn->rx.getOverflowCount() != overflows) {
+        Serial.println(F("[BLE] WARNING: RX buffer overflow, dropping message"));
     }
 }
 
 void BLEManager::deliverMessage(BBConnection* conn, uint16_t connHandleParam) {
     // Check for IDENTIFY messages (handshake protocol)
+    const char* message = conn->rx.frame();
     if (conn->pendingIdentify) {
-        if (strcmp(conn->rxBuffer, "IDENTIFY:SECONDARY") == 0) {
+        if (strcmp(message, "IDENTIFY:SECONDARY") == 0) {
             Serial.println(F("[BLE] Received IDENTIFY:SECONDARY"));
             conn->type = ConnectionType::SECONDARY;
             conn->pendingIdentify = false;
@@ -685,7 +703,7 @@ void BLEManager::deliverMessage(BBConnection* conn, uint16_t connHandleParam) {
                 _connectCallback(connHandleParam, ConnectionType::SECONDARY);
             }
             return;
-        } else if (strcmp(conn->rxBuffer, "IDENTIFY:PHONE") == 0) {
+        } else if (strcmp(message, "IDENTIFY:PHONE") == 0) {
             Serial.println(F("[BLE] Received IDENTIFY:PHONE"));
             conn->type = ConnectionType::PHONE;
             conn->pendingIdentify = false;
@@ -698,45 +716,29 @@ void BLEManager::deliverMessage(BBConnection* conn, uint16_t connHandleParam) {
 
     // Normal message - deliver to callback
     if (_messageCallback) {
-        _messageCallback(connHandleParam, conn->rxBuffer);
+        _messageCallback(connHandleParam, message, conn->rx.frameRxUs());
     }
 }
 
-void BLEManager::processClientIncomingData(const uint8_t* data, uint16_t len) {
+void BLEManager::processClientIncomingData(const uint8_t* data, uint16_t len, uint64_t rxUs) {
     // Find PRIMARY connection (SECONDARY mode)
     BBConnection* conn = findConnectionByType(ConnectionType::PRIMARY);
     if (!conn) return;
 
-    // Append data to buffer
-    for (uint16_t i = 0; i < len && conn->rxIndex < RX_BUFFER_SIZE - 1; i++) {
-        uint8_t c = data[i];
-
-        // Skip carriage return
-        if (c == '\r') {
-            continue;
-        }
-
-        // Check for message terminator (EOT only - phone apps must send EOT)
-        if (c == EOT_CHAR) {
-            // End of message - null terminate and deliver
-            conn->rxBuffer[conn->rxIndex] = '\0';
-
-            if (conn->rxIndex > 0 && _messageCallback) {
-                _messageCallback(conn->connHandle, conn->rxBuffer);
+    uint32_t overflows = conn->rx.getOverflowCount();
+    uint16_t offset = 0;
+    while (offset < len) {
+        offset = static_cast<uint16_t>(offset + conn->rx.feed(data + offset, static_cast<uint16_t>(len - offset), rxUs));
+        if (conn->rx.hasFrame()) {
+            if (_messageCallback) {
+                _messageCallback(conn->connHandle, conn->rx.frame(), conn->rx.frameRxUs());
             }
-
-            // Reset buffer for next message
-            conn->rxIndex = 0;
-        } else {
-            // Add to buffer
-            conn->rxBuffer[conn->rxIndex++] = c;
+            conn->rx.consumeFrame();
         }
     }
 
-    // Handle buffer overflow
-    if (conn->rxIndex >= RX_BUFFER_SIZE - 1) {
-        Serial.println(F("[BLE] WARNING: RX buffer overflow, clearing"));
-        conn->rxIndex = 0;
+    if (conn->rx.getOverflowCount() != overflows) {
+        Serial.println(F("[BLE] WARNING: RX buffer overflow, dropping message"));
     }
 }
 
@@ -764,7 +766,7 @@ void BLEManager::_onPeriphConnect(uint16_t connHandleParam) {
     conn->connectedAt = millis();
     conn->pendingIdentify = true;
     conn->identifyStartTime = millis();
-    conn->rxIndex = 0;
+    conn->rx.reset();
 
     Serial.println(F("[BLE] Waiting for IDENTIFY message (1000ms timeout)..."));
 
@@ -816,7 +818,7 @@ void BLEManager::_onCentralConnect(uint16_t connHandle) {
     conn->type = ConnectionType::PRIMARY;
     conn->isConnected = true;
     conn->connectedAt = millis();
-    conn->rxIndex = 0;
+    conn->rx.reset();
 
     // Discover UART service on PRIMARY
     Serial.println(F("[BLE] Discovering UART service on PRIMARY..."));
@@ -886,23 +888,27 @@ void BLEManager::_onScanCallback(ble_gap_evt_adv_report_t* report) {
 void BLEManager::_onUartRx(uint16_t connHandle) {
     if (!g_bleManager) return;
 
-    // Read available data
-    uint8_t buf[64];
-    int len = g_bleManager->_uartService.read(buf, sizeof(buf));
+    // Timestamp before anything else: this is the earliest the firmware
+    // sees these bytes, and it becomes T2/T4 for any frame starting here
+    uint64_t rxUs = getMicros();
 
-    if (len > 0) {
-        g_bleManager->processIncomingData(connHandle, buf, static_cast<uint16_t>(len));
+    // Drain the FIFO so a frame's tail is never left for a later callback
+    uint8_t buf[64];
+    int len;
+    while ((len = g_bleManager->_uartService.read(buf, sizeof(buf))) > 0) {
+        g_bleManager->processIncomingData(connHandle, buf, static_cast<uint16_t>(len), rxUs);
     }
 }
 
 void BLEManager::_onClientUartRx(BLEClientUart& clientUart) {
     if (!g_bleManager) return;
 
-    // Read available data
-    uint8_t buf[64];
-    int len = clientUart.read(buf, sizeof(buf));
+    // Timestamp before anything else (see _onUartRx)
+    uint64_t rxUs = getMicros();
 
-    if (len > 0) {
-        g_bleManager->processClientIncomingData(buf, static_cast<uint16_t>(len));
+    uint8_t buf[64];
+    int len;
+    while ((len = clientUart.read(buf, sizeof(buf))) > 0) {
+        g_bleManager->processClientIncomingData(buf, static_cast<uint16_t>(len), rxUs);
     }
 }
@@ -0,0 +1,175 @@
+/**
+ * @file clock_servo.cpp
+ * @brief Two-state Kalman clock servo (offset + skew) - Implementation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ */
+
+#include "clock_servo.h"
+#include "config.h"
+#include <math.h>
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+ClockServo::ClockServo() :
+    _minValidSamples(SYNC_MIN_VALID_SAMPLES)
+{
+    reset();
+}
+
+void ClockServo::reset() {
+    _seeded = false;
+    _anchorOffset = 0;
+    _lastTimeUs = 0;
+    _offset = 0.0f;
+    _skew = 0.0f;
+    _p00 = 0.0f;
+    _p01 = 0.0f;
+    _p11 = 0.0f;
+    _minDelayUs = 0;
+    _acceptedCount = 0;
+    _rejectedCount = 0;
+    _reseedCount = 0;
+    _consecutiveRejects = 0;
+}
+
+// =============================================================================
+// MEASUREMENT UPDATE
+// =============================================================================
+
+bool ClockServo::addSample(const PtpSample& sample) {
+    int64_t delay = sample.pathDelay();
+    if (delay < 0 || delay > MAX_PATH_DELAY_US) {
+        _rejectedCount++;
+        return false;
+    }
+
+    // Decaying minimum: best path seen recently, slowly forgotten
+    if (!_seeded || delay < _minDelayUs + MIN_DELAY_DECAY_US) {
+        _minDelayUs = delay;
+    } else {
+        _minDelayUs += MIN_DELAY_DECAY_US;
+    }
+    float r = measurementVariance(delay);
+
+    if (!_seeded) {
+        seed(sample, r);
+        return true;
+    }
+
+    uint64_t timeUs = sample.midpoint();
+    float dt = elapsedMs(timeUs);
+    if (dt < 0.0f) {
+        dt = 0.0f;  // Out-of-order sample: update without predicting backwards
+    }
+
+    // Predict: x = F x, P = F P F' + Q  (F = [1 dt; 0 1])
+    float x0 = _offset + _skew * dt;
+    float dt2 = dt * dt;
+    float p00 = _p00 + 2.0f * dt * _p01 + dt2 * _p11
+              + OFFSET_PROCESS_NOISE * dt + SKEW_PROCESS_NOISE * dt2 * dt / 3.0f;
+    float p01 = _p01 + dt * _p11 + SKEW_PROCESS_NOISE * dt2 / 2.0f;
+    float p11 = _p11 + SKEW_PROCESS_NOISE * dt;
+
+    // Innovation against the measured offset (H = [1 0])
+    float innovation = (float)(sample.offset() - _anchorOffset) - x0;
+    float s = p00 + r;
+    if (innovation * innovation > GATE_SIGMA * GATE_SIGMA * s) {
+        _rejectedCount++;
+        _consecutiveRejects++;
+        if (_consecutiveRejects >= MAX_CONSECUTIVE_REJECTS) {
+            // Persistent disagreement is a step change, not noise: start over
+            _reseedCount++;
+            seed(sample, r);
+            return true;
+        }
+        return false;
+    }
+    _consecutiveRejects = 0;
+
+    // Update
+    float k0 = p00 / s;
+    float k1 = p01 / s;
+    _offset = x0 + k0 * innovation;
+    _skew += k1 * innovation;
+    _p00 = (1.0f - k0) * p00;
+    _p01 = (1.0f - k0) * p01;
+    _p11 = p11 - k1 * p01;
+
+    if (timeUs > _lastTimeUs) {
+        _lastTimeUs = timeUs;
+    }
+    _acceptedCount++;
+
+    // Keep the float residual small: move whole microseconds into the anchor
+    if (fabsf(_offset) > 1000.0f) {
+        int64_t shift = (int64_t)lroundf(_offset);
+        _anchorOffset += shift;
+        _offset -= (float)shift;
+    }
+    return true;
+}
+
+void ClockServo::seed(const PtpSample& sample, float measVariance) {
+    _seeded = true;
+    _anchorOffset = sample.offset();
+    _lastTimeUs = sample.midpoint();
+    _offset = 0.0f;
+    _skew = 0.0f;
+    _p00 = measVariance;
+    _p01 = 0.0f;
+    _p11 = INITIAL_SKEW_STDDEV * INITIAL_SKEW_STDDEV;
+    _consecutiveRejects = 0;
+    _acceptedCount = 1;  // A re-seed must earn validity again
+}
+
+float ClockServo::measurementVariance(int64_t pathDelayUs) const {
+    // PTP offset error is half the path asymmetry, which is bounded by the
+    // delay in excess of the best path (e.g. one side waited an extra
+    // connection interval for a retransmission)
+    float excessHalf = (float)(pathDelayUs - _minDelayUs) * 0.5f;
+    if (excessHalf < 0.0f) {
+        excessHalf = 0.0f;
+    }
+    return MEAS_NOISE_US * MEAS_NOISE_US + excessHalf * excessHalf;
+}
+
+// =============================================================================
+// PREDICTION
+// =============================================================================
+
+float ClockServo::elapsedMs(uint64_t primaryTimeUs) const {
+    float dt = (float)(int64_t)(primaryTimeUs - _lastTimeUs) / 1000.0f;
+    if (dt > (float)MAX_HOLDOVER_MS) {
+        dt = (float)MAX_HOLDOVER_MS;
+    }
+    return dt;
+}
+
+int64_t ClockServo::getOffsetAt(uint64_t primaryTimeUs) const {
+    if (!_seeded) {
+        return 0;
+    }
+    float dt = elapsedMs(primaryTimeUs);
+    return _anchorOffset + (int64_t)lroundf(_offset + _skew * dt);
+}
+
+float ClockServo::getOffsetStdDevUs(uint64_t primaryTimeUs) const {
+    if (!_seeded) {
+        return 0.0f;
+    }
+    float dt = elapsedMs(primaryTimeUs);
+    if (dt < 0.0f) {
+        dt = 0.0f;
+    }
+    float dt2 = dt * dt;
+    float variance = _p00 + 2.0f * dt * _p01 + dt2 * _p11
+                   + OFFSET_PROCESS_NOISE * dt + SKEW_PROCESS_NOISE * dt2 * dt / 3.0f;
+    return (variance > 0.0f) ? sqrtf(variance) : 0.0f;
+}
+
+uint32_t ClockServo::getConfidenceIntervalUs(uint64_t primaryTimeUs) const {
+    return (uint32_t)lroundf(1.96f * getOffsetStdDevUs(primaryTimeUs));
+}
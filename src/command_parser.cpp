@@ -0,0 +1,172 @@
+/**
+ * @file command_parser.cpp
+ * @brief Zero-copy command tokenizer and sorted command tables - Implementation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ */
+
+#include "command_parser.h"
+#include <string.h>
+
+// =============================================================================
+// INTERNAL MESSAGES
+// =============================================================================
+
+namespace {
+
+// Command words of PRIMARY <-> SECONDARY messages (sorted, see commandTableSorted)
+constexpr CommandEntry<bool> INTERNAL_COMMANDS[] = {
+    {"ACK_PARAM_UPDATE", true},
+    {"BATRESPONSE", true},
+    {"BUZZ", true},
+    {"CAPS", true},             // SECONDARY capability advertisement
+    {"DEBUG_FLASH", true},
+    {"DEBUG_SYNC", true},
+    {"FIRST_SYNC", true},
+    {"GET_BATTERY", true},
+    {"IDENTIFY", true},
+    {"LED_OFF_SYNC", true},
+    {"MB", true},               // Macrocycle batch message (binary)
+    {"MC", true},               // Macrocycle batch message
+    {"MC_ACK", true},           // Macrocycle acknowledgment
+    {"MN", true},               // Macrocycle beacon (seeded session)
+    {"MU", true},               // Macrocycle batch message (µs text)
+    {"PARAM_UPDATE", true},
+    {"PAUSE_SESSION", true},
+    {"PING", true},
+    {"PONG", true},
+    {"RESUME_SESSION", true},
+    {"SEED", true},
+    {"SEED_ACK", true},
+    {"SS", true},               // Seeded session parameters
+    {"START_SESSION", true},
+    {"STOP_SESSION", true},
+};
+static_assert(commandTableSorted(INTERNAL_COMMANDS), "INTERNAL_COMMANDS must be sorted by name");
+
+// Families matched by prefix: SYNC_ADJ, SYNC_PROBE, SYNC_PROBE_ACK, ACK_SYNC_ADJ
+constexpr const char* INTERNAL_PREFIXES[] = {"SYNC_", "ACK_SYNC"};
+
+}  // namespace
+
+bool isInternalCommand(std::string_view word) {
+    if (word.empty()) {
+        return false;
+    }
+    if (findCommand(INTERNAL_COMMANDS, word)) {
+        return true;
+    }
+    for (const char* prefix : INTERNAL_PREFIXES) {
+        if (word.compare(0, strlen(prefix), prefix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// =============================================================================
+// COMMAND TOKENS
+// =============================================================================
+
+CommandTokens::CommandTokens() :
+    _message(nullptr),
+    _fieldCount(0)
+{
+}
+
+bool CommandTokens::parse(const char* message) {
+    _message = nullptr;
+    _fieldCount = 0;
+
+    if (!message) {
+        return false;
+    }
+
+    // Message ends at the first line terminator or EOT
+    size_t len = 0;
+    while (len < COMMAND_MESSAGE_MAX && message[len] != '\0' && message[len] != '\n' &&
+           message[len] != '\r' && message[len] != BLE_EOT_CHAR) {
+        len++;
+    }
+
+    // Skip leading spaces
+    size_t pos = 0;
+    while (pos < len && message[pos] == ' ') {
+        pos++;
+    }
+
+    // Index colon-delimited fields; empty fields are skipped (strtok semantics)
+    while (pos < len && _fieldCount < MAX_FIELDS) {
+        if (message[pos] == ':') {
+            pos++;
+            continue;
+        }
+
+        size_t start = pos;
+        while (pos < len && message[pos] != ':') {
+            pos++;
+        }
+
+        _fieldStart[_fieldCount] = static_cast<uint8_t>(start);
+        _fieldLen[_fieldCount] = static_cast<uint8_t>(pos - start);
+        _fieldCount++;
+    }
+
+    if (_fieldCount == 0) {
+        return false;
+    }
+
+    _message = message;
+    return true;
+}
+
+std::string_view CommandTokens::field(uint8_t index) const {
+    if (index >= _fieldCount) {
+        return std::string_view();
+    }
+    return std::string_view(_message + _fieldStart[index], _fieldLen[index]);
+}
+
+int32_t CommandTokens::paramInt(uint8_t index, int32_t defaultValue) const {
+    if (index >= paramCount()) {
+        return defaultValue;
+    }
+
+    // atoi(): optional leading spaces and sign, then digits up to the first non-digit
+    std::string_view value = param(index);
+    size_t i = 0;
+    while (i < value.size() && value[i] == ' ') {
+        i++;
+    }
+    bool negative = false;
+    if (i < value.size() && (value[i] == '-' || value[i] == '+')) {
+        negative = (value[i] == '-');
+        i++;
+    }
+    int64_t result = 0;
+    for (; i < value.size() && value[i] >= '0' && value[i] <= '9'; i++) {
+        if (result <= INT32_MAX) {
+            result = result * 10 + (value[i] - '0');
+        }
+    }
+    if (result > INT32_MAX) {
+        result = INT32_MAX;
+    }
+    return static_cast<int32_t>(negative ? -result : result);
+}
+
+bool CommandTokens::copyParam(uint8_t index, char* out, size_t outSize) const {
+    if (!out || outSize == 0) {
+        return false;
+    }
+    if (index >= paramCount()) {
+        out[0] = '\0';
+        return false;
+    }
+
+    std::string_view value = param(index);
+    size_t n = value.size() < outSize - 1 ? value.size() : outSize - 1;
+    memcpy(out, value.data(), n);
+    out[n] = '\0';
+    return true;
+}
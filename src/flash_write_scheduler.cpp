@@ -0,0 +1,77 @@
+/**
+ * @file flash_write_scheduler.cpp
+ * @brief Defers settings writes to windows with no scheduled motor events - Implementation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ */
+
+#include "flash_write_scheduler.h"
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+FlashWriteScheduler::FlashWriteScheduler() :
+    _markedGeneration(0),
+    _lastChangeMs(0),
+    _committedGeneration(0),
+    _commitCount(0),
+    _failureCount(0),
+    _lastStallUs(0),
+    _maxStallUs(0)
+{
+}
+
+// =============================================================================
+// DIRTY TRACKING
+// =============================================================================
+
+void FlashWriteScheduler::markDirty(uint32_t nowMs) {
+    _lastChangeMs.store(nowMs, std::memory_order_relaxed);
+    _markedGeneration.fetch_add(1, std::memory_order_release);
+}
+
+// =============================================================================
+// COMMIT WINDOW
+// =============================================================================
+
+uint32_t FlashWriteScheduler::getRequiredWindowUs() const {
+    uint32_t learned = _maxStallUs + FLASH_WRITE_GUARD_US;
+    return (learned > FLASH_WRITE_WINDOW_US) ? learned : FLASH_WRITE_WINDOW_US;
+}
+
+bool FlashWriteScheduler::shouldCommit(uint32_t nowMs, uint64_t nowUs, uint64_t nextEventUs,
+                                       uint64_t nextMacrocycleUs) const {
+    if (!isDirty()) {
+        return false;
+    }
+
+    // Let a burst of changes settle into one write
+    if (nowMs - _lastChangeMs.load(std::memory_order_relaxed) < FLASH_WRITE_COALESCE_MS) {
+        return false;
+    }
+
+    // An empty queue mid-session only means the next macrocycle isn't queued yet
+    if (nextMacrocycleUs < nextEventUs) {
+        nextEventUs = nextMacrocycleUs;
+    }
+
+    // Event due now (or late) or inside the stall window: wait for a gap
+    return nextEventUs > nowUs && nextEventUs - nowUs >= getRequiredWindowUs();
+}
+
+void FlashWriteScheduler::endCommit(uint32_t generation, uint32_t nowMs, uint32_t stallUs, bool success) {
+    _lastStallUs = stallUs;
+    if (stallUs > _maxStallUs) {
+        _maxStallUs = stallUs;
+    }
+
+    if (success) {
+        // Changes marked during the write keep the settings dirty
+        _committedGeneration = generation;
+        _commitCount++;
+    } else {
+        _failureCount++;
+        _lastChangeMs.store(nowMs, std::memory_order_relaxed);
+    }
+}
@@ -6,6 +6,7 @@
  */
 
 #include "hardware.h"
+#include "sync_protocol.h"  // For getMicros() - batch deadlines
 
 // =============================================================================
 // I2C MUTEX RAII LOCK
@@ -69,10 +70,19 @@ const uint8_t BatteryMonitor::VOLTAGE_CURVE_SIZE = sizeof(VOLTAGE_CURVE) / sizeo
 // HAPTIC CONTROLLER - Implementation
 // =============================================================================
 
-HapticController::HapticController() : _tca(TCA9548A_ADDRESS), _initialized(false), _preSelectedFinger(-1), _i2cMutex(nullptr) {
+HapticController::HapticController()
+    : _tca(TCA9548A_ADDRESS)
+    , _initialized(false)
+    , _preSelectedFinger(-1)
+    , _i2cMutex(nullptr)
+    , _muxShadow(0)
+    , _muxShadowValid(false)
+    , _busStats{}
+{
     for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
         _fingerActive[i] = false;
         _fingerEnabled[i] = false;
+        invalidateDrvShadow(i);
     }
 }
 
@@ -89,9 +99,9 @@ bool HapticController::begin() {
     Wire.begin();
     Wire.setClock(I2C_FREQUENCY);
 
-    // Initialize TCA9548A multiplexer
+    // Initialize TCA9548A multiplexer (forced write: power-on mux state is unknown)
     _tca.begin(Wire);
-    _tca.closeAll();
+    writeMux(0, true);
 
     Serial.printf("[INFO] TCA9548A multiplexer initialized at 0x%02X\n", TCA9548A_ADDRESS);
 
@@ -148,9 +158,12 @@ bool HapticController::initializeFinger(uint8_t finger) {
         // Configure for LRA + RTP mode
         configureDRV2605(_drv[finger]);
 
+        // Library calls above wrote registers behind the shadow's back
+        invalidateDrvShadow(finger);
+
         // SAFETY: Immediately stop motor after init - DRV2605 retains RTP value
         // across MCU resets, so motor may be buzzing from pre-power-off state
-        _drv[finger].setRealtimeValue(0);
+        writeDrvRegister(finger, DRV2605_REG_RTPIN, 0, true);
 
         closeChannels();
 
@@ -192,17 +205,77 @@ void HapticController::configureDRV2605(Adafruit_DRV2605& drv) {
     drv.setRealtimeValue(0);
 }
 
+// =============================================================================
+// SHADOW REGISTERS
+// =============================================================================
+
+void HapticController::writeMux(uint8_t mask, bool force) {
+    if (!force && _muxShadowValid && _muxShadow == mask) {
+        _busStats.muxWritesSkipped++;
+        return;
+    }
+
+    _tca.writeRegister(mask);
+    _muxShadow = mask;
+    _muxShadowValid = true;
+    _busStats.muxWrites++;
+}
+
+void HapticController::writeDrvRegister(uint8_t finger, uint8_t reg, uint8_t value, bool force) {
+    if (!force && drvRegisterMatches(finger, reg, value)) {
+        _busStats.drvWritesSkipped++;
+        return;
+    }
+
+    _drv[finger].writeRegister8(reg, value);
+    _busStats.drvWrites++;
+
+    if (reg < DRV_SHADOW_REG_COUNT) {
+        _drvShadow[finger][reg] = value;
+        _drvShadowValid[finger] |= (1ULL << reg);
+    }
+}
+
+bool HapticController::drvRegisterMatches(uint8_t finger, uint8_t reg, uint8_t value) const {
+    if (reg >= DRV_SHADOW_REG_COUNT) {
+        return false;
+    }
+    return ((_drvShadowValid[finger] >> reg) & 1ULL) != 0 && _drvShadow[finger][reg] == value;
+}
+
+void HapticController::invalidateDrvShadow(uint8_t finger) {
+    _drvShadowValid[finger] = 0;
+    for (uint8_t reg = 0; reg < DRV_SHADOW_REG_COUNT; reg++) {
+        _drvShadow[finger][reg] = 0;
+    }
+}
+
+void HapticController::countSkippedSequence() {
+    // Un-shadowed path would have issued: select, register write, close
+    _busStats.muxWritesSkipped += 2;
+    _busStats.drvWritesSkipped++;
+}
+
+void HapticController::resetBusStats() {
+    _busStats = I2CBusStats{};
+}
+
+// =============================================================================
+// CHANNEL SELECTION
+// =============================================================================
+
 bool HapticController::selectChannel(uint8_t finger) {
     if (finger >= MAX_ACTUATORS) {
         return false;
     }
 
-    _tca.openChannel(finger);
+    // Exclusive select: all DRV2605s share 0x5A, so exactly one channel may be open
+    writeMux(static_cast<uint8_t>(1U << finger));
     return true;
 }
 
 void HapticController::closeChannels() {
-    _tca.closeAll();
+    writeMux(0);
     _preSelectedFinger = -1;  // Invalidate pre-selection
 }
 
@@ -238,16 +311,22 @@ Result HapticController::activate(uint8_t finger, uint8_t amplitude) {
         return Result::ERROR_BUSY;
     }
 
-    // Select channel
-    if (!selectChannel(finger)) {
-        return Result::ERROR_HARDWARE;
-    }
-
-    // Set RTP value
     uint8_t rtpValue = amplitudeToRTP(amplitude);
-    _drv[finger].setRealtimeValue(rtpValue);
 
-    closeChannels();
+    // Chip already holds this RTP value - no bus traffic needed at all
+    if (drvRegisterMatches(finger, DRV2605_REG_RTPIN, rtpValue)) {
+        countSkippedSequence();
+    } else {
+        // Select channel
+        if (!selectChannel(finger)) {
+            return Result::ERROR_HARDWARE;
+        }
+
+        // Set RTP value
+        writeDrvRegister(finger, DRV2605_REG_RTPIN, rtpValue);
+
+        closeChannels();
+    }
 
     // Update state
     _fingerActive[finger] = (amplitude > 0);
@@ -272,15 +351,20 @@ Result HapticController::deactivate(uint8_t finger) {
         return Result::ERROR_BUSY;
     }
 
-    // Select channel
-    if (!selectChannel(finger)) {
-        return Result::ERROR_HARDWARE;
-    }
+    // Motor already stopped in hardware - no bus traffic needed
+    if (drvRegisterMatches(finger, DRV2605_REG_RTPIN, 0)) {
+        countSkippedSequence();
+    } else {
+        // Select channel
+        if (!selectChannel(finger)) {
+            return Result::ERROR_HARDWARE;
+        }
 
-    // Set RTP value to 0
-    _drv[finger].setRealtimeValue(0);
+        // Set RTP value to 0
+        writeDrvRegister(finger, DRV2605_REG_RTPIN, 0);
 
-    closeChannels();
+        closeChannels();
+    }
 
     // Update state
     _fingerActive[finger] = false;
@@ -301,15 +385,15 @@ void HapticController::emergencyStop() {
     // If we can't acquire, proceed anyway (emergency takes priority)
     I2CMutexLock lock(_i2cMutex, pdMS_TO_TICKS(200));
 
-    // Stop all motors regardless of tracked state
+    // Stop all motors regardless of tracked state - forced writes, never trust the shadow here
     for (uint8_t finger = 0; finger < MAX_ACTUATORS; finger++) {
         if (_fingerEnabled[finger]) {
-            if (selectChannel(finger)) {
-                _drv[finger].setRealtimeValue(0);
-            }
+            writeMux(static_cast<uint8_t>(1U << finger), true);
+            writeDrvRegister(finger, DRV2605_REG_RTPIN, 0, true);
         }
     }
-    closeChannels();
+    writeMux(0, true);
+    _preSelectedFinger = -1;
 
     // Clear all active states
     for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
@@ -347,10 +431,9 @@ Result HapticController::setFrequency(uint8_t finger, uint16_t frequencyHz) {
         return Result::ERROR_DISABLED;
     }
 
-    // Skip I2C if frequency unchanged (latency optimization)
-    if (_lastFrequency[finger] == frequencyHz) {
-        return Result::OK;
-    }
+    // Calculate drive time for LRA frequency
+    // Formula from DRV2605 datasheet
+    uint8_t driveTime = (uint8_t)((5000 / frequencyHz) & 0x1F);
 
     // Acquire I2C mutex for thread-safe access
     I2CMutexLock lock(_i2cMutex);
@@ -358,23 +441,22 @@ Result HapticController::setFrequency(uint8_t finger, uint16_t frequencyHz) {
         return Result::ERROR_BUSY;
     }
 
+    // Skip I2C if CONTROL1 already holds this drive time (latency optimization)
+    if (drvRegisterMatches(finger, DRV2605_REG_CONTROL1, driveTime)) {
+        countSkippedSequence();
+        return Result::OK;
+    }
+
     // Select channel
     if (!selectChannel(finger)) {
         return Result::ERROR_HARDWARE;
     }
 
-    // Calculate drive time for LRA frequency
-    // Formula from DRV2605 datasheet
-    uint8_t driveTime = (uint8_t)((5000 / frequencyHz) & 0x1F);
-
     // Write to CONTROL1 register (0x1B)
-    _drv[finger].writeRegister8(DRV2605_REG_CONTROL1, driveTime);
+    writeDrvRegister(finger, DRV2605_REG_CONTROL1, driveTime);
 
     closeChannels();
 
-    // Cache the frequency for future skip optimization
-    _lastFrequency[finger] = frequencyHz;
-
     return Result::OK;
 }
 
@@ -404,7 +486,7 @@ bool HapticController::selectChannelPersistent(uint8_t finger) {
     }
 
     // Open channel and leave it open (no closeChannels call)
-    _tca.openChannel(finger);
+    writeMux(static_cast<uint8_t>(1U << finger));
     _preSelectedFinger = static_cast<int8_t>(finger);  // Track pre-selected channel
     return true;
 }
@@ -437,8 +519,8 @@ Result HapticController::setFrequencyDirect(uint8_t finger, uint16_t frequencyHz
     // Calculate drive time for LRA frequency (same formula as setFrequency)
     uint8_t driveTime = (uint8_t)((5000 / frequencyHz) & 0x1F);
 
-    // Write to CONTROL1 register (0x1B)
-    _drv[finger].writeRegister8(DRV2605_REG_CONTROL1, driveTime);
+    // Write to CONTROL1 register (0x1B) - skipped if unchanged
+    writeDrvRegister(finger, DRV2605_REG_CONTROL1, driveTime);
 
     return Result::OK;
 }
@@ -478,7 +560,7 @@ Result HapticController::activatePreSelected(uint8_t finger, uint8_t amplitude)
     // Write RTP value (frequency was already set during pre-selection)
     // This is the minimal critical-path I2C: just the RTP write (~100-150µs)
     uint8_t rtpValue = amplitudeToRTP(amplitude);
-    _drv[finger].setRealtimeValue(rtpValue);
+    writeDrvRegister(finger, DRV2605_REG_RTPIN, rtpValue);
 
     // Update state
     _fingerActive[finger] = (amplitude > 0);
@@ -491,10 +573,75 @@ void HapticController::closeAllChannels() {
     // (closing is important for safety)
     I2CMutexLock lock(_i2cMutex, pdMS_TO_TICKS(50));
 
-    _tca.closeAll();
+    writeMux(0);
     _preSelectedFinger = -1;  // Invalidate pre-selection
 }
 
+// =============================================================================
+// BATCHED I2C (coalesced motor events)
+// =============================================================================
+
+Result HapticController::executeBatch(HapticBatchOp* ops, uint8_t count) {
+    if (ops == nullptr || count == 0) {
+        return Result::ERROR_INVALID_PARAM;
+    }
+
+    // One mutex acquisition for the whole boundary instead of one per event
+    I2CMutexLock lock(_i2cMutex);
+    if (!lock.acquired()) {
+        uint64_t nowUs = getMicros();
+        for (uint8_t i = 0; i < count; i++) {
+            ops[i].result = Result::ERROR_BUSY;
+            ops[i].completedUs = nowUs;
+        }
+        return Result::ERROR_BUSY;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        HapticBatchOp& op = ops[i];
+
+        if (op.finger >= MAX_ACTUATORS || !_fingerEnabled[op.finger]) {
+            op.result = (op.finger >= MAX_ACTUATORS) ? Result::ERROR_INVALID_PARAM
+                                                     : Result::ERROR_DISABLED;
+            op.completedUs = getMicros();
+            continue;
+        }
+
+        uint8_t rtpValue = amplitudeToRTP(op.amplitude);
+
+        // Switch mux exclusively to this channel (one register write, replaces
+        // open + closeAll) - skipped entirely if the RTP write will be elided
+        if (!drvRegisterMatches(op.finger, DRV2605_REG_RTPIN, rtpValue)) {
+            writeMux(static_cast<uint8_t>(1U << op.finger));
+            _preSelectedFinger = static_cast<int8_t>(op.finger);
+        }
+
+        // Frequency is off the critical path - done before waiting for the deadline
+        if (op.amplitude > 0 && op.frequencyHz >= MIN_FREQUENCY_HZ &&
+            op.frequencyHz <= MAX_FREQUENCY_HZ) {
+            uint8_t driveTime = (uint8_t)((5000 / op.frequencyHz) & 0x1F);
+            if (!drvRegisterMatches(op.finger, DRV2605_REG_CONTROL1, driveTime)) {
+                writeMux(static_cast<uint8_t>(1U << op.finger));
+                _preSelectedFinger = static_cast<int8_t>(op.finger);
+            }
+            writeDrvRegister(op.finger, DRV2605_REG_CONTROL1, driveTime);
+        }
+
+        // Hold the write until its own deadline so later events are not early
+        while (getMicros() < op.deadlineUs) {
+            // Window is sub-millisecond (MOTOR_COALESCE_WINDOW_US)
+        }
+
+        writeDrvRegister(op.finger, DRV2605_REG_RTPIN, rtpValue);
+        op.completedUs = getMicros();
+        _fingerActive[op.finger] = (op.amplitude > 0);
+        op.result = Result::OK;
+    }
+
+    closeChannels();
+    return Result::OK;
+}
+
 // =============================================================================
 // BATTERY MONITOR - Implementation
 // =============================================================================
@@ -0,0 +1,113 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief Fixed-memory log-linear latency histogram - Implementation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ */
+
+#include "latency_histogram.h"
+#include <string.h>
+
+// =============================================================================
+// CONSTRUCTOR / RESET
+// =============================================================================
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    memset(_positive, 0, sizeof(_positive));
+    memset(_negative, 0, sizeof(_negative));
+    _count = 0;
+    _min = 0;
+    _max = 0;
+}
+
+// =============================================================================
+// BUCKET LAYOUT
+// =============================================================================
+
+uint16_t LatencyHistogram::bucketIndex(uint32_t magnitude) {
+    if (magnitude > MAX_MAGNITUDE) {
+        magnitude = MAX_MAGNITUDE;
+    }
+    if (magnitude < SUB_COUNT) {
+        return static_cast<uint16_t>(magnitude);
+    }
+    // Keep the top SUB_BITS + 1 bits: the leading 1 picks the power of two,
+    // the SUB_BITS below it pick the linear sub-bucket
+    uint32_t msb = 31u - static_cast<uint32_t>(__builtin_clz(magnitude));
+    uint32_t shift = msb - SUB_BITS;
+    return static_cast<uint16_t>((shift + 1) * SUB_COUNT + ((magnitude >> shift) - SUB_COUNT));
+}
+
+uint32_t LatencyHistogram::bucketLowest(uint16_t index) {
+    uint32_t group = index / SUB_COUNT;
+    if (group == 0) {
+        return index;
+    }
+    return (SUB_COUNT + index % SUB_COUNT) << (group - 1);
+}
+
+uint32_t LatencyHistogram::bucketHighest(uint16_t index) {
+    uint32_t group = index / SUB_COUNT;
+    if (group == 0) {
+        return index;
+    }
+    return bucketLowest(index) + (1u << (group - 1)) - 1;
+}
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+void LatencyHistogram::record(int32_t value_us) {
+    if (value_us < 0) {
+        _negative[bucketIndex(static_cast<uint32_t>(-static_cast<int64_t>(value_us)))]++;
+    } else {
+        _positive[bucketIndex(static_cast<uint32_t>(value_us))]++;
+    }
+
+    if (_count == 0 || value_us < _min) _min = value_us;
+    if (_count == 0 || value_us > _max) _max = value_us;
+    _count++;
+}
+
+// =============================================================================
+// PERCENTILES
+// =============================================================================
+
+int32_t LatencyHistogram::getPercentile(uint16_t perMille) const {
+    if (_count == 0) return 0;
+
+    // Nearest rank: the ceil(p * N)-th smallest sample
+    uint64_t rank = (static_cast<uint64_t>(perMille) * _count + 999) / 1000;
+    if (rank == 0) rank = 1;
+    if (rank > _count) rank = _count;
+
+    int64_t result = _max;
+    uint64_t seen = 0;
+    bool found = false;
+
+    // Most negative first: high magnitudes of the mirrored side
+    for (int32_t i = BUCKETS - 1; i >= 0 && !found; i--) {
+        seen += _negative[i];
+        if (seen >= rank) {
+            result = -static_cast<int64_t>(bucketLowest(static_cast<uint16_t>(i)));
+            found = true;
+        }
+    }
+    for (uint16_t i = 0; i < BUCKETS && !found; i++) {
+        seen += _positive[i];
+        if (seen >= rank) {
+            // The top bucket also holds saturated values: only max bounds it
+            result = (i == BUCKETS - 1) ? _max : bucketHighest(i);
+            found = true;
+        }
+    }
+
+    if (result < _min) result = _min;
+    if (result > _max) result = _max;
+    return static_cast<int32_t>(result);
+}
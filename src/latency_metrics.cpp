@@ -11,14 +11,10 @@
 LatencyMetrics latencyMetrics;
 
 // =============================================================================
-// RESET AND STATE MANAGEMENT
+// SHARD STATISTICS
 // =============================================================================
 
-void LatencyMetrics::reset() {
-    // State
-    enabled = false;
-    verboseLogging = false;
-
+void LatencyExecutionStats::clear() {
     // Execution drift
     lastDrift_us = 0;
     minDrift_us = INT32_MAX;
@@ -28,12 +24,81 @@ void LatencyMetrics::reset() {
     lateCount = 0;
     earlyCount = 0;
 
-    // Ongoing RTT
+    // Motor dispatch
+    spinWaitCount = 0;
+    maxSpinWait_us = 0;
+    totalSpinWait_us = 0;
+}
+
+int32_t LatencyExecutionStats::getAverageDrift() const {
+    if (sampleCount == 0) return 0;
+    return (int32_t)(totalDrift_us / (int64_t)sampleCount);
+}
+
+uint32_t LatencyExecutionStats::getJitter() const {
+    if (sampleCount == 0) return 0;
+    if (minDrift_us == INT32_MAX || maxDrift_us == INT32_MIN) return 0;
+    return (uint32_t)(maxDrift_us - minDrift_us);
+}
+
+uint32_t LatencyExecutionStats::getAverageSpinWait() const {
+    if (spinWaitCount == 0) return 0;
+    return (uint32_t)(totalSpinWait_us / (uint64_t)spinWaitCount);
+}
+
+void LatencyRttStats::clear() {
     lastRtt_us = 0;
     minRtt_us = UINT32_MAX;
     maxRtt_us = 0;
     totalRtt_us = 0;
     rttSampleCount = 0;
+}
+
+uint32_t LatencyRttStats::getAverageRtt() const {
+    if (rttSampleCount == 0) return 0;
+    return (uint32_t)(totalRtt_us / (uint64_t)rttSampleCount);
+}
+
+// =============================================================================
+// RESET AND STATE MANAGEMENT
+// =============================================================================
+
+LatencyMetrics::LatencyMetrics() :
+    _resetEpoch(0)
+{
+    _execution.epoch = 0;
+    _execution.stats.clear();
+    _rtt.epoch = 0;
+    _rtt.stats.clear();
+    reset();
+}
+
+void LatencyMetrics::reset() {
+    // State
+    enabled = false;
+    verboseLogging = false;
+
+    // Execution drift, motor dispatch, ongoing RTT: owned by the motor task
+    // and BLE callback, which clear their shard when they see the new epoch
+    _resetEpoch.fetch_add(1, std::memory_order_release);
+
+    // Macrocycle start
+    idlePrecomputedCount = 0;
+    maxIdlePrecomputed_us = 0;
+    totalIdlePrecomputed_us = 0;
+    idleInlineCount = 0;
+    maxIdleInline_us = 0;
+    totalIdleInline_us = 0;
+
+    // Bilateral skew
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    minSkew_us = INT32_MAX;
+    maxSkew_us = INT32_MIN;
+    totalSkew_us = 0;
+    skewSampleCount = 0;
+    recentSkewHead = 0;
+    __set_PRIMASK(primask);
 
     // Sync quality
     syncProbeCount = 0;
@@ -71,24 +136,66 @@ void LatencyMetrics::disable() {
 // RECORDING METHODS
 // =============================================================================
 
-void LatencyMetrics::recordExecution(int32_t drift_us) {
+void LatencyMetrics::beginExecutionWrite() {
+    _execution.lock.writeBegin();
+
+    // First sample after reset(): clear the shard here, in its only writer
+    uint32_t epoch = _resetEpoch.load(std::memory_order_acquire);
+    if (_execution.epoch != epoch) {
+        _execution.stats.clear();
+        _execution.activateDrift.reset();
+        _execution.deactivateDrift.reset();
+        for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+            _execution.fingerDrift[i].reset();
+        }
+        _execution.epoch = epoch;
+    }
+}
+
+void LatencyMetrics::beginRttWrite() {
+    _rtt.lock.writeBegin();
+
+    uint32_t epoch = _resetEpoch.load(std::memory_order_acquire);
+    if (_rtt.epoch != epoch) {
+        _rtt.stats.clear();
+        _rtt.histogram.reset();
+        _rtt.epoch = epoch;
+    }
+}
+
+void LatencyMetrics::recordExecution(int32_t drift_us, bool activate, uint8_t finger) {
     if (!enabled) return;
 
-    lastDrift_us = drift_us;
-    totalDrift_us += drift_us;
-    sampleCount++;
+    beginExecutionWrite();
+    LatencyExecutionStats& stats = _execution.stats;
+
+    stats.lastDrift_us = drift_us;
+    stats.totalDrift_us += drift_us;
+    stats.sampleCount++;
 
     // Update min/max
-    if (drift_us < minDrift_us) minDrift_us = drift_us;
-    if (drift_us > maxDrift_us) maxDrift_us = drift_us;
+    if (drift_us < stats.minDrift_us) stats.minDrift_us = drift_us;
+    if (drift_us > stats.maxDrift_us) stats.maxDrift_us = drift_us;
+
+    // Update distributions
+    if (activate) {
+        _execution.activateDrift.record(drift_us);
+        if (finger < MAX_ACTUATORS) {
+            _execution.fingerDrift[finger].record(drift_us);
+        }
+    } else {
+        _execution.deactivateDrift.record(drift_us);
+    }
 
     // Track late/early
     if (drift_us > (int32_t)LATENCY_LATE_THRESHOLD_US) {
-        lateCount++;
+        stats.lateCount++;
     } else if (drift_us < 0) {
-        earlyCount++;
+        stats.earlyCount++;
     }
 
+    _execution.lock.writeEnd();
+
     // Verbose logging
     if (verboseLogging) {
         Serial.printf("[LATENCY] Execution drift: %+ld us%s\n",
@@ -97,16 +204,49 @@ void LatencyMetrics::recordExecution(int32_t drift_us) {
     }
 }
 
+void LatencyMetrics::recordSpinWait(uint32_t spin_us) {
+    if (!enabled) return;
+
+    beginExecutionWrite();
+    LatencyExecutionStats& stats = _execution.stats;
+    stats.spinWaitCount++;
+    stats.totalSpinWait_us += spin_us;
+    if (spin_us > stats.maxSpinWait_us) stats.maxSpinWait_us = spin_us;
+    _execution.lock.writeEnd();
+}
+
+void LatencyMetrics::recordIdleStep(uint32_t step_us, bool precomputed) {
+    if (!enabled) return;
+
+    if (precomputed) {
+        idlePrecomputedCount++;
+        totalIdlePrecomputed_us += step_us;
+        if (step_us > maxIdlePrecomputed_us) maxIdlePrecomputed_us = step_us;
+    } else {
+        idleInlineCount++;
+        totalIdleInline_us += step_us;
+        if (step_us > maxIdleInline_us) maxIdleInline_us = step_us;
+    }
+}
+
 void LatencyMetrics::recordRtt(uint32_t rtt_us) {
     if (!enabled) return;
 
-    lastRtt_us = rtt_us;
-    totalRtt_us += rtt_us;
-    rttSampleCount++;
+    beginRttWrite();
+    LatencyRttStats& stats = _rtt.stats;
+
+    stats.lastRtt_us = rtt_us;
+    stats.totalRtt_us += rtt_us;
+    stats.rttSampleCount++;
 
     // Update min/max
-    if (rtt_us < minRtt_us) minRtt_us = rtt_us;
-    if (rtt_us > maxRtt_us) maxRtt_us = rtt_us;
+    if (rtt_us < stats.minRtt_us) stats.minRtt_us = rtt_us;
+    if (rtt_us > stats.maxRtt_us) stats.maxRtt_us = rtt_us;
+
+    // Update distribution (saturates in the top bucket; max above is exact)
+    _rtt.histogram.record((rtt_us > (uint32_t)INT32_MAX) ? INT32_MAX : (int32_t)rtt_us);
+
+    _rtt.lock.writeEnd();
 
     // Verbose logging
     if (verboseLogging) {
@@ -116,6 +256,28 @@ void LatencyMetrics::recordRtt(uint32_t rtt_us) {
     }
 }
 
+void LatencyMetrics::recordBilateralSkew(int32_t skew_us) {
+    // Always record skew (even if metrics disabled, it's what the therapy is judged on).
+    // First sample seeds min/max: this can run before reset() ever has.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (skewSampleCount == 0 || skew_us < minSkew_us) minSkew_us = skew_us;
+    if (skewSampleCount == 0 || skew_us > maxSkew_us) maxSkew_us = skew_us;
+    if (skewSampleCount == 0) totalSkew_us = 0;
+
+    totalSkew_us += skew_us;
+    skewSampleCount++;
+
+    uint32_t absSkew = (skew_us < 0) ? (uint32_t)(-(int64_t)skew_us) : (uint32_t)skew_us;
+    recentAbsSkew_us[recentSkewHead] = (absSkew > UINT16_MAX) ? UINT16_MAX : (uint16_t)absSkew;
+    recentSkewHead = (uint16_t)((recentSkewHead + 1) % LATENCY_SKEW_WINDOW);
+    __set_PRIMASK(primask);
+
+    if (verboseLogging) {
+        Serial.printf("[LATENCY] Bilateral skew: %+ld us\n", (long)skew_us);
+    }
+}
+
 void LatencyMetrics::recordSyncProbe(uint32_t rtt_us) {
     // Always record sync probes (even if metrics disabled, sync quality is important)
     syncProbeCount++;
@@ -147,24 +309,130 @@ void LatencyMetrics::finalizeSyncProbing(int64_t offset_us) {
     Serial.println(F(""));
 }
 
+// =============================================================================
+// SNAPSHOTS
+// =============================================================================
+
+LatencyExecutionStats LatencyMetrics::getExecutionStats() const {
+    LatencyExecutionStats snapshot;
+    uint32_t start;
+    do {
+        start = _execution.lock.readBegin();
+        if (_execution.epoch == _resetEpoch.load(std::memory_order_acquire)) {
+            snapshot = _execution.stats;
+        } else {
+            snapshot.clear();  // Reset, writer hasn't cleared yet
+        }
+    } while (_execution.lock.readRetry(start));
+    return snapshot;
+}
+
+LatencyRttStats LatencyMetrics::getRttStats() const {
+    LatencyRttStats snapshot;
+    uint32_t start;
+    do {
+        start = _rtt.lock.readBegin();
+        if (_rtt.epoch == _resetEpoch.load(std::memory_order_acquire)) {
+            snapshot = _rtt.stats;
+        } else {
+            snapshot.clear();
+        }
+    } while (_rtt.lock.readRetry(start));
+    return snapshot;
+}
+
+LatencyPercentiles LatencyMetrics::readPercentiles(const SeqLock& lock, const uint32_t& shardEpoch,
+                                                   const LatencyHistogram& histogram) const {
+    // Walk the buckets inside the read section; a torn walk is thrown away
+    LatencyPercentiles result;
+    uint32_t start;
+    do {
+        start = lock.readBegin();
+        result = LatencyPercentiles();
+        if (shardEpoch == _resetEpoch.load(std::memory_order_acquire)) {
+            result.count = histogram.getCount();
+            result.min_us = histogram.getMin();
+            result.p50_us = histogram.getPercentile(500);
+            result.p90_us = histogram.getPercentile(900);
+            result.p99_us = histogram.getPercentile(990);
+            result.p999_us = histogram.getPercentile(999);
+            result.max_us = histogram.getMax();
+        }
+    } while (lock.readRetry(start));
+    return result;
+}
+
+LatencyPercentiles LatencyMetrics::getDriftPercentiles(bool activate) const {
+    return readPercentiles(_execution.lock, _execution.epoch,
+                           activate ? _execution.activateDrift : _execution.deactivateDrift);
+}
+
+LatencyPercentiles LatencyMetrics::getFingerDriftPercentiles(uint8_t finger) const {
+    if (finger >= MAX_ACTUATORS) return LatencyPercentiles();
+    return readPercentiles(_execution.lock, _execution.epoch, _execution.fingerDrift[finger]);
+}
+
+LatencyPercentiles LatencyMetrics::getRttPercentiles() const {
+    return readPercentiles(_rtt.lock, _rtt.epoch, _rtt.histogram);
+}
+
 // =============================================================================
 // COMPUTED METRICS
 // =============================================================================
 
 int32_t LatencyMetrics::getAverageDrift() const {
-    if (sampleCount == 0) return 0;
-    return (int32_t)(totalDrift_us / (int64_t)sampleCount);
+    return getExecutionStats().getAverageDrift();
 }
 
 uint32_t LatencyMetrics::getAverageRtt() const {
-    if (rttSampleCount == 0) return 0;
-    return (uint32_t)(totalRtt_us / (uint64_t)rttSampleCount);
+    return getRttStats().getAverageRtt();
+}
+
+uint32_t LatencyMetrics::getAverageSpinWait() const {
+    return getExecutionStats().getAverageSpinWait();
+}
+
+uint32_t LatencyMetrics::getAverageIdleStep(bool precomputed) const {
+    if (precomputed) {
+        if (idlePrecomputedCount == 0) return 0;
+        return (uint32_t)(totalIdlePrecomputed_us / (uint64_t)idlePrecomputedCount);
+    }
+    if (idleInlineCount == 0) return 0;
+    return (uint32_t)(totalIdleInline_us / (uint64_t)idleInlineCount);
+}
+
+int32_t LatencyMetrics::getAverageSkew() const {
+    if (skewSampleCount == 0) return 0;
+    return (int32_t)(totalSkew_us / (int64_t)skewSampleCount);
+}
+
+uint32_t LatencyMetrics::getSkewP99Abs() const {
+    uint32_t n = (skewSampleCount < LATENCY_SKEW_WINDOW) ? skewSampleCount : LATENCY_SKEW_WINDOW;
+    if (n == 0) return 0;
+
+    // p99 (nearest rank) is the k-th largest sample; keep only the top k
+    // instead of sorting a copy of the window (k <= 3 for a 256 window)
+    constexpr uint32_t TOP_MAX = LATENCY_SKEW_WINDOW / 100 + 1;
+    uint32_t rank = (99 * n + 99) / 100;
+    uint32_t k = n - rank + 1;
+    uint16_t top[TOP_MAX];
+    uint32_t topCount = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint16_t v = recentAbsSkew_us[i];
+        if (topCount == k && v <= top[k - 1]) continue;
+        uint32_t pos = (topCount < k) ? topCount++ : k - 1;
+        while (pos > 0 && top[pos - 1] < v) {
+            top[pos] = top[pos - 1];
+            pos--;
+        }
+        top[pos] = v;
+    }
+    return top[k - 1];
 }
 
 uint32_t LatencyMetrics::getJitter() const {
-    if (sampleCount == 0) return 0;
-    if (minDrift_us == INT32_MAX || maxDrift_us == INT32_MIN) return 0;
-    return (uint32_t)(maxDrift_us - minDrift_us);
+    return getExecutionStats().getJitter();
 }
 
 const char* LatencyMetrics::getSyncConfidence() const {
@@ -185,7 +453,35 @@ const char* LatencyMetrics::getSyncConfidence() const {
 // REPORTING
 // =============================================================================
 
+/**
+ * @brief Print one histogram's p50/p90/p99/p99.9 on a single line
+ * @param label Left column (padded by the caller)
+ * @param percentiles Snapshot to print
+ * @param sign Print a +/- sign (drift) or not (RTT)
+ */
+static void printPercentiles(const char* label, const LatencyPercentiles& percentiles, bool sign) {
+    if (percentiles.count == 0) {
+        Serial.printf("  %s (no samples)\n", label);
+        return;
+    }
+    if (sign) {
+        Serial.printf("  %s p50 %+ld  p90 %+ld  p99 %+ld  p99.9 %+ld us (%lu)\n",
+                      label, (long)percentiles.p50_us, (long)percentiles.p90_us,
+                      (long)percentiles.p99_us, (long)percentiles.p999_us,
+                      (unsigned long)percentiles.count);
+    } else {
+        Serial.printf("  %s p50 %ld  p90 %ld  p99 %ld  p99.9 %ld us (%lu)\n",
+                      label, (long)percentiles.p50_us, (long)percentiles.p90_us,
+                      (long)percentiles.p99_us, (long)percentiles.p999_us,
+                      (unsigned long)percentiles.count);
+    }
+}
+
 void LatencyMetrics::printReport() const {
+    // One snapshot per shard so every line of a section agrees
+    LatencyExecutionStats exec = getExecutionStats();
+    LatencyRttStats rtt = getRttStats();
+
     Serial.println(F(""));
     Serial.println(F("========== LATENCY METRICS =========="));
 
@@ -198,7 +494,7 @@ void LatencyMetrics::printReport() const {
     } else {
         Serial.println(F("DISABLED"));
     }
-    Serial.printf("Buzzes: %lu\n", (unsigned long)sampleCount);
+    Serial.printf("Buzzes: %lu\n", (unsigned long)exec.sampleCount);
 
     Serial.println(F("-------------------------------------"));
 
@@ -221,24 +517,35 @@ void LatencyMetrics::printReport() const {
 
     // Execution drift section
     Serial.println(F("EXECUTION DRIFT:"));
-    if (sampleCount > 0) {
-        Serial.printf("  Last:    %+ld us\n", (long)lastDrift_us);
-        Serial.printf("  Average: %+ld us\n", (long)getAverageDrift());
-        Serial.printf("  Min:     %+ld us\n", (long)minDrift_us);
-        Serial.printf("  Max:     %+ld us\n", (long)maxDrift_us);
-        Serial.printf("  Jitter:  %lu us\n", (unsigned long)getJitter());
+    if (exec.sampleCount > 0) {
+        Serial.printf("  Last:    %+ld us\n", (long)exec.lastDrift_us);
+        Serial.printf("  Average: %+ld us\n", (long)exec.getAverageDrift());
+        Serial.printf("  Min:     %+ld us\n", (long)exec.minDrift_us);
+        Serial.printf("  Max:     %+ld us\n", (long)exec.maxDrift_us);
+        Serial.printf("  Jitter:  %lu us\n", (unsigned long)exec.getJitter());
 
         // Late percentage
-        float latePercent = (sampleCount > 0) ?
-            (100.0f * static_cast<float>(lateCount) / static_cast<float>(sampleCount)) : 0.0f;
+        float latePercent = (exec.sampleCount > 0) ?
+            (100.0f * static_cast<float>(exec.lateCount) / static_cast<float>(exec.sampleCount)) : 0.0f;
         Serial.printf("  Late (>%lu us): %lu (%.1f%%)\n",
                       (unsigned long)LATENCY_LATE_THRESHOLD_US,
-                      (unsigned long)lateCount,
+                      (unsigned long)exec.lateCount,
                       latePercent);
 
-        if (earlyCount > 0) {
+        if (exec.earlyCount > 0) {
             Serial.printf("  Early (<0):  %lu (unexpected)\n",
-                          (unsigned long)earlyCount);
+                          (unsigned long)exec.earlyCount);
+        }
+
+        printPercentiles("ACTIVATE:  ", getDriftPercentiles(true), true);
+        printPercentiles("DEACTIVATE:", getDriftPercentiles(false), true);
+        for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
+            LatencyPercentiles finger = getFingerDriftPercentiles(i);
+            if (finger.count > 0) {
+                char label[16];
+                snprintf(label, sizeof(label), "  Finger %u:", (unsigned)i);
+                printPercentiles(label, finger, true);
+            }
         }
     } else {
         Serial.println(F("  (no execution data)"));
@@ -246,14 +553,68 @@ void LatencyMetrics::printReport() const {
 
     Serial.println(F("-------------------------------------"));
 
+    // Motor dispatch section (compare drift above across dispatch builds)
+    Serial.printf("MOTOR DISPATCH (%s):\n",
+                  (MOTOR_DISPATCH_MODE == MOTOR_DISPATCH_HW_TIMER) ? "HW_TIMER" : "BUSY_WAIT");
+    if (exec.spinWaitCount > 0) {
+        Serial.printf("  Avg spin: %lu us\n", (unsigned long)exec.getAverageSpinWait());
+        Serial.printf("  Max spin: %lu us\n", (unsigned long)exec.maxSpinWait_us);
+        Serial.printf("  Total:    %lu ms over %lu events\n",
+                      (unsigned long)(exec.totalSpinWait_us / 1000),
+                      (unsigned long)exec.spinWaitCount);
+    } else {
+        Serial.println(F("  (no dispatch data)"));
+    }
+
+    Serial.println(F("-------------------------------------"));
+
+    // Macrocycle start section (inline = generation on the critical path)
+    Serial.println(F("MACROCYCLE START (IDLE step):"));
+    if (idlePrecomputedCount > 0 || idleInlineCount > 0) {
+        if (idlePrecomputedCount > 0) {
+            Serial.printf("  Precomputed: avg %lu us, max %lu us (%lu steps)\n",
+                          (unsigned long)getAverageIdleStep(true),
+                          (unsigned long)maxIdlePrecomputed_us,
+                          (unsigned long)idlePrecomputedCount);
+        }
+        if (idleInlineCount > 0) {
+            Serial.printf("  Inline gen:  avg %lu us, max %lu us (%lu steps)\n",
+                          (unsigned long)getAverageIdleStep(false),
+                          (unsigned long)maxIdleInline_us,
+                          (unsigned long)idleInlineCount);
+        }
+    } else {
+        Serial.println(F("  (no IDLE step data)"));
+    }
+
+    Serial.println(F("-------------------------------------"));
+
+    // Bilateral skew section (per-event, from SECONDARY feedback)
+    Serial.println(F("BILATERAL SKEW (PRIMARY only):"));
+    if (skewSampleCount > 0) {
+        Serial.printf("  Average: %+ld us\n", (long)getAverageSkew());
+        Serial.printf("  Min:     %+ld us\n", (long)minSkew_us);
+        Serial.printf("  Max:     %+ld us\n", (long)maxSkew_us);
+        Serial.printf("  p99 |x|: %lu us (last %lu events)\n",
+                      (unsigned long)getSkewP99Abs(),
+                      (unsigned long)((skewSampleCount < LATENCY_SKEW_WINDOW) ?
+                                      skewSampleCount : LATENCY_SKEW_WINDOW));
+        Serial.printf("  Samples: %lu\n", (unsigned long)skewSampleCount);
+    } else {
+        Serial.println(F("  (no skew feedback)"));
+    }
+
+    Serial.println(F("-------------------------------------"));
+
     // Ongoing RTT section
     Serial.println(F("ONGOING RTT (PRIMARY only):"));
-    if (rttSampleCount > 0) {
-        Serial.printf("  Last:    %lu us\n", (unsigned long)lastRtt_us);
-        Serial.printf("  Average: %lu us\n", (unsigned long)getAverageRtt());
-        Serial.printf("  Min:     %lu us\n", (unsigned long)minRtt_us);
-        Serial.printf("  Max:     %lu us\n", (unsigned long)maxRtt_us);
-        Serial.printf("  Samples: %lu\n", (unsigned long)rttSampleCount);
+    if (rtt.rttSampleCount > 0) {
+        Serial.printf("  Last:    %lu us\n", (unsigned long)rtt.lastRtt_us);
+        Serial.printf("  Average: %lu us\n", (unsigned long)rtt.getAverageRtt());
+        Serial.printf("  Min:     %lu us\n", (unsigned long)rtt.minRtt_us);
+        Serial.printf("  Max:     %lu us\n", (unsigned long)rtt.maxRtt_us);
+        Serial.printf("  Samples: %lu\n", (unsigned long)rtt.rttSampleCount);
+        printPercentiles("Dist:   ", getRttPercentiles(), false);
     } else {
         Serial.println(F("  (no RTT data)"));
     }
@@ -28,11 +28,19 @@
 #include "therapy_engine.h"
 #include "state_machine.h"
 #include "menu_controller.h"
+#include "command_parser.h"
 #include "profile_manager.h"
 #include "latency_metrics.h"
 #include "deferred_queue.h"
 #include "activation_queue.h"
 #include "motor_event_buffer.h"
+#include "activation_log.h"
+#include "status_publisher.h"
+
+#if MOTOR_DISPATCH_MODE == MOTOR_DISPATCH_HW_TIMER
+// Header-only library with ISR definitions - include from exactly one translation unit
+#include <NRF52TimerInterrupt.h>
+#endif
 
 // =============================================================================
 // CONFIGURATION
@@ -54,6 +62,7 @@ TherapyStateMachine stateMachine;
 MenuController menu;
 ProfileManager profiles;
 SimpleSyncProtocol syncProtocol;
+StatusPublisher statusPublisher;    // SUBSCRIBE pushes to the phone (PRIMARY, loop only)
 
 // =============================================================================
 // STATE VARIABLES
@@ -65,6 +74,7 @@ bool bleReady = false;
 
 // Timing
 uint32_t lastBatteryCheck = 0;
+BatteryStatus lastBatteryStatus;   // From setup() / the periodic check (a read blocks for the ADC samples)
 uint32_t lastKeepalive = 0;        // Time of last keepalive PING sent (PRIMARY)
 uint32_t lastStatusPrint = 0;
 
@@ -86,6 +96,45 @@ bool autoStartTriggered = false; // Prevent repeated auto-starts (only accessed
 volatile uint32_t lastKeepaliveReceived = 0;  // SECONDARY: Last PING/BUZZ from PRIMARY
 volatile uint32_t lastSecondaryKeepalive = 0; // PRIMARY: Last PONG from SECONDARY
 
+// MACROCYCLE wire format negotiated with SECONDARY (PRIMARY only)
+// Reset to TEXT_V4 on every SECONDARY connect; upgraded when CAPS:MB<ver> arrives
+volatile MacrocycleWireFormat secondaryMacrocycleFormat = MacrocycleWireFormat::TEXT_V4;
+
+// Received MACROCYCLE sequence IDs (SECONDARY only, BLE callback context)
+// Detects resends from a pipelined PRIMARY; reset on every PRIMARY connect
+static MacrocycleReceiveWindow macrocycleReceiveWindow;
+
+// Seeded macrocycle timeline (SECONDARY only)
+// Beacons update it in BLE callback context, coastSeededTimeline() in loop()
+// generates through a late beacon - shared fields are read/written with interrupts disabled (PRIMASK)
+struct SeededTimeline {
+    bool loaded;               // SS: session received (BLE callback writes only)
+    bool active;               // At least one beacon staged since loading
+    uint16_t tag;              // SeededSession::tag() of the loaded session
+    uint8_t coastBudget;       // SeededSession::coastBudget
+    uint8_t coasted;           // Macrocycles generated locally since the last beacon
+    uint32_t lastBeaconSeq;    // Newest sequence ID received in a beacon
+    uint32_t lastSeq;          // Newest sequence ID staged (beacon or coasted)
+    uint64_t nextPrimaryBase;  // Predicted baseTime of lastSeq + 1 (PRIMARY clock)
+    int64_t clockOffset;       // Offset from the newest beacon
+};
+static SeededTimeline seededTimeline = {};
+
+// Seeded session announcement (PRIMARY only)
+// SS: rides along with every beacon until SECONDARY ACKs one of the session's
+// beacons (it only ACKs beacons for a session it holds), so a lost SS: costs
+// one macrocycle instead of the session. Reset on every SECONDARY connect
+static uint64_t seededSessionSentSeed = 0;            // loop() only, 0 = none
+static volatile uint32_t seededSessionFirstSeq = 0;   // First beacon of the session
+static volatile bool seededSessionAcked = false;      // Set by MC_ACK (BLE callback)
+
+// Per-event execution feedback from SECONDARY (PRIMARY only)
+// Parsed from MC_ACK in the BLE callback, matched against activationLog in
+// loop(). Single slot: feedback arrives once per macrocycle and loop() runs
+// far more often, so a newer one overwriting an unread one only loses stats.
+static MacrocycleFeedback secondaryFeedback;          // Guarded by PRIMASK
+static volatile bool secondaryFeedbackPending = false;
+
 // PRIMARY-side keepalive timeout
 // Aligned with SECONDARY's KEEPALIVE_TIMEOUT_MS (6000) to prevent race conditions
 // where PRIMARY shuts down before SECONDARY has timed out
@@ -118,11 +167,40 @@ const char *FINGER_NAMES[] = {"Index", "Middle", "Ring", "Pinky"};
 // FREERTOS MOTOR TASK
 // =============================================================================
 // High-priority task (Priority 4/HIGHEST) for motor events.
-// Uses FreeRTOS timing + busy-wait for sub-millisecond precision.
+// Uses FreeRTOS timing + busy-wait for sub-millisecond precision, or a
+// one-shot hardware timer wakeup when built with MOTOR_DISPATCH_MODE=HW_TIMER.
 // Handles BOTH activations AND deactivations from unified event queue.
 
 static TaskHandle_t motorTaskHandle = nullptr;
 
+#if MOTOR_DISPATCH_MODE == MOTOR_DISPATCH_HW_TIMER
+// TIMER0 belongs to the SoftDevice; TIMER3 is unused by the Bluefruit core
+static NRF52Timer motorDispatchTimer(NRF_TIMER_3);
+
+/**
+ * @brief One-shot TIMER3 compare ISR - wakes the motor task
+ *
+ * The library timer is periodic, so it is stopped on first fire. No I2C here:
+ * the motor task performs the write once it is scheduled.
+ */
+static void motorDispatchTimerISR() {
+    motorDispatchTimer.stopTimer();
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(motorTaskHandle, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+/**
+ * @brief Arm TIMER3 to wake the motor task MOTOR_TIMER_WAKE_LEAD_US before an event
+ * @param delayUs Time until the event (must exceed the lead time)
+ */
+static void armMotorDispatchTimer(int64_t delayUs) {
+    unsigned long intervalUs = static_cast<unsigned long>(delayUs - MOTOR_TIMER_WAKE_LEAD_US);
+    motorDispatchTimer.stopTimer();
+    motorDispatchTimer.attachInterruptInterval(intervalUs, motorDispatchTimerISR);
+}
+#endif
+
 /**
  * @brief Pre-select the next activation's I2C channel
  *
@@ -142,17 +220,61 @@ static void preSelectNextActivation() {
     }
 }
 
+/**
+ * @brief Record drift for an executed motor event and log it in debug mode
+ * @param event The executed event
+ * @param drift_us Completion time minus scheduled time
+ * @param suffix Appended to the debug line (e.g. " [FAST]", " [BATCH]")
+ *
+ * H6 fix: Handles 64-bit lateness values correctly in printf.
+ */
+static void reportMotorEventDrift(const MotorEvent& event, int64_t drift_us, const char* suffix) {
+    // Record latency metrics (if enabled)
+    // Note: Deactivation timing is less critical than activation for bilateral sync,
+    // so it gets its own distribution instead of diluting the ACTIVATE percentiles
+    if (latencyMetrics.enabled) {
+        latencyMetrics.recordExecution(static_cast<int32_t>(drift_us),
+                                       event.type == MotorEventType::ACTIVATE,
+                                       event.finger);
+    }
+
+    if (!profiles.getDebugMode()) {
+        return;
+    }
+
+    if (event.type == MotorEventType::ACTIVATE) {
+        if (drift_us >= 0 && drift_us < 1000000) {
+            Serial.printf("[MOTOR_TASK] ACTIVATE F%d A%d @%dHz (drift: %ldus)%s\n",
+                          event.finger, event.amplitude, event.frequencyHz,
+                          static_cast<long>(drift_us), suffix);
+        } else {
+            // Large or negative drift - print with more precision
+            Serial.printf("[MOTOR_TASK] ACTIVATE F%d A%d @%dHz (drift: %ld.%06ldus)%s\n",
+                          event.finger, event.amplitude, event.frequencyHz,
+                          static_cast<long>(drift_us / 1000000),
+                          static_cast<long>(drift_us % 1000000), suffix);
+        }
+    } else {
+        if (drift_us >= 0 && drift_us < 1000000) {
+            Serial.printf("[MOTOR_TASK] DEACTIVATE F%d (drift: %ldus)%s\n",
+                          event.finger, static_cast<long>(drift_us), suffix);
+        } else {
+            Serial.printf("[MOTOR_TASK] DEACTIVATE F%d (drift: %ld.%06ldus)%s\n",
+                          event.finger,
+                          static_cast<long>(drift_us / 1000000),
+                          static_cast<long>(drift_us % 1000000), suffix);
+        }
+    }
+}
+
 /**
  * @brief Execute a motor event (activation or deactivation)
  * @param event The motor event to execute
  *
  * M1 fix: Captures lateness AFTER motor I2C operations for accurate timing.
- * H6 fix: Handles 64-bit lateness values correctly in printf.
  * Phase 2: Uses I2C pre-selection for faster activation when available.
  */
 static void executeMotorEvent(const MotorEvent& event) {
-    uint64_t beforeOp = getMicros();
-
     if (event.type == MotorEventType::ACTIVATE) {
         if (haptic.isEnabled(event.finger)) {
             // Phase 2: Check if this finger is pre-selected for fast-path activation
@@ -171,29 +293,9 @@ static void executeMotorEvent(const MotorEvent& event) {
 
             // M1 fix: Capture time AFTER I2C ops for true lateness
             uint64_t afterOp = getMicros();
+            activationLog.recordActivation(event.timeUs, afterOp);
             int64_t drift_us = static_cast<int64_t>(afterOp - event.timeUs);
-
-            // Record latency metrics (if enabled)
-            if (latencyMetrics.enabled) {
-                latencyMetrics.recordExecution(static_cast<int32_t>(drift_us));
-            }
-
-            if (profiles.getDebugMode()) {
-                // H6 fix: Handle 64-bit lateness (split into seconds + microseconds if large)
-                if (drift_us >= 0 && drift_us < 1000000) {
-                    Serial.printf("[MOTOR_TASK] ACTIVATE F%d A%d @%dHz (drift: %ldus)%s\n",
-                                  event.finger, event.amplitude, event.frequencyHz,
-                                  static_cast<long>(drift_us),
-                                  usedFastPath ? " [FAST]" : "");
-                } else {
-                    // Large or negative drift - print with more precision
-                    Serial.printf("[MOTOR_TASK] ACTIVATE F%d A%d @%dHz (drift: %ld.%06ldus)%s\n",
-                                  event.finger, event.amplitude, event.frequencyHz,
-                                  static_cast<long>(drift_us / 1000000),
-                                  static_cast<long>(drift_us % 1000000),
-                                  usedFastPath ? " [FAST]" : "");
-                }
-            }
+            reportMotorEventDrift(event, drift_us, usedFastPath ? " [FAST]" : "");
         }
     } else {
         haptic.deactivate(event.finger);
@@ -201,32 +303,109 @@ static void executeMotorEvent(const MotorEvent& event) {
         // M1 fix: Capture time AFTER I2C ops for true drift measurement
         uint64_t afterOp = getMicros();
         int64_t drift_us = static_cast<int64_t>(afterOp - event.timeUs);
+        reportMotorEventDrift(event, drift_us, "");
 
-        // Record latency metrics for deactivation (if enabled)
-        // Note: Deactivation timing is less critical than activation for bilateral sync,
-        // but we record it for completeness and to track overall timing precision
-        if (latencyMetrics.enabled) {
-            latencyMetrics.recordExecution(static_cast<int32_t>(drift_us));
+        // Phase 2: Pre-select next activation's channel while we have time
+        // This moves mux selection OFF the critical path for the next ACTIVATE
+        preSelectNextActivation();
+    }
+}
+
+/**
+ * @brief Execute near-simultaneous motor events as one locked I2C batch
+ * @param events Events in deadline order (from dequeueEventsWithin)
+ * @param count Number of events (2..MOTOR_COALESCE_MAX_EVENTS)
+ *
+ * Busy boundaries (DEACTIVATE F0 at T, ACTIVATE F1 at T+few hundred us) would
+ * otherwise take the I2C mutex and do open/write/close per event. The batch
+ * switches the mux once per op and waits for each op's own deadline, so drift
+ * is still measured and reported per event.
+ */
+static void executeMotorBatch(const MotorEvent* events, uint8_t count) {
+    HapticBatchOp ops[MOTOR_COALESCE_MAX_EVENTS];
+    const MotorEvent* opEvents[MOTOR_COALESCE_MAX_EVENTS];
+    uint8_t opCount = 0;
+
+    for (uint8_t i = 0; i < count && opCount < MOTOR_COALESCE_MAX_EVENTS; i++) {
+        const MotorEvent& event = events[i];
+        bool isActivate = (event.type == MotorEventType::ACTIVATE);
+
+        // Same rule as executeMotorEvent: disabled fingers are never activated
+        if (isActivate && !haptic.isEnabled(event.finger)) {
+            continue;
         }
 
-        if (profiles.getDebugMode()) {
-            // H6 fix: Handle 64-bit drift
-            if (drift_us >= 0 && drift_us < 1000000) {
-                Serial.printf("[MOTOR_TASK] DEACTIVATE F%d (drift: %ldus)\n",
-                              event.finger, static_cast<long>(drift_us));
-            } else {
-                Serial.printf("[MOTOR_TASK] DEACTIVATE F%d (drift: %ld.%06ldus)\n",
-                              event.finger,
-                              static_cast<long>(drift_us / 1000000),
-                              static_cast<long>(drift_us % 1000000));
-            }
+        HapticBatchOp& op = ops[opCount];
+        op.deadlineUs = event.timeUs;
+        op.finger = event.finger;
+        op.amplitude = isActivate ? event.amplitude : 0;
+        op.frequencyHz = isActivate ? event.frequencyHz : 0;
+        op.result = Result::OK;
+        op.completedUs = 0;
+        opEvents[opCount] = &event;
+        opCount++;
+    }
+
+    if (opCount == 0) {
+        return;
+    }
+
+    haptic.executeBatch(ops, opCount);
+
+    for (uint8_t i = 0; i < opCount; i++) {
+        if (opEvents[i]->type == MotorEventType::ACTIVATE) {
+            activationLog.recordActivation(opEvents[i]->timeUs, ops[i].completedUs);
         }
+        int64_t drift_us = static_cast<int64_t>(ops[i].completedUs - opEvents[i]->timeUs);
+        reportMotorEventDrift(*opEvents[i], drift_us, " [BATCH]");
+    }
 
-        // Phase 2: Pre-select next activation's channel while we have time
-        // This moves mux selection OFF the critical path for the next ACTIVATE
+    // Phase 2: Same pre-selection as the single-event path if we ended on a DEACTIVATE
+    if (opEvents[opCount - 1]->type == MotorEventType::DEACTIVATE) {
         preSelectNextActivation();
     }
-    (void)beforeOp;  // Suppress unused warning if debug mode off
+}
+
+/**
+ * @brief Dequeue the due event plus any within MOTOR_COALESCE_WINDOW_US and execute
+ */
+static void dispatchDueEvents() {
+    MotorEvent due[MOTOR_COALESCE_MAX_EVENTS];
+    uint8_t count = activationQueue.dequeueEventsWithin(due, MOTOR_COALESCE_MAX_EVENTS,
+                                                        MOTOR_COALESCE_WINDOW_US);
+    if (count == 1) {
+        executeMotorEvent(due[0]);
+    } else if (count > 1) {
+        executeMotorBatch(due, count);
+    }
+}
+
+/**
+ * @brief Move staged BLE events into the ActivationQueue (motor task only)
+ *
+ * The motor task is the single consumer of motorEventBuffer, so staged
+ * MACROCYCLE events reach the queue as soon as the BLE callback notifies
+ * the task, independent of how long the current loop() iteration takes.
+ * A batch tagged isMacrocycleFirst starts a new timeline and clears the queue first.
+ */
+static void drainStagedMotorEvents() {
+    uint8_t eventsForwarded = 0;
+    StagedMotorEvent staged;
+    while (motorEventBuffer.unstage(staged)) {
+        if (staged.isMacrocycleFirst) {
+            activationQueue.clear();  // Start fresh for macrocycle
+            eventsForwarded = 0;
+        }
+
+        activationQueue.enqueue(staged.activateTimeUs, staged.finger, staged.amplitude,
+                                staged.durationMs, staged.frequencyHz);
+        eventsForwarded++;
+
+        if (staged.isMacrocycleLast && profiles.getDebugMode()) {
+            Serial.printf("[MOTOR_TASK] Forwarded %u macrocycle events from staging buffer\n",
+                          eventsForwarded);
+        }
+    }
 }
 
 /**
@@ -252,6 +431,9 @@ static void motorTask(void* pvParameters) {
     for (;;) {
         MotorEvent event;
 
+        // TP-1: Pull anything the BLE callback staged since the last wakeup
+        drainStagedMotorEvents();
+
         // Check if there are any events in the queue
         if (!activationQueue.peekNextEvent(event)) {
             // No events - block until notified of new event
@@ -267,13 +449,23 @@ static void motorTask(void* pvParameters) {
 
         if (delayUs <= 0) {
             // Event time already passed - execute immediately
-            if (activationQueue.dequeueNextEvent(event)) {
-                executeMotorEvent(event);
-            }
+            dispatchDueEvents();
             continue;
         }
 
-        if (delayUs > 2000) {
+#if MOTOR_DISPATCH_MODE == MOTOR_DISPATCH_HW_TIMER
+        if (delayUs > MOTOR_TIMER_WAKE_LEAD_US) {
+            // Hardware timer wakes us MOTOR_TIMER_WAKE_LEAD_US before the event;
+            // tick timeout is only a backstop in case the compare is missed
+            armMotorDispatchTimer(delayUs);
+            TickType_t backstopTicks = pdMS_TO_TICKS(delayUs / 1000 + 2);
+            // Wake early if new event is enqueued (may be earlier than current)
+            ulTaskNotifyTake(pdTRUE, backstopTicks);
+            // H1 fix: Re-capture time after sleep - original `now` is stale
+            continue;  // Re-check queue in case new event is earlier
+        }
+#else
+        if (delayUs > MOTOR_BUSY_WAIT_WINDOW_US) {
             // Event is far away (>2ms) - use FreeRTOS sleep
             // Sleep until 1ms before event, then busy-wait
             TickType_t ticks = pdMS_TO_TICKS((delayUs - 1000) / 1000);
@@ -284,6 +476,7 @@ static void motorTask(void* pvParameters) {
                 continue;  // Re-check queue in case new event is earlier
             }
         }
+#endif
 
         // H2 fix: Re-check queue before busy-wait to ensure this is still earliest event
         // A new, earlier event may have been enqueued while we were checking timing
@@ -294,15 +487,18 @@ static void motorTask(void* pvParameters) {
             continue;
         }
 
-        // Event is close (<2ms) - busy-wait for precision
+        // Event is close (<2ms, or <MOTOR_TIMER_WAKE_LEAD_US with HW timer) - busy-wait for precision
+        uint64_t spinStartUs = getMicros();
         while (getMicros() < event.timeUs) {
             taskYIELD();  // Allow other tasks to run briefly
         }
-
-        // Execute event - dequeue first to ensure we get the same event we peeked
-        if (activationQueue.dequeueNextEvent(event)) {
-            executeMotorEvent(event);
+        if (latencyMetrics.enabled) {
+            latencyMetrics.recordSpinWait(static_cast<uint32_t>(getMicros() - spinStartUs));
         }
+
+        // Execute event (plus any coalesced neighbours) - dequeue first to ensure we
+        // get the same event we peeked
+        dispatchDueEvents();
     }
 }
 
@@ -326,7 +522,7 @@ void sendPing();
 // BLE Callbacks
 void onBLEConnect(uint16_t connHandle, ConnectionType type);
 void onBLEDisconnect(uint16_t connHandle, ConnectionType type, uint8_t reason);
-void onBLEMessage(uint16_t connHandle, const char *message);
+void onBLEMessage(uint16_t connHandle, const char *message, uint64_t rxTimestamp);
 
 // Therapy Callbacks
 void onSendMacrocycle(const Macrocycle& macrocycle);
@@ -341,6 +537,7 @@ void onScheduleActivation(uint64_t activateTimeUs, uint8_t finger, uint8_t ampli
 void onStartScheduling();
 bool onIsSchedulingComplete();
 uint32_t onGetLeadTime();
+void onIdleStepTime(uint32_t elapsedUs, bool precomputed);
 
 // State Machine Callback
 void onStateChange(const StateTransition &transition);
@@ -348,9 +545,20 @@ void onStateChange(const StateTransition &transition);
 // Menu Controller Callback
 void onMenuSendResponse(const char *response);
 
+// Status push to a subscribed phone (PRIMARY)
+void publishStatus(uint32_t now);
+
 // SECONDARY Keepalive Timeout
 void handleKeepaliveTimeout();
 
+// Seeded macrocycles (SECONDARY)
+static void resetSeededTimeline();
+static void coastSeededTimeline();
+
+// Bilateral skew feedback
+static void sendMacrocycleAck(uint32_t sequenceId, bool withFeedback, int64_t localMinusPrimaryUs);
+static void processSecondaryFeedback();
+
 // Debug flash helper
 void triggerDebugFlash();
 
@@ -562,6 +770,7 @@ void setup()
     menu.begin(&therapy, &battery, &haptic, &stateMachine, &profiles, &ble);
     menu.setDeviceInfo(deviceRole, FIRMWARE_VERSION, BLE_NAME);
     menu.setSendCallback(onMenuSendResponse);
+    menu.setStatusPublisher(&statusPublisher);
     Serial.println(F("[SUCCESS] Menu controller initialized"));
 
     // Initialize Deferred Queue (for ISR-safe callback operations)
@@ -574,6 +783,7 @@ void setup()
     // Initial battery reading
     Serial.println(F("\n--- Battery Status ---"));
     BatteryStatus battStatus = battery.getStatus();
+    lastBatteryStatus = battStatus;
     Serial.printf("[BATTERY] %.2fV | %d%% | Status: %s\n",
                   battStatus.voltage, battStatus.percentage, battStatus.statusString());
 
@@ -619,39 +829,8 @@ void loop()
     // Motor events (activations AND deactivations) handled by motor task
     // No polling needed - motor task uses FreeRTOS timing
 
-    // TP-1: Process staged motor events from BLE callbacks
-    // Forward from lock-free staging buffer to mutex-protected activationQueue
-    // Defensive check: only process if motor task is initialized
-    if (motorTaskHandle != nullptr && motorEventBuffer.hasPending()) {
-        // Check if this is a macrocycle batch (needs queue clear first)
-        bool isMacrocycleBatch = motorEventBuffer.isMacrocyclePending();
-        if (isMacrocycleBatch) {
-            activationQueue.clear();  // Start fresh for macrocycle
-        }
-
-        uint8_t eventsForwarded = 0;
-        StagedMotorEvent staged;
-        while (motorEventBuffer.unstage(staged)) {
-            activationQueue.enqueue(staged.activateTimeUs, staged.finger, staged.amplitude,
-                                   staged.durationMs, staged.frequencyHz);
-            eventsForwarded++;
-
-            // If this was the last event in a macrocycle, start scheduling
-            if (staged.isMacrocycleLast) {
-                activationQueue.scheduleNext();
-                if (profiles.getDebugMode()) {
-                    Serial.printf("[MACROCYCLE] Forwarded %u events, scheduling started\n",
-                                  eventsForwarded);
-                }
-            }
-        }
-
-        // For single ACTIVATE events (not macrocycle), log if debug enabled
-        if (!isMacrocycleBatch && eventsForwarded > 0 && profiles.getDebugMode()) {
-            Serial.printf("[ACTIVATE] Forwarded %u event(s) from staging buffer\n",
-                          eventsForwarded);
-        }
-    }
+    // TP-1: Staged motor events from BLE callbacks are consumed directly by the
+    // motor task (drainStagedMotorEvents) - no forwarding hop through loop()
 
     // Process deferred work queue (haptic operations from BLE callbacks)
     deferredQueue.processOne();
@@ -701,6 +880,18 @@ void loop()
     // SECONDARY needs this for standalone hardware tests)
     therapy.update();
 
+    // SECONDARY: keep a seeded session buzzing through a late beacon
+    if (deviceRole == DeviceRole::SECONDARY && stateMachine.getCurrentState() == TherapyState::RUNNING)
+    {
+        coastSeededTimeline();
+    }
+
+    // PRIMARY: turn SECONDARY's execution feedback into bilateral skew
+    if (deviceRole == DeviceRole::PRIMARY)
+    {
+        processSecondaryFeedback();
+    }
+
     // Detect when therapy session ends (for resuming scanning on SECONDARY)
     bool isTherapyRunning = therapy.isRunning();
     if (wasTherapyRunning && !isTherapyRunning)
@@ -721,6 +912,18 @@ void loop()
         stateMachine.transition(StateTrigger::STOP_SESSION);
         stateMachine.transition(StateTrigger::STOPPED);
 
+        // Seeded session: SECONDARY would otherwise coast past the end when
+        // beacons stop, so tell it explicitly
+        if (deviceRole == DeviceRole::PRIMARY && therapy.isSeeded() && ble.isSecondaryConnected())
+        {
+            char buffer[64];
+            SyncCommand cmd = SyncCommand::createStopSession(g_sequenceGenerator.next());
+            if (cmd.serialize(buffer, sizeof(buffer)))
+            {
+                ble.sendToSecondary(buffer);
+            }
+        }
+
         // Resume scanning on SECONDARY after standalone test
         if (deviceRole == DeviceRole::SECONDARY && !ble.isPrimaryConnected())
         {
@@ -845,10 +1048,34 @@ void loop()
     {
         lastBatteryCheck = now;
         BatteryStatus status = battery.getStatus();
+        lastBatteryStatus = status;
         Serial.printf("[BATTERY] %.2fV | %d%% | Status: %s\n",
                       status.voltage, status.percentage, status.statusString());
     }
 
+    // PRIMARY: push status deltas to a subscribed phone in idle link time
+    if (deviceRole == DeviceRole::PRIMARY && statusPublisher.isSubscribed())
+    {
+        publishStatus(now);
+    }
+
+    // Commit settings changed from BLE/menu commands once no motor event is near
+    // (a flash erase stalls the CPU; runs after therapy.update() so the queue is current)
+    if (profiles.hasPendingSettings())
+    {
+        uint64_t nowUs = getMicros();
+        uint64_t nextEventUs = activationQueue.getNextEventTime();
+        // The next macrocycle's events aren't queued until shortly before they start.
+        // SECONDARY can't know when PRIMARY sends it, so waits out the session's gaps
+        uint64_t nextMacrocycleUs = therapy.getNextMacrocycleDueUs();
+        if (deviceRole == DeviceRole::SECONDARY && stateMachine.getCurrentState() == TherapyState::RUNNING &&
+            nextEventUs == UINT64_MAX)
+        {
+            nextMacrocycleUs = nowUs;
+        }
+        profiles.serviceSettingsWrite(nowUs, nextEventUs, nextMacrocycleUs);
+    }
+
     // Yield to BLE stack (non-blocking - allows SoftDevice processing)
     yield();
 }
@@ -997,6 +1224,11 @@ bool initializeTherapy()
         therapy.setSchedulingCallbacks(onScheduleActivation, onStartScheduling, onIsSchedulingComplete);
         // Set adaptive lead time callback for RTT-based scheduling
         therapy.setGetLeadTimeCallback(onGetLeadTime);
+        // Macrocycles kept in flight on SECONDARY (1 = lockstep)
+        therapy.setPipelineDepth(MACROCYCLE_PIPELINE_DEPTH);
+        // Lockstep: generate the next macrocycle during relax, report IDLE step time
+        therapy.setMacrocyclePrecompute(MACROCYCLE_PRECOMPUTE);
+        therapy.setIdleStepTimeCallback(onIdleStepTime);
     }
     return true;
 }
@@ -1077,8 +1309,17 @@ void onBLEConnect(uint16_t connHandle, ConnectionType type)
     {
         Serial.println(F("[SECONDARY] Sending IDENTIFY:SECONDARY to PRIMARY"));
         ble.sendToPrimary("IDENTIFY:SECONDARY");
+        // Advertise binary MACROCYCLE, seeded generation and µs text support
+        // (PRIMARY keeps V4 text if it doesn't understand)
+        char capsBuffer[24];
+        snprintf(capsBuffer, sizeof(capsBuffer), SYNC_CAPS_PREFIX "MB%d,SG%d,MT%d",
+                 MACROCYCLE_BINARY_VERSION, SEEDED_MACROCYCLE_VERSION, MACROCYCLE_TEXT_VERSION);
+        ble.sendToPrimary(capsBuffer);
         // Start keepalive timeout tracking
         lastKeepaliveReceived = millis();
+        // New link: PRIMARY may have rebooted, its sequence IDs start over
+        macrocycleReceiveWindow.reset();
+        resetSeededTimeline();
     }
 
     // Update state machine on relevant connections
@@ -1088,6 +1329,15 @@ void onBLEConnect(uint16_t connHandle, ConnectionType type)
         stateMachine.transition(StateTrigger::CONNECTED);
     }
 
+    // PRIMARY: New SECONDARY link starts on V4 text until it advertises CAPS
+    if (deviceRole == DeviceRole::PRIMARY && type == ConnectionType::SECONDARY)
+    {
+        secondaryMacrocycleFormat = MacrocycleWireFormat::TEXT_V4;
+        therapy.setSeededGeneration(false);
+        seededSessionSentSeed = 0;
+        seededSessionAcked = false;
+    }
+
     // PRIMARY: Boot window logic for auto-start
     if (deviceRole == DeviceRole::PRIMARY)
     {
@@ -1146,6 +1396,7 @@ void onBLEDisconnect(uint16_t connHandle, ConnectionType type, uint8_t reason)
         (deviceRole == DeviceRole::SECONDARY && type == ConnectionType::PRIMARY))
     {
         stateMachine.transition(StateTrigger::DISCONNECTED);
+        resetSeededTimeline();
 
         // SAFETY: Signal main loop to execute motor shutdown
         // Cannot call safeMotorShutdown() directly here (BLE callback = ISR context, no I2C)
@@ -1264,42 +1515,82 @@ void executeDeferredWork(DeferredWorkType type, uint8_t p1, uint8_t p2, uint32_t
     }
 }
 
-void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
+// Messages onBLEMessage() handles itself (sorted, see commandTableSorted)
+enum class BleRoute : uint8_t
 {
-    // CRITICAL: Capture receive timestamp FIRST, before any parsing
-    // This minimizes jitter for PTP clock synchronization
-    uint64_t rxTimestamp = getMicros();
+    TEST,
+    STOP,
+    LED_OFF_SYNC,
+    DEBUG_SYNC,
+    CAPS,
+    SEEDED_SESSION,
+    MACROCYCLE,
+    MACROCYCLE_BINARY,
+    MACROCYCLE_BEACON,
+    MACROCYCLE_ACK
+};
+
+static constexpr CommandEntry<BleRoute> BLE_ROUTES[] = {
+    {"CAPS", BleRoute::CAPS},
+    {"DEBUG_SYNC", BleRoute::DEBUG_SYNC},
+    {"LED_OFF_SYNC", BleRoute::LED_OFF_SYNC},
+    {"MB", BleRoute::MACROCYCLE_BINARY},
+    {"MC", BleRoute::MACROCYCLE},
+    {"MC_ACK", BleRoute::MACROCYCLE_ACK},
+    {"MN", BleRoute::MACROCYCLE_BEACON},
+    {"MU", BleRoute::MACROCYCLE},
+    {"SS", BleRoute::SEEDED_SESSION},
+    {"STOP", BleRoute::STOP},
+    {"TEST", BleRoute::TEST},
+    {"stop", BleRoute::STOP},
+    {"test", BleRoute::TEST},
+};
+static_assert(commandTableSorted(BLE_ROUTES), "BLE_ROUTES must be sorted by name");
+
+void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message, uint64_t rxTimestamp)
+{
+    // rxTimestamp was captured by the BLE RX callback when the message's first
+    // byte arrived, so PTP T2/T4 exclude reassembly waits for later packets and
+    // time spent handling earlier messages from the same packet
+
+    // Tokenize once (offsets into message, no copies) and route on the command word
+    CommandTokens tokens;
+    if (!tokens.parse(message))
+    {
+        return;
+    }
+    const CommandEntry<BleRoute> *route = findCommand(BLE_ROUTES, tokens.command());
 
     // Check for simple text commands first (for testing)
     // Both PRIMARY and SECONDARY can run standalone tests for hardware verification
-    if (strcmp(message, "TEST") == 0 || strcmp(message, "test") == 0)
+    if (route && route->value == BleRoute::TEST && tokens.paramCount() == 0)
     {
         startTherapyTest();
         return;
     }
 
-    if (strcmp(message, "STOP") == 0 || strcmp(message, "stop") == 0)
+    if (route && route->value == BleRoute::STOP && tokens.paramCount() == 0)
     {
         stopTherapyTest();
         return;
     }
 
     // Try menu controller first for phone/BLE commands (PRIMARY only)
-    if (deviceRole == DeviceRole::PRIMARY && !menu.isInternalMessage(message))
+    if (deviceRole == DeviceRole::PRIMARY && !isInternalCommand(tokens.command()))
     {
-        if (menu.handleCommand(message))
+        if (menu.handleCommand(tokens))
         {
             return; // Command handled by menu controller
         }
     }
 
     // Handle LED_OFF_SYNC from PRIMARY (SECONDARY only)
-    if (deviceRole == DeviceRole::SECONDARY && strncmp(message, "LED_OFF_SYNC:", 13) == 0)
+    if (deviceRole == DeviceRole::SECONDARY && route && route->value == BleRoute::LED_OFF_SYNC)
     {
-        int value = atoi(message + 13);
+        int32_t value = tokens.paramInt(0);
         profiles.setTherapyLedOff(value != 0);
-        profiles.saveSettings();
-        Serial.printf("[SYNC] LED_OFF_SYNC received: %d\n", value);
+        profiles.requestSaveSettings();  // Committed from loop() away from motor events
+        Serial.printf("[SYNC] LED_OFF_SYNC received: %ld\n", (long)value);
 
         // Update LED immediately if currently running therapy
         if (stateMachine.getCurrentState() == TherapyState::RUNNING)
@@ -1317,27 +1608,124 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
     }
 
     // Handle DEBUG_SYNC from PRIMARY (SECONDARY only)
-    if (deviceRole == DeviceRole::SECONDARY && strncmp(message, "DEBUG_SYNC:", 11) == 0)
+    if (deviceRole == DeviceRole::SECONDARY && route && route->value == BleRoute::DEBUG_SYNC)
     {
-        int value = atoi(message + 11);
+        int32_t value = tokens.paramInt(0);
         profiles.setDebugMode(value != 0);
-        profiles.saveSettings();
-        Serial.printf("[SYNC] DEBUG_SYNC received: %d\n", value);
+        profiles.requestSaveSettings();  // Committed from loop() away from motor events
+        Serial.printf("[SYNC] DEBUG_SYNC received: %ld\n", (long)value);
+        return;
+    }
+
+    // Handle capability advertisement from SECONDARY (PRIMARY only)
+    // Format: CAPS:MB<version>[,SG<version>][,MT<version>] - SECONDARY can decode
+    // binary MACROCYCLE up to <version>
+    if (route && route->value == BleRoute::CAPS)
+    {
+        std::string_view caps = tokens.param(0);
+        if (deviceRole == DeviceRole::PRIMARY && caps.substr(0, 2) == "MB")
+        {
+            // Optional ",MT<version>": SECONDARY decodes µs text MACROCYCLE (MU:)
+            const char *text = strstr(message, ",MT");
+            if (text && atoi(text + 3) >= MACROCYCLE_TEXT_VERSION)
+            {
+                secondaryMacrocycleFormat = MacrocycleWireFormat::TEXT_V5;
+            }
+            int version = atoi(caps.data() + 2);
+            if (version >= MACROCYCLE_BINARY_VERSION)
+            {
+                secondaryMacrocycleFormat = MacrocycleWireFormat::BINARY_V1;
+                Serial.printf("[SYNC] SECONDARY supports binary MACROCYCLE v%d\n", version);
+            }
+#if SEEDED_MACROCYCLES
+            // Optional ",SG<version>": SECONDARY can generate macrocycles from a
+            // session seed. Takes effect from the next startSession()
+            const char *seeded = strstr(message, ",SG");
+            if (seeded && atoi(seeded + 3) >= SEEDED_MACROCYCLE_VERSION)
+            {
+                secondaryMacrocycleFormat = MacrocycleWireFormat::SEEDED_V1;
+                therapy.setSeededGeneration(true);
+                Serial.println(F("[SYNC] SECONDARY supports seeded macrocycles"));
+            }
+#endif
+        }
+        return;
+    }
+
+    // Handle seeded session parameters (SECONDARY only)
+    // Format: SS:seedHigh|seedLow|type|onBits|offBits|jitterBits|fingers|mirror|ampMin|ampMax|...
+    if (route && route->value == BleRoute::SEEDED_SESSION)
+    {
+        if (deviceRole == DeviceRole::SECONDARY)
+        {
+            SeededSession session;
+            if (SyncCommand::deserializeSeededSession(message, session))
+            {
+                therapy.loadSeededSession(session);
+                uint32_t primask = __get_PRIMASK();
+                __disable_irq();
+                seededTimeline = SeededTimeline();
+                seededTimeline.loaded = true;
+                seededTimeline.tag = session.tag();
+                seededTimeline.coastBudget = session.coastBudget;
+                __set_PRIMASK(primask);
+                Serial.printf("[SEEDED] Session loaded: tag=%u pattern=%u fingers=%u coast=%u\n",
+                              session.tag(), session.patternType, session.numFingers, session.coastBudget);
+            }
+            else
+            {
+                Serial.println(F("[ERROR] Failed to parse seeded session"));
+            }
+        }
         return;
     }
 
     // Handle MACROCYCLE messages (special format - not standard SyncCommand)
-    // Format: MC:seq|baseTime|count|d,f,a,dur,fo|...
-    if (strncmp(message, "MC:", 3) == 0)
+    // Text:   MU:seq|baseHigh|baseLow|offHigh|offLow|dur|count|dUs,f,a[,fo]|...
+    //         MC:seq|baseMs|offHigh|offLow|dur|count|dMs,f,a[,fo]|... (older PRIMARY)
+    // Binary: MB:<packed payload> (only sent after CAPS negotiation)
+    // Beacon: MN:seq|baseHigh|baseLow|offHigh|offLow|tag (seeded session, events generated here)
+    bool isBinaryMacrocycle = (route && route->value == BleRoute::MACROCYCLE_BINARY);
+    bool isMacrocycleBeacon = (route && route->value == BleRoute::MACROCYCLE_BEACON);
+    if (isBinaryMacrocycle || isMacrocycleBeacon || (route && route->value == BleRoute::MACROCYCLE))
     {
         if (deviceRole == DeviceRole::SECONDARY)
         {
             // Track connectivity - MACROCYCLE proves PRIMARY is alive
             lastKeepaliveReceived = millis();
 
-            // Parse macrocycle from V2 format (includes clock offset)
+            // Parse macrocycle (all formats include clock offset)
             Macrocycle mc;
-            if (SyncCommand::deserializeMacrocycle(message, strlen(message), mc))
+            size_t messageLen = strlen(message);
+            bool parsed;
+            if (isMacrocycleBeacon)
+            {
+                uint16_t tag = 0;
+                parsed = SyncCommand::deserializeMacrocycleBeacon(message, mc, tag);
+                if (parsed && (!seededTimeline.loaded || tag != seededTimeline.tag))
+                {
+                    // No ACK: a pipelined PRIMARY resends, and SS: precedes every new session
+                    Serial.printf("[ERROR] MACROCYCLE beacon seq=%lu for unknown seeded session\n",
+                                  (unsigned long)mc.sequenceId);
+                    return;
+                }
+                if (parsed)
+                {
+                    // Same (seed, sequence) -> same events as PRIMARY generated
+                    uint64_t baseTime = mc.baseTime;
+                    int64_t clockOffset = mc.clockOffset;
+                    therapy.generateSeededMacrocycle(mc, mc.sequenceId);
+                    mc.baseTime = baseTime;
+                    mc.clockOffset = clockOffset;
+                }
+            }
+            else
+            {
+                parsed = isBinaryMacrocycle
+                             ? SyncCommand::deserializeMacrocycleBinary(message, messageLen, mc)
+                             : SyncCommand::deserializeMacrocycle(message, messageLen, mc);
+            }
+            if (parsed)
             {
                 // Apply clock offset from PRIMARY (V2 format)
                 // PRIMARY calculated this offset and sent it in the message
@@ -1358,12 +1746,8 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
                     Serial.printf("[ERROR] MACROCYCLE rejected: invalid offset %ld.%06ldus (exceeds ±35s)\n",
                                   (long)offsetSec, (long)offsetUs);
                     // Still send ACK to avoid retry storms, but don't execute
-                    SyncCommand ackCmd = SyncCommand::createMacrocycleAck(mc.sequenceId);
-                    char ackBuffer[32];
-                    if (ackCmd.serialize(ackBuffer, sizeof(ackBuffer)))
-                    {
-                        ble.sendToPrimary(ackBuffer);
-                    }
+                    // (and don't convert feedback with an offset known to be bad)
+                    sendMacrocycleAck(mc.sequenceId, false, 0);
                     return;
                 }
 
@@ -1393,18 +1777,62 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
                     Serial.printf("[ERROR] MACROCYCLE rejected: baseTime %ld seconds from now\n",
                                   (long)diffSec);  // Division reduces to 32-bit safe range
                     // Still send ACK to avoid retry storms
-                    SyncCommand ackCmd = SyncCommand::createMacrocycleAck(mc.sequenceId);
-                    char ackBuffer[32];
-                    if (ackCmd.serialize(ackBuffer, sizeof(ackBuffer)))
+                    sendMacrocycleAck(mc.sequenceId, false, 0);
+                    return;
+                }
+
+                // Pipelined PRIMARY resends macrocycles whose ACK it missed:
+                // ACK again but don't stage the same events twice
+                MacrocycleReceiveWindow::Result seqCheck = macrocycleReceiveWindow.classify(mc.sequenceId);
+
+                // Seeded: a beacon for a macrocycle loop() already coasted through
+                // is a duplicate too, but it does correct the timeline prediction
+                bool coasted = false;
+                if (isMacrocycleBeacon)
+                {
+                    uint64_t nextPrimaryBase = mc.baseTime + therapy.getMacrocycleSlotUs(mc);
+                    uint32_t primask = __get_PRIMASK();
+                    __disable_irq();
+                    coasted = seededTimeline.active &&
+                              static_cast<int32_t>(mc.sequenceId - seededTimeline.lastBeaconSeq) > 0 &&
+                              static_cast<int32_t>(mc.sequenceId - seededTimeline.lastSeq) <= 0;
+                    if (!seededTimeline.active ||
+                        static_cast<int32_t>(mc.sequenceId - seededTimeline.lastSeq) >= 0)
                     {
-                        ble.sendToPrimary(ackBuffer);
+                        seededTimeline.lastSeq = mc.sequenceId;
+                        seededTimeline.nextPrimaryBase = nextPrimaryBase;
+                        seededTimeline.clockOffset = mc.clockOffset;
                     }
+                    if (!seededTimeline.active ||
+                        static_cast<int32_t>(mc.sequenceId - seededTimeline.lastBeaconSeq) > 0)
+                    {
+                        seededTimeline.lastBeaconSeq = mc.sequenceId;
+                    }
+                    seededTimeline.active = true;
+                    seededTimeline.coasted = 0;
+                    __set_PRIMASK(primask);
+                    if (coasted)
+                    {
+                        macrocycleReceiveWindow.markStaged(mc.sequenceId);
+                    }
+                }
+
+                if (seqCheck == MacrocycleReceiveWindow::DUPLICATE || coasted)
+                {
+                    sendMacrocycleAck(mc.sequenceId, true, offset);
                     return;
                 }
 
                 // TP-1: Stage all events via lock-free buffer (ISR-safe)
-                // Main loop will forward to activationQueue and call scheduleNext()
-                motorEventBuffer.beginMacrocycle();
+                // Motor task forwards them to activationQueue
+                // Pipelined: only a new timeline clears the queue - macrocycles within
+                // the sequence window may be queued behind ones still executing.
+                // Lockstep: every macrocycle replaces the last, so events stranded by
+                // a lost macrocycle never outlive the next one
+                if (seqCheck == MacrocycleReceiveWindow::NEW_TIMELINE || MACROCYCLE_PIPELINE_DEPTH == 1)
+                {
+                    motorEventBuffer.beginMacrocycle();
+                }
                 uint8_t validEvents = 0;
                 uint8_t lastValidIndex = 0;
 
@@ -1431,7 +1859,7 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
                         continue;
                     }
 
-                    uint64_t localActivateTime = localBaseTime + (evt.deltaTimeMs * 1000ULL);
+                    uint64_t localActivateTime = localBaseTime + evt.deltaTimeUs;
                     uint16_t freqHz = evt.getFrequencyHz();
                     bool isLast = (i == lastValidIndex);
 
@@ -1440,16 +1868,17 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
                     stagedCount++;
                 }
 
-                // Note: scheduleNext() will be called by main loop after forwarding events
-                // Serial.printf moved to main loop to avoid ISR context I/O
-
-                // Send ACK immediately
-                SyncCommand ackCmd = SyncCommand::createMacrocycleAck(mc.sequenceId);
-                char ackBuffer[32];
-                if (ackCmd.serialize(ackBuffer, sizeof(ackBuffer)))
+                // TP-1: Wake the motor task so it drains the staging buffer now
+                // rather than on its next scheduled event
+                if (stagedCount > 0)
                 {
-                    ble.sendToPrimary(ackBuffer);
+                    activationQueue.notifyMotorTask();
                 }
+                macrocycleReceiveWindow.markStaged(mc.sequenceId);
+                activationLog.track(mc, localBaseTime);
+
+                // Send ACK immediately (with feedback for an earlier macrocycle)
+                sendMacrocycleAck(mc.sequenceId, true, offset);
             }
             else
             {
@@ -1460,16 +1889,31 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
     }
 
     // Handle MACROCYCLE_ACK messages
-    if (strncmp(message, "MC_ACK:", 7) == 0)
+    if (route && route->value == BleRoute::MACROCYCLE_ACK && tokens.paramCount() > 0)
     {
         if (deviceRole == DeviceRole::PRIMARY)
         {
             lastSecondaryKeepalive = millis();
-            // TODO: TherapyEngine will handle ACK tracking in Phase 4
+            // Parse sequence ID from message; TherapyEngine matches it to an
+            // in-flight macrocycle (pipelined mode resends unacknowledged ones)
+            uint32_t seqId = static_cast<uint32_t>(strtoul(tokens.param(0).data(), nullptr, 10));
+            therapy.onMacrocycleAck(seqId);
+            if (!seededSessionAcked && static_cast<int32_t>(seqId - seededSessionFirstSeq) >= 0)
+            {
+                seededSessionAcked = true;
+            }
+            // Execution feedback for an earlier macrocycle (MC_ACK:seq|ts|fbSeq|l0,...)
+            MacrocycleFeedback feedback;
+            if (SyncCommand::deserializeMacrocycleAckFeedback(message, feedback))
+            {
+                uint32_t primask = __get_PRIMASK();
+                __disable_irq();
+                secondaryFeedback = feedback;
+                secondaryFeedbackPending = true;
+                __set_PRIMASK(primask);
+            }
             if (profiles.getDebugMode())
             {
-                // Parse sequence ID from message
-                uint32_t seqId = strtoul(message + 7, nullptr, 10);
                 Serial.printf("[MACROCYCLE] ACK received seq=%lu\n", (unsigned long)seqId);
             }
         }
@@ -1477,45 +1921,44 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
     }
 
     // Parse sync/internal commands
-    SyncCommand cmd;
-    if (cmd.deserialize(message))
+    // Zero-copy view: indexes fields in the BLE receive buffer, decodes integers on access
+    // (avoids a ~420-byte SyncCommand + token copies on the callback stack for every PING)
+    SyncCommandView cmd;
+    if (cmd.parse(message))
     {
         // Handle specific command types
         switch (cmd.getType())
         {
         case SyncCommandType::PING:
-            // SECONDARY: Reply with PONG including T2 (early capture), T3 (just before send)
+            // SECONDARY: Reply with PONG including T2 (first-byte arrival), T3 (stamped at transmit)
             // Also tracks connectivity - PING proves PRIMARY is alive
             if (deviceRole == DeviceRole::SECONDARY)
             {
                 // Track connectivity - PING proves PRIMARY is alive
                 lastKeepaliveReceived = millis();
 
-                // T2 = rxTimestamp captured at callback entry (before parsing)
+                // T2 = rxTimestamp captured at first-byte arrival (before reassembly/parsing)
                 // This gives us the most accurate receive timestamp
                 uint64_t t2 = rxTimestamp;
 
-                // Prepare buffer first, then capture T3 right before send
                 char buffer[64];
                 uint32_t seqId = cmd.getSequenceId();
 
-                // Capture T3 as late as possible before sending
-                // Note: T3 must be captured BEFORE send since it goes in the message
-                // Best we can do is minimize work between T3 capture and send call
-                uint64_t t3 = getMicros();
-                SyncCommand pong = SyncCommand::createPongWithTimestamps(seqId, t2, t3);
-                if (pong.serialize(buffer, sizeof(buffer)))
+                // T3 is left as a fixed-width placeholder: BLEManager patches it in
+                // update() as the PONG is written to the UART service, so time spent
+                // in the TX queue isn't counted as network delay
+                uint16_t stampOffset;
+                if (SyncCommand::serializePongForTxStamp(buffer, sizeof(buffer), seqId, t2, stampOffset))
                 {
-                    ble.sendToPrimary(buffer);
+                    ble.sendStamped(ble.getPrimaryHandle(), buffer, stampOffset);
 
                     // Debug logging (matches PRIMARY's PONG handler logging)
                     if (profiles.getDebugMode())
                     {
                         // Arduino printf doesn't support %llu - cast to uint32_t (timestamps fit in 32-bit for ~71 minutes)
-                        Serial.printf("[SYNC] PING seq=%lu T2=%lu T3=%lu -> PONG sent\n",
+                        Serial.printf("[SYNC] PING seq=%lu T2=%lu -> PONG queued\n",
                                       (unsigned long)seqId,
-                                      (unsigned long)(t2 / 1000),  // Convert to ms for readability
-                                      (unsigned long)(t3 / 1000));
+                                      (unsigned long)(t2 / 1000));  // Convert to ms for readability
                     }
                 }
             }
@@ -1534,7 +1977,7 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
             if (deviceRole == DeviceRole::PRIMARY && pingT1 > 0)
             {
 
-                // T4 = rxTimestamp captured at callback entry (before parsing)
+                // T4 = rxTimestamp captured at first-byte arrival (before reassembly/parsing)
                 // This gives us the most accurate receive timestamp
                 uint64_t t4 = rxTimestamp;
                 uint64_t t1 = pingT1;
@@ -1543,21 +1986,21 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
                 // Format depends on whether high bits are used (see createPongWithTimestamps)
                 // C4 fix: Use getDataUnsigned to avoid sign extension when values > 2^31
                 uint64_t t2, t3;
-                if (cmd.hasData("2"))
+                if (cmd.hasData(2))
                 {
                     // Full 64-bit: T2High|T2Low|T3High|T3Low
-                    uint32_t t2High = cmd.getDataUnsigned("0", 0);
-                    uint32_t t2Low = cmd.getDataUnsigned("1", 0);
-                    uint32_t t3High = cmd.getDataUnsigned("2", 0);
-                    uint32_t t3Low = cmd.getDataUnsigned("3", 0);
+                    uint32_t t2High = cmd.getDataUnsigned(0, 0);
+                    uint32_t t2Low = cmd.getDataUnsigned(1, 0);
+                    uint32_t t3High = cmd.getDataUnsigned(2, 0);
+                    uint32_t t3Low = cmd.getDataUnsigned(3, 0);
                     t2 = ((uint64_t)t2High << 32) | t2Low;
                     t3 = ((uint64_t)t3High << 32) | t3Low;
                 }
                 else
                 {
                     // Simple 32-bit: T2|T3
-                    t2 = static_cast<uint64_t>(cmd.getDataUnsigned("0", 0));
-                    t3 = static_cast<uint64_t>(cmd.getDataUnsigned("1", 0));
+                    t2 = static_cast<uint64_t>(cmd.getDataUnsigned(0, 0));
+                    t3 = static_cast<uint64_t>(cmd.getDataUnsigned(1, 0));
                 }
 
                 // Calculate RTT using IEEE 1588 PTP formula (excludes SECONDARY processing)
@@ -1584,23 +2027,21 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
                               (unsigned long)rtt);
 #endif
 
-                // Calculate PTP clock offset
+                // Calculate PTP clock offset (raw, for logging)
                 int64_t offset = syncProtocol.calculatePTPOffset(t1, t2, t3, t4);
 
-                // Add sample with RTT-based quality filtering
-                // High-RTT samples are rejected as they likely have asymmetric delays
-                bool sampleAccepted = false;
-                if (syncProtocol.isClockSyncValid())
-                {
-                    // Already synced - use EMA update (no RTT filtering for maintenance)
-                    syncProtocol.updateOffsetEMA(offset);
-                    sampleAccepted = true;
-                }
-                else
-                {
-                    // Building initial sync - use quality filtering
-                    sampleAccepted = syncProtocol.addOffsetSampleWithQuality(offset, rtt);
-                }
+                // Clock servo jointly tracks offset + skew, weighting each sample
+                // by its path delay and gating outliers (replaces median + EMA)
+                bool sampleAccepted = syncProtocol.addPTPSample(t1, t2, t3, t4);
+
+#ifdef DEBUG_SYNC_TIMING
+                // Raw exchange in the format the native clock-servo replay harness reads
+                Serial.printf("[PTP] %lu%06lu,%lu%06lu,%lu%06lu,%lu%06lu\n",
+                              (unsigned long)(t1 / 1000000), (unsigned long)(t1 % 1000000),
+                              (unsigned long)(t2 / 1000000), (unsigned long)(t2 % 1000000),
+                              (unsigned long)(t3 / 1000000), (unsigned long)(t3 % 1000000),
+                              (unsigned long)(t4 / 1000000), (unsigned long)(t4 % 1000000));
+#endif
 
                 // Also update RTT-based latency for backward compatibility
                 syncProtocol.updateLatency(rtt);
@@ -1613,13 +2054,15 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
                 // Enhanced logging (DEBUG only)
                 if (profiles.getDebugMode())
                 {
-                    Serial.printf("[SYNC] RTT=%lu offset_raw=%ld offset_median=%ld offset_corrected=%ld valid=%d samples=%u %s\n",
+                    const ClockServo& servo = syncProtocol.getClockServo();
+                    Serial.printf("[SYNC] RTT=%lu offset_raw=%ld offset_corrected=%ld ci95=%lu skew=%.2fppm valid=%d samples=%lu %s\n",
                                   (unsigned long)rtt,
                                   (long)offset,
-                                  (long)syncProtocol.getMedianOffset(),
                                   (long)syncProtocol.getCorrectedOffset(),
+                                  (unsigned long)syncProtocol.getOffsetConfidenceUs(),
+                                  servo.getSkewPpm(),
                                   syncProtocol.isClockSyncValid() ? 1 : 0,
-                                  syncProtocol.getOffsetSampleCount(),
+                                  (unsigned long)servo.getAcceptedCount(),
                                   sampleAccepted ? "" : "(rejected)");
                 }
 
@@ -1653,6 +2096,7 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
 
         case SyncCommandType::STOP_SESSION:
             Serial.println(F("[SESSION] Stop requested"));
+            resetSeededTimeline();
             haptic.emergencyStop();
             stateMachine.transition(StateTrigger::STOP_SESSION);
             break;
@@ -1662,24 +2106,24 @@ void onBLEMessage(uint16_t connHandle [[maybe_unused]], const char *message)
             if (deviceRole == DeviceRole::SECONDARY && profiles.getDebugMode())
             {
                 // Check if this is a PTP sync command with scheduled flash time
-                bool hasPTPTime = cmd.hasData("0");
+                bool hasPTPTime = cmd.hasData(0);
                 if (hasPTPTime && syncProtocol.isClockSyncValid())
                 {
                     // Parse flash time from command
                     uint64_t flashTime;
-                    if (cmd.hasData("1"))
+                    if (cmd.hasData(1))
                     {
                         // Full 64-bit: timeHigh|timeLow
                         // SP-C1 fix: Use getDataUnsigned() to avoid sign extension for values > 2^31
-                        uint32_t timeHigh = cmd.getDataUnsigned("0", 0);
-                        uint32_t timeLow = cmd.getDataUnsigned("1", 0);
+                        uint32_t timeHigh = cmd.getDataUnsigned(0, 0);
+                        uint32_t timeLow = cmd.getDataUnsigned(1, 0);
                         flashTime = ((uint64_t)timeHigh << 32) | timeLow;
                     }
                     else
                     {
                         // Simple 32-bit
                         // SP-C1 fix: Use getDataUnsigned() to avoid sign extension
-                        flashTime = static_cast<uint64_t>(cmd.getDataUnsigned("0", 0));
+                        flashTime = static_cast<uint64_t>(cmd.getDataUnsigned(0, 0));
                     }
 
                     // Convert PRIMARY clock time to local (SECONDARY) clock time
@@ -1726,8 +2170,16 @@ void onSendMacrocycle(const Macrocycle& macrocycle)
         return;
     }
 
-    // Clear activation queue for new macrocycle (PRIMARY will enqueue via callbacks)
-    activationQueue.clear();
+    // Clear activation queue when this macrocycle starts a new timeline (PRIMARY will
+    // enqueue via callbacks). Always the case in lockstep mode; in pipelined mode
+    // earlier macrocycles are still queued, and resends reuse this callback.
+    if (therapy.getInFlightCount() == 0)
+    {
+        activationQueue.clear();
+    }
+
+    // Resends are ignored; PRIMARY's schedule is its own clock
+    activationLog.track(macrocycle, macrocycle.baseTime);
 
     // Make a local copy to set clock offset (callback receives const reference)
     Macrocycle mcCopy = macrocycle;
@@ -1736,11 +2188,51 @@ void onSendMacrocycle(const Macrocycle& macrocycle)
     // This allows SECONDARY to convert PRIMARY's baseTime to its local clock
     mcCopy.clockOffset = syncProtocol.getCorrectedOffset();
 
-    // Serialize macrocycle to buffer
+    // Serialize macrocycle to buffer: beacon for a seeded session, else the full
+    // event list (binary if SECONDARY negotiated it, else V5 text, or V4 text for
+    // a SECONDARY that advertised neither)
     char buffer[MESSAGE_BUFFER_SIZE];
-    if (SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mcCopy))
+    bool serialized;
+    if (therapy.isSeeded() && secondaryMacrocycleFormat == MacrocycleWireFormat::SEEDED_V1)
+    {
+        SeededSession session = therapy.getSeededSession();
+        if (seededSessionSentSeed != session.seed)
+        {
+            seededSessionSentSeed = session.seed;
+            seededSessionFirstSeq = mcCopy.sequenceId;
+            seededSessionAcked = false;
+        }
+        if (!seededSessionAcked)
+        {
+            // BLE delivers in order, so SS: precedes the beacon it unlocks
+            char sessionBuffer[160];
+            if (SyncCommand::serializeSeededSession(sessionBuffer, sizeof(sessionBuffer), session))
+            {
+                ble.sendToSecondary(sessionBuffer);
+            }
+        }
+        serialized = SyncCommand::serializeMacrocycleBeacon(buffer, sizeof(buffer), mcCopy, session.tag());
+    }
+    else
+    {
+        MacrocycleWireFormat format = secondaryMacrocycleFormat;
+        if (format == MacrocycleWireFormat::BINARY_V1)
+        {
+            serialized = SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mcCopy);
+        }
+        else
+        {
+            // SEEDED_V1 between seeded sessions: that SECONDARY also decodes V5
+            serialized = SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mcCopy,
+                                                          format == MacrocycleWireFormat::TEXT_V4
+                                                              ? MacrocycleWireFormat::TEXT_V4
+                                                              : MacrocycleWireFormat::TEXT_V5);
+        }
+    }
+    if (serialized)
     {
         ble.sendToSecondary(buffer);
+        statusPublisher.onMacrocycleSent(millis());
 
         if (profiles.getDebugMode())
         {
@@ -1823,6 +2315,11 @@ uint32_t onGetLeadTime()
     return syncProtocol.calculateAdaptiveLeadTime();
 }
 
+void onIdleStepTime(uint32_t elapsedUs, bool precomputed)
+{
+    latencyMetrics.recordIdleStep(elapsedUs, precomputed);
+}
+
 void onCycleComplete(uint32_t cycleCount)
 {
     Serial.printf("[THERAPY] Cycle %lu complete\n", cycleCount);
@@ -2131,9 +2628,9 @@ void triggerDebugFlash()
  * @brief Send PING to SECONDARY to measure BLE latency and clock offset
  *
  * Uses PTP-style 4-timestamp protocol:
- * - T1: PRIMARY send time (stored in pingT1, included in PING)
+ * - T1: PRIMARY send time (pingT1, updated when the PING is written)
  * - T2: SECONDARY receive time (returned in PONG)
- * - T3: SECONDARY send time (returned in PONG)
+ * - T3: SECONDARY send time (patched into PONG when it is written)
  * - T4: PRIMARY receive time (recorded on PONG receipt)
  */
 void sendPing()
@@ -2143,7 +2640,8 @@ void sendPing()
         return;
     }
 
-    // Record T1 for PTP offset calculation
+    // Record T1 for PTP offset calculation (provisional: BLEManager overwrites
+    // pingT1 when the PING is actually written, excluding TX queue delay)
     pingT1 = getMicros();
     pingStartTime = pingT1; // Keep for backward compat
 
@@ -2152,7 +2650,7 @@ void sendPing()
     char buffer[64];
     if (cmd.serialize(buffer, sizeof(buffer)))
     {
-        ble.sendToSecondary(buffer);
+        ble.sendStamped(ble.getSecondaryHandle(), buffer, 0, &pingT1);
     }
 }
 
@@ -2269,6 +2767,37 @@ void onMenuSendResponse(const char *response)
     }
 }
 
+// =============================================================================
+// STATUS PUSH (SUBSCRIBE)
+// =============================================================================
+
+void publishStatus(uint32_t now)
+{
+    // Subscription ends with the phone connection (reconnects SUBSCRIBE again)
+    if (!ble.isPhoneConnected())
+    {
+        statusPublisher.unsubscribe();
+        return;
+    }
+
+    StatusSnapshot snapshot;
+    snapshot.state = stateMachine.getCurrentState();
+    snapshot.elapsedSec = therapy.getElapsedSeconds();
+    snapshot.remainingSec = therapy.getRemainingSeconds();
+    snapshot.batteryCentivolts = static_cast<uint16_t>(lastBatteryStatus.voltage * 100.0f + 0.5f);
+    snapshot.syncUs = (ble.isSecondaryConnected() && syncProtocol.getClockServo().isValid())
+                          ? static_cast<int32_t>(syncProtocol.getOffsetConfidenceUs())
+                          : -1;
+
+    // Held while MACROCYCLE traffic is queued or just went out
+    char buffer[STATUS_PUSH_BUFFER_SIZE];
+    size_t len = statusPublisher.prepare(now, snapshot, ble.getPendingTxCount(), buffer, sizeof(buffer));
+    if (len > 0 && ble.sendToPhone(buffer))
+    {
+        statusPublisher.markSent(now, snapshot);
+    }
+}
+
 // =============================================================================
 // SECONDARY KEEPALIVE TIMEOUT HANDLER
 // =============================================================================
@@ -2279,6 +2808,7 @@ void handleKeepaliveTimeout()
 
     // 1. Safety first - stop therapy and all motors immediately
     therapy.stop();
+    resetSeededTimeline();
     safeMotorShutdown();
 
     // 2. Update state machine (LED handled by onStateChange callback)
@@ -2308,6 +2838,166 @@ void handleKeepaliveTimeout()
     ble.startScanning(BLE_NAME);
 }
 
+// =============================================================================
+// SEEDED MACROCYCLES (SECONDARY)
+// =============================================================================
+
+/**
+ * @brief Forget the seeded session (new link, stop, or timeout)
+ *
+ * Until the next SS: message, beacons are rejected and nothing coasts.
+ */
+static void resetSeededTimeline()
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    seededTimeline = SeededTimeline();
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Generate the next seeded macrocycle locally when its beacon is late
+ *
+ * PRIMARY's pipelined timeline is fully determined by (seed, sequence ID)
+ * and the previous macrocycle's slot, so a missing beacon doesn't stop this
+ * glove: up to coastBudget macrocycles are generated here and scheduled with
+ * the newest beacon's clock offset. A beacon that arrives later for a
+ * coasted sequence ID is ACKed as a duplicate. Called from loop() only.
+ */
+static void coastSeededTimeline()
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    SeededTimeline snapshot = seededTimeline;
+    __set_PRIMASK(primask);
+
+    if (!snapshot.active || snapshot.coasted >= snapshot.coastBudget)
+    {
+        return;
+    }
+
+    // Beacon for lastSeq + 1 normally lands a pipeline slot early - only coast
+    // once its macrocycle is about to start on PRIMARY's timeline
+    int64_t startLocal = static_cast<int64_t>(snapshot.nextPrimaryBase) + snapshot.clockOffset;
+    int64_t nowUs = static_cast<int64_t>(getMicros());
+    if (nowUs + SEEDED_MACROCYCLE_COAST_LEAD_MS * 1000LL < startLocal)
+    {
+        return;
+    }
+
+    uint32_t seq = snapshot.lastSeq + 1;
+    Macrocycle mc;
+    therapy.generateSeededMacrocycle(mc, seq);
+    mc.baseTime = snapshot.nextPrimaryBase;
+    mc.clockOffset = snapshot.clockOffset;
+
+    // Claim the sequence ID unless a beacon staged it while we generated
+    primask = __get_PRIMASK();
+    __disable_irq();
+    bool claimed = seededTimeline.active && seededTimeline.lastSeq == snapshot.lastSeq;
+    if (claimed)
+    {
+        seededTimeline.lastSeq = seq;
+        seededTimeline.coasted++;
+        seededTimeline.nextPrimaryBase = mc.baseTime + therapy.getMacrocycleSlotUs(mc);
+    }
+    __set_PRIMASK(primask);
+    if (!claimed)
+    {
+        return;
+    }
+
+    // ActivationQueue is mutex-protected; motorEventBuffer has a single
+    // producer (BLE callback), so coasted events bypass it
+    uint64_t localBaseTime = static_cast<uint64_t>(startLocal);
+    uint8_t scheduled = 0;
+    for (uint8_t i = 0; i < mc.eventCount; i++)
+    {
+        const MacrocycleEvent& evt = mc.events[i];
+        if (evt.amplitude == 0 || evt.finger >= MAX_ACTUATORS)
+        {
+            continue;
+        }
+        if (activationQueue.enqueue(localBaseTime + evt.deltaTimeUs, evt.finger,
+                                    evt.amplitude, evt.durationMs, evt.getFrequencyHz()))
+        {
+            scheduled++;
+        }
+    }
+    activationQueue.notifyMotorTask();
+
+    Serial.printf("[SEEDED] Coasted seq=%lu (%u/%u): %u events\n",
+                  (unsigned long)seq, snapshot.coasted + 1, snapshot.coastBudget, scheduled);
+}
+
+// =============================================================================
+// BILATERAL SKEW FEEDBACK
+// =============================================================================
+
+/**
+ * @brief ACK a macrocycle, attaching feedback for the oldest finished one (SECONDARY only)
+ *
+ * Activation times are converted to the PRIMARY clock with the offset
+ * PRIMARY sent in the macrocycle being ACKed: this glove has no PTP state
+ * of its own, and that is the offset its schedule was built from.
+ *
+ * @param sequenceId Sequence ID to acknowledge
+ * @param withFeedback false for ACKs whose macrocycle was rejected
+ * @param localMinusPrimaryUs Macrocycle clockOffset (SECONDARY - PRIMARY)
+ */
+static void sendMacrocycleAck(uint32_t sequenceId, bool withFeedback, int64_t localMinusPrimaryUs)
+{
+    MacrocycleFeedback feedback;
+    bool hasFeedback = false;
+    if (withFeedback)
+    {
+        activationLog.drain(localMinusPrimaryUs);
+        hasFeedback = activationLog.takeFeedback(getMicros(), feedback);
+    }
+
+    char ackBuffer[MACROCYCLE_ACK_BUFFER_SIZE];
+    if (SyncCommand::serializeMacrocycleAck(ackBuffer, sizeof(ackBuffer), sequenceId,
+                                            hasFeedback ? &feedback : nullptr))
+    {
+        ble.sendToPrimary(ackBuffer);
+    }
+}
+
+/**
+ * @brief Match SECONDARY's feedback against own activations (PRIMARY, loop() only)
+ *
+ * Records one bilateral skew sample per event both gloves started.
+ */
+static void processSecondaryFeedback()
+{
+    activationLog.drain(0);
+
+    if (!secondaryFeedbackPending)
+    {
+        return;
+    }
+    MacrocycleFeedback feedback;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    feedback = secondaryFeedback;
+    secondaryFeedbackPending = false;
+    __set_PRIMASK(primask);
+
+    int32_t skewUs[MACROCYCLE_MAX_EVENTS];
+    uint8_t count = activationLog.computeSkew(feedback, skewUs);
+    for (uint8_t i = 0; i < count; i++)
+    {
+        latencyMetrics.recordBilateralSkew(skewUs[i]);
+    }
+
+    if (count > 0 && profiles.getDebugMode())
+    {
+        Serial.printf("[SKEW] seq=%lu events=%u p99|skew|=%lu us\n",
+                      (unsigned long)feedback.sequenceId, count,
+                      (unsigned long)latencyMetrics.getSkewP99Abs());
+    }
+}
+
 // =============================================================================
 // SERIAL-ONLY COMMANDS
 // =============================================================================
@@ -2321,8 +3011,8 @@ void handleSerialCommand(const char *command)
         if (strcasecmp(roleStr, "PRIMARY") == 0)
         {
             profiles.setDeviceRole(DeviceRole::PRIMARY);
+            safeMotorShutdown(); // Ensure motors off before reset (and before the flash stall)
             profiles.saveSettings();
-            safeMotorShutdown(); // Ensure motors off before reset
             Serial.println(F("[CONFIG] Role set to PRIMARY - restarting..."));
             Serial.flush();
             delay(100);
@@ -2331,8 +3021,8 @@ void handleSerialCommand(const char *command)
         else if (strcasecmp(roleStr, "SECONDARY") == 0)
         {
             profiles.setDeviceRole(DeviceRole::SECONDARY);
+            safeMotorShutdown(); // Ensure motors off before reset (and before the flash stall)
             profiles.saveSettings();
-            safeMotorShutdown(); // Ensure motors off before reset
             Serial.println(F("[CONFIG] Role set to SECONDARY - restarting..."));
             Serial.flush();
             delay(100);
@@ -2385,13 +3075,14 @@ void handleSerialCommand(const char *command)
 
         if (internalName && profiles.loadProfileByName(internalName))
         {
-            profiles.saveSettings();
-
             // Stop any active therapy session before rebooting
             therapy.stop();
             safeMotorShutdown();
             stateMachine.transition(StateTrigger::STOP_SESSION);
 
+            // Synchronous save: rebooting next, motors already off
+            profiles.saveSettings();
+
             Serial.printf("[CONFIG] Profile set to %s - restarting...\n", profileStr);
             Serial.flush();
             delay(100);
@@ -2467,11 +3158,17 @@ void handleSerialCommand(const char *command)
     if (strcmp(command, "GET_CLOCK_SYNC") == 0)
     {
         Serial.println(F("=== PTP Clock Synchronization Status ==="));
+        const ClockServo& servo = syncProtocol.getClockServo();
         Serial.printf("Valid: %s\n", syncProtocol.isClockSyncValid() ? "YES" : "NO");
-        Serial.printf("Offset samples: %u\n", syncProtocol.getOffsetSampleCount());
-        Serial.printf("Median offset: %ld us\n", (long)syncProtocol.getMedianOffset());
-        Serial.printf("Corrected offset: %ld us\n", (long)syncProtocol.getCorrectedOffset());
-        Serial.printf("Drift rate: %.3f us/ms\n", syncProtocol.getDriftRate());
+        Serial.printf("Servo samples: %lu accepted, %lu rejected, %lu reseeds\n",
+                      (unsigned long)servo.getAcceptedCount(),
+                      (unsigned long)servo.getRejectedCount(),
+                      (unsigned long)servo.getReseedCount());
+        Serial.printf("Corrected offset: %ld us (95%% CI +/-%lu us)\n",
+                      (long)syncProtocol.getCorrectedOffset(),
+                      (unsigned long)syncProtocol.getOffsetConfidenceUs());
+        Serial.printf("Drift rate: %.3f us/ms (%.2f ppm)\n", syncProtocol.getDriftRate(), servo.getSkewPpm());
+        Serial.printf("Min path delay: %ld us\n", (long)servo.getMinPathDelayUs());
         Serial.printf("RTT samples: %u\n", syncProtocol.getSampleCount());
         Serial.printf("RTT smoothed: %lu us (avg RTT %lu us)\n",
                       (unsigned long)syncProtocol.getMeasuredLatency(),
@@ -2494,9 +3191,11 @@ void handleSerialCommand(const char *command)
         // Clock Sync Status
         Serial.printf("Clock Sync Valid: %s\n", syncProtocol.isClockSyncValid() ? "YES" : "NO");
         Serial.printf("Offset (corrected): %+ld μs\n", (long)syncProtocol.getCorrectedOffset());
-        Serial.printf("Offset (median):    %+ld μs\n", (long)syncProtocol.getMedianOffset());
+        Serial.printf("Offset 95%% CI:      ±%lu μs\n", (unsigned long)syncProtocol.getOffsetConfidenceUs());
         Serial.printf("Drift Rate:         %.4f μs/ms\n", syncProtocol.getDriftRate());
-        Serial.printf("Offset Samples:     %u/%u\n", syncProtocol.getOffsetSampleCount(), 10);
+        Serial.printf("Servo Samples:      %lu accepted, %lu rejected\n",
+                      (unsigned long)syncProtocol.getClockServo().getAcceptedCount(),
+                      (unsigned long)syncProtocol.getClockServo().getRejectedCount());
         Serial.println(F("-------------------------------------"));
 
         // RTT Statistics
@@ -2559,5 +3258,5 @@ void handleSerialCommand(const char *command)
     }
 
     // Not a serial-only command, pass to regular BLE message handler
-    onBLEMessage(0, command);
+    onBLEMessage(0, command, getMicros());
 }
@@ -12,37 +12,8 @@
 #include "profile_manager.h"
 #include "ble_manager.h"
 #include "sync_protocol.h"
-
-// =============================================================================
-// INTERNAL MESSAGE PREFIXES
-// =============================================================================
-
-const char* INTERNAL_MESSAGES[] = {
-    "BUZZ",
-    "PING",
-    "PONG",
-    "PARAM_UPDATE",
-    "SEED",
-    "SEED_ACK",
-    "GET_BATTERY",
-    "BATRESPONSE",
-    "ACK_PARAM_UPDATE",
-    "SYNC_",           // Covers SYNC_ADJ, SYNC_PROBE, SYNC_PROBE_ACK
-    "FIRST_SYNC",
-    "ACK_SYNC",        // Covers ACK_SYNC_ADJ
-    "START_SESSION",
-    "PAUSE_SESSION",
-    "RESUME_SESSION",
-    "STOP_SESSION",
-    "IDENTIFY:",
-    "LED_OFF_SYNC",
-    "DEBUG_FLASH",
-    "DEBUG_SYNC",
-    "MC:",             // Macrocycle batch message
-    "MC_ACK:"          // Macrocycle acknowledgment
-};
-
-const uint8_t INTERNAL_MESSAGE_COUNT = sizeof(INTERNAL_MESSAGES) / sizeof(INTERNAL_MESSAGES[0]);
+#include "latency_metrics.h"
+#include "status_publisher.h"
 
 // =============================================================================
 // CONSTRUCTOR
@@ -55,6 +26,7 @@ MenuController::MenuController() :
     _stateMachine(nullptr),
     _profiles(nullptr),
     _ble(nullptr),
+    _publisher(nullptr),
     _role(DeviceRole::PRIMARY),
     _sendCallback(nullptr),
     _restartCallback(nullptr),
@@ -110,25 +82,27 @@ void MenuController::setRestartCallback(RestartCallback callback) {
     _restartCallback = callback;
 }
 
+void MenuController::setStatusPublisher(StatusPublisher* publisher) {
+    _publisher = publisher;
+}
+
 // =============================================================================
 // COMMAND PROCESSING
 // =============================================================================
 
 bool MenuController::isInternalMessage(const char* message) {
-    if (!message || strlen(message) == 0) {
+    if (!message) {
         return false;
     }
 
-    for (uint8_t i = 0; i < INTERNAL_MESSAGE_COUNT; i++) {
-        if (strncmp(message, INTERNAL_MESSAGES[i], strlen(INTERNAL_MESSAGES[i])) == 0) {
-            return true;
-        }
-    }
-    return false;
+    // Command word is everything up to the first ':'
+    const char* colon = strchr(message, ':');
+    size_t len = colon ? static_cast<size_t>(colon - message) : strlen(message);
+    return isInternalCommand(std::string_view(message, len));
 }
 
 bool MenuController::handleCommand(const char* message) {
-    if (!message || strlen(message) == 0) {
+    if (!message || message[0] == '\0') {
         return false;
     }
 
@@ -137,125 +111,63 @@ bool MenuController::handleCommand(const char* message) {
         return false;
     }
 
-    // Parse command
-    char command[32];
-    char params[MAX_COMMAND_PARAMS][PARAM_BUFFER_SIZE];
-    uint8_t paramCount = 0;
-
-    if (!parseCommand(message, command, params, paramCount)) {
+    CommandTokens tokens;
+    if (!tokens.parse(message)) {
         sendError("Invalid command format");
         return false;
     }
 
-    Serial.printf("[MENU] Command: %s, Params: %d\n", command, paramCount);
-
-    // Dispatch to handler
-    if (strcmp(command, "INFO") == 0) {
-        handleInfo();
-    } else if (strcmp(command, "BATTERY") == 0) {
-        handleBattery();
-    } else if (strcmp(command, "PING") == 0) {
-        handlePing();
-    } else if (strcmp(command, "PROFILE_LIST") == 0) {
-        handleProfileList();
-    } else if (strcmp(command, "PROFILE_LOAD") == 0) {
-        handleProfileLoad(params, paramCount);
-    } else if (strcmp(command, "PROFILE_GET") == 0) {
-        handleProfileGet();
-    } else if (strcmp(command, "PROFILE_CUSTOM") == 0) {
-        handleProfileCustom(params, paramCount);
-    } else if (strcmp(command, "SESSION_START") == 0) {
-        handleSessionStart();
-    } else if (strcmp(command, "SESSION_PAUSE") == 0) {
-        handleSessionPause();
-    } else if (strcmp(command, "SESSION_RESUME") == 0) {
-        handleSessionResume();
-    } else if (strcmp(command, "SESSION_STOP") == 0) {
-        handleSessionStop();
-    } else if (strcmp(command, "SESSION_STATUS") == 0) {
-        handleSessionStatus();
-    } else if (strcmp(command, "PARAM_SET") == 0) {
-        handleParamSet(params, paramCount);
-    } else if (strcmp(command, "CALIBRATE_START") == 0) {
-        handleCalibrateStart();
-    } else if (strcmp(command, "CALIBRATE_BUZZ") == 0) {
-        handleCalibrateBuzz(params, paramCount);
-    } else if (strcmp(command, "CALIBRATE_STOP") == 0) {
-        handleCalibrateStop();
-    } else if (strcmp(command, "HELP") == 0) {
-        handleHelp();
-    } else if (strcmp(command, "RESTART") == 0) {
-        handleRestart();
-    } else if (strcmp(command, "THERAPY_LED_OFF") == 0) {
-        handleTherapyLedOff(params, paramCount);
-    } else if (strcmp(command, "DEBUG") == 0) {
-        handleDebug(params, paramCount);
-    } else {
-        char errorMsg[64];
-        snprintf(errorMsg, sizeof(errorMsg), "Unknown command: %s", command);
-        sendError(errorMsg);
-        return false;
-    }
-
-    return true;
+    return handleCommand(tokens);
 }
 
-// =============================================================================
-// COMMAND PARSING
-// =============================================================================
-
-bool MenuController::parseCommand(const char* message, char* command, char params[][PARAM_BUFFER_SIZE], uint8_t& paramCount) {
-    if (!message || !command || !params) {
-        return false;
-    }
-
-    // Create a working copy
-    char buffer[256];
-    strncpy(buffer, message, sizeof(buffer) - 1);
-    buffer[sizeof(buffer) - 1] = '\0';
+bool MenuController::handleCommand(const CommandTokens& tokens) {
+    std::string_view command = tokens.command();
 
-    // Strip newlines and EOT
-    char* p = buffer;
-    while (*p) {
-        if (*p == '\n' || *p == '\r' || *p == EOT_CHAR) {
-            *p = '\0';
-            break;
-        }
-        p++;
-    }
-
-    // Trim leading whitespace
-    p = buffer;
-    while (*p == ' ') p++;
-
-    if (strlen(p) == 0) {
+    // Skip internal messages
+    if (isInternalCommand(command)) {
         return false;
     }
 
-    // Split on colon
-    paramCount = 0;
-    char* token = strtok(p, ":");
-
-    if (!token) {
+    // Handlers by command name (sorted; matched case-insensitively)
+    static constexpr CommandEntry<CommandHandler> COMMANDS[] = {
+        {"BATTERY", &MenuController::handleBattery},
+        {"CALIBRATE_BUZZ", &MenuController::handleCalibrateBuzz},
+        {"CALIBRATE_START", &MenuController::handleCalibrateStart},
+        {"CALIBRATE_STOP", &MenuController::handleCalibrateStop},
+        {"DEBUG", &MenuController::handleDebug},
+        {"HELP", &MenuController::handleHelp},
+        {"INFO", &MenuController::handleInfo},
+        {"PARAM_SET", &MenuController::handleParamSet},
+        {"PING", &MenuController::handlePing},
+        {"PROFILE_CUSTOM", &MenuController::handleProfileCustom},
+        {"PROFILE_GET", &MenuController::handleProfileGet},
+        {"PROFILE_LIST", &MenuController::handleProfileList},
+        {"PROFILE_LOAD", &MenuController::handleProfileLoad},
+        {"RESTART", &MenuController::handleRestart},
+        {"SESSION_PAUSE", &MenuController::handleSessionPause},
+        {"SESSION_RESUME", &MenuController::handleSessionResume},
+        {"SESSION_START", &MenuController::handleSessionStart},
+        {"SESSION_STATUS", &MenuController::handleSessionStatus},
+        {"SESSION_STOP", &MenuController::handleSessionStop},
+        {"SKEW_STATUS", &MenuController::handleSkewStatus},
+        {"SUBSCRIBE", &MenuController::handleSubscribe},
+        {"THERAPY_LED_OFF", &MenuController::handleTherapyLedOff},
+    };
+    static_assert(commandTableSorted(COMMANDS), "COMMANDS must be sorted by name");
+
+    Serial.printf("[MENU] Command: %.*s, Params: %d\n",
+                  static_cast<int>(command.size()), command.data(), tokens.paramCount());
+
+    const CommandEntry<CommandHandler>* entry = findCommand(COMMANDS, command, true);
+    if (!entry) {
+        char errorMsg[64];
+        snprintf(errorMsg, sizeof(errorMsg), "Unknown command: %.*s",
+                 static_cast<int>(command.size()), command.data());
+        sendError(errorMsg);
         return false;
     }
 
-    // First token is the command (uppercase it)
-    strncpy(command, token, 31);
-    command[31] = '\0';
-
-    // Convert command to uppercase
-    for (char* c = command; *c; c++) {
-        *c = static_cast<char>(toupper(*c));
-    }
-
-    // Remaining tokens are parameters
-    while ((token = strtok(nullptr, ":")) != nullptr && paramCount < MAX_COMMAND_PARAMS) {
-        strncpy(params[paramCount], token, PARAM_BUFFER_SIZE - 1);
-        params[paramCount][PARAM_BUFFER_SIZE - 1] = '\0';
-        paramCount++;
-    }
-
+    (this->*(entry->value))(tokens);
     return true;
 }
 
@@ -320,7 +232,7 @@ void MenuController::sendError(const char* message) {
 // DEVICE INFO COMMANDS
 // =============================================================================
 
-void MenuController::handleInfo() {
+void MenuController::handleInfo(const CommandTokens&) {
     beginResponse();
 
     addResponseLine("ROLE", deviceRoleToString(_role));
@@ -352,7 +264,7 @@ void MenuController::handleInfo() {
     sendResponse();
 }
 
-void MenuController::handleBattery() {
+void MenuController::handleBattery(const CommandTokens&) {
     beginResponse();
 
     if (_battery) {
@@ -366,7 +278,7 @@ void MenuController::handleBattery() {
     sendResponse();
 }
 
-void MenuController::handlePing() {
+void MenuController::handlePing(const CommandTokens&) {
     beginResponse();
     addResponseLine("PONG", "");
     sendResponse();
@@ -376,7 +288,7 @@ void MenuController::handlePing() {
 // PROFILE COMMANDS
 // =============================================================================
 
-void MenuController::handleProfileList() {
+void MenuController::handleProfileList(const CommandTokens&) {
     if (!_profiles) {
         sendError("Profile manager not available");
         return;
@@ -397,8 +309,8 @@ void MenuController::handleProfileList() {
     sendResponse();
 }
 
-void MenuController::handleProfileLoad(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
-    if (paramCount < 1) {
+void MenuController::handleProfileLoad(const CommandTokens& tokens) {
+    if (tokens.paramCount() < 1) {
         sendError("Profile ID required");
         return;
     }
@@ -408,15 +320,12 @@ void MenuController::handleProfileLoad(const char params[][PARAM_BUFFER_SIZE], u
         return;
     }
 
-    int profileId = atoi(params[0]);
+    int32_t profileId = tokens.paramInt(0);
     if (!_profiles->loadProfile(static_cast<uint8_t>(profileId))) {
         sendError("Invalid profile ID");
         return;
     }
 
-    // Save settings to persist profile change
-    _profiles->saveSettings();
-
     // Stop any active therapy session before rebooting
     if (_therapy) {
         _therapy->stop();
@@ -428,6 +337,10 @@ void MenuController::handleProfileLoad(const char params[][PARAM_BUFFER_SIZE], u
         _stateMachine->transition(StateTrigger::STOP_SESSION);
     }
 
+    // Save settings to persist profile change (synchronous: rebooting next,
+    // motors already stopped so the flash stall can't disturb a buzz)
+    _profiles->saveSettings();
+
     // Send response before reboot
     beginResponse();
     addResponseLine("STATUS", "REBOOTING");
@@ -445,7 +358,7 @@ void MenuController::handleProfileLoad(const char params[][PARAM_BUFFER_SIZE], u
     }
 }
 
-void MenuController::handleProfileGet() {
+void MenuController::handleProfileGet(const CommandTokens&) {
     if (!_profiles) {
         sendError("Profile manager not available");
         return;
@@ -471,13 +384,14 @@ void MenuController::handleProfileGet() {
     sendResponse();
 }
 
-void MenuController::handleProfileCustom(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleProfileCustom(const CommandTokens& tokens) {
     // Check if session is active
     if (_therapy && _therapy->isRunning()) {
         sendError("Cannot modify parameters during active session");
         return;
     }
 
+    uint8_t paramCount = tokens.paramCount();
     if (paramCount < 2 || paramCount % 2 != 0) {
         sendError("Invalid parameter format (KEY:VALUE pairs required)");
         return;
@@ -489,10 +403,14 @@ void MenuController::handleProfileCustom(const char params[][PARAM_BUFFER_SIZE],
     }
 
     // Apply each key-value pair
+    char key[PARAM_BUFFER_SIZE];
+    char value[PARAM_BUFFER_SIZE];
     for (uint8_t i = 0; i < paramCount; i += 2) {
-        if (!_profiles->setParameter(params[i], params[i + 1])) {
+        tokens.copyParam(i, key, sizeof(key));
+        tokens.copyParam(static_cast<uint8_t>(i + 1), value, sizeof(value));
+        if (!_profiles->setParameter(key, value)) {
             char errorMsg[64];
-            snprintf(errorMsg, sizeof(errorMsg), "Invalid parameter: %s", params[i]);
+            snprintf(errorMsg, sizeof(errorMsg), "Invalid parameter: %s", key);
             sendError(errorMsg);
             return;
         }
@@ -507,7 +425,7 @@ void MenuController::handleProfileCustom(const char params[][PARAM_BUFFER_SIZE],
 // SESSION COMMANDS
 // =============================================================================
 
-void MenuController::handleSessionStart() {
+void MenuController::handleSessionStart(const CommandTokens&) {
     if (!_therapy) {
         sendError("Therapy engine not available");
         return;
@@ -575,7 +493,7 @@ void MenuController::handleSessionStart() {
     sendResponse();
 }
 
-void MenuController::handleSessionPause() {
+void MenuController::handleSessionPause(const CommandTokens&) {
     if (!_therapy || !_therapy->isRunning()) {
         sendError("No active session");
         return;
@@ -601,7 +519,7 @@ void MenuController::handleSessionPause() {
     sendResponse();
 }
 
-void MenuController::handleSessionResume() {
+void MenuController::handleSessionResume(const CommandTokens&) {
     if (!_therapy) {
         sendError("No active session");
         return;
@@ -632,7 +550,7 @@ void MenuController::handleSessionResume() {
     sendResponse();
 }
 
-void MenuController::handleSessionStop() {
+void MenuController::handleSessionStop(const CommandTokens&) {
     if (_therapy) {
         _therapy->stop();
     }
@@ -659,7 +577,7 @@ void MenuController::handleSessionStop() {
     sendResponse();
 }
 
-void MenuController::handleSessionStatus() {
+void MenuController::handleSessionStatus(const CommandTokens&) {
     beginResponse();
 
     const char* statusStr = "IDLE";
@@ -686,17 +604,60 @@ void MenuController::handleSessionStatus() {
     sendResponse();
 }
 
+void MenuController::handleSkewStatus(const CommandTokens&) {
+    // Per-event bilateral skew (SECONDARY start - PRIMARY start), measured by
+    // PRIMARY from MC_ACK execution feedback. Zeros until feedback arrives.
+    beginResponse();
+    addResponseLine("SKEW_N", (int32_t)latencyMetrics.skewSampleCount);
+    if (latencyMetrics.skewSampleCount > 0) {
+        addResponseLine("SKEW_MIN", latencyMetrics.minSkew_us);
+        addResponseLine("SKEW_AVG", latencyMetrics.getAverageSkew());
+        addResponseLine("SKEW_MAX", latencyMetrics.maxSkew_us);
+    } else {
+        addResponseLine("SKEW_MIN", (int32_t)0);
+        addResponseLine("SKEW_AVG", (int32_t)0);
+        addResponseLine("SKEW_MAX", (int32_t)0);
+    }
+    addResponseLine("SKEW_P99", (int32_t)latencyMetrics.getSkewP99Abs());
+    sendResponse();
+}
+
+void MenuController::handleSubscribe(const CommandTokens& tokens) {
+    if (!_publisher) {
+        sendError("Status push not available");
+        return;
+    }
+
+    if (tokens.paramCount() < 1) {
+        sendError("Interval (ms) required");
+        return;
+    }
+
+    int32_t intervalMs = tokens.paramInt(0);
+    if (intervalMs < 0) {
+        sendError("Invalid interval");
+        return;
+    }
+
+    // Pushes start once this response has left the TX queue (0 = unsubscribed)
+    uint32_t applied = _publisher->subscribe(static_cast<uint32_t>(intervalMs));
+
+    beginResponse();
+    addResponseLine("SUBSCRIBE", (int32_t)applied);
+    sendResponse();
+}
+
 // =============================================================================
 // PARAMETER COMMANDS
 // =============================================================================
 
-void MenuController::handleParamSet(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleParamSet(const CommandTokens& tokens) {
     if (_therapy && _therapy->isRunning()) {
         sendError("Cannot modify parameters during active session");
         return;
     }
 
-    if (paramCount < 2) {
+    if (tokens.paramCount() < 2) {
         sendError("Parameter name and value required");
         return;
     }
@@ -708,20 +669,21 @@ void MenuController::handleParamSet(const char params[][PARAM_BUFFER_SIZE], uint
 
     // Create local copy and convert param name to uppercase
     char paramName[PARAM_BUFFER_SIZE];
-    strncpy(paramName, params[0], PARAM_BUFFER_SIZE - 1);
-    paramName[PARAM_BUFFER_SIZE - 1] = '\0';
+    char value[PARAM_BUFFER_SIZE];
+    tokens.copyParam(0, paramName, sizeof(paramName));
+    tokens.copyParam(1, value, sizeof(value));
     for (char* c = paramName; *c; c++) {
         *c = static_cast<char>(toupper(*c));
     }
 
-    if (!_profiles->setParameter(paramName, params[1])) {
+    if (!_profiles->setParameter(paramName, value)) {
         sendError("Invalid parameter name or value out of range");
         return;
     }
 
     beginResponse();
     addResponseLine("PARAM", paramName);
-    addResponseLine("VALUE", params[1]);
+    addResponseLine("VALUE", value);
     sendResponse();
 }
 
@@ -729,7 +691,7 @@ void MenuController::handleParamSet(const char params[][PARAM_BUFFER_SIZE], uint
 // CALIBRATION COMMANDS
 // =============================================================================
 
-void MenuController::handleCalibrateStart() {
+void MenuController::handleCalibrateStart(const CommandTokens&) {
     if (_therapy && _therapy->isRunning()) {
         sendError("Cannot calibrate during active session");
         return;
@@ -743,20 +705,20 @@ void MenuController::handleCalibrateStart() {
     sendResponse();
 }
 
-void MenuController::handleCalibrateBuzz(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleCalibrateBuzz(const CommandTokens& tokens) {
     if (!_isCalibrating) {
         sendError("Not in calibration mode");
         return;
     }
 
-    if (paramCount < 3) {
+    if (tokens.paramCount() < 3) {
         sendError("Finger, intensity, and duration required");
         return;
     }
 
-    int finger = atoi(params[0]);
-    int intensity = atoi(params[1]);
-    int duration = atoi(params[2]);
+    int32_t finger = tokens.paramInt(0);
+    int32_t intensity = tokens.paramInt(1);
+    int32_t duration = tokens.paramInt(2);
 
     // Validate ranges
     if (finger < 0 || finger > 7) {
@@ -791,7 +753,7 @@ void MenuController::handleCalibrateBuzz(const char params[][PARAM_BUFFER_SIZE],
     sendResponse();
 }
 
-void MenuController::handleCalibrateStop() {
+void MenuController::handleCalibrateStop(const CommandTokens&) {
     _isCalibrating = false;
 
     if (_haptic) {
@@ -807,7 +769,7 @@ void MenuController::handleCalibrateStop() {
 // SYSTEM COMMANDS
 // =============================================================================
 
-void MenuController::handleHelp() {
+void MenuController::handleHelp(const CommandTokens&) {
     beginResponse();
     addResponseLine("COMMAND", "INFO");
     addResponseLine("COMMAND", "BATTERY");
@@ -821,6 +783,8 @@ void MenuController::handleHelp() {
     addResponseLine("COMMAND", "SESSION_RESUME");
     addResponseLine("COMMAND", "SESSION_STOP");
     addResponseLine("COMMAND", "SESSION_STATUS");
+    addResponseLine("COMMAND", "SKEW_STATUS");
+    addResponseLine("COMMAND", "SUBSCRIBE");
     addResponseLine("COMMAND", "PARAM_SET");
     addResponseLine("COMMAND", "CALIBRATE_START");
     addResponseLine("COMMAND", "CALIBRATE_BUZZ");
@@ -832,7 +796,7 @@ void MenuController::handleHelp() {
     sendResponse();
 }
 
-void MenuController::handleRestart() {
+void MenuController::handleRestart(const CommandTokens&) {
     // Stop any active therapy session before rebooting
     if (_therapy) {
         _therapy->stop();
@@ -864,14 +828,14 @@ void MenuController::handleRestart() {
 // LED CONTROL COMMAND
 // =============================================================================
 
-void MenuController::handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleTherapyLedOff(const CommandTokens& tokens) {
     if (!_profiles) {
         sendError("Profile manager not available");
         return;
     }
 
     // Query mode: no parameter - return current value
-    if (paramCount == 0) {
+    if (tokens.paramCount() == 0) {
         beginResponse();
         addResponseLine("THERAPY_LED_OFF", _profiles->getTherapyLedOff() ? "true" : "false");
         sendResponse();
@@ -880,11 +844,11 @@ void MenuController::handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE],
 
     // Set mode: parse boolean value
     bool newValue = false;
-    const char* value = params[0];
+    std::string_view value = tokens.param(0);
 
-    if (strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0) {
+    if (compareCommand(value, "TRUE", true) == 0 || value == "1") {
         newValue = true;
-    } else if (strcasecmp(value, "false") == 0 || strcmp(value, "0") == 0) {
+    } else if (compareCommand(value, "FALSE", true) == 0 || value == "0") {
         newValue = false;
     } else {
         sendError("Invalid value. Use: true/false or 1/0");
@@ -894,10 +858,8 @@ void MenuController::handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE],
     // Update setting
     _profiles->setTherapyLedOff(newValue);
 
-    // Persist to flash
-    if (!_profiles->saveSettings()) {
-        Serial.println(F("[MENU] Warning: Failed to save settings"));
-    }
+    // Persist to flash outside motor event windows (may be mid-session)
+    _profiles->requestSaveSettings();
 
     // Sync to SECONDARY if connected
     if (_ble && _ble->isSecondaryConnected()) {
@@ -916,14 +878,14 @@ void MenuController::handleTherapyLedOff(const char params[][PARAM_BUFFER_SIZE],
 // DEBUG MODE COMMAND
 // =============================================================================
 
-void MenuController::handleDebug(const char params[][PARAM_BUFFER_SIZE], uint8_t paramCount) {
+void MenuController::handleDebug(const CommandTokens& tokens) {
     if (!_profiles) {
         sendError("Profile manager not available");
         return;
     }
 
     // Query mode: no parameter - return current value
-    if (paramCount == 0) {
+    if (tokens.paramCount() == 0) {
         beginResponse();
         addResponseLine("DEBUG", _profiles->getDebugMode() ? "true" : "false");
         sendResponse();
@@ -932,11 +894,11 @@ void MenuController::handleDebug(const char params[][PARAM_BUFFER_SIZE], uint8_t
 
     // Set mode: parse boolean value
     bool newValue = false;
-    const char* value = params[0];
+    std::string_view value = tokens.param(0);
 
-    if (strcasecmp(value, "true") == 0 || strcmp(value, "1") == 0) {
+    if (compareCommand(value, "TRUE", true) == 0 || value == "1") {
         newValue = true;
-    } else if (strcasecmp(value, "false") == 0 || strcmp(value, "0") == 0) {
+    } else if (compareCommand(value, "FALSE", true) == 0 || value == "0") {
         newValue = false;
     } else {
         sendError("Invalid value. Use: true/false or 1/0");
@@ -946,10 +908,8 @@ void MenuController::handleDebug(const char params[][PARAM_BUFFER_SIZE], uint8_t
     // Update setting
     _profiles->setDebugMode(newValue);
 
-    // Persist to flash
-    if (!_profiles->saveSettings()) {
-        Serial.println(F("[MENU] Warning: Failed to save settings"));
-    }
+    // Persist to flash outside motor event windows (may be mid-session)
+    _profiles->requestSaveSettings();
 
     // Sync to SECONDARY if connected
     if (_ble && _ble->isSecondaryConnected()) {
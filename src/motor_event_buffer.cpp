@@ -7,11 +7,6 @@
 
 #include "motor_event_buffer.h"
 
-// ARM CMSIS intrinsics for memory barriers
-extern "C" {
-    void __DMB(void);  // Data Memory Barrier
-}
-
 // =============================================================================
 // GLOBAL INSTANCE
 // =============================================================================
@@ -25,7 +20,8 @@ MotorEventBuffer motorEventBuffer;
 MotorEventBuffer::MotorEventBuffer() :
     _head(0),
     _tail(0),
-    _macrocyclePending(false)
+    _macrocyclePending(false),
+    _nextIsMacrocycleFirst(false)
 {
     for (uint8_t i = 0; i < MAX_STAGED; i++) {
         _buffer[i].clear();
@@ -33,108 +29,80 @@ MotorEventBuffer::MotorEventBuffer() :
 }
 
 // =============================================================================
-// STAGING (ISR-SAFE)
+// STAGING (ISR-SAFE, PRODUCER ONLY)
 // =============================================================================
 
 bool MotorEventBuffer::stage(uint64_t activateTimeUs, uint8_t finger, uint8_t amplitude,
                               uint16_t durationMs, uint16_t frequencyHz, bool isMacrocycleLast) {
-    // Memory barrier before reading consumer index (tail)
-    __DMB();
+    // Only the producer writes _head, so a relaxed load of our own index is enough
+    uint8_t currentHead = _head.load(std::memory_order_relaxed);
+    uint8_t nextHead = static_cast<uint8_t>((currentHead + 1) & (MAX_STAGED - 1));
 
-    // Calculate next head position
-    uint8_t currentHead = _head;
-    uint8_t nextHead = (currentHead + 1) % MAX_STAGED;
-
-    // Check if buffer is full (next position would equal tail)
-    if (nextHead == _tail) {
+    // Acquire pairs with the consumer's release of _tail: once we see the slot
+    // freed, the consumer's reads of it are complete and we may overwrite it
+    if (nextHead == _tail.load(std::memory_order_acquire)) {
         // Buffer full - cannot stage
         return false;
     }
 
-    // Write event data to current head position
+    // Write event data to current head position (not yet visible to consumer)
     StagedMotorEvent& slot = _buffer[currentHead];
     slot.activateTimeUs = activateTimeUs;
     slot.finger = finger;
     slot.amplitude = amplitude;
     slot.durationMs = durationMs;
     slot.frequencyHz = frequencyHz;
+    slot.isMacrocycleFirst = _nextIsMacrocycleFirst;
     slot.isMacrocycleLast = isMacrocycleLast;
-
-    // Memory barrier to ensure all data writes complete before marking valid
-    __DMB();
-
-    // Mark slot as valid (consumer can now read it)
     slot.valid = true;
+    _nextIsMacrocycleFirst = false;
 
-    // Memory barrier before updating head
-    __DMB();
-
-    // Advance head
-    _head = nextHead;
+    // Release publishes all slot writes above before the new head is observed
+    _head.store(nextHead, std::memory_order_release);
 
     return true;
 }
 
 void MotorEventBuffer::beginMacrocycle() {
-    __DMB();
-    _macrocyclePending = true;
-    __DMB();
+    _nextIsMacrocycleFirst = true;
+    _macrocyclePending.store(true, std::memory_order_release);
 }
 
 bool MotorEventBuffer::isMacrocyclePending() const {
-    __DMB();
-    return _macrocyclePending;
+    return _macrocyclePending.load(std::memory_order_acquire);
 }
 
 // =============================================================================
-// UNSTAGING (MAIN LOOP ONLY)
+// UNSTAGING (CONSUMER ONLY)
 // =============================================================================
 
 bool MotorEventBuffer::unstage(StagedMotorEvent& event) {
-    // Memory barrier before reading producer index (head)
-    __DMB();
+    // Only the consumer writes _tail
+    uint8_t currentTail = _tail.load(std::memory_order_relaxed);
 
-    uint8_t currentTail = _tail;
-
-    // Check if buffer is empty
-    if (currentTail == _head) {
-        return false;
-    }
-
-    // Memory barrier before reading data
-    __DMB();
-
-    // Read event data from current tail position
-    StagedMotorEvent& slot = _buffer[currentTail];
-
-    // Verify slot is valid (should always be true if head != tail)
-    if (!slot.valid) {
-        // Should not happen - indicates a bug
+    // Acquire pairs with the producer's release of _head: slot data is visible
+    if (currentTail == _head.load(std::memory_order_acquire)) {
         return false;
     }
 
     // Copy data to output
+    const StagedMotorEvent& slot = _buffer[currentTail];
     event.activateTimeUs = slot.activateTimeUs;
     event.finger = slot.finger;
     event.amplitude = slot.amplitude;
     event.durationMs = slot.durationMs;
     event.frequencyHz = slot.frequencyHz;
+    event.isMacrocycleFirst = slot.isMacrocycleFirst;
     event.isMacrocycleLast = slot.isMacrocycleLast;
     event.valid = true;
 
     // If this was the last macrocycle event, clear the pending flag
-    if (slot.isMacrocycleLast) {
-        _macrocyclePending = false;
+    if (event.isMacrocycleLast) {
+        _macrocyclePending.store(false, std::memory_order_release);
     }
 
-    // Clear slot
-    slot.clear();
-
-    // Memory barrier before advancing tail
-    __DMB();
-
-    // Advance tail
-    _tail = (currentTail + 1) % MAX_STAGED;
+    // Release hands the slot back to the producer after our reads complete
+    _tail.store(static_cast<uint8_t>((currentTail + 1) & (MAX_STAGED - 1)), std::memory_order_release);
 
     return true;
 }
@@ -144,25 +112,20 @@ bool MotorEventBuffer::unstage(StagedMotorEvent& event) {
 // =============================================================================
 
 bool MotorEventBuffer::hasPending() const {
-    __DMB();
-    return _head != _tail;
+    return _head.load(std::memory_order_acquire) != _tail.load(std::memory_order_acquire);
 }
 
 uint8_t MotorEventBuffer::getPendingCount() const {
-    __DMB();
-    uint8_t h = _head;
-    uint8_t t = _tail;
-    if (h >= t) {
-        return h - t;
-    } else {
-        return MAX_STAGED - t + h;
-    }
+    uint8_t h = _head.load(std::memory_order_acquire);
+    uint8_t t = _tail.load(std::memory_order_acquire);
+    return static_cast<uint8_t>((h - t) & (MAX_STAGED - 1));
 }
 
 void MotorEventBuffer::clear() {
-    _head = 0;
-    _tail = 0;
-    _macrocyclePending = false;
+    _head.store(0, std::memory_order_relaxed);
+    _tail.store(0, std::memory_order_relaxed);
+    _macrocyclePending.store(false, std::memory_order_relaxed);
+    _nextIsMacrocycleFirst = false;
     for (uint8_t i = 0; i < MAX_STAGED; i++) {
         _buffer[i].clear();
     }
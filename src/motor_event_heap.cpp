@@ -0,0 +1,122 @@
+/**
+ * @file motor_event_heap.cpp
+ * @brief Fixed-capacity earliest-deadline min-heap - Implementation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ */
+
+#include "motor_event_heap.h"
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+MotorEventHeap::MotorEventHeap() :
+    _size(0),
+    _nextOrder(0)
+{
+    clear();
+}
+
+void MotorEventHeap::clear() {
+    for (uint8_t i = 0; i < CAPACITY; i++) {
+        _events[i].clear();
+        _order[i] = 0;
+    }
+    _size = 0;
+    _nextOrder = 0;
+}
+
+// =============================================================================
+// INSERT / REMOVE
+// =============================================================================
+
+bool MotorEventHeap::push(const MotorEvent& event) {
+    if (_size >= CAPACITY) {
+        return false;
+    }
+
+    uint8_t pos = _size;
+    _events[pos] = event;
+    _events[pos].active = true;
+    _order[pos] = _nextOrder++;
+    _size++;
+
+    siftUp(pos);
+    return true;
+}
+
+bool MotorEventHeap::pop(MotorEvent& event) {
+    if (_size == 0) {
+        return false;
+    }
+
+    event = _events[0];
+    _size--;
+
+    if (_size > 0) {
+        _events[0] = _events[_size];
+        _order[0] = _order[_size];
+        siftDown(0);
+    }
+    _events[_size].clear();
+    return true;
+}
+
+uint8_t MotorEventHeap::popWithin(MotorEvent* out, uint8_t maxCount, uint32_t windowUs) {
+    if (out == nullptr || maxCount == 0 || _size == 0) {
+        return 0;
+    }
+
+    uint64_t limitUs = _events[0].timeUs + windowUs;
+    uint8_t count = 0;
+    while (count < maxCount && _size > 0 && _events[0].timeUs <= limitUs) {
+        pop(out[count]);
+        count++;
+    }
+    return count;
+}
+
+// =============================================================================
+// HEAP MAINTENANCE
+// =============================================================================
+
+void MotorEventHeap::siftUp(uint8_t pos) {
+    // Hole insertion: shift parents down instead of swapping at each level
+    MotorEvent moving = _events[pos];
+    uint32_t movingOrder = _order[pos];
+    while (pos > 0) {
+        uint8_t parent = static_cast<uint8_t>((pos - 1) / 2);
+        if (!before(moving.timeUs, movingOrder, _events[parent].timeUs, _order[parent])) {
+            break;
+        }
+        _events[pos] = _events[parent];
+        _order[pos] = _order[parent];
+        pos = parent;
+    }
+    _events[pos] = moving;
+    _order[pos] = movingOrder;
+}
+
+void MotorEventHeap::siftDown(uint8_t pos) {
+    MotorEvent moving = _events[pos];
+    uint32_t movingOrder = _order[pos];
+    for (;;) {
+        uint8_t child = static_cast<uint8_t>(2 * pos + 1);
+        if (child >= _size) {
+            break;
+        }
+        uint8_t right = static_cast<uint8_t>(child + 1);
+        if (right < _size && before(right, child)) {
+            child = right;
+        }
+        if (!before(_events[child].timeUs, _order[child], moving.timeUs, movingOrder)) {
+            break;
+        }
+        _events[pos] = _events[child];
+        _order[pos] = _order[child];
+        pos = child;
+    }
+    _events[pos] = moving;
+    _order[pos] = movingOrder;
+}
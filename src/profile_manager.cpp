@@ -6,11 +6,202 @@
  */
 
 #include "profile_manager.h"
+#include "settings_journal.h"
 #include <Adafruit_LittleFS.h>
 #include <InternalFileSystem.h>
 
 using namespace Adafruit_LittleFS_Namespace;
 
+// =============================================================================
+// BUILT-IN PROFILES (constexpr, stored in flash)
+// =============================================================================
+
+namespace {
+
+constexpr TherapyProfile BUILT_IN_PROFILES[] = {
+    // =========================================================================
+    // V1 ORIGINAL PROFILES (research-based vCR therapy)
+    // =========================================================================
+
+    // Profile 1: Regular vCR (Default) - Non-mirrored, no jitter
+    // Reference: Original v1 defaults_RegVCR.py
+    {
+        .name = "regular_vcr",
+        .description = "Regular vCR - non-mirrored, no jitter",
+        .actuatorType = ActuatorType::LRA,
+        .frequencyHz = 250,
+        .timeOnMs = 100.0f,
+        .timeOffMs = 67.0f,
+        .jitterPercent = 0.0f,
+        .amplitudeMin = 100,
+        .amplitudeMax = 100,
+        .sessionDurationMin = 120,
+        .patternType = "rndp",
+        .mirrorPattern = false,
+        .numFingers = 4,
+        .isDefault = true,
+        .frequencyRandomization = false,
+        .frequencyMin = 210,
+        .frequencyMax = 260,
+    },
+
+    // Profile 2: Noisy vCR - Mirrored with 23.5% jitter
+    // Reference: Original v1 defaults_NoisyVCR.py
+    {
+        .name = "noisy_vcr",
+        .description = "Noisy vCR - mirrored with 23.5% jitter",
+        .actuatorType = ActuatorType::LRA,
+        .frequencyHz = 250,
+        .timeOnMs = 100.0f,
+        .timeOffMs = 67.0f,
+        .jitterPercent = 23.5f,
+        .amplitudeMin = 100,
+        .amplitudeMax = 100,
+        .sessionDurationMin = 120,
+        .patternType = "rndp",
+        .mirrorPattern = true,
+        .numFingers = 4,
+        .isDefault = false,
+        .frequencyRandomization = false,
+        .frequencyMin = 210,
+        .frequencyMax = 260,
+    },
+
+    // Profile 3: Hybrid vCR - Non-mirrored with 23.5% jitter
+    // Reference: Original v1 defaults_HybridVCR.py
+    {
+        .name = "hybrid_vcr",
+        .description = "Hybrid vCR - non-mirrored with 23.5% jitter",
+        .actuatorType = ActuatorType::LRA,
+        .frequencyHz = 250,
+        .timeOnMs = 100.0f,
+        .timeOffMs = 67.0f,
+        .jitterPercent = 23.5f,
+        .amplitudeMin = 100,
+        .amplitudeMax = 100,
+        .sessionDurationMin = 120,
+        .patternType = "rndp",
+        .mirrorPattern = false,
+        .numFingers = 4,
+        .isDefault = false,
+        .frequencyRandomization = false,
+        .frequencyMin = 210,
+        .frequencyMax = 260,
+    },
+
+    // Profile 4: Custom vCR - Non-mirrored, jitter, amplitude range, freq randomization
+    // Reference: Original v1 defaults_CustomVCR.py
+    {
+        .name = "custom_vcr",
+        .description = "Custom vCR - variable amplitude & frequency",
+        .actuatorType = ActuatorType::LRA,
+        .frequencyHz = 250,
+        .timeOnMs = 100.0f,
+        .timeOffMs = 67.0f,
+        .jitterPercent = 23.5f,
+        .amplitudeMin = 70,
+        .amplitudeMax = 100,
+        .sessionDurationMin = 120,
+        .patternType = "rndp",
+        .mirrorPattern = false,
+        .numFingers = 4,
+        .isDefault = false,
+        .frequencyRandomization = true,
+        .frequencyMin = 210,
+        .frequencyMax = 260,
+    },
+
+    // =========================================================================
+    // V2 ADDITIONAL PROFILES (convenience/testing)
+    // =========================================================================
+
+    // Profile 5: Gentle (Lower amplitude, v2 addition)
+    {
+        .name = "gentle",
+        .description = "Gentle therapy with lower amplitude (v2)",
+        .actuatorType = ActuatorType::LRA,
+        .frequencyHz = 250,
+        .timeOnMs = 80.0f,
+        .timeOffMs = 87.0f,
+        .jitterPercent = 15.0f,
+        .amplitudeMin = 30,
+        .amplitudeMax = 70,
+        .sessionDurationMin = 60,
+        .patternType = "sequential",
+        .mirrorPattern = true,
+        .numFingers = 4,
+        .isDefault = false,
+        .frequencyRandomization = false,
+        .frequencyMin = 210,
+        .frequencyMax = 260,
+    },
+
+    // Profile 6: Quick Test (Short duration, v2 addition)
+    {
+        .name = "quick_test",
+        .description = "Quick test session - 5 minutes (v2)",
+        .actuatorType = ActuatorType::LRA,
+        .frequencyHz = 250,
+        .timeOnMs = 100.0f,
+        .timeOffMs = 67.0f,
+        .jitterPercent = 23.5f,
+        .amplitudeMin = 50,
+        .amplitudeMax = 100,
+        .sessionDurationMin = 5,
+        .patternType = "rndp",
+        .mirrorPattern = true,
+        .numFingers = 4,
+        .isDefault = false,
+        .frequencyRandomization = false,
+        .frequencyMin = 210,
+        .frequencyMax = 260,
+    },
+};
+
+constexpr uint8_t BUILT_IN_PROFILE_COUNT = sizeof(BUILT_IN_PROFILES) / sizeof(BUILT_IN_PROFILES[0]);
+static_assert(BUILT_IN_PROFILE_COUNT <= MAX_PROFILES, "too many built-in profiles");
+
+// Pattern names accepted by PATTERN (patternType always points at one of these)
+constexpr const char* PATTERN_TYPES[] = {"rndp", "sequential", "mirrored"};
+
+constexpr size_t literalLength(const char* s) {
+    size_t len = 0;
+    while (s[len] != '\0') {
+        len++;
+    }
+    return len;
+}
+
+constexpr bool profileStringsFit() {
+    for (const TherapyProfile& profile : BUILT_IN_PROFILES) {
+        if (literalLength(profile.name) >= PROFILE_NAME_MAX ||
+            literalLength(profile.description) >= PROFILE_DESC_MAX) {
+            return false;
+        }
+    }
+    for (const char* pattern : PATTERN_TYPES) {
+        if (literalLength(pattern) >= PATTERN_TYPE_MAX) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(profileStringsFit(), "profile strings exceed PROFILE_NAME_MAX/PROFILE_DESC_MAX/PATTERN_TYPE_MAX");
+
+/**
+ * @brief Map a pattern name (any case) to its literal, or nullptr if unknown
+ */
+const char* findPatternType(const char* value) {
+    for (const char* pattern : PATTERN_TYPES) {
+        if (strcasecmp(value, pattern) == 0) {
+            return pattern;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
 // =============================================================================
 // CONSTRUCTOR
 // =============================================================================
@@ -23,7 +214,10 @@ ProfileManager::ProfileManager() :
     _deviceRole(DeviceRole::PRIMARY),
     _roleFromSettings(false),
     _therapyLedOff(false),
-    _debugMode(false)
+    _debugMode(false),
+    _lastSaveStallUs(0),
+    _persisted{},
+    _journalBytes(0)
 {
     memset(_profileNames, 0, sizeof(_profileNames));
 }
@@ -60,151 +254,9 @@ bool ProfileManager::begin(bool loadFromStorage) {
 }
 
 void ProfileManager::initBuiltInProfiles() {
-    _profileCount = 0;
-
-    // =========================================================================
-    // V1 ORIGINAL PROFILES (research-based vCR therapy)
-    // =========================================================================
-
-    // Profile 1: Regular vCR (Default) - Non-mirrored, no jitter
-    // Reference: Original v1 defaults_RegVCR.py
-    TherapyProfile& regular = _builtInProfiles[_profileCount];
-    strcpy(regular.name, "regular_vcr");
-    strcpy(regular.description, "Regular vCR - non-mirrored, no jitter");
-    regular.actuatorType = ActuatorType::LRA;
-    regular.frequencyHz = 250;
-    regular.timeOnMs = 100.0f;
-    regular.timeOffMs = 67.0f;
-    regular.jitterPercent = 0.0f;
-    regular.amplitudeMin = 100;
-    regular.amplitudeMax = 100;
-    regular.sessionDurationMin = 120;
-    strcpy(regular.patternType, "rndp");
-    regular.mirrorPattern = false;
-    regular.numFingers = 4;
-    regular.isDefault = true;
-    regular.frequencyRandomization = false;
-    regular.frequencyMin = 210;
-    regular.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // Profile 2: Noisy vCR - Mirrored with 23.5% jitter
-    // Reference: Original v1 defaults_NoisyVCR.py
-    TherapyProfile& noisy = _builtInProfiles[_profileCount];
-    strcpy(noisy.name, "noisy_vcr");
-    strcpy(noisy.description, "Noisy vCR - mirrored with 23.5% jitter");
-    noisy.actuatorType = ActuatorType::LRA;
-    noisy.frequencyHz = 250;
-    noisy.timeOnMs = 100.0f;
-    noisy.timeOffMs = 67.0f;
-    noisy.jitterPercent = 23.5f;
-    noisy.amplitudeMin = 100;
-    noisy.amplitudeMax = 100;
-    noisy.sessionDurationMin = 120;
-    strcpy(noisy.patternType, "rndp");
-    noisy.mirrorPattern = true;
-    noisy.numFingers = 4;
-    noisy.isDefault = false;
-    noisy.frequencyRandomization = false;
-    noisy.frequencyMin = 210;
-    noisy.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // Profile 3: Hybrid vCR - Non-mirrored with 23.5% jitter
-    // Reference: Original v1 defaults_HybridVCR.py
-    TherapyProfile& hybrid = _builtInProfiles[_profileCount];
-    strcpy(hybrid.name, "hybrid_vcr");
-    strcpy(hybrid.description, "Hybrid vCR - non-mirrored with 23.5% jitter");
-    hybrid.actuatorType = ActuatorType::LRA;
-    hybrid.frequencyHz = 250;
-    hybrid.timeOnMs = 100.0f;
-    hybrid.timeOffMs = 67.0f;
-    hybrid.jitterPercent = 23.5f;
-    hybrid.amplitudeMin = 100;
-    hybrid.amplitudeMax = 100;
-    hybrid.sessionDurationMin = 120;
-    strcpy(hybrid.patternType, "rndp");
-    hybrid.mirrorPattern = false;
-    hybrid.numFingers = 4;
-    hybrid.isDefault = false;
-    hybrid.frequencyRandomization = false;
-    hybrid.frequencyMin = 210;
-    hybrid.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // Profile 4: Custom vCR - Non-mirrored, jitter, amplitude range, freq randomization
-    // Reference: Original v1 defaults_CustomVCR.py
-    TherapyProfile& custom = _builtInProfiles[_profileCount];
-    strcpy(custom.name, "custom_vcr");
-    strcpy(custom.description, "Custom vCR - variable amplitude & frequency");
-    custom.actuatorType = ActuatorType::LRA;
-    custom.frequencyHz = 250;
-    custom.timeOnMs = 100.0f;
-    custom.timeOffMs = 67.0f;
-    custom.jitterPercent = 23.5f;
-    custom.amplitudeMin = 70;
-    custom.amplitudeMax = 100;
-    custom.sessionDurationMin = 120;
-    strcpy(custom.patternType, "rndp");
-    custom.mirrorPattern = false;
-    custom.numFingers = 4;
-    custom.isDefault = false;
-    custom.frequencyRandomization = true;
-    custom.frequencyMin = 210;
-    custom.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // =========================================================================
-    // V2 ADDITIONAL PROFILES (convenience/testing)
-    // =========================================================================
-
-    // Profile 5: Gentle (Lower amplitude, v2 addition)
-    TherapyProfile& gentle = _builtInProfiles[_profileCount];
-    strcpy(gentle.name, "gentle");
-    strcpy(gentle.description, "Gentle therapy with lower amplitude (v2)");
-    gentle.actuatorType = ActuatorType::LRA;
-    gentle.frequencyHz = 250;
-    gentle.timeOnMs = 80.0f;
-    gentle.timeOffMs = 87.0f;
-    gentle.jitterPercent = 15.0f;
-    gentle.amplitudeMin = 30;
-    gentle.amplitudeMax = 70;
-    gentle.sessionDurationMin = 60;
-    strcpy(gentle.patternType, "sequential");
-    gentle.mirrorPattern = true;
-    gentle.numFingers = 4;
-    gentle.isDefault = false;
-    gentle.frequencyRandomization = false;
-    gentle.frequencyMin = 210;
-    gentle.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
-
-    // Profile 6: Quick Test (Short duration, v2 addition)
-    TherapyProfile& quick = _builtInProfiles[_profileCount];
-    strcpy(quick.name, "quick_test");
-    strcpy(quick.description, "Quick test session - 5 minutes (v2)");
-    quick.actuatorType = ActuatorType::LRA;
-    quick.frequencyHz = 250;
-    quick.timeOnMs = 100.0f;
-    quick.timeOffMs = 67.0f;
-    quick.jitterPercent = 23.5f;
-    quick.amplitudeMin = 50;
-    quick.amplitudeMax = 100;
-    quick.sessionDurationMin = 5;
-    strcpy(quick.patternType, "rndp");
-    quick.mirrorPattern = true;
-    quick.numFingers = 4;
-    quick.isDefault = false;
-    quick.frequencyRandomization = false;
-    quick.frequencyMin = 210;
-    quick.frequencyMax = 260;
-    _profileNames[_profileCount] = _builtInProfiles[_profileCount].name;
-    _profileCount++;
+    for (_profileCount = 0; _profileCount < BUILT_IN_PROFILE_COUNT; _profileCount++) {
+        _profileNames[_profileCount] = BUILT_IN_PROFILES[_profileCount].name;
+    }
 }
 
 // =============================================================================
@@ -224,8 +276,8 @@ bool ProfileManager::loadProfile(uint8_t profileId) {
         return false;
     }
 
-    // Copy built-in profile to current
-    _currentProfile = _builtInProfiles[profileId - 1];
+    // Copy built-in profile to current (strings stay in flash)
+    _currentProfile = BUILT_IN_PROFILES[profileId - 1];
     _currentProfileId = profileId;
     _profileLoaded = true;
 
@@ -242,7 +294,7 @@ bool ProfileManager::loadProfileByName(const char* name) {
     }
 
     for (uint8_t i = 0; i < _profileCount; i++) {
-        if (strcasecmp(_builtInProfiles[i].name, name) == 0) {
+        if (strcasecmp(BUILT_IN_PROFILES[i].name, name) == 0) {
             return loadProfile(i + 1);
         }
     }
@@ -323,18 +375,9 @@ bool ProfileManager::setParameter(const char* paramName, const char* value) {
         _currentProfile.amplitudeMax = static_cast<uint8_t>(amp);
     }
     else if (strcmp(paramUpper, "PATTERN") == 0) {
-        if (strcasecmp(value, "rndp") == 0 ||
-            strcasecmp(value, "sequential") == 0 ||
-            strcasecmp(value, "mirrored") == 0) {
-            strncpy(_currentProfile.patternType, value, PATTERN_TYPE_MAX - 1);
-            _currentProfile.patternType[PATTERN_TYPE_MAX - 1] = '\0';
-            // Lowercase for consistency
-            for (char* c = _currentProfile.patternType; *c; c++) {
-                *c = static_cast<char>(tolower(*c));
-            }
-        } else {
-            return false;
-        }
+        const char* pattern = findPatternType(value);
+        if (!pattern) return false;
+        _currentProfile.patternType = pattern;
     }
     else if (strcmp(paramUpper, "MIRROR") == 0) {
         int mirror = atoi(value);
@@ -361,21 +404,17 @@ bool ProfileManager::setParameter(const char* paramName, const char* value) {
 
 void ProfileManager::resetToDefaults() {
     if (_currentProfileId > 0 && _currentProfileId <= _profileCount) {
-        _currentProfile = _builtInProfiles[_currentProfileId - 1];
+        _currentProfile = BUILT_IN_PROFILES[_currentProfileId - 1];
         Serial.printf("[PROFILE] Reset to defaults: %s\n", _currentProfile.name);
     }
 }
 
 // =============================================================================
-// SETTINGS PERSISTENCE (Binary format)
+// SETTINGS PERSISTENCE (Journal, see settings_journal.h)
 // =============================================================================
 
-bool ProfileManager::saveSettings() {
-    if (!_storageAvailable) {
-        return false;
-    }
-
-    SettingsData data{};
+void ProfileManager::captureSettings(SettingsData& data) const {
+    data = SettingsData{};
 
     // Header
     data.magic = SETTINGS_MAGIC;
@@ -383,8 +422,6 @@ bool ProfileManager::saveSettings() {
 
     // Device role
     data.role = (_deviceRole == DeviceRole::SECONDARY) ? 1 : 0;
-    Serial.printf("[SETTINGS] Saving role: %s (value=%d)\n",
-                  deviceRoleToString(_deviceRole), data.role);
 
     // Profile data
     data.profileId = _currentProfileId;
@@ -409,48 +446,212 @@ bool ProfileManager::saveSettings() {
 
     // Debug mode
     data.debugMode = _debugMode ? 1 : 0;
+}
+
+bool ProfileManager::saveSettings() {
+    if (!_storageAvailable) {
+        return false;
+    }
+
+    SettingsData data;
+    captureSettings(data);
+    Serial.printf("[SETTINGS] Saving role: %s (value=%d)\n",
+                  deviceRoleToString(_deviceRole), data.role);
+
+    // Only changed fields are appended; a full journal is rewritten
+    uint8_t records[SettingsJournal::ENCODE_BUFFER_SIZE];
+    size_t recordBytes = 0;
+    bool compact = (_journalBytes == 0);
+    if (!compact) {
+        SettingsJournal::encodeChanges(_persisted, data, records, sizeof(records), recordBytes);
+        if (recordBytes == 0) {
+            _lastSaveStallUs = 0;
+            Serial.println(F("[SETTINGS] Unchanged, nothing to write"));
+            return true;
+        }
+        compact = (_journalBytes + recordBytes > SETTINGS_JOURNAL_MAX_BYTES);
+    }
+
+    // Timed from open to close: LittleFS erases/programs flash in here, stalling the CPU
+    uint32_t writeStart = micros();
+    bool ok = compact ? compactJournal(data) : appendJournal(records, recordBytes);
+    _lastSaveStallUs = micros() - writeStart;
+
+    if (!ok) {
+        return false;
+    }
+
+    _persisted = data;
+    Serial.printf("[SETTINGS] Saved %s, journal %u bytes (flash stall %lu us)\n",
+                  compact ? "snapshot" : "changes", _journalBytes, (unsigned long)_lastSaveStallUs);
+    return true;
+}
 
-    // Write binary data
-    // Note: FILE_O_WRITE seeks to end-of-file, so we must seek(0) to overwrite
+bool ProfileManager::appendJournal(const uint8_t* records, size_t len) {
+    // FILE_O_WRITE positions at EOF
     File file(InternalFS);
-    if (!file.open(SETTINGS_FILE, FILE_O_WRITE)) {
-        Serial.println(F("[SETTINGS] Failed to open file for writing"));
+    if (!file.open(SETTINGS_JOURNAL_FILE, FILE_O_WRITE)) {
+        Serial.println(F("[SETTINGS] Failed to open journal for append"));
         return false;
     }
 
-    // Seek to beginning to overwrite (FILE_O_WRITE positions at EOF)
-    file.seek(0);
+    size_t written = file.write(records, len);
+    file.flush();  // Ensure data is written to flash before close
+    file.close();
 
-    size_t written = file.write((uint8_t*)&data, sizeof(data));
+    if (written != len) {
+        // Partial record at the tail: replay drops it, next save compacts
+        _journalBytes = 0;
+        Serial.println(F("[SETTINGS] Journal append failed"));
+        return false;
+    }
+
+    _journalBytes = static_cast<uint16_t>(_journalBytes + len);
+    return true;
+}
+
+bool ProfileManager::compactJournal(const SettingsData& data) {
+    uint8_t snapshot[SettingsJournal::ENCODE_BUFFER_SIZE];
+    size_t len = SettingsJournal::encodeSnapshot(data, snapshot, sizeof(snapshot));
+
+    // Written beside the journal and renamed over it, so a reset mid-write
+    // leaves the old journal intact
+    if (InternalFS.exists(SETTINGS_JOURNAL_TMP_FILE)) {
+        InternalFS.remove(SETTINGS_JOURNAL_TMP_FILE);
+    }
+
+    File file(InternalFS);
+    if (!file.open(SETTINGS_JOURNAL_TMP_FILE, FILE_O_WRITE)) {
+        Serial.println(F("[SETTINGS] Failed to open file for writing"));
+        return false;
+    }
+
+    size_t written = file.write(snapshot, len);
     file.flush();  // Ensure data is written to flash before close
     file.close();
 
-    if (written != sizeof(data)) {
+    if (written != len || !InternalFS.rename(SETTINGS_JOURNAL_TMP_FILE, SETTINGS_JOURNAL_FILE)) {
         Serial.println(F("[SETTINGS] Write failed"));
         return false;
     }
+    _journalBytes = static_cast<uint16_t>(len);
 
-    Serial.println(F("[SETTINGS] Saved"));
+    // Migrated: the journal now holds everything the v1 file did
+    if (InternalFS.exists(SETTINGS_FILE)) {
+        InternalFS.remove(SETTINGS_FILE);
+        Serial.println(F("[SETTINGS] Migrated v1 settings file to journal"));
+    }
     return true;
 }
 
+void ProfileManager::requestSaveSettings() {
+    if (!_storageAvailable) {
+        return;
+    }
+    _settingsWriter.markDirty(millis());
+}
+
+bool ProfileManager::serviceSettingsWrite(uint64_t nowUs, uint64_t nextMotorEventUs,
+                                          uint64_t nextMacrocycleUs) {
+    if (!_settingsWriter.shouldCommit(millis(), nowUs, nextMotorEventUs, nextMacrocycleUs)) {
+        return false;
+    }
+    if (nextMacrocycleUs < nextMotorEventUs) {
+        nextMotorEventUs = nextMacrocycleUs;
+    }
+
+    uint32_t generation = _settingsWriter.beginCommit();
+    bool saved = saveSettings();
+    _settingsWriter.endCommit(generation, millis(), _lastSaveStallUs, saved);
+
+    // saveSettings() logged the stall; relate it to the window it had
+    if (nextMotorEventUs == UINT64_MAX) {
+        Serial.println(F("[SETTINGS] Deferred commit (no motor events pending)"));
+    } else {
+        uint64_t windowUs = nextMotorEventUs - nowUs;
+        Serial.printf("[SETTINGS] Deferred commit in %lu us motor-free window\n", (unsigned long)windowUs);
+        if (_lastSaveStallUs >= windowUs) {
+            Serial.println(F("[SETTINGS] WARNING: Flash stall overran the next motor event"));
+        }
+    }
+    return saved;
+}
+
 bool ProfileManager::loadSettings() {
     if (!_storageAvailable) {
         return false;
     }
 
-    if (!InternalFS.exists(SETTINGS_FILE)) {
+    // Leftover from a compaction interrupted before its rename
+    if (InternalFS.exists(SETTINGS_JOURNAL_TMP_FILE)) {
+        InternalFS.remove(SETTINGS_JOURNAL_TMP_FILE);
+    }
+
+    SettingsData data;
+    bool migrate = false;
+    if (InternalFS.exists(SETTINGS_JOURNAL_FILE)) {
+        if (!loadJournal(data)) {
+            return false;
+        }
+    } else if (InternalFS.exists(SETTINGS_FILE)) {
+        if (!loadLegacySettings(data)) {
+            return false;
+        }
+        migrate = true;
+    } else {
         Serial.println(F("[SETTINGS] No settings file found"));
         return false;
     }
 
+    applySettings(data);
+
+    if (migrate) {
+        saveSettings();  // _journalBytes is 0: writes a snapshot, removes the v1 file
+    }
+    return true;
+}
+
+bool ProfileManager::loadJournal(SettingsData& data) {
+    File file(InternalFS);
+    if (!file.open(SETTINGS_JOURNAL_FILE, FILE_O_READ)) {
+        Serial.println(F("[SETTINGS] Failed to open file"));
+        return false;
+    }
+
+    uint8_t image[SETTINGS_JOURNAL_MAX_BYTES];
+    size_t bytesRead = file.read(image, sizeof(image));
+    file.close();
+
+    // Fields without records keep the values an empty v1 file would have
+    data = SettingsData{};
+    data.magic = SETTINGS_MAGIC;
+    data.version = SETTINGS_VERSION;
+
+    SettingsJournalReplay result = SettingsJournal::replay(image, bytesRead, data);
+    if (!result.valid) {
+        Serial.println(F("[SETTINGS] Invalid file format"));
+        return false;
+    }
+
+    _persisted = data;
+    if (result.torn) {
+        // Interrupted append: keep the good prefix, rewrite on next save
+        _journalBytes = 0;
+        Serial.printf("[SETTINGS] Journal truncated at byte %u (%u records kept)\n",
+                      (unsigned)result.validBytes, result.records);
+    } else {
+        _journalBytes = static_cast<uint16_t>(result.validBytes);
+    }
+    return true;
+}
+
+bool ProfileManager::loadLegacySettings(SettingsData& data) {
     File file(InternalFS);
     if (!file.open(SETTINGS_FILE, FILE_O_READ)) {
         Serial.println(F("[SETTINGS] Failed to open file"));
         return false;
     }
 
-    SettingsData data;
     size_t bytesRead = file.read((uint8_t*)&data, sizeof(data));
     file.close();
 
@@ -458,7 +659,10 @@ bool ProfileManager::loadSettings() {
         Serial.println(F("[SETTINGS] Invalid file format"));
         return false;
     }
+    return true;
+}
 
+void ProfileManager::applySettings(const SettingsData& data) {
     // Load device role
     _deviceRole = (data.role == 1) ? DeviceRole::SECONDARY : DeviceRole::PRIMARY;
     _roleFromSettings = true;
@@ -466,7 +670,7 @@ bool ProfileManager::loadSettings() {
 
     // Load profile
     if (data.profileId > 0 && data.profileId <= _profileCount) {
-        _currentProfile = _builtInProfiles[data.profileId - 1];
+        _currentProfile = BUILT_IN_PROFILES[data.profileId - 1];
         _currentProfileId = data.profileId;
 
         // Apply saved customizations
@@ -492,8 +696,15 @@ bool ProfileManager::loadSettings() {
         _currentProfile.amplitudeMin = data.amplitudeMin;
         _currentProfile.amplitudeMax = data.amplitudeMax;
         _currentProfile.sessionDurationMin = data.sessionDurationMin;
-        strncpy(_currentProfile.patternType, data.patternType, PATTERN_TYPE_MAX - 1);
-        _currentProfile.patternType[PATTERN_TYPE_MAX - 1] = '\0';
+        char storedPattern[sizeof(data.patternType) + 1] = {};
+        memcpy(storedPattern, data.patternType, sizeof(data.patternType));
+        const char* pattern = findPatternType(storedPattern);
+        if (pattern) {
+            _currentProfile.patternType = pattern;
+        } else {
+            Serial.printf("[SETTINGS] WARNING: Invalid pattern '%s', keeping default %s\n",
+                          storedPattern, _currentProfile.patternType);
+        }
         _currentProfile.mirrorPattern = (data.mirrorPattern != 0);
         _currentProfile.numFingers = data.numFingers;
 
@@ -513,5 +724,4 @@ bool ProfileManager::loadSettings() {
     Serial.printf("[SETTINGS] Debug Mode: %s\n", _debugMode ? "true" : "false");
 
     Serial.printf("[SETTINGS] Loaded profile: %s\n", _currentProfile.name);
-    return true;
 }
@@ -0,0 +1,82 @@
+/**
+ * @file rx_frame_assembler.cpp
+ * @brief EOT frame reassembly with first-byte receive timestamps - Implementation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ */
+
+#include "rx_frame_assembler.h"
+
+// =============================================================================
+// CONSTRUCTOR / RESET
+// =============================================================================
+
+RxFrameAssembler::RxFrameAssembler() :
+    _overflowCount(0)
+{
+    reset();
+}
+
+void RxFrameAssembler::reset() {
+    _buffer[0] = '\0';
+    _length = 0;
+    _frameRxUs = 0;
+    _frameReady = false;
+    _discarding = false;
+}
+
+// =============================================================================
+// REASSEMBLY
+// =============================================================================
+
+uint16_t RxFrameAssembler::feed(const uint8_t* data, uint16_t len, uint64_t chunkRxUs) {
+    if (_frameReady) {
+        return 0;
+    }
+
+    for (uint16_t i = 0; i < len; i++) {
+        uint8_t c = data[i];
+
+        // Skip carriage return
+        if (c == '\r') {
+            continue;
+        }
+
+        if (c == BLE_EOT_CHAR) {
+            if (_discarding) {
+                _discarding = false;
+                _length = 0;
+                continue;
+            }
+            if (_length == 0) {
+                continue;  // Empty frame
+            }
+            _buffer[_length] = '\0';
+            _frameReady = true;
+            return static_cast<uint16_t>(i + 1);
+        }
+
+        if (_discarding) {
+            continue;
+        }
+
+        if (_length >= RX_BUFFER_SIZE - 1) {
+            // Oversized: drop the whole frame rather than deliver its tail as a message
+            _overflowCount++;
+            _discarding = true;
+            _length = 0;
+            continue;
+        }
+
+        if (_length == 0) {
+            _frameRxUs = chunkRxUs;  // First byte of a new frame
+        }
+        _buffer[_length++] = static_cast<char>(c);
+    }
+    return len;
+}
+
+void RxFrameAssembler::consumeFrame() {
+    _frameReady = false;
+    _length = 0;
+}
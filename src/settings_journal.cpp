@@ -0,0 +1,182 @@
+/**
+ * @file settings_journal.cpp
+ * @brief Append-only key/value journal for persistent settings - Implementation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ */
+
+#include "settings_journal.h"
+#include <string.h>
+
+// =============================================================================
+// FIELD TABLE
+// =============================================================================
+
+namespace {
+
+struct SettingsField {
+    SettingsKey key;
+    uint8_t offset;     // Within SettingsData
+    uint8_t size;
+};
+
+#define SETTINGS_FIELD(k, member) \
+    { SettingsKey::k, static_cast<uint8_t>(offsetof(SettingsData, member)), \
+      static_cast<uint8_t>(sizeof(SettingsData::member)) }
+
+constexpr SettingsField SETTINGS_FIELDS[] = {
+    SETTINGS_FIELD(ROLE, role),
+    SETTINGS_FIELD(PROFILE_ID, profileId),
+    SETTINGS_FIELD(ACTUATOR_TYPE, actuatorType),
+    SETTINGS_FIELD(FREQUENCY_HZ, frequencyHz),
+    SETTINGS_FIELD(TIME_ON_MS, timeOnMs),
+    SETTINGS_FIELD(TIME_OFF_MS, timeOffMs),
+    SETTINGS_FIELD(JITTER_PERCENT, jitterPercent),
+    SETTINGS_FIELD(AMPLITUDE_MIN, amplitudeMin),
+    SETTINGS_FIELD(AMPLITUDE_MAX, amplitudeMax),
+    SETTINGS_FIELD(SESSION_DURATION_MIN, sessionDurationMin),
+    SETTINGS_FIELD(PATTERN_TYPE, patternType),
+    SETTINGS_FIELD(MIRROR_PATTERN, mirrorPattern),
+    SETTINGS_FIELD(NUM_FINGERS, numFingers),
+    SETTINGS_FIELD(THERAPY_LED_OFF, therapyLedOff),
+    SETTINGS_FIELD(DEBUG_MODE, debugMode),
+};
+
+#undef SETTINGS_FIELD
+
+constexpr size_t SETTINGS_FIELD_COUNT = sizeof(SETTINGS_FIELDS) / sizeof(SETTINGS_FIELDS[0]);
+static_assert(SETTINGS_FIELD_COUNT == SettingsJournal::FIELD_COUNT, "update SettingsJournal::FIELD_COUNT");
+
+const SettingsField* findField(uint8_t key) {
+    for (size_t i = 0; i < SETTINGS_FIELD_COUNT; i++) {
+        if (static_cast<uint8_t>(SETTINGS_FIELDS[i].key) == key) {
+            return &SETTINGS_FIELDS[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Append one record; returns bytes written (0 if it doesn't fit)
+ */
+size_t encodeRecord(const SettingsField& field, const SettingsData& data, uint8_t* out, size_t outSize) {
+    size_t recordSize = field.size + SettingsJournal::RECORD_OVERHEAD;
+    if (recordSize > outSize) {
+        return 0;
+    }
+    out[0] = static_cast<uint8_t>(field.key);
+    out[1] = field.size;
+    memcpy(out + 2, reinterpret_cast<const uint8_t*>(&data) + field.offset, field.size);
+    uint16_t crc = SettingsJournal::crc16(out, field.size + 2u);
+    out[field.size + 2] = static_cast<uint8_t>(crc & 0xFF);
+    out[field.size + 3] = static_cast<uint8_t>(crc >> 8);
+    return recordSize;
+}
+
+}  // namespace
+
+// =============================================================================
+// ENCODING
+// =============================================================================
+
+bool SettingsJournal::encodeChanges(const SettingsData& from, const SettingsData& to,
+                                    uint8_t* out, size_t outSize, size_t& written) {
+    const uint8_t* fromBytes = reinterpret_cast<const uint8_t*>(&from);
+    const uint8_t* toBytes = reinterpret_cast<const uint8_t*>(&to);
+    written = 0;
+
+    for (size_t i = 0; i < SETTINGS_FIELD_COUNT; i++) {
+        const SettingsField& field = SETTINGS_FIELDS[i];
+        if (memcmp(fromBytes + field.offset, toBytes + field.offset, field.size) == 0) {
+            continue;
+        }
+        size_t recordSize = encodeRecord(field, to, out + written, outSize - written);
+        if (recordSize == 0) {
+            return false;
+        }
+        written += recordSize;
+    }
+    return true;
+}
+
+size_t SettingsJournal::snapshotSize() {
+    size_t size = HEADER_SIZE;
+    for (size_t i = 0; i < SETTINGS_FIELD_COUNT; i++) {
+        size += SETTINGS_FIELDS[i].size + RECORD_OVERHEAD;
+    }
+    return size;
+}
+
+size_t SettingsJournal::encodeSnapshot(const SettingsData& data, uint8_t* out, size_t outSize) {
+    if (outSize < snapshotSize()) {
+        return 0;
+    }
+
+    out[0] = SETTINGS_MAGIC;
+    out[1] = SETTINGS_JOURNAL_ID;
+    out[2] = SETTINGS_JOURNAL_VERSION;
+    out[3] = 0xFF;
+
+    size_t written = HEADER_SIZE;
+    for (size_t i = 0; i < SETTINGS_FIELD_COUNT; i++) {
+        written += encodeRecord(SETTINGS_FIELDS[i], data, out + written, outSize - written);
+    }
+    return written;
+}
+
+// =============================================================================
+// REPLAY
+// =============================================================================
+
+SettingsJournalReplay SettingsJournal::replay(const uint8_t* image, size_t len, SettingsData& data) {
+    SettingsJournalReplay result = {false, 0, 0, 0, false};
+
+    if (len < HEADER_SIZE || image[0] != SETTINGS_MAGIC || image[1] != SETTINGS_JOURNAL_ID ||
+        image[2] != SETTINGS_JOURNAL_VERSION) {
+        return result;
+    }
+    result.valid = true;
+
+    size_t pos = HEADER_SIZE;
+    while (pos < len) {
+        // Key and length, then value and CRC
+        if (len - pos < RECORD_OVERHEAD || len - pos < static_cast<size_t>(RECORD_OVERHEAD) + image[pos + 1]) {
+            result.torn = true;
+            break;
+        }
+        uint8_t key = image[pos];
+        uint8_t size = image[pos + 1];
+        uint16_t stored = static_cast<uint16_t>(image[pos + 2 + size] | (image[pos + 3 + size] << 8));
+        if (crc16(image + pos, size + 2u) != stored) {
+            result.torn = true;
+            break;
+        }
+
+        const SettingsField* field = findField(key);
+        if (field && field->size == size) {
+            memcpy(reinterpret_cast<uint8_t*>(&data) + field->offset, image + pos + 2, size);
+            result.records++;
+        } else {
+            result.skipped++;
+        }
+        pos += size + RECORD_OVERHEAD;
+    }
+
+    result.validBytes = pos;
+    return result;
+}
+
+// =============================================================================
+// CRC
+// =============================================================================
+
+uint16_t SettingsJournal::crc16(const uint8_t* data, size_t len, uint16_t crc) {
+    for (size_t i = 0; i < len; i++) {
+        crc = static_cast<uint16_t>(crc ^ (data[i] << 8));
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                                 : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
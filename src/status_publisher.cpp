@@ -0,0 +1,209 @@
+/**
+ * @file status_publisher.cpp
+ * @brief Pushes session status deltas to a subscribed phone - Implementation
+ * @version 1.0.0
+ * @platform Adafruit Feather nRF52840 Express
+ */
+
+#include "status_publisher.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+// =============================================================================
+// CHANGE DETECTION
+// =============================================================================
+
+namespace {
+
+bool batteryChanged(uint16_t sent, uint16_t now) {
+    uint16_t diff = (now > sent) ? static_cast<uint16_t>(now - sent) : static_cast<uint16_t>(sent - now);
+    return diff >= STATUS_PUSH_BATTERY_STEP_CV;
+}
+
+bool syncChanged(int32_t sent, int32_t now) {
+    // Gaining or losing sync always counts; negative = not synced
+    if ((sent < 0) != (now < 0)) {
+        return true;
+    }
+    if (sent < 0) {
+        return false;
+    }
+    int32_t diff = (now > sent) ? now - sent : sent - now;
+    return diff >= STATUS_PUSH_SYNC_STEP_US;
+}
+
+/**
+ * @brief printf one line onto the message; false if it doesn't fit
+ */
+bool appendLine(char* out, size_t outSize, size_t& len, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(out + len, outSize - len, format, args);
+    va_end(args);
+    if (n < 0 || static_cast<size_t>(n) >= outSize - len) {
+        return false;
+    }
+    len += static_cast<size_t>(n);
+    return true;
+}
+
+}  // namespace
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+StatusPublisher::StatusPublisher() :
+    _intervalMs(0),
+    _lastPushMs(0),
+    _lastMacrocycleMs(0),
+    _macrocycleSent(false),
+    _hasSent(false),
+    _sent{TherapyState::IDLE, 0, 0, 0, -1},
+    _pushCount(0),
+    _deferredCount(0),
+    _deferring(false)
+{
+}
+
+// =============================================================================
+// SUBSCRIPTION
+// =============================================================================
+
+uint32_t StatusPublisher::subscribe(uint32_t intervalMs) {
+    if (intervalMs == 0) {
+        unsubscribe();
+        return 0;
+    }
+
+    if (intervalMs < STATUS_PUSH_MIN_INTERVAL_MS) {
+        intervalMs = STATUS_PUSH_MIN_INTERVAL_MS;
+    } else if (intervalMs > STATUS_PUSH_MAX_INTERVAL_MS) {
+        intervalMs = STATUS_PUSH_MAX_INTERVAL_MS;
+    }
+
+    _intervalMs = intervalMs;
+    _hasSent = false;
+    _deferring = false;
+    return _intervalMs;
+}
+
+void StatusPublisher::unsubscribe() {
+    _intervalMs = 0;
+    _hasSent = false;
+    _deferring = false;
+}
+
+// =============================================================================
+// SCHEDULING
+// =============================================================================
+
+void StatusPublisher::onMacrocycleSent(uint32_t nowMs) {
+    _lastMacrocycleMs = nowMs;
+    _macrocycleSent = true;
+}
+
+bool StatusPublisher::isLinkIdle(uint32_t nowMs, uint8_t pendingTx) const {
+    if (pendingTx > 0) {
+        return false;
+    }
+    return !_macrocycleSent || nowMs - _lastMacrocycleMs >= STATUS_PUSH_MACROCYCLE_HOLDOFF_MS;
+}
+
+bool StatusPublisher::isDue(uint32_t nowMs, const StatusSnapshot& snapshot) const {
+    if (!isSubscribed()) {
+        return false;
+    }
+    if (!_hasSent) {
+        return true;
+    }
+
+    uint32_t sinceLast = nowMs - _lastPushMs;
+    if (sinceLast < STATUS_PUSH_MIN_INTERVAL_MS) {
+        return false;
+    }
+    return snapshot.state != _sent.state || sinceLast >= _intervalMs;
+}
+
+size_t StatusPublisher::prepare(uint32_t nowMs, const StatusSnapshot& snapshot, uint8_t pendingTx,
+                                char* out, size_t outSize) {
+    if (!isDue(nowMs, snapshot)) {
+        return 0;
+    }
+
+    if (!isLinkIdle(nowMs, pendingTx)) {
+        if (!_deferring) {
+            _deferring = true;
+            _deferredCount++;
+        }
+        return 0;
+    }
+
+    size_t len = encode(snapshot, out, outSize);
+    if (len == 0) {
+        // Nothing changed: wait another interval
+        _lastPushMs = nowMs;
+        _deferring = false;
+    }
+    return len;
+}
+
+void StatusPublisher::markSent(uint32_t nowMs, const StatusSnapshot& snapshot) {
+    // Values below their push step stay at what the phone has, so slow
+    // drift still adds up to a push
+    if (!_hasSent || batteryChanged(_sent.batteryCentivolts, snapshot.batteryCentivolts)) {
+        _sent.batteryCentivolts = snapshot.batteryCentivolts;
+    }
+    if (!_hasSent || syncChanged(_sent.syncUs, snapshot.syncUs)) {
+        _sent.syncUs = snapshot.syncUs;
+    }
+    _sent.state = snapshot.state;
+    _sent.elapsedSec = snapshot.elapsedSec;
+    _sent.remainingSec = snapshot.remainingSec;
+
+    _hasSent = true;
+    _lastPushMs = nowMs;
+    _deferring = false;
+    _pushCount++;
+}
+
+// =============================================================================
+// ENCODING
+// =============================================================================
+
+size_t StatusPublisher::encode(const StatusSnapshot& snapshot, char* out, size_t outSize) const {
+    if (!out || outSize == 0) {
+        return 0;
+    }
+
+    bool full = !_hasSent;
+    bool state = full || snapshot.state != _sent.state;
+    bool elapsed = full || snapshot.elapsedSec != _sent.elapsedSec;
+    bool remaining = full || snapshot.remainingSec != _sent.remainingSec;
+    bool battery = full || batteryChanged(_sent.batteryCentivolts, snapshot.batteryCentivolts);
+    bool sync = full || syncChanged(_sent.syncUs, snapshot.syncUs);
+
+    if (!state && !elapsed && !remaining && !battery && !sync) {
+        return 0;
+    }
+
+    size_t len = 0;
+    bool ok = appendLine(out, outSize, len, "PUSH:%lu\n", (unsigned long)(_pushCount + 1));
+    if (state) {
+        ok = ok && appendLine(out, outSize, len, "SESSION_STATUS:%s\n", therapyStateToString(snapshot.state));
+    }
+    if (elapsed) {
+        ok = ok && appendLine(out, outSize, len, "ELAPSED:%lu\n", (unsigned long)snapshot.elapsedSec);
+    }
+    if (remaining) {
+        ok = ok && appendLine(out, outSize, len, "REMAINING:%lu\n", (unsigned long)snapshot.remainingSec);
+    }
+    if (battery) {
+        ok = ok && appendLine(out, outSize, len, "BATP:%u.%02u\n",
+                              snapshot.batteryCentivolts / 100u, snapshot.batteryCentivolts % 100u);
+    }
+    if (sync) {
+        ok = ok && appendLine(out, outSize, len, "SYNC_US:%ld\n", (long)snapshot.syncUs);
+    }
+    return ok ? len : 0;
+}
@@ -230,53 +230,34 @@ bool SyncCommand::deserialize(const char* message) {
     // Clear current data
     clearData();
 
-    // Make a copy for parsing
-    char buffer[MESSAGE_BUFFER_SIZE];
-    strncpy(buffer, message, sizeof(buffer) - 1);
-    buffer[sizeof(buffer) - 1] = '\0';
-
-    // New format: COMMAND:seq|timestamp|param|param|...
-    // Find the colon that separates command type from parameters
-    char* colonPos = strchr(buffer, ':');
-    if (!colonPos) {
+    // Index the message once, then copy the fields this command owns
+    SyncCommandView view;
+    if (!view.parse(message)) {
         return false;
     }
+    return deserialize(view);
+}
 
-    // Null-terminate command type and parse it
-    *colonPos = '\0';
-    if (!parseCommandType(buffer)) {
-        return false;
-    }
-
-    // Everything after the colon is pipe-delimited: seq|timestamp|data...
-    char* params = colonPos + 1;
-    if (!params || *params == '\0') {
-        return false;  // Need at least seq|timestamp
-    }
-
-    // Parse sequence ID (first pipe-delimited token)
-    char* token = strtok(params, "|");
-    if (!token) {
-        return false;
-    }
-    _sequenceId = strtoul(token, nullptr, 10);
-
-    // Parse timestamp (second pipe-delimited token)
-    token = strtok(nullptr, "|");
-    if (!token) {
+bool SyncCommand::deserialize(const SyncCommandView& view) {
+    if (!view.isValid()) {
         return false;
     }
-    _timestamp = strtoull(token, nullptr, 10);
 
-    // Parse remaining pipe-delimited data parameters
-    uint8_t index = 0;
-    char indexKey[4];
-    token = strtok(nullptr, "|");
-    while (token && _dataCount < SYNC_MAX_DATA_PAIRS) {
-        snprintf(indexKey, sizeof(indexKey), "%d", index);
-        setData(indexKey, token);
-        index++;
-        token = strtok(nullptr, "|");
+    clearData();
+    _type = view.getType();
+    _sequenceId = view.getSequenceId();
+    _timestamp = view.getTimestamp();
+
+    // Positional keys "0".."7" (SYNC_MAX_DATA_PAIRS <= 10 keeps them single-digit)
+    char indexKey[2] = {'0', '\0'};
+    char value[SYNC_MAX_VALUE_LEN];
+    for (uint8_t i = 0; i < view.getDataCount(); i++) {
+        std::string_view field = view.getData(i);
+        size_t copyLen = field.size() < sizeof(value) - 1 ? field.size() : sizeof(value) - 1;
+        memcpy(value, field.data(), copyLen);
+        value[copyLen] = '\0';
+        indexKey[0] = static_cast<char>('0' + i);
+        setData(indexKey, value);
     }
 
     return true;
@@ -480,6 +461,36 @@ SyncCommand SyncCommand::createPongWithTimestamps(uint32_t sequenceId, uint64_t
     return cmd;
 }
 
+bool SyncCommand::serializePongForTxStamp(char* buffer, size_t bufferSize, uint32_t sequenceId,
+                                          uint64_t t2, uint16_t& stampOffset) {
+    if (!buffer) {
+        return false;
+    }
+
+    // PRIMARY ignores the timestamp field of a PONG (T2/T3 travel in the data fields)
+    int prefix = snprintf(buffer, bufferSize, "PONG:%lu|0|%lu|%lu|",
+                          (unsigned long)sequenceId,
+                          (unsigned long)(t2 >> 32),
+                          (unsigned long)(t2 & 0xFFFFFFFF));
+    if (prefix < 0 || (size_t)prefix + SYNC_TX_STAMP_LEN >= bufferSize) {
+        return false;
+    }
+
+    stampOffset = static_cast<uint16_t>(prefix);
+    stampTxTime(buffer, stampOffset, 0);
+    buffer[prefix + SYNC_TX_STAMP_LEN] = '\0';
+    return true;
+}
+
+void SyncCommand::stampTxTime(char* buffer, uint16_t stampOffset, uint64_t txUs) {
+    // Same width for every value, so the message length never changes in the TX queue
+    char stamp[SYNC_TX_STAMP_LEN + 1];
+    snprintf(stamp, sizeof(stamp), "%010lu|%010lu",
+             (unsigned long)(txUs >> 32),
+             (unsigned long)(txUs & 0xFFFFFFFF));
+    memcpy(buffer + stampOffset, stamp, SYNC_TX_STAMP_LEN);
+}
+
 SyncCommand SyncCommand::createDebugFlash(uint32_t sequenceId) {
     return SyncCommand(SyncCommandType::DEBUG_FLASH, sequenceId);
 }
@@ -505,58 +516,260 @@ SyncCommand SyncCommand::createMacrocycleAck(uint32_t sequenceId) {
     return SyncCommand(SyncCommandType::MACROCYCLE_ACK, sequenceId);
 }
 
+// =============================================================================
+// SYNC COMMAND VIEW - ZERO-COPY PARSE
+// =============================================================================
+
+/**
+ * @brief Decode a decimal field with strtoul()-compatible semantics
+ *
+ * Skips leading spaces, accepts an optional sign, stops at the first
+ * non-digit. Returns the magnitude; caller applies the sign. A magnitude
+ * above maxMagnitude sets overflow and saturates, as strtoul() does at
+ * ULONG_MAX.
+ */
+static uint64_t decodeDecimalField(std::string_view field, uint64_t maxMagnitude,
+                                   bool& negative, bool& overflow) {
+    size_t i = 0;
+    negative = false;
+    overflow = false;
+
+    while (i < field.size() && (field[i] == ' ' || field[i] == '\t')) {
+        i++;
+    }
+    if (i < field.size() && (field[i] == '+' || field[i] == '-')) {
+        negative = (field[i] == '-');
+        i++;
+    }
+
+    uint64_t value = 0;
+    for (; i < field.size(); i++) {
+        char c = field[i];
+        if (c < '0' || c > '9') {
+            break;
+        }
+        uint64_t digit = static_cast<uint64_t>(c - '0');
+        if (value > (maxMagnitude - digit) / 10) {
+            overflow = true;
+            return maxMagnitude;
+        }
+        value = value * 10 + digit;
+    }
+    return value;
+}
+
+/**
+ * @brief strtoul() for a field of maxValue's width: saturates on overflow,
+ * negates modulo the width for a leading '-'
+ */
+static uint64_t decodeUnsignedField(std::string_view field, uint64_t maxValue) {
+    bool negative;
+    bool overflow;
+    uint64_t value = decodeDecimalField(field, maxValue, negative, overflow);
+    if (overflow) {
+        return maxValue;
+    }
+    return negative ? ((0 - value) & maxValue) : value;
+}
+
+SyncCommandView::SyncCommandView() :
+    _message(nullptr),
+    _type(SyncCommandType::PING),
+    _fieldCount(0)
+{
+}
+
+bool SyncCommandView::parse(const char* message) {
+    _message = nullptr;
+    _fieldCount = 0;
+
+    if (!message) {
+        return false;
+    }
+
+    size_t len = strlen(message);
+    if (len < 3) {
+        return false;
+    }
+
+    // COMMAND:seq|timestamp|param|param|...
+    const char* colonPos = static_cast<const char*>(memchr(message, ':', len));
+    if (!colonPos) {
+        return false;
+    }
+
+    // Match command type against the prefix without NUL-terminating it
+    size_t typeLen = static_cast<size_t>(colonPos - message);
+    bool typeFound = false;
+    for (size_t i = 0; i < COMMAND_MAPPINGS_COUNT; i++) {
+        const char* str = COMMAND_MAPPINGS[i].str;
+        if (strncmp(message, str, typeLen) == 0 && str[typeLen] == '\0') {
+            _type = COMMAND_MAPPINGS[i].type;
+            typeFound = true;
+            break;
+        }
+    }
+    if (!typeFound) {
+        return false;
+    }
+
+    // Index pipe-delimited fields; empty tokens are skipped (strtok semantics)
+    size_t pos = typeLen + 1;
+    while (pos < len && _fieldCount < MAX_FIELDS) {
+        if (message[pos] == SYNC_DATA_DELIMITER) {
+            pos++;
+            continue;
+        }
+
+        size_t start = pos;
+        while (pos < len && message[pos] != SYNC_DATA_DELIMITER) {
+            pos++;
+        }
+
+        size_t fieldLen = pos - start;
+        _fieldStart[_fieldCount] = static_cast<uint16_t>(start);
+        _fieldLen[_fieldCount] = static_cast<uint8_t>(fieldLen > UINT8_MAX ? UINT8_MAX : fieldLen);
+        _fieldCount++;
+    }
+
+    // Need at least seq|timestamp
+    if (_fieldCount < 2) {
+        _fieldCount = 0;
+        return false;
+    }
+
+    _message = message;
+    return true;
+}
+
+std::string_view SyncCommandView::field(uint8_t index) const {
+    if (!_message || index >= _fieldCount) {
+        return std::string_view();
+    }
+    return std::string_view(_message + _fieldStart[index], _fieldLen[index]);
+}
+
+uint32_t SyncCommandView::getSequenceId() const {
+    return static_cast<uint32_t>(decodeUnsignedField(field(0), UINT32_MAX));
+}
+
+uint64_t SyncCommandView::getTimestamp() const {
+    return decodeUnsignedField(field(1), UINT64_MAX);
+}
+
+std::string_view SyncCommandView::getData(uint8_t index) const {
+    if (index >= getDataCount()) {
+        return std::string_view();
+    }
+    return field(static_cast<uint8_t>(index + 2));
+}
+
+int32_t SyncCommandView::getDataInt(uint8_t index, int32_t defaultValue) const {
+    if (!hasData(index)) {
+        return defaultValue;
+    }
+    // strtol() semantics: saturates at INT32_MIN / INT32_MAX
+    bool negative;
+    bool overflow;
+    uint64_t magnitude = decodeDecimalField(getData(index), static_cast<uint64_t>(INT32_MAX) + 1, negative, overflow);
+    if (negative) {
+        return static_cast<int32_t>(-static_cast<int64_t>(magnitude));
+    }
+    return magnitude > INT32_MAX ? INT32_MAX : static_cast<int32_t>(magnitude);
+}
+
+uint32_t SyncCommandView::getDataUnsigned(uint8_t index, uint32_t defaultValue) const {
+    if (!hasData(index)) {
+        return defaultValue;
+    }
+    return static_cast<uint32_t>(decodeUnsignedField(getData(index), UINT32_MAX));
+}
+
 // =============================================================================
 // MACROCYCLE SERIALIZATION (all-text format for BLE compatibility)
 // =============================================================================
 
-bool SyncCommand::serializeMacrocycle(char* buffer, size_t bufferSize, const Macrocycle& macrocycle) {
+bool SyncCommand::serializeMacrocycle(char* buffer, size_t bufferSize, const Macrocycle& macrocycle,
+                                      MacrocycleWireFormat format) {
     if (!buffer || bufferSize < 200) {
         return false;
     }
+    if (format != MacrocycleWireFormat::TEXT_V5 && format != MacrocycleWireFormat::TEXT_V4) {
+        return false;
+    }
+    bool v5 = (format == MacrocycleWireFormat::TEXT_V5);
 
-    // Compact format V4: MC:seq|baseMs|offHigh|offLow|dur|count|d,f,a[,fo]|...
-    // - baseMs: baseTime in MILLISECONDS (uint32, fits 49 days)
+    // Compact format V5: MU:seq|baseHigh|baseLow|offHigh|offLow|dur|count|d,f,a[,fo]|...
+    // - baseHigh/baseLow: baseTime (µs) split into two 32-bit parts, no rounding
     // - offHigh/offLow: clockOffset split into two 32-bit parts (supports any uptime diff)
+    // - d: event offset from baseTime in MICROSECONDS, so jitter survives the link
+    // Legacy format V4: MC:seq|baseMs|offHigh|offLow|dur|count|d,f,a[,fo]|...
+    // - baseMs and d in MILLISECONDS, as older SECONDARY firmware expects
     // This avoids 64-bit printf issues on ARM and keeps message short
-
-    // Convert baseTime from microseconds to milliseconds for transmission
-    uint32_t baseMs = (uint32_t)(macrocycle.baseTime / 1000);
+    uint32_t baseHigh = (uint32_t)(macrocycle.baseTime >> 32);
+    uint32_t baseLow = (uint32_t)(macrocycle.baseTime & 0xFFFFFFFF);
+    uint64_t baseMs = macrocycle.baseTime / 1000;
 
     // Split 64-bit offset into high/low 32-bit parts for ARM compatibility
     // Offset can exceed ±35 minutes when devices have different uptimes
     int32_t offHigh = (int32_t)(macrocycle.clockOffset >> 32);
     uint32_t offLow = (uint32_t)(macrocycle.clockOffset & 0xFFFFFFFF);
 
-    // Format: MC:seq|baseMs|offHigh|offLow|dur|count
-    int written = snprintf(buffer, bufferSize, "MC:%lu|%lu|%ld|%lu|%u|%u",
+    int written;
+    if (v5) {
+        // Format: MU:seq|baseHigh|baseLow|offHigh|offLow|dur|count
+        written = snprintf(buffer, bufferSize, MACROCYCLE_TEXT_V5_PREFIX "%lu|%lu|%lu|%ld|%lu|%u|%u",
                            (unsigned long)macrocycle.sequenceId,
-                           (unsigned long)baseMs,
+                           (unsigned long)baseHigh,
+                           (unsigned long)baseLow,
                            (long)offHigh,
                            (unsigned long)offLow,
                            macrocycle.durationMs,
                            macrocycle.eventCount);
+    } else {
+        // Format: MC:seq|baseMs|offHigh|offLow|dur|count
+        written = snprintf(buffer, bufferSize, MACROCYCLE_TEXT_V4_PREFIX "%lu|%lu|%ld|%lu|%u|%u",
+                           (unsigned long)macrocycle.sequenceId,
+                           (unsigned long)(uint32_t)baseMs,
+                           (long)offHigh,
+                           (unsigned long)offLow,
+                           macrocycle.durationMs,
+                           macrocycle.eventCount);
+    }
 
     if (written < 0 || (size_t)written >= bufferSize) {
         return false;
     }
 
-    // Append events: |deltaTimeMs,finger,amplitude[,freqOffset]
+    // Append events: |deltaTime,finger,amplitude[,freqOffset]
     // Omit freqOffset when 0 for compression
-    for (uint8_t i = 0; i < macrocycle.eventCount && (size_t)written < bufferSize - 15; i++) {
+    for (uint8_t i = 0; i < macrocycle.eventCount; i++) {
         const MacrocycleEvent& evt = macrocycle.events[i];
+        uint32_t delta = evt.deltaTimeUs;
+        if (!v5) {
+            // Truncate the event's absolute time, not the delta, so each event
+            // lands within 1ms of its µs time without accumulating error
+            uint64_t eventMs = (macrocycle.baseTime + evt.deltaTimeUs) / 1000;
+            if (eventMs - baseMs > UINT16_MAX) {
+                return false;
+            }
+            delta = (uint32_t)(eventMs - baseMs);
+        }
         int evtWritten;
 
         if (evt.freqOffset != 0) {
             evtWritten = snprintf(buffer + written, bufferSize - written,
-                                  "|%u,%u,%u,%u",
-                                  evt.deltaTimeMs, evt.finger, evt.amplitude, evt.freqOffset);
+                                  "|%lu,%u,%u,%u",
+                                  (unsigned long)delta, evt.finger, evt.amplitude, evt.freqOffset);
         } else {
             evtWritten = snprintf(buffer + written, bufferSize - written,
-                                  "|%u,%u,%u",
-                                  evt.deltaTimeMs, evt.finger, evt.amplitude);
+                                  "|%lu,%u,%u",
+                                  (unsigned long)delta, evt.finger, evt.amplitude);
         }
 
-        if (evtWritten < 0) {
+        // An event that doesn't fit fails the message rather than silently
+        // dropping the tail of the macrocycle
+        if (evtWritten < 0 || (size_t)evtWritten >= bufferSize - written) {
             return false;
         }
         written += evtWritten;
@@ -566,9 +779,9 @@ bool SyncCommand::serializeMacrocycle(char* buffer, size_t bufferSize, const Mac
 }
 
 size_t SyncCommand::getMacrocycleSerializedSize(const Macrocycle& macrocycle) {
-    // Header: "MC:seq|baseTime|offset|dur|count" = ~50 bytes
-    // Each event: "|d,f,a" or "|d,f,a,fo" = ~10-12 bytes
-    return 50 + (macrocycle.eventCount * 12);
+    // Header: "MU:seq|baseHigh|baseLow|offHigh|offLow|dur|count" = ~50 bytes
+    // Each event: "|d,f,a" or "|d,f,a,fo" with d in µs = ~14-17 bytes
+    return 50 + (macrocycle.eventCount * 17);
 }
 
 bool SyncCommand::deserializeMacrocycle(const char* message, size_t messageLen, Macrocycle& macrocycle) {
@@ -578,16 +791,24 @@ bool SyncCommand::deserializeMacrocycle(const char* message, size_t messageLen,
         return false;
     }
 
-    // Clean format V4: MC:seq|baseMs|offHigh|offLow|dur|count|d,f,a[,fo]|...
-    // - baseMs: baseTime in milliseconds (convert to microseconds)
+    // Clean format V5: MU:seq|baseHigh|baseLow|offHigh|offLow|dur|count|d,f,a[,fo]|...
+    // - baseHigh/baseLow: baseTime (µs) split into two 32-bit parts
     // - offHigh/offLow: clockOffset split into two 32-bit parts
+    // Legacy format V4: MC:seq|baseMs|offHigh|offLow|dur|count|d,f,a[,fo]|...
+    // - baseMs and d in milliseconds (convert to microseconds)
     const char* ptr = message;
 
-    // Skip "MC:"
-    if (strncmp(ptr, "MC:", 3) != 0) {
+    // The prefix alone tells the layouts apart
+    bool v5;
+    if (strncmp(ptr, MACROCYCLE_TEXT_V5_PREFIX, MACROCYCLE_TEXT_PREFIX_LEN) == 0) {
+        v5 = true;
+    } else if (strncmp(ptr, MACROCYCLE_TEXT_V4_PREFIX, MACROCYCLE_TEXT_PREFIX_LEN) == 0) {
+        v5 = false;
+    } else {
         return false;
     }
-    ptr += 3;
+    ptr += MACROCYCLE_TEXT_PREFIX_LEN;
+    uint32_t deltaScale = v5 ? 1 : 1000;
 
     char* endptr;
 
@@ -596,11 +817,25 @@ bool SyncCommand::deserializeMacrocycle(const char* message, size_t messageLen,
     if (*endptr != '|') return false;
     ptr = endptr + 1;
 
-    // Parse baseMs and convert to microseconds
-    uint32_t baseMs = strtoul(ptr, &endptr, 10);
-    macrocycle.baseTime = (uint64_t)baseMs * 1000;  // ms → μs
-    if (*endptr != '|') return false;
-    ptr = endptr + 1;
+    if (v5) {
+        // Parse baseTime high/low 32 bits
+        uint32_t baseHigh = strtoul(ptr, &endptr, 10);
+        if (*endptr != '|') return false;
+        ptr = endptr + 1;
+
+        uint32_t baseLow = strtoul(ptr, &endptr, 10);
+        if (*endptr != '|') return false;
+        ptr = endptr + 1;
+
+        macrocycle.baseTime = ((uint64_t)baseHigh << 32) | baseLow;
+    } else {
+        // Parse baseMs and convert to microseconds
+        uint32_t baseMs = strtoul(ptr, &endptr, 10);
+        if (*endptr != '|') return false;
+        ptr = endptr + 1;
+
+        macrocycle.baseTime = (uint64_t)baseMs * 1000;
+    }
 
     // Parse clockOffset high 32 bits (signed)
     int32_t offHigh = strtol(ptr, &endptr, 10);
@@ -627,7 +862,7 @@ bool SyncCommand::deserializeMacrocycle(const char* message, size_t messageLen,
         macrocycle.eventCount = MACROCYCLE_MAX_EVENTS;
     }
 
-    // Parse events: |deltaTimeMs,finger,amplitude[,freqOffset]
+    // Parse events: |deltaTimeUs,finger,amplitude[,freqOffset]
     // freqOffset is optional (defaults to 0 if not present)
     for (uint8_t i = 0; i < macrocycle.eventCount; i++) {
         // Skip to next pipe delimiter
@@ -639,8 +874,8 @@ bool SyncCommand::deserializeMacrocycle(const char* message, size_t messageLen,
 
         MacrocycleEvent& evt = macrocycle.events[i];
 
-        // Parse deltaTimeMs
-        evt.deltaTimeMs = (uint16_t)strtoul(ptr, &endptr, 10);
+        // Parse deltaTime (µs for V5, ms for V4)
+        evt.deltaTimeUs = (uint32_t)strtoul(ptr, &endptr, 10) * deltaScale;
         if (*endptr != ',') { macrocycle.eventCount = i; break; }
         ptr = endptr + 1;
 
@@ -668,6 +903,401 @@ bool SyncCommand::deserializeMacrocycle(const char* message, size_t messageLen,
     return macrocycle.eventCount > 0;
 }
 
+// =============================================================================
+// MACROCYCLE SERIALIZATION (binary format, negotiated)
+// =============================================================================
+
+// 7-bit packing: every output byte carries 7 payload bits with bit 7 set.
+// Keeps the frame clear of NUL/EOT/CR so it travels over the existing
+// EOT-framed, NUL-terminated transport unchanged.
+
+/**
+ * @brief Streaming 7-bit packer writing directly into the output buffer
+ *
+ * Fields are bit-granular: putBits() writes the low n bits MSB-first, so
+ * small fields (finger, amplitude) don't pay for a whole byte.
+ */
+struct MacrocycleBitWriter {
+    char* out;
+    size_t pos;
+    uint32_t acc;
+    uint8_t bits;
+
+    void putBits(uint32_t v, uint8_t n) {  // n <= 24
+        acc = (acc << n) | (v & ((1u << n) - 1u));
+        bits = static_cast<uint8_t>(bits + n);
+        while (bits >= 7) {
+            bits = static_cast<uint8_t>(bits - 7);
+            out[pos++] = static_cast<char>(0x80 | ((acc >> bits) & 0x7F));
+        }
+        acc &= (1u << bits) - 1u;
+    }
+
+    void put8(uint8_t b) { putBits(b, 8); }
+    void put16(uint16_t v) { put8(static_cast<uint8_t>(v)); put8(static_cast<uint8_t>(v >> 8)); }
+    void put32(uint32_t v) { put16(static_cast<uint16_t>(v)); put16(static_cast<uint16_t>(v >> 16)); }
+    void put64(uint64_t v) { put32(static_cast<uint32_t>(v)); put32(static_cast<uint32_t>(v >> 32)); }
+
+    void flush() {
+        if (bits > 0) {
+            out[pos++] = static_cast<char>(0x80 | ((acc << (7 - bits)) & 0x7F));
+            acc = 0;
+            bits = 0;
+        }
+    }
+};
+
+/**
+ * @brief Streaming 7-bit unpacker reading directly from the receive buffer
+ *
+ * Sets ok=false on the first malformed byte; callers check once at the end.
+ */
+struct MacrocycleBitReader {
+    const uint8_t* in;
+    const uint8_t* end;
+    uint32_t acc;
+    uint8_t bits;
+    bool ok;
+
+    uint32_t getBits(uint8_t n) {  // n <= 24
+        while (bits < n) {
+            if (in >= end || (*in & 0x80) == 0) {
+                ok = false;
+                return 0;
+            }
+            acc = (acc << 7) | (*in++ & 0x7Fu);
+            bits = static_cast<uint8_t>(bits + 7);
+        }
+        bits = static_cast<uint8_t>(bits - n);
+        uint32_t v = (acc >> bits) & ((1u << n) - 1u);
+        acc &= (1u << bits) - 1u;
+        return v;
+    }
+
+    uint8_t get8() { return static_cast<uint8_t>(getBits(8)); }
+    uint16_t get16() { uint16_t lo = get8(); return static_cast<uint16_t>(lo | (get8() << 8)); }
+    uint32_t get32() { uint32_t lo = get16(); return lo | (static_cast<uint32_t>(get16()) << 16); }
+    uint64_t get64() { uint64_t lo = get32(); return lo | (static_cast<uint64_t>(get32()) << 32); }
+};
+
+static constexpr size_t packedSize(size_t rawBits) {
+    return (rawBits + 6) / 7;
+}
+
+size_t SyncCommand::getMacrocycleBinarySize(const Macrocycle& macrocycle) {
+    uint8_t count = macrocycle.eventCount > MACROCYCLE_MAX_EVENTS ? MACROCYCLE_MAX_EVENTS : macrocycle.eventCount;
+    size_t raw = MACROCYCLE_BINARY_HEADER_BITS + (size_t)count * MACROCYCLE_BINARY_EVENT_BITS;
+    return MACROCYCLE_BINARY_PREFIX_LEN + packedSize(raw);
+}
+
+bool SyncCommand::serializeMacrocycleBinary(char* buffer, size_t bufferSize, const Macrocycle& macrocycle) {
+    if (!buffer || macrocycle.eventCount > MACROCYCLE_MAX_EVENTS) {
+        return false;
+    }
+
+    size_t total = getMacrocycleBinarySize(macrocycle);
+    if (bufferSize < total + 1) {
+        return false;
+    }
+
+    // Event times travel as µs gaps from the previous event, which stay within
+    // 21 bits for any TIME_ON + jittered TIME_OFF; reject what doesn't fit
+    uint32_t prevDeltaUs = 0;
+    for (uint8_t i = 0; i < macrocycle.eventCount; i++) {
+        const MacrocycleEvent& evt = macrocycle.events[i];
+        if (evt.deltaTimeUs < prevDeltaUs || evt.deltaTimeUs - prevDeltaUs > MACROCYCLE_BINARY_MAX_GAP_US ||
+            evt.finger > MACROCYCLE_BINARY_MAX_FINGER || evt.amplitude > MACROCYCLE_BINARY_MAX_AMPLITUDE) {
+            return false;
+        }
+        prevDeltaUs = evt.deltaTimeUs;
+    }
+
+    memcpy(buffer, MACROCYCLE_BINARY_PREFIX, MACROCYCLE_BINARY_PREFIX_LEN);
+
+    // baseTime travels as 48-bit microseconds (8.9 years of uptime), unrounded
+    MacrocycleBitWriter w{buffer + MACROCYCLE_BINARY_PREFIX_LEN, 0, 0, 0};
+    w.put8(MACROCYCLE_BINARY_VERSION);
+    w.put32(macrocycle.sequenceId);
+    w.put32(static_cast<uint32_t>(macrocycle.baseTime));
+    w.put16(static_cast<uint16_t>(macrocycle.baseTime >> 32));
+    w.put64(static_cast<uint64_t>(macrocycle.clockOffset));
+    w.put16(macrocycle.durationMs);
+    w.put8(macrocycle.eventCount);
+
+    prevDeltaUs = 0;
+    for (uint8_t i = 0; i < macrocycle.eventCount; i++) {
+        const MacrocycleEvent& evt = macrocycle.events[i];
+        w.putBits(evt.deltaTimeUs - prevDeltaUs, 21);
+        w.putBits(evt.finger, 3);
+        w.putBits(evt.amplitude, 7);
+        w.put8(evt.freqOffset);
+        prevDeltaUs = evt.deltaTimeUs;
+    }
+    w.flush();
+
+    buffer[MACROCYCLE_BINARY_PREFIX_LEN + w.pos] = '\0';
+    return true;
+}
+
+bool SyncCommand::deserializeMacrocycleBinary(const char* message, size_t messageLen, Macrocycle& macrocycle) {
+    if (!message || messageLen < MACROCYCLE_BINARY_PREFIX_LEN + packedSize(MACROCYCLE_BINARY_HEADER_BITS)) {
+        return false;
+    }
+
+    if (strncmp(message, MACROCYCLE_BINARY_PREFIX, MACROCYCLE_BINARY_PREFIX_LEN) != 0) {
+        return false;
+    }
+
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(message + MACROCYCLE_BINARY_PREFIX_LEN);
+    MacrocycleBitReader r{payload, payload + (messageLen - MACROCYCLE_BINARY_PREFIX_LEN), 0, 0, true};
+
+    // Version gate: a newer PRIMARY must fall back to V5 text for this SECONDARY
+    if (r.get8() != MACROCYCLE_BINARY_VERSION || !r.ok) {
+        return false;
+    }
+
+    uint32_t sequenceId = r.get32();
+    uint64_t baseTime = r.get32();
+    baseTime |= static_cast<uint64_t>(r.get16()) << 32;
+    int64_t clockOffset = static_cast<int64_t>(r.get64());
+    uint16_t durationMs = r.get16();
+    uint8_t eventCount = r.get8();
+
+    if (!r.ok || eventCount == 0 || eventCount > MACROCYCLE_MAX_EVENTS) {
+        return false;
+    }
+
+    // Exact length check catches truncation and trailing garbage up front
+    size_t raw = MACROCYCLE_BINARY_HEADER_BITS + (size_t)eventCount * MACROCYCLE_BINARY_EVENT_BITS;
+    if (messageLen != MACROCYCLE_BINARY_PREFIX_LEN + packedSize(raw)) {
+        return false;
+    }
+
+    macrocycle.sequenceId = sequenceId;
+    macrocycle.baseTime = baseTime;
+    macrocycle.clockOffset = clockOffset;
+    macrocycle.durationMs = durationMs;
+    macrocycle.eventCount = eventCount;
+
+    uint32_t deltaUs = 0;
+    for (uint8_t i = 0; i < eventCount; i++) {
+        MacrocycleEvent& evt = macrocycle.events[i];
+        deltaUs += r.getBits(21);
+        evt.deltaTimeUs = deltaUs;
+        evt.finger = static_cast<uint8_t>(r.getBits(3));
+        evt.amplitude = static_cast<uint8_t>(r.getBits(7));
+        evt.freqOffset = r.get8();
+        evt.durationMs = durationMs;  // Use duration from header
+    }
+
+    return r.ok;
+}
+
+// =============================================================================
+// SEEDED MACROCYCLES (negotiated)
+// =============================================================================
+
+static uint32_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float floatFromBits(uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Parse unsigned fields separated by '|' (strict: all present, nothing after)
+ */
+static bool parseUnsignedFields(const char* ptr, uint32_t* fields, uint8_t count) {
+    char* endptr;
+    for (uint8_t i = 0; i < count; i++) {
+        fields[i] = strtoul(ptr, &endptr, 10);
+        if (endptr == ptr) {
+            return false;
+        }
+        char expected = (i + 1 < count) ? '|' : '\0';
+        if (*endptr != expected) {
+            return false;
+        }
+        ptr = endptr + 1;
+    }
+    return true;
+}
+
+bool SyncCommand::serializeSeededSession(char* buffer, size_t bufferSize, const SeededSession& session) {
+    if (!buffer) {
+        return false;
+    }
+    int written = snprintf(buffer, bufferSize, SEEDED_SESSION_PREFIX "%lu|%lu|%u|%lu|%lu|%lu|%u|%u|%u|%u|%u|%u|%u|%u",
+                           (unsigned long)(uint32_t)(session.seed >> 32),
+                           (unsigned long)(uint32_t)(session.seed & 0xFFFFFFFF),
+                           session.patternType,
+                           (unsigned long)floatBits(session.timeOnMs),
+                           (unsigned long)floatBits(session.timeOffMs),
+                           (unsigned long)floatBits(session.jitterPercent),
+                           session.numFingers,
+                           session.mirrorPattern ? 1 : 0,
+                           session.amplitudeMin,
+                           session.amplitudeMax,
+                           session.frequencyRandomization ? 1 : 0,
+                           session.frequencyMin,
+                           session.frequencyMax,
+                           session.coastBudget);
+    return written > 0 && (size_t)written < bufferSize;
+}
+
+bool SyncCommand::deserializeSeededSession(const char* message, SeededSession& session) {
+    if (!message || strncmp(message, SEEDED_SESSION_PREFIX, SEEDED_PREFIX_LEN) != 0) {
+        return false;
+    }
+    uint32_t f[14];
+    if (!parseUnsignedFields(message + SEEDED_PREFIX_LEN, f, 14)) {
+        return false;
+    }
+    session.seed = ((uint64_t)f[0] << 32) | f[1];
+    session.patternType = (uint8_t)f[2];
+    session.timeOnMs = floatFromBits(f[3]);
+    session.timeOffMs = floatFromBits(f[4]);
+    session.jitterPercent = floatFromBits(f[5]);
+    session.numFingers = (uint8_t)f[6];
+    session.mirrorPattern = f[7] != 0;
+    session.amplitudeMin = (uint8_t)f[8];
+    session.amplitudeMax = (uint8_t)f[9];
+    session.frequencyRandomization = f[10] != 0;
+    session.frequencyMin = (uint16_t)f[11];
+    session.frequencyMax = (uint16_t)f[12];
+    session.coastBudget = (uint8_t)f[13];
+    return session.seed != 0;
+}
+
+bool SyncCommand::serializeMacrocycleBeacon(char* buffer, size_t bufferSize,
+                                            const Macrocycle& macrocycle, uint16_t sessionTag) {
+    if (!buffer) {
+        return false;
+    }
+    // 64-bit values split into 32-bit halves (no %llu on ARM newlib-nano)
+    int written = snprintf(buffer, bufferSize, MACROCYCLE_BEACON_PREFIX "%lu|%lu|%lu|%ld|%lu|%u",
+                           (unsigned long)macrocycle.sequenceId,
+                           (unsigned long)(uint32_t)(macrocycle.baseTime >> 32),
+                           (unsigned long)(uint32_t)(macrocycle.baseTime & 0xFFFFFFFF),
+                           (long)(int32_t)(macrocycle.clockOffset >> 32),
+                           (unsigned long)(uint32_t)(macrocycle.clockOffset & 0xFFFFFFFF),
+                           sessionTag);
+    return written > 0 && (size_t)written < bufferSize;
+}
+
+bool SyncCommand::deserializeMacrocycleBeacon(const char* message, Macrocycle& macrocycle, uint16_t& sessionTag) {
+    if (!message || strncmp(message, MACROCYCLE_BEACON_PREFIX, SEEDED_PREFIX_LEN) != 0) {
+        return false;
+    }
+    const char* ptr = message + SEEDED_PREFIX_LEN;
+    char* endptr;
+
+    macrocycle.sequenceId = strtoul(ptr, &endptr, 10);
+    if (endptr == ptr || *endptr != '|') return false;
+    ptr = endptr + 1;
+
+    uint32_t baseHigh = strtoul(ptr, &endptr, 10);
+    if (endptr == ptr || *endptr != '|') return false;
+    ptr = endptr + 1;
+    uint32_t baseLow = strtoul(ptr, &endptr, 10);
+    if (endptr == ptr || *endptr != '|') return false;
+    ptr = endptr + 1;
+    macrocycle.baseTime = ((uint64_t)baseHigh << 32) | baseLow;
+
+    int32_t offHigh = strtol(ptr, &endptr, 10);
+    if (endptr == ptr || *endptr != '|') return false;
+    ptr = endptr + 1;
+    uint32_t offLow = strtoul(ptr, &endptr, 10);
+    if (endptr == ptr || *endptr != '|') return false;
+    ptr = endptr + 1;
+    macrocycle.clockOffset = ((int64_t)offHigh << 32) | static_cast<uint64_t>(offLow);
+
+    uint32_t tag = strtoul(ptr, &endptr, 10);
+    if (endptr == ptr || *endptr != '\0') return false;
+    sessionTag = (uint16_t)tag;
+    macrocycle.eventCount = 0;
+    return true;
+}
+
+// =============================================================================
+// MACROCYCLE_ACK EXECUTION FEEDBACK
+// =============================================================================
+
+bool SyncCommand::serializeMacrocycleAck(char* buffer, size_t bufferSize, uint32_t sequenceId,
+                                         const MacrocycleFeedback* feedback) {
+    if (!createMacrocycleAck(sequenceId).serialize(buffer, bufferSize)) {
+        return false;
+    }
+    if (!feedback) {
+        return true;
+    }
+
+    size_t pos = strlen(buffer);
+    int written = snprintf(buffer + pos, bufferSize - pos, "|%lu|", (unsigned long)feedback->sequenceId);
+    if (written < 0 || (size_t)written >= bufferSize - pos) {
+        return false;
+    }
+    pos += (size_t)written;
+
+    for (uint8_t i = 0; i < feedback->eventCount && i < MACROCYCLE_MAX_EVENTS; i++) {
+        if (i > 0) {
+            if (pos + 1 >= bufferSize) return false;
+            buffer[pos++] = ',';
+            buffer[pos] = '\0';
+        }
+        if (feedback->latenessUs[i] == MACROCYCLE_LATENESS_NONE) {
+            continue;
+        }
+        written = snprintf(buffer + pos, bufferSize - pos, "%d", (int)feedback->latenessUs[i]);
+        if (written < 0 || (size_t)written >= bufferSize - pos) {
+            return false;
+        }
+        pos += (size_t)written;
+    }
+    return true;
+}
+
+bool SyncCommand::deserializeMacrocycleAckFeedback(const char* message, MacrocycleFeedback& feedback) {
+    if (!message || strncmp(message, "MC_ACK:", 7) != 0) {
+        return false;
+    }
+    // Skip seq|ts
+    const char* ptr = strchr(message + 7, '|');
+    if (!ptr) return false;
+    ptr = strchr(ptr + 1, '|');
+    if (!ptr) return false;  // Plain ACK
+    ptr++;
+
+    char* endptr;
+    feedback = MacrocycleFeedback();
+    feedback.sequenceId = strtoul(ptr, &endptr, 10);
+    if (endptr == ptr || *endptr != '|') return false;
+    ptr = endptr + 1;
+
+    // Comma-separated lateness list; an empty field is an event that never started
+    uint8_t count = 0;
+    while (*ptr != '\0' || count > 0) {
+        if (count >= MACROCYCLE_MAX_EVENTS) return false;
+        if (*ptr != ',' && *ptr != '\0') {
+            long value = strtol(ptr, &endptr, 10);
+            if (endptr == ptr || value <= MACROCYCLE_LATENESS_NONE || value > INT16_MAX) return false;
+            feedback.latenessUs[count] = (int16_t)value;
+            ptr = endptr;
+        }
+        count++;
+        if (*ptr == '\0') break;
+        if (*ptr != ',') return false;
+        ptr++;
+    }
+    feedback.eventCount = count;
+    return true;
+}
+
 // =============================================================================
 // SIMPLE SYNC PROTOCOL - IMPLEMENTATION
 // =============================================================================
@@ -740,6 +1370,20 @@ int64_t SimpleSyncProtocol::calculatePTPOffset(uint64_t t1, uint64_t t2, uint64_
     return offset;
 }
 
+bool SimpleSyncProtocol::addPTPSample(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4) {
+    PtpSample sample = {t1, t2, t3, t4};
+    bool accepted = _servo.addSample(sample);
+    _lastSyncTime = millis();
+    return accepted;
+}
+
+uint32_t SimpleSyncProtocol::getOffsetConfidenceUs() const {
+    if (!_servo.isValid()) {
+        return 0;
+    }
+    return _servo.getConfidenceIntervalUs(getMicros());
+}
+
 void SimpleSyncProtocol::addOffsetSample(int64_t offset) {
     // Add sample to circular buffer
     _offsetSamples[_offsetSampleIndex] = offset;
@@ -867,6 +1511,11 @@ void SimpleSyncProtocol::updateOffsetEMA(int64_t offset) {
 }
 
 int64_t SimpleSyncProtocol::getCorrectedOffset() const {
+    // Clock servo extrapolates offset with its skew estimate
+    if (_servo.isValid()) {
+        return _servo.getOffsetAt(getMicros());
+    }
+
     if (!_clockSyncValid) {
         return 0;
     }
@@ -911,6 +1560,7 @@ void SimpleSyncProtocol::resetClockSync() {
     _lastMeasuredOffset = 0;
     _lastOffsetTime = 0;
     _driftRateUsPerMs = 0.0f;
+    _servo.reset();
 }
 
 bool SimpleSyncProtocol::addOffsetSampleWithQuality(int64_t offset, uint32_t rttUs) {
@@ -7,7 +7,9 @@
 
 #include "therapy_engine.h"
 #include "sync_protocol.h"  // For getMicros() - overflow-safe 64-bit timestamp
+#include <math.h>
 #include <span>
+#include <string.h>
 
 using namespace std::literals;
 
@@ -15,38 +17,73 @@ using namespace std::literals;
 // UTILITY FUNCTIONS
 // =============================================================================
 
-constexpr void shuffleArray(std::span<uint8_t> arr) {
-    // Fisher-Yates shuffle
+constexpr void shuffleArray(std::span<uint8_t> arr, Prng& rng) {
+    // Fisher-Yates shuffle (unbiased draws, so every permutation is equally likely)
     for (size_t i = arr.size() - 1; i > 0; i--) {
-        size_t const j = static_cast<size_t>(random(0, static_cast<long>(i + 1)));
+        size_t const j = rng.below(static_cast<uint32_t>(i + 1));
         std::swap(arr[i], arr[j]);
     }
 }
 
+/**
+ * @brief Round a profile time in milliseconds onto the integer µs timeline
+ */
+static uint32_t msToUs(float ms) {
+    return (ms > 0.0f) ? static_cast<uint32_t>(lroundf(ms * 1000.0f)) : 0;
+}
+
+/**
+ * @brief Fill each finger's TIME_OFF + jitter in whole microseconds
+ *
+ * Jitter amplitude follows the v1 formula (TIME_ON + TIME_OFF) * jitter% / 100 / 2,
+ * evaluated in fixed point with jitter% as parts per million, then drawn
+ * uniformly over [-amplitude, +amplitude] µs. With 23.5% jitter:
+ * 167000us * 235000ppm / 2000000 = 19622us.
+ */
+static void fillTimeOff(Pattern& pattern, uint32_t timeOnUs, uint32_t timeOffUs,
+                        float jitterPercent, Prng& rng) {
+    uint32_t jitterUs = 0;
+    if (jitterPercent > 0.0f) {
+        auto jitterPpm = static_cast<uint64_t>(lroundf(jitterPercent * 10000.0f));
+        jitterUs = static_cast<uint32_t>(
+            (static_cast<uint64_t>(timeOnUs) + timeOffUs) * jitterPpm / 2000000u);
+    }
+
+    for (uint8_t i = 0; i < pattern.numFingers; i++) {
+        uint32_t offTime = timeOffUs;
+        if (jitterUs > 0) {
+            int64_t jittered = static_cast<int64_t>(timeOffUs) - jitterUs + rng.below(2 * jitterUs + 1);
+            offTime = (jittered < 0) ? 0 : static_cast<uint32_t>(jittered);
+        }
+        pattern.timeOffUs[i] = offTime;
+    }
+}
+
 // =============================================================================
 // PATTERN GENERATION
 // =============================================================================
 
-Pattern generateRandomPermutation(
+void fillRandomPermutation(
+    Pattern& pattern,
     uint8_t numFingers,
-    float timeOnMs,
-    float timeOffMs,
+    uint32_t timeOnUs,
+    uint32_t timeOffUs,
     float jitterPercent,
-    bool mirrorPattern
+    bool mirrorPattern,
+    Prng& rng
 ) {
-    Pattern pattern = Pattern(numFingers);
-    pattern.numFingers = numFingers;
-    pattern.burstDurationMs = timeOnMs;
+    pattern.reset(numFingers);
+    numFingers = pattern.numFingers;
+    pattern.burstDurationUs = timeOnUs;
 
     // TIME_RELAX = 4 * (time_on + time_off) - fixed interval between pattern cycles
-    float cycleDurationMs = timeOnMs + timeOffMs;
-    pattern.interBurstIntervalMs = 4.0f * cycleDurationMs;
+    pattern.interBurstIntervalUs = 4 * (timeOnUs + timeOffUs);
 
     // Generate PRIMARY device sequence (random permutation)
     for (uint8_t i = 0; i < numFingers; i++) {
         pattern.primarySequence[i] = i;
     }
-    shuffleArray(pattern.primarySequence);
+    shuffleArray(pattern.primarySequence, rng);
 
     // Generate SECONDARY device sequence based on mirror setting
     if (mirrorPattern) {
@@ -59,44 +96,30 @@ Pattern generateRandomPermutation(
         for (uint8_t i = 0; i < numFingers; i++) {
             pattern.secondarySequence[i] = i;
         }
-        shuffleArray(pattern.secondarySequence);
+        shuffleArray(pattern.secondarySequence, rng);
     }
 
-    // Calculate jitter amount per v1 formula: (TIME_ON + TIME_OFF) * jitter% / 100 / 2
-    // With 23.5% jitter: 167ms * 0.235 / 2 = 19.6ms
-    float jitterAmount = cycleDurationMs * (jitterPercent / 100.0f) / 2.0f;
-
     // Apply jitter to TIME_OFF (67ms), NOT the inter-burst interval
     // v1 behavior: TIME_OFF_actual = TIME_OFF ± jitter (range: 47-87ms with 23.5% jitter)
-    for (uint8_t i = 0; i < numFingers; i++) {
-        float offTime = timeOffMs;
-        if (jitterPercent > 0) {
-            // Add random jitter to TIME_OFF
-            float jitter = static_cast<float>(random(-1000, 1001)) / 1000.0f * jitterAmount;
-            offTime += jitter;
-            if (offTime < 0) offTime = 0;
-        }
-        pattern.timeOffMs[i] = offTime;
-    }
-
-    return pattern;
+    fillTimeOff(pattern, timeOnUs, timeOffUs, jitterPercent, rng);
 }
 
-Pattern generateSequentialPattern(
+void fillSequentialPattern(
+    Pattern& pattern,
     uint8_t numFingers,
-    float timeOnMs,
-    float timeOffMs,
+    uint32_t timeOnUs,
+    uint32_t timeOffUs,
     float jitterPercent,
     bool mirrorPattern,
-    bool reverse
+    bool reverse,
+    Prng& rng
 ) {
-    Pattern pattern = Pattern(numFingers);
-    pattern.numFingers = numFingers;
-    pattern.burstDurationMs = timeOnMs;
+    pattern.reset(numFingers);
+    numFingers = pattern.numFingers;
+    pattern.burstDurationUs = timeOnUs;
 
     // TIME_RELAX = 4 * (time_on + time_off) - fixed interval between pattern cycles
-    float cycleDurationMs = timeOnMs + timeOffMs;
-    pattern.interBurstIntervalMs = 4.0f * cycleDurationMs;
+    pattern.interBurstIntervalUs = 4 * (timeOnUs + timeOffUs);
 
     // Generate sequential list
     for (uint8_t i = 0; i < numFingers; i++) {
@@ -120,37 +143,25 @@ Pattern generateSequentialPattern(
         }
     }
 
-    // Calculate jitter amount per v1 formula: (TIME_ON + TIME_OFF) * jitter% / 100 / 2
-    float jitterAmount = cycleDurationMs * (jitterPercent / 100.0f) / 2.0f;
-
     // Apply jitter to TIME_OFF, NOT the inter-burst interval
-    for (uint8_t i = 0; i < numFingers; i++) {
-        float offTime = timeOffMs;
-        if (jitterPercent > 0) {
-            float jitter = static_cast<float>(random(-1000, 1001)) / 1000.0f * jitterAmount;
-            offTime += jitter;
-            if (offTime < 0) offTime = 0;
-        }
-        pattern.timeOffMs[i] = offTime;
-    }
-
-    return pattern;
+    fillTimeOff(pattern, timeOnUs, timeOffUs, jitterPercent, rng);
 }
 
-Pattern generateMirroredPattern(
+void fillMirroredPattern(
+    Pattern& pattern,
     uint8_t numFingers,
-    float timeOnMs,
-    float timeOffMs,
+    uint32_t timeOnUs,
+    uint32_t timeOffUs,
     float jitterPercent,
-    bool randomize
+    bool randomize,
+    Prng& rng
 ) {
-    Pattern pattern = Pattern(numFingers);
-    pattern.numFingers = numFingers;
-    pattern.burstDurationMs = timeOnMs;
+    pattern.reset(numFingers);
+    numFingers = pattern.numFingers;
+    pattern.burstDurationUs = timeOnUs;
 
     // TIME_RELAX = 4 * (time_on + time_off) - fixed interval between pattern cycles
-    float cycleDurationMs = timeOnMs + timeOffMs;
-    pattern.interBurstIntervalMs = 4.0f * cycleDurationMs;
+    pattern.interBurstIntervalUs = 4 * (timeOnUs + timeOffUs);
 
     // Generate base sequence
     for (uint8_t i = 0; i < numFingers; i++) {
@@ -158,7 +169,7 @@ Pattern generateMirroredPattern(
     }
 
     if (randomize) {
-        shuffleArray(pattern.primarySequence);
+        shuffleArray(pattern.primarySequence, rng);
     }
 
     // Mirror to both devices (identical sequences)
@@ -166,20 +177,47 @@ Pattern generateMirroredPattern(
         pattern.secondarySequence[i] = pattern.primarySequence[i];
     }
 
-    // Calculate jitter amount per v1 formula: (TIME_ON + TIME_OFF) * jitter% / 100 / 2
-    float jitterAmount = cycleDurationMs * (jitterPercent / 100.0f) / 2.0f;
-
     // Apply jitter to TIME_OFF, NOT the inter-burst interval
-    for (uint8_t i = 0; i < numFingers; i++) {
-        float offTime = timeOffMs;
-        if (jitterPercent > 0) {
-            float jitter = static_cast<float>(random(-1000, 1001)) / 1000.0f * jitterAmount;
-            offTime += jitter;
-            if (offTime < 0) offTime = 0;
-        }
-        pattern.timeOffMs[i] = offTime;
-    }
+    fillTimeOff(pattern, timeOnUs, timeOffUs, jitterPercent, rng);
+}
 
+Pattern generateRandomPermutation(
+    Prng& rng,
+    uint8_t numFingers,
+    uint32_t timeOnUs,
+    uint32_t timeOffUs,
+    float jitterPercent,
+    bool mirrorPattern
+) {
+    Pattern pattern;
+    fillRandomPermutation(pattern, numFingers, timeOnUs, timeOffUs, jitterPercent, mirrorPattern, rng);
+    return pattern;
+}
+
+Pattern generateSequentialPattern(
+    Prng& rng,
+    uint8_t numFingers,
+    uint32_t timeOnUs,
+    uint32_t timeOffUs,
+    float jitterPercent,
+    bool mirrorPattern,
+    bool reverse
+) {
+    Pattern pattern;
+    fillSequentialPattern(pattern, numFingers, timeOnUs, timeOffUs, jitterPercent, mirrorPattern, reverse, rng);
+    return pattern;
+}
+
+Pattern generateMirroredPattern(
+    Prng& rng,
+    uint8_t numFingers,
+    uint32_t timeOnUs,
+    uint32_t timeOffUs,
+    float jitterPercent,
+    bool randomize
+) {
+    Pattern pattern;
+    fillMirroredPattern(pattern, numFingers, timeOnUs, timeOffUs, jitterPercent, randomize, rng);
     return pattern;
 }
 
@@ -196,6 +234,8 @@ TherapyEngine::TherapyEngine() :
     _patternType(PatternType::RNDP),
     _timeOnMs(100.0f),
     _timeOffMs(67.0f),
+    _timeOnUs(100000),
+    _timeOffUs(67000),
     _jitterPercent(0.0f),
     _numFingers(4),
     _mirrorPattern(false),
@@ -224,11 +264,32 @@ TherapyEngine::TherapyEngine() :
     _startSchedulingCallback(nullptr),
     _isSchedulingCompleteCallback(nullptr),
     _getLeadTimeCallback(nullptr),
+    _idleStepTimeCallback(nullptr),
     _macrocycleSequenceId(0),
+    _seededGeneration(false),
+    _rng(),
+    _randomSeed(0),
+    _randomSeedPinned(false),
+    _sessionSeed(0),
+    _seedCoastBudget(0),
+    _frontMacrocycle(0),
+    _nextMacrocycleReady(false),
+    _precomputeMacrocycles(true),
     _macrocycleEventIndex(0),
-    _macrocycleBaseTime(0)
+    _macrocycleBaseTime(0),
+    _pipelineDepth(1),
+    _inFlightHead(0),
+    _inFlightCount(0),
+    _nextMacrocycleBaseTime(0),
+    _pipelineStats(),
+    _ackHead(0),
+    _ackTail(0)
 {
-    // Initialize frequencies to default (250 Hz per v1 ACTUATOR_FREQUENCY)
+    resetFrequencies();
+}
+
+void TherapyEngine::resetFrequencies() {
+    // Default 250 Hz per v1 ACTUATOR_FREQUENCY
     for (uint8_t i = 0; i < MAX_ACTUATORS; i++) {
         _currentFrequency[i] = 250;
     }
@@ -274,10 +335,42 @@ void TherapyEngine::setGetLeadTimeCallback(GetLeadTimeCallback callback) {
     _getLeadTimeCallback = callback;
 }
 
+void TherapyEngine::setIdleStepTimeCallback(IdleStepTimeCallback callback) {
+    _idleStepTimeCallback = callback;
+}
+
+void TherapyEngine::setMacrocyclePrecompute(bool enabled) {
+    _precomputeMacrocycles = enabled;
+    _nextMacrocycleReady = false;
+}
+
+void TherapyEngine::setPipelineDepth(uint8_t depth) {
+    if (depth < 1) {
+        depth = 1;
+    } else if (depth > MACROCYCLE_PIPELINE_MAX_DEPTH) {
+        depth = MACROCYCLE_PIPELINE_MAX_DEPTH;
+    }
+    _pipelineDepth = depth;
+}
+
+bool TherapyEngine::onMacrocycleAck(uint32_t sequenceId) {
+    // Producer side of the ACK ring (BLE callback context)
+    uint8_t head = _ackHead.load(std::memory_order_relaxed);
+    uint8_t next = static_cast<uint8_t>((head + 1) & (ACK_RING_SIZE - 1));
+    if (next == _ackTail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    _ackRing[head] = sequenceId;
+    _ackHead.store(next, std::memory_order_release);
+    return true;
+}
+
 void TherapyEngine::setFrequencyRandomization(bool enabled, uint16_t minHz, uint16_t maxHz) {
     _frequencyRandomization = enabled;
     _frequencyMin = minHz;
     _frequencyMax = maxHz;
+    // A precomputed macrocycle carries the old frequencies
+    _nextMacrocycleReady = false;
 }
 
 // =============================================================================
@@ -311,6 +404,8 @@ void TherapyEngine::startSession(
     _patternType = patternType;
     _timeOnMs = timeOnMs;
     _timeOffMs = timeOffMs;
+    _timeOnUs = msToUs(timeOnMs);
+    _timeOffUs = msToUs(timeOffMs);
     _jitterPercent = jitterPercent;
     _numFingers = numFingers;
     _mirrorPattern = mirrorPattern;
@@ -327,20 +422,48 @@ void TherapyEngine::startSession(
     // Reset flow control state
     _buzzFlowState = BuzzFlowState::IDLE;
     _buzzSendTime = 0;
+    resetPipeline();
+    _pipelineStats = MacrocyclePipelineStats();
+
+    // Fresh generator seed per session unless seedRandom() pinned one (replay)
+    if (!_randomSeedPinned) {
+        uint64_t entropy = (static_cast<uint64_t>(_rng.next()) << 32) ^ getMicros();
+        _randomSeed = Prng::mix64(entropy);
+        _rng.seed(_randomSeed);
+    }
+    _randomSeedPinned = false;
+
+    // Seeded mode: the session seed is shared with SECONDARY; frequencies start
+    // from the same defaults a SECONDARY replica has
+    _sessionSeed = 0;
+    _seedCoastBudget = 0;
+    if (_seededGeneration) {
+        _sessionSeed = (_randomSeed != 0) ? _randomSeed : 1;
+        // Only a contiguous (pipelined) timeline lets SECONDARY predict the next baseTime
+        _seedCoastBudget = (_pipelineDepth > 1) ? SEEDED_MACROCYCLE_MAX_COAST : 0;
+        resetFrequencies();
+    }
 
     // Generate first pattern
     generateNextPattern();
 
+    // First lockstep macrocycle is ready before the first IDLE step
+    _nextMacrocycleReady = false;
+    precomputeNextMacrocycle();
+
     // Notify macrocycle start (first macrocycle)
     if (_macrocycleStartCallback) {
         _macrocycleStartCallback(_cyclesCompleted);
     }
 
     Serial.printf("[THERAPY] Session started: %lu sec, pattern=%d\n", durationSec, patternType);
+    Serial.printf("[THERAPY] Random seed: %08lX%08lX\n",
+                  (unsigned long)(_randomSeed >> 32), (unsigned long)(_randomSeed & 0xFFFFFFFF));
     Serial.printf("[THERAPY] Timing: ON=%.1fms, OFF=%.1fms, Jitter=%.1f%%\n",
                   timeOnMs, timeOffMs, jitterPercent);
-    Serial.printf("[THERAPY] Pattern duration: %.1fms, Relax: %.1fms\n",
-                  _currentPattern.burstDurationMs, _currentPattern.interBurstIntervalMs);
+    Serial.printf("[THERAPY] Pattern duration: %luus, Relax: %luus\n",
+                  (unsigned long)_currentPattern.burstDurationUs,
+                  (unsigned long)_currentPattern.interBurstIntervalUs);
 }
 
 void TherapyEngine::update() {
@@ -370,7 +493,11 @@ void TherapyEngine::update() {
     }
 
     // Execute macrocycle batching (MACROCYCLE-only architecture)
-    executeMacrocycleStep();
+    if (_pipelineDepth > 1) {
+        executePipelinedMacrocycleStep();
+    } else {
+        executeMacrocycleStep();
+    }
 }
 
 void TherapyEngine::pause() {
@@ -406,6 +533,10 @@ void TherapyEngine::stop() {
         _motorActive = false;
     }
 
+    // In-flight macrocycles are dropped; the caller clears the ActivationQueue
+    resetPipeline();
+    _nextMacrocycleReady = false;
+
     Serial.printf("[THERAPY] Stopped - Cycles: %lu, Activations: %lu\n",
                   _cyclesCompleted, _totalActivations);
 }
@@ -439,45 +570,24 @@ uint32_t TherapyEngine::getRemainingSeconds() const {
 void TherapyEngine::generateNextPattern() {
     switch (_patternType) {
         case PatternType::RNDP:
-            _currentPattern = generateRandomPermutation(
-                _numFingers,
-                _timeOnMs,
-                _timeOffMs,
-                _jitterPercent,
-                _mirrorPattern
-            );
+            fillRandomPermutation(_currentPattern, _numFingers, _timeOnUs, _timeOffUs,
+                                  _jitterPercent, _mirrorPattern, _rng);
             break;
 
         case PatternType::SEQUENTIAL:
-            _currentPattern = generateSequentialPattern(
-                _numFingers,
-                _timeOnMs,
-                _timeOffMs,
-                _jitterPercent,
-                _mirrorPattern,
-                false
-            );
+            fillSequentialPattern(_currentPattern, _numFingers, _timeOnUs, _timeOffUs,
+                                  _jitterPercent, _mirrorPattern, false, _rng);
             break;
 
         case PatternType::MIRRORED:
-            _currentPattern = generateMirroredPattern(
-                _numFingers,
-                _timeOnMs,
-                _timeOffMs,
-                _jitterPercent,
-                true
-            );
+            fillMirroredPattern(_currentPattern, _numFingers, _timeOnUs, _timeOffUs,
+                                _jitterPercent, true, _rng);
             break;
 
         default:
             // Default to RNDP
-            _currentPattern = generateRandomPermutation(
-                _numFingers,
-                _timeOnMs,
-                _timeOffMs,
-                _jitterPercent,
-                _mirrorPattern
-            );
+            fillRandomPermutation(_currentPattern, _numFingers, _timeOnUs, _timeOffUs,
+                                  _jitterPercent, _mirrorPattern, _rng);
             break;
     }
 
@@ -516,7 +626,7 @@ void TherapyEngine::applyFrequencyRandomization() {
     // Apply randomized frequency to each finger's motor
     for (uint8_t finger = 0; finger < _numFingers; finger++) {
         // Generate random frequency in 5 Hz steps (matching v1 behavior)
-        uint16_t freq = _frequencyMin + static_cast<uint16_t>(random(0, steps + 1) * 5);
+        uint16_t freq = _frequencyMin + static_cast<uint16_t>(_rng.below(steps + 1u) * 5);
         _currentFrequency[finger] = freq;
 
         // Apply locally if callback registered
@@ -530,34 +640,62 @@ void TherapyEngine::applyFrequencyRandomization() {
 // THERAPY ENGINE - MACROCYCLE BATCHING
 // =============================================================================
 
-Macrocycle TherapyEngine::generateMacrocycle() {
-    // Generate 3 patterns × 4 fingers = 12 events
+void TherapyEngine::generateMacrocycle(Macrocycle& mc) {
+    uint32_t sequenceId = _macrocycleSequenceId++;
+    if (_sessionSeed != 0) {
+        generateSeededMacrocycle(mc, sequenceId);
+        return;
+    }
+    mc.sequenceId = sequenceId;
+    fillMacrocycle(mc, _rng, _currentFrequency);
+}
+
+void TherapyEngine::seedRandom(uint64_t seed) {
+    _rng.seed(seed);
+    _randomSeed = seed;
+    _randomSeedPinned = true;
+}
+
+void TherapyEngine::generateSeededMacrocycle(Macrocycle& mc, uint32_t sequenceId) const {
+    // Works on a copy of the frequency table and writes no engine state, so
+    // SECONDARY may call this from both the BLE callback and the main loop
+    uint16_t frequency[MAX_ACTUATORS];
+    memcpy(frequency, _currentFrequency, sizeof(frequency));
+    Prng rng = Prng::forStream(_sessionSeed, sequenceId);
+    mc.sequenceId = sequenceId;
+    fillMacrocycle(mc, rng, frequency);
+}
+
+void TherapyEngine::fillMacrocycle(Macrocycle& mc, Prng& rng, uint16_t* frequency) const {
+    // Generate 3 patterns × 4 fingers = 12 events straight into mc.events
     // Each event has a delta time relative to baseTime
+    // Every draw goes through rng, so a seeded stream gives both gloves the same events
 
-    Macrocycle mc;
-    mc.sequenceId = _macrocycleSequenceId++;
-    mc.durationMs = (uint8_t)_timeOnMs;  // Common duration for all events (V2 format)
+    // Common ON duration for all events (V2 format), rounded to whole ms for the
+    // motor driver. The timeline itself advances by the exact TIME_ON in µs
+    uint32_t onMs = (_timeOnUs + 500) / 1000;
+    mc.durationMs = static_cast<uint16_t>(onMs > UINT16_MAX ? UINT16_MAX : onMs);
     mc.clockOffset = 0;  // Will be set by PRIMARY before sending (V2 format)
     mc.eventCount = 0;
 
-    uint16_t cumulativeTimeMs = 0;  // Running time offset from base
+    uint32_t cumulativeTimeUs = 0;  // Running time offset from base (exact, integer µs)
 
-    // Generate 3 patterns
+    // One pattern buffer, regenerated in place for each of the 3 patterns
+    Pattern pattern;
     for (uint8_t patternNum = 0; patternNum < PATTERNS_PER_MACROCYCLE; patternNum++) {
         // Generate pattern based on type
-        Pattern pattern;
         switch (_patternType) {
             case PatternType::RNDP:
-                pattern = generateRandomPermutation(_numFingers, _timeOnMs, _timeOffMs, _jitterPercent, _mirrorPattern);
+                fillRandomPermutation(pattern, _numFingers, _timeOnUs, _timeOffUs, _jitterPercent, _mirrorPattern, rng);
                 break;
             case PatternType::SEQUENTIAL:
-                pattern = generateSequentialPattern(_numFingers, _timeOnMs, _timeOffMs, _jitterPercent, _mirrorPattern, false);
+                fillSequentialPattern(pattern, _numFingers, _timeOnUs, _timeOffUs, _jitterPercent, _mirrorPattern, false, rng);
                 break;
             case PatternType::MIRRORED:
-                pattern = generateMirroredPattern(_numFingers, _timeOnMs, _timeOffMs, _jitterPercent, true);
+                fillMirroredPattern(pattern, _numFingers, _timeOnUs, _timeOffUs, _jitterPercent, true, rng);
                 break;
             default:
-                pattern = generateRandomPermutation(_numFingers, _timeOnMs, _timeOffMs, _jitterPercent, _mirrorPattern);
+                fillRandomPermutation(pattern, _numFingers, _timeOnUs, _timeOffUs, _jitterPercent, _mirrorPattern, rng);
                 break;
         }
 
@@ -566,7 +704,7 @@ Macrocycle TherapyEngine::generateMacrocycle() {
             uint16_t range = _frequencyMax - _frequencyMin;
             uint16_t steps = range / 5;
             for (uint8_t finger = 0; finger < _numFingers; finger++) {
-                _currentFrequency[finger] = _frequencyMin + static_cast<uint16_t>(random(0, steps + 1) * 5);
+                frequency[finger] = _frequencyMin + static_cast<uint16_t>(rng.below(steps + 1u) * 5);
             }
         }
 
@@ -578,33 +716,29 @@ Macrocycle TherapyEngine::generateMacrocycle() {
             uint8_t secondaryFinger = pattern.secondarySequence[fingerIdx];
             uint8_t amplitude = (_amplitudeMin == _amplitudeMax)
                 ? _amplitudeMin
-                : (uint8_t)random(_amplitudeMin, _amplitudeMax + 1);
+                : (uint8_t)rng.range(_amplitudeMin, _amplitudeMax + 1);
 
-            // Create event with both finger indices:
+            // Write the event in place with both finger indices:
             // - secondaryFinger: transmitted over BLE to SECONDARY device
             // - primaryFinger: used locally on PRIMARY device
             // In mirrored mode these are identical; in non-mirrored mode they differ
-            MacrocycleEvent evt(
-                cumulativeTimeMs,
+            mc.events[mc.eventCount++] = MacrocycleEvent(
+                cumulativeTimeUs,
                 secondaryFinger,   // For SECONDARY (BLE transmission)
                 primaryFinger,     // For PRIMARY (local scheduling)
                 amplitude,
-                (uint8_t)pattern.burstDurationMs,
-                _currentFrequency[primaryFinger]  // Use PRIMARY finger for frequency lookup
+                mc.durationMs,
+                frequency[primaryFinger]  // Use PRIMARY finger for frequency lookup
             );
 
-            mc.events[mc.eventCount++] = evt;
-
             // Advance time: TIME_ON + TIME_OFF (with jitter)
-            cumulativeTimeMs += (uint16_t)pattern.burstDurationMs;
-            cumulativeTimeMs += (uint16_t)pattern.timeOffMs[fingerIdx];
+            cumulativeTimeUs += pattern.burstDurationUs;
+            cumulativeTimeUs += pattern.timeOffUs[fingerIdx];
         }
 
         // NO extra time between patterns within a macrocycle
         // (v1 behavior: patterns are back-to-back)
     }
-
-    return mc;
 }
 
 void TherapyEngine::executeMacrocycleStep() {
@@ -614,8 +748,16 @@ void TherapyEngine::executeMacrocycleStep() {
     // State machine for macrocycle batching with FreeRTOS motor task scheduling
     switch (_buzzFlowState) {
         case BuzzFlowState::IDLE: {
-            // Generate and send a new macrocycle
-            _currentMacrocycle = generateMacrocycle();
+            // Take the macrocycle generated during the previous relax period;
+            // generate inline only when none is ready (precompute disabled)
+            bool precomputed = _nextMacrocycleReady;
+            if (precomputed) {
+                _frontMacrocycle ^= 1;
+                _nextMacrocycleReady = false;
+            } else {
+                generateMacrocycle(_macrocycleBuffers[_frontMacrocycle]);
+            }
+            Macrocycle& mc = _macrocycleBuffers[_frontMacrocycle];
             _macrocycleEventIndex = 0;
 
             // Notify macrocycle start
@@ -624,43 +766,31 @@ void TherapyEngine::executeMacrocycleStep() {
             }
 
             // Calculate lead time for scheduling using adaptive RTT-based calculation
-            // Falls back to 50ms if no callback registered
+            // Falls back to 50ms if no callback registered. Stamp baseTime right
+            // before sending so nothing above eats into the lead time
             uint32_t leadTimeUs = _getLeadTimeCallback ? _getLeadTimeCallback() : 50000;
-            _macrocycleBaseTime = nowUs + leadTimeUs;
-            _currentMacrocycle.baseTime = _macrocycleBaseTime;
-
-            // DEBUG: Log lead time calculation
-            Serial.printf("[LEADTIME] leadTime=%lu nowUs=%lu baseTime=%lu\n",
-                          (unsigned long)leadTimeUs,
-                          (unsigned long)(nowUs / 1000),
-                          (unsigned long)(_macrocycleBaseTime / 1000));
+            uint64_t stampUs = getMicros();
+            _macrocycleBaseTime = stampUs + leadTimeUs;
+            mc.baseTime = _macrocycleBaseTime;
 
             // Send macrocycle to SECONDARY
             if (_sendMacrocycleCallback) {
-                _sendMacrocycleCallback(_currentMacrocycle);
+                _sendMacrocycleCallback(mc);
             }
 
             // Schedule all PRIMARY activations locally via ActivationQueue
-            // FreeRTOS motor task handles timing with ~1ms precision
-            // Note: Use primaryFinger for local PRIMARY scheduling (finger is for SECONDARY)
-            if (_scheduleActivationCallback) {
-                for (uint8_t i = 0; i < _currentMacrocycle.eventCount; i++) {
-                    const MacrocycleEvent& evt = _currentMacrocycle.events[i];
-                    uint64_t activateTime = _macrocycleBaseTime + (evt.deltaTimeMs * 1000ULL);
-
-                    // Enqueue to ActivationQueue using PRIMARY's finger index
-                    // Motor task handles timing and frequency via FreeRTOS
-                    _scheduleActivationCallback(activateTime, evt.primaryFinger, evt.amplitude,
-                                                evt.durationMs, evt.getFrequencyHz());
-                    _totalActivations++;
-                }
+            scheduleLocalEvents(mc);
 
-                // Signal motor task that events are ready for processing
-                if (_startSchedulingCallback) {
-                    _startSchedulingCallback();
-                }
+            if (_idleStepTimeCallback) {
+                _idleStepTimeCallback(static_cast<uint32_t>(getMicros() - nowUs), precomputed);
             }
 
+            // DEBUG: Log lead time calculation (after the send, off the critical path)
+            Serial.printf("[LEADTIME] leadTime=%lu nowUs=%lu baseTime=%lu\n",
+                          (unsigned long)leadTimeUs,
+                          (unsigned long)(stampUs / 1000),
+                          (unsigned long)(_macrocycleBaseTime / 1000));
+
             // Record send time for tracking
             _buzzSendTime = now;
 
@@ -691,10 +821,11 @@ void TherapyEngine::executeMacrocycleStep() {
             break;
 
         case BuzzFlowState::WAITING_RELAX: {
-            // Wait for 2x TIME_RELAX (1336ms with default timing)
-            float doubleRelaxMs = 2.0f * 4.0f * (_timeOnMs + _timeOffMs);  // TIME_RELAX = 4 * (ON + OFF)
+            // Generate the next macrocycle while motors are idle
+            precomputeNextMacrocycle();
 
-            if ((now - _buzzSendTime) >= (uint32_t)doubleRelaxMs) {
+            // Wait for 2x TIME_RELAX (1336ms with default timing)
+            if ((now - _buzzSendTime) >= getDoubleRelaxUs() / 1000) {
                 // Double TIME_RELAX elapsed - macrocycle complete
                 _cyclesCompleted++;
 
@@ -709,3 +840,236 @@ void TherapyEngine::executeMacrocycleStep() {
         }
     }
 }
+
+// =============================================================================
+// THERAPY ENGINE - SEEDED MACROCYCLES
+// =============================================================================
+
+SeededSession TherapyEngine::getSeededSession() const {
+    SeededSession session;
+    session.seed = _sessionSeed;
+    session.patternType = static_cast<uint8_t>(_patternType);
+    session.timeOnMs = _timeOnMs;
+    session.timeOffMs = _timeOffMs;
+    session.jitterPercent = _jitterPercent;
+    session.numFingers = _numFingers;
+    session.mirrorPattern = _mirrorPattern;
+    session.amplitudeMin = _amplitudeMin;
+    session.amplitudeMax = _amplitudeMax;
+    session.frequencyRandomization = _frequencyRandomization;
+    session.frequencyMin = _frequencyMin;
+    session.frequencyMax = _frequencyMax;
+    session.coastBudget = _seedCoastBudget;
+    return session;
+}
+
+void TherapyEngine::loadSeededSession(const SeededSession& session) {
+    _sessionSeed = session.seed;
+    _patternType = static_cast<PatternType>(session.patternType);
+    _timeOnMs = session.timeOnMs;
+    _timeOffMs = session.timeOffMs;
+    _timeOnUs = msToUs(session.timeOnMs);
+    _timeOffUs = msToUs(session.timeOffMs);
+    _jitterPercent = session.jitterPercent;
+    _numFingers = (session.numFingers > PATTERN_MAX_FINGERS) ? PATTERN_MAX_FINGERS : session.numFingers;
+    _mirrorPattern = session.mirrorPattern;
+    _amplitudeMin = session.amplitudeMin;
+    _amplitudeMax = session.amplitudeMax;
+    _frequencyRandomization = session.frequencyRandomization;
+    _frequencyMin = session.frequencyMin;
+    _frequencyMax = session.frequencyMax;
+    _seedCoastBudget = session.coastBudget;
+    resetFrequencies();
+}
+
+// =============================================================================
+// THERAPY ENGINE - MACROCYCLE PIPELINING
+// =============================================================================
+
+void TherapyEngine::scheduleLocalEvents(const Macrocycle& mc) {
+    // FreeRTOS motor task handles timing with ~1ms precision
+    // Note: Use primaryFinger for local PRIMARY scheduling (finger is for SECONDARY)
+    if (!_scheduleActivationCallback) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < mc.eventCount; i++) {
+        const MacrocycleEvent& evt = mc.events[i];
+        uint64_t activateTime = mc.baseTime + evt.deltaTimeUs;
+
+        // Enqueue to ActivationQueue using PRIMARY's finger index
+        // Motor task handles timing and frequency via FreeRTOS
+        _scheduleActivationCallback(activateTime, evt.primaryFinger, evt.amplitude,
+                                    evt.durationMs, evt.getFrequencyHz());
+        _totalActivations++;
+    }
+
+    // Signal motor task that events are ready for processing
+    if (_startSchedulingCallback) {
+        _startSchedulingCallback();
+    }
+}
+
+uint32_t TherapyEngine::getDoubleRelaxUs() const {
+    // TIME_RELAX = 4 * (ON + OFF), 1336ms for 2x with default timing
+    return 2 * 4 * (_timeOnUs + _timeOffUs);
+}
+
+uint64_t TherapyEngine::getNextMacrocycleDueUs() const {
+    if (!_isRunning || _isPaused) {
+        return UINT64_MAX;
+    }
+    uint64_t nowUs = getMicros();
+
+    if (_pipelineDepth > 1) {
+        // Topped up as soon as a slot is free, i.e. when the oldest retires
+        if (_inFlightCount < _pipelineDepth) {
+            return nowUs;
+        }
+        const Macrocycle& oldest = _inFlight[_inFlightHead].macrocycle;
+        uint64_t slotEndUs = oldest.baseTime + getMacrocycleSlotUs(oldest);
+        return (slotEndUs > nowUs) ? slotEndUs : nowUs;
+    }
+
+    uint32_t relaxMs = getDoubleRelaxUs() / 1000;
+    switch (_buzzFlowState) {
+        case BuzzFlowState::ACTIVE:
+            // Relax starts once the queue drains, no earlier than now
+            return nowUs + (uint64_t)relaxMs * 1000;
+        case BuzzFlowState::WAITING_RELAX: {
+            uint32_t elapsedMs = millis() - _buzzSendTime;
+            return (elapsedMs >= relaxMs) ? nowUs : nowUs + (uint64_t)(relaxMs - elapsedMs) * 1000;
+        }
+        default:
+            return nowUs;
+    }
+}
+
+void TherapyEngine::precomputeNextMacrocycle() {
+    // Lockstep only: the pipelined path generates straight into its ring
+    if (!_precomputeMacrocycles || _nextMacrocycleReady || _pipelineDepth > 1) {
+        return;
+    }
+    generateMacrocycle(_macrocycleBuffers[_frontMacrocycle ^ 1]);
+    _nextMacrocycleReady = true;
+}
+
+void TherapyEngine::resetPipeline() {
+    _inFlightHead = 0;
+    _inFlightCount = 0;
+    _nextMacrocycleBaseTime = 0;
+    // Discard ACKs still queued from a previous session (consumer owns _ackTail)
+    _ackTail.store(_ackHead.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+void TherapyEngine::drainMacrocycleAcks() {
+    uint8_t tail = _ackTail.load(std::memory_order_relaxed);
+    while (tail != _ackHead.load(std::memory_order_acquire)) {
+        uint32_t sequenceId = _ackRing[tail];
+        tail = static_cast<uint8_t>((tail + 1) & (ACK_RING_SIZE - 1));
+        _ackTail.store(tail, std::memory_order_release);
+
+        for (uint8_t i = 0; i < _inFlightCount; i++) {
+            InFlightMacrocycle& entry = _inFlight[(_inFlightHead + i) % MACROCYCLE_PIPELINE_MAX_DEPTH];
+            if (entry.macrocycle.sequenceId == sequenceId && !entry.acked) {
+                entry.acked = true;
+                _pipelineStats.acked++;
+                break;
+            }
+        }
+    }
+}
+
+void TherapyEngine::executePipelinedMacrocycleStep() {
+    uint32_t now = millis();
+    uint64_t nowUs = getMicros();
+
+    drainMacrocycleAcks();
+
+    // 1. Retire macrocycles whose slot (events + 2x TIME_RELAX) has ended.
+    //    The slot end of one macrocycle is the baseTime of the next.
+    while (_inFlightCount > 0) {
+        const InFlightMacrocycle& oldest = _inFlight[_inFlightHead];
+        uint64_t slotEndUs = oldest.macrocycle.baseTime + getMacrocycleSlotUs(oldest.macrocycle);
+        if (nowUs < slotEndUs) {
+            break;
+        }
+
+        if (!oldest.acked) {
+            _pipelineStats.retiredUnacked++;
+            Serial.printf("[PIPELINE] seq=%lu retired without ACK (sent %u times)\n",
+                          (unsigned long)oldest.macrocycle.sequenceId, oldest.sendCount);
+        }
+
+        _inFlightHead = static_cast<uint8_t>((_inFlightHead + 1) % MACROCYCLE_PIPELINE_MAX_DEPTH);
+        _inFlightCount--;
+        _cyclesCompleted++;
+
+        if (_cycleCompleteCallback) {
+            _cycleCompleteCallback(_cyclesCompleted);
+        }
+    }
+
+    // 2. Resend macrocycles SECONDARY hasn't ACKed while they can still arrive in time
+    for (uint8_t i = 0; i < _inFlightCount; i++) {
+        InFlightMacrocycle& entry = _inFlight[(_inFlightHead + i) % MACROCYCLE_PIPELINE_MAX_DEPTH];
+        if (entry.acked || (now - entry.lastSentMs) < MACROCYCLE_ACK_TIMEOUT_MS) {
+            continue;
+        }
+        if (entry.macrocycle.baseTime <= nowUs + MACROCYCLE_RESEND_CUTOFF_US) {
+            continue;
+        }
+
+        if (_sendMacrocycleCallback) {
+            _sendMacrocycleCallback(entry.macrocycle);
+        }
+        entry.lastSentMs = now;
+        entry.sendCount++;
+        _pipelineStats.resent++;
+    }
+
+    // 3. Top up the pipeline, one macrocycle per update() to spread BLE traffic
+    if (_inFlightCount >= _pipelineDepth) {
+        return;
+    }
+
+    // Lead time only matters when the timeline (re)starts: a macrocycle that
+    // continues it is already a full slot ahead of the one before
+    uint32_t leadTimeUs = _getLeadTimeCallback ? _getLeadTimeCallback() : 50000;
+    uint64_t baseTime = _nextMacrocycleBaseTime;
+    if (baseTime == 0 || baseTime < nowUs + leadTimeUs) {
+        if (baseTime != 0) {
+            _pipelineStats.rebased++;
+            Serial.println(F("[PIPELINE] Fell behind, restarting timeline"));
+        }
+        baseTime = nowUs + leadTimeUs;
+    }
+
+    // Generate directly into the free ring slot: no Macrocycle copies
+    InFlightMacrocycle& slot = _inFlight[(_inFlightHead + _inFlightCount) % MACROCYCLE_PIPELINE_MAX_DEPTH];
+    Macrocycle& mc = slot.macrocycle;
+    generateMacrocycle(mc);
+    mc.baseTime = baseTime;
+
+    if (_macrocycleStartCallback) {
+        _macrocycleStartCallback(_cyclesCompleted);
+    }
+
+    if (_sendMacrocycleCallback) {
+        _sendMacrocycleCallback(mc);
+    }
+    scheduleLocalEvents(mc);
+
+    slot.lastSentMs = now;
+    slot.sendCount = 1;
+    slot.acked = false;
+    _inFlightCount++;
+    _pipelineStats.sent++;
+
+    _nextMacrocycleBaseTime = baseTime + getMacrocycleSlotUs(mc);
+
+    Serial.printf("[PIPELINE] seq=%lu baseTime=%lu inFlight=%u/%u\n",
+                  (unsigned long)mc.sequenceId,
+                  (unsigned long)(baseTime / 1000),
+                  _inFlightCount, _pipelineDepth);
+}
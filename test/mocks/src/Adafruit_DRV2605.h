@@ -0,0 +1,70 @@
+/**
+ * @file Adafruit_DRV2605.h
+ * @brief Mock DRV2605 haptic driver for native testing
+ *
+ * Keeps a per-instance register file and routes every register access
+ * through the mock Wire bus so transaction/byte counts are realistic.
+ */
+
+#ifndef MOCK_ADAFRUIT_DRV2605_H
+#define MOCK_ADAFRUIT_DRV2605_H
+
+#ifdef NATIVE_TEST_BUILD
+
+#include <Wire.h>
+
+#define DRV2605_ADDR 0x5A
+#define DRV2605_REG_STATUS 0x00
+#define DRV2605_REG_MODE 0x01
+#define DRV2605_MODE_REALTIME 0x05
+#define DRV2605_REG_RTPIN 0x02
+#define DRV2605_REG_LIBRARY 0x03
+#define DRV2605_REG_FEEDBACK 0x1A
+#define DRV2605_REG_CONTROL1 0x1B
+#define DRV2605_REG_CONTROL3 0x1D
+
+class Adafruit_DRV2605 {
+public:
+    uint8_t registers[256] = {0};  // Test inspection: last value written per register
+    uint32_t writeCount = 0;       // Register writes to this driver
+
+    bool begin(TwoWire* wire = &Wire) {
+        _wire = wire;
+        readRegister8(DRV2605_REG_STATUS);
+        writeRegister8(DRV2605_REG_MODE, 0x00);
+        return true;
+    }
+
+    void useLRA() {
+        writeRegister8(DRV2605_REG_FEEDBACK, readRegister8(DRV2605_REG_FEEDBACK) | 0x80);
+    }
+    void useERM() {
+        writeRegister8(DRV2605_REG_FEEDBACK, readRegister8(DRV2605_REG_FEEDBACK) & 0x7F);
+    }
+    void setMode(uint8_t mode) { writeRegister8(DRV2605_REG_MODE, mode); }
+    void setRealtimeValue(uint8_t rtp) { writeRegister8(DRV2605_REG_RTPIN, rtp); }
+
+    uint8_t readRegister8(uint8_t reg) {
+        _wire->beginTransmission(DRV2605_ADDR);
+        _wire->write(reg);
+        _wire->endTransmission();
+        _wire->requestFrom(DRV2605_ADDR, 1);
+        return registers[reg];
+    }
+
+    void writeRegister8(uint8_t reg, uint8_t val) {
+        _wire->beginTransmission(DRV2605_ADDR);
+        _wire->write(reg);
+        _wire->write(val);
+        _wire->endTransmission();
+        registers[reg] = val;
+        writeCount++;
+    }
+
+private:
+    TwoWire* _wire = &Wire;
+};
+
+#endif // NATIVE_TEST_BUILD
+
+#endif // MOCK_ADAFRUIT_DRV2605_H
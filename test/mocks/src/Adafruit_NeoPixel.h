@@ -0,0 +1,31 @@
+/**
+ * @file Adafruit_NeoPixel.h
+ * @brief Mock NeoPixel driver for native testing (no-op)
+ */
+
+#ifndef MOCK_ADAFRUIT_NEOPIXEL_H
+#define MOCK_ADAFRUIT_NEOPIXEL_H
+
+#ifdef NATIVE_TEST_BUILD
+
+#include <stdint.h>
+
+#define NEO_GRB 0x52
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoPixel {
+public:
+    Adafruit_NeoPixel(uint16_t, int16_t, uint32_t) {}
+    void begin() {}
+    void clear() {}
+    void show() {}
+    void setBrightness(uint8_t) {}
+    void setPixelColor(uint16_t, uint32_t) {}
+    static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+        return (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+    }
+};
+
+#endif // NATIVE_TEST_BUILD
+
+#endif // MOCK_ADAFRUIT_NEOPIXEL_H
@@ -14,6 +14,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
+#include <math.h>
 #include <stdarg.h>
 
 // =============================================================================
@@ -252,6 +253,14 @@ inline int digitalRead(uint8_t pin) {
     return LOW;
 }
 
+// =============================================================================
+// MATH CONSTANTS
+// =============================================================================
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+
 // =============================================================================
 // FLASH STRING HELPER
 // =============================================================================
@@ -0,0 +1,43 @@
+/**
+ * @file TCA9548A.h
+ * @brief Mock TCA9548A I2C multiplexer for native testing
+ *
+ * Every control-byte write is a real transaction on the mock Wire bus.
+ */
+
+#ifndef MOCK_TCA9548A_H
+#define MOCK_TCA9548A_H
+
+#ifdef NATIVE_TEST_BUILD
+
+#include <Wire.h>
+
+class TCA9548A {
+public:
+    explicit TCA9548A(uint8_t address = 0x70) : _address(address), _wire(&Wire), _channels(0) {}
+
+    void begin(TwoWire& wire = Wire) { _wire = &wire; }
+
+    void openChannel(uint8_t channel) { writeRegister(static_cast<uint8_t>(_channels | (1u << channel))); }
+    void closeChannel(uint8_t channel) { writeRegister(static_cast<uint8_t>(_channels & ~(1u << channel))); }
+    void closeAll() { writeRegister(0); }
+    void openAll() { writeRegister(0xFF); }
+
+    void writeRegister(uint8_t value) {
+        _wire->beginTransmission(_address);
+        _wire->write(value);
+        _wire->endTransmission();
+        _channels = value;
+    }
+
+    uint8_t readRegister() { return _channels; }
+
+private:
+    uint8_t _address;
+    TwoWire* _wire;
+    uint8_t _channels;
+};
+
+#endif // NATIVE_TEST_BUILD
+
+#endif // MOCK_TCA9548A_H
@@ -0,0 +1,53 @@
+/**
+ * @file Wire.h
+ * @brief Mock I2C bus for native testing - counts transactions and bytes
+ *
+ * Each beginTransmission()/endTransmission() pair or requestFrom() is one
+ * transaction. Byte count includes the address byte, matching what the
+ * nRF52 TWIM actually clocks onto the bus.
+ */
+
+#ifndef MOCK_WIRE_H
+#define MOCK_WIRE_H
+
+#ifdef NATIVE_TEST_BUILD
+
+#include <stdint.h>
+#include <stddef.h>
+
+class TwoWire {
+public:
+    uint32_t transactions = 0;  // Bus transactions (START ... STOP)
+    uint32_t bytes = 0;         // Bytes on the bus including address bytes
+
+    void begin() {}
+    void setClock(uint32_t) {}
+
+    void beginTransmission(uint8_t) {
+        transactions++;
+        bytes++;  // Address byte
+    }
+    size_t write(uint8_t) {
+        bytes++;
+        return 1;
+    }
+    uint8_t endTransmission(bool = true) { return 0; }
+
+    uint8_t requestFrom(uint8_t, uint8_t quantity) {
+        transactions++;
+        bytes += 1u + quantity;
+        return quantity;
+    }
+    int read() { return 0; }
+
+    void resetCounters() {
+        transactions = 0;
+        bytes = 0;
+    }
+};
+
+inline TwoWire Wire;
+
+#endif // NATIVE_TEST_BUILD
+
+#endif // MOCK_WIRE_H
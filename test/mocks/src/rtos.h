@@ -0,0 +1,42 @@
+/**
+ * @file rtos.h
+ * @brief Minimal FreeRTOS mocks for native testing (single-threaded)
+ * @note Mutexes always succeed; task notifications are no-ops
+ */
+
+#ifndef MOCK_RTOS_H
+#define MOCK_RTOS_H
+
+#ifdef NATIVE_TEST_BUILD
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef void* SemaphoreHandle_t;
+typedef void* TaskHandle_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+// Non-null sentinel so "mutex created" paths are exercised
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+    static int mockMutex;
+    return &mockMutex;
+}
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+
+inline void xTaskNotifyGive(TaskHandle_t) {}
+inline void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t*) {}
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+inline void taskYIELD() {}
+inline void portYIELD_FROM_ISR(BaseType_t) {}
+
+#endif // NATIVE_TEST_BUILD
+
+#endif // MOCK_RTOS_H
@@ -0,0 +1,265 @@
+/**
+ * @file test_activation_log.cpp
+ * @brief Unit tests for ActivationLog (per-event bilateral skew feedback)
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include "activation_log.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static ActivationLog* log_ = nullptr;
+
+void setUp(void) {
+    log_ = new ActivationLog();
+}
+
+void tearDown(void) {
+    delete log_;
+    log_ = nullptr;
+}
+
+/**
+ * @brief Macrocycle with events every 100ms starting at baseTime
+ */
+static Macrocycle makeMacrocycle(uint32_t seq, uint64_t baseTime, uint8_t events) {
+    Macrocycle mc;
+    mc.sequenceId = seq;
+    mc.baseTime = baseTime;
+    for (uint8_t i = 0; i < events; i++) {
+        mc.addEvent(i * 100000u, i % 4, i % 4, 100, 100, 250);
+    }
+    return mc;
+}
+
+// =============================================================================
+// LATENESS TESTS
+// =============================================================================
+
+void test_ActivationLog_primary_lateness(void) {
+    Macrocycle mc = makeMacrocycle(1, 1000000, 3);
+    log_->track(mc, mc.baseTime);
+
+    log_->recordActivation(1000000, 1000040);
+    log_->recordActivation(1100000, 1099990);
+    log_->recordActivation(1200000, 1200100);
+    TEST_ASSERT_EQUAL_UINT8(3, log_->drain(0));
+
+    MacrocycleFeedback fb;
+    TEST_ASSERT_TRUE(log_->takeFeedback(1200000 + ActivationLog::SETTLE_US, fb));
+    TEST_ASSERT_EQUAL_UINT32(1, fb.sequenceId);
+    TEST_ASSERT_EQUAL_UINT8(3, fb.eventCount);
+    TEST_ASSERT_EQUAL_INT16(40, fb.latenessUs[0]);
+    TEST_ASSERT_EQUAL_INT16(-10, fb.latenessUs[1]);
+    TEST_ASSERT_EQUAL_INT16(100, fb.latenessUs[2]);
+}
+
+void test_ActivationLog_secondary_converts_to_primary_clock(void) {
+    // SECONDARY clock runs 5000us ahead: local = primary + 5000
+    Macrocycle mc = makeMacrocycle(7, 2000000, 2);
+    log_->track(mc, mc.baseTime + 5000);
+
+    log_->recordActivation(2005000, 2005030);
+    log_->recordActivation(2105000, 2105000);
+    TEST_ASSERT_EQUAL_UINT8(2, log_->drain(5000));
+
+    MacrocycleFeedback fb;
+    TEST_ASSERT_TRUE(log_->takeFeedback(2105000 + ActivationLog::SETTLE_US, fb));
+    TEST_ASSERT_EQUAL_INT16(30, fb.latenessUs[0]);
+    TEST_ASSERT_EQUAL_INT16(0, fb.latenessUs[1]);
+}
+
+void test_ActivationLog_offset_error_shows_as_lateness(void) {
+    // Converting with a stale offset shifts every event by the error
+    Macrocycle mc = makeMacrocycle(3, 500000, 1);
+    log_->track(mc, mc.baseTime + 1000);
+    log_->recordActivation(501000, 501000);
+    log_->drain(1200);
+
+    MacrocycleFeedback fb;
+    TEST_ASSERT_TRUE(log_->takeFeedback(501000 + ActivationLog::SETTLE_US, fb));
+    TEST_ASSERT_EQUAL_INT16(-200, fb.latenessUs[0]);
+}
+
+void test_ActivationLog_lateness_saturates(void) {
+    Macrocycle mc = makeMacrocycle(2, 1000000, 2);
+    log_->track(mc, mc.baseTime);
+    log_->recordActivation(1000000, 1000000 + 90000);
+    log_->recordActivation(1100000, 1100000 - 90000);
+    log_->drain(0);
+
+    MacrocycleFeedback fb;
+    TEST_ASSERT_TRUE(log_->takeFeedback(2000000, fb));
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, fb.latenessUs[0]);
+    TEST_ASSERT_EQUAL_INT16(INT16_MIN + 1, fb.latenessUs[1]);
+    TEST_ASSERT_NOT_EQUAL(MACROCYCLE_LATENESS_NONE, fb.latenessUs[1]);
+}
+
+// =============================================================================
+// FEEDBACK TESTS
+// =============================================================================
+
+void test_ActivationLog_feedback_waits_for_settle(void) {
+    Macrocycle mc = makeMacrocycle(1, 1000000, 2);
+    log_->track(mc, mc.baseTime);
+
+    MacrocycleFeedback fb;
+    TEST_ASSERT_FALSE(log_->takeFeedback(1100000, fb));
+    TEST_ASSERT_FALSE(log_->takeFeedback(1100000 + ActivationLog::SETTLE_US - 1, fb));
+    TEST_ASSERT_TRUE(log_->takeFeedback(1100000 + ActivationLog::SETTLE_US, fb));
+}
+
+void test_ActivationLog_missed_events_are_none(void) {
+    Macrocycle mc = makeMacrocycle(1, 1000000, 3);
+    log_->track(mc, mc.baseTime);
+    log_->recordActivation(1100000, 1100020);
+    log_->drain(0);
+
+    MacrocycleFeedback fb;
+    TEST_ASSERT_TRUE(log_->takeFeedback(2000000, fb));
+    TEST_ASSERT_EQUAL_INT16(MACROCYCLE_LATENESS_NONE, fb.latenessUs[0]);
+    TEST_ASSERT_EQUAL_INT16(20, fb.latenessUs[1]);
+    TEST_ASSERT_EQUAL_INT16(MACROCYCLE_LATENESS_NONE, fb.latenessUs[2]);
+}
+
+void test_ActivationLog_feedback_reported_once_oldest_first(void) {
+    Macrocycle a = makeMacrocycle(10, 1000000, 1);
+    Macrocycle b = makeMacrocycle(11, 2000000, 1);
+    log_->track(b, b.baseTime);
+    log_->track(a, a.baseTime);
+
+    MacrocycleFeedback fb;
+    TEST_ASSERT_TRUE(log_->takeFeedback(3000000, fb));
+    TEST_ASSERT_EQUAL_UINT32(10, fb.sequenceId);
+    TEST_ASSERT_TRUE(log_->takeFeedback(3000000, fb));
+    TEST_ASSERT_EQUAL_UINT32(11, fb.sequenceId);
+    TEST_ASSERT_FALSE(log_->takeFeedback(3000000, fb));
+}
+
+void test_ActivationLog_retrack_is_noop(void) {
+    // Pipelined resend of a macrocycle must not wipe lateness already logged
+    Macrocycle mc = makeMacrocycle(4, 1000000, 1);
+    log_->track(mc, mc.baseTime);
+    log_->recordActivation(1000000, 1000025);
+    log_->drain(0);
+    log_->track(mc, mc.baseTime);
+
+    MacrocycleFeedback fb;
+    TEST_ASSERT_TRUE(log_->takeFeedback(2000000, fb));
+    TEST_ASSERT_EQUAL_INT16(25, fb.latenessUs[0]);
+}
+
+void test_ActivationLog_oldest_forgotten_when_full(void) {
+    for (uint32_t s = 0; s <= ActivationLog::MAX_MACROCYCLES; s++) {
+        Macrocycle mc = makeMacrocycle(s, 1000000ULL * (s + 1), 1);
+        log_->track(mc, mc.baseTime);
+    }
+
+    MacrocycleFeedback fb;
+    TEST_ASSERT_TRUE(log_->takeFeedback(100000000, fb));
+    TEST_ASSERT_EQUAL_UINT32(1, fb.sequenceId);
+}
+
+void test_ActivationLog_unmatched_activation_ignored(void) {
+    Macrocycle mc = makeMacrocycle(1, 1000000, 2);
+    log_->track(mc, mc.baseTime);
+    log_->recordActivation(1050000, 1050000);   // Not an event time
+    log_->recordActivation(500000, 500000);     // Before baseTime
+    TEST_ASSERT_EQUAL_UINT8(0, log_->drain(0));
+}
+
+// =============================================================================
+// SKEW TESTS
+// =============================================================================
+
+void test_ActivationLog_computeSkew(void) {
+    // PRIMARY log: events 40us and 10us late, event 2 missed
+    Macrocycle mc = makeMacrocycle(9, 1000000, 3);
+    log_->track(mc, mc.baseTime);
+    log_->recordActivation(1000000, 1000040);
+    log_->recordActivation(1100000, 1100010);
+    log_->drain(0);
+
+    MacrocycleFeedback secondary;
+    secondary.sequenceId = 9;
+    secondary.eventCount = 3;
+    secondary.latenessUs[0] = 100;
+    secondary.latenessUs[1] = -20;
+    secondary.latenessUs[2] = 50;
+
+    int32_t skew[MACROCYCLE_MAX_EVENTS];
+    TEST_ASSERT_EQUAL_UINT8(2, log_->computeSkew(secondary, skew));
+    TEST_ASSERT_EQUAL_INT32(60, skew[0]);
+    TEST_ASSERT_EQUAL_INT32(-30, skew[1]);
+}
+
+void test_ActivationLog_computeSkew_unknown_sequence(void) {
+    MacrocycleFeedback secondary;
+    secondary.sequenceId = 99;
+    secondary.eventCount = 1;
+    secondary.latenessUs[0] = 0;
+
+    int32_t skew[MACROCYCLE_MAX_EVENTS];
+    TEST_ASSERT_EQUAL_UINT8(0, log_->computeSkew(secondary, skew));
+}
+
+// =============================================================================
+// RING TESTS
+// =============================================================================
+
+void test_ActivationLog_ring_full_counts_drops(void) {
+    for (uint32_t i = 0; i < ActivationLog::RING_SIZE - 1; i++) {
+        TEST_ASSERT_TRUE(log_->recordActivation(i, i));
+    }
+    TEST_ASSERT_FALSE(log_->recordActivation(999, 999));
+    TEST_ASSERT_EQUAL_UINT32(1, log_->getDroppedCount());
+
+    log_->drain(0);
+    TEST_ASSERT_TRUE(log_->recordActivation(1000, 1000));
+}
+
+void test_ActivationLog_reset_clears_everything(void) {
+    Macrocycle mc = makeMacrocycle(1, 1000000, 1);
+    log_->track(mc, mc.baseTime);
+    log_->recordActivation(1000000, 1000000);
+    log_->reset();
+
+    TEST_ASSERT_EQUAL_UINT8(0, log_->drain(0));
+    MacrocycleFeedback fb;
+    TEST_ASSERT_FALSE(log_->takeFeedback(100000000, fb));
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Lateness Tests
+    RUN_TEST(test_ActivationLog_primary_lateness);
+    RUN_TEST(test_ActivationLog_secondary_converts_to_primary_clock);
+    RUN_TEST(test_ActivationLog_offset_error_shows_as_lateness);
+    RUN_TEST(test_ActivationLog_lateness_saturates);
+
+    // Feedback Tests
+    RUN_TEST(test_ActivationLog_feedback_waits_for_settle);
+    RUN_TEST(test_ActivationLog_missed_events_are_none);
+    RUN_TEST(test_ActivationLog_feedback_reported_once_oldest_first);
+    RUN_TEST(test_ActivationLog_retrack_is_noop);
+    RUN_TEST(test_ActivationLog_oldest_forgotten_when_full);
+    RUN_TEST(test_ActivationLog_unmatched_activation_ignored);
+
+    // Skew Tests
+    RUN_TEST(test_ActivationLog_computeSkew);
+    RUN_TEST(test_ActivationLog_computeSkew_unknown_sequence);
+
+    // Ring Tests
+    RUN_TEST(test_ActivationLog_ring_full_counts_drops);
+    RUN_TEST(test_ActivationLog_reset_clears_everything);
+
+    return UNITY_END();
+}
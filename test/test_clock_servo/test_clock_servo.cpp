@@ -0,0 +1,604 @@
+/**
+ * @file test_clock_servo.cpp
+ * @brief Unit tests and trace-replay harness for ClockServo (offset + skew Kalman servo)
+ *
+ * Replay harness:
+ *   - Synthetic traces with known ground truth (offset, crystal skew, BLE
+ *     connection-interval jitter, one-sided retransmission spikes) compare the
+ *     servo against the legacy median + EMA path it replaces.
+ *   - Recorded traces: build firmware with -DDEBUG_SYNC_TIMING, capture the
+ *     "[PTP] t1,t2,t3,t4" lines from the PRIMARY serial log into a file, then
+ *     run this test with CLOCK_SERVO_TRACE=<file>. Without ground truth the
+ *     harness reports one-step-ahead prediction error for both estimators.
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include "clock_servo.h"
+
+// Include source files directly for native testing
+// (excluded from build_src_filter to avoid conflicts with other tests)
+#include "../../src/sync_protocol.cpp"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+void setUp(void) {
+    mockResetTime();
+    resetMicrosOverflow();
+}
+
+void tearDown(void) {}
+
+// Deterministic LCG so synthetic traces are reproducible
+static uint32_t lcgState = 1;
+static uint32_t lcgNext() {
+    lcgState = lcgState * 1664525u + 1013904223u;
+    return lcgState;
+}
+
+// =============================================================================
+// TRACE MODEL
+// =============================================================================
+
+/**
+ * @brief Ground-truth model of two free-running clocks over a BLE link
+ */
+struct TraceModel {
+    int64_t offset0Us;          // SECONDARY - PRIMARY at PRIMARY time 0
+    float skewPpm;              // SECONDARY crystal runs fast by this much
+    uint32_t baseDelayUs;       // Minimum one-way delay
+    uint32_t connIntervalUs;    // One-way delay jitter (wait for next connection event)
+    uint32_t spikeEvery;        // Every Nth exchange one direction is retransmitted (0 = never)
+    uint32_t spikeIntervals;    // Extra connection intervals on a spike
+};
+
+static uint64_t secondaryClock(const TraceModel& m, uint64_t primaryUs) {
+    double skewed = (double)primaryUs * (double)m.skewPpm * 1e-6;
+    return (uint64_t)((int64_t)primaryUs + m.offset0Us + (int64_t)skewed);
+}
+
+static int64_t trueOffset(const TraceModel& m, uint64_t primaryUs) {
+    return (int64_t)secondaryClock(m, primaryUs) - (int64_t)primaryUs;
+}
+
+/**
+ * @brief Generate PING/PONG exchanges every periodMs starting at startUs
+ */
+static std::vector<PtpSample> synthesizeTrace(const TraceModel& m, uint32_t count,
+                                              uint32_t periodMs, uint64_t startUs) {
+    std::vector<PtpSample> trace;
+    trace.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t pingUs = startUs + (uint64_t)i * periodMs * 1000ULL + (lcgNext() % 2000);
+        uint64_t forward = m.baseDelayUs + (lcgNext() % m.connIntervalUs);
+        uint64_t reverse = m.baseDelayUs + (lcgNext() % m.connIntervalUs);
+        if (m.spikeEvery > 0 && (i % m.spikeEvery) == m.spikeEvery - 1) {
+            uint64_t extra = (uint64_t)m.spikeIntervals * m.connIntervalUs;
+            if (lcgNext() & 1) {
+                forward += extra;
+            } else {
+                reverse += extra;
+            }
+        }
+        uint64_t processing = 300 + (lcgNext() % 500);
+
+        PtpSample s;
+        s.t1 = pingUs;
+        s.t2 = secondaryClock(m, pingUs + forward);
+        s.t3 = secondaryClock(m, pingUs + forward + processing);
+        s.t4 = pingUs + forward + processing + reverse;
+        trace.push_back(s);
+    }
+    return trace;
+}
+
+// =============================================================================
+// REPLAY HARNESS
+// =============================================================================
+
+struct ErrorStats {
+    uint32_t count;
+    int64_t maxAbsUs;
+    int64_t p95Us;
+    double meanAbsUs;
+};
+
+static ErrorStats summarize(std::vector<int64_t>& absErrors) {
+    ErrorStats stats = {0, 0, 0, 0.0};
+    if (absErrors.empty()) {
+        return stats;
+    }
+    std::sort(absErrors.begin(), absErrors.end());
+    double sum = 0.0;
+    for (int64_t e : absErrors) {
+        sum += (double)e;
+    }
+    stats.count = (uint32_t)absErrors.size();
+    stats.maxAbsUs = absErrors.back();
+    stats.p95Us = absErrors[(absErrors.size() * 95) / 100];
+    stats.meanAbsUs = sum / (double)absErrors.size();
+    return stats;
+}
+
+/**
+ * @brief Feed one exchange the way the pre-servo PONG handler did
+ *
+ * Median of quality-filtered samples until valid, then slow EMA + EMA drift.
+ */
+static void legacyFeed(SimpleSyncProtocol& sync, const PtpSample& s) {
+    mockSetMicros((uint32_t)s.t4);
+    int64_t offset = sync.calculatePTPOffset(s.t1, s.t2, s.t3, s.t4);
+    if (sync.isClockSyncValid()) {
+        sync.updateOffsetEMA(offset);
+    } else {
+        sync.addOffsetSampleWithQuality(offset, (uint32_t)s.pathDelay());
+    }
+}
+
+static int64_t legacyPredict(const SimpleSyncProtocol& sync, uint64_t primaryUs) {
+    mockSetMicros((uint32_t)primaryUs);
+    return sync.getCorrectedOffset();
+}
+
+/**
+ * @brief Replay with ground truth, evaluating each estimator evalDelayMs after every PONG
+ */
+static void replayAgainstTruth(const TraceModel& m, const std::vector<PtpSample>& trace,
+                               uint32_t evalDelayMs, ErrorStats& legacy, ErrorStats& servo) {
+    SimpleSyncProtocol sync;
+    ClockServo kalman;
+    std::vector<int64_t> legacyErrors;
+    std::vector<int64_t> servoErrors;
+
+    for (const PtpSample& s : trace) {
+        legacyFeed(sync, s);
+        kalman.addSample(s);
+
+        uint64_t evalUs = s.t4 + evalDelayMs * 1000ULL;
+        int64_t truth = trueOffset(m, evalUs);
+        if (sync.isClockSyncValid()) {
+            legacyErrors.push_back(llabs(legacyPredict(sync, evalUs) - truth));
+        }
+        if (kalman.isValid()) {
+            servoErrors.push_back(llabs(kalman.getOffsetAt(evalUs) - truth));
+        }
+    }
+
+    legacy = summarize(legacyErrors);
+    servo = summarize(servoErrors);
+}
+
+/**
+ * @brief Replay without ground truth: one-step-ahead prediction error
+ *
+ * Before each sample is fed, both estimators predict its offset; the error
+ * against the (noisy) measured offset is recorded for the low-delay samples
+ * only, where the measurement itself is trustworthy.
+ */
+static void replayOneStepAhead(const std::vector<PtpSample>& trace,
+                               ErrorStats& legacy, ErrorStats& servo, ClockServo& kalman) {
+    SimpleSyncProtocol sync;
+    std::vector<int64_t> legacyErrors;
+    std::vector<int64_t> servoErrors;
+
+    for (const PtpSample& s : trace) {
+        bool trusted = kalman.isValid() &&
+                       (s.pathDelay() <= kalman.getMinPathDelayUs() + 2 * ClockServo::MIN_DELAY_DECAY_US + 8000);
+        if (trusted && sync.isClockSyncValid()) {
+            legacyErrors.push_back(llabs(legacyPredict(sync, s.midpoint()) - s.offset()));
+            servoErrors.push_back(llabs(kalman.getOffsetAt(s.midpoint()) - s.offset()));
+        }
+        legacyFeed(sync, s);
+        kalman.addSample(s);
+    }
+
+    legacy = summarize(legacyErrors);
+    servo = summarize(servoErrors);
+}
+
+/**
+ * @brief Parse "t1,t2,t3,t4" with an optional "[PTP] " serial-log prefix
+ */
+static bool parseTraceLine(const char* line, PtpSample& out) {
+    const char* p = strstr(line, "[PTP]");
+    p = p ? p + 5 : line;
+    unsigned long long t1, t2, t3, t4;
+    if (sscanf(p, " %llu,%llu,%llu,%llu", &t1, &t2, &t3, &t4) != 4) {
+        return false;
+    }
+    out.t1 = t1;
+    out.t2 = t2;
+    out.t3 = t3;
+    out.t4 = t4;
+    return true;
+}
+
+static bool loadTraceFile(const char* path, std::vector<PtpSample>& trace) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    char line[256];
+    PtpSample s;
+    while (fgets(line, sizeof(line), f)) {
+        if (parseTraceLine(line, s)) {
+            trace.push_back(s);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+static void printComparison(const char* name, const ErrorStats& legacy, const ErrorStats& servo) {
+    printf("[SIM] %s: legacy max=%lldus p95=%lldus mean=%.0fus | servo max=%lldus p95=%lldus mean=%.0fus\n",
+           name,
+           (long long)legacy.maxAbsUs, (long long)legacy.p95Us, legacy.meanAbsUs,
+           (long long)servo.maxAbsUs, (long long)servo.p95Us, servo.meanAbsUs);
+}
+
+// =============================================================================
+// PTP SAMPLE TESTS
+// =============================================================================
+
+void test_PtpSample_offset_and_delay(void) {
+    // SECONDARY 1000us ahead, 5000us each way, 300us processing
+    PtpSample s = {100000, 106000, 106300, 110300};
+
+    TEST_ASSERT_EQUAL_INT64(1000, s.offset());
+    TEST_ASSERT_EQUAL_INT64(10000, s.pathDelay());
+    TEST_ASSERT_EQUAL_UINT64(105150, s.midpoint());
+}
+
+// =============================================================================
+// CLOCK SERVO TESTS
+// =============================================================================
+
+void test_ClockServo_initial_state(void) {
+    ClockServo servo;
+
+    TEST_ASSERT_FALSE(servo.isValid());
+    TEST_ASSERT_EQUAL_INT64(0, servo.getOffsetAt(1000000));
+    TEST_ASSERT_EQUAL_UINT32(0, servo.getConfidenceIntervalUs(1000000));
+}
+
+void test_ClockServo_seeds_from_first_sample(void) {
+    ClockServo servo;
+    PtpSample s = {100000, 106000, 106300, 110300};
+
+    TEST_ASSERT_TRUE(servo.addSample(s));
+    TEST_ASSERT_EQUAL_INT64(1000, servo.getOffsetAt(s.midpoint()));
+    TEST_ASSERT_EQUAL_UINT32(1, servo.getAcceptedCount());
+    TEST_ASSERT_FALSE(servo.isValid());
+}
+
+void test_ClockServo_valid_after_min_samples(void) {
+    ClockServo servo;
+    TraceModel m = {50000, 0.0f, 4000, 1, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, SYNC_MIN_VALID_SAMPLES, 1000, 1000000);
+
+    for (uint8_t i = 0; i < SYNC_MIN_VALID_SAMPLES - 1; i++) {
+        servo.addSample(trace[i]);
+    }
+    TEST_ASSERT_FALSE(servo.isValid());
+    servo.addSample(trace[SYNC_MIN_VALID_SAMPLES - 1]);
+    TEST_ASSERT_TRUE(servo.isValid());
+}
+
+void test_ClockServo_rejects_bad_path_delay(void) {
+    ClockServo servo;
+    PtpSample negative = {100000, 106000, 106300, 100100};   // t4 before t3-t2 allows
+    PtpSample slow = {100000, 200000, 200300, 300300};       // 200ms round trip
+
+    TEST_ASSERT_FALSE(servo.addSample(negative));
+    TEST_ASSERT_FALSE(servo.addSample(slow));
+    TEST_ASSERT_EQUAL_UINT32(2, servo.getRejectedCount());
+    TEST_ASSERT_EQUAL_UINT32(0, servo.getAcceptedCount());
+}
+
+void test_ClockServo_learns_skew(void) {
+    ClockServo servo;
+    lcgState = 7;
+    TraceModel m = {-2000000, 40.0f, 3000, 7500, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 300, 1000, 5000000);
+
+    for (const PtpSample& s : trace) {
+        servo.addSample(s);
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(3.0f, 40.0f, servo.getSkewPpm());
+    // Predict 1s past the last exchange
+    uint64_t evalUs = trace.back().t4 + 1000000;
+    TEST_ASSERT_INT64_WITHIN(400, trueOffset(m, evalUs), servo.getOffsetAt(evalUs));
+}
+
+void test_ClockServo_gates_single_outlier(void) {
+    ClockServo servo;
+    lcgState = 11;
+    TraceModel m = {10000, 0.0f, 3000, 2000, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 30, 1000, 1000000);
+    for (const PtpSample& s : trace) {
+        servo.addSample(s);
+    }
+    uint64_t evalUs = trace.back().t4;
+    int64_t before = servo.getOffsetAt(evalUs);
+
+    // Normal-looking delay but offset 20ms off (corrupted timestamp)
+    PtpSample bad = trace.back();
+    bad.t1 += 1000000;
+    bad.t4 += 1000000;
+    bad.t2 += 1000000 + 20000;
+    bad.t3 += 1000000 + 20000;
+
+    TEST_ASSERT_FALSE(servo.addSample(bad));
+    TEST_ASSERT_INT64_WITHIN(50, before, servo.getOffsetAt(evalUs));
+}
+
+void test_ClockServo_reseeds_after_step_change(void) {
+    ClockServo servo;
+    lcgState = 13;
+    TraceModel m = {10000, 0.0f, 3000, 2000, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 20, 1000, 1000000);
+    for (const PtpSample& s : trace) {
+        servo.addSample(s);
+    }
+
+    // SECONDARY clock jumps by 1 second (e.g. it rebooted)
+    TraceModel jumped = m;
+    jumped.offset0Us += 1000000;
+    std::vector<PtpSample> after = synthesizeTrace(jumped, 10, 1000, 21000000);
+    for (const PtpSample& s : after) {
+        servo.addSample(s);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1, servo.getReseedCount());
+    uint64_t evalUs = after.back().t4;
+    TEST_ASSERT_INT64_WITHIN(3000, trueOffset(jumped, evalUs), servo.getOffsetAt(evalUs));
+}
+
+void test_ClockServo_reseed_is_invalid_until_new_samples(void) {
+    ClockServo servo;
+    lcgState = 17;
+    TraceModel m = {10000, 0.0f, 3000, 2000, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 20, 1000, 1000000);
+    for (const PtpSample& s : trace) {
+        servo.addSample(s);
+    }
+    TEST_ASSERT_TRUE(servo.isValid());
+
+    TraceModel jumped = m;
+    jumped.offset0Us += 1000000;
+    std::vector<PtpSample> after = synthesizeTrace(jumped, 10, 1000, 21000000);
+    size_t i = 0;
+    while (servo.getReseedCount() == 0 && i < after.size()) {
+        servo.addSample(after[i++]);
+    }
+
+    // Forced re-seed: the old estimate's history no longer counts
+    TEST_ASSERT_EQUAL_UINT32(1, servo.getReseedCount());
+    TEST_ASSERT_FALSE(servo.isValid());
+    TEST_ASSERT_EQUAL_UINT32(1, servo.getAcceptedCount());
+
+    while (i < after.size()) {
+        servo.addSample(after[i++]);
+    }
+    TEST_ASSERT_TRUE(servo.isValid());
+}
+
+void test_ClockServo_downweights_high_delay_sample(void) {
+    ClockServo servo;
+    lcgState = 17;
+    TraceModel m = {0, 0.0f, 3000, 1000, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 30, 1000, 1000000);
+    for (const PtpSample& s : trace) {
+        servo.addSample(s);
+    }
+    uint64_t evalUs = trace.back().t4 + 1000000;
+    int64_t before = servo.getOffsetAt(evalUs);
+
+    // PONG retransmitted: reverse path 15ms longer, so measured offset is -7.5ms
+    PtpSample retrans = trace.back();
+    retrans.t1 += 1000000;
+    retrans.t2 += 1000000;
+    retrans.t3 += 1000000;
+    retrans.t4 += 1000000 + 15000;
+    TEST_ASSERT_TRUE(retrans.offset() < -7000);
+
+    servo.addSample(retrans);
+
+    // Legacy EMA would move 10% of the way (~750us); weighted update barely moves
+    TEST_ASSERT_INT64_WITHIN(100, before, servo.getOffsetAt(evalUs));
+}
+
+void test_ClockServo_confidence_grows_with_holdover(void) {
+    ClockServo servo;
+    lcgState = 19;
+    TraceModel m = {0, 20.0f, 3000, 7500, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 60, 1000, 1000000);
+    for (const PtpSample& s : trace) {
+        servo.addSample(s);
+    }
+    uint64_t lastUs = trace.back().midpoint();
+
+    uint32_t ciNow = servo.getConfidenceIntervalUs(lastUs);
+    uint32_t ciLater = servo.getConfidenceIntervalUs(lastUs + 20000000);
+
+    TEST_ASSERT_TRUE(ciNow > 0);
+    TEST_ASSERT_TRUE(ciLater > ciNow);
+}
+
+void test_ClockServo_confidence_shrinks_with_samples(void) {
+    ClockServo servo;
+    lcgState = 23;
+    TraceModel m = {0, 20.0f, 3000, 7500, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 60, 1000, 1000000);
+
+    for (uint8_t i = 0; i < SYNC_MIN_VALID_SAMPLES; i++) {
+        servo.addSample(trace[i]);
+    }
+    uint32_t ciEarly = servo.getConfidenceIntervalUs(trace[SYNC_MIN_VALID_SAMPLES - 1].midpoint());
+    for (size_t i = SYNC_MIN_VALID_SAMPLES; i < trace.size(); i++) {
+        servo.addSample(trace[i]);
+    }
+    uint32_t ciLate = servo.getConfidenceIntervalUs(trace.back().midpoint());
+
+    TEST_ASSERT_TRUE(ciLate < ciEarly);
+}
+
+void test_ClockServo_reset(void) {
+    ClockServo servo;
+    PtpSample s = {100000, 106000, 106300, 110300};
+    servo.addSample(s);
+    servo.reset();
+
+    TEST_ASSERT_EQUAL_UINT32(0, servo.getAcceptedCount());
+    TEST_ASSERT_EQUAL_INT64(0, servo.getOffsetAt(s.midpoint()));
+}
+
+// =============================================================================
+// SIMPLE SYNC PROTOCOL INTEGRATION
+// =============================================================================
+
+void test_SimpleSyncProtocol_addPTPSample_drives_corrected_offset(void) {
+    SimpleSyncProtocol sync;
+    lcgState = 29;
+    TraceModel m = {250000, 0.0f, 3000, 1000, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 10, 1000, 1000000);
+
+    for (const PtpSample& s : trace) {
+        mockSetMicros((uint32_t)s.t4);
+        sync.addPTPSample(s.t1, s.t2, s.t3, s.t4);
+    }
+
+    TEST_ASSERT_TRUE(sync.isClockSyncValid());
+    TEST_ASSERT_INT64_WITHIN(500, 250000, sync.getCorrectedOffset());
+    TEST_ASSERT_TRUE(sync.getOffsetConfidenceUs() > 0);
+    TEST_ASSERT_EQUAL_UINT32(10, sync.getClockServo().getAcceptedCount());
+}
+
+void test_SimpleSyncProtocol_resetClockSync_resets_servo(void) {
+    SimpleSyncProtocol sync;
+    lcgState = 31;
+    TraceModel m = {250000, 0.0f, 3000, 1000, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 10, 1000, 1000000);
+    for (const PtpSample& s : trace) {
+        sync.addPTPSample(s.t1, s.t2, s.t3, s.t4);
+    }
+
+    sync.resetClockSync();
+
+    TEST_ASSERT_FALSE(sync.isClockSyncValid());
+    TEST_ASSERT_EQUAL_INT64(0, sync.getCorrectedOffset());
+    TEST_ASSERT_EQUAL_UINT32(0, sync.getOffsetConfidenceUs());
+}
+
+// =============================================================================
+// TRACE REPLAY: SERVO VS LEGACY MEDIAN + EMA
+// =============================================================================
+
+void test_replay_steady_skew(void) {
+    lcgState = 101;
+    TraceModel m = {-1500000, 30.0f, 3000, 7500, 0, 0};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 1200, 1000, 5000000);
+
+    ErrorStats legacy, servo;
+    replayAgainstTruth(m, trace, 500, legacy, servo);
+    printComparison("30ppm, 7.5ms conn interval", legacy, servo);
+
+    TEST_ASSERT_TRUE(servo.count > 1000);
+    TEST_ASSERT_TRUE(servo.maxAbsUs < legacy.maxAbsUs);
+    TEST_ASSERT_TRUE(servo.p95Us < legacy.p95Us);
+}
+
+void test_replay_retransmission_spikes(void) {
+    lcgState = 103;
+    // Every 7th exchange waits 2 extra connection intervals in one direction
+    TraceModel m = {800000, -25.0f, 3000, 7500, 7, 2};
+    std::vector<PtpSample> trace = synthesizeTrace(m, 1200, 1000, 5000000);
+
+    ErrorStats legacy, servo;
+    replayAgainstTruth(m, trace, 500, legacy, servo);
+    printComparison("-25ppm + retransmission spikes", legacy, servo);
+
+    TEST_ASSERT_TRUE(servo.maxAbsUs < legacy.maxAbsUs);
+    TEST_ASSERT_TRUE(servo.p95Us < legacy.p95Us);
+    // Worst-case offset error well under the ~5ms SECONDARY spike budget
+    TEST_ASSERT_TRUE(servo.maxAbsUs < 1500);
+}
+
+void test_replay_parse_trace_lines(void) {
+    PtpSample s;
+
+    TEST_ASSERT_TRUE(parseTraceLine("[PTP] 1000,2000,2300,3300\n", s));
+    TEST_ASSERT_EQUAL_UINT64(1000, s.t1);
+    TEST_ASSERT_EQUAL_UINT64(3300, s.t4);
+    TEST_ASSERT_TRUE(parseTraceLine("12:00:01.123 -> [PTP] 0005000000,0006000000,0006000300,0005010300", s));
+    TEST_ASSERT_EQUAL_UINT64(5000000, s.t1);
+    TEST_ASSERT_TRUE(parseTraceLine("1,2,3,4", s));
+    TEST_ASSERT_FALSE(parseTraceLine("[SYNC] RTT=1234 offset_raw=5", s));
+}
+
+void test_replay_recorded_trace_file(void) {
+    const char* path = getenv("CLOCK_SERVO_TRACE");
+    if (path == nullptr) {
+        TEST_IGNORE_MESSAGE("Set CLOCK_SERVO_TRACE=<file of [PTP] t1,t2,t3,t4 lines> to replay a recorded trace");
+    }
+
+    std::vector<PtpSample> trace;
+    TEST_ASSERT_TRUE_MESSAGE(loadTraceFile(path, trace), "Cannot open CLOCK_SERVO_TRACE");
+    TEST_ASSERT_TRUE_MESSAGE(trace.size() > SYNC_MIN_VALID_SAMPLES, "Trace has too few [PTP] lines");
+
+    ClockServo servo;
+    ErrorStats legacy, kalman;
+    replayOneStepAhead(trace, legacy, kalman, servo);
+    printf("[SIM] %s: %u exchanges, %lu accepted, %lu rejected, %lu reseeds, skew=%.2fppm, ci95=%luus\n",
+           path, (unsigned)trace.size(),
+           (unsigned long)servo.getAcceptedCount(),
+           (unsigned long)servo.getRejectedCount(),
+           (unsigned long)servo.getReseedCount(),
+           servo.getSkewPpm(),
+           (unsigned long)servo.getConfidenceIntervalUs(trace.back().midpoint()));
+    printComparison("recorded trace, one-step-ahead", legacy, kalman);
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // PtpSample Tests
+    RUN_TEST(test_PtpSample_offset_and_delay);
+
+    // ClockServo Tests
+    RUN_TEST(test_ClockServo_initial_state);
+    RUN_TEST(test_ClockServo_seeds_from_first_sample);
+    RUN_TEST(test_ClockServo_valid_after_min_samples);
+    RUN_TEST(test_ClockServo_rejects_bad_path_delay);
+    RUN_TEST(test_ClockServo_learns_skew);
+    RUN_TEST(test_ClockServo_gates_single_outlier);
+    RUN_TEST(test_ClockServo_reseeds_after_step_change);
+    RUN_TEST(test_ClockServo_reseed_is_invalid_until_new_samples);
+    RUN_TEST(test_ClockServo_downweights_high_delay_sample);
+    RUN_TEST(test_ClockServo_confidence_grows_with_holdover);
+    RUN_TEST(test_ClockServo_confidence_shrinks_with_samples);
+    RUN_TEST(test_ClockServo_reset);
+
+    // SimpleSyncProtocol Integration Tests
+    RUN_TEST(test_SimpleSyncProtocol_addPTPSample_drives_corrected_offset);
+    RUN_TEST(test_SimpleSyncProtocol_resetClockSync_resets_servo);
+
+    // Trace Replay Tests
+    RUN_TEST(test_replay_steady_skew);
+    RUN_TEST(test_replay_retransmission_spikes);
+    RUN_TEST(test_replay_parse_trace_lines);
+    RUN_TEST(test_replay_recorded_trace_file);
+
+    return UNITY_END();
+}
@@ -0,0 +1,577 @@
+/**
+ * @file test_command_parser.cpp
+ * @brief Unit tests for the zero-copy command tokenizer and sorted command tables
+ *
+ * Tests:
+ * - CommandTokens parsing (same rules as the former MenuController::parseCommand)
+ * - Parameter access: views, atoi-style integers, bounded copies
+ * - Sorted table lookup and isInternalCommand() matching
+ * - Dispatch cost and peak stack depth versus the strtok + strcmp chain
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <stdio.h>
+#include <chrono>
+#include <cstring>
+#include <cctype>
+#include "command_parser.h"
+
+#ifdef __linux__
+#include <ucontext.h>
+#endif
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+// Phone commands with typical parameters (one per MenuController handler)
+static const char* const MENU_MESSAGES[] = {
+    "INFO",
+    "BATTERY",
+    "PING",
+    "PROFILE_LIST",
+    "PROFILE_LOAD:2",
+    "PROFILE_GET",
+    "PROFILE_CUSTOM:ON:100:OFF:67:JITTER:23.5:MIRROR:1",
+    "SESSION_START",
+    "SESSION_PAUSE",
+    "SESSION_RESUME",
+    "SESSION_STOP",
+    "SESSION_STATUS",
+    "SKEW_STATUS",
+    "PARAM_SET:freq:250",
+    "CALIBRATE_START",
+    "CALIBRATE_BUZZ:0:80:500",
+    "CALIBRATE_STOP",
+    "HELP",
+    "RESTART",
+    "THERAPY_LED_OFF:true",
+    "DEBUG:0",
+};
+static const size_t MENU_MESSAGE_COUNT = sizeof(MENU_MESSAGES) / sizeof(MENU_MESSAGES[0]);
+
+// Handler index per command; mirrors MenuController::handleCommand's table
+static constexpr CommandEntry<uint8_t> MENU_COMMANDS[] = {
+    {"BATTERY", 1},
+    {"CALIBRATE_BUZZ", 15},
+    {"CALIBRATE_START", 14},
+    {"CALIBRATE_STOP", 16},
+    {"DEBUG", 20},
+    {"HELP", 17},
+    {"INFO", 0},
+    {"PARAM_SET", 13},
+    {"PING", 2},
+    {"PROFILE_CUSTOM", 6},
+    {"PROFILE_GET", 5},
+    {"PROFILE_LIST", 3},
+    {"PROFILE_LOAD", 4},
+    {"RESTART", 18},
+    {"SESSION_PAUSE", 8},
+    {"SESSION_RESUME", 9},
+    {"SESSION_START", 7},
+    {"SESSION_STATUS", 11},
+    {"SESSION_STOP", 10},
+    {"SKEW_STATUS", 12},
+    {"THERAPY_LED_OFF", 19},
+};
+static_assert(commandTableSorted(MENU_COMMANDS), "MENU_COMMANDS must be sorted by name");
+
+static CommandTokens* tokens = nullptr;
+
+void setUp(void) {
+    tokens = new CommandTokens();
+}
+
+void tearDown(void) {
+    delete tokens;
+    tokens = nullptr;
+}
+
+static bool viewEquals(std::string_view view, const char* expected) {
+    return view == std::string_view(expected);
+}
+
+// =============================================================================
+// PARSE TESTS
+// =============================================================================
+
+void test_parse_null_message_returns_false(void) {
+    TEST_ASSERT_FALSE(tokens->parse(nullptr));
+    TEST_ASSERT_EQUAL(0, tokens->paramCount());
+}
+
+void test_parse_empty_message_returns_false(void) {
+    TEST_ASSERT_FALSE(tokens->parse(""));
+}
+
+void test_parse_whitespace_only_returns_false(void) {
+    TEST_ASSERT_FALSE(tokens->parse("   "));
+}
+
+void test_parse_separators_only_returns_false(void) {
+    TEST_ASSERT_FALSE(tokens->parse(":::"));
+}
+
+void test_parse_simple_command_no_params(void) {
+    TEST_ASSERT_TRUE(tokens->parse("INFO"));
+    TEST_ASSERT_TRUE(viewEquals(tokens->command(), "INFO"));
+    TEST_ASSERT_EQUAL(0, tokens->paramCount());
+}
+
+void test_parse_preserves_case(void) {
+    TEST_ASSERT_TRUE(tokens->parse("Profile_Load:2"));
+    TEST_ASSERT_TRUE(viewEquals(tokens->command(), "Profile_Load"));
+}
+
+void test_parse_multiple_params(void) {
+    TEST_ASSERT_TRUE(tokens->parse("CALIBRATE_BUZZ:0:80:500"));
+    TEST_ASSERT_TRUE(viewEquals(tokens->command(), "CALIBRATE_BUZZ"));
+    TEST_ASSERT_EQUAL(3, tokens->paramCount());
+    TEST_ASSERT_TRUE(viewEquals(tokens->param(0), "0"));
+    TEST_ASSERT_TRUE(viewEquals(tokens->param(1), "80"));
+    TEST_ASSERT_TRUE(viewEquals(tokens->param(2), "500"));
+}
+
+void test_parse_views_point_into_message(void) {
+    const char* message = "PARAM_SET:FREQ:250";
+    TEST_ASSERT_TRUE(tokens->parse(message));
+    TEST_ASSERT_EQUAL_PTR(message, tokens->command().data());
+    TEST_ASSERT_EQUAL_PTR(message + 10, tokens->param(0).data());
+}
+
+void test_parse_skips_empty_fields(void) {
+    TEST_ASSERT_TRUE(tokens->parse("PARAM_SET::FREQ:::250:"));
+    TEST_ASSERT_EQUAL(2, tokens->paramCount());
+    TEST_ASSERT_TRUE(viewEquals(tokens->param(0), "FREQ"));
+    TEST_ASSERT_TRUE(viewEquals(tokens->param(1), "250"));
+}
+
+void test_parse_strips_newline(void) {
+    TEST_ASSERT_TRUE(tokens->parse("PROFILE_LOAD:3\nIGNORED"));
+    TEST_ASSERT_EQUAL(1, tokens->paramCount());
+    TEST_ASSERT_TRUE(viewEquals(tokens->param(0), "3"));
+}
+
+void test_parse_strips_carriage_return(void) {
+    TEST_ASSERT_TRUE(tokens->parse("PING\r\n"));
+    TEST_ASSERT_TRUE(viewEquals(tokens->command(), "PING"));
+    TEST_ASSERT_EQUAL(0, tokens->paramCount());
+}
+
+void test_parse_strips_EOT(void) {
+    TEST_ASSERT_TRUE(tokens->parse("DEBUG:1\x04"));
+    TEST_ASSERT_EQUAL(1, tokens->paramCount());
+    TEST_ASSERT_TRUE(viewEquals(tokens->param(0), "1"));
+}
+
+void test_parse_trims_leading_whitespace(void) {
+    TEST_ASSERT_TRUE(tokens->parse("   HELP"));
+    TEST_ASSERT_TRUE(viewEquals(tokens->command(), "HELP"));
+}
+
+void test_parse_max_params(void) {
+    char message[128] = "CMD";
+    for (int i = 0; i < MAX_COMMAND_PARAMS + 4; i++) {
+        strcat(message, ":p");
+    }
+    TEST_ASSERT_TRUE(tokens->parse(message));
+    TEST_ASSERT_EQUAL(MAX_COMMAND_PARAMS, tokens->paramCount());
+}
+
+void test_parse_limits_message_length(void) {
+    char message[COMMAND_MESSAGE_MAX + 16];
+    memset(message, 'A', sizeof(message) - 1);
+    message[sizeof(message) - 1] = '\0';
+    message[COMMAND_MESSAGE_MAX - 2] = ':';
+    TEST_ASSERT_TRUE(tokens->parse(message));
+    TEST_ASSERT_EQUAL(1, tokens->paramCount());
+    TEST_ASSERT_EQUAL(1, tokens->param(0).size());
+}
+
+void test_parse_resets_previous_result(void) {
+    TEST_ASSERT_TRUE(tokens->parse("PARAM_SET:FREQ:250"));
+    TEST_ASSERT_FALSE(tokens->parse(""));
+    TEST_ASSERT_EQUAL(0, tokens->paramCount());
+    TEST_ASSERT_TRUE(tokens->command().empty());
+}
+
+// =============================================================================
+// PARAMETER ACCESS TESTS
+// =============================================================================
+
+void test_param_out_of_range_is_empty(void) {
+    TEST_ASSERT_TRUE(tokens->parse("PROFILE_LOAD:2"));
+    TEST_ASSERT_TRUE(tokens->param(1).empty());
+    TEST_ASSERT_TRUE(tokens->param(200).empty());
+}
+
+void test_paramInt_matches_atoi(void) {
+    const char* values[] = {"0", "42", "-7", "+15", "  12", "250Hz", "abc", "", "2147483647", "99999999999"};
+    for (const char* value : values) {
+        char message[64];
+        snprintf(message, sizeof(message), "CMD:%s:end", value);
+        TEST_ASSERT_TRUE(tokens->parse(message));
+        int32_t expected = (value[0] == '\0') ? atoi("end") : atoi(value);
+        if (strcmp(value, "99999999999") == 0) {
+            expected = INT32_MAX;  // Saturates where atoi() is undefined
+        }
+        TEST_ASSERT_EQUAL_MESSAGE(expected, tokens->paramInt(0), value);
+    }
+}
+
+void test_paramInt_default_when_missing(void) {
+    TEST_ASSERT_TRUE(tokens->parse("PROFILE_LOAD"));
+    TEST_ASSERT_EQUAL_INT32(0, tokens->paramInt(0));
+    TEST_ASSERT_EQUAL_INT32(-1, tokens->paramInt(0, -1));
+}
+
+void test_copyParam_terminates_and_truncates(void) {
+    char out[8];
+    TEST_ASSERT_TRUE(tokens->parse("PARAM_SET:FREQUENCY_HZ:250"));
+    TEST_ASSERT_TRUE(tokens->copyParam(0, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("FREQUEN", out);
+    TEST_ASSERT_TRUE(tokens->copyParam(1, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("250", out);
+}
+
+void test_copyParam_out_of_range_clears_output(void) {
+    char out[8] = "stale";
+    TEST_ASSERT_TRUE(tokens->parse("PING"));
+    TEST_ASSERT_FALSE(tokens->copyParam(0, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING("", out);
+}
+
+// =============================================================================
+// TABLE LOOKUP TESTS
+// =============================================================================
+
+void test_compareCommand_orders_like_strcmp(void) {
+    TEST_ASSERT_EQUAL(0, compareCommand("MC", "MC"));
+    TEST_ASSERT_TRUE(compareCommand("MC", "MC_ACK") < 0);
+    TEST_ASSERT_TRUE(compareCommand("MC_ACK", "MC") > 0);
+    TEST_ASSERT_TRUE(compareCommand("SESSION_STATUS", "SESSION_STOP") < 0);
+    TEST_ASSERT_EQUAL(0, compareCommand("session_stop", "SESSION_STOP", true));
+    TEST_ASSERT_TRUE(compareCommand("session_stop", "SESSION_STOP") != 0);
+}
+
+void test_commandTableSorted_detects_order(void) {
+    static constexpr CommandEntry<int> unsorted[] = {{"B", 0}, {"A", 1}};
+    static constexpr CommandEntry<int> duplicate[] = {{"A", 0}, {"A", 1}};
+    TEST_ASSERT_FALSE(commandTableSorted(unsorted));
+    TEST_ASSERT_FALSE(commandTableSorted(duplicate));
+    TEST_ASSERT_TRUE(commandTableSorted(MENU_COMMANDS));
+}
+
+void test_findCommand_finds_every_menu_command(void) {
+    for (size_t i = 0; i < MENU_MESSAGE_COUNT; i++) {
+        TEST_ASSERT_TRUE(tokens->parse(MENU_MESSAGES[i]));
+        const CommandEntry<uint8_t>* entry = findCommand(MENU_COMMANDS, tokens->command());
+        TEST_ASSERT_TRUE_MESSAGE(entry != nullptr, MENU_MESSAGES[i]);
+        TEST_ASSERT_EQUAL_MESSAGE(i, entry->value, MENU_MESSAGES[i]);
+    }
+}
+
+void test_findCommand_ignore_case(void) {
+    TEST_ASSERT_NULL(findCommand(MENU_COMMANDS, "session_start"));
+    const CommandEntry<uint8_t>* entry = findCommand(MENU_COMMANDS, "session_start", true);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL(7, entry->value);
+}
+
+void test_findCommand_unknown_and_prefix_do_not_match(void) {
+    TEST_ASSERT_NULL(findCommand(MENU_COMMANDS, "BOGUS"));
+    TEST_ASSERT_NULL(findCommand(MENU_COMMANDS, ""));
+    TEST_ASSERT_NULL(findCommand(MENU_COMMANDS, "SESSION"));
+    TEST_ASSERT_NULL(findCommand(MENU_COMMANDS, "SESSION_STOPPED"));
+}
+
+void test_findCommand_is_constexpr(void) {
+    static_assert(findCommand(MENU_COMMANDS, "HELP") != nullptr, "HELP must be found");
+    static_assert(findCommand(MENU_COMMANDS, "HELP")->value == 17, "HELP maps to handler 17");
+    TEST_PASS();
+}
+
+// =============================================================================
+// INTERNAL COMMAND TESTS
+// =============================================================================
+
+void test_isInternalCommand_exact_words(void) {
+    const char* words[] = {"PARAM_UPDATE", "SEED", "SEED_ACK", "GET_BATTERY", "BATRESPONSE",
+                           "ACK_PARAM_UPDATE", "IDENTIFY", "PING", "PONG", "MC", "MC_ACK",
+                           "MB", "MN", "MU", "SS", "CAPS", "LED_OFF_SYNC", "DEBUG_SYNC"};
+    for (const char* word : words) {
+        TEST_ASSERT_TRUE_MESSAGE(isInternalCommand(word), word);
+    }
+}
+
+void test_isInternalCommand_sync_families(void) {
+    TEST_ASSERT_TRUE(isInternalCommand("SYNC_ADJ"));
+    TEST_ASSERT_TRUE(isInternalCommand("SYNC_PROBE_ACK"));
+    TEST_ASSERT_TRUE(isInternalCommand("ACK_SYNC_ADJ"));
+    TEST_ASSERT_FALSE(isInternalCommand("SYNC"));
+}
+
+void test_isInternalCommand_menu_commands_false(void) {
+    for (size_t i = 0; i < MENU_MESSAGE_COUNT; i++) {
+        TEST_ASSERT_TRUE(tokens->parse(MENU_MESSAGES[i]));
+        if (tokens->command() == "PING") {
+            continue;  // PING is also the PRIMARY -> SECONDARY keepalive
+        }
+        TEST_ASSERT_TRUE_MESSAGE(!isInternalCommand(tokens->command()), MENU_MESSAGES[i]);
+    }
+}
+
+void test_isInternalCommand_case_sensitive_and_exact(void) {
+    TEST_ASSERT_FALSE(isInternalCommand(""));
+    TEST_ASSERT_FALSE(isInternalCommand("seed"));
+    TEST_ASSERT_FALSE(isInternalCommand("SEEDLING"));
+    TEST_ASSERT_FALSE(isInternalCommand("MCX"));
+}
+
+// =============================================================================
+// DISPATCH COST
+// =============================================================================
+
+static volatile uint32_t handlerSink = 0;
+
+// The MenuController front end this replaces: copy, strtok into 16 x 64-byte
+// parameter buffers, uppercase, then a strcmp chain
+static bool legacyParse(const char* message, char* command, char params[][PARAM_BUFFER_SIZE], uint8_t& paramCount) {
+    char buffer[256];
+    strncpy(buffer, message, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    char* p = buffer;
+    while (*p) {
+        if (*p == '\n' || *p == '\r' || *p == '\x04') {
+            *p = '\0';
+            break;
+        }
+        p++;
+    }
+    p = buffer;
+    while (*p == ' ') p++;
+    if (strlen(p) == 0) {
+        return false;
+    }
+
+    paramCount = 0;
+    char* token = strtok(p, ":");
+    if (!token) {
+        return false;
+    }
+    strncpy(command, token, 31);
+    command[31] = '\0';
+    for (char* c = command; *c; c++) {
+        *c = static_cast<char>(toupper(*c));
+    }
+    while ((token = strtok(nullptr, ":")) != nullptr && paramCount < MAX_COMMAND_PARAMS) {
+        strncpy(params[paramCount], token, PARAM_BUFFER_SIZE - 1);
+        params[paramCount][PARAM_BUFFER_SIZE - 1] = '\0';
+        paramCount++;
+    }
+    return true;
+}
+
+static const char* const LEGACY_CHAIN[] = {
+    "INFO", "BATTERY", "PING", "PROFILE_LIST", "PROFILE_LOAD", "PROFILE_GET", "PROFILE_CUSTOM",
+    "SESSION_START", "SESSION_PAUSE", "SESSION_RESUME", "SESSION_STOP", "SESSION_STATUS",
+    "SKEW_STATUS", "PARAM_SET", "CALIBRATE_START", "CALIBRATE_BUZZ", "CALIBRATE_STOP",
+    "HELP", "RESTART", "THERAPY_LED_OFF", "DEBUG",
+};
+
+__attribute__((noinline)) static void legacyDispatch(const char* message) {
+    char command[32];
+    char params[MAX_COMMAND_PARAMS][PARAM_BUFFER_SIZE];
+    uint8_t paramCount = 0;
+    if (!legacyParse(message, command, params, paramCount)) {
+        return;
+    }
+    for (uint8_t i = 0; i < sizeof(LEGACY_CHAIN) / sizeof(LEGACY_CHAIN[0]); i++) {
+        if (strcmp(command, LEGACY_CHAIN[i]) == 0) {
+            handlerSink = handlerSink + i + (paramCount > 0 ? static_cast<uint8_t>(params[0][0]) : 0u);
+            return;
+        }
+    }
+}
+
+__attribute__((noinline)) static void tableDispatch(const char* message) {
+    CommandTokens parsed;
+    if (!parsed.parse(message)) {
+        return;
+    }
+    const CommandEntry<uint8_t>* entry = findCommand(MENU_COMMANDS, parsed.command(), true);
+    if (entry) {
+        std::string_view first = parsed.param(0);
+        handlerSink = handlerSink + entry->value + (first.empty() ? 0u : static_cast<uint8_t>(first[0]));
+    }
+}
+
+void test_dispatch_cost_per_command(void) {
+    const int iterations = 20000;
+    double legacyTotal = 0.0;
+    double tableTotal = 0.0;
+    double worstRatio = 0.0;
+
+    for (size_t i = 0; i < MENU_MESSAGE_COUNT; i++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int n = 0; n < iterations; n++) {
+            legacyDispatch(MENU_MESSAGES[i]);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double legacyNs = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int n = 0; n < iterations; n++) {
+            tableDispatch(MENU_MESSAGES[i]);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        double tableNs = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+
+        legacyTotal += legacyNs;
+        tableTotal += tableNs;
+        if (tableNs / legacyNs > worstRatio) {
+            worstRatio = tableNs / legacyNs;
+        }
+        printf("[PERF] dispatch %-52s strtok+strcmp=%6.1f ns, tokens+table=%6.1f ns\n",
+               MENU_MESSAGES[i], legacyNs, tableNs);
+    }
+
+    printf("[PERF] dispatch average over %u commands: strtok+strcmp=%.1f ns, tokens+table=%.1f ns (%.1fx)\n",
+           (unsigned)MENU_MESSAGE_COUNT, legacyTotal / MENU_MESSAGE_COUNT, tableTotal / MENU_MESSAGE_COUNT,
+           legacyTotal / tableTotal);
+    printf("[SIZE] CommandTokens=%u bytes vs command+params buffers=%u bytes\n",
+           (unsigned)sizeof(CommandTokens), (unsigned)(32 + MAX_COMMAND_PARAMS * PARAM_BUFFER_SIZE));
+
+    TEST_ASSERT_TRUE(tableTotal < legacyTotal);
+    TEST_ASSERT_TRUE(sizeof(CommandTokens) < 64);
+}
+
+// =============================================================================
+// PEAK STACK DEPTH
+// =============================================================================
+
+#ifdef __linux__
+
+static const size_t PROBE_STACK_SIZE = 16384;
+static const uint8_t STACK_PAINT = 0xA5;
+static uint8_t probeStack[PROBE_STACK_SIZE];
+static ucontext_t probeCaller;
+static ucontext_t probeContext;
+static void (*probeFunction)(const char*) = nullptr;
+static const char* probeMessage = nullptr;
+
+static void probeEntry() {
+    probeFunction(probeMessage);
+}
+
+/**
+ * @brief Run fn(message) on a painted stack; return the bytes it touched
+ */
+static size_t measureStack(void (*fn)(const char*), const char* message) {
+    memset(probeStack, STACK_PAINT, sizeof(probeStack));
+    probeFunction = fn;
+    probeMessage = message;
+
+    getcontext(&probeContext);
+    probeContext.uc_stack.ss_sp = probeStack;
+    probeContext.uc_stack.ss_size = sizeof(probeStack);
+    probeContext.uc_link = &probeCaller;
+    makecontext(&probeContext, probeEntry, 0);
+    swapcontext(&probeCaller, &probeContext);
+
+    // Stack grows down: the lowest overwritten byte marks the peak
+    size_t untouched = 0;
+    while (untouched < sizeof(probeStack) && probeStack[untouched] == STACK_PAINT) {
+        untouched++;
+    }
+    return sizeof(probeStack) - untouched;
+}
+
+static void probeBaseline(const char*) {
+}
+
+#endif
+
+void test_dispatch_peak_stack_per_command(void) {
+#ifdef __linux__
+    size_t baseline = measureStack(probeBaseline, "");
+    size_t legacyMax = 0;
+    size_t tableMax = 0;
+
+    for (size_t i = 0; i < MENU_MESSAGE_COUNT; i++) {
+        size_t legacyBytes = measureStack(legacyDispatch, MENU_MESSAGES[i]) - baseline;
+        size_t tableBytes = measureStack(tableDispatch, MENU_MESSAGES[i]) - baseline;
+        if (legacyBytes > legacyMax) legacyMax = legacyBytes;
+        if (tableBytes > tableMax) tableMax = tableBytes;
+        printf("[STACK] dispatch %-52s strtok+strcmp=%5u bytes, tokens+table=%4u bytes\n",
+               MENU_MESSAGES[i], (unsigned)legacyBytes, (unsigned)tableBytes);
+        TEST_ASSERT_TRUE(tableBytes < legacyBytes);
+    }
+
+    printf("[STACK] dispatch peak: strtok+strcmp=%u bytes, tokens+table=%u bytes\n",
+           (unsigned)legacyMax, (unsigned)tableMax);
+
+    TEST_ASSERT_TRUE(legacyMax >= MAX_COMMAND_PARAMS * PARAM_BUFFER_SIZE);
+    TEST_ASSERT_TRUE(tableMax < 256);
+#else
+    TEST_IGNORE_MESSAGE("Stack painting needs ucontext");
+#endif
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+
+    // Parse tests
+    RUN_TEST(test_parse_null_message_returns_false);
+    RUN_TEST(test_parse_empty_message_returns_false);
+    RUN_TEST(test_parse_whitespace_only_returns_false);
+    RUN_TEST(test_parse_separators_only_returns_false);
+    RUN_TEST(test_parse_simple_command_no_params);
+    RUN_TEST(test_parse_preserves_case);
+    RUN_TEST(test_parse_multiple_params);
+    RUN_TEST(test_parse_views_point_into_message);
+    RUN_TEST(test_parse_skips_empty_fields);
+    RUN_TEST(test_parse_strips_newline);
+    RUN_TEST(test_parse_strips_carriage_return);
+    RUN_TEST(test_parse_strips_EOT);
+    RUN_TEST(test_parse_trims_leading_whitespace);
+    RUN_TEST(test_parse_max_params);
+    RUN_TEST(test_parse_limits_message_length);
+    RUN_TEST(test_parse_resets_previous_result);
+
+    // Parameter access tests
+    RUN_TEST(test_param_out_of_range_is_empty);
+    RUN_TEST(test_paramInt_matches_atoi);
+    RUN_TEST(test_paramInt_default_when_missing);
+    RUN_TEST(test_copyParam_terminates_and_truncates);
+    RUN_TEST(test_copyParam_out_of_range_clears_output);
+
+    // Table lookup tests
+    RUN_TEST(test_compareCommand_orders_like_strcmp);
+    RUN_TEST(test_commandTableSorted_detects_order);
+    RUN_TEST(test_findCommand_finds_every_menu_command);
+    RUN_TEST(test_findCommand_ignore_case);
+    RUN_TEST(test_findCommand_unknown_and_prefix_do_not_match);
+    RUN_TEST(test_findCommand_is_constexpr);
+
+    // Internal command tests
+    RUN_TEST(test_isInternalCommand_exact_words);
+    RUN_TEST(test_isInternalCommand_sync_families);
+    RUN_TEST(test_isInternalCommand_menu_commands_false);
+    RUN_TEST(test_isInternalCommand_case_sensitive_and_exact);
+
+    // Dispatch cost and stack depth
+    RUN_TEST(test_dispatch_cost_per_command);
+    RUN_TEST(test_dispatch_peak_stack_per_command);
+
+    return UNITY_END();
+}
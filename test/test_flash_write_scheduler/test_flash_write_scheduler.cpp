@@ -0,0 +1,270 @@
+/**
+ * @file test_flash_write_scheduler.cpp
+ * @brief Unit tests for FlashWriteScheduler (deferred settings commits)
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <vector>
+#include "flash_write_scheduler.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static FlashWriteScheduler* g_scheduler = nullptr;
+
+static const uint64_t NO_EVENTS = UINT64_MAX;
+
+void setUp(void) {
+    g_scheduler = new FlashWriteScheduler();
+}
+
+void tearDown(void) {
+    delete g_scheduler;
+    g_scheduler = nullptr;
+}
+
+/**
+ * @brief Commit as loop() does (ProfileManager::serviceSettingsWrite)
+ */
+static void commit(uint32_t nowMs, uint32_t stallUs, bool success = true) {
+    uint32_t generation = g_scheduler->beginCommit();
+    g_scheduler->endCommit(generation, nowMs, stallUs, success);
+}
+
+// =============================================================================
+// DIRTY TRACKING TESTS
+// =============================================================================
+
+void test_FlashWriteScheduler_initially_clean(void) {
+    TEST_ASSERT_FALSE(g_scheduler->isDirty());
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(100000, 100000000, NO_EVENTS));
+}
+
+void test_FlashWriteScheduler_commit_clears_dirty(void) {
+    g_scheduler->markDirty(1000);
+    TEST_ASSERT_TRUE(g_scheduler->isDirty());
+
+    commit(2000, 30000);
+
+    TEST_ASSERT_FALSE(g_scheduler->isDirty());
+    TEST_ASSERT_EQUAL_UINT32(1, g_scheduler->getCommitCount());
+    TEST_ASSERT_EQUAL_UINT32(30000, g_scheduler->getLastStallUs());
+}
+
+void test_FlashWriteScheduler_change_during_commit_stays_dirty(void) {
+    g_scheduler->markDirty(1000);
+
+    uint32_t generation = g_scheduler->beginCommit();
+    g_scheduler->markDirty(1600);   // BLE callback while the file is written
+    g_scheduler->endCommit(generation, 1620, 30000, true);
+
+    TEST_ASSERT_TRUE(g_scheduler->isDirty());
+}
+
+void test_FlashWriteScheduler_failure_stays_dirty_and_retries_later(void) {
+    g_scheduler->markDirty(1000);
+    commit(1500, 5000, false);
+
+    TEST_ASSERT_TRUE(g_scheduler->isDirty());
+    TEST_ASSERT_EQUAL_UINT32(1, g_scheduler->getFailureCount());
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(1500 + FLASH_WRITE_COALESCE_MS - 1, 0, NO_EVENTS));
+    TEST_ASSERT_TRUE(g_scheduler->shouldCommit(1500 + FLASH_WRITE_COALESCE_MS, 0, NO_EVENTS));
+}
+
+// =============================================================================
+// COALESCING TESTS
+// =============================================================================
+
+void test_FlashWriteScheduler_waits_for_changes_to_settle(void) {
+    g_scheduler->markDirty(1000);
+
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(1000 + FLASH_WRITE_COALESCE_MS - 1, 0, NO_EVENTS));
+    TEST_ASSERT_TRUE(g_scheduler->shouldCommit(1000 + FLASH_WRITE_COALESCE_MS, 0, NO_EVENTS));
+}
+
+void test_FlashWriteScheduler_burst_becomes_one_commit(void) {
+    // LED toggled 10 times, 100ms apart
+    uint32_t commits = 0;
+    for (uint32_t nowMs = 0; nowMs < 5000; nowMs++) {
+        if (nowMs < 1000 && nowMs % 100 == 0) {
+            g_scheduler->markDirty(nowMs);
+        }
+        if (g_scheduler->shouldCommit(nowMs, (uint64_t)nowMs * 1000, NO_EVENTS)) {
+            commit(nowMs, 30000);
+            commits++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1, commits);
+    TEST_ASSERT_FALSE(g_scheduler->isDirty());
+}
+
+void test_FlashWriteScheduler_millis_wraparound(void) {
+    g_scheduler->markDirty(0xFFFFFF00u);
+
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(0xFFFFFF00u + 10, 0, NO_EVENTS));
+    TEST_ASSERT_TRUE(g_scheduler->shouldCommit(0xFFFFFF00u + FLASH_WRITE_COALESCE_MS, 0, NO_EVENTS));
+}
+
+// =============================================================================
+// MOTOR WINDOW TESTS
+// =============================================================================
+
+void test_FlashWriteScheduler_needs_event_free_window(void) {
+    g_scheduler->markDirty(0);
+    uint32_t nowMs = FLASH_WRITE_COALESCE_MS;
+    uint64_t nowUs = 10000000;
+
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(nowMs, nowUs, nowUs + FLASH_WRITE_WINDOW_US - 1));
+    TEST_ASSERT_TRUE(g_scheduler->shouldCommit(nowMs, nowUs, nowUs + FLASH_WRITE_WINDOW_US));
+}
+
+void test_FlashWriteScheduler_overdue_event_blocks_commit(void) {
+    g_scheduler->markDirty(0);
+    uint64_t nowUs = 10000000;
+
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(FLASH_WRITE_COALESCE_MS, nowUs, nowUs));
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(FLASH_WRITE_COALESCE_MS, nowUs, nowUs - 500));
+}
+
+void test_FlashWriteScheduler_window_grows_with_measured_stall(void) {
+    TEST_ASSERT_EQUAL_UINT32(FLASH_WRITE_WINDOW_US, g_scheduler->getRequiredWindowUs());
+
+    // Short stall: default window still applies
+    g_scheduler->markDirty(0);
+    commit(1000, 20000);
+    TEST_ASSERT_EQUAL_UINT32(FLASH_WRITE_WINDOW_US, g_scheduler->getRequiredWindowUs());
+
+    // Stall longer than the default: window = worst stall + guard
+    g_scheduler->markDirty(2000);
+    commit(3000, FLASH_WRITE_WINDOW_US + 5000);
+    TEST_ASSERT_EQUAL_UINT32(FLASH_WRITE_WINDOW_US + 5000 + FLASH_WRITE_GUARD_US,
+                             g_scheduler->getRequiredWindowUs());
+
+    // Worst case is kept
+    g_scheduler->markDirty(4000);
+    commit(5000, 10000);
+    TEST_ASSERT_EQUAL_UINT32(FLASH_WRITE_WINDOW_US + 5000, g_scheduler->getMaxStallUs());
+    TEST_ASSERT_EQUAL_UINT32(10000, g_scheduler->getLastStallUs());
+}
+
+// =============================================================================
+// SESSION SIMULATION
+// =============================================================================
+
+/**
+ * @brief Run a therapy-like schedule with loop() every 1ms and commit once
+ *
+ * Macrocycle: 12 buzzes of 100ms ON / 67ms OFF, then 2x TIME_RELAX (1336ms).
+ * Each buzz queues an activation and a deactivation. Settings are changed
+ * mid-buzz at 1.25s.
+ *
+ * @param stallUs Simulated flash write duration
+ * @return Commit time in microseconds (0 if never committed)
+ */
+static uint64_t simulateSessionCommit(uint32_t stallUs) {
+    const uint32_t onUs = 100000, offUs = 67000, relaxUs = 1336000;
+    std::vector<uint64_t> events;
+    uint64_t t = 1000000;
+    for (int cycle = 0; cycle < 6; cycle++) {
+        for (int buzz = 0; buzz < 12; buzz++) {
+            events.push_back(t);
+            events.push_back(t + onUs);
+            t += onUs + offUs;
+        }
+        t += relaxUs;
+    }
+
+    size_t next = 0;
+    uint64_t commitAtUs = 0;
+    g_scheduler->markDirty(1250);
+    for (uint64_t nowUs = 1250000; nowUs < t && commitAtUs == 0; nowUs += 1000) {
+        while (next < events.size() && events[next] <= nowUs) {
+            next++;  // Motor task already executed it
+        }
+        uint64_t nextEventUs = (next < events.size()) ? events[next] : NO_EVENTS;
+        if (g_scheduler->shouldCommit((uint32_t)(nowUs / 1000), nowUs, nextEventUs)) {
+            commitAtUs = nowUs;
+            commit((uint32_t)(nowUs / 1000), stallUs);
+        }
+    }
+
+    // No motor event comes due while the CPU is stalled
+    for (uint64_t e : events) {
+        TEST_ASSERT_FALSE(e > commitAtUs && e <= commitAtUs + stallUs);
+    }
+    return commitAtUs;
+}
+
+void test_FlashWriteScheduler_session_commit_avoids_motor_events(void) {
+    uint64_t commitAtUs = simulateSessionCommit(60000);
+
+    TEST_ASSERT_TRUE(commitAtUs > 0);
+    TEST_ASSERT_FALSE(g_scheduler->isDirty());
+    printf("[SIM] 60ms stall: marked at 1250 ms, committed at %lu ms\n",
+           (unsigned long)(commitAtUs / 1000));
+}
+
+void test_FlashWriteScheduler_long_stall_waits_for_relax_period(void) {
+    // A previous commit took 150ms (e.g. LittleFS block compaction)
+    g_scheduler->markDirty(0);
+    commit(600, 150000);
+
+    uint64_t commitAtUs = simulateSessionCommit(150000);
+
+    // Buzz gaps are at most 100ms: only the relax after the first macrocycle
+    // (ends at 1s + 12 x 167ms = 3.004s) is long enough
+    TEST_ASSERT_TRUE(commitAtUs >= 3004000 - 67000);
+    TEST_ASSERT_TRUE(commitAtUs < 3004000 + 1336000);
+    printf("[SIM] 150ms stall: marked at 1250 ms, committed at %lu ms (relax period)\n",
+           (unsigned long)(commitAtUs / 1000));
+}
+
+void test_FlashWriteScheduler_running_session_empty_queue_waits_for_macrocycle(void) {
+    g_scheduler->markDirty(1000);
+
+    // Lockstep relax period: queue empty, next macrocycle queued in 30ms
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(2000, 2000000, NO_EVENTS, 2030000));
+    // Queued macrocycle's events don't hide one due sooner
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(2000, 2000000, 2500000, 2030000));
+    // Early in the relax period there is room
+    TEST_ASSERT_TRUE(g_scheduler->shouldCommit(2000, 2000000, NO_EVENTS, 3000000));
+    // ...unless a queued event is nearer
+    TEST_ASSERT_FALSE(g_scheduler->shouldCommit(2000, 2000000, 2050000, 3000000));
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+
+    // Dirty tracking tests
+    RUN_TEST(test_FlashWriteScheduler_initially_clean);
+    RUN_TEST(test_FlashWriteScheduler_commit_clears_dirty);
+    RUN_TEST(test_FlashWriteScheduler_change_during_commit_stays_dirty);
+    RUN_TEST(test_FlashWriteScheduler_failure_stays_dirty_and_retries_later);
+
+    // Coalescing tests
+    RUN_TEST(test_FlashWriteScheduler_waits_for_changes_to_settle);
+    RUN_TEST(test_FlashWriteScheduler_burst_becomes_one_commit);
+    RUN_TEST(test_FlashWriteScheduler_millis_wraparound);
+
+    // Motor window tests
+    RUN_TEST(test_FlashWriteScheduler_needs_event_free_window);
+    RUN_TEST(test_FlashWriteScheduler_overdue_event_blocks_commit);
+    RUN_TEST(test_FlashWriteScheduler_window_grows_with_measured_stall);
+
+    // Session simulation
+    RUN_TEST(test_FlashWriteScheduler_session_commit_avoids_motor_events);
+    RUN_TEST(test_FlashWriteScheduler_long_stall_waits_for_relax_period);
+    RUN_TEST(test_FlashWriteScheduler_running_session_empty_queue_waits_for_macrocycle);
+
+    return UNITY_END();
+}
@@ -0,0 +1,316 @@
+/**
+ * @file test_hardware.cpp
+ * @brief Unit tests for HapticController I2C shadow registers (mock Wire/TCA9548A/DRV2605)
+ */
+
+#include <unity.h>
+#include "hardware.h"
+
+// Source files under test (excluded from native build_src_filter)
+#include "../../src/sync_protocol.cpp"  // For getMicros() - needed by executeBatch
+#include "../../src/hardware.cpp"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static HapticController* haptic = nullptr;
+
+void setUp(void) {
+    mockResetTime();
+    haptic = new HapticController();
+    haptic->begin();
+    haptic->resetBusStats();
+    Wire.resetCounters();
+}
+
+void tearDown(void) {
+    delete haptic;
+    haptic = nullptr;
+}
+
+// =============================================================================
+// LEGACY (UNSHADOWED) BUS REFERENCE
+// =============================================================================
+
+/**
+ * Mirror of the pre-shadow HapticController bus behavior: every operation
+ * does openChannel + register write + closeAll; only the frequency value
+ * was cached. Drives the same mock TCA9548A/DRV2605 so byte counts compare.
+ */
+struct LegacyHapticBus {
+    TCA9548A tca{TCA9548A_ADDRESS};
+    Adafruit_DRV2605 drv[MAX_ACTUATORS];
+    uint16_t lastFrequency[MAX_ACTUATORS] = {0};
+    int8_t preSelected = -1;
+
+    void closeAllChannels() { tca.closeAll(); preSelected = -1; }
+
+    void activate(uint8_t f, uint8_t amp) {
+        tca.openChannel(f);
+        drv[f].setRealtimeValue(static_cast<uint8_t>((amp * DRV2605_MAX_RTP) / MAX_AMPLITUDE));
+        closeAllChannels();
+    }
+    void deactivate(uint8_t f) {
+        tca.openChannel(f);
+        drv[f].setRealtimeValue(0);
+        closeAllChannels();
+    }
+    void setFrequency(uint8_t f, uint16_t hz) {
+        if (lastFrequency[f] == hz) return;
+        tca.openChannel(f);
+        drv[f].writeRegister8(DRV2605_REG_CONTROL1, static_cast<uint8_t>((5000 / hz) & 0x1F));
+        closeAllChannels();
+        lastFrequency[f] = hz;
+    }
+    void selectChannelPersistent(uint8_t f) { tca.openChannel(f); preSelected = static_cast<int8_t>(f); }
+    void setFrequencyDirect(uint8_t f, uint16_t hz) {
+        drv[f].writeRegister8(DRV2605_REG_CONTROL1, static_cast<uint8_t>((5000 / hz) & 0x1F));
+    }
+    void activatePreSelected(uint8_t f, uint8_t amp) {
+        if (preSelected != static_cast<int8_t>(f)) tca.openChannel(f);
+        drv[f].setRealtimeValue(static_cast<uint8_t>((amp * DRV2605_MAX_RTP) / MAX_AMPLITUDE));
+    }
+    int8_t getPreSelectedFinger() const { return preSelected; }
+};
+
+/**
+ * Replays one macrocycle exactly as the motor task issues it
+ * (executeMotorEvent + preSelectNextActivation, no coalescing).
+ */
+template <typename Bus>
+static void replayMacrocycle(Bus& bus, const uint8_t* fingers, const uint16_t* freqs, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t f = fingers[i];
+        if (bus.getPreSelectedFinger() == static_cast<int8_t>(f)) {
+            bus.activatePreSelected(f, 100);
+            bus.closeAllChannels();
+        } else {
+            bus.setFrequency(f, freqs[i]);
+            bus.activate(f, 100);
+        }
+
+        bus.deactivate(f);
+        if (i + 1 < count) {
+            bus.selectChannelPersistent(fingers[i + 1]);
+            bus.setFrequencyDirect(fingers[i + 1], freqs[i + 1]);
+        }
+    }
+}
+
+// Deterministic LCG for reproducible macrocycles
+static uint32_t lcgState = 1;
+static uint32_t lcgNext() {
+    lcgState = lcgState * 1664525u + 1013904223u;
+    return lcgState >> 8;
+}
+
+static void buildMacrocycle(uint8_t* fingers, uint16_t* freqs, bool randomFrequency) {
+    // 3 patterns x 4 fingers (random permutation each), as TherapyEngine generates
+    for (uint8_t p = 0; p < 3; p++) {
+        uint8_t perm[4] = {0, 1, 2, 3};
+        for (uint8_t i = 3; i > 0; i--) {
+            uint8_t j = static_cast<uint8_t>(lcgNext() % (i + 1u));
+            uint8_t t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+        }
+        for (uint8_t i = 0; i < 4; i++) {
+            fingers[p * 4 + i] = perm[i];
+            freqs[p * 4 + i] = randomFrequency
+                ? static_cast<uint16_t>(210 + (lcgNext() % 41))  // 210-250Hz jitter
+                : 250;
+        }
+    }
+}
+
+// =============================================================================
+// SHADOW REGISTER TESTS
+// =============================================================================
+
+void test_Haptic_begin_enables_all_fingers(void) {
+    TEST_ASSERT_EQUAL_UINT8(MAX_ACTUATORS, haptic->getEnabledCount());
+}
+
+void test_Haptic_activate_issues_select_write_close(void) {
+    TEST_ASSERT_EQUAL(Result::OK, haptic->activate(0, 100));
+    TEST_ASSERT_EQUAL_UINT32(3, Wire.transactions);
+    TEST_ASSERT_EQUAL_UINT32(2, haptic->getBusStats().muxWrites);
+    TEST_ASSERT_EQUAL_UINT32(1, haptic->getBusStats().drvWrites);
+    TEST_ASSERT_TRUE(haptic->isActive(0));
+}
+
+void test_Haptic_repeat_activate_same_amplitude_elided(void) {
+    haptic->activate(1, 80);
+    Wire.resetCounters();
+
+    TEST_ASSERT_EQUAL(Result::OK, haptic->activate(1, 80));
+    TEST_ASSERT_EQUAL_UINT32(0, Wire.transactions);
+    TEST_ASSERT_EQUAL_UINT32(1, haptic->getBusStats().drvWritesSkipped);
+    TEST_ASSERT_TRUE(haptic->isActive(1));
+}
+
+void test_Haptic_changed_amplitude_is_written(void) {
+    haptic->activate(1, 80);
+    Wire.resetCounters();
+
+    haptic->activate(1, 40);
+    TEST_ASSERT_EQUAL_UINT32(3, Wire.transactions);
+}
+
+void test_Haptic_deactivate_after_init_elided(void) {
+    // initializeFinger leaves RTP=0 in the chip and the shadow
+    TEST_ASSERT_EQUAL(Result::OK, haptic->deactivate(2));
+    TEST_ASSERT_EQUAL_UINT32(0, Wire.transactions);
+    TEST_ASSERT_FALSE(haptic->isActive(2));
+}
+
+void test_Haptic_close_when_closed_elided(void) {
+    haptic->closeAllChannels();
+    haptic->closeAllChannels();
+    TEST_ASSERT_EQUAL_UINT32(0, Wire.transactions);
+    TEST_ASSERT_EQUAL_UINT32(2, haptic->getBusStats().muxWritesSkipped);
+}
+
+void test_Haptic_setFrequency_same_drive_time_elided(void) {
+    // 5000/240 = 20 and 5000/245 = 20 -> identical CONTROL1 value
+    haptic->setFrequency(0, 240);
+    Wire.resetCounters();
+
+    haptic->setFrequency(0, 245);
+    TEST_ASSERT_EQUAL_UINT32(0, Wire.transactions);
+}
+
+void test_Haptic_setFrequencyDirect_elided_when_unchanged(void) {
+    haptic->selectChannelPersistent(3);
+    haptic->setFrequencyDirect(3, 250);
+    Wire.resetCounters();
+
+    haptic->setFrequencyDirect(3, 250);
+    TEST_ASSERT_EQUAL_UINT32(0, Wire.transactions);
+}
+
+void test_Haptic_preselected_activate_skips_mux(void) {
+    haptic->selectChannelPersistent(2);
+    Wire.resetCounters();
+
+    haptic->activatePreSelected(2, 100);
+    TEST_ASSERT_EQUAL_UINT32(1, Wire.transactions);  // RTP only
+}
+
+void test_Haptic_emergencyStop_always_writes(void) {
+    // Shadow says every motor is already at RTP=0 - emergency stop must not trust it
+    haptic->emergencyStop();
+    TEST_ASSERT_EQUAL_UINT32(MAX_ACTUATORS * 2 + 1, Wire.transactions);
+    TEST_ASSERT_EQUAL_UINT32(0, haptic->getBusStats().totalSkipped());
+}
+
+void test_Haptic_emergencyStop_then_activate_writes(void) {
+    haptic->activate(0, 100);
+    haptic->emergencyStop();
+    Wire.resetCounters();
+
+    haptic->activate(0, 100);
+    TEST_ASSERT_EQUAL_UINT32(3, Wire.transactions);
+}
+
+void test_Haptic_resetBusStats(void) {
+    haptic->activate(0, 100);
+    haptic->resetBusStats();
+    TEST_ASSERT_EQUAL_UINT32(0, haptic->getBusStats().muxWrites);
+    TEST_ASSERT_EQUAL_UINT32(0, haptic->getBusStats().drvWrites);
+}
+
+void test_Haptic_executeBatch_elides_redundant_writes(void) {
+    HapticBatchOp ops[2] = {};
+    ops[0].finger = 0; ops[0].amplitude = 0;                           // already off
+    ops[1].finger = 1; ops[1].amplitude = 100; ops[1].frequencyHz = 250;
+
+    TEST_ASSERT_EQUAL(Result::OK, haptic->executeBatch(ops, 2));
+    TEST_ASSERT_EQUAL(Result::OK, ops[0].result);
+    TEST_ASSERT_EQUAL(Result::OK, ops[1].result);
+    // F0: nothing. F1: select + CONTROL1 + RTP. Close: 1
+    TEST_ASSERT_EQUAL_UINT32(4, Wire.transactions);
+    TEST_ASSERT_TRUE(haptic->isActive(1));
+}
+
+// =============================================================================
+// MACROCYCLE BUS TRAFFIC (before/after shadow registers)
+// =============================================================================
+
+static void compareMacrocycleTraffic(bool randomFrequency, const char* label) {
+    constexpr uint8_t MACROCYCLES = 20;
+    constexpr uint8_t EVENTS = 12;
+
+    LegacyHapticBus legacy;
+    uint32_t legacyBytes = 0;
+    uint32_t legacyTxns = 0;
+    lcgState = 42;
+    for (uint8_t m = 0; m < MACROCYCLES; m++) {
+        uint8_t fingers[EVENTS];
+        uint16_t freqs[EVENTS];
+        buildMacrocycle(fingers, freqs, randomFrequency);
+        Wire.resetCounters();
+        replayMacrocycle(legacy, fingers, freqs, EVENTS);
+        legacyBytes += Wire.bytes;
+        legacyTxns += Wire.transactions;
+    }
+
+    uint32_t shadowBytes = 0;
+    uint32_t shadowTxns = 0;
+    lcgState = 42;
+    haptic->resetBusStats();
+    for (uint8_t m = 0; m < MACROCYCLES; m++) {
+        uint8_t fingers[EVENTS];
+        uint16_t freqs[EVENTS];
+        buildMacrocycle(fingers, freqs, randomFrequency);
+        Wire.resetCounters();
+        replayMacrocycle(*haptic, fingers, freqs, EVENTS);
+        shadowBytes += Wire.bytes;
+        shadowTxns += Wire.transactions;
+    }
+
+    printf("[I2C] %s: %lu -> %lu bytes/macrocycle, %lu -> %lu transactions (%lu elided)\n",
+           label,
+           (unsigned long)(legacyBytes / MACROCYCLES), (unsigned long)(shadowBytes / MACROCYCLES),
+           (unsigned long)(legacyTxns / MACROCYCLES), (unsigned long)(shadowTxns / MACROCYCLES),
+           (unsigned long)(haptic->getBusStats().totalSkipped() / MACROCYCLES));
+
+    TEST_ASSERT_TRUE(shadowBytes < legacyBytes);
+    TEST_ASSERT_TRUE(shadowTxns < legacyTxns);
+}
+
+void test_Haptic_macrocycle_traffic_fixed_frequency(void) {
+    compareMacrocycleTraffic(false, "Fixed 250Hz");
+}
+
+void test_Haptic_macrocycle_traffic_random_frequency(void) {
+    compareMacrocycleTraffic(true, "Random 210-250Hz");
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Shadow registers
+    RUN_TEST(test_Haptic_begin_enables_all_fingers);
+    RUN_TEST(test_Haptic_activate_issues_select_write_close);
+    RUN_TEST(test_Haptic_repeat_activate_same_amplitude_elided);
+    RUN_TEST(test_Haptic_changed_amplitude_is_written);
+    RUN_TEST(test_Haptic_deactivate_after_init_elided);
+    RUN_TEST(test_Haptic_close_when_closed_elided);
+    RUN_TEST(test_Haptic_setFrequency_same_drive_time_elided);
+    RUN_TEST(test_Haptic_setFrequencyDirect_elided_when_unchanged);
+    RUN_TEST(test_Haptic_preselected_activate_skips_mux);
+    RUN_TEST(test_Haptic_emergencyStop_always_writes);
+    RUN_TEST(test_Haptic_emergencyStop_then_activate_writes);
+    RUN_TEST(test_Haptic_resetBusStats);
+    RUN_TEST(test_Haptic_executeBatch_elides_redundant_writes);
+
+    // Macrocycle bus traffic
+    RUN_TEST(test_Haptic_macrocycle_traffic_fixed_frequency);
+    RUN_TEST(test_Haptic_macrocycle_traffic_random_frequency);
+
+    return UNITY_END();
+}
@@ -4,6 +4,9 @@
  */
 
 #include <unity.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include "latency_metrics.h"
 
 // =============================================================================
@@ -37,55 +40,60 @@ void test_reset_clears_verbose_logging(void) {
 }
 
 void test_reset_clears_drift_values(void) {
-    latencyMetrics.lastDrift_us = 100;
-    latencyMetrics.totalDrift_us = 1000;
-    latencyMetrics.sampleCount = 10;
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(100);
+    latencyMetrics.recordExecution(900);
     latencyMetrics.reset();
-    TEST_ASSERT_EQUAL_INT32(0, latencyMetrics.lastDrift_us);
-    TEST_ASSERT_EQUAL_INT64(0, latencyMetrics.totalDrift_us);
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.sampleCount);
+    TEST_ASSERT_EQUAL_INT32(0, latencyMetrics.getExecutionStats().lastDrift_us);
+    TEST_ASSERT_EQUAL_INT64(0, latencyMetrics.getExecutionStats().totalDrift_us);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().sampleCount);
 }
 
 void test_reset_initializes_drift_min_to_max(void) {
-    latencyMetrics.minDrift_us = 0;
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(0);
     latencyMetrics.reset();
-    TEST_ASSERT_EQUAL_INT32(INT32_MAX, latencyMetrics.minDrift_us);
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, latencyMetrics.getExecutionStats().minDrift_us);
 }
 
 void test_reset_initializes_drift_max_to_min(void) {
-    latencyMetrics.maxDrift_us = 0;
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(0);
     latencyMetrics.reset();
-    TEST_ASSERT_EQUAL_INT32(INT32_MIN, latencyMetrics.maxDrift_us);
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, latencyMetrics.getExecutionStats().maxDrift_us);
 }
 
 void test_reset_clears_late_early_counts(void) {
-    latencyMetrics.lateCount = 5;
-    latencyMetrics.earlyCount = 3;
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(5000);
+    latencyMetrics.recordExecution(-3);
     latencyMetrics.reset();
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.lateCount);
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.earlyCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().lateCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().earlyCount);
 }
 
 void test_reset_clears_rtt_values(void) {
-    latencyMetrics.lastRtt_us = 100;
-    latencyMetrics.totalRtt_us = 1000;
-    latencyMetrics.rttSampleCount = 10;
+    latencyMetrics.enable();
+    latencyMetrics.recordRtt(100);
+    latencyMetrics.recordRtt(900);
     latencyMetrics.reset();
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.lastRtt_us);
-    TEST_ASSERT_EQUAL_UINT64(0, latencyMetrics.totalRtt_us);
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.rttSampleCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getRttStats().lastRtt_us);
+    TEST_ASSERT_EQUAL_UINT64(0, latencyMetrics.getRttStats().totalRtt_us);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getRttStats().rttSampleCount);
 }
 
 void test_reset_initializes_rtt_min_to_max(void) {
-    latencyMetrics.minRtt_us = 0;
+    latencyMetrics.enable();
+    latencyMetrics.recordRtt(0);
     latencyMetrics.reset();
-    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, latencyMetrics.minRtt_us);
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, latencyMetrics.getRttStats().minRtt_us);
 }
 
 void test_reset_initializes_rtt_max_to_zero(void) {
-    latencyMetrics.maxRtt_us = 1000;
+    latencyMetrics.enable();
+    latencyMetrics.recordRtt(1000);
     latencyMetrics.reset();
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.maxRtt_us);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getRttStats().maxRtt_us);
 }
 
 void test_reset_clears_sync_probe_values(void) {
@@ -115,7 +123,7 @@ void test_reset_is_idempotent(void) {
     latencyMetrics.reset();
     latencyMetrics.reset();
     TEST_ASSERT_FALSE(latencyMetrics.enabled);
-    TEST_ASSERT_EQUAL_INT32(INT32_MAX, latencyMetrics.minDrift_us);
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, latencyMetrics.getExecutionStats().minDrift_us);
 }
 
 // =============================================================================
@@ -143,13 +151,15 @@ void test_enable_with_verbose_false_explicit(void) {
 }
 
 void test_enable_first_time_resets_metrics(void) {
-    // Set some values
-    latencyMetrics.sampleCount = 100;
-    latencyMetrics.lateCount = 50;
+    // Record some values, then disable without the report
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(100);
+    latencyMetrics.recordExecution(5000);
+    latencyMetrics.enabled = false;
     // Enable should reset
     latencyMetrics.enable();
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.sampleCount);
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.lateCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().sampleCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().lateCount);
 }
 
 void test_enable_already_enabled_no_reset(void) {
@@ -157,10 +167,10 @@ void test_enable_already_enabled_no_reset(void) {
     latencyMetrics.enable();
     // Record some data
     latencyMetrics.recordExecution(100);
-    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.sampleCount);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.getExecutionStats().sampleCount);
     // Enable again - should NOT reset
     latencyMetrics.enable();
-    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.sampleCount);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.getExecutionStats().sampleCount);
 }
 
 void test_enable_updates_verbose_when_already_enabled(void) {
@@ -197,13 +207,13 @@ void test_recordExecution_disabled_returns_early(void) {
     // Ensure disabled
     latencyMetrics.enabled = false;
     latencyMetrics.recordExecution(100);
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.sampleCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().sampleCount);
 }
 
 void test_recordExecution_updates_last_drift(void) {
     latencyMetrics.enable();
     latencyMetrics.recordExecution(500);
-    TEST_ASSERT_EQUAL_INT32(500, latencyMetrics.lastDrift_us);
+    TEST_ASSERT_EQUAL_INT32(500, latencyMetrics.getExecutionStats().lastDrift_us);
 }
 
 void test_recordExecution_accumulates_total_drift(void) {
@@ -211,14 +221,14 @@ void test_recordExecution_accumulates_total_drift(void) {
     latencyMetrics.recordExecution(100);
     latencyMetrics.recordExecution(200);
     latencyMetrics.recordExecution(300);
-    TEST_ASSERT_EQUAL_INT64(600, latencyMetrics.totalDrift_us);
+    TEST_ASSERT_EQUAL_INT64(600, latencyMetrics.getExecutionStats().totalDrift_us);
 }
 
 void test_recordExecution_increments_sample_count(void) {
     latencyMetrics.enable();
     latencyMetrics.recordExecution(100);
     latencyMetrics.recordExecution(200);
-    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.sampleCount);
+    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.getExecutionStats().sampleCount);
 }
 
 void test_recordExecution_updates_min_drift(void) {
@@ -226,7 +236,7 @@ void test_recordExecution_updates_min_drift(void) {
     latencyMetrics.recordExecution(500);
     latencyMetrics.recordExecution(100);
     latencyMetrics.recordExecution(300);
-    TEST_ASSERT_EQUAL_INT32(100, latencyMetrics.minDrift_us);
+    TEST_ASSERT_EQUAL_INT32(100, latencyMetrics.getExecutionStats().minDrift_us);
 }
 
 void test_recordExecution_updates_max_drift(void) {
@@ -234,7 +244,7 @@ void test_recordExecution_updates_max_drift(void) {
     latencyMetrics.recordExecution(100);
     latencyMetrics.recordExecution(500);
     latencyMetrics.recordExecution(300);
-    TEST_ASSERT_EQUAL_INT32(500, latencyMetrics.maxDrift_us);
+    TEST_ASSERT_EQUAL_INT32(500, latencyMetrics.getExecutionStats().maxDrift_us);
 }
 
 void test_recordExecution_increments_late_count_above_threshold(void) {
@@ -243,13 +253,13 @@ void test_recordExecution_increments_late_count_above_threshold(void) {
     latencyMetrics.recordExecution(1001);  // Late
     latencyMetrics.recordExecution(2000);  // Late
     latencyMetrics.recordExecution(500);   // Not late
-    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.lateCount);
+    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.getExecutionStats().lateCount);
 }
 
 void test_recordExecution_at_threshold_not_late(void) {
     latencyMetrics.enable();
     latencyMetrics.recordExecution(1000);  // Exactly at threshold - NOT late
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.lateCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().lateCount);
 }
 
 void test_recordExecution_increments_early_count_negative(void) {
@@ -257,21 +267,161 @@ void test_recordExecution_increments_early_count_negative(void) {
     latencyMetrics.recordExecution(-100);  // Early
     latencyMetrics.recordExecution(-50);   // Early
     latencyMetrics.recordExecution(100);   // Not early
-    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.earlyCount);
+    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.getExecutionStats().earlyCount);
 }
 
 void test_recordExecution_zero_drift_not_early(void) {
     latencyMetrics.enable();
     latencyMetrics.recordExecution(0);
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.earlyCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().earlyCount);
 }
 
 void test_recordExecution_negative_min_positive_max(void) {
     latencyMetrics.enable();
     latencyMetrics.recordExecution(-500);
     latencyMetrics.recordExecution(500);
-    TEST_ASSERT_EQUAL_INT32(-500, latencyMetrics.minDrift_us);
-    TEST_ASSERT_EQUAL_INT32(500, latencyMetrics.maxDrift_us);
+    TEST_ASSERT_EQUAL_INT32(-500, latencyMetrics.getExecutionStats().minDrift_us);
+    TEST_ASSERT_EQUAL_INT32(500, latencyMetrics.getExecutionStats().maxDrift_us);
+}
+
+// =============================================================================
+// RECORD SPIN WAIT TESTS
+// =============================================================================
+
+void test_recordSpinWait_disabled_returns_early(void) {
+    latencyMetrics.enabled = false;
+    latencyMetrics.recordSpinWait(800);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().spinWaitCount);
+}
+
+void test_recordSpinWait_accumulates_and_tracks_max(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordSpinWait(900);
+    latencyMetrics.recordSpinWait(1100);
+    latencyMetrics.recordSpinWait(40);
+    TEST_ASSERT_EQUAL_UINT32(3, latencyMetrics.getExecutionStats().spinWaitCount);
+    TEST_ASSERT_EQUAL_UINT64(2040, latencyMetrics.getExecutionStats().totalSpinWait_us);
+    TEST_ASSERT_EQUAL_UINT32(1100, latencyMetrics.getExecutionStats().maxSpinWait_us);
+    TEST_ASSERT_EQUAL_UINT32(680, latencyMetrics.getAverageSpinWait());
+}
+
+void test_getAverageSpinWait_no_samples_returns_zero(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getAverageSpinWait());
+}
+
+void test_reset_clears_spin_wait(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordSpinWait(500);
+    latencyMetrics.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().spinWaitCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().maxSpinWait_us);
+    TEST_ASSERT_EQUAL_UINT64(0, latencyMetrics.getExecutionStats().totalSpinWait_us);
+}
+
+// =============================================================================
+// RECORD IDLE STEP TESTS
+// =============================================================================
+
+void test_recordIdleStep_disabled_returns_early(void) {
+    latencyMetrics.enabled = false;
+    latencyMetrics.recordIdleStep(300, true);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.idlePrecomputedCount);
+}
+
+void test_recordIdleStep_splits_precomputed_and_inline(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordIdleStep(120, true);
+    latencyMetrics.recordIdleStep(80, true);
+    latencyMetrics.recordIdleStep(900, false);
+    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.idlePrecomputedCount);
+    TEST_ASSERT_EQUAL_UINT64(200, latencyMetrics.totalIdlePrecomputed_us);
+    TEST_ASSERT_EQUAL_UINT32(120, latencyMetrics.maxIdlePrecomputed_us);
+    TEST_ASSERT_EQUAL_UINT32(100, latencyMetrics.getAverageIdleStep(true));
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.idleInlineCount);
+    TEST_ASSERT_EQUAL_UINT32(900, latencyMetrics.maxIdleInline_us);
+    TEST_ASSERT_EQUAL_UINT32(900, latencyMetrics.getAverageIdleStep(false));
+}
+
+void test_getAverageIdleStep_no_samples_returns_zero(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getAverageIdleStep(true));
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getAverageIdleStep(false));
+}
+
+void test_reset_clears_idle_step(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordIdleStep(100, true);
+    latencyMetrics.recordIdleStep(700, false);
+    latencyMetrics.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.idlePrecomputedCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.maxIdlePrecomputed_us);
+    TEST_ASSERT_EQUAL_UINT64(0, latencyMetrics.totalIdlePrecomputed_us);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.idleInlineCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.maxIdleInline_us);
+    TEST_ASSERT_EQUAL_UINT64(0, latencyMetrics.totalIdleInline_us);
+}
+
+// =============================================================================
+// RECORD BILATERAL SKEW TESTS
+// =============================================================================
+
+void test_recordBilateralSkew_records_when_disabled(void) {
+    latencyMetrics.enabled = false;
+    latencyMetrics.recordBilateralSkew(-40);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.skewSampleCount);
+}
+
+void test_recordBilateralSkew_min_avg_max(void) {
+    latencyMetrics.recordBilateralSkew(-40);
+    latencyMetrics.recordBilateralSkew(100);
+    latencyMetrics.recordBilateralSkew(30);
+    TEST_ASSERT_EQUAL_INT32(-40, latencyMetrics.minSkew_us);
+    TEST_ASSERT_EQUAL_INT32(100, latencyMetrics.maxSkew_us);
+    TEST_ASSERT_EQUAL_INT32(30, latencyMetrics.getAverageSkew());
+}
+
+void test_getSkewP99Abs_no_samples_returns_zero(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getSkewP99Abs());
+    TEST_ASSERT_EQUAL_INT32(0, latencyMetrics.getAverageSkew());
+}
+
+void test_getSkewP99Abs_uses_absolute_value(void) {
+    latencyMetrics.recordBilateralSkew(-500);
+    TEST_ASSERT_EQUAL_UINT32(500, latencyMetrics.getSkewP99Abs());
+}
+
+void test_getSkewP99Abs_nearest_rank(void) {
+    // 1..100: p99 is the 99th smallest
+    for (int32_t i = 1; i <= 100; i++) {
+        latencyMetrics.recordBilateralSkew((i % 2) ? i : -i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(99, latencyMetrics.getSkewP99Abs());
+}
+
+void test_getSkewP99Abs_full_window_ignores_old_samples(void) {
+    // Old outliers roll out of the window; min/max keep them
+    for (int i = 0; i < 10; i++) {
+        latencyMetrics.recordBilateralSkew(20000);
+    }
+    for (uint32_t i = 0; i < LATENCY_SKEW_WINDOW; i++) {
+        latencyMetrics.recordBilateralSkew((int32_t)i);
+    }
+    // Window holds 0..N-1: nearest-rank p99 is rank ceil(0.99N), value rank-1
+    uint32_t rank = (99 * LATENCY_SKEW_WINDOW + 99) / 100;
+    TEST_ASSERT_EQUAL_UINT32(rank - 1, latencyMetrics.getSkewP99Abs());
+    TEST_ASSERT_EQUAL_INT32(20000, latencyMetrics.maxSkew_us);
+}
+
+void test_getSkewP99Abs_saturates(void) {
+    latencyMetrics.recordBilateralSkew(100000);
+    TEST_ASSERT_EQUAL_UINT32(UINT16_MAX, latencyMetrics.getSkewP99Abs());
+}
+
+void test_reset_clears_skew(void) {
+    latencyMetrics.recordBilateralSkew(250);
+    latencyMetrics.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.skewSampleCount);
+    TEST_ASSERT_EQUAL_INT64(0, latencyMetrics.totalSkew_us);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getSkewP99Abs());
 }
 
 // =============================================================================
@@ -281,13 +431,13 @@ void test_recordExecution_negative_min_positive_max(void) {
 void test_recordRtt_disabled_returns_early(void) {
     latencyMetrics.enabled = false;
     latencyMetrics.recordRtt(1000);
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.rttSampleCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getRttStats().rttSampleCount);
 }
 
 void test_recordRtt_updates_last_rtt(void) {
     latencyMetrics.enable();
     latencyMetrics.recordRtt(5000);
-    TEST_ASSERT_EQUAL_UINT32(5000, latencyMetrics.lastRtt_us);
+    TEST_ASSERT_EQUAL_UINT32(5000, latencyMetrics.getRttStats().lastRtt_us);
 }
 
 void test_recordRtt_accumulates_total(void) {
@@ -295,14 +445,14 @@ void test_recordRtt_accumulates_total(void) {
     latencyMetrics.recordRtt(1000);
     latencyMetrics.recordRtt(2000);
     latencyMetrics.recordRtt(3000);
-    TEST_ASSERT_EQUAL_UINT64(6000, latencyMetrics.totalRtt_us);
+    TEST_ASSERT_EQUAL_UINT64(6000, latencyMetrics.getRttStats().totalRtt_us);
 }
 
 void test_recordRtt_increments_sample_count(void) {
     latencyMetrics.enable();
     latencyMetrics.recordRtt(1000);
     latencyMetrics.recordRtt(2000);
-    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.rttSampleCount);
+    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.getRttStats().rttSampleCount);
 }
 
 void test_recordRtt_updates_min(void) {
@@ -310,7 +460,7 @@ void test_recordRtt_updates_min(void) {
     latencyMetrics.recordRtt(5000);
     latencyMetrics.recordRtt(2000);
     latencyMetrics.recordRtt(3000);
-    TEST_ASSERT_EQUAL_UINT32(2000, latencyMetrics.minRtt_us);
+    TEST_ASSERT_EQUAL_UINT32(2000, latencyMetrics.getRttStats().minRtt_us);
 }
 
 void test_recordRtt_updates_max(void) {
@@ -318,14 +468,14 @@ void test_recordRtt_updates_max(void) {
     latencyMetrics.recordRtt(2000);
     latencyMetrics.recordRtt(5000);
     latencyMetrics.recordRtt(3000);
-    TEST_ASSERT_EQUAL_UINT32(5000, latencyMetrics.maxRtt_us);
+    TEST_ASSERT_EQUAL_UINT32(5000, latencyMetrics.getRttStats().maxRtt_us);
 }
 
 void test_recordRtt_zero_value(void) {
     latencyMetrics.enable();
     latencyMetrics.recordRtt(0);
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.lastRtt_us);
-    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.minRtt_us);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getRttStats().lastRtt_us);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getRttStats().minRtt_us);
 }
 
 // =============================================================================
@@ -594,6 +744,274 @@ void test_getSyncConfidence_spread_above_20ms_returns_low(void) {
     TEST_ASSERT_EQUAL_STRING("LOW", latencyMetrics.getSyncConfidence());
 }
 
+// =============================================================================
+// HISTOGRAM TESTS
+// =============================================================================
+
+static LatencyHistogram histogram;
+
+void test_histogram_small_values_exact(void) {
+    // Below 2 * SUB_COUNT every value has its own bucket
+    for (uint32_t v = 0; v < 2 * LatencyHistogram::SUB_COUNT; v++) {
+        uint16_t i = LatencyHistogram::bucketIndex(v);
+        TEST_ASSERT_EQUAL_UINT16(v, i);
+        TEST_ASSERT_EQUAL_UINT32(v, LatencyHistogram::bucketLowest(i));
+        TEST_ASSERT_EQUAL_UINT32(v, LatencyHistogram::bucketHighest(i));
+    }
+}
+
+void test_histogram_buckets_contiguous_and_bounded(void) {
+    // Buckets tile [0, MAX_MAGNITUDE] with no gaps; width <= 1/SUB_COUNT of value
+    uint32_t expectedLowest = 0;
+    for (uint16_t i = 0; i < LatencyHistogram::BUCKETS; i++) {
+        uint32_t lo = LatencyHistogram::bucketLowest(i);
+        uint32_t hi = LatencyHistogram::bucketHighest(i);
+        TEST_ASSERT_EQUAL_UINT32(expectedLowest, lo);
+        TEST_ASSERT_EQUAL_UINT16(i, LatencyHistogram::bucketIndex(lo));
+        TEST_ASSERT_EQUAL_UINT16(i, LatencyHistogram::bucketIndex(hi));
+        TEST_ASSERT_TRUE((hi - lo) * LatencyHistogram::SUB_COUNT <= lo);
+        expectedLowest = hi + 1;
+    }
+    TEST_ASSERT_EQUAL_UINT32(LatencyHistogram::MAX_MAGNITUDE + 1, expectedLowest);
+}
+
+void test_histogram_saturates_at_top_bucket(void) {
+    TEST_ASSERT_EQUAL_UINT16(LatencyHistogram::BUCKETS - 1,
+                             LatencyHistogram::bucketIndex(UINT32_MAX));
+    histogram.reset();
+    histogram.record(10);
+    histogram.record(5000000);
+    // Top bucket is clamped to the exact max
+    TEST_ASSERT_EQUAL_INT32(5000000, histogram.getPercentile(999));
+    TEST_ASSERT_EQUAL_INT32(5000000, histogram.getMax());
+}
+
+void test_histogram_empty_returns_zero(void) {
+    histogram.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.getCount());
+    TEST_ASSERT_EQUAL_INT32(0, histogram.getPercentile(500));
+    TEST_ASSERT_EQUAL_INT32(0, histogram.getMin());
+    TEST_ASSERT_EQUAL_INT32(0, histogram.getMax());
+}
+
+void test_histogram_percentiles_nearest_rank(void) {
+    // 1..1000, all below 32 exact then within a bucket
+    histogram.reset();
+    for (int32_t v = 1; v <= 1000; v++) {
+        histogram.record(v);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000, histogram.getCount());
+    int32_t percentiles[] = {500, 900, 990, 999};
+    for (int32_t p : percentiles) {
+        int32_t got = histogram.getPercentile((uint16_t)p);
+        // Never below the true value, at most one bucket above it
+        TEST_ASSERT_TRUE(got >= p);
+        TEST_ASSERT_TRUE((got - p) * (int32_t)LatencyHistogram::SUB_COUNT <= p);
+    }
+    TEST_ASSERT_EQUAL_INT32(1, histogram.getPercentile(0));
+    TEST_ASSERT_EQUAL_INT32(1000, histogram.getPercentile(1000));
+}
+
+void test_histogram_tail_not_hidden_by_outlier(void) {
+    // One 4984us outlier in 1000 samples: p99 stays at the body, p99.9 finds it
+    histogram.reset();
+    for (int i = 0; i < 999; i++) {
+        histogram.record(20 + (i % 8));
+    }
+    histogram.record(4984);
+    TEST_ASSERT_EQUAL_INT32(27, histogram.getPercentile(990));
+    TEST_ASSERT_EQUAL_INT32(27, histogram.getPercentile(999));
+    TEST_ASSERT_EQUAL_INT32(4984, histogram.getPercentile(1000));
+
+    histogram.record(4984);
+    TEST_ASSERT_EQUAL_INT32(4984, histogram.getPercentile(999));
+}
+
+void test_histogram_negative_values(void) {
+    histogram.reset();
+    histogram.record(-3000);
+    histogram.record(-5);
+    histogram.record(0);
+    histogram.record(7);
+    TEST_ASSERT_EQUAL_INT32(-3000, histogram.getMin());
+    // -3000 shares a bucket with [-3071, -2944]: the highest (signed) end, clamped
+    int32_t p25 = histogram.getPercentile(250);
+    TEST_ASSERT_TRUE(p25 >= -3000 && p25 <= -2944);
+    TEST_ASSERT_EQUAL_INT32(-5, histogram.getPercentile(500));
+    TEST_ASSERT_EQUAL_INT32(0, histogram.getPercentile(750));
+    TEST_ASSERT_EQUAL_INT32(7, histogram.getPercentile(1000));
+}
+
+void test_histogram_int32_min_does_not_overflow(void) {
+    histogram.reset();
+    histogram.record(INT32_MIN);
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, histogram.getPercentile(500));
+}
+
+void test_histogram_record_perf(void) {
+    constexpr uint32_t ITERATIONS = 1000000;
+    histogram.reset();
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        histogram.record(static_cast<int32_t>((i * 7919u) & 0x1FFFFu));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    double recordNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / ITERATIONS;
+    printf("[PERF] LatencyHistogram::record: %.1f ns/op\n", recordNs);
+    printf("[SIZE] LatencyHistogram: %u bytes, LatencyMetrics: %u bytes\n",
+           (unsigned)sizeof(LatencyHistogram), (unsigned)sizeof(LatencyMetrics));
+    TEST_ASSERT_EQUAL_UINT32(ITERATIONS, histogram.getCount());
+}
+
+// =============================================================================
+// DRIFT DISTRIBUTION TESTS
+// =============================================================================
+
+void test_recordExecution_splits_activate_deactivate(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(100, true, 0);
+    latencyMetrics.recordExecution(200, true, 1);
+    latencyMetrics.recordExecution(-20, false, 1);
+    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.getDriftPercentiles(true).count);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.getDriftPercentiles(false).count);
+    TEST_ASSERT_EQUAL_INT32(-20, latencyMetrics.getDriftPercentiles(false).p50_us);
+    TEST_ASSERT_EQUAL_UINT32(3, latencyMetrics.getExecutionStats().sampleCount);
+}
+
+void test_recordExecution_per_finger_activate_only(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(100, true, 2);
+    latencyMetrics.recordExecution(300, false, 2);
+    latencyMetrics.recordExecution(50, true, LATENCY_NO_FINGER);
+    latencyMetrics.recordExecution(50, true, MAX_ACTUATORS);  // Out of range: ignored
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.getFingerDriftPercentiles(2).count);
+    TEST_ASSERT_EQUAL_INT32(100, latencyMetrics.getFingerDriftPercentiles(2).max_us);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getFingerDriftPercentiles(0).count);
+    TEST_ASSERT_EQUAL_UINT32(3, latencyMetrics.getDriftPercentiles(true).count);
+}
+
+void test_recordExecution_disabled_skips_histograms(void) {
+    latencyMetrics.enabled = false;
+    latencyMetrics.recordExecution(100, true, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getDriftPercentiles(true).count);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getFingerDriftPercentiles(0).count);
+}
+
+void test_recordRtt_feeds_histogram(void) {
+    latencyMetrics.enable();
+    for (uint32_t i = 0; i < 99; i++) {
+        latencyMetrics.recordRtt(15000);
+    }
+    latencyMetrics.recordRtt(60000);
+    int32_t p50 = latencyMetrics.getRttPercentiles().p50_us;
+    TEST_ASSERT_TRUE(p50 >= 15000 && p50 < 15000 + 15000 / (int32_t)LatencyHistogram::SUB_COUNT);
+    TEST_ASSERT_EQUAL_INT32(60000, latencyMetrics.getRttPercentiles().max_us);
+}
+
+void test_reset_clears_histograms(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(100, true, 3);
+    latencyMetrics.recordExecution(100, false, 3);
+    latencyMetrics.recordRtt(5000);
+    latencyMetrics.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getDriftPercentiles(true).count);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getDriftPercentiles(false).count);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getFingerDriftPercentiles(3).count);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getRttPercentiles().count);
+}
+
+// =============================================================================
+// SNAPSHOT TESTS
+// =============================================================================
+
+void test_reset_hides_shards_until_next_sample(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(700, true, 1);
+    latencyMetrics.recordSpinWait(40);
+    latencyMetrics.recordRtt(15000);
+    latencyMetrics.reset();
+
+    // Writers haven't cleared their shards yet; readers must not see old data
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getExecutionStats().spinWaitCount);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getFingerDriftPercentiles(1).count);
+    TEST_ASSERT_EQUAL_INT32(0, latencyMetrics.getDriftPercentiles(true).max_us);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getRttStats().rttSampleCount);
+
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(20, true, 1);
+    LatencyExecutionStats stats = latencyMetrics.getExecutionStats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.sampleCount);
+    TEST_ASSERT_EQUAL_INT32(20, stats.maxDrift_us);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.spinWaitCount);
+    TEST_ASSERT_EQUAL_UINT32(1, latencyMetrics.getFingerDriftPercentiles(1).count);
+}
+
+void test_getFingerDriftPercentiles_out_of_range(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordExecution(20, true, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, latencyMetrics.getFingerDriftPercentiles(MAX_ACTUATORS).count);
+}
+
+void test_snapshots_consistent_under_concurrent_writers(void) {
+    // Motor task and BLE callback stand-ins record 1, 2, 3, ... while the
+    // loop() stand-in snapshots. Any torn read breaks one of the identities
+    // below (sum = n(n+1)/2, last = max = n, percentile count = max).
+    constexpr uint32_t SAMPLES = 2000000;
+    latencyMetrics.enable();
+
+    std::atomic<bool> motorDone(false);
+    std::atomic<bool> bleDone(false);
+    std::thread motorTask([&]() {
+        for (uint32_t i = 1; i <= SAMPLES; i++) {
+            latencyMetrics.recordExecution((int32_t)i, true, (uint8_t)(i % MAX_ACTUATORS));
+        }
+        motorDone.store(true);
+    });
+    std::thread bleCallback([&]() {
+        for (uint32_t i = 1; i <= SAMPLES; i++) {
+            latencyMetrics.recordRtt(i);
+        }
+        bleDone.store(true);
+    });
+
+    uint32_t snapshots = 0;
+    uint32_t torn = 0;
+    while (!motorDone.load() || !bleDone.load()) {
+        LatencyExecutionStats exec = latencyMetrics.getExecutionStats();
+        uint64_t n = exec.sampleCount;
+        if (n > 0 && ((uint64_t)exec.totalDrift_us != n * (n + 1) / 2 ||
+                      (uint64_t)exec.lastDrift_us != n || (uint64_t)exec.maxDrift_us != n ||
+                      exec.minDrift_us != 1 ||
+                      exec.lateCount != (n > LATENCY_LATE_THRESHOLD_US ? n - LATENCY_LATE_THRESHOLD_US : 0))) {
+            torn++;
+        }
+
+        LatencyRttStats rtt = latencyMetrics.getRttStats();
+        uint64_t m = rtt.rttSampleCount;
+        if (m > 0 && (rtt.totalRtt_us != m * (m + 1) / 2 ||
+                      rtt.lastRtt_us != m || rtt.maxRtt_us != m || rtt.minRtt_us != 1)) {
+            torn++;
+        }
+
+        LatencyPercentiles drift = latencyMetrics.getDriftPercentiles(true);
+        if (drift.count > 0 && ((uint32_t)drift.max_us != drift.count || drift.min_us != 1 ||
+                                drift.p50_us > drift.p90_us || drift.p90_us > drift.p99_us ||
+                                drift.p99_us > drift.p999_us || drift.p999_us > drift.max_us)) {
+            torn++;
+        }
+        snapshots++;
+    }
+    motorTask.join();
+    bleCallback.join();
+
+    printf("[STRESS] LatencyMetrics: %lu snapshots during %lu + %lu concurrent samples, %lu torn\n",
+           (unsigned long)snapshots, (unsigned long)SAMPLES, (unsigned long)SAMPLES,
+           (unsigned long)torn);
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(SAMPLES, latencyMetrics.getExecutionStats().sampleCount);
+    TEST_ASSERT_EQUAL_UINT32(SAMPLES, latencyMetrics.getRttStats().rttSampleCount);
+}
+
 // =============================================================================
 // PRINT REPORT TESTS (verify it doesn't crash, output not captured)
 // =============================================================================
@@ -619,6 +1037,21 @@ void test_printReport_with_rtt_data_no_crash(void) {
     TEST_PASS();
 }
 
+void test_printReport_with_idle_step_data_no_crash(void) {
+    latencyMetrics.enable();
+    latencyMetrics.recordIdleStep(90, true);
+    latencyMetrics.recordIdleStep(650, false);
+    latencyMetrics.printReport();
+    TEST_PASS();
+}
+
+void test_printReport_with_skew_data_no_crash(void) {
+    latencyMetrics.recordBilateralSkew(-35);
+    latencyMetrics.recordBilateralSkew(80);
+    latencyMetrics.printReport();
+    TEST_PASS();
+}
+
 void test_printReport_with_sync_data_no_crash(void) {
     latencyMetrics.recordSyncProbe(5000);
     latencyMetrics.recordSyncProbe(8000);
@@ -640,6 +1073,17 @@ void test_printReport_with_all_data_no_crash(void) {
     TEST_PASS();
 }
 
+void test_printReport_with_distribution_data_no_crash(void) {
+    latencyMetrics.enable();
+    for (int32_t i = 0; i < 200; i++) {
+        latencyMetrics.recordExecution(40 + i, true, (uint8_t)(i % MAX_ACTUATORS));
+        latencyMetrics.recordExecution(-10 + i, false, (uint8_t)(i % MAX_ACTUATORS));
+    }
+    latencyMetrics.recordRtt(15000);
+    latencyMetrics.printReport();
+    TEST_PASS();
+}
+
 void test_printReport_verbose_mode_no_crash(void) {
     latencyMetrics.enable(true);
     latencyMetrics.recordExecution(100);
@@ -652,7 +1096,7 @@ void test_printReport_early_count_displayed(void) {
     latencyMetrics.recordExecution(-100);
     latencyMetrics.recordExecution(-50);
     latencyMetrics.printReport();
-    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.earlyCount);
+    TEST_ASSERT_EQUAL_UINT32(2, latencyMetrics.getExecutionStats().earlyCount);
 }
 
 // =============================================================================
@@ -702,6 +1146,28 @@ int main(int argc, char **argv) {
     RUN_TEST(test_recordExecution_zero_drift_not_early);
     RUN_TEST(test_recordExecution_negative_min_positive_max);
 
+    // Record Spin Wait Tests
+    RUN_TEST(test_recordSpinWait_disabled_returns_early);
+    RUN_TEST(test_recordSpinWait_accumulates_and_tracks_max);
+    RUN_TEST(test_getAverageSpinWait_no_samples_returns_zero);
+    RUN_TEST(test_reset_clears_spin_wait);
+
+    // Record Idle Step Tests
+    RUN_TEST(test_recordIdleStep_disabled_returns_early);
+    RUN_TEST(test_recordIdleStep_splits_precomputed_and_inline);
+    RUN_TEST(test_getAverageIdleStep_no_samples_returns_zero);
+    RUN_TEST(test_reset_clears_idle_step);
+
+    // Record Bilateral Skew Tests
+    RUN_TEST(test_recordBilateralSkew_records_when_disabled);
+    RUN_TEST(test_recordBilateralSkew_min_avg_max);
+    RUN_TEST(test_getSkewP99Abs_no_samples_returns_zero);
+    RUN_TEST(test_getSkewP99Abs_uses_absolute_value);
+    RUN_TEST(test_getSkewP99Abs_nearest_rank);
+    RUN_TEST(test_getSkewP99Abs_full_window_ignores_old_samples);
+    RUN_TEST(test_getSkewP99Abs_saturates);
+    RUN_TEST(test_reset_clears_skew);
+
     // Record RTT Tests
     RUN_TEST(test_recordRtt_disabled_returns_early);
     RUN_TEST(test_recordRtt_updates_last_rtt);
@@ -760,12 +1226,38 @@ int main(int argc, char **argv) {
     RUN_TEST(test_getSyncConfidence_spread_at_20000_returns_low);
     RUN_TEST(test_getSyncConfidence_spread_above_20ms_returns_low);
 
+    // Histogram Tests
+    RUN_TEST(test_histogram_small_values_exact);
+    RUN_TEST(test_histogram_buckets_contiguous_and_bounded);
+    RUN_TEST(test_histogram_saturates_at_top_bucket);
+    RUN_TEST(test_histogram_empty_returns_zero);
+    RUN_TEST(test_histogram_percentiles_nearest_rank);
+    RUN_TEST(test_histogram_tail_not_hidden_by_outlier);
+    RUN_TEST(test_histogram_negative_values);
+    RUN_TEST(test_histogram_int32_min_does_not_overflow);
+    RUN_TEST(test_histogram_record_perf);
+
+    // Drift Distribution Tests
+    RUN_TEST(test_recordExecution_splits_activate_deactivate);
+    RUN_TEST(test_recordExecution_per_finger_activate_only);
+    RUN_TEST(test_recordExecution_disabled_skips_histograms);
+    RUN_TEST(test_recordRtt_feeds_histogram);
+    RUN_TEST(test_reset_clears_histograms);
+
+    // Snapshot Tests
+    RUN_TEST(test_reset_hides_shards_until_next_sample);
+    RUN_TEST(test_getFingerDriftPercentiles_out_of_range);
+    RUN_TEST(test_snapshots_consistent_under_concurrent_writers);
+
     // Print Report Tests
     RUN_TEST(test_printReport_empty_metrics_no_crash);
     RUN_TEST(test_printReport_with_execution_data_no_crash);
     RUN_TEST(test_printReport_with_rtt_data_no_crash);
+    RUN_TEST(test_printReport_with_idle_step_data_no_crash);
+    RUN_TEST(test_printReport_with_skew_data_no_crash);
     RUN_TEST(test_printReport_with_sync_data_no_crash);
     RUN_TEST(test_printReport_with_all_data_no_crash);
+    RUN_TEST(test_printReport_with_distribution_data_no_crash);
     RUN_TEST(test_printReport_verbose_mode_no_crash);
     RUN_TEST(test_printReport_early_count_displayed);
 
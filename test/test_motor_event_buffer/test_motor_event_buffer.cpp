@@ -4,6 +4,8 @@
  */
 
 #include <unity.h>
+#include <atomic>
+#include <thread>
 #include "motor_event_buffer.h"
 
 // =============================================================================
@@ -339,6 +341,132 @@ void test_MotorEventBuffer_stage_zero_values(void) {
     TEST_ASSERT_FALSE(event.isMacrocycleLast);
 }
 
+// =============================================================================
+// MACROCYCLE BOUNDARY TAGGING
+// =============================================================================
+
+void test_MotorEventBuffer_beginMacrocycle_tags_first_event(void) {
+    buffer.beginMacrocycle();
+    buffer.stage(1000, 0, 100, 50, 250, false);
+    buffer.stage(2000, 1, 100, 50, 250, true);
+
+    StagedMotorEvent event;
+    TEST_ASSERT_TRUE(buffer.unstage(event));
+    TEST_ASSERT_TRUE(event.isMacrocycleFirst);
+    TEST_ASSERT_TRUE(buffer.unstage(event));
+    TEST_ASSERT_FALSE(event.isMacrocycleFirst);
+}
+
+void test_MotorEventBuffer_untagged_without_beginMacrocycle(void) {
+    buffer.stage(1000, 0, 100, 50, 250, false);
+
+    StagedMotorEvent event;
+    TEST_ASSERT_TRUE(buffer.unstage(event));
+    TEST_ASSERT_FALSE(event.isMacrocycleFirst);
+}
+
+void test_MotorEventBuffer_second_macrocycle_tagged_after_partial_drain(void) {
+    // Consumer drains part of batch A, producer then stages batch B.
+    // Only B's first event may carry the boundary tag - A's remaining
+    // events must not be wiped by an early clear.
+    buffer.beginMacrocycle();
+    buffer.stage(1000, 0, 100, 50, 250, false);
+    buffer.stage(2000, 1, 100, 50, 250, true);
+
+    StagedMotorEvent event;
+    buffer.unstage(event);
+
+    buffer.beginMacrocycle();
+    buffer.stage(3000, 2, 100, 50, 250, true);
+
+    TEST_ASSERT_TRUE(buffer.unstage(event));
+    TEST_ASSERT_EQUAL_UINT64(2000, event.activateTimeUs);
+    TEST_ASSERT_FALSE(event.isMacrocycleFirst);
+    TEST_ASSERT_TRUE(buffer.unstage(event));
+    TEST_ASSERT_EQUAL_UINT64(3000, event.activateTimeUs);
+    TEST_ASSERT_TRUE(event.isMacrocycleFirst);
+}
+
+// =============================================================================
+// CONCURRENCY STRESS (producer/consumer on separate threads)
+// =============================================================================
+
+// All fields are derived from the sequence number so a torn slot (fields
+// from two different writes) is detected on the consumer side.
+static const uint32_t STRESS_EVENT_COUNT = 1000000;
+
+static uint8_t stressFinger(uint32_t seq) { return static_cast<uint8_t>(seq & 0x03); }
+static uint8_t stressAmplitude(uint32_t seq) { return static_cast<uint8_t>((seq >> 2) & 0xFF); }
+static uint16_t stressDuration(uint32_t seq) { return static_cast<uint16_t>(seq ^ 0xA5A5); }
+static uint16_t stressFrequency(uint32_t seq) { return static_cast<uint16_t>(seq >> 8); }
+
+void test_MotorEventBuffer_spsc_stress_two_threads(void) {
+    std::atomic<bool> producerDone(false);
+    uint32_t producerRetries = 0;
+
+    std::thread producer([&]() {
+        for (uint32_t seq = 0; seq < STRESS_EVENT_COUNT; seq++) {
+            if ((seq % 12) == 0) {
+                buffer.beginMacrocycle();
+            }
+            bool isLast = (seq % 12) == 11;
+            while (!buffer.stage(seq, stressFinger(seq), stressAmplitude(seq),
+                                 stressDuration(seq), stressFrequency(seq), isLast)) {
+                producerRetries++;
+                std::this_thread::yield();
+            }
+        }
+        producerDone.store(true, std::memory_order_release);
+    });
+
+    uint32_t received = 0;
+    uint32_t orderErrors = 0;
+    uint32_t tornErrors = 0;
+    uint32_t boundaryErrors = 0;
+
+    std::thread consumer([&]() {
+        StagedMotorEvent event;
+        while (received < STRESS_EVENT_COUNT) {
+            if (!buffer.unstage(event)) {
+                if (producerDone.load(std::memory_order_acquire) && !buffer.hasPending()) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            uint32_t seq = static_cast<uint32_t>(event.activateTimeUs);
+            if (seq != received) {
+                orderErrors++;
+            }
+            if (event.finger != stressFinger(seq) ||
+                event.amplitude != stressAmplitude(seq) ||
+                event.durationMs != stressDuration(seq) ||
+                event.frequencyHz != stressFrequency(seq) ||
+                event.isMacrocycleLast != ((seq % 12) == 11)) {
+                tornErrors++;
+            }
+            if (event.isMacrocycleFirst != ((seq % 12) == 0)) {
+                boundaryErrors++;
+            }
+            received++;
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    printf("[STRESS] SPSC: %u events, %u producer retries (buffer full)\n",
+           (unsigned)received, (unsigned)producerRetries);
+
+    TEST_ASSERT_EQUAL_UINT32(STRESS_EVENT_COUNT, received);
+    TEST_ASSERT_EQUAL_UINT32(0, orderErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, tornErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, boundaryErrors);
+    TEST_ASSERT_FALSE(buffer.hasPending());
+    TEST_ASSERT_FALSE(buffer.isMacrocyclePending());
+}
+
 // =============================================================================
 // TEST RUNNER
 // =============================================================================
@@ -384,5 +512,13 @@ int main(int argc, char **argv) {
     RUN_TEST(test_MotorEventBuffer_stage_max_values);
     RUN_TEST(test_MotorEventBuffer_stage_zero_values);
 
+    // Macrocycle boundary tagging
+    RUN_TEST(test_MotorEventBuffer_beginMacrocycle_tags_first_event);
+    RUN_TEST(test_MotorEventBuffer_untagged_without_beginMacrocycle);
+    RUN_TEST(test_MotorEventBuffer_second_macrocycle_tagged_after_partial_drain);
+
+    // Concurrency stress
+    RUN_TEST(test_MotorEventBuffer_spsc_stress_two_threads);
+
     return UNITY_END();
 }
@@ -0,0 +1,437 @@
+/**
+ * @file test_motor_event_heap.cpp
+ * @brief Unit tests and microbenchmark for MotorEventHeap (ActivationQueue backing store)
+ */
+
+#include <unity.h>
+#include <chrono>
+#include "motor_event_heap.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static MotorEventHeap heap;
+
+void setUp(void) {
+    heap.clear();
+}
+
+void tearDown(void) {
+    heap.clear();
+}
+
+static MotorEvent makeEvent(uint64_t timeUs, uint8_t finger,
+                            MotorEventType type = MotorEventType::ACTIVATE) {
+    MotorEvent event;
+    event.timeUs = timeUs;
+    event.finger = finger;
+    event.amplitude = (type == MotorEventType::ACTIVATE) ? 100 : 0;
+    event.frequencyHz = (type == MotorEventType::ACTIVATE) ? 250 : 0;
+    event.type = type;
+    return event;
+}
+
+// =============================================================================
+// LEGACY LINEAR-SCAN REFERENCE
+// =============================================================================
+
+/**
+ * Mirror of the pre-heap ActivationQueue storage: 32 slots, first-free insert,
+ * full scan for the earliest active event. Used as the correctness reference
+ * and the benchmark baseline.
+ */
+struct LinearScanQueue {
+    MotorEvent events[MotorEventHeap::CAPACITY];
+
+    void clear() {
+        for (uint8_t i = 0; i < MotorEventHeap::CAPACITY; i++) {
+            events[i].clear();
+        }
+    }
+
+    int8_t findEmptySlot() const {
+        for (uint8_t i = 0; i < MotorEventHeap::CAPACITY; i++) {
+            if (!events[i].active) {
+                return static_cast<int8_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    int8_t findNextEvent() const {
+        int8_t earliestIdx = -1;
+        uint64_t earliestTime = UINT64_MAX;
+        for (uint8_t i = 0; i < MotorEventHeap::CAPACITY; i++) {
+            if (events[i].active && events[i].timeUs < earliestTime) {
+                earliestTime = events[i].timeUs;
+                earliestIdx = static_cast<int8_t>(i);
+            }
+        }
+        return earliestIdx;
+    }
+
+    bool push(const MotorEvent& event) {
+        int8_t slot = findEmptySlot();
+        if (slot < 0) {
+            return false;
+        }
+        events[slot] = event;
+        events[slot].active = true;
+        return true;
+    }
+
+    bool peek(MotorEvent& event) const {
+        int8_t idx = findNextEvent();
+        if (idx < 0) {
+            return false;
+        }
+        event = events[idx];
+        return true;
+    }
+
+    bool pop(MotorEvent& event) {
+        int8_t idx = findNextEvent();
+        if (idx < 0) {
+            return false;
+        }
+        event = events[idx];
+        events[idx].clear();
+        return true;
+    }
+};
+
+// Deterministic LCG so benchmark workloads are reproducible
+static uint32_t lcgState = 1;
+static uint32_t lcgNext() {
+    lcgState = lcgState * 1664525u + 1013904223u;
+    return lcgState;
+}
+
+// =============================================================================
+// BASIC OPERATIONS
+// =============================================================================
+
+void test_MotorEventHeap_initial_state_empty(void) {
+    MotorEventHeap fresh;
+    TEST_ASSERT_TRUE(fresh.isEmpty());
+    TEST_ASSERT_EQUAL_UINT8(0, fresh.size());
+    TEST_ASSERT_EQUAL_UINT8(MotorEventHeap::CAPACITY, fresh.available());
+    TEST_ASSERT_NULL(fresh.peek());
+}
+
+void test_MotorEventHeap_pop_empty_returns_false(void) {
+    MotorEvent event;
+    TEST_ASSERT_FALSE(heap.pop(event));
+}
+
+void test_MotorEventHeap_push_sets_active(void) {
+    MotorEvent event = makeEvent(1000, 2);
+    event.active = false;
+    TEST_ASSERT_TRUE(heap.push(event));
+
+    const MotorEvent* next = heap.peek();
+    TEST_ASSERT_NOT_NULL(next);
+    TEST_ASSERT_TRUE(next->active);
+    TEST_ASSERT_EQUAL_UINT64(1000, next->timeUs);
+    TEST_ASSERT_EQUAL_UINT8(2, next->finger);
+}
+
+void test_MotorEventHeap_pops_in_time_order(void) {
+    const uint64_t times[] = {5000, 1000, 4000, 2000, 3000, 6000, 500};
+    for (uint8_t i = 0; i < 7; i++) {
+        heap.push(makeEvent(times[i], i));
+    }
+
+    uint64_t last = 0;
+    MotorEvent event;
+    uint8_t popped = 0;
+    while (heap.pop(event)) {
+        TEST_ASSERT_TRUE(event.timeUs >= last);
+        last = event.timeUs;
+        popped++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(7, popped);
+    TEST_ASSERT_TRUE(heap.isEmpty());
+}
+
+void test_MotorEventHeap_peek_does_not_remove(void) {
+    heap.push(makeEvent(2000, 1));
+    heap.push(makeEvent(1000, 0));
+
+    TEST_ASSERT_EQUAL_UINT64(1000, heap.peek()->timeUs);
+    TEST_ASSERT_EQUAL_UINT64(1000, heap.peek()->timeUs);
+    TEST_ASSERT_EQUAL_UINT8(2, heap.size());
+}
+
+void test_MotorEventHeap_full_rejects_push(void) {
+    for (uint8_t i = 0; i < MotorEventHeap::CAPACITY; i++) {
+        TEST_ASSERT_TRUE(heap.push(makeEvent(1000 + i, 0)));
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, heap.available());
+    TEST_ASSERT_FALSE(heap.push(makeEvent(1, 0)));
+
+    // Rejected event must not have displaced the root
+    TEST_ASSERT_EQUAL_UINT64(1000, heap.peek()->timeUs);
+}
+
+void test_MotorEventHeap_clear(void) {
+    heap.push(makeEvent(1000, 0));
+    heap.push(makeEvent(2000, 1));
+    heap.clear();
+
+    TEST_ASSERT_TRUE(heap.isEmpty());
+    TEST_ASSERT_NULL(heap.peek());
+}
+
+// =============================================================================
+// STABLE ORDERING
+// =============================================================================
+
+void test_MotorEventHeap_equal_times_fifo(void) {
+    // Same-microsecond events must come out in enqueue order
+    for (uint8_t i = 0; i < 10; i++) {
+        heap.push(makeEvent(5000, i));
+    }
+
+    MotorEvent event;
+    for (uint8_t i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(heap.pop(event));
+        TEST_ASSERT_EQUAL_UINT8(i, event.finger);
+    }
+}
+
+void test_MotorEventHeap_deactivate_before_activate_at_same_time(void) {
+    // Back-to-back pattern: F0 OFF and F1 ON share a timestamp
+    heap.push(makeEvent(0, 0, MotorEventType::ACTIVATE));
+    heap.push(makeEvent(100000, 0, MotorEventType::DEACTIVATE));
+    heap.push(makeEvent(100000, 1, MotorEventType::ACTIVATE));
+    heap.push(makeEvent(200000, 1, MotorEventType::DEACTIVATE));
+
+    MotorEvent event;
+    heap.pop(event);
+    heap.pop(event);
+    TEST_ASSERT_EQUAL(MotorEventType::DEACTIVATE, event.type);
+    TEST_ASSERT_EQUAL_UINT8(0, event.finger);
+    heap.pop(event);
+    TEST_ASSERT_EQUAL(MotorEventType::ACTIVATE, event.type);
+    TEST_ASSERT_EQUAL_UINT8(1, event.finger);
+}
+
+void test_MotorEventHeap_fifo_survives_interleaved_pops(void) {
+    heap.push(makeEvent(100, 0));
+    heap.push(makeEvent(9000, 1));
+    MotorEvent event;
+    heap.pop(event);
+
+    for (uint8_t i = 2; i < 8; i++) {
+        heap.push(makeEvent(9000, i));
+    }
+
+    for (uint8_t i = 1; i < 8; i++) {
+        TEST_ASSERT_TRUE(heap.pop(event));
+        TEST_ASSERT_EQUAL_UINT8(i, event.finger);
+    }
+}
+
+void test_MotorEventHeap_matches_linear_scan(void) {
+    // Randomized interleaved push/pop with distinct times: heap and legacy
+    // scan must dequeue identical sequences
+    LinearScanQueue legacy;
+    legacy.clear();
+    lcgState = 12345;
+
+    uint32_t compared = 0;
+    for (uint32_t round = 0; round < 5000; round++) {
+        uint32_t r = lcgNext();
+        bool doPush = (r & 1) != 0 && heap.available() > 0;
+        if (doPush || heap.isEmpty()) {
+            // Unique times: high bits random, low bits = round
+            uint64_t t = (static_cast<uint64_t>(r >> 8) << 16) | (round & 0xFFFF);
+            MotorEvent e = makeEvent(t, static_cast<uint8_t>(round & 3));
+            TEST_ASSERT_TRUE(heap.push(e));
+            TEST_ASSERT_TRUE(legacy.push(e));
+        } else {
+            MotorEvent a, b;
+            TEST_ASSERT_TRUE(heap.pop(a));
+            TEST_ASSERT_TRUE(legacy.pop(b));
+            TEST_ASSERT_EQUAL_UINT64(b.timeUs, a.timeUs);
+            TEST_ASSERT_EQUAL_UINT8(b.finger, a.finger);
+            compared++;
+        }
+    }
+    TEST_ASSERT_TRUE(compared > 1000);
+}
+
+// =============================================================================
+// COALESCING (popWithin)
+// =============================================================================
+
+void test_MotorEventHeap_popWithin_empty_returns_zero(void) {
+    MotorEvent out[4];
+    TEST_ASSERT_EQUAL_UINT8(0, heap.popWithin(out, 4, 500));
+}
+
+void test_MotorEventHeap_popWithin_merges_boundary(void) {
+    // DEACTIVATE F0 and ACTIVATE F1 300us apart, next event far away
+    heap.push(makeEvent(100000, 0, MotorEventType::DEACTIVATE));
+    heap.push(makeEvent(100300, 1, MotorEventType::ACTIVATE));
+    heap.push(makeEvent(200000, 1, MotorEventType::DEACTIVATE));
+
+    MotorEvent out[4];
+    uint8_t n = heap.popWithin(out, 4, 500);
+    TEST_ASSERT_EQUAL_UINT8(2, n);
+    TEST_ASSERT_EQUAL(MotorEventType::DEACTIVATE, out[0].type);
+    TEST_ASSERT_EQUAL_UINT64(100300, out[1].timeUs);
+    TEST_ASSERT_EQUAL_UINT8(1, heap.size());
+}
+
+void test_MotorEventHeap_popWithin_window_is_inclusive(void) {
+    heap.push(makeEvent(1000, 0));
+    heap.push(makeEvent(1500, 1));
+    heap.push(makeEvent(1501, 2));
+
+    MotorEvent out[4];
+    TEST_ASSERT_EQUAL_UINT8(2, heap.popWithin(out, 4, 500));
+    TEST_ASSERT_EQUAL_UINT64(1501, heap.peek()->timeUs);
+}
+
+void test_MotorEventHeap_popWithin_respects_max_count(void) {
+    for (uint8_t i = 0; i < 6; i++) {
+        heap.push(makeEvent(1000, i));
+    }
+
+    MotorEvent out[4];
+    TEST_ASSERT_EQUAL_UINT8(4, heap.popWithin(out, 4, 0));
+    TEST_ASSERT_EQUAL_UINT8(3, out[3].finger);
+    TEST_ASSERT_EQUAL_UINT8(2, heap.size());
+}
+
+void test_MotorEventHeap_popWithin_zero_window_single_event(void) {
+    heap.push(makeEvent(1000, 0));
+    heap.push(makeEvent(1001, 1));
+
+    MotorEvent out[4];
+    TEST_ASSERT_EQUAL_UINT8(1, heap.popWithin(out, 4, 0));
+}
+
+// =============================================================================
+// BENCHMARK (heap vs legacy linear scan)
+// =============================================================================
+
+/**
+ * Motor-task access pattern per event: peekNextEvent (sleep target),
+ * peekNextEvent (recheck after wake), dequeueNextEvent.
+ */
+template <typename Queue, typename PeekFn>
+static uint64_t drainLikeMotorTask(Queue& q, PeekFn peekTime) {
+    uint64_t checksum = 0;
+    MotorEvent event;
+    for (;;) {
+        uint64_t t1 = peekTime(q);
+        if (t1 == UINT64_MAX) {
+            break;
+        }
+        uint64_t t2 = peekTime(q);
+        q.pop(event);
+        checksum += t1 ^ t2 ^ event.timeUs;
+    }
+    return checksum;
+}
+
+static void benchmarkAtDepth(uint8_t depth) {
+    constexpr uint32_t ITERATIONS = 20000;
+
+    // Pre-generate one macrocycle-like batch (activation/deactivation pairs)
+    MotorEvent batch[MotorEventHeap::CAPACITY];
+    lcgState = depth;
+    for (uint8_t i = 0; i < depth; i++) {
+        uint64_t base = static_cast<uint64_t>(i / 2) * 167000ULL + (lcgNext() % 30000);
+        batch[i] = makeEvent(base + ((i & 1) ? 100000ULL : 0), static_cast<uint8_t>(i & 3),
+                             (i & 1) ? MotorEventType::DEACTIVATE : MotorEventType::ACTIVATE);
+    }
+
+    LinearScanQueue legacy;
+    legacy.clear();
+    uint64_t legacySum = 0;
+    uint64_t heapSum = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t it = 0; it < ITERATIONS; it++) {
+        for (uint8_t i = 0; i < depth; i++) {
+            legacy.push(batch[i]);
+        }
+        legacySum += drainLikeMotorTask(legacy, [](const LinearScanQueue& q) {
+            MotorEvent e;
+            return q.peek(e) ? e.timeUs : UINT64_MAX;
+        });
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t it = 0; it < ITERATIONS; it++) {
+        for (uint8_t i = 0; i < depth; i++) {
+            heap.push(batch[i]);
+        }
+        heapSum += drainLikeMotorTask(heap, [](const MotorEventHeap& q) {
+            const MotorEvent* e = q.peek();
+            return e ? e->timeUs : UINT64_MAX;
+        });
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    TEST_ASSERT_EQUAL_UINT64(legacySum, heapSum);
+
+    double opsPerIter = depth * 4.0;  // push + peek + peek + pop per event
+    double scanNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / (ITERATIONS * opsPerIter);
+    double heapNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / (ITERATIONS * opsPerIter);
+    printf("[PERF] ActivationQueue %2u events: linear scan=%.1f ns/op, heap=%.1f ns/op (%.1fx)\n",
+           depth, scanNs, heapNs, heapNs > 0 ? scanNs / heapNs : 0.0);
+}
+
+void test_MotorEventHeap_benchmark_vs_linear_scan(void) {
+    benchmarkAtDepth(12);
+    benchmarkAtDepth(24);
+    benchmarkAtDepth(32);
+}
+
+void test_MotorEventHeap_footprint(void) {
+    printf("[SIZE] MotorEventHeap: %u bytes (legacy MotorEvent[32]: %u bytes)\n",
+           (unsigned)sizeof(MotorEventHeap),
+           (unsigned)(sizeof(MotorEvent) * MotorEventHeap::CAPACITY));
+    TEST_ASSERT_TRUE(sizeof(MotorEventHeap) <= sizeof(MotorEvent) * MotorEventHeap::CAPACITY + 4 * MotorEventHeap::CAPACITY + 16);
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Basic operations
+    RUN_TEST(test_MotorEventHeap_initial_state_empty);
+    RUN_TEST(test_MotorEventHeap_pop_empty_returns_false);
+    RUN_TEST(test_MotorEventHeap_push_sets_active);
+    RUN_TEST(test_MotorEventHeap_pops_in_time_order);
+    RUN_TEST(test_MotorEventHeap_peek_does_not_remove);
+    RUN_TEST(test_MotorEventHeap_full_rejects_push);
+    RUN_TEST(test_MotorEventHeap_clear);
+
+    // Stable ordering
+    RUN_TEST(test_MotorEventHeap_equal_times_fifo);
+    RUN_TEST(test_MotorEventHeap_deactivate_before_activate_at_same_time);
+    RUN_TEST(test_MotorEventHeap_fifo_survives_interleaved_pops);
+    RUN_TEST(test_MotorEventHeap_matches_linear_scan);
+
+    // Coalescing
+    RUN_TEST(test_MotorEventHeap_popWithin_empty_returns_zero);
+    RUN_TEST(test_MotorEventHeap_popWithin_merges_boundary);
+    RUN_TEST(test_MotorEventHeap_popWithin_window_is_inclusive);
+    RUN_TEST(test_MotorEventHeap_popWithin_respects_max_count);
+    RUN_TEST(test_MotorEventHeap_popWithin_zero_window_single_event);
+
+    // Benchmark
+    RUN_TEST(test_MotorEventHeap_benchmark_vs_linear_scan);
+    RUN_TEST(test_MotorEventHeap_footprint);
+
+    return UNITY_END();
+}
@@ -0,0 +1,180 @@
+/**
+ * @file test_prng.cpp
+ * @brief Unit tests for Prng (seedable xoshiro128++)
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include "prng.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// =============================================================================
+// SEEDING TESTS
+// =============================================================================
+
+void test_Prng_same_seed_same_sequence(void) {
+    Prng a(0x123456789ABCDEFULL);
+    Prng b(0x123456789ABCDEFULL);
+
+    for (int i = 0; i < 1000; i++) {
+        TEST_ASSERT_EQUAL_UINT32(a.next(), b.next());
+    }
+}
+
+void test_Prng_reseed_restarts_sequence(void) {
+    Prng rng(42);
+    uint32_t first = rng.next();
+    rng.next();
+    rng.seed(42);
+
+    TEST_ASSERT_EQUAL_UINT32(first, rng.next());
+}
+
+void test_Prng_zero_seed_is_usable(void) {
+    // SplitMix64 expansion never leaves xoshiro in the all-zero state
+    Prng rng(0);
+    uint32_t orBits = 0;
+    for (int i = 0; i < 16; i++) {
+        orBits |= rng.next();
+    }
+    TEST_ASSERT_NOT_EQUAL(0, orBits);
+}
+
+void test_Prng_adjacent_seeds_diverge(void) {
+    Prng a(1000);
+    Prng b(1001);
+    int equal = 0;
+    for (int i = 0; i < 1000; i++) {
+        if (a.next() == b.next()) {
+            equal++;
+        }
+    }
+    TEST_ASSERT_TRUE(equal <= 1);
+}
+
+// =============================================================================
+// STREAM TESTS
+// =============================================================================
+
+void test_Prng_forStream_is_random_access(void) {
+    // Stream N doesn't depend on having drawn streams 0..N-1
+    Prng late = Prng::forStream(77, 500);
+    for (uint32_t s = 0; s < 500; s++) {
+        Prng::forStream(77, s).next();
+    }
+    Prng again = Prng::forStream(77, 500);
+
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL_UINT32(late.next(), again.next());
+    }
+}
+
+void test_Prng_forStream_streams_are_distinct(void) {
+    // First draws of neighbouring streams and seeds must not collide
+    constexpr uint32_t STREAMS = 2000;
+    uint32_t firsts[STREAMS];
+    for (uint32_t s = 0; s < STREAMS; s++) {
+        firsts[s] = Prng::forStream(9, s).next();
+    }
+    int collisions = 0;
+    for (uint32_t i = 0; i < STREAMS; i++) {
+        for (uint32_t j = i + 1; j < STREAMS; j++) {
+            if (firsts[i] == firsts[j]) {
+                collisions++;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, collisions);
+    TEST_ASSERT_NOT_EQUAL(Prng::forStream(9, 0).next(), Prng::forStream(10, 0).next());
+    TEST_ASSERT_NOT_EQUAL(Prng::forStream(0, 1).next(), Prng::forStream(1, 0).next());
+}
+
+// =============================================================================
+// RANGE TESTS
+// =============================================================================
+
+void test_Prng_range_stays_in_bounds(void) {
+    Prng rng(5);
+    for (int i = 0; i < 100000; i++) {
+        long v = rng.range(-1000, 1001);
+        TEST_ASSERT_TRUE(v >= -1000 && v <= 1000);
+    }
+}
+
+void test_Prng_range_empty_returns_min(void) {
+    Prng rng(5);
+    TEST_ASSERT_EQUAL_INT32(7, rng.range(7, 7));
+    TEST_ASSERT_EQUAL_INT32(7, rng.range(7, 3));
+}
+
+void test_Prng_range_hits_every_value(void) {
+    // Fisher-Yates over 4 fingers draws range(0, i + 1); every index must occur
+    Prng rng(11);
+    uint32_t counts[4] = {0};
+    constexpr uint32_t DRAWS = 40000;
+    for (uint32_t i = 0; i < DRAWS; i++) {
+        counts[rng.range(0, 4)]++;
+    }
+    for (int v = 0; v < 4; v++) {
+        // Expect 10000 each; 5 sigma is about +/-435
+        TEST_ASSERT_UINT32_WITHIN(500, DRAWS / 4, counts[v]);
+    }
+}
+
+void test_Prng_below_unbiased_for_large_bound(void) {
+    // bound = 3 * 2^30: next() % bound would return values below 2^30 half
+    // the time (2^32 wraps onto them), an unbiased draw a third of the time
+    constexpr uint32_t BOUND = 0xC0000000u;
+    constexpr uint32_t DRAWS = 90000;
+    Prng rng(3);
+    uint32_t low = 0;
+    for (uint32_t i = 0; i < DRAWS; i++) {
+        uint32_t v = rng.below(BOUND);
+        TEST_ASSERT_TRUE(v < BOUND);
+        if (v < 0x40000000u) {
+            low++;
+        }
+    }
+    // Expect 30000; 5 sigma is about +/-700
+    TEST_ASSERT_UINT32_WITHIN(700, DRAWS / 3, low);
+}
+
+void test_Prng_below_degenerate_bounds(void) {
+    Prng rng(3);
+    TEST_ASSERT_EQUAL_UINT32(0, rng.below(0));
+    TEST_ASSERT_EQUAL_UINT32(0, rng.below(1));
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Seeding Tests
+    RUN_TEST(test_Prng_same_seed_same_sequence);
+    RUN_TEST(test_Prng_reseed_restarts_sequence);
+    RUN_TEST(test_Prng_zero_seed_is_usable);
+    RUN_TEST(test_Prng_adjacent_seeds_diverge);
+
+    // Stream Tests
+    RUN_TEST(test_Prng_forStream_is_random_access);
+    RUN_TEST(test_Prng_forStream_streams_are_distinct);
+
+    // Range Tests
+    RUN_TEST(test_Prng_range_stays_in_bounds);
+    RUN_TEST(test_Prng_range_empty_returns_min);
+    RUN_TEST(test_Prng_range_hits_every_value);
+    RUN_TEST(test_Prng_below_unbiased_for_large_bound);
+    RUN_TEST(test_Prng_below_degenerate_bounds);
+
+    return UNITY_END();
+}
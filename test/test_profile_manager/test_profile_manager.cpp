@@ -7,11 +7,15 @@
  * - Profile loading by ID and name
  * - Parameter validation and modification
  * - Device role management
+ * - Built-in profile table (flash-resident, no RAM copies)
  */
 
 #include <unity.h>
 #include <Arduino.h>
+#include <stdio.h>
+#include <chrono>
 #include <cstring>
+#include <type_traits>
 
 // =============================================================================
 // MOCK DEFINITIONS FOR LITTLEFS
@@ -47,6 +51,8 @@ class MockInternalFS {
 public:
     bool begin() { return false; }  // Return false to skip storage
     bool exists(const char*) { return false; }
+    bool remove(const char*) { return false; }
+    bool rename(const char*, const char*) { return false; }
 };
 
 }  // namespace Adafruit_LittleFS_Namespace
@@ -693,6 +699,69 @@ void test_loadSettings_returns_false_without_storage(void) {
     TEST_ASSERT_FALSE(profiles->loadSettings());
 }
 
+void test_requestSaveSettings_noop_without_storage(void) {
+    // Nothing to write: must not leave a commit pending forever
+    profiles->requestSaveSettings();
+
+    TEST_ASSERT_FALSE(profiles->hasPendingSettings());
+    TEST_ASSERT_FALSE(profiles->serviceSettingsWrite(10000000, UINT64_MAX));
+    TEST_ASSERT_EQUAL_UINT32(0, profiles->getSettingsWriteScheduler().getCommitCount());
+}
+
+// =============================================================================
+// BUILT-IN PROFILE TABLE TESTS
+// =============================================================================
+
+void test_TherapyProfile_is_trivially_copyable(void) {
+    // No strcpy-based copy constructor: loadProfile is a plain struct copy
+    TEST_ASSERT_TRUE(std::is_trivially_copyable<TherapyProfile>::value);
+}
+
+void test_loadProfile_strings_point_into_shared_table(void) {
+    ProfileManager other;
+    other.begin(false);
+    profiles->loadProfile(5);
+    other.loadProfile(5);
+
+    // Both managers reference the same flash strings instead of copies
+    TEST_ASSERT_EQUAL_PTR(profiles->getCurrentProfile()->name, other.getCurrentProfile()->name);
+    TEST_ASSERT_EQUAL_PTR(profiles->getCurrentProfile()->patternType, other.getCurrentProfile()->patternType);
+
+    uint8_t count = 0;
+    const char** names = profiles->getProfileNames(&count);
+    TEST_ASSERT_EQUAL_PTR(names[4], profiles->getCurrentProfile()->name);
+}
+
+void test_setParameter_does_not_modify_builtin_profile(void) {
+    profiles->loadProfile(1);
+    profiles->setParameter("FREQ", "200");
+    profiles->setParameter("PATTERN", "SEQUENTIAL");
+
+    ProfileManager other;
+    other.begin(false);
+    TEST_ASSERT_EQUAL_UINT16(250, other.getCurrentProfile()->frequencyHz);
+    TEST_ASSERT_EQUAL_STRING("rndp", other.getCurrentProfile()->patternType);
+}
+
+void test_profile_ram_and_loadProfile_cost(void) {
+    const int iterations = 100000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        profiles->loadProfile(static_cast<uint8_t>(1 + i % 6));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double loadNs = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+
+    // Before: 8 x 140-byte TherapyProfile array + 140-byte working copy in RAM
+    printf("[SIZE] TherapyProfile %lu bytes, ProfileManager %lu bytes (was 140 / 1424 on this host)\n",
+           (unsigned long)sizeof(TherapyProfile), (unsigned long)sizeof(ProfileManager));
+    printf("[PERF] loadProfile: %.1f ns/op\n", loadNs);
+
+    TEST_ASSERT_TRUE(sizeof(ProfileManager) < 512);
+    TEST_ASSERT_EQUAL_STRING("custom_vcr", profiles->getCurrentProfileName());  // (99999 % 6) + 1
+}
+
 // =============================================================================
 // MAIN - RUN ALL TESTS
 // =============================================================================
@@ -813,6 +882,13 @@ int main(int argc, char **argv) {
     RUN_TEST(test_isStorageAvailable_false_with_mock);
     RUN_TEST(test_saveSettings_returns_false_without_storage);
     RUN_TEST(test_loadSettings_returns_false_without_storage);
+    RUN_TEST(test_requestSaveSettings_noop_without_storage);
+
+    // Built-in Profile Table Tests
+    RUN_TEST(test_TherapyProfile_is_trivially_copyable);
+    RUN_TEST(test_loadProfile_strings_point_into_shared_table);
+    RUN_TEST(test_setParameter_does_not_modify_builtin_profile);
+    RUN_TEST(test_profile_ram_and_loadProfile_cost);
 
     return UNITY_END();
 }
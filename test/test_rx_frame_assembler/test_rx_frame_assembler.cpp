@@ -0,0 +1,291 @@
+/**
+ * @file test_rx_frame_assembler.cpp
+ * @brief Unit tests for RxFrameAssembler (EOT framing, first-byte timestamps)
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "rx_frame_assembler.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+struct Delivered {
+    std::string message;
+    uint64_t rxUs;
+};
+
+static RxFrameAssembler* g_rx = nullptr;
+static std::vector<Delivered> g_delivered;
+
+void setUp(void) {
+    g_rx = new RxFrameAssembler();
+    g_delivered.clear();
+}
+
+void tearDown(void) {
+    delete g_rx;
+    g_rx = nullptr;
+}
+
+/**
+ * @brief Feed one BLE chunk the way BLEManager does and collect the frames
+ */
+static void feedChunk(const std::string& chunk, uint64_t chunkRxUs) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(chunk.data());
+    uint16_t len = static_cast<uint16_t>(chunk.size());
+    uint16_t offset = 0;
+    while (offset < len) {
+        offset = static_cast<uint16_t>(offset + g_rx->feed(data + offset, static_cast<uint16_t>(len - offset), chunkRxUs));
+        if (g_rx->hasFrame()) {
+            g_delivered.push_back({g_rx->frame(), g_rx->frameRxUs()});
+            g_rx->consumeFrame();
+        }
+    }
+}
+
+static const std::string EOT(1, static_cast<char>(BLE_EOT_CHAR));
+
+// =============================================================================
+// FRAMING TESTS
+// =============================================================================
+
+void test_RxFrameAssembler_single_frame(void) {
+    feedChunk("PING:1|1000" + EOT, 500);
+
+    TEST_ASSERT_EQUAL(1, g_delivered.size());
+    TEST_ASSERT_EQUAL_STRING("PING:1|1000", g_delivered[0].message.c_str());
+    TEST_ASSERT_EQUAL_UINT64(500, g_delivered[0].rxUs);
+}
+
+void test_RxFrameAssembler_no_delivery_without_eot(void) {
+    feedChunk("PING:1|1000", 500);
+
+    TEST_ASSERT_EQUAL(0, g_delivered.size());
+    TEST_ASSERT_FALSE(g_rx->hasFrame());
+}
+
+void test_RxFrameAssembler_multiple_frames_in_one_chunk(void) {
+    feedChunk("A" + EOT + "BB" + EOT + "CCC" + EOT, 700);
+
+    TEST_ASSERT_EQUAL(3, g_delivered.size());
+    TEST_ASSERT_EQUAL_STRING("A", g_delivered[0].message.c_str());
+    TEST_ASSERT_EQUAL_STRING("BB", g_delivered[1].message.c_str());
+    TEST_ASSERT_EQUAL_STRING("CCC", g_delivered[2].message.c_str());
+}
+
+void test_RxFrameAssembler_skips_carriage_return(void) {
+    feedChunk("PI\rNG\r" + EOT, 0);
+
+    TEST_ASSERT_EQUAL(1, g_delivered.size());
+    TEST_ASSERT_EQUAL_STRING("PING", g_delivered[0].message.c_str());
+}
+
+void test_RxFrameAssembler_ignores_empty_frames(void) {
+    feedChunk(EOT + "\r" + EOT + "X" + EOT + EOT, 0);
+
+    TEST_ASSERT_EQUAL(1, g_delivered.size());
+    TEST_ASSERT_EQUAL_STRING("X", g_delivered[0].message.c_str());
+}
+
+void test_RxFrameAssembler_feed_stops_at_completed_frame(void) {
+    std::string chunk = "AB" + EOT + "CD" + EOT;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(chunk.data());
+
+    TEST_ASSERT_EQUAL_UINT16(3, g_rx->feed(data, 6, 0));
+    TEST_ASSERT_TRUE(g_rx->hasFrame());
+
+    // Unconsumed frame blocks further input
+    TEST_ASSERT_EQUAL_UINT16(0, g_rx->feed(data + 3, 3, 0));
+    TEST_ASSERT_EQUAL_STRING("AB", g_rx->frame());
+
+    g_rx->consumeFrame();
+    TEST_ASSERT_EQUAL_UINT16(3, g_rx->feed(data + 3, 3, 0));
+    TEST_ASSERT_EQUAL_STRING("CD", g_rx->frame());
+}
+
+void test_RxFrameAssembler_reset_drops_partial_frame(void) {
+    feedChunk("STALE", 100);
+    g_rx->reset();
+    feedChunk("PING" + EOT, 200);
+
+    TEST_ASSERT_EQUAL(1, g_delivered.size());
+    TEST_ASSERT_EQUAL_STRING("PING", g_delivered[0].message.c_str());
+    TEST_ASSERT_EQUAL_UINT64(200, g_delivered[0].rxUs);
+}
+
+// =============================================================================
+// OVERFLOW TESTS
+// =============================================================================
+
+void test_RxFrameAssembler_max_length_frame_fits(void) {
+    std::string body(RX_BUFFER_SIZE - 1, 'x');
+    feedChunk(body + EOT, 0);
+
+    TEST_ASSERT_EQUAL(1, g_delivered.size());
+    TEST_ASSERT_EQUAL(RX_BUFFER_SIZE - 1, g_delivered[0].message.size());
+    TEST_ASSERT_EQUAL_UINT32(0, g_rx->getOverflowCount());
+}
+
+void test_RxFrameAssembler_overflow_drops_whole_frame(void) {
+    // Tail of an oversized frame must not be delivered as a message
+    std::string body(RX_BUFFER_SIZE + 20, 'x');
+    feedChunk(body + "TAIL" + EOT + "PING" + EOT, 0);
+
+    TEST_ASSERT_EQUAL(1, g_delivered.size());
+    TEST_ASSERT_EQUAL_STRING("PING", g_delivered[0].message.c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, g_rx->getOverflowCount());
+}
+
+void test_RxFrameAssembler_overflow_across_chunks(void) {
+    std::string part(100, 'y');
+    feedChunk(part, 0);
+    feedChunk(part, 10);
+    feedChunk(part, 20);        // Overflows here
+    feedChunk(part + EOT, 30);  // Still discarding up to EOT
+    feedChunk("OK" + EOT, 40);
+
+    TEST_ASSERT_EQUAL(1, g_delivered.size());
+    TEST_ASSERT_EQUAL_STRING("OK", g_delivered[0].message.c_str());
+    TEST_ASSERT_EQUAL_UINT64(40, g_delivered[0].rxUs);
+    TEST_ASSERT_EQUAL_UINT32(1, g_rx->getOverflowCount());
+}
+
+// =============================================================================
+// FIRST-BYTE TIMESTAMP TESTS
+// =============================================================================
+
+void test_RxFrameAssembler_split_frame_stamped_at_first_chunk(void) {
+    // PING split across two BLE packets one connection interval apart
+    feedChunk("PING:42|1", 1000);
+    feedChunk("234567" + EOT, 8500);
+
+    TEST_ASSERT_EQUAL(1, g_delivered.size());
+    TEST_ASSERT_EQUAL_STRING("PING:42|1234567", g_delivered[0].message.c_str());
+    TEST_ASSERT_EQUAL_UINT64(1000, g_delivered[0].rxUs);
+}
+
+void test_RxFrameAssembler_frame_starting_mid_chunk_uses_that_chunk(void) {
+    // Tail of A completes in chunk 2; B starts in chunk 2 and ends in chunk 3
+    feedChunk("AAAA", 100);
+    feedChunk("AA" + EOT + "BB", 200);
+    feedChunk("BB" + EOT, 300);
+
+    TEST_ASSERT_EQUAL(2, g_delivered.size());
+    TEST_ASSERT_EQUAL_UINT64(100, g_delivered[0].rxUs);
+    TEST_ASSERT_EQUAL_UINT64(200, g_delivered[1].rxUs);
+}
+
+void test_RxFrameAssembler_leading_cr_does_not_start_frame(void) {
+    feedChunk("\r", 100);
+    feedChunk("PING" + EOT, 200);
+
+    TEST_ASSERT_EQUAL_UINT64(200, g_delivered[0].rxUs);
+}
+
+void test_RxFrameAssembler_frames_after_slow_handler_keep_chunk_time(void) {
+    // A long MC and a PING arrive in one packet; handling the MC takes 3ms.
+    // The PING must still carry the packet arrival time.
+    std::string chunk = "MC:1|2|0|100|5000" + EOT + "PING:7|999" + EOT;
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(chunk.data());
+    uint16_t len = static_cast<uint16_t>(chunk.size());
+    const uint64_t chunkRxUs = 50000;
+    uint64_t now = chunkRxUs;
+
+    uint16_t offset = 0;
+    std::vector<uint64_t> legacyStamps;
+    while (offset < len) {
+        offset = static_cast<uint16_t>(offset + g_rx->feed(data + offset, static_cast<uint16_t>(len - offset), chunkRxUs));
+        if (g_rx->hasFrame()) {
+            legacyStamps.push_back(now);    // What getMicros() in the handler would read
+            g_delivered.push_back({g_rx->frame(), g_rx->frameRxUs()});
+            g_rx->consumeFrame();
+            now += 3000;                    // Handler cost
+        }
+    }
+
+    TEST_ASSERT_EQUAL(2, g_delivered.size());
+    TEST_ASSERT_EQUAL_UINT64(chunkRxUs, g_delivered[1].rxUs);
+    TEST_ASSERT_EQUAL_UINT64(chunkRxUs + 3000, legacyStamps[1]);
+}
+
+// =============================================================================
+// PTP BIAS SIMULATION
+// =============================================================================
+
+void test_RxFrameAssembler_removes_split_message_offset_bias(void) {
+    // Symmetric 5ms path, SECONDARY clock 2ms ahead. The PING is split over
+    // two packets 7.5ms apart; stamping T2 at delivery biases the offset by
+    // half the gap, stamping at first byte removes it.
+    const int64_t trueOffset = 2000;
+    const int64_t oneWay = 5000;
+    const int64_t connInterval = 7500;
+    const int64_t processing = 200;
+
+    int64_t t1 = 1000000;                               // PRIMARY clock
+    int64_t firstChunk = t1 + oneWay + trueOffset;      // SECONDARY clock
+    int64_t lastChunk = firstChunk + connInterval;
+
+    feedChunk("PING:1|", static_cast<uint64_t>(firstChunk));
+    TEST_ASSERT_EQUAL(0, g_delivered.size());
+    feedChunk("1000000" + EOT, static_cast<uint64_t>(lastChunk));
+    TEST_ASSERT_EQUAL(1, g_delivered.size());
+
+    int64_t t2New = static_cast<int64_t>(g_delivered[0].rxUs);
+    int64_t t2Legacy = lastChunk;                       // Old: getMicros() in onBLEMessage
+
+    auto offsetFor = [&](int64_t t2) {
+        int64_t t3 = t2 + processing;
+        int64_t t4 = t3 - trueOffset + oneWay;          // PONG fits one packet
+        return ((t2 - t1) + (t3 - t4)) / 2;
+    };
+
+    int64_t errNew = offsetFor(t2New) - trueOffset;
+    int64_t errLegacy = offsetFor(t2Legacy) - trueOffset;
+
+    printf("[SIM] Split PING offset error: legacy=%lld us, first-byte=%lld us\n",
+           static_cast<long long>(errLegacy), static_cast<long long>(errNew));
+
+    TEST_ASSERT_EQUAL_INT64(0, errNew);
+    TEST_ASSERT_EQUAL_INT64(connInterval / 2, errLegacy);
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+
+    // Framing tests
+    RUN_TEST(test_RxFrameAssembler_single_frame);
+    RUN_TEST(test_RxFrameAssembler_no_delivery_without_eot);
+    RUN_TEST(test_RxFrameAssembler_multiple_frames_in_one_chunk);
+    RUN_TEST(test_RxFrameAssembler_skips_carriage_return);
+    RUN_TEST(test_RxFrameAssembler_ignores_empty_frames);
+    RUN_TEST(test_RxFrameAssembler_feed_stops_at_completed_frame);
+    RUN_TEST(test_RxFrameAssembler_reset_drops_partial_frame);
+
+    // Overflow tests
+    RUN_TEST(test_RxFrameAssembler_max_length_frame_fits);
+    RUN_TEST(test_RxFrameAssembler_overflow_drops_whole_frame);
+    RUN_TEST(test_RxFrameAssembler_overflow_across_chunks);
+
+    // First-byte timestamp tests
+    RUN_TEST(test_RxFrameAssembler_split_frame_stamped_at_first_chunk);
+    RUN_TEST(test_RxFrameAssembler_frame_starting_mid_chunk_uses_that_chunk);
+    RUN_TEST(test_RxFrameAssembler_leading_cr_does_not_start_frame);
+    RUN_TEST(test_RxFrameAssembler_frames_after_slow_handler_keep_chunk_time);
+
+    // PTP bias simulation
+    RUN_TEST(test_RxFrameAssembler_removes_split_message_offset_bias);
+
+    return UNITY_END();
+}
@@ -0,0 +1,614 @@
+/**
+ * @file test_settings_journal.cpp
+ * @brief Unit tests for the settings journal and ProfileManager persistence
+ *
+ * Tests:
+ * - Record encoding, replay, CRC and torn-tail handling
+ * - Append, compaction and v1 migration against a RAM-backed InternalFS
+ * - Write amplification and boot-time load cost versus the v1 file
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <stdio.h>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// =============================================================================
+// RAM-BACKED MOCK FOR LITTLEFS
+// =============================================================================
+
+// File open modes (from Adafruit_LittleFS)
+#ifndef FILE_O_READ
+#define FILE_O_READ  0x01
+#define FILE_O_WRITE 0x02
+#endif
+
+namespace Adafruit_LittleFS_Namespace {
+
+/**
+ * @brief Files held in memory; counts what reaches "flash"
+ */
+class MockInternalFS {
+public:
+    std::map<std::string, std::vector<uint8_t>> files;
+    size_t bytesWritten = 0;        // Payload bytes passed to File::write
+    size_t bytesRead = 0;
+    uint32_t writeOpens = 0;        // Files opened for writing
+    uint32_t renames = 0;
+    size_t writeBudget = SIZE_MAX;  // Bytes written before a simulated reset
+
+    bool begin() { return true; }
+    bool exists(const char* path) { return files.count(path) != 0; }
+    bool remove(const char* path) { return files.erase(path) != 0; }
+
+    bool rename(const char* from, const char* to) {
+        auto it = files.find(from);
+        if (it == files.end()) {
+            return false;
+        }
+        files[to] = it->second;
+        files.erase(from);
+        renames++;
+        return true;
+    }
+
+    void reset() {
+        files.clear();
+        bytesWritten = 0;
+        bytesRead = 0;
+        writeOpens = 0;
+        renames = 0;
+        writeBudget = SIZE_MAX;
+    }
+};
+
+class File {
+public:
+    File(MockInternalFS& fs) : _fs(&fs), _data(nullptr), _pos(0) {}
+
+    bool open(const char* path, uint8_t mode) {
+        if (mode == FILE_O_READ) {
+            auto it = _fs->files.find(path);
+            if (it == _fs->files.end()) {
+                return false;
+            }
+            _data = &it->second;
+            _pos = 0;
+        } else {
+            // FILE_O_WRITE creates the file and positions at EOF
+            _data = &_fs->files[path];
+            _pos = _data->size();
+            _fs->writeOpens++;
+        }
+        return true;
+    }
+
+    void close() { _data = nullptr; }
+
+    size_t read(uint8_t* buf, size_t len) {
+        size_t n = (_pos < _data->size()) ? std::min(len, _data->size() - _pos) : 0;
+        memcpy(buf, _data->data() + _pos, n);
+        _pos += n;
+        _fs->bytesRead += n;
+        return n;
+    }
+
+    size_t write(const uint8_t* buf, size_t len) {
+        size_t n = std::min(len, _fs->writeBudget);
+        _fs->writeBudget -= n;
+        if (_data->size() < _pos + n) {
+            _data->resize(_pos + n);
+        }
+        memcpy(_data->data() + _pos, buf, n);
+        _pos += n;
+        _fs->bytesWritten += n;
+        return n;
+    }
+
+    bool seek(uint32_t pos) { _pos = pos; return true; }
+    void flush() {}
+    operator bool() const { return _data != nullptr; }
+
+private:
+    MockInternalFS* _fs;
+    std::vector<uint8_t>* _data;
+    size_t _pos;
+};
+
+}  // namespace Adafruit_LittleFS_Namespace
+
+// Define global InternalFS before including source
+Adafruit_LittleFS_Namespace::MockInternalFS InternalFS;
+
+// Prevent including real LittleFS headers
+#define _ADAFRUIT_LITTLEFS_H_
+#define _INTERNAL_FILESYSTEM_H_
+
+using Adafruit_LittleFS_Namespace::File;
+
+#include "profile_manager.h"
+#include "settings_journal.h"
+
+// Include source file directly for native testing
+#include "../../src/profile_manager.cpp"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static ProfileManager* profiles = nullptr;
+
+void setUp(void) {
+    InternalFS.reset();
+    profiles = new ProfileManager();
+    profiles->begin(false);  // Storage available, nothing loaded
+}
+
+void tearDown(void) {
+    delete profiles;
+    profiles = nullptr;
+}
+
+/**
+ * @brief Replace the manager with a freshly booted one that loads settings
+ */
+static void reboot() {
+    delete profiles;
+    profiles = new ProfileManager();
+    profiles->begin(true);
+}
+
+static size_t journalSize() {
+    auto it = InternalFS.files.find(SETTINGS_JOURNAL_FILE);
+    return (it == InternalFS.files.end()) ? 0 : it->second.size();
+}
+
+static SettingsData defaultSettings() {
+    SettingsData data{};
+    data.magic = SETTINGS_MAGIC;
+    data.version = SETTINGS_VERSION;
+    data.role = 1;
+    data.profileId = 2;
+    data.frequencyHz = 235;
+    data.timeOnMs = 100.0f;
+    data.timeOffMs = 67.0f;
+    data.jitterPercent = 23.5f;
+    data.amplitudeMin = 80;
+    data.amplitudeMax = 100;
+    data.sessionDurationMin = 120;
+    strcpy(data.patternType, "rndp");
+    data.numFingers = 4;
+    return data;
+}
+
+// =============================================================================
+// ENCODING TESTS
+// =============================================================================
+
+void test_crc16_ccitt_check_value(void) {
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, SettingsJournal::crc16(check, sizeof(check)));
+}
+
+void test_snapshot_roundtrip(void) {
+    SettingsData in = defaultSettings();
+    uint8_t image[SettingsJournal::ENCODE_BUFFER_SIZE];
+    size_t len = SettingsJournal::encodeSnapshot(in, image, sizeof(image));
+
+    TEST_ASSERT_EQUAL(SettingsJournal::snapshotSize(), len);
+    TEST_ASSERT_TRUE(len <= sizeof(image));
+
+    SettingsData out{};
+    out.magic = SETTINGS_MAGIC;
+    out.version = SETTINGS_VERSION;
+    SettingsJournalReplay result = SettingsJournal::replay(image, len, out);
+
+    TEST_ASSERT_TRUE(result.valid);
+    TEST_ASSERT_FALSE(result.torn);
+    TEST_ASSERT_EQUAL_UINT16(SettingsJournal::FIELD_COUNT, result.records);
+    TEST_ASSERT_EQUAL(len, result.validBytes);
+    TEST_ASSERT_EQUAL_MEMORY(&in, &out, sizeof(SettingsData));
+}
+
+void test_encodeChanges_only_changed_fields(void) {
+    SettingsData from = defaultSettings();
+    SettingsData to = from;
+    uint8_t records[SettingsJournal::ENCODE_BUFFER_SIZE];
+    size_t len = 99;
+
+    TEST_ASSERT_TRUE(SettingsJournal::encodeChanges(from, to, records, sizeof(records), len));
+    TEST_ASSERT_EQUAL(0, len);
+
+    to.therapyLedOff = 1;
+    TEST_ASSERT_TRUE(SettingsJournal::encodeChanges(from, to, records, sizeof(records), len));
+    TEST_ASSERT_EQUAL(1 + SettingsJournal::RECORD_OVERHEAD, len);
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)SettingsKey::THERAPY_LED_OFF, records[0]);
+
+    to.timeOnMs = 120.0f;
+    TEST_ASSERT_TRUE(SettingsJournal::encodeChanges(from, to, records, sizeof(records), len));
+    TEST_ASSERT_EQUAL(1 + 4 + 2 * SettingsJournal::RECORD_OVERHEAD, len);
+
+    // Too small for both records
+    TEST_ASSERT_FALSE(SettingsJournal::encodeChanges(from, to, records, 9, len));
+}
+
+void test_replay_last_record_wins(void) {
+    SettingsData base = defaultSettings();
+    uint8_t image[256];
+    size_t len = SettingsJournal::encodeSnapshot(base, image, sizeof(image));
+
+    SettingsData on = base;
+    on.debugMode = 1;
+    size_t added = 0;
+    SettingsJournal::encodeChanges(base, on, image + len, sizeof(image) - len, added);
+    len += added;
+    SettingsData off = on;
+    off.debugMode = 0;
+    SettingsJournal::encodeChanges(on, off, image + len, sizeof(image) - len, added);
+    len += added;
+
+    SettingsData out{};
+    SettingsJournalReplay result = SettingsJournal::replay(image, len, out);
+
+    TEST_ASSERT_EQUAL_UINT16(SettingsJournal::FIELD_COUNT + 2, result.records);
+    TEST_ASSERT_EQUAL_UINT8(0, out.debugMode);
+}
+
+void test_replay_skips_unknown_keys(void) {
+    SettingsData base = defaultSettings();
+    uint8_t image[256];
+    size_t len = SettingsJournal::encodeSnapshot(base, image, sizeof(image));
+
+    // Record from a newer firmware: key 0x40, 3-byte value
+    uint8_t* rec = image + len;
+    rec[0] = 0x40;
+    rec[1] = 3;
+    rec[2] = 1; rec[3] = 2; rec[4] = 3;
+    uint16_t crc = SettingsJournal::crc16(rec, 5);
+    rec[5] = (uint8_t)(crc & 0xFF);
+    rec[6] = (uint8_t)(crc >> 8);
+    len += 7;
+
+    SettingsData out{};
+    SettingsJournalReplay result = SettingsJournal::replay(image, len, out);
+
+    TEST_ASSERT_FALSE(result.torn);
+    TEST_ASSERT_EQUAL_UINT16(1, result.skipped);
+    TEST_ASSERT_EQUAL(len, result.validBytes);
+    TEST_ASSERT_EQUAL_UINT16(235, out.frequencyHz);
+}
+
+void test_replay_stops_at_bad_crc(void) {
+    SettingsData base = defaultSettings();
+    uint8_t image[256];
+    size_t snapshotLen = SettingsJournal::encodeSnapshot(base, image, sizeof(image));
+    SettingsData changed = base;
+    changed.frequencyHz = 180;
+    size_t added = 0;
+    SettingsJournal::encodeChanges(base, changed, image + snapshotLen, sizeof(image) - snapshotLen, added);
+
+    image[snapshotLen + 2] ^= 0x01;  // Flip a value bit
+
+    SettingsData out{};
+    SettingsJournalReplay result = SettingsJournal::replay(image, snapshotLen + added, out);
+
+    TEST_ASSERT_TRUE(result.valid);
+    TEST_ASSERT_TRUE(result.torn);
+    TEST_ASSERT_EQUAL(snapshotLen, result.validBytes);
+    TEST_ASSERT_EQUAL_UINT16(235, out.frequencyHz);
+}
+
+void test_replay_truncated_tail(void) {
+    SettingsData base = defaultSettings();
+    uint8_t image[256];
+    size_t len = SettingsJournal::encodeSnapshot(base, image, sizeof(image));
+
+    SettingsData out{};
+    SettingsJournalReplay result = SettingsJournal::replay(image, len - 1, out);
+
+    TEST_ASSERT_TRUE(result.torn);
+    TEST_ASSERT_EQUAL_UINT16(SettingsJournal::FIELD_COUNT - 1, result.records);
+    TEST_ASSERT_EQUAL(len - (1 + SettingsJournal::RECORD_OVERHEAD), result.validBytes);
+}
+
+void test_replay_rejects_bad_header(void) {
+    SettingsData base = defaultSettings();
+    uint8_t image[256];
+    size_t len = SettingsJournal::encodeSnapshot(base, image, sizeof(image));
+
+    image[2] = SETTINGS_JOURNAL_VERSION + 1;
+    SettingsData out{};
+    TEST_ASSERT_FALSE(SettingsJournal::replay(image, len, out).valid);
+
+    // A v1 settings file is not a journal
+    TEST_ASSERT_FALSE(SettingsJournal::replay((const uint8_t*)&base, sizeof(base), out).valid);
+}
+
+// =============================================================================
+// PROFILE MANAGER PERSISTENCE TESTS
+// =============================================================================
+
+void test_first_save_writes_snapshot(void) {
+    TEST_ASSERT_TRUE(profiles->saveSettings());
+
+    TEST_ASSERT_EQUAL(SettingsJournal::snapshotSize(), journalSize());
+    TEST_ASSERT_EQUAL_UINT16(SettingsJournal::snapshotSize(), profiles->getJournalBytes());
+    TEST_ASSERT_EQUAL_UINT32(1, InternalFS.renames);
+    TEST_ASSERT_FALSE(InternalFS.exists(SETTINGS_JOURNAL_TMP_FILE));
+}
+
+void test_save_and_reload_roundtrip(void) {
+    profiles->setDeviceRole(DeviceRole::SECONDARY);
+    profiles->loadProfile(3);
+    profiles->setParameter("FREQ", "200");
+    profiles->setParameter("ON", "120");
+    profiles->setTherapyLedOff(true);
+    TEST_ASSERT_TRUE(profiles->saveSettings());
+
+    reboot();
+
+    TEST_ASSERT_TRUE(profiles->hasStoredRole());
+    TEST_ASSERT_EQUAL(DeviceRole::SECONDARY, profiles->getDeviceRole());
+    TEST_ASSERT_EQUAL_STRING("hybrid_vcr", profiles->getCurrentProfileName());
+    TEST_ASSERT_EQUAL_UINT16(200, profiles->getCurrentProfile()->frequencyHz);
+    TEST_ASSERT_EQUAL_FLOAT(120.0f, profiles->getCurrentProfile()->timeOnMs);
+    TEST_ASSERT_TRUE(profiles->getTherapyLedOff());
+    TEST_ASSERT_FALSE(profiles->getDebugMode());
+}
+
+void test_second_save_appends_changed_field(void) {
+    profiles->saveSettings();
+    size_t before = InternalFS.bytesWritten;
+
+    profiles->setDebugMode(true);
+    TEST_ASSERT_TRUE(profiles->saveSettings());
+
+    TEST_ASSERT_EQUAL(1 + SettingsJournal::RECORD_OVERHEAD, InternalFS.bytesWritten - before);
+    TEST_ASSERT_EQUAL(SettingsJournal::snapshotSize() + 1 + SettingsJournal::RECORD_OVERHEAD, journalSize());
+    TEST_ASSERT_EQUAL_UINT32(1, InternalFS.renames);
+
+    reboot();
+    TEST_ASSERT_TRUE(profiles->getDebugMode());
+}
+
+void test_unchanged_save_writes_nothing(void) {
+    profiles->saveSettings();
+    uint32_t opens = InternalFS.writeOpens;
+    size_t bytes = InternalFS.bytesWritten;
+
+    TEST_ASSERT_TRUE(profiles->saveSettings());
+
+    TEST_ASSERT_EQUAL_UINT32(opens, InternalFS.writeOpens);
+    TEST_ASSERT_EQUAL(bytes, InternalFS.bytesWritten);
+}
+
+void test_full_journal_is_compacted(void) {
+    profiles->saveSettings();
+
+    uint32_t compactions = 0;
+    for (int i = 0; i < 200; i++) {
+        uint32_t renames = InternalFS.renames;
+        profiles->setTherapyLedOff(i % 2 == 0);
+        TEST_ASSERT_TRUE(profiles->saveSettings());
+        TEST_ASSERT_TRUE(journalSize() <= SETTINGS_JOURNAL_MAX_BYTES);
+        TEST_ASSERT_EQUAL(journalSize(), profiles->getJournalBytes());
+        compactions += InternalFS.renames - renames;
+    }
+
+    // (512 - 105) / 5 appends fit between compactions
+    TEST_ASSERT_TRUE(compactions >= 2);
+    TEST_ASSERT_TRUE(compactions <= 3);
+
+    reboot();
+    TEST_ASSERT_FALSE(profiles->getTherapyLedOff());  // i = 199
+}
+
+// =============================================================================
+// RECOVERY TESTS
+// =============================================================================
+
+void test_torn_append_keeps_previous_value_and_compacts(void) {
+    profiles->setParameter("FREQ", "200");
+    profiles->saveSettings();
+
+    // Reset after 3 bytes of the 6-byte record (uint16 value)
+    profiles->setParameter("FREQ", "150");
+    InternalFS.writeBudget = 3;
+    TEST_ASSERT_FALSE(profiles->saveSettings());
+    InternalFS.writeBudget = SIZE_MAX;
+
+    reboot();
+    TEST_ASSERT_EQUAL_UINT16(200, profiles->getCurrentProfile()->frequencyHz);
+    TEST_ASSERT_EQUAL_UINT16(0, profiles->getJournalBytes());
+
+    // Next save drops the torn tail
+    uint32_t renames = InternalFS.renames;
+    TEST_ASSERT_TRUE(profiles->saveSettings());
+    TEST_ASSERT_EQUAL_UINT32(renames + 1, InternalFS.renames);
+    TEST_ASSERT_EQUAL(SettingsJournal::snapshotSize(), journalSize());
+}
+
+void test_interrupted_compaction_keeps_old_journal(void) {
+    profiles->setParameter("FREQ", "200");
+    profiles->saveSettings();
+
+    // Reset partway through writing the replacement snapshot
+    InternalFS.files[SETTINGS_JOURNAL_TMP_FILE] = {0xBB, 'J', SETTINGS_JOURNAL_VERSION, 0xFF, 4, 2};
+
+    reboot();
+    TEST_ASSERT_FALSE(InternalFS.exists(SETTINGS_JOURNAL_TMP_FILE));
+    TEST_ASSERT_EQUAL_UINT16(200, profiles->getCurrentProfile()->frequencyHz);
+}
+
+void test_corrupt_journal_header_falls_back_to_defaults(void) {
+    profiles->setParameter("FREQ", "200");
+    profiles->saveSettings();
+    InternalFS.files[SETTINGS_JOURNAL_FILE][0] = 0x00;
+
+    reboot();
+    TEST_ASSERT_FALSE(profiles->hasStoredRole());
+    TEST_ASSERT_EQUAL_STRING("regular_vcr", profiles->getCurrentProfileName());
+    TEST_ASSERT_EQUAL_UINT16(250, profiles->getCurrentProfile()->frequencyHz);
+}
+
+// =============================================================================
+// MIGRATION TESTS
+// =============================================================================
+
+void test_v1_settings_migrated_to_journal(void) {
+    SettingsData v1 = defaultSettings();
+    v1.therapyLedOff = 1;
+    InternalFS.files[SETTINGS_FILE].assign((uint8_t*)&v1, (uint8_t*)&v1 + sizeof(v1));
+
+    reboot();
+
+    TEST_ASSERT_EQUAL(DeviceRole::SECONDARY, profiles->getDeviceRole());
+    TEST_ASSERT_EQUAL_STRING("noisy_vcr", profiles->getCurrentProfileName());
+    TEST_ASSERT_EQUAL_FLOAT(23.5f, profiles->getCurrentProfile()->jitterPercent);
+    TEST_ASSERT_TRUE(profiles->getTherapyLedOff());
+    TEST_ASSERT_FALSE(InternalFS.exists(SETTINGS_FILE));
+    TEST_ASSERT_EQUAL(SettingsJournal::snapshotSize(), journalSize());
+
+    // Second boot reads the journal
+    reboot();
+    TEST_ASSERT_EQUAL_STRING("noisy_vcr", profiles->getCurrentProfileName());
+    TEST_ASSERT_TRUE(profiles->getTherapyLedOff());
+}
+
+void test_invalid_v1_settings_not_migrated(void) {
+    SettingsData v1 = defaultSettings();
+    v1.magic = 0x00;
+    InternalFS.files[SETTINGS_FILE].assign((uint8_t*)&v1, (uint8_t*)&v1 + sizeof(v1));
+
+    reboot();
+
+    TEST_ASSERT_FALSE(profiles->hasStoredRole());
+    TEST_ASSERT_FALSE(InternalFS.exists(SETTINGS_JOURNAL_FILE));
+}
+
+void test_unknown_stored_pattern_keeps_profile_default(void) {
+    SettingsData v1 = defaultSettings();
+    v1.profileId = 5;
+    memset(v1.patternType, 'x', sizeof(v1.patternType));  // Unterminated garbage
+    InternalFS.files[SETTINGS_FILE].assign((uint8_t*)&v1, (uint8_t*)&v1 + sizeof(v1));
+
+    reboot();
+
+    TEST_ASSERT_EQUAL_STRING("gentle", profiles->getCurrentProfileName());
+    TEST_ASSERT_EQUAL_STRING("sequential", profiles->getCurrentProfile()->patternType);
+}
+
+// =============================================================================
+// WRITE AMPLIFICATION AND LOAD COST
+// =============================================================================
+
+void test_write_amplification_led_toggles(void) {
+    const int toggles = 100;
+    profiles->saveSettings();
+    size_t before = InternalFS.bytesWritten;
+
+    for (int i = 0; i < toggles; i++) {
+        profiles->setTherapyLedOff(i % 2 == 0);
+        profiles->saveSettings();
+    }
+
+    size_t journalBytes = InternalFS.bytesWritten - before;
+    size_t legacyBytes = toggles * sizeof(SettingsData);   // v1 rewrote the whole struct
+
+    printf("[SIZE] %d LED toggles: v1 %lu bytes, journal %lu bytes (%.1fx less), record %u bytes, snapshot %lu bytes\n",
+           toggles, (unsigned long)legacyBytes, (unsigned long)journalBytes,
+           (double)legacyBytes / (double)journalBytes,
+           (unsigned)(1 + SettingsJournal::RECORD_OVERHEAD),
+           (unsigned long)SettingsJournal::snapshotSize());
+
+    TEST_ASSERT_TRUE(journalBytes * 4 < legacyBytes);
+}
+
+void test_boot_load_cost(void) {
+    const int iterations = 2000;
+
+    // Worst case: journal one append short of compaction
+    profiles->saveSettings();
+    while (profiles->getJournalBytes() + 1 + SettingsJournal::RECORD_OVERHEAD <= SETTINGS_JOURNAL_MAX_BYTES) {
+        profiles->setTherapyLedOff(!profiles->getTherapyLedOff());
+        profiles->saveSettings();
+    }
+    size_t fullBytes = journalSize();
+
+    InternalFS.bytesRead = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        profiles->loadSettings();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double fullNs = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    TEST_ASSERT_EQUAL(fullBytes * iterations, InternalFS.bytesRead);
+
+    // Freshly compacted journal
+    InternalFS.files.erase(SETTINGS_JOURNAL_FILE);
+    delete profiles;
+    profiles = new ProfileManager();
+    profiles->begin(false);
+    profiles->saveSettings();
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        profiles->loadSettings();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double snapshotNs = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+
+    printf("[PERF] loadSettings: snapshot %lu bytes %.0f ns, full journal %lu bytes %.0f ns (v1 file %lu bytes)\n",
+           (unsigned long)SettingsJournal::snapshotSize(), snapshotNs,
+           (unsigned long)fullBytes, fullNs, (unsigned long)sizeof(SettingsData));
+
+    TEST_ASSERT_TRUE(fullBytes <= SETTINGS_JOURNAL_MAX_BYTES);
+    TEST_ASSERT_TRUE(fullNs < 1000000.0);  // Replay of a full journal stays far below 1 ms
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+
+    // Encoding tests
+    RUN_TEST(test_crc16_ccitt_check_value);
+    RUN_TEST(test_snapshot_roundtrip);
+    RUN_TEST(test_encodeChanges_only_changed_fields);
+    RUN_TEST(test_replay_last_record_wins);
+    RUN_TEST(test_replay_skips_unknown_keys);
+    RUN_TEST(test_replay_stops_at_bad_crc);
+    RUN_TEST(test_replay_truncated_tail);
+    RUN_TEST(test_replay_rejects_bad_header);
+
+    // ProfileManager persistence tests
+    RUN_TEST(test_first_save_writes_snapshot);
+    RUN_TEST(test_save_and_reload_roundtrip);
+    RUN_TEST(test_second_save_appends_changed_field);
+    RUN_TEST(test_unchanged_save_writes_nothing);
+    RUN_TEST(test_full_journal_is_compacted);
+
+    // Recovery tests
+    RUN_TEST(test_torn_append_keeps_previous_value_and_compacts);
+    RUN_TEST(test_interrupted_compaction_keeps_old_journal);
+    RUN_TEST(test_corrupt_journal_header_falls_back_to_defaults);
+
+    // Migration tests
+    RUN_TEST(test_v1_settings_migrated_to_journal);
+    RUN_TEST(test_invalid_v1_settings_not_migrated);
+    RUN_TEST(test_unknown_stored_pattern_keeps_profile_default);
+
+    // Write amplification and load cost
+    RUN_TEST(test_write_amplification_led_toggles);
+    RUN_TEST(test_boot_load_cost);
+
+    return UNITY_END();
+}
@@ -0,0 +1,338 @@
+/**
+ * @file test_status_publisher.cpp
+ * @brief Unit tests for StatusPublisher (SUBSCRIBE status pushes)
+ *
+ * Tests:
+ * - Subscription and interval clamping
+ * - Delta encoding, push steps for battery and sync quality
+ * - Rate limiting and deferral to idle link time
+ * - Session simulation: link traffic versus polling
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include <cstring>
+#include <string>
+#include "status_publisher.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+static StatusPublisher* g_publisher = nullptr;
+static char g_buffer[STATUS_PUSH_BUFFER_SIZE];
+
+void setUp(void) {
+    g_publisher = new StatusPublisher();
+    memset(g_buffer, 0, sizeof(g_buffer));
+}
+
+void tearDown(void) {
+    delete g_publisher;
+    g_publisher = nullptr;
+}
+
+static StatusSnapshot makeSnapshot(TherapyState state = TherapyState::RUNNING, uint32_t elapsed = 60,
+                                   uint32_t remaining = 7140, uint16_t batteryCv = 372, int32_t syncUs = 150) {
+    StatusSnapshot snapshot;
+    snapshot.state = state;
+    snapshot.elapsedSec = elapsed;
+    snapshot.remainingSec = remaining;
+    snapshot.batteryCentivolts = batteryCv;
+    snapshot.syncUs = syncUs;
+    return snapshot;
+}
+
+/**
+ * @brief Poll as loop() does with an idle link; returns the pushed message ("" if none)
+ */
+static std::string poll(uint32_t nowMs, const StatusSnapshot& snapshot, uint8_t pendingTx = 0) {
+    size_t len = g_publisher->prepare(nowMs, snapshot, pendingTx, g_buffer, sizeof(g_buffer));
+    if (len == 0) {
+        return std::string();
+    }
+    g_publisher->markSent(nowMs, snapshot);
+    return std::string(g_buffer, len);
+}
+
+static bool contains(const std::string& message, const char* line) {
+    return message.find(line) != std::string::npos;
+}
+
+// =============================================================================
+// SUBSCRIPTION TESTS
+// =============================================================================
+
+void test_StatusPublisher_not_subscribed_never_pushes(void) {
+    TEST_ASSERT_FALSE(g_publisher->isSubscribed());
+    TEST_ASSERT_TRUE(poll(10000, makeSnapshot()).empty());
+}
+
+void test_StatusPublisher_subscribe_clamps_interval(void) {
+    TEST_ASSERT_EQUAL_UINT32(STATUS_PUSH_MIN_INTERVAL_MS, g_publisher->subscribe(10));
+    TEST_ASSERT_EQUAL_UINT32(STATUS_PUSH_MAX_INTERVAL_MS, g_publisher->subscribe(10000000));
+    TEST_ASSERT_EQUAL_UINT32(2000, g_publisher->subscribe(2000));
+    TEST_ASSERT_TRUE(g_publisher->isSubscribed());
+}
+
+void test_StatusPublisher_subscribe_zero_unsubscribes(void) {
+    g_publisher->subscribe(1000);
+    TEST_ASSERT_EQUAL_UINT32(0, g_publisher->subscribe(0));
+    TEST_ASSERT_FALSE(g_publisher->isSubscribed());
+    TEST_ASSERT_TRUE(poll(10000, makeSnapshot()).empty());
+}
+
+void test_StatusPublisher_first_push_is_full_snapshot(void) {
+    g_publisher->subscribe(1000);
+    std::string push = poll(5000, makeSnapshot());
+
+    TEST_ASSERT_EQUAL_STRING("PUSH:1\nSESSION_STATUS:RUNNING\nELAPSED:60\nREMAINING:7140\nBATP:3.72\nSYNC_US:150\n",
+                             push.c_str());
+    TEST_ASSERT_EQUAL_UINT32(1, g_publisher->getPushCount());
+}
+
+void test_StatusPublisher_resubscribe_sends_full_snapshot(void) {
+    g_publisher->subscribe(1000);
+    poll(5000, makeSnapshot());
+
+    g_publisher->subscribe(500);
+    std::string push = poll(5010, makeSnapshot());
+    TEST_ASSERT_TRUE(contains(push, "SESSION_STATUS:RUNNING\n"));
+    TEST_ASSERT_TRUE(contains(push, "BATP:3.72\n"));
+}
+
+// =============================================================================
+// DELTA ENCODING TESTS
+// =============================================================================
+
+void test_StatusPublisher_interval_push_has_only_changes(void) {
+    g_publisher->subscribe(1000);
+    poll(5000, makeSnapshot(TherapyState::RUNNING, 60, 7140));
+
+    std::string push = poll(6000, makeSnapshot(TherapyState::RUNNING, 61, 7139));
+    TEST_ASSERT_EQUAL_STRING("PUSH:2\nELAPSED:61\nREMAINING:7139\n", push.c_str());
+}
+
+void test_StatusPublisher_waits_for_interval(void) {
+    g_publisher->subscribe(1000);
+    poll(5000, makeSnapshot(TherapyState::RUNNING, 60, 7140));
+
+    TEST_ASSERT_TRUE(poll(5999, makeSnapshot(TherapyState::RUNNING, 61, 7139)).empty());
+    TEST_ASSERT_FALSE(poll(6000, makeSnapshot(TherapyState::RUNNING, 61, 7139)).empty());
+}
+
+void test_StatusPublisher_unchanged_interval_is_silent(void) {
+    g_publisher->subscribe(1000);
+    StatusSnapshot paused = makeSnapshot(TherapyState::PAUSED);
+    poll(5000, paused);
+
+    TEST_ASSERT_TRUE(poll(6000, paused).empty());
+    TEST_ASSERT_FALSE(g_publisher->isDue(6500, paused));   // Interval restarted at 6000
+    TEST_ASSERT_TRUE(g_publisher->isDue(7000, paused));
+    TEST_ASSERT_EQUAL_UINT32(1, g_publisher->getPushCount());
+}
+
+void test_StatusPublisher_state_change_skips_interval(void) {
+    g_publisher->subscribe(5000);
+    poll(5000, makeSnapshot(TherapyState::RUNNING));
+
+    // Rate limit still applies
+    TEST_ASSERT_TRUE(poll(5000 + STATUS_PUSH_MIN_INTERVAL_MS - 1, makeSnapshot(TherapyState::PAUSED)).empty());
+
+    std::string push = poll(5000 + STATUS_PUSH_MIN_INTERVAL_MS, makeSnapshot(TherapyState::PAUSED));
+    TEST_ASSERT_EQUAL_STRING("PUSH:2\nSESSION_STATUS:PAUSED\n", push.c_str());
+}
+
+void test_StatusPublisher_battery_noise_not_pushed(void) {
+    g_publisher->subscribe(1000);
+    poll(5000, makeSnapshot(TherapyState::READY, 0, 0, 372));
+
+    // Below the step: nothing to send
+    TEST_ASSERT_TRUE(poll(6000, makeSnapshot(TherapyState::READY, 0, 0, 369)).empty());
+    TEST_ASSERT_TRUE(poll(7000, makeSnapshot(TherapyState::READY, 0, 0, 375)).empty());
+}
+
+void test_StatusPublisher_battery_drift_accumulates(void) {
+    g_publisher->subscribe(1000);
+    poll(5000, makeSnapshot(TherapyState::READY, 0, 0, 372));
+
+    TEST_ASSERT_TRUE(poll(6000, makeSnapshot(TherapyState::READY, 0, 0, 370)).empty());
+    TEST_ASSERT_TRUE(poll(7000, makeSnapshot(TherapyState::READY, 0, 0, 368)).empty());
+    std::string push = poll(8000, makeSnapshot(TherapyState::READY, 0, 0, 367));
+    TEST_ASSERT_EQUAL_STRING("PUSH:2\nBATP:3.67\n", push.c_str());
+}
+
+void test_StatusPublisher_sync_lost_and_regained(void) {
+    g_publisher->subscribe(1000);
+    poll(5000, makeSnapshot(TherapyState::READY, 0, 0, 372, 150));
+
+    TEST_ASSERT_TRUE(poll(6000, makeSnapshot(TherapyState::READY, 0, 0, 372, 180)).empty());
+    std::string lost = poll(7000, makeSnapshot(TherapyState::READY, 0, 0, 372, -1));
+    TEST_ASSERT_EQUAL_STRING("PUSH:2\nSYNC_US:-1\n", lost.c_str());
+
+    std::string regained = poll(8000, makeSnapshot(TherapyState::READY, 0, 0, 372, 40));
+    TEST_ASSERT_EQUAL_STRING("PUSH:3\nSYNC_US:40\n", regained.c_str());
+}
+
+void test_StatusPublisher_small_buffer_encodes_nothing(void) {
+    g_publisher->subscribe(1000);
+    char small[24];
+    TEST_ASSERT_EQUAL(0, g_publisher->encode(makeSnapshot(), small, sizeof(small)));
+}
+
+void test_StatusPublisher_full_push_fits_buffer(void) {
+    g_publisher->subscribe(1000);
+    StatusSnapshot worst = makeSnapshot(TherapyState::PHONE_DISCONNECTED, UINT32_MAX, UINT32_MAX,
+                                        UINT16_MAX, INT32_MIN);
+    TEST_ASSERT_TRUE(g_publisher->encode(worst, g_buffer, sizeof(g_buffer)) > 0);
+}
+
+// =============================================================================
+// LINK SCHEDULING TESTS
+// =============================================================================
+
+void test_StatusPublisher_waits_for_empty_tx_queue(void) {
+    g_publisher->subscribe(1000);
+
+    TEST_ASSERT_TRUE(poll(5000, makeSnapshot(), 2).empty());
+    TEST_ASSERT_TRUE(poll(5005, makeSnapshot(), 1).empty());
+    TEST_ASSERT_EQUAL_UINT32(1, g_publisher->getDeferredCount());
+
+    TEST_ASSERT_FALSE(poll(5010, makeSnapshot(), 0).empty());
+    TEST_ASSERT_EQUAL_UINT32(1, g_publisher->getDeferredCount());
+}
+
+void test_StatusPublisher_holds_off_after_macrocycle(void) {
+    g_publisher->subscribe(1000);
+    g_publisher->onMacrocycleSent(5000);
+
+    TEST_ASSERT_TRUE(poll(5000 + STATUS_PUSH_MACROCYCLE_HOLDOFF_MS - 1, makeSnapshot()).empty());
+    TEST_ASSERT_FALSE(poll(5000 + STATUS_PUSH_MACROCYCLE_HOLDOFF_MS, makeSnapshot()).empty());
+}
+
+void test_StatusPublisher_failed_send_is_retried(void) {
+    g_publisher->subscribe(1000);
+    poll(5000, makeSnapshot(TherapyState::RUNNING, 60, 7140));
+
+    // TX queue full: sendToPhone() failed, markSent() not called
+    size_t len = g_publisher->prepare(6000, makeSnapshot(TherapyState::RUNNING, 61, 7139), 0,
+                                      g_buffer, sizeof(g_buffer));
+    TEST_ASSERT_TRUE(len > 0);
+
+    std::string retry = poll(6010, makeSnapshot(TherapyState::RUNNING, 61, 7139));
+    TEST_ASSERT_EQUAL_STRING("PUSH:2\nELAPSED:61\nREMAINING:7139\n", retry.c_str());
+}
+
+void test_StatusPublisher_millis_wraparound(void) {
+    g_publisher->subscribe(1000);
+    uint32_t start = UINT32_MAX - 500;
+    poll(start, makeSnapshot(TherapyState::RUNNING, 60, 7140));
+
+    TEST_ASSERT_TRUE(poll(start + 999, makeSnapshot(TherapyState::RUNNING, 61, 7139)).empty());
+    TEST_ASSERT_FALSE(poll(start + 1000, makeSnapshot(TherapyState::RUNNING, 61, 7139)).empty());
+}
+
+// =============================================================================
+// SESSION SIMULATION
+// =============================================================================
+
+void test_StatusPublisher_session_vs_polling(void) {
+    // 10 minute session, 1s updates. Lockstep macrocycles every 3.34s
+    // (12 x 167ms buzzes + 2 x 668ms relax); each keeps the TX queue busy
+    // ~20ms. A polling phone sends SESSION_STATUS + BATTERY every second.
+    const uint32_t sessionMs = 10 * 60 * 1000;
+    const uint32_t macrocycleMs = 3340;
+    const uint32_t txBusyMs = 20;
+    const uint32_t startMs = 10000;
+
+    g_publisher->subscribe(1000);
+
+    size_t pushBytes = 0;
+    uint32_t pushes = 0;
+    uint32_t collisions = 0;
+    uint32_t maxGapMs = 0;
+    uint32_t lastPushMs = startMs;
+    uint32_t nextMacrocycleMs = startMs;
+    uint32_t txBusyUntil = 0;
+
+    for (uint32_t now = startMs; now < startMs + sessionMs; now++) {
+        if (now == nextMacrocycleMs) {
+            g_publisher->onMacrocycleSent(now);
+            txBusyUntil = now + txBusyMs;
+            nextMacrocycleMs += macrocycleMs;
+        }
+        uint8_t pendingTx = (now < txBusyUntil) ? 1 : 0;
+
+        uint32_t elapsed = (now - startMs) / 1000;
+        uint16_t batteryCv = static_cast<uint16_t>(400 - elapsed / 30 + ((now / 7) % 3));  // Drain + ADC noise
+        StatusSnapshot snapshot = makeSnapshot(TherapyState::RUNNING, elapsed, 600 - elapsed, batteryCv, 120);
+
+        std::string push = poll(now, snapshot, pendingTx);
+        if (!push.empty()) {
+            if (pendingTx > 0 || now - (nextMacrocycleMs - macrocycleMs) < STATUS_PUSH_MACROCYCLE_HOLDOFF_MS) {
+                collisions++;
+            }
+            if (pushes > 0 && now - lastPushMs > maxGapMs) {
+                maxGapMs = now - lastPushMs;
+            }
+            lastPushMs = now;
+            pushBytes += push.size() + 1;   // + EOT
+            pushes++;
+        }
+    }
+
+    // Polling: request + response (KEY:VALUE lines + EOT) per second
+    const size_t statusPoll = strlen("SESSION_STATUS\x04") +
+                              strlen("SESSION_STATUS:RUNNING\nELAPSED:300\nTOTAL:600\nPROGRESS:50\n\x04");
+    const size_t batteryPoll = strlen("BATTERY\x04") + strlen("BATP:3.72\nBATS:3.68\n\x04");
+    size_t pollBytes = (sessionMs / 1000) * (statusPoll + batteryPoll);
+
+    printf("[SIM] 10 min session, 1s updates: polling=%lu bytes (%lu messages), push=%lu bytes (%lu messages, max gap %lu ms)\n",
+           (unsigned long)pollBytes, (unsigned long)(sessionMs / 1000 * 4),
+           (unsigned long)pushBytes, (unsigned long)pushes, (unsigned long)maxGapMs);
+
+    TEST_ASSERT_EQUAL_UINT32(0, collisions);
+    TEST_ASSERT_TRUE(pushes >= sessionMs / 1000 - 5);
+    TEST_ASSERT_TRUE(maxGapMs <= 1000 + STATUS_PUSH_MACROCYCLE_HOLDOFF_MS);
+    TEST_ASSERT_TRUE(pushBytes * 2 < pollBytes);
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char **argv) {
+    (void)argc;
+    (void)argv;
+
+    UNITY_BEGIN();
+
+    // Subscription tests
+    RUN_TEST(test_StatusPublisher_not_subscribed_never_pushes);
+    RUN_TEST(test_StatusPublisher_subscribe_clamps_interval);
+    RUN_TEST(test_StatusPublisher_subscribe_zero_unsubscribes);
+    RUN_TEST(test_StatusPublisher_first_push_is_full_snapshot);
+    RUN_TEST(test_StatusPublisher_resubscribe_sends_full_snapshot);
+
+    // Delta encoding tests
+    RUN_TEST(test_StatusPublisher_interval_push_has_only_changes);
+    RUN_TEST(test_StatusPublisher_waits_for_interval);
+    RUN_TEST(test_StatusPublisher_unchanged_interval_is_silent);
+    RUN_TEST(test_StatusPublisher_state_change_skips_interval);
+    RUN_TEST(test_StatusPublisher_battery_noise_not_pushed);
+    RUN_TEST(test_StatusPublisher_battery_drift_accumulates);
+    RUN_TEST(test_StatusPublisher_sync_lost_and_regained);
+    RUN_TEST(test_StatusPublisher_small_buffer_encodes_nothing);
+    RUN_TEST(test_StatusPublisher_full_push_fits_buffer);
+
+    // Link scheduling tests
+    RUN_TEST(test_StatusPublisher_waits_for_empty_tx_queue);
+    RUN_TEST(test_StatusPublisher_holds_off_after_macrocycle);
+    RUN_TEST(test_StatusPublisher_failed_send_is_retried);
+    RUN_TEST(test_StatusPublisher_millis_wraparound);
+
+    // Session simulation
+    RUN_TEST(test_StatusPublisher_session_vs_polling);
+
+    return UNITY_END();
+}
@@ -4,7 +4,9 @@
  */
 
 #include <unity.h>
+#include <chrono>
 #include "sync_protocol.h"
+#include "prng.h"
 
 // Include source file directly for native testing
 #include "../../src/sync_protocol.cpp"
@@ -266,6 +268,144 @@ void test_SyncCommand_deserialize_roundtrip(void) {
     TEST_ASSERT_EQUAL_INT32(80, parsed.getDataInt("1", -1));
 }
 
+// =============================================================================
+// SYNC COMMAND VIEW (ZERO-COPY) TESTS
+// =============================================================================
+
+void test_SyncCommandView_parse_pong_fields(void) {
+    const char* message = "PONG:42|0|1|3000000000|1|3000000500";
+
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(message));
+    TEST_ASSERT_TRUE(view.isValid());
+    TEST_ASSERT_EQUAL(SyncCommandType::PONG, view.getType());
+    TEST_ASSERT_EQUAL_UINT32(42, view.getSequenceId());
+    TEST_ASSERT_EQUAL_UINT64(0, view.getTimestamp());
+    TEST_ASSERT_EQUAL_UINT8(4, view.getDataCount());
+
+    // Values above 2^31 must not sign-extend
+    TEST_ASSERT_EQUAL_UINT32(1, view.getDataUnsigned(0));
+    TEST_ASSERT_EQUAL_UINT32(3000000000UL, view.getDataUnsigned(1));
+    TEST_ASSERT_EQUAL_UINT32(3000000500UL, view.getDataUnsigned(3, 0));
+    TEST_ASSERT_TRUE(view.hasData(2));
+    TEST_ASSERT_FALSE(view.hasData(4));
+    TEST_ASSERT_EQUAL_UINT32(7, view.getDataUnsigned(4, 7));
+}
+
+void test_SyncCommandView_fields_point_into_buffer(void) {
+    char message[] = "BUZZ:1|1000|2|80";
+
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(message));
+
+    // Zero-copy: field data aliases the receive buffer
+    std::string_view amp = view.getData(1);
+    TEST_ASSERT_TRUE(amp.data() == message + 14);
+    TEST_ASSERT_EQUAL(2, amp.size());
+
+    // Lazy decode: integers are read from the buffer at access time
+    message[14] = '9';
+    TEST_ASSERT_EQUAL_INT32(90, view.getDataInt(1));
+}
+
+void test_SyncCommandView_signed_and_64bit_values(void) {
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse("DEBUG_FLASH:7|12345678901234|-250|00017"));
+
+    TEST_ASSERT_EQUAL_UINT64(12345678901234ULL, view.getTimestamp());
+    TEST_ASSERT_EQUAL_INT32(-250, view.getDataInt(0));
+    TEST_ASSERT_EQUAL_INT32(17, view.getDataInt(1));
+    TEST_ASSERT_EQUAL_INT32(-1, view.getDataInt(2, -1));
+}
+
+void test_SyncCommandView_overlong_values_saturate(void) {
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse("MC_ACK:99999999999999999999999|184467440737095516160|4294967296|-99999999999|99999999999|-1"));
+
+    // strtoul()/strtol() saturate rather than wrapping modulo 2^32
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, view.getSequenceId());
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, view.getTimestamp());
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, view.getDataUnsigned(0));
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, view.getDataInt(1));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, view.getDataInt(2));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, view.getDataUnsigned(3));
+
+    // Largest values that fit are exact
+    TEST_ASSERT_TRUE(view.parse("MC_ACK:4294967295|18446744073709551615|-2147483648|2147483647"));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, view.getSequenceId());
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, view.getTimestamp());
+    TEST_ASSERT_EQUAL_INT32(INT32_MIN, view.getDataInt(0));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, view.getDataInt(1));
+}
+
+void test_SyncCommandView_parse_invalid(void) {
+    SyncCommandView view;
+
+    TEST_ASSERT_FALSE(view.parse(nullptr));
+    TEST_ASSERT_FALSE(view.parse(""));
+    TEST_ASSERT_FALSE(view.parse("PING"));
+    TEST_ASSERT_FALSE(view.parse("PING:"));
+    TEST_ASSERT_FALSE(view.parse("PING:1"));
+    TEST_ASSERT_FALSE(view.parse("UNKNOWN_CMD:1|1000"));
+    // Type prefix of a longer name must not match (MC vs MC_ACK)
+    TEST_ASSERT_FALSE(view.parse("PIN:1|1000"));
+    TEST_ASSERT_FALSE(view.isValid());
+    TEST_ASSERT_EQUAL_UINT8(0, view.getDataCount());
+}
+
+void test_SyncCommandView_matches_SyncCommand(void) {
+    const char* messages[] = {
+        "PING:5|0|1|4294967295",
+        "PONG:9|0|123|456",
+        "MC_ACK:77|0",
+        "BUZZ:3||1000||2|80",  // Empty tokens skipped like strtok
+        "STOP_SESSION:12|99",
+    };
+
+    for (const char* message : messages) {
+        SyncCommand owning;
+        SyncCommandView view;
+        TEST_ASSERT_TRUE(owning.deserialize(message));
+        TEST_ASSERT_TRUE(view.parse(message));
+
+        TEST_ASSERT_EQUAL(owning.getType(), view.getType());
+        TEST_ASSERT_EQUAL_UINT32(owning.getSequenceId(), view.getSequenceId());
+        TEST_ASSERT_EQUAL_UINT64(owning.getTimestamp(), view.getTimestamp());
+        TEST_ASSERT_EQUAL_UINT8(owning.getDataCount(), view.getDataCount());
+        for (uint8_t i = 0; i < view.getDataCount(); i++) {
+            char key[2] = {static_cast<char>('0' + i), '\0'};
+            TEST_ASSERT_EQUAL_UINT32(owning.getDataUnsigned(key), view.getDataUnsigned(i));
+        }
+    }
+}
+
+void test_SyncCommandView_owning_copy(void) {
+    char message[] = "PONG:8|0|11|22";
+
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(message));
+
+    SyncCommand copy;
+    TEST_ASSERT_TRUE(copy.deserialize(view));
+
+    // Copy survives the receive buffer being reused
+    memset(message, 0, sizeof(message));
+    TEST_ASSERT_EQUAL(SyncCommandType::PONG, copy.getType());
+    TEST_ASSERT_EQUAL_UINT32(8, copy.getSequenceId());
+    TEST_ASSERT_EQUAL_STRING("11", copy.getData("0"));
+    TEST_ASSERT_EQUAL_STRING("22", copy.getData("1"));
+
+    SyncCommandView invalid;
+    TEST_ASSERT_FALSE(copy.deserialize(invalid));
+}
+
+void test_SyncCommandView_footprint(void) {
+    // View must stay a small fraction of the owning command on the callback stack
+    TEST_ASSERT_TRUE(sizeof(SyncCommandView) * 8 < sizeof(SyncCommand));
+    printf("[SIZE] SyncCommandView=%u bytes, SyncCommand=%u bytes\n",
+           (unsigned)sizeof(SyncCommandView), (unsigned)sizeof(SyncCommand));
+}
+
 // =============================================================================
 // SYNC COMMAND FACTORY METHOD TESTS
 // =============================================================================
@@ -332,6 +472,65 @@ void test_global_sequence_generator(void) {
     TEST_ASSERT_EQUAL_UINT32(2, g_sequenceGenerator.next());
 }
 
+// =============================================================================
+// MACROCYCLE RECEIVE WINDOW TESTS
+// =============================================================================
+
+void test_MacrocycleReceiveWindow_first_is_new_timeline(void) {
+    MacrocycleReceiveWindow window;
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::NEW_TIMELINE, window.classify(42));
+}
+
+void test_MacrocycleReceiveWindow_in_order_and_duplicates(void) {
+    MacrocycleReceiveWindow window;
+    window.markStaged(10);
+    window.markStaged(11);
+
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::IN_WINDOW, window.classify(12));
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::DUPLICATE, window.classify(11));
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::DUPLICATE, window.classify(10));
+}
+
+void test_MacrocycleReceiveWindow_fills_gap_out_of_order(void) {
+    MacrocycleReceiveWindow window;
+    window.markStaged(10);
+    window.markStaged(12);  // 11 lost on first send
+
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::IN_WINDOW, window.classify(11));
+    window.markStaged(11);
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::DUPLICATE, window.classify(11));
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::DUPLICATE, window.classify(12));
+}
+
+void test_MacrocycleReceiveWindow_far_sequence_is_new_timeline(void) {
+    MacrocycleReceiveWindow window;
+    window.markStaged(100);
+
+    // PRIMARY rebooted (sequence restarted) or jumped far ahead
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::NEW_TIMELINE, window.classify(0));
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::NEW_TIMELINE,
+                      window.classify(100 + MACROCYCLE_PIPELINE_MAX_DEPTH + 1));
+    window.markStaged(0);
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::IN_WINDOW, window.classify(1));
+}
+
+void test_MacrocycleReceiveWindow_wraps(void) {
+    MacrocycleReceiveWindow window;
+    window.markStaged(0xFFFFFFFFu);
+
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::IN_WINDOW, window.classify(0));
+    window.markStaged(0);
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::DUPLICATE, window.classify(0xFFFFFFFFu));
+}
+
+void test_MacrocycleReceiveWindow_reset(void) {
+    MacrocycleReceiveWindow window;
+    window.markStaged(5);
+    window.reset();
+
+    TEST_ASSERT_EQUAL(MacrocycleReceiveWindow::NEW_TIMELINE, window.classify(5));
+}
+
 // =============================================================================
 // SIMPLE SYNC PROTOCOL TESTS
 // =============================================================================
@@ -1091,6 +1290,102 @@ void test_SyncCommand_createPongWithTimestamps(void) {
 }
 
 
+void test_SyncCommand_serializePongForTxStamp_placeholder(void) {
+    char buffer[64];
+    uint16_t stampOffset = 0;
+
+    TEST_ASSERT_TRUE(SyncCommand::serializePongForTxStamp(buffer, sizeof(buffer), 42, 1000000, stampOffset));
+    TEST_ASSERT_EQUAL_STRING("PONG:42|0|0|1000000|0000000000|0000000000", buffer);
+    TEST_ASSERT_EQUAL_UINT16(strlen(buffer) - SYNC_TX_STAMP_LEN, stampOffset);
+}
+
+void test_SyncCommand_stampTxTime_keeps_length_and_parses(void) {
+    char buffer[64];
+    uint16_t stampOffset = 0;
+    uint64_t t2 = 0x100000010ULL;
+    uint64_t t3 = 0x1FFFFFFFFULL;
+    SyncCommand::serializePongForTxStamp(buffer, sizeof(buffer), 7, t2, stampOffset);
+    size_t len = strlen(buffer);
+
+    SyncCommand::stampTxTime(buffer, stampOffset, t3);
+    TEST_ASSERT_EQUAL(len, strlen(buffer));
+
+    // PRIMARY's 64-bit PONG decode (main.cpp) sees T2 and the patched T3
+    SyncCommandView view;
+    TEST_ASSERT_TRUE(view.parse(buffer));
+    TEST_ASSERT_EQUAL(SyncCommandType::PONG, view.getType());
+    TEST_ASSERT_EQUAL_UINT32(7, view.getSequenceId());
+    TEST_ASSERT_TRUE(view.hasData(3));
+    uint64_t gotT2 = ((uint64_t)view.getDataUnsigned(0, 0) << 32) | view.getDataUnsigned(1, 0);
+    uint64_t gotT3 = ((uint64_t)view.getDataUnsigned(2, 0) << 32) | view.getDataUnsigned(3, 0);
+    TEST_ASSERT_EQUAL_UINT64(t2, gotT2);
+    TEST_ASSERT_EQUAL_UINT64(t3, gotT3);
+}
+
+void test_SyncCommand_serializePongForTxStamp_buffer_too_small(void) {
+    char buffer[32];
+    uint16_t stampOffset = 0;
+
+    TEST_ASSERT_FALSE(SyncCommand::serializePongForTxStamp(buffer, sizeof(buffer), 42, 1000000, stampOffset));
+}
+
+/**
+ * @brief Offset error when T1/T3 are taken before vs. after the TX queue
+ *
+ * Both gloves hold sync messages in BLEManager's TX queue for 0-4ms (one
+ * loop() pass plus MACROCYCLE chunks ahead of them). Stamping at enqueue
+ * counts that wait as path delay; stamping at write does not.
+ */
+void test_SimpleSyncProtocol_tx_stamp_removes_queue_delay_from_offset(void) {
+    const int64_t trueOffset = 3000;
+    const uint32_t oneWayUs = 5000;
+    const uint32_t processingUs = 300;
+    const uint32_t maxQueueUs = 4000;
+    const int samples = 500;
+
+    Prng rng(2024);
+    SimpleSyncProtocol legacy;
+    SimpleSyncProtocol stamped;
+    double sumLegacy = 0, sumSqLegacy = 0, sumStamped = 0, sumSqStamped = 0;
+
+    for (int i = 0; i < samples; i++) {
+        int64_t enqueuePing = 1000000 + (int64_t)i * 1000000;
+        int64_t writePing = enqueuePing + rng.below(maxQueueUs);
+        int64_t t2 = writePing + oneWayUs + trueOffset;            // SECONDARY clock
+        int64_t enqueuePong = t2 + processingUs;
+        int64_t writePong = enqueuePong + rng.below(maxQueueUs);
+        int64_t t4 = writePong - trueOffset + oneWayUs;            // PRIMARY clock
+
+        int64_t errLegacy = legacy.calculatePTPOffset(enqueuePing, t2, enqueuePong, t4) - trueOffset;
+        int64_t errStamped = stamped.calculatePTPOffset(writePing, t2, writePong, t4) - trueOffset;
+        legacy.updateLatency((uint32_t)((t4 - enqueuePing) - (enqueuePong - t2)));
+        stamped.updateLatency((uint32_t)((t4 - writePing) - (writePong - t2)));
+
+        sumLegacy += errLegacy;
+        sumSqLegacy += (double)errLegacy * errLegacy;
+        sumStamped += errStamped;
+        sumSqStamped += (double)errStamped * errStamped;
+    }
+
+    double meanLegacy = sumLegacy / samples;
+    double meanStamped = sumStamped / samples;
+    double varLegacy = sumSqLegacy / samples - meanLegacy * meanLegacy;
+    double varStamped = sumSqStamped / samples - meanStamped * meanStamped;
+
+    printf("[SIM] Offset error stddev: enqueue-stamped=%.0f us, write-stamped=%.0f us\n",
+           sqrt(varLegacy), sqrt(varStamped));
+    printf("[SIM] Average RTT: enqueue-stamped=%lu us, write-stamped=%lu us (true %lu us)\n",
+           (unsigned long)legacy.getAverageRTT(), (unsigned long)stamped.getAverageRTT(),
+           (unsigned long)(2 * oneWayUs));
+
+    // Queue delay is one-sided per direction: it shows up as offset noise
+    TEST_ASSERT_TRUE(sqrt(varLegacy) > 500.0);
+    TEST_ASSERT_TRUE(varStamped < 1.0);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, (float)meanStamped);
+    TEST_ASSERT_UINT32_WITHIN(50, 2 * oneWayUs, stamped.getAverageRTT());
+    TEST_ASSERT_TRUE(legacy.getAverageRTT() > stamped.getAverageRTT() + 1000);
+}
+
 void test_SyncCommand_createDebugFlashWithTime(void) {
     SyncCommand cmd = SyncCommand::createDebugFlashWithTime(42, 5000000);
 
@@ -1184,12 +1479,12 @@ void test_SyncCommand_serializeMacrocycle_basic(void) {
     mc.durationMs = 100;
     mc.eventCount = 2;
 
-    mc.events[0].deltaTimeMs = 0;
+    mc.events[0].deltaTimeUs = 0;
     mc.events[0].finger = 0;
     mc.events[0].amplitude = 80;
     mc.events[0].freqOffset = 0;
 
-    mc.events[1].deltaTimeMs = 50;
+    mc.events[1].deltaTimeUs = 50000;
     mc.events[1].finger = 1;
     mc.events[1].amplitude = 90;
     mc.events[1].freqOffset = 0;
@@ -1197,33 +1492,122 @@ void test_SyncCommand_serializeMacrocycle_basic(void) {
     char buffer[256];
     TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc));
 
-    // Verify format: MC:seq|baseMs|offHigh|offLow|dur|count|...
-    TEST_ASSERT_NOT_NULL(strstr(buffer, "MC:42|"));
+    // Verify format: MU:seq|baseHigh|baseLow|offHigh|offLow|dur|count|...
+    TEST_ASSERT_EQUAL_STRING("MU:42|0|5000000|0|1000|100|2|0,0,80|50000,1,90", buffer);
+}
+
+void test_SyncCommand_serializeMacrocycle_v4_legacy(void) {
+    Macrocycle mc;
+    mc.sequenceId = 42;
+    mc.baseTime = 5000400;
+    mc.clockOffset = 1000;
+    mc.durationMs = 100;
+    mc.eventCount = 2;
+
+    mc.events[0].deltaTimeUs = 0;
+    mc.events[0].finger = 0;
+    mc.events[0].amplitude = 80;
+    mc.events[0].freqOffset = 0;
+
+    mc.events[1].deltaTimeUs = 50700;  // Absolute 5051100us -> 5051ms
+    mc.events[1].finger = 1;
+    mc.events[1].amplitude = 90;
+    mc.events[1].freqOffset = 0;
+
+    char buffer[256];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MacrocycleWireFormat::TEXT_V4));
+
+    // Same layout older SECONDARY firmware parses: MC:seq|baseMs|offHigh|offLow|dur|count|dMs,...
+    TEST_ASSERT_EQUAL_STRING("MC:42|5000|0|1000|100|2|0,0,80|51,1,90", buffer);
+
+    // Non-text formats are not serialized here
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MacrocycleWireFormat::BINARY_V1));
+}
+
+void test_SyncCommand_serializeMacrocycle_v4_rejects_wide_delta(void) {
+    Macrocycle mc;
+    mc.sequenceId = 1;
+    mc.baseTime = 1000000;
+    mc.clockOffset = 0;
+    mc.durationMs = 50;
+    mc.eventCount = 1;
+    mc.events[0].deltaTimeUs = 70000000;  // 70s does not fit V4's uint16 ms
+
+    char buffer[256];
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MacrocycleWireFormat::TEXT_V4));
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc));
 }
 
 void test_SyncCommand_deserializeMacrocycle_basic(void) {
     // Create a valid macrocycle message
-    // Format: MC:seq|baseMs|offHigh|offLow|dur|count|d,f,a|d,f,a
-    const char* message = "MC:42|5000|0|1000|100|2|0,0,80|50,1,90";
+    // Format: MU:seq|baseHigh|baseLow|offHigh|offLow|dur|count|d,f,a|d,f,a
+    const char* message = "MU:42|0|5000000|0|1000|100|2|0,0,80|50000,1,90";
 
     Macrocycle mc;
     TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycle(message, strlen(message), mc));
 
     TEST_ASSERT_EQUAL_UINT32(42, mc.sequenceId);
-    TEST_ASSERT_EQUAL_UINT64(5000000, mc.baseTime);  // 5000ms → 5000000μs
+    TEST_ASSERT_EQUAL_UINT64(5000000, mc.baseTime);
     TEST_ASSERT_EQUAL_INT64(1000, mc.clockOffset);
     TEST_ASSERT_EQUAL_UINT16(100, mc.durationMs);
     TEST_ASSERT_EQUAL_UINT8(2, mc.eventCount);
 
-    TEST_ASSERT_EQUAL_UINT16(0, mc.events[0].deltaTimeMs);
+    TEST_ASSERT_EQUAL_UINT32(0, mc.events[0].deltaTimeUs);
     TEST_ASSERT_EQUAL_UINT8(0, mc.events[0].finger);
     TEST_ASSERT_EQUAL_UINT8(80, mc.events[0].amplitude);
 
-    TEST_ASSERT_EQUAL_UINT16(50, mc.events[1].deltaTimeMs);
+    TEST_ASSERT_EQUAL_UINT32(50000, mc.events[1].deltaTimeUs);
     TEST_ASSERT_EQUAL_UINT8(1, mc.events[1].finger);
     TEST_ASSERT_EQUAL_UINT8(90, mc.events[1].amplitude);
 }
 
+void test_SyncCommand_deserializeMacrocycle_v4_legacy(void) {
+    // Sent by older PRIMARY firmware: baseTime and deltas in ms
+    const char* message = "MC:42|5000|0|1000|100|2|0,0,80|167,1,90,10";
+
+    Macrocycle mc;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycle(message, strlen(message), mc));
+
+    TEST_ASSERT_EQUAL_UINT32(42, mc.sequenceId);
+    TEST_ASSERT_EQUAL_UINT64(5000000, mc.baseTime);
+    TEST_ASSERT_EQUAL_INT64(1000, mc.clockOffset);
+    TEST_ASSERT_EQUAL_UINT16(100, mc.durationMs);
+    TEST_ASSERT_EQUAL_UINT8(2, mc.eventCount);
+    TEST_ASSERT_EQUAL_UINT32(0, mc.events[0].deltaTimeUs);
+    TEST_ASSERT_EQUAL_UINT32(167000, mc.events[1].deltaTimeUs);
+    TEST_ASSERT_EQUAL_UINT8(1, mc.events[1].finger);
+    TEST_ASSERT_EQUAL_UINT8(10, mc.events[1].freqOffset);
+}
+
+void test_SyncCommand_macrocycle_v4_round_trip_within_1ms(void) {
+    Macrocycle mc;
+    mc.sequenceId = 7;
+    mc.baseTime = 123456789;
+    mc.clockOffset = -5000;
+    mc.durationMs = 100;
+    mc.eventCount = MACROCYCLE_MAX_EVENTS;
+    for (uint8_t i = 0; i < MACROCYCLE_MAX_EVENTS; i++) {
+        mc.events[i].deltaTimeUs = i * 167413u + 3u;
+        mc.events[i].finger = static_cast<uint8_t>(i % MAX_ACTUATORS);
+        mc.events[i].amplitude = 100;
+        mc.events[i].freqOffset = 0;
+    }
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc, MacrocycleWireFormat::TEXT_V4));
+
+    Macrocycle out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycle(buffer, strlen(buffer), out));
+    TEST_ASSERT_EQUAL_UINT8(mc.eventCount, out.eventCount);
+    for (uint8_t i = 0; i < mc.eventCount; i++) {
+        // Absolute event times are truncated to ms, never accumulated
+        uint64_t sent = mc.baseTime + mc.events[i].deltaTimeUs;
+        uint64_t received = out.baseTime + out.events[i].deltaTimeUs;
+        TEST_ASSERT_TRUE(received <= sent);
+        TEST_ASSERT_TRUE(sent - received < 1000);
+    }
+}
+
 void test_SyncCommand_serializeMacrocycle_with_freqOffset(void) {
     Macrocycle mc;
     mc.sequenceId = 1;
@@ -1232,7 +1616,7 @@ void test_SyncCommand_serializeMacrocycle_with_freqOffset(void) {
     mc.durationMs = 50;
     mc.eventCount = 1;
 
-    mc.events[0].deltaTimeMs = 0;
+    mc.events[0].deltaTimeUs = 0;
     mc.events[0].finger = 2;
     mc.events[0].amplitude = 100;
     mc.events[0].freqOffset = 25;  // Non-zero freqOffset
@@ -1275,11 +1659,441 @@ void test_SyncCommand_getMacrocycleSerializedSize(void) {
 
     size_t size = SyncCommand::getMacrocycleSerializedSize(mc);
 
-    // Header (~50) + 5 events * 12 bytes = ~110
+    // Header (~50) + 5 events * 17 bytes = ~135
     TEST_ASSERT_TRUE(size >= 100);
     TEST_ASSERT_TRUE(size <= 150);
 }
 
+// =============================================================================
+// BINARY MACROCYCLE SERIALIZATION TESTS
+// =============================================================================
+
+/**
+ * @brief Fill a full 12-event macrocycle with field values that exercise
+ * every byte of the packed encoding (negative offset, high bits set,
+ * sub-millisecond baseTime and event offsets)
+ */
+static void fillFullMacrocycle(Macrocycle& mc) {
+    mc.sequenceId = 0xDEADBEEF;
+    mc.baseTime = 4000000000ULL * 1000ULL + 777;  // ~46 days uptime, ms value has bit 31 set
+    mc.clockOffset = -12345678901LL;
+    mc.durationMs = 100;
+    mc.eventCount = MACROCYCLE_MAX_EVENTS;
+    for (uint8_t i = 0; i < MACROCYCLE_MAX_EVENTS; i++) {
+        mc.events[i].deltaTimeUs = i * 167413u + 3u;
+        mc.events[i].finger = static_cast<uint8_t>(i % MAX_ACTUATORS);
+        mc.events[i].amplitude = static_cast<uint8_t>(60 + i);
+        mc.events[i].freqOffset = static_cast<uint8_t>(i * 2);
+        mc.events[i].durationMs = 100;
+    }
+}
+
+void test_SyncCommand_macrocycleBinary_round_trip(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+    TEST_ASSERT_EQUAL(0, strncmp(buffer, "MB:", 3));
+
+    Macrocycle out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleBinary(buffer, strlen(buffer), out));
+
+    TEST_ASSERT_EQUAL_UINT32(mc.sequenceId, out.sequenceId);
+    TEST_ASSERT_EQUAL_UINT64(mc.baseTime, out.baseTime);
+    TEST_ASSERT_EQUAL_INT64(mc.clockOffset, out.clockOffset);
+    TEST_ASSERT_EQUAL_UINT16(mc.durationMs, out.durationMs);
+    TEST_ASSERT_EQUAL_UINT8(mc.eventCount, out.eventCount);
+    for (uint8_t i = 0; i < mc.eventCount; i++) {
+        TEST_ASSERT_EQUAL_UINT32(mc.events[i].deltaTimeUs, out.events[i].deltaTimeUs);
+        TEST_ASSERT_EQUAL_UINT8(mc.events[i].finger, out.events[i].finger);
+        TEST_ASSERT_EQUAL_UINT8(mc.events[i].amplitude, out.events[i].amplitude);
+        TEST_ASSERT_EQUAL_UINT8(mc.events[i].freqOffset, out.events[i].freqOffset);
+        TEST_ASSERT_EQUAL_UINT16(mc.durationMs, out.events[i].durationMs);
+    }
+}
+
+void test_SyncCommand_macrocycleBinary_matches_text_decode(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+    mc.baseTime = 5000000;
+    mc.clockOffset = 1000;
+
+    char textBuf[MESSAGE_BUFFER_SIZE];
+    char binBuf[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(textBuf, sizeof(textBuf), mc));
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleBinary(binBuf, sizeof(binBuf), mc));
+
+    Macrocycle fromText;
+    Macrocycle fromBin;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycle(textBuf, strlen(textBuf), fromText));
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleBinary(binBuf, strlen(binBuf), fromBin));
+
+    TEST_ASSERT_EQUAL_UINT64(fromText.baseTime, fromBin.baseTime);
+    TEST_ASSERT_EQUAL_INT64(fromText.clockOffset, fromBin.clockOffset);
+    TEST_ASSERT_EQUAL_UINT8(fromText.eventCount, fromBin.eventCount);
+    TEST_ASSERT_EQUAL_MEMORY(fromText.events, fromBin.events, sizeof(fromText.events));
+}
+
+void test_SyncCommand_macrocycleBinary_frame_safe_bytes(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+
+    // Payload must never contain NUL, EOT, CR or text delimiters
+    size_t len = strlen(buffer);
+    TEST_ASSERT_EQUAL(SyncCommand::getMacrocycleBinarySize(mc), len);
+    for (size_t i = 3; i < len; i++) {
+        TEST_ASSERT_TRUE((static_cast<uint8_t>(buffer[i]) & 0x80) != 0);
+    }
+}
+
+void test_SyncCommand_macrocycleBinary_size_fits_single_chunk(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char textBuf[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(textBuf, sizeof(textBuf), mc));
+
+    // Full macrocycle + EOT fits in one BLE notification; text V5 does not
+    size_t binSize = SyncCommand::getMacrocycleBinarySize(mc);
+    TEST_ASSERT_EQUAL(95, binSize);
+    TEST_ASSERT_TRUE(binSize + 1 <= BLE_CHUNK_SIZE);
+    TEST_ASSERT_TRUE(binSize < strlen(textBuf));
+    TEST_ASSERT_TRUE(strlen(textBuf) + 1 > BLE_CHUNK_SIZE);
+
+    printf("[SIZE] 12-event MACROCYCLE: binary=%u bytes, text V5=%u bytes\n",
+           (unsigned)binSize, (unsigned)strlen(textBuf));
+}
+
+void test_SyncCommand_macrocycleBinary_buffer_too_small(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[95];  // Needs 95 + NUL
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleBinary(nullptr, 0, mc));
+}
+
+void test_SyncCommand_macrocycleBinary_rejects_malformed(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+    size_t len = strlen(buffer);
+    Macrocycle out;
+
+    // Truncated frame
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBinary(buffer, len - 1, out));
+
+    // Wrong prefix (text decoder input)
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBinary("MC:42|0|5000000|0|1000|100|2|0,0,80", 36, out));
+
+    // Non-packed byte in payload
+    char corrupt[MESSAGE_BUFFER_SIZE];
+    memcpy(corrupt, buffer, len + 1);
+    corrupt[10] = 'x';
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBinary(corrupt, len, out));
+
+    // Null / empty
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBinary(nullptr, 0, out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBinary("", 0, out));
+}
+
+void test_SyncCommand_macrocycleBinary_rejects_unknown_version(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+
+    // First packed byte carries the top 7 bits of the version byte
+    // (version 2 → 0x81); bump it to encode version 4
+    buffer[3] = static_cast<char>(0x82);
+    Macrocycle out;
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBinary(buffer, strlen(buffer), out));
+}
+
+void test_SyncCommand_macrocycleBinary_rejects_unencodable_events(void) {
+    char buffer[MESSAGE_BUFFER_SIZE];
+    Macrocycle mc;
+
+    // Events out of order (negative gap)
+    fillFullMacrocycle(mc);
+    mc.events[5].deltaTimeUs = mc.events[4].deltaTimeUs - 1;
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+
+    // Gap wider than 21 bits; the widest legal gap still round-trips
+    fillFullMacrocycle(mc);
+    mc.eventCount = 2;
+    mc.events[1].deltaTimeUs = mc.events[0].deltaTimeUs + MACROCYCLE_BINARY_MAX_GAP_US + 1;
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+    mc.events[1].deltaTimeUs = mc.events[0].deltaTimeUs + MACROCYCLE_BINARY_MAX_GAP_US;
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+    Macrocycle out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleBinary(buffer, strlen(buffer), out));
+    TEST_ASSERT_EQUAL_UINT32(mc.events[1].deltaTimeUs, out.events[1].deltaTimeUs);
+
+    // Finger / amplitude wider than their bit fields
+    fillFullMacrocycle(mc);
+    mc.events[3].finger = MACROCYCLE_BINARY_MAX_FINGER + 1;
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+    fillFullMacrocycle(mc);
+    mc.events[3].amplitude = MACROCYCLE_BINARY_MAX_AMPLITUDE + 1;
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mc));
+}
+
+void test_SyncCommand_macrocycleText_preserves_microseconds(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc));
+
+    Macrocycle out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycle(buffer, strlen(buffer), out));
+    TEST_ASSERT_EQUAL_UINT64(mc.baseTime, out.baseTime);
+    TEST_ASSERT_EQUAL_UINT8(mc.eventCount, out.eventCount);
+    for (uint8_t i = 0; i < mc.eventCount; i++) {
+        TEST_ASSERT_EQUAL_UINT32(mc.events[i].deltaTimeUs, out.events[i].deltaTimeUs);
+    }
+}
+
+void test_SyncCommand_macrocycleText_fails_instead_of_truncating(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    // Room for the header and a few events only
+    char buffer[200];
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mc));
+}
+
+void test_SyncCommand_macrocycleBinary_throughput(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+    mc.baseTime = 5000000;
+
+    char textBuf[MESSAGE_BUFFER_SIZE];
+    char binBuf[MESSAGE_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycle(textBuf, sizeof(textBuf), mc));
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleBinary(binBuf, sizeof(binBuf), mc));
+    size_t textLen = strlen(textBuf);
+    size_t binLen = strlen(binBuf);
+
+    constexpr uint32_t ITERATIONS = 20000;
+    Macrocycle out;
+    uint32_t ok = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        ok += SyncCommand::deserializeMacrocycle(textBuf, textLen, out) ? 1 : 0;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        ok += SyncCommand::deserializeMacrocycleBinary(binBuf, binLen, out) ? 1 : 0;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    TEST_ASSERT_EQUAL_UINT32(ITERATIONS * 2, ok);
+
+    double textNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / ITERATIONS;
+    double binNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / ITERATIONS;
+    printf("[PERF] MACROCYCLE decode: text V5=%.0f ns, binary=%.0f ns (%.1fx)\n",
+           textNs, binNs, binNs > 0 ? textNs / binNs : 0.0);
+}
+
+// =============================================================================
+// SEEDED MACROCYCLE SERIALIZATION TESTS
+// =============================================================================
+
+static SeededSession makeSeededSession() {
+    SeededSession session;
+    session.seed = 0xF00DCAFE12345678ULL;
+    session.patternType = 1;
+    session.timeOnMs = 100.0f;
+    session.timeOffMs = 67.0f;
+    session.jitterPercent = 23.5f;
+    session.numFingers = 4;
+    session.mirrorPattern = true;
+    session.amplitudeMin = 60;
+    session.amplitudeMax = 90;
+    session.frequencyRandomization = true;
+    session.frequencyMin = 210;
+    session.frequencyMax = 260;
+    session.coastBudget = 2;
+    return session;
+}
+
+void test_SyncCommand_seededSession_round_trip(void) {
+    SeededSession session = makeSeededSession();
+
+    char buffer[160];
+    TEST_ASSERT_TRUE(SyncCommand::serializeSeededSession(buffer, sizeof(buffer), session));
+    TEST_ASSERT_EQUAL(0, strncmp(buffer, SEEDED_SESSION_PREFIX, SEEDED_PREFIX_LEN));
+
+    SeededSession out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeSeededSession(buffer, out));
+    TEST_ASSERT_EQUAL_UINT64(session.seed, out.seed);
+    TEST_ASSERT_EQUAL_UINT8(session.patternType, out.patternType);
+    // Bit-identical floats, not just close
+    TEST_ASSERT_EQUAL_MEMORY(&session.timeOnMs, &out.timeOnMs, sizeof(float));
+    TEST_ASSERT_EQUAL_MEMORY(&session.timeOffMs, &out.timeOffMs, sizeof(float));
+    TEST_ASSERT_EQUAL_MEMORY(&session.jitterPercent, &out.jitterPercent, sizeof(float));
+    TEST_ASSERT_EQUAL_UINT8(session.numFingers, out.numFingers);
+    TEST_ASSERT_TRUE(out.mirrorPattern);
+    TEST_ASSERT_EQUAL_UINT8(session.amplitudeMin, out.amplitudeMin);
+    TEST_ASSERT_EQUAL_UINT8(session.amplitudeMax, out.amplitudeMax);
+    TEST_ASSERT_TRUE(out.frequencyRandomization);
+    TEST_ASSERT_EQUAL_UINT16(session.frequencyMin, out.frequencyMin);
+    TEST_ASSERT_EQUAL_UINT16(session.frequencyMax, out.frequencyMax);
+    TEST_ASSERT_EQUAL_UINT8(session.coastBudget, out.coastBudget);
+    TEST_ASSERT_EQUAL_UINT16(session.tag(), out.tag());
+}
+
+void test_SyncCommand_seededSession_rejects_malformed(void) {
+    SeededSession out;
+    char buffer[160];
+
+    // Zero seed means "not seeded"
+    SeededSession unseeded = makeSeededSession();
+    unseeded.seed = 0;
+    TEST_ASSERT_TRUE(SyncCommand::serializeSeededSession(buffer, sizeof(buffer), unseeded));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeSeededSession(buffer, out));
+
+    // Truncated field list
+    TEST_ASSERT_FALSE(SyncCommand::deserializeSeededSession("SS:1|2|0|0", out));
+    // Trailing garbage
+    SeededSession session = makeSeededSession();
+    TEST_ASSERT_TRUE(SyncCommand::serializeSeededSession(buffer, sizeof(buffer), session));
+    strcat(buffer, "x");
+    TEST_ASSERT_FALSE(SyncCommand::deserializeSeededSession(buffer, out));
+    // Wrong prefix / null
+    TEST_ASSERT_FALSE(SyncCommand::deserializeSeededSession("MC:1|2", out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeSeededSession(nullptr, out));
+    // Buffer too small
+    TEST_ASSERT_FALSE(SyncCommand::serializeSeededSession(buffer, 16, session));
+}
+
+void test_SyncCommand_macrocycleBeacon_round_trip(void) {
+    Macrocycle mc;
+    fillFullMacrocycle(mc);
+
+    char buffer[64];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleBeacon(buffer, sizeof(buffer), mc, 0xBEEF));
+    TEST_ASSERT_EQUAL(0, strncmp(buffer, MACROCYCLE_BEACON_PREFIX, SEEDED_PREFIX_LEN));
+
+    Macrocycle out;
+    uint16_t tag = 0;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleBeacon(buffer, out, tag));
+    TEST_ASSERT_EQUAL_UINT32(mc.sequenceId, out.sequenceId);
+    TEST_ASSERT_EQUAL_UINT64(mc.baseTime, out.baseTime);   // Full us, no ms truncation
+    TEST_ASSERT_EQUAL_INT64(mc.clockOffset, out.clockOffset);
+    TEST_ASSERT_EQUAL_UINT16(0xBEEF, tag);
+    TEST_ASSERT_EQUAL_UINT8(0, out.eventCount);
+
+    // Smaller than the macrocycle it replaces even with every field at full width
+    printf("[SIZE] MACROCYCLE beacon=%u bytes vs binary=%u bytes\n",
+           (unsigned)strlen(buffer), (unsigned)SyncCommand::getMacrocycleBinarySize(mc));
+    TEST_ASSERT_TRUE(strlen(buffer) < SyncCommand::getMacrocycleBinarySize(mc));
+}
+
+void test_SyncCommand_macrocycleBeacon_rejects_malformed(void) {
+    Macrocycle out;
+    uint16_t tag = 0;
+
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBeacon("MN:1|0|5000|0|0", out, tag));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBeacon("MN:1|0|5000|0|0|7|9", out, tag));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBeacon("MN:1|0|50a0|0|0|7", out, tag));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBeacon("MC:1|0|5000|0|0|7", out, tag));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleBeacon(nullptr, out, tag));
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleBeacon("MN:1|0|5000|0|0|7", out, tag));
+}
+
+// =============================================================================
+// MACROCYCLE_ACK FEEDBACK TESTS
+// =============================================================================
+
+void test_SyncCommand_macrocycleAck_plain_has_no_feedback(void) {
+    char buffer[MACROCYCLE_ACK_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleAck(buffer, sizeof(buffer), 42, nullptr));
+    TEST_ASSERT_EQUAL(0, strncmp(buffer, "MC_ACK:42|", 10));
+
+    MacrocycleFeedback out;
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleAckFeedback(buffer, out));
+}
+
+void test_SyncCommand_macrocycleAck_feedback_round_trip(void) {
+    MacrocycleFeedback fb;
+    fb.sequenceId = 41;
+    fb.eventCount = 4;
+    fb.latenessUs[0] = 35;
+    fb.latenessUs[1] = -12;
+    fb.latenessUs[3] = INT16_MAX;   // [2] never started
+
+    char buffer[MACROCYCLE_ACK_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleAck(buffer, sizeof(buffer), 42, &fb));
+
+    // Old PRIMARY parsing (seq only) still works
+    TEST_ASSERT_EQUAL_UINT32(42, (uint32_t)strtoul(buffer + 7, nullptr, 10));
+
+    MacrocycleFeedback out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleAckFeedback(buffer, out));
+    TEST_ASSERT_EQUAL_UINT32(41, out.sequenceId);
+    TEST_ASSERT_EQUAL_UINT8(4, out.eventCount);
+    TEST_ASSERT_EQUAL_INT16(35, out.latenessUs[0]);
+    TEST_ASSERT_EQUAL_INT16(-12, out.latenessUs[1]);
+    TEST_ASSERT_EQUAL_INT16(MACROCYCLE_LATENESS_NONE, out.latenessUs[2]);
+    TEST_ASSERT_EQUAL_INT16(INT16_MAX, out.latenessUs[3]);
+}
+
+void test_SyncCommand_macrocycleAck_full_feedback_fits(void) {
+    // Every field at full width; micros() is 32-bit, so the timestamp
+    // gets its widest low word and the wrapped (high word) digits are added below
+    MacrocycleFeedback fb;
+    fb.sequenceId = UINT32_MAX;
+    fb.eventCount = MACROCYCLE_MAX_EVENTS;
+    for (uint8_t i = 0; i < MACROCYCLE_MAX_EVENTS; i++) {
+        fb.latenessUs[i] = (int16_t)(MACROCYCLE_LATENESS_NONE + 1);
+    }
+    mockSetMicros(UINT32_MAX);
+
+    char buffer[MACROCYCLE_ACK_BUFFER_SIZE];
+    TEST_ASSERT_TRUE(SyncCommand::serializeMacrocycleAck(buffer, sizeof(buffer), UINT32_MAX, &fb));
+
+    // Timestamp after 2^32 - 1 micros() wraps prints as 20 digits (high + low word)
+    const char* tsStart = strchr(buffer, '|') + 1;
+    size_t tsDigits = (size_t)(strchr(tsStart, '|') - tsStart);
+    size_t worstLen = strlen(buffer) - tsDigits + 20;
+    printf("[SIZE] MC_ACK with %u-event feedback=%u bytes, %u with a wrapped 64-bit timestamp (plain ~20)\n",
+           (unsigned)MACROCYCLE_MAX_EVENTS, (unsigned)strlen(buffer), (unsigned)worstLen);
+    TEST_ASSERT_TRUE(worstLen < MACROCYCLE_ACK_BUFFER_SIZE);
+
+    MacrocycleFeedback out;
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleAckFeedback(buffer, out));
+    TEST_ASSERT_EQUAL_UINT8(MACROCYCLE_MAX_EVENTS, out.eventCount);
+    TEST_ASSERT_EQUAL_INT16(MACROCYCLE_LATENESS_NONE + 1, out.latenessUs[MACROCYCLE_MAX_EVENTS - 1]);
+
+    // Fails rather than truncating
+    TEST_ASSERT_FALSE(SyncCommand::serializeMacrocycleAck(buffer, 64, UINT32_MAX, &fb));
+}
+
+void test_SyncCommand_macrocycleAck_rejects_malformed_feedback(void) {
+    MacrocycleFeedback out;
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleAckFeedback("MC_ACK:5|100|4|1,x", out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleAckFeedback("MC_ACK:5|100|4|1;2", out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleAckFeedback("MC_ACK:5|100|4|40000", out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleAckFeedback("MC_ACK:5|100|4|-32768", out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleAckFeedback("MC_ACK:5|100|x|1", out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleAckFeedback("MC_ACK:5|100|4|1,2,3,4,5,6,7,8,9,10,11,12,13", out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleAckFeedback("MC:5|100|4|1", out));
+    TEST_ASSERT_FALSE(SyncCommand::deserializeMacrocycleAckFeedback(nullptr, out));
+    TEST_ASSERT_TRUE(SyncCommand::deserializeMacrocycleAckFeedback("MC_ACK:5|100|4|,", out));
+    TEST_ASSERT_EQUAL_UINT8(2, out.eventCount);
+}
+
 // =============================================================================
 // 64-BIT TIMING UTILITY TESTS
 // =============================================================================
@@ -1386,6 +2200,16 @@ int main(int argc, char **argv) {
     RUN_TEST(test_SyncCommand_deserialize_unknown_command);
     RUN_TEST(test_SyncCommand_deserialize_roundtrip);
 
+    // SyncCommandView (zero-copy) Tests
+    RUN_TEST(test_SyncCommandView_parse_pong_fields);
+    RUN_TEST(test_SyncCommandView_fields_point_into_buffer);
+    RUN_TEST(test_SyncCommandView_signed_and_64bit_values);
+    RUN_TEST(test_SyncCommandView_overlong_values_saturate);
+    RUN_TEST(test_SyncCommandView_parse_invalid);
+    RUN_TEST(test_SyncCommandView_matches_SyncCommand);
+    RUN_TEST(test_SyncCommandView_owning_copy);
+    RUN_TEST(test_SyncCommandView_footprint);
+
     // SyncCommand Factory Method Tests
     RUN_TEST(test_SyncCommand_createStartSession);
     RUN_TEST(test_SyncCommand_createPauseSession);
@@ -1399,6 +2223,14 @@ int main(int argc, char **argv) {
     RUN_TEST(test_SequenceGenerator_reset);
     RUN_TEST(test_global_sequence_generator);
 
+    // MacrocycleReceiveWindow Tests
+    RUN_TEST(test_MacrocycleReceiveWindow_first_is_new_timeline);
+    RUN_TEST(test_MacrocycleReceiveWindow_in_order_and_duplicates);
+    RUN_TEST(test_MacrocycleReceiveWindow_fills_gap_out_of_order);
+    RUN_TEST(test_MacrocycleReceiveWindow_far_sequence_is_new_timeline);
+    RUN_TEST(test_MacrocycleReceiveWindow_wraps);
+    RUN_TEST(test_MacrocycleReceiveWindow_reset);
+
     // SimpleSyncProtocol Tests
     RUN_TEST(test_SimpleSyncProtocol_initial_state);
     RUN_TEST(test_SimpleSyncProtocol_calculateOffset);
@@ -1488,6 +2320,10 @@ int main(int argc, char **argv) {
     // Factory Method Tests for PTP Commands
     RUN_TEST(test_SyncCommand_createPingWithT1);
     RUN_TEST(test_SyncCommand_createPongWithTimestamps);
+    RUN_TEST(test_SyncCommand_serializePongForTxStamp_placeholder);
+    RUN_TEST(test_SyncCommand_stampTxTime_keeps_length_and_parses);
+    RUN_TEST(test_SyncCommand_serializePongForTxStamp_buffer_too_small);
+    RUN_TEST(test_SimpleSyncProtocol_tx_stamp_removes_queue_delay_from_offset);
     RUN_TEST(test_SyncCommand_createDebugFlashWithTime);
     RUN_TEST(test_SyncCommand_createDebugFlash);
     RUN_TEST(test_SyncCommand_createPing);
@@ -1503,12 +2339,41 @@ int main(int argc, char **argv) {
 
     // Macrocycle serialization tests
     RUN_TEST(test_SyncCommand_serializeMacrocycle_basic);
+    RUN_TEST(test_SyncCommand_serializeMacrocycle_v4_legacy);
+    RUN_TEST(test_SyncCommand_serializeMacrocycle_v4_rejects_wide_delta);
     RUN_TEST(test_SyncCommand_deserializeMacrocycle_basic);
+    RUN_TEST(test_SyncCommand_deserializeMacrocycle_v4_legacy);
+    RUN_TEST(test_SyncCommand_macrocycle_v4_round_trip_within_1ms);
     RUN_TEST(test_SyncCommand_serializeMacrocycle_with_freqOffset);
     RUN_TEST(test_SyncCommand_serializeMacrocycle_buffer_too_small);
     RUN_TEST(test_SyncCommand_deserializeMacrocycle_invalid);
     RUN_TEST(test_SyncCommand_getMacrocycleSerializedSize);
 
+    // Binary macrocycle serialization tests
+    RUN_TEST(test_SyncCommand_macrocycleBinary_round_trip);
+    RUN_TEST(test_SyncCommand_macrocycleBinary_matches_text_decode);
+    RUN_TEST(test_SyncCommand_macrocycleBinary_frame_safe_bytes);
+    RUN_TEST(test_SyncCommand_macrocycleBinary_size_fits_single_chunk);
+    RUN_TEST(test_SyncCommand_macrocycleBinary_buffer_too_small);
+    RUN_TEST(test_SyncCommand_macrocycleBinary_rejects_malformed);
+    RUN_TEST(test_SyncCommand_macrocycleBinary_rejects_unknown_version);
+    RUN_TEST(test_SyncCommand_macrocycleBinary_rejects_unencodable_events);
+    RUN_TEST(test_SyncCommand_macrocycleText_preserves_microseconds);
+    RUN_TEST(test_SyncCommand_macrocycleText_fails_instead_of_truncating);
+    RUN_TEST(test_SyncCommand_macrocycleBinary_throughput);
+
+    // Seeded macrocycle serialization tests
+    RUN_TEST(test_SyncCommand_seededSession_round_trip);
+    RUN_TEST(test_SyncCommand_seededSession_rejects_malformed);
+    RUN_TEST(test_SyncCommand_macrocycleBeacon_round_trip);
+    RUN_TEST(test_SyncCommand_macrocycleBeacon_rejects_malformed);
+
+    // MACROCYCLE_ACK Feedback Tests
+    RUN_TEST(test_SyncCommand_macrocycleAck_plain_has_no_feedback);
+    RUN_TEST(test_SyncCommand_macrocycleAck_feedback_round_trip);
+    RUN_TEST(test_SyncCommand_macrocycleAck_full_feedback_fits);
+    RUN_TEST(test_SyncCommand_macrocycleAck_rejects_malformed_feedback);
+
     // 64-bit timing utilities
     RUN_TEST(test_getMillis64);
     RUN_TEST(test_getMicros_overflow_detection);
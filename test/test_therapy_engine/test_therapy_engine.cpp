@@ -8,6 +8,10 @@
 #include <ranges>
 #include <algorithm>
 #include <vector>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
 
 // Include source files directly for native testing
 // (excluded from build_src_filter to avoid conflicts with other tests)
@@ -33,6 +37,41 @@ bool isValidPermutation(std::span<uint8_t> arr) {
     return true;
 }
 
+// Generator for the free pattern functions, reseeded by setUp()
+static Prng testRng;
+
+// =============================================================================
+// ALLOCATION COUNTING
+// =============================================================================
+
+// Global operator new hook: every heap allocation in this binary is counted,
+// so a zero delta across a block proves it is allocation-free
+static size_t g_allocCount = 0;
+
+void* operator new(size_t size) {
+    g_allocCount++;
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+// The replacement operator new above allocates with malloc(), so free() is
+// the matching release. GCC only sees the operator new/free() pair once
+// these are inlined into their callers and flags it as mismatched
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+#pragma GCC diagnostic pop
+
 // =============================================================================
 // CALLBACK TRACKING
 // =============================================================================
@@ -71,6 +110,7 @@ void mockCycleCompleteCallback(uint32_t count) {
 void setUp(void) {
     // Seed random for reproducibility
     randomSeed(42);
+    testRng.seed(42);
     mockResetTime();
     // Reset getMicros() overflow tracking state (must be after mockResetTime)
     resetMicrosOverflow();
@@ -94,30 +134,30 @@ void tearDown(void) {
 
 void test_shuffleArray_produces_valid_permutation(void) {
     uint8_t arr[4] = {0, 1, 2, 3};
-    shuffleArray(arr);
+    shuffleArray(arr, testRng);
 
     TEST_ASSERT_TRUE(isValidPermutation(arr));
 }
 
 void test_shuffleArray_single_element(void) {
     uint8_t arr[1] = {0};
-    shuffleArray(arr);
+    shuffleArray(arr, testRng);
 
     TEST_ASSERT_EQUAL_UINT8(0, arr[0]);
 }
 
 void test_shuffleArray_two_elements(void) {
     uint8_t arr[2] = {0, 1};
-    shuffleArray(arr);
+    shuffleArray(arr, testRng);
 
     TEST_ASSERT_TRUE(isValidPermutation(arr));
 }
 
 void test_shuffleArray_maintains_all_elements(void) {
-    randomSeed(12345);  // Different seed
+    testRng.seed(12345);  // Different seed
 
     uint8_t arr[4] = {0, 1, 2, 3};
-    shuffleArray(arr);
+    shuffleArray(arr, testRng);
 
     // Count each element - should appear exactly once
     int counts[4] = {0};
@@ -138,8 +178,8 @@ void test_Pattern_default_constructor(void) {
     Pattern p;
 
     TEST_ASSERT_EQUAL_UINT8(4, p.numFingers);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, p.burstDurationMs);
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 668.0f, p.interBurstIntervalMs);
+    TEST_ASSERT_EQUAL_UINT32(100000, p.burstDurationUs);
+    TEST_ASSERT_EQUAL_UINT32(668000, p.interBurstIntervalUs);
 
     // Default sequence is 0,1,2,3
     for (int i = 0; i < 4; i++) {
@@ -148,18 +188,17 @@ void test_Pattern_default_constructor(void) {
     }
 }
 
-void test_Pattern_getTotalDurationMs(void) {
+void test_Pattern_getTotalDurationUs(void) {
     Pattern p;
     p.numFingers = 4;
-    p.burstDurationMs = 100.0f;
+    p.burstDurationUs = 100000;
     for (int i = 0; i < 4; i++) {
-        p.timeOffMs[i] = 500.0f;  // 500ms between each
+        p.timeOffUs[i] = 500000;  // 500ms between each
     }
 
     // Total = sum of (timeOff + burst) for each finger + interBurstInterval
     // = 4 * (500 + 100) + 668 = 3068ms
-    float total = p.getTotalDurationMs();
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 3068.0f, total);
+    TEST_ASSERT_EQUAL_UINT32(3068000, p.getTotalDurationUs());
 }
 
 void test_Pattern_getFingerPair(void) {
@@ -186,7 +225,7 @@ void test_Pattern_getFingerPair(void) {
 // =============================================================================
 
 void test_generateRandomPermutation_produces_valid_pattern(void) {
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(testRng, 4, 100000, 67000, 0.0f, true);
 
     TEST_ASSERT_EQUAL_UINT8(4, p.numFingers);
     TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
@@ -194,16 +233,16 @@ void test_generateRandomPermutation_produces_valid_pattern(void) {
 }
 
 void test_generateRandomPermutation_mirrored(void) {
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(testRng, 4, 100000, 67000, 0.0f, true);
 
     // Mirrored: primary and secondary should be identical
     TEST_ASSERT_TRUE(std::ranges::equal(p.primarySequence, p.secondarySequence));
 }
 
 void test_generateRandomPermutation_non_mirrored(void) {
-    randomSeed(999);  // Seed to ensure different sequences
+    testRng.seed(999);  // Seed to ensure different sequences
 
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 0.0f, false);
+    Pattern p = generateRandomPermutation(testRng, 4, 100000, 67000, 0.0f, false);
 
     // Both should still be valid permutations
     TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
@@ -213,32 +252,32 @@ void test_generateRandomPermutation_non_mirrored(void) {
 }
 
 void test_generateRandomPermutation_with_jitter(void) {
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 23.5f, true);
+    Pattern p = generateRandomPermutation(testRng, 4, 100000, 67000, 23.5f, true);
 
-    // With jitter, timing values will vary but should be positive
+    // With jitter, TIME_OFF varies within ±(167ms * 23.5% / 2) = ±19622us
     for (int i = 0; i < 4; i++) {
-        TEST_ASSERT_TRUE(p.timeOffMs[i] >= 0.0f);
+        TEST_ASSERT_UINT32_WITHIN(19622, 67000, p.timeOffUs[i]);
     }
 }
 
 void test_generateRandomPermutation_partial_fingers(void) {
-    Pattern p = generateRandomPermutation(3, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(testRng, 3, 100000, 67000, 0.0f, true);
 
     TEST_ASSERT_EQUAL_UINT8(3, p.numFingers);
     TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
 }
 
 void test_generateRandomPermutation_burst_duration(void) {
-    Pattern p = generateRandomPermutation(4, 150.0f, 50.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(testRng, 4, 150000, 50000, 0.0f, true);
 
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 150.0f, p.burstDurationMs);
+    TEST_ASSERT_EQUAL_UINT32(150000, p.burstDurationUs);
 }
 
 void test_generateRandomPermutation_interBurstInterval(void) {
     // Inter-burst = 4 * (timeOn + timeOff) = 4 * (100 + 67) = 668
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateRandomPermutation(testRng, 4, 100000, 67000, 0.0f, true);
 
-    TEST_ASSERT_FLOAT_WITHIN(0.1f, 668.0f, p.interBurstIntervalMs);
+    TEST_ASSERT_EQUAL_UINT32(668000, p.interBurstIntervalUs);
 }
 
 // =============================================================================
@@ -246,7 +285,7 @@ void test_generateRandomPermutation_interBurstInterval(void) {
 // =============================================================================
 
 void test_generateSequentialPattern_forward(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 0.0f, true, false);
+    Pattern p = generateSequentialPattern(testRng, 4, 100000, 67000, 0.0f, true, false);
 
     // Sequential forward: 0, 1, 2, 3
     for (int i = 0; i < 4; i++) {
@@ -255,7 +294,7 @@ void test_generateSequentialPattern_forward(void) {
 }
 
 void test_generateSequentialPattern_reverse(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 0.0f, true, true);
+    Pattern p = generateSequentialPattern(testRng, 4, 100000, 67000, 0.0f, true, true);
 
     // Sequential reverse: 3, 2, 1, 0
     for (int i = 0; i < 4; i++) {
@@ -264,14 +303,14 @@ void test_generateSequentialPattern_reverse(void) {
 }
 
 void test_generateSequentialPattern_mirrored(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 0.0f, true, false);
+    Pattern p = generateSequentialPattern(testRng, 4, 100000, 67000, 0.0f, true, false);
 
     // Mirrored: primary and secondary identical
     TEST_ASSERT_TRUE(std::ranges::equal(p.primarySequence, p.secondarySequence));
 }
 
 void test_generateSequentialPattern_non_mirrored(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 0.0f, false, false);
+    Pattern p = generateSequentialPattern(testRng, 4, 100000, 67000, 0.0f, false, false);
 
     // Non-mirrored: secondary is opposite order of primary
     // Primary: 0,1,2,3  Secondary: 3,2,1,0
@@ -286,7 +325,7 @@ void test_generateSequentialPattern_non_mirrored(void) {
 // =============================================================================
 
 void test_generateMirroredPattern_not_randomized(void) {
-    Pattern p = generateMirroredPattern(4, 100.0f, 67.0f, 0.0f, false);
+    Pattern p = generateMirroredPattern(testRng, 4, 100000, 67000, 0.0f, false);
 
     // Not randomized: sequential
     for (int i = 0; i < 4; i++) {
@@ -298,7 +337,7 @@ void test_generateMirroredPattern_not_randomized(void) {
 }
 
 void test_generateMirroredPattern_randomized(void) {
-    Pattern p = generateMirroredPattern(4, 100.0f, 67.0f, 0.0f, true);
+    Pattern p = generateMirroredPattern(testRng, 4, 100000, 67000, 0.0f, true);
 
     // Randomized: valid permutation
     TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
@@ -558,31 +597,31 @@ void test_TherapyEngine_fixed_amplitude(void) {
 
 void test_generateRandomPermutation_high_jitter(void) {
     // Test with 50% jitter (extreme case)
-    Pattern p = generateRandomPermutation(4, 100.0f, 67.0f, 50.0f, true);
+    Pattern p = generateRandomPermutation(testRng, 4, 100000, 67000, 50.0f, true);
 
     TEST_ASSERT_EQUAL_UINT8(4, p.numFingers);
-    // With high jitter, timing values should still be valid
+    // With high jitter, TIME_OFF stays within ±(167ms * 50% / 2) = ±41750us
     for (int i = 0; i < 4; i++) {
-        TEST_ASSERT_TRUE(p.timeOffMs[i] >= 0.0f);
+        TEST_ASSERT_UINT32_WITHIN(41750, 67000, p.timeOffUs[i]);
     }
 }
 
 void test_generateSequentialPattern_with_jitter(void) {
-    Pattern p = generateSequentialPattern(4, 100.0f, 67.0f, 23.5f, true, false);
+    Pattern p = generateSequentialPattern(testRng, 4, 100000, 67000, 23.5f, true, false);
 
     TEST_ASSERT_EQUAL_UINT8(4, p.numFingers);
     // Jitter should be applied to timing
     for (int i = 0; i < 4; i++) {
-        TEST_ASSERT_TRUE(p.timeOffMs[i] >= 0.0f);
+        TEST_ASSERT_UINT32_WITHIN(19622, 67000, p.timeOffUs[i]);
     }
 }
 
 void test_generateMirroredPattern_with_jitter(void) {
-    Pattern p = generateMirroredPattern(4, 100.0f, 67.0f, 23.5f, true);
+    Pattern p = generateMirroredPattern(testRng, 4, 100000, 67000, 23.5f, true);
 
     TEST_ASSERT_EQUAL_UINT8(4, p.numFingers);
     for (int i = 0; i < 4; i++) {
-        TEST_ASSERT_TRUE(p.timeOffMs[i] >= 0.0f);
+        TEST_ASSERT_UINT32_WITHIN(19622, 67000, p.timeOffUs[i]);
     }
 }
 
@@ -1097,7 +1136,7 @@ void test_MacrocycleEvent_getFrequencyHz(void) {
 void test_MacrocycleEvent_constructor(void) {
     MacrocycleEvent evt(500, 2, 3, 100, 75, 210);
 
-    TEST_ASSERT_EQUAL_UINT16(500, evt.deltaTimeMs);
+    TEST_ASSERT_EQUAL_UINT32(500, evt.deltaTimeUs);
     TEST_ASSERT_EQUAL_UINT8(2, evt.finger);
     TEST_ASSERT_EQUAL_UINT8(3, evt.primaryFinger);
     TEST_ASSERT_EQUAL_UINT8(100, evt.amplitude);
@@ -1105,6 +1144,916 @@ void test_MacrocycleEvent_constructor(void) {
     TEST_ASSERT_EQUAL_UINT16(210, evt.getFrequencyHz());
 }
 
+// =============================================================================
+// MACROCYCLE PIPELINING TESTS
+// =============================================================================
+
+static Macrocycle g_pipelineSent[16];
+static int g_pipelineSentCount = 0;
+
+void mockPipelineSendCallback(const Macrocycle& mc) {
+    if (g_pipelineSentCount < 16) {
+        g_pipelineSent[g_pipelineSentCount] = mc;
+    }
+    g_pipelineSentCount++;
+}
+
+/**
+ * @brief Start a pipelined session (100ms ON / 67ms OFF, 50ms lead time) at t=1000ms
+ */
+static void startPipelinedSession(TherapyEngine& engine, uint8_t depth) {
+    engine.setSendMacrocycleCallback(mockPipelineSendCallback);
+    engine.setSchedulingCallbacks(mockScheduleActivationCallback, mockStartSchedulingCallback, mockIsSchedulingCompleteCallback);
+    engine.setGetLeadTimeCallback(mockGetLeadTimeCallback);
+    engine.setCycleCompleteCallback(mockCycleCompleteCallback);
+    engine.setPipelineDepth(depth);
+
+    g_pipelineSentCount = 0;
+    g_scheduleActivationCallCount = 0;
+    g_cycleCompleteCallCount = 0;
+    mockSetMillis(1000);
+    engine.startSession(0, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+}
+
+static uint64_t slotEndUs(const Macrocycle& mc) {
+    // Events + 2x TIME_RELAX (2 * 4 * (100 + 67) = 1336ms)
+    return mc.baseTime + mc.getTotalDurationUs() + 1336000ULL;
+}
+
+void test_pipeline_default_depth_is_lockstep(void) {
+    TherapyEngine engine;
+    TEST_ASSERT_EQUAL_UINT8(1, engine.getPipelineDepth());
+
+    engine.setSendMacrocycleCallback(mockPipelineSendCallback);
+    g_pipelineSentCount = 0;
+    mockSetMillis(1000);
+    engine.startSession(0, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    engine.update();
+    engine.update();
+
+    // Lockstep: one macrocycle, nothing tracked in flight
+    TEST_ASSERT_EQUAL_INT(1, g_pipelineSentCount);
+    TEST_ASSERT_EQUAL_UINT8(0, engine.getInFlightCount());
+}
+
+void test_pipeline_depth_is_clamped(void) {
+    TherapyEngine engine;
+
+    engine.setPipelineDepth(0);
+    TEST_ASSERT_EQUAL_UINT8(1, engine.getPipelineDepth());
+
+    engine.setPipelineDepth(200);
+    TEST_ASSERT_EQUAL_UINT8(MACROCYCLE_PIPELINE_MAX_DEPTH, engine.getPipelineDepth());
+}
+
+void test_pipeline_fills_to_depth_one_per_update(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 3);
+
+    engine.update();
+    TEST_ASSERT_EQUAL_INT(1, g_pipelineSentCount);
+    engine.update();
+    engine.update();
+    TEST_ASSERT_EQUAL_INT(3, g_pipelineSentCount);
+    TEST_ASSERT_EQUAL_UINT8(3, engine.getInFlightCount());
+
+    // Full: further updates send nothing new
+    engine.update();
+    TEST_ASSERT_EQUAL_INT(3, g_pipelineSentCount);
+
+    // PRIMARY schedules its local events for every in-flight macrocycle
+    TEST_ASSERT_EQUAL_INT(36, g_scheduleActivationCallCount);
+    TEST_ASSERT_EQUAL_UINT32(3, engine.getPipelineStats().sent);
+}
+
+void test_pipeline_base_times_are_contiguous(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 3);
+
+    engine.update();
+    engine.update();
+    engine.update();
+
+    // Only the first macrocycle pays the lead time
+    TEST_ASSERT_EQUAL_UINT64(1000000ULL + 50000ULL, g_pipelineSent[0].baseTime);
+    // Each following one starts exactly one slot later, regardless of when it was sent
+    TEST_ASSERT_EQUAL_UINT64(slotEndUs(g_pipelineSent[0]), g_pipelineSent[1].baseTime);
+    TEST_ASSERT_EQUAL_UINT64(slotEndUs(g_pipelineSent[1]), g_pipelineSent[2].baseTime);
+    TEST_ASSERT_EQUAL_UINT32(g_pipelineSent[0].sequenceId + 1, g_pipelineSent[1].sequenceId);
+    TEST_ASSERT_EQUAL_UINT32(g_pipelineSent[1].sequenceId + 1, g_pipelineSent[2].sequenceId);
+}
+
+void test_pipeline_retires_at_slot_end_and_tops_up(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 2);
+
+    engine.update();
+    engine.update();
+    TEST_ASSERT_TRUE(engine.onMacrocycleAck(g_pipelineSent[0].sequenceId));
+    TEST_ASSERT_TRUE(engine.onMacrocycleAck(g_pipelineSent[1].sequenceId));
+
+    // Just before the first slot ends: nothing retired
+    mockSetMicros(static_cast<uint32_t>(slotEndUs(g_pipelineSent[0]) - 1));
+    engine.update();
+    TEST_ASSERT_EQUAL_INT(0, g_cycleCompleteCallCount);
+    TEST_ASSERT_EQUAL_INT(2, g_pipelineSentCount);
+
+    // Slot end: first retires, third generated continuing the timeline
+    mockSetMicros(static_cast<uint32_t>(slotEndUs(g_pipelineSent[0])));
+    engine.update();
+    TEST_ASSERT_EQUAL_INT(1, g_cycleCompleteCallCount);
+    TEST_ASSERT_EQUAL_UINT32(1, engine.getCyclesCompleted());
+    TEST_ASSERT_EQUAL_INT(3, g_pipelineSentCount);
+    TEST_ASSERT_EQUAL_UINT64(slotEndUs(g_pipelineSent[1]), g_pipelineSent[2].baseTime);
+    TEST_ASSERT_EQUAL_UINT32(0, engine.getPipelineStats().retiredUnacked);
+}
+
+void test_pipeline_resends_unacked_after_timeout(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 2);
+
+    engine.update();
+    engine.update();
+    // Only the first is acknowledged
+    engine.onMacrocycleAck(g_pipelineSent[0].sequenceId);
+
+    mockAdvanceMillis(MACROCYCLE_ACK_TIMEOUT_MS - 1);
+    engine.update();
+    TEST_ASSERT_EQUAL_INT(2, g_pipelineSentCount);
+
+    mockAdvanceMillis(1);
+    engine.update();
+    TEST_ASSERT_EQUAL_INT(3, g_pipelineSentCount);
+    // Resend is the same macrocycle: same sequence ID and absolute baseTime
+    TEST_ASSERT_EQUAL_UINT32(g_pipelineSent[1].sequenceId, g_pipelineSent[2].sequenceId);
+    TEST_ASSERT_EQUAL_UINT64(g_pipelineSent[1].baseTime, g_pipelineSent[2].baseTime);
+    TEST_ASSERT_EQUAL_UINT32(1, engine.getPipelineStats().resent);
+    TEST_ASSERT_EQUAL_UINT32(1, engine.getPipelineStats().acked);
+
+    // Resend does not schedule PRIMARY's local events again
+    TEST_ASSERT_EQUAL_INT(24, g_scheduleActivationCallCount);
+
+    // Once ACKed, no further resends
+    engine.onMacrocycleAck(g_pipelineSent[1].sequenceId);
+    mockAdvanceMillis(MACROCYCLE_ACK_TIMEOUT_MS);
+    engine.update();
+    TEST_ASSERT_EQUAL_INT(3, g_pipelineSentCount);
+}
+
+void test_pipeline_no_resend_past_cutoff(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 2);
+
+    engine.update();
+    engine.update();
+    engine.onMacrocycleAck(g_pipelineSent[1].sequenceId);
+
+    // First macrocycle (50ms lead) is within the resend cutoff: too late to help
+    mockAdvanceMillis(MACROCYCLE_ACK_TIMEOUT_MS);
+    engine.update();
+    TEST_ASSERT_EQUAL_INT(2, g_pipelineSentCount);
+    TEST_ASSERT_EQUAL_UINT32(0, engine.getPipelineStats().resent);
+
+    // It retires unacknowledged
+    mockSetMicros(static_cast<uint32_t>(slotEndUs(g_pipelineSent[0])));
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT32(1, engine.getPipelineStats().retiredUnacked);
+}
+
+void test_pipeline_ignores_unknown_ack(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 2);
+
+    engine.update();
+    engine.onMacrocycleAck(g_pipelineSent[0].sequenceId + 100);
+    engine.update();
+
+    TEST_ASSERT_EQUAL_UINT32(0, engine.getPipelineStats().acked);
+}
+
+void test_pipeline_ack_ring_full_drops(void) {
+    TherapyEngine engine;
+
+    // Ring of 8 holds 7 pending ACKs until update() drains them
+    for (uint32_t i = 0; i < 7; i++) {
+        TEST_ASSERT_TRUE(engine.onMacrocycleAck(i));
+    }
+    TEST_ASSERT_FALSE(engine.onMacrocycleAck(7));
+}
+
+void test_pipeline_rebases_after_falling_behind(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 2);
+
+    engine.update();
+    engine.update();
+
+    // Paused well past every in-flight slot
+    engine.pause();
+    mockSetMicros(static_cast<uint32_t>(slotEndUs(g_pipelineSent[1]) + 5000000ULL));
+    engine.resume();
+    uint64_t nowUs = getMicros();
+    engine.update();
+
+    // Both retired, new timeline starts from now + lead time
+    TEST_ASSERT_EQUAL_UINT32(2, engine.getCyclesCompleted());
+    TEST_ASSERT_EQUAL_INT(3, g_pipelineSentCount);
+    TEST_ASSERT_EQUAL_UINT64(nowUs + 50000ULL, g_pipelineSent[2].baseTime);
+    TEST_ASSERT_EQUAL_UINT32(1, engine.getPipelineStats().rebased);
+}
+
+void test_pipeline_stop_clears_in_flight(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 3);
+
+    engine.update();
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT8(2, engine.getInFlightCount());
+
+    engine.stop();
+    TEST_ASSERT_EQUAL_UINT8(0, engine.getInFlightCount());
+}
+
+void test_next_macrocycle_due_lockstep_relax(void) {
+    TherapyEngine engine;
+    engine.setSchedulingCallbacks(mockScheduleActivationCallback, mockStartSchedulingCallback, mockIsSchedulingCompleteCallback);
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, engine.getNextMacrocycleDueUs());
+
+    g_schedulingComplete = false;
+    mockSetMillis(1000);
+    engine.startSession(0, PatternType::RNDP, 100.0f, 67.0f, 0.0f, 4, true);
+    // IDLE: sends on the next update
+    TEST_ASSERT_EQUAL_UINT64(1000000ULL, engine.getNextMacrocycleDueUs());
+    engine.update();
+
+    // Queue drains at 3s: relax of 2x TIME_RELAX (1336ms) starts
+    g_schedulingComplete = true;
+    mockSetMillis(3000);
+    engine.update();
+    TEST_ASSERT_EQUAL_UINT64(3000000ULL + 1336000ULL, engine.getNextMacrocycleDueUs());
+
+    // Late in the relax period the queue is still empty, but a macrocycle is near
+    mockSetMillis(4300);
+    TEST_ASSERT_EQUAL_UINT64(4336000ULL, engine.getNextMacrocycleDueUs());
+
+    engine.pause();
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, engine.getNextMacrocycleDueUs());
+}
+
+void test_next_macrocycle_due_pipelined_oldest_slot_end(void) {
+    TherapyEngine engine;
+    startPipelinedSession(engine, 2);
+
+    engine.update();
+    // Pipeline not full: topped up on the next update
+    TEST_ASSERT_EQUAL_UINT64(1000000ULL, engine.getNextMacrocycleDueUs());
+    engine.update();
+
+    // Full: the next one is generated when the oldest retires
+    TEST_ASSERT_EQUAL_UINT64(slotEndUs(g_pipelineSent[0]), engine.getNextMacrocycleDueUs());
+}
+
+// =============================================================================
+// ALLOCATION-FREE GENERATION TESTS
+// =============================================================================
+
+/**
+ * @brief Pre-change Pattern layout (three heap vectors), kept as the baseline
+ */
+struct LegacyVectorPattern {
+    std::vector<uint8_t> primarySequence;
+    std::vector<uint8_t> secondarySequence;
+    std::vector<uint32_t> timeOffUs;
+
+    explicit LegacyVectorPattern(uint8_t numFingers) :
+        primarySequence(numFingers), secondarySequence(numFingers), timeOffUs(numFingers, 67000) {}
+};
+
+/**
+ * @brief Pre-change generateMacrocycle(): RNDP, by-value patterns, returned by value
+ */
+static Macrocycle legacyGenerateMacrocycle(uint8_t numFingers, float timeOnMs, float timeOffMs,
+                                           float jitterPercent, uint8_t ampMin, uint8_t ampMax,
+                                           uint16_t freqMin, uint16_t freqMax, uint16_t* frequency,
+                                           Prng& rng) {
+    Macrocycle mc;
+    auto timeOnUs = static_cast<uint32_t>(timeOnMs * 1000.0f);
+    auto timeOffUs = static_cast<uint32_t>(timeOffMs * 1000.0f);
+    mc.durationMs = static_cast<uint16_t>(timeOnMs);
+    uint32_t cumulativeTimeUs = 0;
+    auto jitterUs = static_cast<uint32_t>(
+        (uint64_t)(timeOnUs + timeOffUs) * static_cast<uint64_t>(jitterPercent * 10000.0f) / 2000000u);
+
+    for (uint8_t patternNum = 0; patternNum < 3; patternNum++) {
+        LegacyVectorPattern pattern(numFingers);
+        for (uint8_t i = 0; i < numFingers; i++) {
+            pattern.primarySequence[i] = i;
+            pattern.secondarySequence[i] = i;
+        }
+        shuffleArray(pattern.primarySequence, rng);
+        shuffleArray(pattern.secondarySequence, rng);
+        for (uint8_t i = 0; i < numFingers; i++) {
+            int64_t offTime = (int64_t)timeOffUs - jitterUs + rng.below(2 * jitterUs + 1);
+            pattern.timeOffUs[i] = offTime < 0 ? 0 : static_cast<uint32_t>(offTime);
+        }
+
+        uint16_t steps = (freqMax - freqMin) / 5;
+        for (uint8_t finger = 0; finger < numFingers; finger++) {
+            frequency[finger] = freqMin + static_cast<uint16_t>(rng.below(steps + 1u) * 5);
+        }
+
+        for (uint8_t i = 0; i < numFingers; i++) {
+            uint8_t amplitude = (uint8_t)rng.range(ampMin, ampMax + 1);
+            mc.events[mc.eventCount++] = MacrocycleEvent(
+                cumulativeTimeUs, pattern.secondarySequence[i], pattern.primarySequence[i],
+                amplitude, mc.durationMs, frequency[pattern.primarySequence[i]]);
+            cumulativeTimeUs += timeOnUs;
+            cumulativeTimeUs += pattern.timeOffUs[i];
+        }
+    }
+    return mc;
+}
+
+static void startBenchmarkSession(TherapyEngine& engine) {
+    mockSetMillis(1000);
+    engine.setFrequencyRandomization(true, 210, 255);
+    engine.startSession(0, PatternType::RNDP, 100.0f, 67.0f, 23.5f, 4, false, 60, 100);
+}
+
+void test_Pattern_fill_does_not_allocate(void) {
+    Pattern p;
+    size_t before = g_allocCount;
+    for (int i = 0; i < 100; i++) {
+        fillRandomPermutation(p, 4, 100000, 67000, 23.5f, false, testRng);
+        fillSequentialPattern(p, 4, 100000, 67000, 23.5f, false, true, testRng);
+        fillMirroredPattern(p, 4, 100000, 67000, 23.5f, true, testRng);
+        Pattern byValue = generateRandomPermutation(testRng, 4, 100000, 67000, 23.5f, true);
+        TEST_ASSERT_EQUAL_UINT8(4, byValue.numFingers);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, g_allocCount - before);
+    TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
+}
+
+void test_Pattern_fill_reuses_buffer_across_sizes(void) {
+    Pattern p;
+    fillRandomPermutation(p, 5, 100000, 67000, 0.0f, false, testRng);
+    TEST_ASSERT_EQUAL_UINT8(5, p.primarySequence.size());
+    TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
+    TEST_ASSERT_TRUE(isValidPermutation(p.secondarySequence));
+
+    fillRandomPermutation(p, 2, 100000, 67000, 0.0f, false, testRng);
+    TEST_ASSERT_EQUAL_UINT8(2, p.primarySequence.size());
+    TEST_ASSERT_EQUAL_UINT8(2, p.timeOffUs.size());
+    TEST_ASSERT_TRUE(isValidPermutation(p.primarySequence));
+    TEST_ASSERT_TRUE(isValidPermutation(p.secondarySequence));
+}
+
+void test_generateMacrocycle_matches_legacy_vector_generator(void) {
+    TherapyEngine engine;
+    startBenchmarkSession(engine);
+    uint16_t legacyFrequency[MAX_ACTUATORS] = {};
+
+    for (uint32_t seed = 1; seed <= 50; seed++) {
+        Prng legacyRng(seed);
+        Macrocycle expected = legacyGenerateMacrocycle(4, 100.0f, 67.0f, 23.5f, 60, 100, 210, 255,
+                                                       legacyFrequency, legacyRng);
+        engine.seedRandom(seed);
+        Macrocycle mc;
+        engine.generateMacrocycle(mc);
+
+        TEST_ASSERT_EQUAL_UINT8(expected.eventCount, mc.eventCount);
+        TEST_ASSERT_EQUAL_UINT16(expected.durationMs, mc.durationMs);
+        for (uint8_t i = 0; i < mc.eventCount; i++) {
+            TEST_ASSERT_EQUAL_UINT32(expected.events[i].deltaTimeUs, mc.events[i].deltaTimeUs);
+            TEST_ASSERT_EQUAL_UINT8(expected.events[i].finger, mc.events[i].finger);
+            TEST_ASSERT_EQUAL_UINT8(expected.events[i].primaryFinger, mc.events[i].primaryFinger);
+            TEST_ASSERT_EQUAL_UINT8(expected.events[i].amplitude, mc.events[i].amplitude);
+            TEST_ASSERT_EQUAL_UINT16(expected.events[i].getFrequencyHz(), mc.events[i].getFrequencyHz());
+        }
+    }
+}
+
+void test_generateMacrocycle_benchmark_zero_allocations(void) {
+    constexpr uint32_t ITERATIONS = 20000;
+    TherapyEngine engine;
+    startBenchmarkSession(engine);
+    uint16_t legacyFrequency[MAX_ACTUATORS] = {};
+    uint32_t checksum = 0;
+
+    Prng legacyRng(42);
+    size_t a0 = g_allocCount;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t it = 0; it < ITERATIONS; it++) {
+        Macrocycle mc = legacyGenerateMacrocycle(4, 100.0f, 67.0f, 23.5f, 60, 100, 210, 255,
+                                                 legacyFrequency, legacyRng);
+        checksum += mc.getTotalDurationUs();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    size_t a1 = g_allocCount;
+
+    engine.seedRandom(42);
+    Macrocycle mc;
+    auto t2 = std::chrono::steady_clock::now();
+    for (uint32_t it = 0; it < ITERATIONS; it++) {
+        engine.generateMacrocycle(mc);
+        checksum -= mc.getTotalDurationUs();
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    size_t a2 = g_allocCount;
+
+    // Same RNG stream, same schedule
+    TEST_ASSERT_EQUAL_UINT32(0, checksum);
+    TEST_ASSERT_EQUAL_UINT32(0, a2 - a1);
+
+    double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / ITERATIONS;
+    double inPlaceNs = std::chrono::duration<double, std::nano>(t3 - t2).count() / ITERATIONS;
+    printf("[PERF] generateMacrocycle: vector patterns=%.0f ns (%.1f allocs), in place=%.0f ns (%.1f allocs)\n",
+           legacyNs, (double)(a1 - a0) / ITERATIONS, inPlaceNs, (double)(a2 - a1) / ITERATIONS);
+    printf("[SIZE] Pattern: %u bytes inline (PATTERN_MAX_FINGERS=%u)\n",
+           (unsigned)sizeof(Pattern), (unsigned)PATTERN_MAX_FINGERS);
+}
+
+// =============================================================================
+// PRNG SUBSYSTEM TESTS
+// =============================================================================
+
+static void assertSameEvents(const Macrocycle& expected, const Macrocycle& actual) {
+    TEST_ASSERT_EQUAL_UINT32(expected.sequenceId, actual.sequenceId);
+    TEST_ASSERT_EQUAL_UINT8(expected.eventCount, actual.eventCount);
+    TEST_ASSERT_EQUAL_UINT16(expected.durationMs, actual.durationMs);
+    for (uint8_t i = 0; i < expected.eventCount; i++) {
+        TEST_ASSERT_EQUAL_UINT32(expected.events[i].deltaTimeUs, actual.events[i].deltaTimeUs);
+        TEST_ASSERT_EQUAL_UINT8(expected.events[i].finger, actual.events[i].finger);
+        TEST_ASSERT_EQUAL_UINT8(expected.events[i].primaryFinger, actual.events[i].primaryFinger);
+        TEST_ASSERT_EQUAL_UINT8(expected.events[i].amplitude, actual.events[i].amplitude);
+        TEST_ASSERT_EQUAL_UINT16(expected.events[i].getFrequencyHz(), actual.events[i].getFrequencyHz());
+    }
+}
+
+/**
+ * @brief Chi-square statistic of shuffleArray() permutation counts
+ *
+ * Every one of the n! orderings of 0..n-1 should be equally likely.
+ */
+static double permutationChiSquare(uint8_t n, uint32_t draws, Prng& rng) {
+    std::vector<uint8_t> identity(n);
+    for (uint8_t i = 0; i < n; i++) {
+        identity[i] = i;
+    }
+    std::vector<std::vector<uint8_t>> perms;
+    std::vector<uint8_t> p = identity;
+    do {
+        perms.push_back(p);
+    } while (std::next_permutation(p.begin(), p.end()));
+
+    std::vector<uint32_t> counts(perms.size(), 0);
+    for (uint32_t d = 0; d < draws; d++) {
+        p = identity;
+        shuffleArray(p, rng);
+        size_t idx = (size_t)(std::lower_bound(perms.begin(), perms.end(), p) - perms.begin());
+        counts[idx]++;
+    }
+
+    double expected = (double)draws / (double)perms.size();
+    double chi2 = 0.0;
+    for (uint32_t c : counts) {
+        double diff = (double)c - expected;
+        chi2 += diff * diff / expected;
+    }
+    return chi2;
+}
+
+void test_shuffleArray_permutations_uniform_4_fingers(void) {
+    Prng rng(2024);
+    double chi2 = permutationChiSquare(4, 240000, rng);
+    printf("[STATS] shuffleArray 4 fingers: chi2=%.1f (df=23, p=0.001 critical 49.7)\n", chi2);
+    TEST_ASSERT_TRUE(chi2 < 49.7);
+}
+
+void test_shuffleArray_permutations_uniform_5_fingers(void) {
+    Prng rng(7);
+    double chi2 = permutationChiSquare(5, 480000, rng);
+    printf("[STATS] shuffleArray 5 fingers: chi2=%.1f (df=119, p=0.001 critical 169.4)\n", chi2);
+    TEST_ASSERT_TRUE(chi2 < 169.4);
+}
+
+void test_seedRandom_replays_session(void) {
+    TherapyEngine original;
+    mockSetMicros(123456);
+    original.setFrequencyRandomization(true, 210, 255);
+    original.startSession(0, PatternType::RNDP, 100.0f, 67.0f, 23.5f, 4, false, 60, 100);
+    uint64_t seed = original.getRandomSeed();
+
+    TherapyEngine replay;
+    mockSetMicros(999999);  // Different time: seed must come from seedRandom()
+    replay.setFrequencyRandomization(true, 210, 255);
+    replay.seedRandom(seed);
+    replay.startSession(0, PatternType::RNDP, 100.0f, 67.0f, 23.5f, 4, false, 60, 100);
+    TEST_ASSERT_EQUAL_UINT64(seed, replay.getRandomSeed());
+
+    for (int n = 0; n < 10; n++) {
+        Macrocycle expected;
+        Macrocycle mc;
+        original.generateMacrocycle(expected);
+        randomSeed(n);  // Arduino random() state is irrelevant
+        replay.generateMacrocycle(mc);
+        assertSameEvents(expected, mc);
+    }
+}
+
+void test_startSession_draws_fresh_seed_each_session(void) {
+    TherapyEngine engine;
+    engine.startSession(0);
+    uint64_t first = engine.getRandomSeed();
+    engine.stop();
+    engine.startSession(0);
+
+    // Pinned seed applies to one session only
+    TEST_ASSERT_NOT_EQUAL(first, engine.getRandomSeed());
+    engine.stop();
+    engine.seedRandom(5);
+    engine.startSession(0);
+    TEST_ASSERT_EQUAL_UINT64(5, engine.getRandomSeed());
+    engine.stop();
+    engine.startSession(0);
+    TEST_ASSERT_NOT_EQUAL(5, engine.getRandomSeed());
+}
+
+void test_Prng_benchmark_vs_arduino_random(void) {
+    constexpr uint32_t ITERATIONS = 1000000;
+    uint32_t sink = 0;
+    Prng rng(1);
+
+    randomSeed(1);
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        sink += (uint32_t)random(-1000, 1001);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        sink += (uint32_t)rng.range(-1000, 1001);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    uint8_t arr[4] = {0, 1, 2, 3};
+    auto t3 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        shuffleArray(arr, rng);
+    }
+    auto t4 = std::chrono::steady_clock::now();
+    sink += arr[0];
+
+    double randomNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / ITERATIONS;
+    double prngNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / ITERATIONS;
+    double shuffleNs = std::chrono::duration<double, std::nano>(t4 - t3).count() / ITERATIONS;
+    printf("[PERF] bounded draw: random()=%.1f ns, Prng::range=%.1f ns | shuffle 4 fingers=%.1f ns (sink=%lu)\n",
+           randomNs, prngNs, shuffleNs, (unsigned long)sink);
+    TEST_ASSERT_TRUE(isValidPermutation(arr));
+}
+
+// =============================================================================
+// SEEDED MACROCYCLE TESTS
+// =============================================================================
+
+void test_unseeded_session_has_no_seed(void) {
+    TherapyEngine engine;
+    startBenchmarkSession(engine);
+
+    TEST_ASSERT_FALSE(engine.isSeeded());
+    TEST_ASSERT_EQUAL_UINT64(0, engine.getSeededSession().seed);
+}
+
+void test_seeded_replica_regenerates_primary_macrocycles(void) {
+    TherapyEngine primary;
+    primary.setSeededGeneration(true);
+    startBenchmarkSession(primary);
+    TEST_ASSERT_TRUE(primary.isSeeded());
+
+    constexpr uint8_t COUNT = 16;
+    Macrocycle generated[COUNT];
+    for (uint8_t n = 0; n < COUNT; n++) {
+        primary.generateMacrocycle(generated[n]);
+    }
+
+    // SECONDARY only ever sees the SS: parameters and sequence IDs
+    TherapyEngine secondary;
+    secondary.loadSeededSession(primary.getSeededSession());
+    TEST_ASSERT_FALSE(secondary.isRunning());
+
+    // Out of order, as after a coasted or lost beacon
+    for (int n = COUNT - 1; n >= 0; n -= 2) {
+        Macrocycle mc;
+        secondary.generateSeededMacrocycle(mc, generated[n].sequenceId);
+        assertSameEvents(generated[n], mc);
+    }
+    for (uint8_t n = 0; n < COUNT; n += 2) {
+        Macrocycle mc;
+        secondary.generateSeededMacrocycle(mc, generated[n].sequenceId);
+        assertSameEvents(generated[n], mc);
+    }
+}
+
+void test_seeded_generation_independent_of_arduino_random(void) {
+    TherapyEngine engine;
+    engine.setSeededGeneration(true);
+    startBenchmarkSession(engine);
+
+    Macrocycle first;
+    Macrocycle second;
+    randomSeed(1);
+    engine.generateSeededMacrocycle(first, 7);
+    randomSeed(999);
+    (void)random(1000);
+    engine.generateSeededMacrocycle(second, 7);
+    assertSameEvents(first, second);
+}
+
+void test_seeded_sessions_differ_by_seed_and_sequence(void) {
+    TherapyEngine engine;
+    engine.setSeededGeneration(true);
+    startBenchmarkSession(engine);
+    SeededSession session = engine.getSeededSession();
+
+    TherapyEngine other;
+    SeededSession otherSession = session;
+    otherSession.seed ^= 1;
+    other.loadSeededSession(otherSession);
+
+    // Over 8 macrocycles a different seed or sequence ID changes the schedule
+    uint8_t sameSeedDiffers = 0;
+    uint8_t otherSeedDiffers = 0;
+    for (uint32_t n = 0; n < 8; n++) {
+        Macrocycle a, b, c;
+        engine.generateSeededMacrocycle(a, n);
+        engine.generateSeededMacrocycle(b, n + 1);
+        other.generateSeededMacrocycle(c, n);
+        if (memcmp(a.events, b.events, sizeof(a.events)) != 0) sameSeedDiffers++;
+        if (memcmp(a.events, c.events, sizeof(a.events)) != 0) otherSeedDiffers++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(8, sameSeedDiffers);
+    TEST_ASSERT_EQUAL_UINT8(8, otherSeedDiffers);
+    TEST_ASSERT_NOT_EQUAL(session.tag(), otherSession.tag());
+}
+
+// =============================================================================
+// INTEGER MICROSECOND TIMELINE TESTS
+// =============================================================================
+
+static std::vector<uint64_t> g_timelineActivations;
+static TherapyEngine* g_timelineEngine = nullptr;
+
+static void timelineScheduleCallback(uint64_t timeUs, uint8_t finger, uint8_t amp, uint16_t durMs, uint16_t freqHz) {
+    g_timelineActivations.push_back(timeUs);
+}
+
+static void timelineSendCallback(const Macrocycle& mc) {
+    // SECONDARY ACKs every macrocycle immediately
+    g_timelineEngine->onMacrocycleAck(mc.sequenceId);
+}
+
+void test_long_durations_do_not_wrap(void) {
+    TherapyEngine engine;
+    engine.setSendMacrocycleCallback(mockSendMacrocycleCallback);
+    mockSetMillis(1000);
+    engine.startSession(0, PatternType::RNDP, 300.0f, 67.0f, 0.0f, 4, true);
+
+    Macrocycle mc;
+    engine.generateMacrocycle(mc);
+
+    // 300ms used to be cast through uint8_t (44ms)
+    TEST_ASSERT_EQUAL_UINT16(300, mc.durationMs);
+    for (uint8_t i = 0; i < mc.eventCount; i++) {
+        TEST_ASSERT_EQUAL_UINT16(300, mc.events[i].durationMs);
+        TEST_ASSERT_EQUAL_UINT32(i * 367000u, mc.events[i].deltaTimeUs);
+    }
+}
+
+void test_sub_millisecond_timing_survives_generation(void) {
+    TherapyEngine engine;
+    mockSetMillis(1000);
+    engine.startSession(0, PatternType::RNDP, 100.0f, 66.7f, 0.0f, 4, true);
+
+    Macrocycle mc;
+    engine.generateMacrocycle(mc);
+
+    // 166.7ms per event: truncating to whole ms lost 0.7ms per event
+    for (uint8_t i = 0; i < mc.eventCount; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i * 166700u, mc.events[i].deltaTimeUs);
+    }
+    // Slot: last event + ON + 2 x TIME_RELAX (8 x 166.7ms)
+    TEST_ASSERT_EQUAL_UINT32(11 * 166700u + 100000u + 8 * 166700u, engine.getMacrocycleSlotUs(mc));
+}
+
+void test_two_hour_session_has_zero_cumulative_schedule_error(void) {
+    // Pipelined session with a non-integer-ms profile and 23.5% jitter, run for
+    // two hours of mock time. Every PRIMARY activation must land exactly where
+    // the patterns (regenerated here from the same seed) say it should.
+    constexpr uint64_t SESSION_US = 2ULL * 3600ULL * 1000000ULL;
+    constexpr uint32_t STEP_US = 20000;
+    constexpr uint32_t ON_US = 100000;
+    constexpr uint32_t OFF_US = 66700;
+    constexpr uint32_t DOUBLE_RELAX_US = 8 * (ON_US + OFF_US);
+    constexpr uint64_t SEED = 0x5EED2024ULL;
+
+    TherapyEngine engine;
+    g_timelineEngine = &engine;
+    g_timelineActivations.clear();
+    g_timelineActivations.reserve(30000);
+    engine.setSendMacrocycleCallback(timelineSendCallback);
+    engine.setSchedulingCallbacks(timelineScheduleCallback, mockStartSchedulingCallback, mockIsSchedulingCompleteCallback);
+    engine.setGetLeadTimeCallback(mockGetLeadTimeCallback);
+    engine.setPipelineDepth(2);
+
+    mockSetMillis(1000);
+    uint64_t startUs = getMicros();
+    engine.seedRandom(SEED);
+    engine.startSession(0, PatternType::RNDP, 100.0f, 66.7f, 23.5f, 4, true, 80, 80);
+
+    // Small steps keep getMicros() tracking the 32-bit micros() wrap at 71 minutes
+    for (uint64_t elapsed = 0; elapsed < SESSION_US; elapsed += STEP_US) {
+        engine.update();
+        mockAdvanceMicros(STEP_US);
+    }
+    engine.stop();
+
+    size_t macrocycles = g_timelineActivations.size() / MACROCYCLE_MAX_EVENTS;
+    TEST_ASSERT_EQUAL_UINT32(0, engine.getPipelineStats().rebased);
+    TEST_ASSERT_TRUE(macrocycles > 2000);
+
+    // Reference: replay the engine's draws (one pattern at startSession, then 3
+    // per macrocycle) and accumulate the ideal timeline in integer µs. Alongside,
+    // total what whole-millisecond truncation of the same schedule would lose.
+    Prng ref(SEED);
+    Pattern p;
+    fillRandomPermutation(p, 4, ON_US, OFF_US, 23.5f, true, ref);
+    uint64_t expected = startUs + 50000;
+    uint64_t truncationLossUs = 0;
+    int64_t maxErrorUs = 0;
+    size_t k = 0;
+    for (size_t m = 0; m < macrocycles; m++) {
+        uint64_t lastEvent = expected;
+        for (uint8_t patternNum = 0; patternNum < 3; patternNum++) {
+            fillRandomPermutation(p, 4, ON_US, OFF_US, 23.5f, true, ref);
+            for (uint8_t i = 0; i < 4; i++) {
+                int64_t error = (int64_t)g_timelineActivations[k++] - (int64_t)expected;
+                maxErrorUs = std::max(maxErrorUs, error < 0 ? -error : error);
+                lastEvent = expected;
+                expected += ON_US + p.timeOffUs[i];
+                truncationLossUs += p.timeOffUs[i] % 1000;
+            }
+        }
+        // Next macrocycle: last event + ON + 2x TIME_RELAX (not the last TIME_OFF)
+        truncationLossUs -= p.timeOffUs[3] % 1000;
+        truncationLossUs += DOUBLE_RELAX_US % 1000;
+        expected = lastEvent + ON_US + DOUBLE_RELAX_US;
+    }
+
+    uint64_t lastUs = g_timelineActivations[k - 1];
+    printf("[STATS] 2h session: %u macrocycles, %u activations over %.1f min, max schedule error %lld us "
+           "(whole-ms truncation would drift %.1f ms)\n",
+           (unsigned)macrocycles, (unsigned)k, (double)(lastUs - startUs) / 60e6,
+           (long long)maxErrorUs, (double)truncationLossUs / 1000.0);
+    TEST_ASSERT_EQUAL_INT64(0, maxErrorUs);
+    TEST_ASSERT_TRUE(lastUs - startUs > SESSION_US - 10000000ULL);
+}
+
+// =============================================================================
+// MACROCYCLE DOUBLE BUFFER TESTS
+// =============================================================================
+
+static std::vector<Macrocycle> g_bufferSent;
+static std::vector<bool> g_idleStepPrecomputed;
+static uint64_t g_bufferSendUs = 0;
+
+static void bufferSendCallback(const Macrocycle& mc) {
+    g_bufferSent.push_back(mc);
+    g_bufferSendUs = getMicros();
+}
+
+static void bufferIdleStepCallback(uint32_t elapsedUs, bool precomputed) {
+    (void)elapsedUs;
+    g_idleStepPrecomputed.push_back(precomputed);
+}
+
+static void slowMacrocycleStartCallback(uint32_t cycleNum) {
+    (void)cycleNum;
+    mockAdvanceMicros(3000);  // e.g. a DEBUG flash sent over BLE
+}
+
+static void startBufferSession(TherapyEngine& engine, bool precompute) {
+    g_schedulingComplete = true;
+    engine.setSendMacrocycleCallback(bufferSendCallback);
+    engine.setSchedulingCallbacks(mockScheduleActivationCallback, mockStartSchedulingCallback, mockIsSchedulingCompleteCallback);
+    engine.setIdleStepTimeCallback(bufferIdleStepCallback);
+    engine.setMacrocyclePrecompute(precompute);
+    engine.seedRandom(77);
+    engine.startSession(0, PatternType::RNDP, 100.0f, 67.0f, 23.5f, 4, false, 50, 100);
+}
+
+// Returns wall-clock nanoseconds spent in the IDLE step
+static double runLockstepCycle(TherapyEngine& engine) {
+    auto t0 = std::chrono::steady_clock::now();
+    engine.update();  // IDLE -> ACTIVE
+    auto t1 = std::chrono::steady_clock::now();
+    mockAdvanceMillis(100);
+    engine.update();  // ACTIVE -> WAITING_RELAX
+    mockAdvanceMillis(1400);
+    engine.update();  // Next macrocycle generated, WAITING_RELAX -> IDLE
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+void test_lockstep_precomputed_macrocycles_match_inline(void) {
+    constexpr int CYCLES = 5;
+    mockSetMillis(1000);
+
+    TherapyEngine inlineEngine;
+    g_bufferSent.clear();
+    g_idleStepPrecomputed.clear();
+    startBufferSession(inlineEngine, false);
+    for (int i = 0; i < CYCLES; i++) {
+        runLockstepCycle(inlineEngine);
+    }
+    std::vector<Macrocycle> inlineSent = g_bufferSent;
+    for (bool precomputed : g_idleStepPrecomputed) {
+        TEST_ASSERT_FALSE(precomputed);
+    }
+
+    TherapyEngine engine;
+    g_bufferSent.clear();
+    g_idleStepPrecomputed.clear();
+    startBufferSession(engine, true);
+    for (int i = 0; i < CYCLES; i++) {
+        runLockstepCycle(engine);
+    }
+
+    // Same draws in the same order, just earlier
+    TEST_ASSERT_EQUAL_INT(CYCLES, (int)g_bufferSent.size());
+    TEST_ASSERT_EQUAL_INT(CYCLES, (int)g_idleStepPrecomputed.size());
+    for (int i = 0; i < CYCLES; i++) {
+        TEST_ASSERT_TRUE(g_idleStepPrecomputed[i]);
+        TEST_ASSERT_EQUAL_UINT32(inlineSent[i].sequenceId, g_bufferSent[i].sequenceId);
+        assertSameEvents(inlineSent[i], g_bufferSent[i]);
+    }
+}
+
+void test_lockstep_baseTime_stamped_just_before_send(void) {
+    TherapyEngine engine;
+    g_bufferSent.clear();
+    mockSetMillis(1000);
+    engine.setMacrocycleStartCallback(slowMacrocycleStartCallback);
+    startBufferSession(engine, true);
+    engine.update();
+
+    // Work done before the send must not eat into the 50ms default lead time
+    TEST_ASSERT_EQUAL_INT(1, (int)g_bufferSent.size());
+    TEST_ASSERT_EQUAL_UINT64(g_bufferSendUs + 50000, g_bufferSent[0].baseTime);
+}
+
+void test_setFrequencyRandomization_discards_precomputed_macrocycle(void) {
+    TherapyEngine engine;
+    g_bufferSent.clear();
+    g_idleStepPrecomputed.clear();
+    mockSetMillis(1000);
+    startBufferSession(engine, true);  // Precomputed with fixed 250 Hz
+
+    engine.setFrequencyRandomization(true, 210, 255);
+    engine.update();
+
+    TEST_ASSERT_EQUAL_INT(1, (int)g_idleStepPrecomputed.size());
+    TEST_ASSERT_FALSE(g_idleStepPrecomputed[0]);
+    bool randomized = false;
+    for (uint8_t i = 0; i < g_bufferSent[0].eventCount; i++) {
+        uint16_t freq = g_bufferSent[0].events[i].getFrequencyHz();
+        TEST_ASSERT_TRUE(freq >= 210 && freq <= 255);
+        randomized |= (freq != 250);
+    }
+    TEST_ASSERT_TRUE(randomized);
+}
+
+void test_idle_step_benchmark_precomputed_vs_inline(void) {
+    constexpr int CYCLES = 2000;
+    mockSetMillis(1000);
+    double totalNs[2] = {0.0, 0.0};
+
+    for (int precompute = 0; precompute < 2; precompute++) {
+        TherapyEngine engine;
+        g_bufferSent.clear();
+        g_bufferSent.reserve(CYCLES);
+        g_idleStepPrecomputed.clear();
+        startBufferSession(engine, precompute != 0);
+        for (int i = 0; i < CYCLES; i++) {
+            totalNs[precompute] += runLockstepCycle(engine);
+        }
+        TEST_ASSERT_EQUAL_INT(CYCLES, (int)g_bufferSent.size());
+        for (bool precomputed : g_idleStepPrecomputed) {
+            TEST_ASSERT_EQUAL(precompute != 0, precomputed);
+        }
+    }
+
+    printf("[PERF] lockstep IDLE step: inline generation=%.0f ns, precomputed=%.0f ns\n",
+           totalNs[0] / CYCLES, totalNs[1] / CYCLES);
+}
+
 // =============================================================================
 // TEST RUNNER
 // =============================================================================
@@ -1120,7 +2069,7 @@ int main(int argc, char **argv) {
 
     // Pattern Struct Tests
     RUN_TEST(test_Pattern_default_constructor);
-    RUN_TEST(test_Pattern_getTotalDurationMs);
+    RUN_TEST(test_Pattern_getTotalDurationUs);
     RUN_TEST(test_Pattern_getFingerPair);
 
     // Generate Random Permutation Tests
@@ -1231,5 +2180,50 @@ int main(int argc, char **argv) {
     RUN_TEST(test_MacrocycleEvent_getFrequencyHz);
     RUN_TEST(test_MacrocycleEvent_constructor);
 
+    // Macrocycle Pipelining Tests
+    RUN_TEST(test_pipeline_default_depth_is_lockstep);
+    RUN_TEST(test_pipeline_depth_is_clamped);
+    RUN_TEST(test_pipeline_fills_to_depth_one_per_update);
+    RUN_TEST(test_pipeline_base_times_are_contiguous);
+    RUN_TEST(test_pipeline_retires_at_slot_end_and_tops_up);
+    RUN_TEST(test_pipeline_resends_unacked_after_timeout);
+    RUN_TEST(test_pipeline_no_resend_past_cutoff);
+    RUN_TEST(test_pipeline_ignores_unknown_ack);
+    RUN_TEST(test_pipeline_ack_ring_full_drops);
+    RUN_TEST(test_pipeline_rebases_after_falling_behind);
+    RUN_TEST(test_pipeline_stop_clears_in_flight);
+    RUN_TEST(test_next_macrocycle_due_lockstep_relax);
+    RUN_TEST(test_next_macrocycle_due_pipelined_oldest_slot_end);
+
+    // Allocation-Free Generation Tests
+    RUN_TEST(test_Pattern_fill_does_not_allocate);
+    RUN_TEST(test_Pattern_fill_reuses_buffer_across_sizes);
+    RUN_TEST(test_generateMacrocycle_matches_legacy_vector_generator);
+    RUN_TEST(test_generateMacrocycle_benchmark_zero_allocations);
+
+    // PRNG Subsystem Tests
+    RUN_TEST(test_shuffleArray_permutations_uniform_4_fingers);
+    RUN_TEST(test_shuffleArray_permutations_uniform_5_fingers);
+    RUN_TEST(test_seedRandom_replays_session);
+    RUN_TEST(test_startSession_draws_fresh_seed_each_session);
+    RUN_TEST(test_Prng_benchmark_vs_arduino_random);
+
+    // Seeded Macrocycle Tests
+    RUN_TEST(test_unseeded_session_has_no_seed);
+    RUN_TEST(test_seeded_replica_regenerates_primary_macrocycles);
+    RUN_TEST(test_seeded_generation_independent_of_arduino_random);
+    RUN_TEST(test_seeded_sessions_differ_by_seed_and_sequence);
+
+    // Integer Microsecond Timeline Tests
+    RUN_TEST(test_long_durations_do_not_wrap);
+    RUN_TEST(test_sub_millisecond_timing_survives_generation);
+    RUN_TEST(test_two_hour_session_has_zero_cumulative_schedule_error);
+
+    // Macrocycle Double Buffer Tests
+    RUN_TEST(test_lockstep_precomputed_macrocycles_match_inline);
+    RUN_TEST(test_lockstep_baseTime_stamped_just_before_send);
+    RUN_TEST(test_setFrequencyRandomization_discards_precomputed_macrocycle);
+    RUN_TEST(test_idle_step_benchmark_precomputed_vs_inline);
+
     return UNITY_END();
 }
@@ -0,0 +1,312 @@
+/**
+ * @file test_two_glove_sim.cpp
+ * @brief End-to-end PRIMARY + SECONDARY simulation: bilateral activation skew
+ *
+ * Runs the real TherapyEngine, SimpleSyncProtocol/ClockServo, MACROCYCLE
+ * serialization and motor event queues for both gloves in one process (see
+ * two_glove_sim.h). The [SIM] output is the benchmark: compare it before and
+ * after a timing change. Build with -DMACROCYCLE_PIPELINE_DEPTH=N to
+ * benchmark pipelined macrocycles.
+ */
+
+#include <unity.h>
+#include <stdio.h>
+
+// Include source files directly for native testing
+// (excluded from build_src_filter to avoid conflicts with other tests)
+#include "../../src/sync_protocol.cpp"
+#include "../../src/therapy_engine.cpp"
+
+#include "two_glove_sim.h"
+
+// =============================================================================
+// TEST FIXTURES
+// =============================================================================
+
+void setUp(void) {
+    mockResetTime();
+    resetMicrosOverflow();
+}
+
+void tearDown(void) {}
+
+/**
+ * @brief Typical bench setup: SECONDARY booted 2.5s after PRIMARY, crystals
+ *        20 ppm apart, 7.5ms connection interval
+ */
+static SimConfig realisticConfig() {
+    SimConfig config;
+    config.primaryClock = {2500000, -8.0f};
+    config.secondaryClock = {0, 12.0f};
+    config.link = {7500, 1000, 1500, 20, 6};
+    config.execLatencyUs = 200;
+    config.sessionMs = 120000;
+    return config;
+}
+
+// =============================================================================
+// SIM CLOCK TESTS
+// =============================================================================
+
+void test_SimClock_applies_offset_and_drift(void) {
+    SimClock clock({1000000, 50.0f});
+
+    TEST_ASSERT_EQUAL_UINT64(1000000, clock.localAt(0));
+    // 50 ppm over 10s = 500us
+    TEST_ASSERT_EQUAL_UINT64(11000500, clock.localAt(10000000));
+}
+
+void test_SimClock_trueAt_inverts_localAt(void) {
+    SimClock clock({123456, -37.5f});
+
+    for (uint64_t t = 0; t < 600000000ULL; t += 7777777ULL) {
+        uint64_t local = clock.localAt(t);
+        uint64_t back = clock.trueAt(local);
+        TEST_ASSERT_TRUE(clock.localAt(back) >= local);
+        TEST_ASSERT_TRUE(back == 0 || clock.localAt(back - 1) < local);
+    }
+}
+
+// =============================================================================
+// SIM LINK TESTS
+// =============================================================================
+
+void test_SimLink_quantizes_to_connection_events(void) {
+    SimLink link({7500, 1000, 0, 0, 6}, 1);
+    std::string payload;
+
+    TEST_ASSERT_TRUE(link.send(100, "A"));
+    // Next connection event at 7500, +1000 latency
+    TEST_ASSERT_EQUAL_UINT64(8500, link.nextDeliveryUs());
+    TEST_ASSERT_FALSE(link.receive(8499, payload));
+    TEST_ASSERT_TRUE(link.receive(8500, payload));
+    TEST_ASSERT_EQUAL_STRING("A", payload.c_str());
+}
+
+void test_SimLink_preserves_order_under_jitter(void) {
+    SimLink link({7500, 1000, 5000, 0, 6}, 7);
+    char msg[8];
+    for (int i = 0; i < 50; i++) {
+        snprintf(msg, sizeof(msg), "%d", i);
+        link.send((uint64_t)i * 100, msg);
+    }
+
+    std::string payload;
+    int expected = 0;
+    uint64_t t = 0;
+    while (expected < 50) {
+        t += 100;
+        while (link.receive(t, payload)) {
+            TEST_ASSERT_EQUAL_INT(expected, atoi(payload.c_str()));
+            expected++;
+        }
+    }
+}
+
+void test_SimLink_retransmits_then_drops(void) {
+    SimLink lossy({7500, 0, 0, 1000, 2}, 3);  // Every attempt fails
+
+    TEST_ASSERT_FALSE(lossy.send(0, "X"));
+    TEST_ASSERT_EQUAL_UINT32(2, lossy.getStats().retransmits);
+    TEST_ASSERT_EQUAL_UINT32(1, lossy.getStats().dropped);
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, lossy.nextDeliveryUs());
+}
+
+// =============================================================================
+// END-TO-END SIMULATION TESTS
+// =============================================================================
+
+void test_sim_ideal_link_near_zero_skew(void) {
+    // Symmetric fixed delay, no drift: PTP offset is exact
+    SimConfig config;
+    config.primaryClock = {3000000, 0.0f};
+    config.secondaryClock = {0, 0.0f};
+    config.link = {0, 4000, 0, 0, 6};
+    config.secondaryProcessingUs = 0;
+    config.sessionMs = 30000;
+
+    TwoGloveSim sim(config);
+    SimReport report = sim.run();
+    TwoGloveSim::printReport("ideal link", report);
+
+    TEST_ASSERT_TRUE(report.matched > 100);
+    TEST_ASSERT_EQUAL_UINT32(0, report.missedOnSecondary);
+    TEST_ASSERT_TRUE(report.skew.maxAbsUs <= 50);
+}
+
+void test_sim_is_deterministic(void) {
+    SimConfig config = realisticConfig();
+    config.sessionMs = 30000;
+
+    SimReport first = TwoGloveSim(config).run();
+    SimReport second = TwoGloveSim(config).run();
+
+    TEST_ASSERT_EQUAL_UINT32(first.matched, second.matched);
+    TEST_ASSERT_TRUE(first.skewUs == second.skewUs);
+    TEST_ASSERT_TRUE(first.offsetErrorUs == second.offsetErrorUs);
+}
+
+void test_sim_realistic_drift_and_jitter(void) {
+    SimConfig config = realisticConfig();
+
+    TwoGloveSim sim(config);
+    SimReport report = sim.run();
+    TwoGloveSim::printReport("20ppm, 7.5ms CI, 2% loss", report);
+
+    TEST_ASSERT_TRUE(report.matched > 400);
+    TEST_ASSERT_TRUE(report.missedOnSecondary <= report.matched / 50);
+    TEST_ASSERT_EQUAL_UINT32(0, sim.getPrimary().getQueueFullCount());
+    TEST_ASSERT_EQUAL_UINT32(0, sim.getSecondary().getQueueFullCount());
+    // Regression bound, well inside one 100ms burst. Connection-event
+    // quantization makes PONG wait longer than PING, which biases the offset
+    TEST_ASSERT_TRUE(report.skew.p95AbsUs < 5000);
+}
+
+void test_sim_text_and_binary_macrocycle_agree(void) {
+    SimConfig config = realisticConfig();
+    config.sessionMs = 30000;
+
+    SimReport binary = TwoGloveSim(config).run();
+    config.binaryMacrocycle = false;
+    SimReport text = TwoGloveSim(config).run();
+
+    // Same schedule either way; only the message bytes differ
+    TEST_ASSERT_EQUAL_UINT32(binary.primaryActivations, text.primaryActivations);
+    TEST_ASSERT_TRUE(text.matched > 100);
+}
+
+void test_sim_dropped_macrocycles_are_reported(void) {
+    SimConfig config = realisticConfig();
+    config.link = {7500, 1000, 1500, 300, 1};   // 30% attempt loss, one retry
+    config.sessionMs = 60000;
+
+    TwoGloveSim sim(config);
+    SimReport report = sim.run();
+    TwoGloveSim::printReport("30% loss, 1 retry", report);
+
+    TEST_ASSERT_TRUE(report.toSecondary.dropped > 0);
+    TEST_ASSERT_TRUE(report.missedOnSecondary > 0 || config.pipelineDepth > 1);
+    // PRIMARY keeps its own timeline regardless of SECONDARY delivery
+    TEST_ASSERT_TRUE(report.primaryActivations > 150);
+}
+
+// =============================================================================
+// EXECUTION FEEDBACK TESTS
+// =============================================================================
+
+void test_sim_feedback_skew_matches_true_skew_with_exact_offset(void) {
+    // Exact PTP offset: what PRIMARY measures from MC_ACK is the true skew
+    SimConfig config;
+    config.primaryClock = {3000000, 0.0f};
+    config.secondaryClock = {0, 0.0f};
+    config.link = {0, 4000, 0, 0, 6};
+    config.secondaryProcessingUs = 0;
+    config.execLatencyUs = 300;
+    config.sessionMs = 30000;
+
+    SimReport report = TwoGloveSim(config).run();
+    TwoGloveSim::printReport("feedback, exact offset", report);
+
+    // Feedback trails by one macrocycle; the tail of the run is never reported
+    TEST_ASSERT_TRUE(report.measuredSkew.count * 10 >= report.matched * 8);
+    TEST_ASSERT_TRUE(report.measuredSkew.count <= report.primaryActivations);
+    TEST_ASSERT_INT64_WITHIN(5, report.skew.minUs, report.measuredSkew.minUs);
+    TEST_ASSERT_INT64_WITHIN(5, report.skew.maxUs, report.measuredSkew.maxUs);
+    TEST_ASSERT_INT64_WITHIN(10, report.skew.p99AbsUs, report.measuredSkew.p99AbsUs);
+}
+
+void test_sim_feedback_skew_within_offset_error(void) {
+    // SECONDARY schedules and converts back with the same offset, so its error
+    // cancels out: measured and true skew differ by at most that error
+    SimConfig config = realisticConfig();
+    config.sessionMs = 60000;
+
+    SimReport report = TwoGloveSim(config).run();
+    TwoGloveSim::printReport("feedback, 20ppm, 7.5ms CI", report);
+    SkewStats offset = TwoGloveSim::summarizeSkew(report.offsetErrorUs);
+
+    TEST_ASSERT_TRUE(report.measuredSkew.count * 10 >= report.matched * 8);
+    TEST_ASSERT_TRUE(report.measuredSkew.meanUs - report.skew.meanUs <= (double)offset.maxAbsUs + 5.0);
+    TEST_ASSERT_TRUE(report.skew.meanUs - report.measuredSkew.meanUs <= (double)offset.maxAbsUs + 5.0);
+    TEST_ASSERT_TRUE(report.measuredSkew.maxAbsUs <= report.skew.maxAbsUs + offset.maxAbsUs + 5);
+}
+
+void test_sim_seeded_beacons_cut_macrocycle_airtime(void) {
+    SimConfig config = realisticConfig();
+    config.sessionMs = 30000;
+
+    TwoGloveSim binarySim(config);
+    SimReport binary = binarySim.run();
+    config.seededMacrocycles = true;
+    TwoGloveSim seededSim(config);
+    SimReport seeded = seededSim.run();
+    TwoGloveSim::printReport("binary MACROCYCLE", binary);
+    TwoGloveSim::printReport("seeded beacons", seeded);
+    printf("[SIM] MACROCYCLE bytes: binary=%lu seeded=%lu (%.0f%% less) | all P->S bytes: binary=%lu seeded=%lu\n",
+           (unsigned long)binary.macrocycleBytes, (unsigned long)seeded.macrocycleBytes,
+           100.0 * (1.0 - (double)seeded.macrocycleBytes / (double)binary.macrocycleBytes),
+           (unsigned long)binary.toSecondary.bytes, (unsigned long)seeded.toSecondary.bytes);
+
+    TEST_ASSERT_TRUE(seededSim.getTherapy().isSeeded());
+    // A beacon is fixed-size; the one-off SS: costs about two macrocycles
+    TEST_ASSERT_TRUE(seeded.macrocycleBytes * 3 < binary.macrocycleBytes * 2);
+    TEST_ASSERT_TRUE(seeded.toSecondary.bytes < binary.toSecondary.bytes);
+    // SECONDARY regenerated every event PRIMARY scheduled
+    TEST_ASSERT_TRUE(seeded.matched > 100);
+    TEST_ASSERT_TRUE(seeded.missedOnSecondary <= binary.missedOnSecondary);
+    TEST_ASSERT_TRUE(seeded.skew.p95AbsUs < 5000);
+}
+
+void test_sim_seeded_secondary_coasts_through_link_outage(void) {
+    SimConfig config = realisticConfig();
+    config.sessionMs = 60000;
+    config.outageAtMs = 30000;   // 4s fade mid-session: longer than one macrocycle slot
+    config.outageMs = 4000;
+    config.seededMacrocycles = true;
+    if (config.pipelineDepth < 2) {
+        TEST_IGNORE_MESSAGE("Coasting needs -DMACROCYCLE_PIPELINE_DEPTH=2 or more");
+    }
+
+    SimReport seeded = TwoGloveSim(config).run();
+    config.seededMacrocycles = false;
+    SimReport binary = TwoGloveSim(config).run();
+    TwoGloveSim::printReport("seeded, 4s outage", seeded);
+    TwoGloveSim::printReport("binary, 4s outage", binary);
+
+    TEST_ASSERT_TRUE(seeded.coasted > 0);
+    TEST_ASSERT_TRUE(seeded.missedOnSecondary < binary.missedOnSecondary);
+}
+
+// =============================================================================
+// TEST RUNNER
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // SimClock Tests
+    RUN_TEST(test_SimClock_applies_offset_and_drift);
+    RUN_TEST(test_SimClock_trueAt_inverts_localAt);
+
+    // SimLink Tests
+    RUN_TEST(test_SimLink_quantizes_to_connection_events);
+    RUN_TEST(test_SimLink_preserves_order_under_jitter);
+    RUN_TEST(test_SimLink_retransmits_then_drops);
+
+    // End-to-End Simulation Tests
+    RUN_TEST(test_sim_ideal_link_near_zero_skew);
+    RUN_TEST(test_sim_is_deterministic);
+    RUN_TEST(test_sim_realistic_drift_and_jitter);
+    RUN_TEST(test_sim_text_and_binary_macrocycle_agree);
+    RUN_TEST(test_sim_dropped_macrocycles_are_reported);
+
+    // Execution Feedback Tests
+    RUN_TEST(test_sim_feedback_skew_matches_true_skew_with_exact_offset);
+    RUN_TEST(test_sim_feedback_skew_within_offset_error);
+
+    // Seeded Macrocycle Tests
+    RUN_TEST(test_sim_seeded_beacons_cut_macrocycle_airtime);
+    RUN_TEST(test_sim_seeded_secondary_coasts_through_link_outage);
+
+    return UNITY_END();
+}
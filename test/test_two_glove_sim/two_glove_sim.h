@@ -0,0 +1,1018 @@
+/**
+ * @file two_glove_sim.h
+ * @brief Deterministic host-side PRIMARY + SECONDARY simulator for sync benchmarking
+ *
+ * Runs both gloves in one process on a shared "true" timeline:
+ * - SimClock: per-glove free-running clock (boot offset + ppm drift). Before a
+ *   glove's code runs, the Arduino mock clock is switched to that glove's
+ *   local time, so getMicros()/millis() see what the real board would see.
+ * - SimLink: one direction of the BLE link. Messages leave on the next
+ *   connection event, each failed attempt costs one more connection interval
+ *   (link-layer retransmission), and after maxRetransmits the message is
+ *   dropped. Delivery order is preserved. An optional outage window drops
+ *   everything sent inside it (supervision-timeout-length fade).
+ * - SimGlove: the firmware state a glove owns - SimpleSyncProtocol, the motor
+ *   event heap behind ActivationQueue, the MotorEventBuffer staging ring and
+ *   the MACROCYCLE receive window. runMotorTask() is a cooperative stand-in
+ *   for the FreeRTOS motor task (the rtos.h mocks are single-threaded).
+ * - TwoGloveSim: event-driven loop that mirrors the main.cpp PING/PONG,
+ *   MACROCYCLE and MC_ACK handlers around the real TherapyEngine, then pairs
+ *   PRIMARY and SECONDARY activations by (macrocycle sequence, event index)
+ *   and reports the bilateral skew distribution - alongside the skew PRIMARY
+ *   itself measures from MC_ACK execution feedback (ActivationLog), which
+ *   only knows the estimated clock offset. With seededMacrocycles the
+ *   SECONDARY runs its own TherapyEngine replica (SS:/MN: messages) and
+ *   coasts through late beacons like coastSeededTimeline().
+ *
+ * Everything random (link jitter/loss, pattern generation) is seeded from
+ * SimConfig::seed, so a run is bit-for-bit reproducible.
+ *
+ * The including test must first include the firmware sources it drives:
+ *   #include "../../src/sync_protocol.cpp"
+ *   #include "../../src/therapy_engine.cpp"
+ */
+
+#ifndef TWO_GLOVE_SIM_H
+#define TWO_GLOVE_SIM_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <deque>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include "config.h"
+#include "types.h"
+#include "sync_protocol.h"
+#include "therapy_engine.h"
+#include "motor_event_heap.h"
+#include "motor_event_buffer.h"
+#include "activation_log.h"
+
+// =============================================================================
+// DETERMINISTIC RANDOM SOURCE
+// =============================================================================
+
+/**
+ * @brief LCG shared by the link and glove models (independent of rand())
+ */
+class SimRandom {
+public:
+    explicit SimRandom(uint32_t seed = 1) : _state(seed) {}
+
+    uint32_t next() {
+        _state = _state * 1664525u + 1013904223u;
+        return _state;
+    }
+
+    /** @brief Uniform in [0, bound) (0 if bound is 0) */
+    uint32_t below(uint32_t bound) {
+        return (bound == 0) ? 0 : (next() >> 8) % bound;
+    }
+
+private:
+    uint32_t _state;
+};
+
+// =============================================================================
+// SIMULATED CLOCK
+// =============================================================================
+
+struct SimClockConfig {
+    uint64_t bootOffsetUs;  // Local clock reading at true time 0
+    float ppm;              // Crystal error: local runs fast by this much
+};
+
+/**
+ * @brief Free-running local clock: local = bootOffset + true * (1 + ppm)
+ */
+class SimClock {
+public:
+    explicit SimClock(const SimClockConfig& config) : _config(config) {}
+
+    uint64_t localAt(uint64_t trueUs) const {
+        double drift = (double)trueUs * (double)_config.ppm * 1e-6;
+        return _config.bootOffsetUs + trueUs + (uint64_t)(int64_t)llround(drift);
+    }
+
+    /**
+     * @brief Earliest true time at which the local clock reads >= localUs
+     */
+    uint64_t trueAt(uint64_t localUs) const {
+        if (localUs <= _config.bootOffsetUs) {
+            return 0;
+        }
+        double scale = 1.0 + (double)_config.ppm * 1e-6;
+        uint64_t t = (uint64_t)((double)(localUs - _config.bootOffsetUs) / scale);
+        while (localAt(t) < localUs) {
+            t++;
+        }
+        while (t > 0 && localAt(t - 1) >= localUs) {
+            t--;
+        }
+        return t;
+    }
+
+private:
+    SimClockConfig _config;
+};
+
+// =============================================================================
+// SIMULATED BLE LINK
+// =============================================================================
+
+struct SimLinkConfig {
+    uint32_t connIntervalUs;    // Connection interval (0 = no quantization)
+    uint32_t latencyUs;         // Radio + stack latency after the connection event
+    uint32_t jitterUs;          // Extra uniform latency [0, jitterUs)
+    uint16_t lossPerMille;      // Chance one connection-event attempt fails
+    uint8_t maxRetransmits;     // Failed attempts beyond this drop the message
+};
+
+struct SimLinkStats {
+    uint32_t sent;
+    uint32_t delivered;
+    uint32_t retransmits;
+    uint32_t dropped;
+    uint32_t bytes;         // Payload bytes handed to send() (airtime proxy)
+};
+
+/**
+ * @brief One direction of the BLE link (FIFO, connection-event quantized)
+ */
+class SimLink {
+public:
+    SimLink(const SimLinkConfig& config, uint32_t seed)
+        : _config(config), _random(seed), _lastDeliveryUs(0), _stats{0, 0, 0, 0, 0}
+        , _outageStartUs(0), _outageEndUs(0) {}
+
+    /** @brief Drop every message sent in [startUs, endUs) */
+    void setOutage(uint64_t startUs, uint64_t endUs) {
+        _outageStartUs = startUs;
+        _outageEndUs = endUs;
+    }
+
+    /**
+     * @brief Queue a message sent at trueUs
+     * @return false if the message was lost (retransmit budget exhausted)
+     */
+    bool send(uint64_t trueUs, const char* payload) {
+        _stats.sent++;
+        _stats.bytes += (uint32_t)strlen(payload);
+        if (trueUs >= _outageStartUs && trueUs < _outageEndUs) {
+            _stats.dropped++;
+            return false;
+        }
+        uint64_t eventUs = nextConnectionEvent(trueUs);
+        uint8_t failures = 0;
+        while (_random.below(1000) < _config.lossPerMille) {
+            if (failures >= _config.maxRetransmits) {
+                _stats.dropped++;
+                return false;
+            }
+            failures++;
+            _stats.retransmits++;
+            eventUs += (_config.connIntervalUs > 0) ? _config.connIntervalUs : 1000;
+        }
+
+        uint64_t deliverUs = eventUs + _config.latencyUs + _random.below(_config.jitterUs);
+        deliverUs = std::max(deliverUs, _lastDeliveryUs);  // BLE preserves order
+        _lastDeliveryUs = deliverUs;
+        _inFlight.push_back({deliverUs, std::string(payload)});
+        return true;
+    }
+
+    /**
+     * @brief Pop the next message due at or before trueUs
+     */
+    bool receive(uint64_t trueUs, std::string& payload) {
+        if (_inFlight.empty() || _inFlight.front().deliverUs > trueUs) {
+            return false;
+        }
+        payload = _inFlight.front().payload;
+        _inFlight.pop_front();
+        _stats.delivered++;
+        return true;
+    }
+
+    /** @brief True time of the next delivery (UINT64_MAX if idle) */
+    uint64_t nextDeliveryUs() const {
+        return _inFlight.empty() ? UINT64_MAX : _inFlight.front().deliverUs;
+    }
+
+    const SimLinkStats& getStats() const { return _stats; }
+
+private:
+    struct Packet {
+        uint64_t deliverUs;
+        std::string payload;
+    };
+
+    SimLinkConfig _config;
+    SimRandom _random;
+    uint64_t _lastDeliveryUs;
+    SimLinkStats _stats;
+    uint64_t _outageStartUs;
+    uint64_t _outageEndUs;
+    std::deque<Packet> _inFlight;
+
+    uint64_t nextConnectionEvent(uint64_t trueUs) const {
+        if (_config.connIntervalUs == 0) {
+            return trueUs;
+        }
+        uint64_t ci = _config.connIntervalUs;
+        return ((trueUs + ci - 1) / ci) * ci;
+    }
+};
+
+// =============================================================================
+// SIMULATED GLOVE
+// =============================================================================
+
+/**
+ * @brief One motor activation as it happened
+ */
+struct SimActivation {
+    uint64_t eventKey;  // Pairing key: macrocycle sequence << 8 | event index
+    uint64_t trueUs;    // When the motor actually started (true time)
+    uint8_t finger;
+};
+
+/**
+ * @brief Firmware state owned by one glove
+ */
+class SimGlove {
+public:
+    SimGlove(const SimClockConfig& clockConfig, uint32_t seed)
+        : clock(clockConfig), _random(seed) {}
+
+    SimClock clock;
+    SimpleSyncProtocol sync;
+    MotorEventHeap queue;               // What ActivationQueue wraps
+    MotorEventBuffer staging;           // SECONDARY: BLE callback -> motor task
+    MacrocycleReceiveWindow rxWindow;   // SECONDARY: duplicate suppression
+    ActivationLog activationLog;        // Per-event start times for MC_ACK feedback
+    std::vector<SimActivation> activations;
+
+    /**
+     * @brief Point the Arduino mock clock at this glove's local time
+     *
+     * Overflow tracking is reset because the two local clocks differ;
+     * simulated runs stay well below the 71-minute micros() wrap.
+     */
+    void enter(uint64_t trueUs) {
+        mockSetMicros((uint32_t)clock.localAt(trueUs));
+        resetMicrosOverflow();
+    }
+
+    /**
+     * @brief Same activation/deactivation pairing as ActivationQueue::enqueue()
+     * @param eventKey Pairing key recorded when this activation fires
+     */
+    bool enqueue(uint64_t activateTimeUs, uint64_t eventKey, uint8_t finger,
+                 uint8_t amplitude, uint16_t durationMs, uint16_t frequencyHz) {
+        if (queue.available() < 2) {
+            _queueFull++;
+            return false;
+        }
+        MotorEvent on;
+        on.timeUs = activateTimeUs;
+        on.finger = finger;
+        on.amplitude = amplitude;
+        on.frequencyHz = frequencyHz;
+        on.type = MotorEventType::ACTIVATE;
+        on.active = true;
+
+        MotorEvent off;
+        off.timeUs = activateTimeUs + (uint64_t)durationMs * 1000ULL;
+        off.finger = finger;
+        off.amplitude = 0;
+        off.frequencyHz = 0;
+        off.type = MotorEventType::DEACTIVATE;
+        off.active = true;
+
+        queue.push(on);
+        queue.push(off);
+        _keys[activateTimeUs] = eventKey;
+        return true;
+    }
+
+    void clearQueue() {
+        queue.clear();
+        _keys.clear();
+    }
+
+    /**
+     * @brief One motor-task wakeup at trueUs (glove must be entered)
+     *
+     * Drains the staging ring (a batch tagged first clears the queue, as
+     * drainStagedMotorEvents() does), then executes every due event with the
+     * same coalescing window as dispatchDueEvents(). The real task spin-waits
+     * onto the deadline, so an event starts when it is due; execLatencyUs
+     * adds uniform I2C/dispatch latency on top.
+     */
+    void runMotorTask(uint64_t trueUs, uint32_t execLatencyUs) {
+        StagedMotorEvent staged;
+        while (staging.unstage(staged)) {
+            if (staged.isMacrocycleFirst) {
+                clearQueue();
+            }
+            uint64_t key = _stagedKeys.empty() ? 0 : _stagedKeys.front();
+            if (!_stagedKeys.empty()) {
+                _stagedKeys.pop_front();
+            }
+            enqueue(staged.activateTimeUs, key, staged.finger, staged.amplitude,
+                    staged.durationMs, staged.frequencyHz);
+        }
+
+        uint64_t nowLocal = clock.localAt(trueUs);
+        const MotorEvent* next = queue.peek();
+        while (next != nullptr && next->timeUs <= nowLocal) {
+            MotorEvent due[MOTOR_COALESCE_MAX_EVENTS];
+            uint8_t count = queue.popWithin(due, MOTOR_COALESCE_MAX_EVENTS, MOTOR_COALESCE_WINDOW_US);
+            uint64_t startUs = trueUs + _random.below(execLatencyUs);
+            for (uint8_t i = 0; i < count; i++) {
+                if (due[i].type != MotorEventType::ACTIVATE) {
+                    continue;
+                }
+                activationLog.recordActivation(due[i].timeUs, clock.localAt(startUs));
+                auto it = _keys.find(due[i].timeUs);
+                if (it == _keys.end()) {
+                    continue;
+                }
+                activations.push_back({it->second, startUs, due[i].finger});
+                _keys.erase(it);
+            }
+            next = queue.peek();
+        }
+    }
+
+    /**
+     * @brief Stage a MACROCYCLE event (SECONDARY BLE callback side)
+     */
+    bool stage(uint64_t localActivateTimeUs, uint64_t eventKey, uint8_t finger, uint8_t amplitude,
+               uint16_t durationMs, uint16_t frequencyHz, bool isLast) {
+        if (!staging.stage(localActivateTimeUs, finger, amplitude, durationMs, frequencyHz, isLast)) {
+            return false;
+        }
+        _stagedKeys.push_back(eventKey);
+        return true;
+    }
+
+    /** @brief True time of the next queued motor event (UINT64_MAX if none) */
+    uint64_t nextMotorEventUs() const {
+        const MotorEvent* next = queue.peek();
+        return (next == nullptr) ? UINT64_MAX : clock.trueAt(next->timeUs);
+    }
+
+    uint32_t getQueueFullCount() const { return _queueFull; }
+
+private:
+    SimRandom _random;
+    std::map<uint64_t, uint64_t> _keys;      // Local activate time -> pairing key
+    std::deque<uint64_t> _stagedKeys;        // Keys riding alongside the staging ring
+    uint32_t _queueFull = 0;
+};
+
+// =============================================================================
+// SIMULATION CONFIG AND REPORT
+// =============================================================================
+
+struct SimConfig {
+    SimClockConfig primaryClock = {0, 0.0f};
+    SimClockConfig secondaryClock = {0, 0.0f};
+    SimLinkConfig link = {7500, 1000, 0, 0, 6};
+    uint32_t seed = 1;
+    uint32_t warmupMs = 8000;             // PING/PONG only, before therapy starts
+    uint32_t sessionMs = 60000;           // Therapy duration measured
+    uint32_t outageAtMs = 0;              // Both links drop everything from here...
+    uint32_t outageMs = 0;                // ...for this long (0 = no outage)
+    uint32_t loopPeriodUs = 1000;         // PRIMARY loop() cadence
+    uint32_t pingIntervalMs = 1000;       // Keepalive / clock sync PING
+    uint32_t secondaryProcessingUs = 300; // PING -> PONG / MACROCYCLE -> ACK turnaround
+    uint32_t execLatencyUs = 0;           // Uniform motor start latency on both gloves
+    uint8_t pipelineDepth = MACROCYCLE_PIPELINE_DEPTH;
+    bool binaryMacrocycle = true;         // SECONDARY negotiated MB: format
+    bool seededMacrocycles = false;       // SECONDARY negotiated SG (SS:/MN: beacons)
+    float timeOnMs = 100.0f;
+    float timeOffMs = 67.0f;
+    float jitterPercent = 23.5f;
+};
+
+struct SkewStats {
+    uint32_t count;
+    double meanUs;
+    int64_t minUs;
+    int64_t maxUs;
+    int64_t p50AbsUs;
+    int64_t p95AbsUs;
+    int64_t p99AbsUs;
+    int64_t maxAbsUs;
+};
+
+struct SimReport {
+    uint32_t primaryActivations;
+    uint32_t secondaryActivations;
+    uint32_t matched;
+    uint32_t missedOnSecondary;          // PRIMARY fired, SECONDARY never did
+    std::vector<int64_t> skewUs;         // SECONDARY start - PRIMARY start (true time)
+    SkewStats skew;
+    std::vector<int64_t> measuredSkewUs; // Same, as PRIMARY measured it from MC_ACK feedback
+    SkewStats measuredSkew;
+    std::vector<int64_t> offsetErrorUs;  // Sent clockOffset - true offset, per MACROCYCLE
+    SimLinkStats toSecondary;
+    SimLinkStats toPrimary;
+    uint32_t macrocyclesStaged;
+    uint32_t lateEvents;                 // SECONDARY events already due when received
+    uint32_t coasted;                    // Seeded macrocycles SECONDARY generated without a beacon
+    uint32_t macrocycleBytes;            // P->S bytes of MACROCYCLE/SS:/MN: messages (first sends)
+    MacrocyclePipelineStats pipeline;
+};
+
+// =============================================================================
+// TWO-GLOVE SIMULATOR
+// =============================================================================
+
+class TwoGloveSim;
+static TwoGloveSim* g_activeSim = nullptr;  // TherapyEngine callbacks are plain function pointers
+
+class TwoGloveSim {
+public:
+    explicit TwoGloveSim(const SimConfig& config)
+        : _config(config)
+        , _primary(config.primaryClock, config.seed * 3u + 1u)
+        , _secondary(config.secondaryClock, config.seed * 3u + 2u)
+        , _toSecondary(config.link, config.seed * 7u + 11u)
+        , _toPrimary(config.link, config.seed * 7u + 13u)
+        , _nowUs(0)
+        , _pingT1(0)
+        , _macrocyclesStaged(0)
+        , _lateEvents(0)
+        , _sessionSentSeed(0)
+        , _sessionFirstSeq(0)
+        , _sessionAcked(false)
+        , _timeline{}
+        , _coasted(0)
+        , _macrocycleBytes(0)
+        , _feedbackPending(false) {}
+
+    /**
+     * @brief Run warm-up + session and return the report
+     */
+    SimReport run() {
+        g_activeSim = this;
+        _therapy.seedRandom(_config.seed);   // TherapyEngine pattern generation
+        mockResetTime();
+        resetMicrosOverflow();
+
+        _therapy.setSendMacrocycleCallback(onSendMacrocycle);
+        _therapy.setSchedulingCallbacks(onScheduleActivation, onStartScheduling, onIsSchedulingComplete);
+        _therapy.setGetLeadTimeCallback(onGetLeadTime);
+        _therapy.setPipelineDepth(_config.pipelineDepth);
+        _therapy.setSeededGeneration(_config.seededMacrocycles);
+        uint64_t outageStartUs = (uint64_t)_config.outageAtMs * 1000ULL;
+        uint64_t outageEndUs = outageStartUs + (uint64_t)_config.outageMs * 1000ULL;
+        _toSecondary.setOutage(outageStartUs, outageEndUs);
+        _toPrimary.setOutage(outageStartUs, outageEndUs);
+
+        uint64_t therapyStartUs = (uint64_t)_config.warmupMs * 1000ULL;
+        uint64_t endUs = therapyStartUs + (uint64_t)_config.sessionMs * 1000ULL;
+        uint64_t nextLoopUs = 0;
+        uint64_t nextPingUs = 0;
+        bool therapyStarted = false;
+
+        while (_nowUs < endUs) {
+            deliverMessages();
+
+            _secondary.enter(_nowUs);
+            coastSeededTimeline();
+            _secondary.runMotorTask(_nowUs, _config.execLatencyUs);
+            _primary.enter(_nowUs);
+            _primary.runMotorTask(_nowUs, _config.execLatencyUs);
+
+            if (_nowUs >= nextLoopUs) {
+                _primary.enter(_nowUs);
+                if (_nowUs >= nextPingUs) {
+                    sendPing();
+                    nextPingUs += (uint64_t)_config.pingIntervalMs * 1000ULL;
+                }
+                if (!therapyStarted && _nowUs >= therapyStartUs) {
+                    _therapy.startSession(_config.sessionMs / 1000 + 60, PatternType::RNDP,
+                                          _config.timeOnMs, _config.timeOffMs, _config.jitterPercent);
+                    therapyStarted = true;
+                }
+                if (therapyStarted) {
+                    _therapy.update();
+                }
+                processSecondaryFeedback();
+                // Motor task is notified by enqueue; pick up same-instant events
+                _primary.runMotorTask(_nowUs, _config.execLatencyUs);
+                nextLoopUs += _config.loopPeriodUs;
+            }
+
+            uint64_t next = nextLoopUs;
+            next = std::min(next, _toSecondary.nextDeliveryUs());
+            next = std::min(next, _toPrimary.nextDeliveryUs());
+            next = std::min(next, _primary.nextMotorEventUs());
+            next = std::min(next, _secondary.nextMotorEventUs());
+            next = std::min(next, nextCoastUs());
+            _nowUs = std::max(next, _nowUs + 1);
+        }
+
+        SimReport report = buildReport(therapyStartUs, endUs);
+        g_activeSim = nullptr;
+        return report;
+    }
+
+    const TherapyEngine& getTherapy() const { return _therapy; }
+    const SimGlove& getPrimary() const { return _primary; }
+    const SimGlove& getSecondary() const { return _secondary; }
+
+private:
+    SimConfig _config;
+    SimGlove _primary;
+    SimGlove _secondary;
+    SimLink _toSecondary;
+    SimLink _toPrimary;
+    TherapyEngine _therapy;
+    uint64_t _nowUs;
+    uint64_t _pingT1;
+    uint32_t _macrocyclesStaged;
+    uint32_t _lateEvents;
+    std::vector<int64_t> _offsetErrors;
+    std::map<uint64_t, uint64_t> _primaryKeys;  // PRIMARY activate time -> pairing key
+
+    // Seeded macrocycles (same roles as main.cpp's globals)
+    struct SeededTimeline {
+        bool loaded;
+        bool active;
+        uint16_t tag;
+        uint8_t coastBudget;
+        uint8_t coasted;
+        uint32_t lastBeaconSeq;
+        uint32_t lastSeq;
+        uint64_t nextPrimaryBase;
+        int64_t clockOffset;
+    };
+    TherapyEngine _replica;        // SECONDARY's engine, fed by SS:
+    uint64_t _sessionSentSeed;     // PRIMARY: seed of the last SS: sent
+    uint32_t _sessionFirstSeq;     // PRIMARY: first beacon of that session
+    bool _sessionAcked;            // PRIMARY: SECONDARY ACKed one of its beacons
+    SeededTimeline _timeline;      // SECONDARY
+    uint32_t _coasted;
+    uint32_t _macrocycleBytes;
+
+    // Execution feedback (PRIMARY: BLE callback -> loop() mailbox)
+    MacrocycleFeedback _feedback;
+    bool _feedbackPending;
+    std::vector<int64_t> _measuredSkew;
+
+    static uint64_t eventKey(uint32_t sequenceId, uint8_t index) {
+        return ((uint64_t)sequenceId << 8) | index;
+    }
+
+    int64_t trueOffsetAt(uint64_t trueUs) const {
+        return (int64_t)_secondary.clock.localAt(trueUs) - (int64_t)_primary.clock.localAt(trueUs);
+    }
+
+    // -------------------------------------------------------------------------
+    // Message delivery (BLE callback context on the receiving glove)
+    // -------------------------------------------------------------------------
+
+    void deliverMessages() {
+        std::string payload;
+        while (_toSecondary.receive(_nowUs, payload)) {
+            _secondary.enter(_nowUs);
+            onSecondaryMessage(payload.c_str());
+        }
+        while (_toPrimary.receive(_nowUs, payload)) {
+            _primary.enter(_nowUs);
+            onPrimaryMessage(payload.c_str());
+        }
+    }
+
+    void sendPing() {
+        _pingT1 = getMicros();
+        SyncCommand cmd = SyncCommand::createPingWithT1(g_sequenceGenerator.next(), _pingT1);
+        char buffer[64];
+        if (cmd.serialize(buffer, sizeof(buffer))) {
+            _toSecondary.send(_nowUs, buffer);
+        }
+    }
+
+    void replyToPrimary(const char* message) {
+        _toPrimary.send(_nowUs + _config.secondaryProcessingUs, message);
+    }
+
+    /**
+     * @brief main.cpp sendMacrocycleAck(): feedback converted with the ACKed clockOffset
+     */
+    void sendMacrocycleAck(uint32_t sequenceId, int64_t localMinusPrimaryUs) {
+        _secondary.activationLog.drain(localMinusPrimaryUs);
+        MacrocycleFeedback feedback;
+        bool hasFeedback = _secondary.activationLog.takeFeedback(getMicros(), feedback);
+        char buffer[MACROCYCLE_ACK_BUFFER_SIZE];
+        if (SyncCommand::serializeMacrocycleAck(buffer, sizeof(buffer), sequenceId,
+                                                hasFeedback ? &feedback : nullptr)) {
+            replyToPrimary(buffer);
+        }
+    }
+
+    /**
+     * @brief SECONDARY side of onBLEMessage() (PING and MACROCYCLE)
+     */
+    void onSecondaryMessage(const char* message) {
+        uint64_t rxTimestamp = getMicros();
+
+        if (strncmp(message, SEEDED_SESSION_PREFIX, SEEDED_PREFIX_LEN) == 0) {
+            SeededSession session;
+            if (SyncCommand::deserializeSeededSession(message, session)) {
+                _replica.loadSeededSession(session);
+                _timeline = SeededTimeline();
+                _timeline.loaded = true;
+                _timeline.tag = session.tag();
+                _timeline.coastBudget = session.coastBudget;
+            }
+            return;
+        }
+
+        bool isBinary = (strncmp(message, MACROCYCLE_BINARY_PREFIX, MACROCYCLE_BINARY_PREFIX_LEN) == 0);
+        bool isBeacon = (strncmp(message, MACROCYCLE_BEACON_PREFIX, SEEDED_PREFIX_LEN) == 0);
+        bool isText = (strncmp(message, MACROCYCLE_TEXT_V5_PREFIX, MACROCYCLE_TEXT_PREFIX_LEN) == 0 ||
+                       strncmp(message, MACROCYCLE_TEXT_V4_PREFIX, MACROCYCLE_TEXT_PREFIX_LEN) == 0);
+        if (isBinary || isBeacon || isText) {
+            Macrocycle mc;
+            size_t len = strlen(message);
+            bool parsed;
+            if (isBeacon) {
+                uint16_t tag = 0;
+                parsed = SyncCommand::deserializeMacrocycleBeacon(message, mc, tag);
+                if (!parsed || !_timeline.loaded || tag != _timeline.tag) {
+                    return;
+                }
+                uint64_t baseTime = mc.baseTime;
+                int64_t clockOffset = mc.clockOffset;
+                _replica.generateSeededMacrocycle(mc, mc.sequenceId);
+                mc.baseTime = baseTime;
+                mc.clockOffset = clockOffset;
+            } else {
+                parsed = isBinary ? SyncCommand::deserializeMacrocycleBinary(message, len, mc)
+                                  : SyncCommand::deserializeMacrocycle(message, len, mc);
+            }
+            if (!parsed) {
+                return;
+            }
+
+            MacrocycleReceiveWindow::Result seqCheck = _secondary.rxWindow.classify(mc.sequenceId);
+            bool coasted = isBeacon && noteBeacon(mc);
+            if (coasted) {
+                _secondary.rxWindow.markStaged(mc.sequenceId);
+            }
+            if (seqCheck == MacrocycleReceiveWindow::DUPLICATE || coasted) {
+                sendMacrocycleAck(mc.sequenceId, mc.clockOffset);
+                return;
+            }
+            if (seqCheck == MacrocycleReceiveWindow::NEW_TIMELINE) {
+                _secondary.staging.beginMacrocycle();
+            }
+
+            uint64_t localBaseTime = (uint64_t)((int64_t)mc.baseTime + mc.clockOffset);
+            uint8_t lastValid = 0;
+            for (uint8_t i = 0; i < mc.eventCount; i++) {
+                if (mc.events[i].amplitude > 0 && mc.events[i].finger < MAX_ACTUATORS) {
+                    lastValid = i;
+                }
+            }
+            for (uint8_t i = 0; i < mc.eventCount; i++) {
+                const MacrocycleEvent& evt = mc.events[i];
+                if (evt.amplitude == 0 || evt.finger >= MAX_ACTUATORS) {
+                    continue;
+                }
+                uint64_t delta = evt.deltaTimeUs;
+                if (localBaseTime + delta < rxTimestamp) {
+                    _lateEvents++;
+                }
+                _secondary.stage(localBaseTime + delta, eventKey(mc.sequenceId, i), evt.finger, evt.amplitude,
+                                 evt.durationMs, evt.getFrequencyHz(), i == lastValid);
+            }
+            _secondary.rxWindow.markStaged(mc.sequenceId);
+            _secondary.activationLog.track(mc, localBaseTime);
+            _macrocyclesStaged++;
+            sendMacrocycleAck(mc.sequenceId, mc.clockOffset);
+            return;
+        }
+
+        SyncCommandView cmd;
+        if (cmd.parse(message) && cmd.getType() == SyncCommandType::PING) {
+            uint64_t t2 = rxTimestamp;
+            char buffer[64];
+            uint16_t stampOffset;
+            if (SyncCommand::serializePongForTxStamp(buffer, sizeof(buffer), cmd.getSequenceId(), t2, stampOffset)) {
+                // BLEManager stamps T3 as the PONG is written (replyToPrimary's send time)
+                uint64_t t3 = _secondary.clock.localAt(_nowUs + _config.secondaryProcessingUs);
+                SyncCommand::stampTxTime(buffer, stampOffset, t3);
+                replyToPrimary(buffer);
+            }
+        }
+    }
+
+    /**
+     * @brief Beacon bookkeeping from the main.cpp MACROCYCLE handler
+     * @return true if loop() already coasted through this sequence ID
+     */
+    bool noteBeacon(const Macrocycle& mc) {
+        SeededTimeline& t = _timeline;
+        bool coasted = t.active && (int32_t)(mc.sequenceId - t.lastBeaconSeq) > 0 &&
+                       (int32_t)(mc.sequenceId - t.lastSeq) <= 0;
+        if (!t.active || (int32_t)(mc.sequenceId - t.lastSeq) >= 0) {
+            t.lastSeq = mc.sequenceId;
+            t.nextPrimaryBase = mc.baseTime + _replica.getMacrocycleSlotUs(mc);
+            t.clockOffset = mc.clockOffset;
+        }
+        if (!t.active || (int32_t)(mc.sequenceId - t.lastBeaconSeq) > 0) {
+            t.lastBeaconSeq = mc.sequenceId;
+        }
+        t.active = true;
+        t.coasted = 0;
+        return coasted;
+    }
+
+    /** @brief True time at which coastSeededTimeline() would next act */
+    uint64_t nextCoastUs() const {
+        const SeededTimeline& t = _timeline;
+        if (!t.active || t.coasted >= t.coastBudget) {
+            return UINT64_MAX;
+        }
+        int64_t dueLocal = (int64_t)t.nextPrimaryBase + t.clockOffset - SEEDED_MACROCYCLE_COAST_LEAD_MS * 1000LL;
+        return _secondary.clock.trueAt((uint64_t)std::max<int64_t>(dueLocal, 0));
+    }
+
+    /**
+     * @brief SECONDARY loop() side: coastSeededTimeline() (glove must be entered)
+     */
+    void coastSeededTimeline() {
+        SeededTimeline& t = _timeline;
+        if (!t.active || t.coasted >= t.coastBudget) {
+            return;
+        }
+        int64_t startLocal = (int64_t)t.nextPrimaryBase + t.clockOffset;
+        if ((int64_t)getMicros() + SEEDED_MACROCYCLE_COAST_LEAD_MS * 1000LL < startLocal) {
+            return;
+        }
+
+        uint32_t seq = t.lastSeq + 1;
+        Macrocycle mc;
+        _replica.generateSeededMacrocycle(mc, seq);
+        mc.baseTime = t.nextPrimaryBase;
+        t.lastSeq = seq;
+        t.coasted++;
+        t.nextPrimaryBase = mc.baseTime + _replica.getMacrocycleSlotUs(mc);
+        _coasted++;
+
+        for (uint8_t i = 0; i < mc.eventCount; i++) {
+            const MacrocycleEvent& evt = mc.events[i];
+            if (evt.amplitude == 0 || evt.finger >= MAX_ACTUATORS) {
+                continue;
+            }
+            _secondary.enqueue((uint64_t)startLocal + evt.deltaTimeUs, eventKey(seq, i),
+                               evt.finger, evt.amplitude, evt.durationMs, evt.getFrequencyHz());
+        }
+    }
+
+    /**
+     * @brief PRIMARY side of onBLEMessage() (PONG and MC_ACK)
+     */
+    void onPrimaryMessage(const char* message) {
+        uint64_t rxTimestamp = getMicros();
+
+        if (strncmp(message, "MC_ACK:", 7) == 0) {
+            uint32_t seqId = (uint32_t)strtoul(message + 7, nullptr, 10);
+            _therapy.onMacrocycleAck(seqId);
+            if (!_sessionAcked && (int32_t)(seqId - _sessionFirstSeq) >= 0) {
+                _sessionAcked = true;
+            }
+            MacrocycleFeedback feedback;
+            if (SyncCommand::deserializeMacrocycleAckFeedback(message, feedback)) {
+                _feedback = feedback;
+                _feedbackPending = true;
+            }
+            return;
+        }
+
+        SyncCommandView cmd;
+        if (!cmd.parse(message) || cmd.getType() != SyncCommandType::PONG || _pingT1 == 0) {
+            return;
+        }
+        uint64_t t2, t3;
+        if (cmd.hasData(2)) {
+            t2 = ((uint64_t)cmd.getDataUnsigned(0, 0) << 32) | cmd.getDataUnsigned(1, 0);
+            t3 = ((uint64_t)cmd.getDataUnsigned(2, 0) << 32) | cmd.getDataUnsigned(3, 0);
+        } else {
+            t2 = cmd.getDataUnsigned(0, 0);
+            t3 = cmd.getDataUnsigned(1, 0);
+        }
+        uint64_t t1 = _pingT1;
+        uint64_t t4 = rxTimestamp;
+        _primary.sync.addPTPSample(t1, t2, t3, t4);
+        _primary.sync.updateLatency((uint32_t)((t4 - t1) - (t3 - t2)));
+        _pingT1 = 0;
+    }
+
+    /**
+     * @brief PRIMARY loop() side: processSecondaryFeedback() (glove must be entered)
+     */
+    void processSecondaryFeedback() {
+        _primary.activationLog.drain(0);
+        if (!_feedbackPending) {
+            return;
+        }
+        _feedbackPending = false;
+        int32_t skewUs[MACROCYCLE_MAX_EVENTS];
+        uint8_t count = _primary.activationLog.computeSkew(_feedback, skewUs);
+        for (uint8_t i = 0; i < count; i++) {
+            _measuredSkew.push_back(skewUs[i]);
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // TherapyEngine callbacks (PRIMARY, main loop context)
+    // -------------------------------------------------------------------------
+
+    static void onSendMacrocycle(const Macrocycle& macrocycle) {
+        TwoGloveSim& sim = *g_activeSim;
+        if (sim._therapy.getInFlightCount() == 0) {
+            sim._primary.clearQueue();
+        }
+        for (uint8_t i = 0; i < macrocycle.eventCount; i++) {
+            uint64_t activateTime = macrocycle.baseTime + macrocycle.events[i].deltaTimeUs;
+            sim._primaryKeys[activateTime] = eventKey(macrocycle.sequenceId, i);
+        }
+        sim._primary.activationLog.track(macrocycle, macrocycle.baseTime);
+
+        Macrocycle mcCopy = macrocycle;
+        mcCopy.clockOffset = sim._primary.sync.getCorrectedOffset();
+        sim._offsetErrors.push_back(mcCopy.clockOffset - sim.trueOffsetAt(sim._nowUs));
+
+        char buffer[MESSAGE_BUFFER_SIZE];
+        bool serialized;
+        if (sim._config.seededMacrocycles && sim._therapy.isSeeded()) {
+            SeededSession session = sim._therapy.getSeededSession();
+            if (sim._sessionSentSeed != session.seed) {
+                sim._sessionSentSeed = session.seed;
+                sim._sessionFirstSeq = mcCopy.sequenceId;
+                sim._sessionAcked = false;
+            }
+            char sessionBuffer[160];
+            if (!sim._sessionAcked &&
+                SyncCommand::serializeSeededSession(sessionBuffer, sizeof(sessionBuffer), session)) {
+                sim._toSecondary.send(sim._nowUs, sessionBuffer);
+                sim._macrocycleBytes += (uint32_t)strlen(sessionBuffer);
+            }
+            serialized = SyncCommand::serializeMacrocycleBeacon(buffer, sizeof(buffer), mcCopy, session.tag());
+        } else {
+            serialized = sim._config.binaryMacrocycle
+                             ? SyncCommand::serializeMacrocycleBinary(buffer, sizeof(buffer), mcCopy)
+                             : SyncCommand::serializeMacrocycle(buffer, sizeof(buffer), mcCopy);
+        }
+        if (serialized) {
+            sim._macrocycleBytes += (uint32_t)strlen(buffer);
+            sim._toSecondary.send(sim._nowUs, buffer);
+        }
+    }
+
+    static void onScheduleActivation(uint64_t activateTimeUs, uint8_t finger, uint8_t amplitude,
+                                     uint16_t durationMs, uint16_t frequencyHz) {
+        TwoGloveSim& sim = *g_activeSim;
+        auto it = sim._primaryKeys.find(activateTimeUs);
+        uint64_t key = (it != sim._primaryKeys.end()) ? it->second : 0;
+        if (it != sim._primaryKeys.end()) {
+            sim._primaryKeys.erase(it);
+        }
+        sim._primary.enqueue(activateTimeUs, key, finger, amplitude, durationMs, frequencyHz);
+    }
+
+    static void onStartScheduling() {}
+
+    static bool onIsSchedulingComplete() {
+        return g_activeSim->_primary.queue.isEmpty();
+    }
+
+    static uint32_t onGetLeadTime() {
+        return g_activeSim->_primary.sync.calculateAdaptiveLeadTime();
+    }
+
+    // -------------------------------------------------------------------------
+    // Report
+    // -------------------------------------------------------------------------
+
+    SimReport buildReport(uint64_t therapyStartUs, uint64_t endUs) {
+        SimReport report = {};
+        report.primaryActivations = (uint32_t)_primary.activations.size();
+        report.secondaryActivations = (uint32_t)_secondary.activations.size();
+        report.toSecondary = _toSecondary.getStats();
+        report.toPrimary = _toPrimary.getStats();
+        report.macrocyclesStaged = _macrocyclesStaged;
+        report.lateEvents = _lateEvents;
+        report.coasted = _coasted;
+        report.macrocycleBytes = _macrocycleBytes;
+        report.pipeline = _therapy.getPipelineStats();
+        report.offsetErrorUs = _offsetErrors;
+
+        std::map<uint64_t, uint64_t> secondaryByKey;
+        for (const SimActivation& a : _secondary.activations) {
+            secondaryByKey.emplace(a.eventKey, a.trueUs);
+        }
+
+        // Ignore the tail: SECONDARY may not have reached events near the end
+        uint64_t cutoffUs = endUs - std::min<uint64_t>(endUs - therapyStartUs, 2000000ULL);
+        for (const SimActivation& a : _primary.activations) {
+            if (a.trueUs > cutoffUs) {
+                continue;
+            }
+            auto it = secondaryByKey.find(a.eventKey);
+            if (it == secondaryByKey.end()) {
+                report.missedOnSecondary++;
+                continue;
+            }
+            report.skewUs.push_back((int64_t)it->second - (int64_t)a.trueUs);
+        }
+        report.matched = (uint32_t)report.skewUs.size();
+        report.skew = summarizeSkew(report.skewUs);
+        report.measuredSkewUs = _measuredSkew;
+        report.measuredSkew = summarizeSkew(report.measuredSkewUs);
+        return report;
+    }
+
+public:
+    static SkewStats summarizeSkew(const std::vector<int64_t>& skewUs) {
+        SkewStats stats = {};
+        if (skewUs.empty()) {
+            return stats;
+        }
+        std::vector<int64_t> absSkew;
+        absSkew.reserve(skewUs.size());
+        double sum = 0.0;
+        stats.minUs = skewUs[0];
+        stats.maxUs = skewUs[0];
+        for (int64_t s : skewUs) {
+            sum += (double)s;
+            stats.minUs = std::min(stats.minUs, s);
+            stats.maxUs = std::max(stats.maxUs, s);
+            absSkew.push_back(s < 0 ? -s : s);
+        }
+        std::sort(absSkew.begin(), absSkew.end());
+        size_t n = absSkew.size();
+        stats.count = (uint32_t)n;
+        stats.meanUs = sum / (double)n;
+        stats.p50AbsUs = absSkew[n / 2];
+        stats.p95AbsUs = absSkew[std::min(n - 1, (n * 95) / 100)];
+        stats.p99AbsUs = absSkew[std::min(n - 1, (n * 99) / 100)];
+        stats.maxAbsUs = absSkew.back();
+        return stats;
+    }
+
+    /**
+     * @brief Print the report as [SIM] lines (skew histogram in |skew| buckets)
+     */
+    static void printReport(const char* name, const SimReport& r) {
+        const SkewStats& s = r.skew;
+        printf("[SIM] %s: paired=%lu missed=%lu late=%lu | skew mean=%+.0fus p50=%lldus p95=%lldus p99=%lldus max=%lldus [%lld..%lld]\n",
+               name, (unsigned long)r.matched, (unsigned long)r.missedOnSecondary,
+               (unsigned long)r.lateEvents, s.meanUs,
+               (long long)s.p50AbsUs, (long long)s.p95AbsUs, (long long)s.p99AbsUs,
+               (long long)s.maxAbsUs, (long long)s.minUs, (long long)s.maxUs);
+
+        static const int64_t EDGES[] = {100, 250, 500, 1000, 2000, 5000};
+        uint32_t buckets[7] = {0};
+        for (int64_t v : r.skewUs) {
+            int64_t a = v < 0 ? -v : v;
+            uint8_t b = 0;
+            while (b < 6 && a >= EDGES[b]) {
+                b++;
+            }
+            buckets[b]++;
+        }
+        printf("[SIM]   |skew| <100us:%lu <250us:%lu <500us:%lu <1ms:%lu <2ms:%lu <5ms:%lu >=5ms:%lu\n",
+               (unsigned long)buckets[0], (unsigned long)buckets[1], (unsigned long)buckets[2],
+               (unsigned long)buckets[3], (unsigned long)buckets[4], (unsigned long)buckets[5],
+               (unsigned long)buckets[6]);
+
+        const SkewStats& m = r.measuredSkew;
+        printf("[SIM]   measured by PRIMARY (MC_ACK feedback): n=%lu mean=%+.0fus p50=%lldus p99=%lldus max=%lldus\n",
+               (unsigned long)m.count, m.meanUs, (long long)m.p50AbsUs, (long long)m.p99AbsUs,
+               (long long)m.maxAbsUs);
+
+        SkewStats offset = summarizeSkew(r.offsetErrorUs);
+        printf("[SIM]   offset error p95=%lldus max=%lldus | link P->S sent=%lu bytes=%lu retx=%lu drop=%lu, S->P sent=%lu retx=%lu drop=%lu | coasted=%lu\n",
+               (long long)offset.p95AbsUs, (long long)offset.maxAbsUs,
+               (unsigned long)r.toSecondary.sent, (unsigned long)r.toSecondary.bytes,
+               (unsigned long)r.toSecondary.retransmits,
+               (unsigned long)r.toSecondary.dropped, (unsigned long)r.toPrimary.sent,
+               (unsigned long)r.toPrimary.retransmits, (unsigned long)r.toPrimary.dropped,
+               (unsigned long)r.coasted);
+    }
+};
+
+#endif // TWO_GLOVE_SIM_H